@@ -17,6 +17,7 @@ LOCAL_SRC_FILES := \
 	execserver/xsTestProcess.cpp \
 	executor/xeBatchExecutor.cpp \
 	executor/xeBatchResult.cpp \
+	executor/xeBinaryTestLogParser.cpp \
 	executor/xeCallQueue.cpp \
 	executor/xeCommLink.cpp \
 	executor/xeContainerFormatParser.cpp \
@@ -37,6 +38,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuCommandLine.cpp \
 	framework/common/tcuCompressedTexture.cpp \
 	framework/common/tcuCPUWarmup.cpp \
+	framework/common/tcuDecompressedTextureCache.cpp \
 	framework/common/tcuDefs.cpp \
 	framework/common/tcuEither.cpp \
 	framework/common/tcuFactoryRegistry.cpp \
@@ -45,12 +47,14 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuFunctionLibrary.cpp \
 	framework/common/tcuFuzzyImageCompare.cpp \
 	framework/common/tcuImageCompare.cpp \
+	framework/common/tcuImageCompareThreads.cpp \
 	framework/common/tcuImageIO.cpp \
 	framework/common/tcuInterval.cpp \
 	framework/common/tcuMatrix.cpp \
 	framework/common/tcuMaybe.cpp \
 	framework/common/tcuPlatform.cpp \
 	framework/common/tcuRandomValueIterator.cpp \
+	framework/common/tcuRefRenderThreads.cpp \
 	framework/common/tcuRenderTarget.cpp \
 	framework/common/tcuResource.cpp \
 	framework/common/tcuResultCollector.cpp \
@@ -60,6 +64,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuSurface.cpp \
 	framework/common/tcuTestCase.cpp \
 	framework/common/tcuTestContext.cpp \
+	framework/common/tcuTestHierarchyCache.cpp \
 	framework/common/tcuTestHierarchyIterator.cpp \
 	framework/common/tcuTestHierarchyUtil.cpp \
 	framework/common/tcuTestLog.cpp \
@@ -104,6 +109,7 @@ LOCAL_SRC_FILES := \
 	framework/delibs/decpp/deStringUtil.cpp \
 	framework/delibs/decpp/deThread.cpp \
 	framework/delibs/decpp/deThreadLocal.cpp \
+	framework/delibs/decpp/deThreadPool.cpp \
 	framework/delibs/decpp/deThreadSafeRingBuffer.cpp \
 	framework/delibs/decpp/deUniquePtr.cpp \
 	framework/delibs/deimage/deImage.c \
@@ -658,8 +664,10 @@ LOCAL_SRC_FILES := \
 	modules/internal/ditFrameworkTests.cpp \
 	modules/internal/ditImageCompareTests.cpp \
 	modules/internal/ditImageIOTests.cpp \
+	modules/internal/ditReferenceRendererPerfTests.cpp \
 	modules/internal/ditTestCase.cpp \
 	modules/internal/ditTestLogTests.cpp \
+	modules/internal/ditTexDecompressionPerfTests.cpp \
 	modules/internal/ditTestPackage.cpp \
 	modules/internal/ditSeedBuilderTests.cpp \
 	modules/internal/ditTestPackageEntry.cpp
@@ -37,6 +37,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <memory>
+#include <map>
 #include <algorithm>
 #include <iostream>
 #include <sstream>
@@ -84,7 +85,7 @@ void registerOptions (de::cmdline::Parser& parser)
 	parser << Option<StartServer>	("s",		"start-server",	"Start local execserver",								"")
 		   << Option<Host>			("c",		"connect",		"Connect to host",										"127.0.0.1")
 		   << Option<Port>			("p",		"port",			"Select TCP port to use",								"50016")
-		   << Option<CaseListDir>	("cd",		"caselistdir",	"Path to test case XML files",							".")
+		   << Option<CaseListDir>	("cd",		"caselistdir",	"Path to test case XML or binary cache files",			".")
 		   << Option<TestSet>		("t",		"testset",		"Test set",												parseCommaSeparatedList,	"")
 		   << Option<ExcludeSet>	("e",		"exclude",		"Comma-separated list of exclude filters",				parseCommaSeparatedList,	"")
 		   << Option<ContinueFile>	(DE_NULL,	"continue",		"Continue execution by initializing results from existing test log", "")
@@ -222,9 +223,34 @@ static void readCaseList (xe::TestGroup* root, const char* filename)
 	}
 }
 
+static void readBinaryCaseList (xe::TestGroup* root, const char* filename)
+{
+	std::ifstream			in		(filename, std::ios_base::binary);
+	std::vector<deUint8>	data;
+
+	XE_CHECK(in.good());
+
+	in.seekg(0, std::ios_base::end);
+	data.resize((size_t)in.tellg());
+	in.seekg(0, std::ios_base::beg);
+
+	XE_CHECK(!data.empty() && in.read((char*)&data[0], (std::streamsize)data.size()));
+
+	xe::parseBinaryTestCaseList(root, &data[0], (int)data.size());
+}
+
+static bool endsWith (const std::string& str, const char* suffix)
+{
+	const size_t suffixLen = strlen(suffix);
+	return str.length() >= suffixLen && str.compare(str.length()-suffixLen, suffixLen, suffix) == 0;
+}
+
 static void readCaseLists (xe::TestRoot& root, const char* caseListDir)
 {
-	de::DirectoryIterator iter(caseListDir);
+	// XML case lists take precedence over binary test hierarchy caches of the same package
+	std::map<std::string, std::string>	xmlCaseLists;
+	std::map<std::string, std::string>	binaryCaseLists;
+	de::DirectoryIterator				iter			(caseListDir);
 
 	for (; iter.hasItem(); iter.next())
 	{
@@ -233,15 +259,22 @@ static void readCaseLists (xe::TestRoot& root, const char* caseListDir)
 		if (item.getType() == de::FilePath::TYPE_FILE)
 		{
 			std::string baseName = item.getBaseName();
-			if (baseName.find("-cases.xml") == baseName.length()-10)
-			{
-				std::string		packageName	= baseName.substr(0, baseName.length()-10);
-				xe::TestGroup*	package		= root.createGroup(packageName.c_str(), "");
 
-				readCaseList(package, item.getPath());
-			}
+			if (endsWith(baseName, "-cases.xml"))
+				xmlCaseLists[baseName.substr(0, baseName.length()-10)] = item.getPath();
+			else if (endsWith(baseName, "-cases.bin"))
+				binaryCaseLists[baseName.substr(0, baseName.length()-10)] = item.getPath();
 		}
 	}
+
+	for (std::map<std::string, std::string>::const_iterator caseList = xmlCaseLists.begin(); caseList != xmlCaseLists.end(); ++caseList)
+		readCaseList(root.createGroup(caseList->first.c_str(), ""), caseList->second.c_str());
+
+	for (std::map<std::string, std::string>::const_iterator caseList = binaryCaseLists.begin(); caseList != binaryCaseLists.end(); ++caseList)
+	{
+		if (xmlCaseLists.find(caseList->first) == xmlCaseLists.end())
+			readBinaryCaseList(root.createGroup(caseList->first.c_str(), ""), caseList->second.c_str());
+	}
 }
 
 static void addMatchingCases (const xe::TestGroup& group, xe::TestSet& testSet, const char* filter)
@@ -350,9 +383,24 @@ static void readLogFile (xe::BatchResult* batchResult, const char* filename)
 
 static void printBatchResultSummary (const xe::TestNode* root, const xe::TestSet& testSet, const xe::BatchResult& batchResult)
 {
-	int countByStatusCode[xe::TESTSTATUSCODE_LAST];
+	std::map<std::string, xe::TestStatusCode>	statusCodeByPath;
+	int											countByStatusCode[xe::TESTSTATUSCODE_LAST];
 	std::fill(&countByStatusCode[0], &countByStatusCode[0]+DE_LENGTH_OF_ARRAY(countByStatusCode), 0);
 
+	// Parse result data in log order, since deduplicated images reference earlier results.
+	{
+		xe::TestResultParser parser;
+
+		for (int resultNdx = 0; resultNdx < batchResult.getNumTestCaseResults(); resultNdx++)
+		{
+			xe::ConstTestCaseResultPtr	resultData	= batchResult.getTestCaseResult(resultNdx);
+			xe::TestCaseResult			result;
+
+			xe::parseTestCaseResultFromData(&parser, &result, *resultData.get());
+			statusCodeByPath[resultData->getTestCasePath()] = result.statusCode;
+		}
+	}
+
 	for (xe::ConstTestNodeIterator iter = xe::ConstTestNodeIterator::begin(root); iter != xe::ConstTestNodeIterator::end(root); ++iter)
 	{
 		const xe::TestNode* node = *iter;
@@ -363,16 +411,8 @@ static void printBatchResultSummary (const xe::TestNode* root, const xe::TestSet
 			xe::TestStatusCode				statusCode		= xe::TESTSTATUSCODE_PENDING;
 			testCase->getFullPath(fullPath);
 
-			// Parse result data if such exists.
-			if (batchResult.hasTestCaseResult(fullPath.c_str()))
-			{
-				xe::ConstTestCaseResultPtr	resultData	= batchResult.getTestCaseResult(fullPath.c_str());
-				xe::TestCaseResult			result;
-				xe::TestResultParser		parser;
-
-				xe::parseTestCaseResultFromData(&parser, &result, *resultData.get());
-				statusCode = result.statusCode;
-			}
+			if (statusCodeByPath.find(fullPath) != statusCodeByPath.end())
+				statusCode = statusCodeByPath[fullPath];
 
 			countByStatusCode[statusCode] += 1;
 		}
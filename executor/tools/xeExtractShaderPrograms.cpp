@@ -158,7 +158,7 @@ public:
 			xe::TestCaseResult					fullResult;
 			xe::TestResultParser::ParseResult	parseResult;
 
-			m_testResultParser.init(&fullResult);
+			m_testResultParser.init(&fullResult, caseData->getDataFormat());
 			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
 			DE_UNREF(parseResult);
 
@@ -162,7 +162,7 @@ public:
 			xe::TestCaseResult					fullResult;
 			xe::TestResultParser::ParseResult	parseResult;
 
-			m_testResultParser.init(&fullResult);
+			m_testResultParser.init(&fullResult, caseData->getDataFormat());
 			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
 
 			if ((parseResult != xe::TestResultParser::PARSERESULT_ERROR && fullResult.statusCode != xe::TESTSTATUSCODE_LAST) ||
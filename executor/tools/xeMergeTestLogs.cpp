@@ -32,8 +32,11 @@
 #include <string>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <algorithm>
 #include <stdexcept>
 
 using std::vector;
@@ -110,14 +113,59 @@ public:
 		// Ignored.
 	}
 
-	void testCaseResultComplete (const xe::TestCaseResultPtr&)
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
 	{
-		// Ignored.
+		if (caseData->getDataFormat() == xe::TESTCASEDATAFORMAT_BINARY)
+		{
+			// Merged log is a text log, so results of binary logs are written as XML.
+			xe::TestCaseResult result;
+
+			if (caseData->getDataSize() > 0)
+			{
+				xe::parseTestCaseResultFromData(&m_resultParser, &result, *caseData);
+				setResultData(*caseData, result);
+			}
+			else
+				caseData->setDataFormat(xe::TESTCASEDATAFORMAT_XML);
+		}
+		// Merging may drop or reorder results, so references to deduplicated images are replaced with image data.
+		else if (containsString(*caseData, "Hash=\"") || containsString(*caseData, "Ref=\""))
+		{
+			xe::TestCaseResult					result;
+			xe::TestResultParser::ParseResult	parseResult;
+
+			m_resultParser.init(&result);
+			parseResult = m_resultParser.parse(caseData->getData(), caseData->getDataSize());
+
+			if (parseResult != xe::TestResultParser::PARSERESULT_ERROR && result.statusCode != xe::TESTSTATUSCODE_LAST && containsString(*caseData, "Ref=\""))
+				setResultData(*caseData, result);
+		}
 	}
 
 private:
+	static void setResultData (xe::TestCaseResultData& caseData, const xe::TestCaseResult& result)
+	{
+		std::ostringstream	str;
+		xe::writeTestResult(result, str);
+
+		const string		data	= str.str();
+
+		caseData.setDataSize((int)data.size());
+		caseData.setDataFormat(xe::TESTCASEDATAFORMAT_XML);
+		std::copy(data.begin(), data.end(), caseData.getData());
+	}
+
+	static bool containsString (const xe::TestCaseResultData& caseData, const char* str)
+	{
+		const deUint8* const	begin	= caseData.getData();
+		const deUint8* const	end		= begin + caseData.getDataSize();
+
+		return std::search(begin, end, str, str + strlen(str)) != end;
+	}
+
 	xe::BatchResult* const	m_batchResult;
 	const deUint32			m_flags;
+	xe::TestResultParser	m_resultParser;		//!< Resolves deduplicated images within source log.
 };
 
 static void readLogFile (xe::BatchResult* dstResult, const char* filename, deUint32 flags)
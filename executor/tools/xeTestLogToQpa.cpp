@@ -0,0 +1,402 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Convert binary test log to text (.qpa) log.
+ *
+ * Test case results are written as soon as they are complete, so logs
+ * of any size can be converted. Case left open at end of log is written
+ * as terminated. XML records of binary case data are written as the same
+ * escaped XML with base64-encoded data that text logs contain.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogParser.hpp"
+#include "xeTestLogWriter.hpp"
+#include "xeBinaryTestLogParser.hpp"
+#include "deString.h"
+#include "deMemory.h"
+
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using std::string;
+
+enum
+{
+	MAX_INDENT = 32
+};
+
+//! Append string escaped as qpXmlWriter does. String ends at first null byte like in text logs.
+static void appendEscaped (string& dst, const deUint8* bytes, size_t numBytes)
+{
+	for (size_t ndx = 0; ndx < numBytes && bytes[ndx] != 0; ndx++)
+	{
+		const char			c		= (char)bytes[ndx];
+		const char* const	name	= xe::getControlCharacterName(c);
+
+		if (name)
+		{
+			dst += "&lt;";
+			dst += name;
+			dst += "&gt;";
+		}
+		else
+		{
+			switch (c)
+			{
+				case '<':	dst += "&lt;";		break;
+				case '>':	dst += "&gt;";		break;
+				case '&':	dst += "&amp;";		break;
+				case '\'':	dst += "&apos;";	break;
+				case '"':	dst += "&quot;";	break;
+				default:	dst += c;			break;
+			}
+		}
+	}
+}
+
+static void appendEscaped (string& dst, const string& str)
+{
+	appendEscaped(dst, (const deUint8*)str.c_str(), str.size());
+}
+
+static void appendIndent (string& dst, int depth)
+{
+	dst.append((size_t)std::min<int>(depth, MAX_INDENT), ' ');
+}
+
+static void appendBase64 (string& dst, const deUint8* data, size_t numBytes, int depth)
+{
+	static const char s_base64Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	size_t	numWritten	= 0;
+	size_t	srcNdx		= 0;
+
+	while (srcNdx < numBytes)
+	{
+		const size_t	numRead	= std::min<size_t>(3, numBytes - srcNdx);
+		const deUint8	s0		= data[srcNdx];
+		const deUint8	s1		= (numRead >= 2) ? data[srcNdx+1] : 0;
+		const deUint8	s2		= (numRead >= 3) ? data[srcNdx+2] : 0;
+
+		srcNdx += numRead;
+
+		if (numWritten == 0)
+			appendIndent(dst, depth);
+
+		dst += s_base64Table[s0 >> 2];
+		dst += s_base64Table[((s0&0x3)<<4) | (s1>>4)];
+		dst += (numRead >= 2) ? s_base64Table[((s1&0xF)<<2) | (s2>>6)] : '=';
+		dst += (numRead >= 3) ? s_base64Table[s2&0x3F] : '=';
+
+		// EOL every now and then.
+		numWritten += 4;
+		if (numWritten >= 64)
+		{
+			dst += '\n';
+			numWritten = 0;
+		}
+	}
+
+	// Last EOL.
+	if (numWritten > 0)
+		dst += '\n';
+}
+
+//! Convert XML records of binary case data to XML formatted as qpXmlWriter does.
+static void convertBinaryCaseData (string& dst, const deUint8* data, size_t dataSize)
+{
+	int		depth					= 0;
+	bool	prevIsStartElement		= false;
+	size_t	pos						= 0;
+
+	while (pos < dataSize)
+	{
+		if (dataSize - pos < xe::BINARY_LOG_RECORD_HEADER_SIZE)
+			throw xe::BinaryLogParseError("Malformed binary case data");
+
+		const int				type		= (int)data[pos];
+		const size_t			payloadSize	= (size_t)xe::readBinaryLogUint32(&data[pos+1]);
+		const deUint8* const	payload		= &data[pos + xe::BINARY_LOG_RECORD_HEADER_SIZE];
+
+		if (dataSize - pos - xe::BINARY_LOG_RECORD_HEADER_SIZE < payloadSize)
+			throw xe::BinaryLogParseError("Malformed binary case data");
+
+		xe::BinaryLogRecordReader reader (payload, payloadSize);
+
+		pos += xe::BINARY_LOG_RECORD_HEADER_SIZE + payloadSize;
+
+		// Close pending start element unless element ends right away or string data follows.
+		if (prevIsStartElement && type != xe::BINARYLOGRECORD_XML_END_ELEMENT && type != xe::BINARYLOGRECORD_XML_STRING)
+		{
+			dst += ">\n";
+			prevIsStartElement = false;
+		}
+
+		switch (type)
+		{
+			case xe::BINARYLOGRECORD_XML_START_DOCUMENT:
+				dst += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+				depth = 0;
+				break;
+
+			case xe::BINARYLOGRECORD_XML_END_DOCUMENT:
+				break;
+
+			case xe::BINARYLOGRECORD_XML_START_ELEMENT:
+			{
+				const string	name		= reader.readString();
+				const deUint32	numAttribs	= reader.readUint32();
+
+				appendIndent(dst, depth);
+				dst += '<';
+				dst += name;
+
+				for (deUint32 attribNdx = 0; attribNdx < numAttribs; attribNdx++)
+				{
+					const string	attribName	= reader.readString();
+					const string	attribValue	= reader.readString();
+
+					dst += ' ';
+					dst += attribName;
+					dst += "=\"";
+					appendEscaped(dst, attribValue);
+					dst += '"';
+				}
+
+				depth				+= 1;
+				prevIsStartElement	= true;
+				break;
+			}
+
+			case xe::BINARYLOGRECORD_XML_END_ELEMENT:
+			{
+				const string name = reader.readString();
+
+				if (depth == 0)
+					throw xe::BinaryLogParseError("Unexpected end element record");
+
+				depth -= 1;
+
+				if (prevIsStartElement)
+				{
+					dst += " />\n";
+					prevIsStartElement = false;
+				}
+				else
+				{
+					dst += "</";
+					dst += name;
+					dst += ">\n";
+				}
+				break;
+			}
+
+			case xe::BINARYLOGRECORD_XML_STRING:
+				if (prevIsStartElement)
+				{
+					dst += '>';
+					prevIsStartElement = false;
+				}
+				appendEscaped(dst, payload, payloadSize);
+				break;
+
+			case xe::BINARYLOGRECORD_XML_DATA:
+				appendBase64(dst, payload, payloadSize, depth);
+				break;
+
+			default:
+				throw xe::BinaryLogParseError("Unexpected record in binary case data");
+		}
+	}
+}
+
+struct CommandLine
+{
+	string	srcFilename;
+	string	dstFilename;
+};
+
+class LogHandler : public xe::TestLogHandler
+{
+public:
+	LogHandler (std::ostream& dst)
+		: m_dst			(dst)
+		, m_inSession	(false)
+	{
+	}
+
+	~LogHandler (void)
+	{
+		if (m_inSession)
+			m_dst << "\n#endSession\n";
+	}
+
+	void setSessionInfo (const xe::SessionInfo& info)
+	{
+		if (m_inSession)
+			m_dst << "\n#endSession\n";
+
+		xe::writeSessionInfo(info, m_dst);
+		m_dst << "#beginSession\n";
+		m_inSession = true;
+	}
+
+	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
+	}
+
+	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
+	{
+		// Ignored.
+	}
+
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
+	{
+		if (caseData->getDataFormat() == xe::TESTCASEDATAFORMAT_BINARY)
+		{
+			string xml;
+
+			convertBinaryCaseData(xml, caseData->getData(), (size_t)caseData->getDataSize());
+
+			// Text logs include newline preceding end marker in case data.
+			if (!xml.empty())
+				xml += '\n';
+
+			caseData->setDataSize((int)xml.size());
+			caseData->setDataFormat(xe::TESTCASEDATAFORMAT_XML);
+
+			if (!xml.empty())
+				deMemcpy(caseData->getData(), xml.c_str(), xml.size());
+		}
+
+		xe::writeTestCaseResultData(*caseData, m_dst);
+	}
+
+private:
+	std::ostream&	m_dst;
+	bool			m_inSession;
+};
+
+static void convertLog (std::istream& src, std::ostream& dst)
+{
+	LogHandler			resultHandler	(dst);
+	xe::TestLogParser	parser			(&resultHandler);
+	deUint8				buf				[2048];
+	int					numRead			= 0;
+
+	for (;;)
+	{
+		src.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
+		numRead = (int)src.gcount();
+
+		if (numRead <= 0)
+			break;
+
+		parser.parse(&buf[0], numRead);
+	}
+
+	// Feed end of string to parser. This terminates open test case if such exists.
+	{
+		const deUint8 eos = 0;
+		parser.parse(&eos, 1);
+	}
+}
+
+static void convertLogFile (const CommandLine& cmdLine)
+{
+	std::ifstream in (cmdLine.srcFilename.c_str(), std::ifstream::binary|std::ifstream::in);
+
+	if (!in.good())
+		throw std::runtime_error(string("Failed to open '") + cmdLine.srcFilename + "'");
+
+	if (!cmdLine.dstFilename.empty())
+	{
+		std::ofstream out (cmdLine.dstFilename.c_str(), std::ofstream::binary|std::ofstream::out);
+
+		if (!out.good())
+			throw std::runtime_error(string("Failed to open '") + cmdLine.dstFilename + "'");
+
+		convertLog(in, out);
+	}
+	else
+		convertLog(in, std::cout);
+}
+
+static void printHelp (const char* binName)
+{
+	printf("%s: [filename]\n", binName);
+	printf("  --dst=[filename]    Write text log to file, otherwise written to stdout.\n");
+}
+
+static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
+{
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		const char* arg = argv[argNdx];
+
+		if (!deStringBeginsWith(arg, "--"))
+		{
+			if (!cmdLine.srcFilename.empty())
+				return false;
+			cmdLine.srcFilename = arg;
+		}
+		else if (deStringBeginsWith(arg, "--dst="))
+		{
+			if (!cmdLine.dstFilename.empty())
+				return false;
+			cmdLine.dstFilename = arg+6;
+		}
+		else
+			return false;
+	}
+
+	if (cmdLine.srcFilename.empty())
+		return false;
+
+	return true;
+}
+
+int main (int argc, const char* const* argv)
+{
+	try
+	{
+		CommandLine cmdLine;
+
+		if (!parseCommandLine(cmdLine, argc, argv))
+		{
+			printHelp(argv[0]);
+			return -1;
+		}
+
+		convertLogFile(cmdLine);
+	}
+	catch (const std::exception& e)
+	{
+		printf("FATAL ERROR: %s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
@@ -23,6 +23,7 @@
 
 #include "xeBatchResult.hpp"
 #include "deMemory.h"
+#include "deString.h"
 
 using std::vector;
 using std::string;
@@ -31,6 +32,28 @@ using std::map;
 namespace xe
 {
 
+// SessionInfo
+
+void setSessionInfoAttribute (SessionInfo& info, const char* attribute, const char* value)
+{
+	if (deStringEqual(attribute, "releaseName"))
+		info.releaseName = value;
+	else if (deStringEqual(attribute, "releaseId"))
+		info.releaseId = value;
+	else if (deStringEqual(attribute, "targetName"))
+		info.targetName = value;
+	else if (deStringEqual(attribute, "candyTargetName"))
+		info.candyTargetName = value;
+	else if (deStringEqual(attribute, "configName"))
+		info.configName = value;
+	else if (deStringEqual(attribute, "resultName"))
+		info.resultName = value;
+	else if (deStringEqual(attribute, "timestamp"))
+		info.timestamp = value;
+
+	// \todo [2012-06-09 pyry] What to do with unknown/duplicate attributes? Currently just ignored.
+}
+
 // InfoLog
 
 InfoLog::InfoLog (void)
@@ -50,6 +73,7 @@ void InfoLog::append (const deUint8* bytes, int numBytes)
 TestCaseResultData::TestCaseResultData (const char* casePath)
 	: m_casePath	(casePath)
 	, m_statusCode	(TESTSTATUSCODE_LAST)
+	, m_dataFormat	(TESTCASEDATAFORMAT_XML)
 {
 }
 
@@ -68,6 +92,7 @@ void TestCaseResultData::clear (void)
 	m_statusCode = TESTSTATUSCODE_LAST;
 	m_statusDetails.clear();
 	m_casePath.clear();
+	m_dataFormat = TESTCASEDATAFORMAT_XML;
 	m_data.clear();
 }
 
@@ -50,6 +50,9 @@ public:
 	std::string			timestamp;
 };
 
+//! Set session info attribute by name as written in test logs. Unknown attributes are ignored.
+void setSessionInfoAttribute (SessionInfo& info, const char* attribute, const char* value);
+
 class InfoLog
 {
 public:
@@ -67,6 +70,14 @@ private:
 	std::vector<deUint8>	m_data;
 };
 
+enum TestCaseDataFormat
+{
+	TESTCASEDATAFORMAT_XML = 0,		//!< TestCaseResult XML, as in text logs.
+	TESTCASEDATAFORMAT_BINARY,		//!< XML records of binary logs, see xeBinaryTestLogParser.hpp.
+
+	TESTCASEDATAFORMAT_LAST
+};
+
 class TestCaseResultData
 {
 public:
@@ -83,6 +94,9 @@ public:
 	int							getDataSize						(void) const	{ return (int)m_data.size();		}
 	void						setDataSize						(int size)		{ m_data.resize(size);				}
 
+	TestCaseDataFormat			getDataFormat					(void) const	{ return m_dataFormat;				}
+	void						setDataFormat					(TestCaseDataFormat format)	{ m_dataFormat = format;	}
+
 	const deUint8*				getData							(void) const	{ return !m_data.empty() ? &m_data[0] : DE_NULL;	}
 	deUint8*					getData							(void)			{ return !m_data.empty() ? &m_data[0] : DE_NULL;	}
 
@@ -93,6 +107,7 @@ private:
 	std::string					m_casePath;
 	TestStatusCode				m_statusCode;
 	std::string					m_statusDetails;
+	TestCaseDataFormat			m_dataFormat;
 	std::vector<deUint8>		m_data;
 };
 
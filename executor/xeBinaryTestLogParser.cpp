@@ -0,0 +1,330 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Binary test log parser.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeBinaryTestLogParser.hpp"
+#include "xeTestLogParser.hpp"
+#include "deMemory.h"
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+namespace
+{
+
+static const deUint8	s_binaryLogMagic[]		= { 'd', 'E', 'Q', 'P', 'b', 'l', 'o', 'g' };
+
+enum
+{
+	END_OF_STRING		= 0		//!< Zero byte in place of record type, fed by executor at end of log data.
+};
+
+DE_STATIC_ASSERT(sizeof(s_binaryLogMagic) == BINARY_TEST_LOG_MAGIC_SIZE);
+
+} // anonymous
+
+const deUint8* getBinaryTestLogMagic (void)
+{
+	return &s_binaryLogMagic[0];
+}
+
+bool matchesBinaryTestLogMagic (const deUint8* bytes, int numBytes)
+{
+	const int numCompared = de::min(numBytes, (int)BINARY_TEST_LOG_MAGIC_SIZE);
+	return deMemCmp(bytes, s_binaryLogMagic, (size_t)numCompared) == 0;
+}
+
+const char* getControlCharacterName (char c)
+{
+	// Same characters as qpXmlWriter escapes.
+	switch (c)
+	{
+		case 1:		return "SOH";
+		case 2:		return "STX";
+		case 3:		return "ETX";
+		case 4:		return "EOT";
+		case 5:		return "ENQ";
+		case 6:		return "ACK";
+		case 7:		return "BEL";
+		case 8:		return "BS";
+		case 11:	return "VT";
+		case 12:	return "FF";
+		case 14:	return "SO";
+		case 15:	return "SI";
+		case 16:	return "DLE";
+		case 17:	return "DC1";
+		case 18:	return "DC2";
+		case 19:	return "DC3";
+		case 20:	return "DC4";
+		case 21:	return "NAK";
+		case 22:	return "SYN";
+		case 23:	return "ETB";
+		case 24:	return "CAN";
+		case 25:	return "EM";
+		case 26:	return "SUB";
+		case 27:	return "ESC";
+		case 28:	return "FS";
+		case 29:	return "GS";
+		case 30:	return "RS";
+		case 31:	return "US";
+
+		default:	return DE_NULL;
+	}
+}
+
+// BinaryLogRecordReader
+
+BinaryLogRecordReader::BinaryLogRecordReader (const deUint8* data, size_t dataSize)
+	: m_data		(data)
+	, m_dataSize	(dataSize)
+	, m_pos			(0)
+{
+}
+
+const deUint8* BinaryLogRecordReader::readBytes (size_t numBytes)
+{
+	if (numBytes > m_dataSize - m_pos)
+		throw BinaryLogParseError("Malformed binary log record: unexpected end of record");
+
+	m_pos += numBytes;
+	return m_data + m_pos - numBytes;
+}
+
+deUint32 BinaryLogRecordReader::readUint32 (void)
+{
+	return readBinaryLogUint32(readBytes(4));
+}
+
+string BinaryLogRecordReader::readString (void)
+{
+	const deUint32			length	= readUint32();
+	const deUint8* const	bytes	= readBytes(length);
+
+	return string((const char*)bytes, (const char*)bytes + length);
+}
+
+// BinaryTestLogParser
+
+BinaryTestLogParser::BinaryTestLogParser (TestLogHandler* handler)
+	: m_handler			(handler)
+	, m_headerParsed	(false)
+	, m_inSession		(false)
+	, m_caseDataUpdated	(false)
+{
+}
+
+BinaryTestLogParser::~BinaryTestLogParser (void)
+{
+}
+
+void BinaryTestLogParser::reset (void)
+{
+	m_buf.clear();
+	m_currentCaseData.clear();
+	m_headerParsed		= false;
+	m_sessionInfo		= SessionInfo();
+	m_inSession			= false;
+	m_caseDataUpdated	= false;
+}
+
+void BinaryTestLogParser::parse (const deUint8* bytes, int numBytes)
+{
+	size_t pos = 0;
+
+	m_buf.insert(m_buf.end(), bytes, bytes+numBytes);
+
+	if (!m_headerParsed)
+	{
+		const size_t headerSize = sizeof(s_binaryLogMagic) + 4;
+
+		if (m_buf.size() < headerSize)
+			return;
+
+		if (!matchesBinaryTestLogMagic(&m_buf[0], (int)sizeof(s_binaryLogMagic)))
+			throw BinaryLogParseError("Invalid binary log magic");
+
+		if (readBinaryLogUint32(&m_buf[sizeof(s_binaryLogMagic)]) != BINARY_TEST_LOG_VERSION)
+			throw BinaryLogParseError("Unsupported binary log version");
+
+		m_headerParsed	= true;
+		pos				= headerSize;
+	}
+
+	while (pos < m_buf.size())
+	{
+		if (m_buf[pos] == END_OF_STRING)
+		{
+			handleEndOfString();
+			pos += 1;
+			continue;
+		}
+
+		if (m_buf.size() - pos < BINARY_LOG_RECORD_HEADER_SIZE)
+			break; // Incomplete record header.
+
+		const size_t payloadSize = (size_t)readBinaryLogUint32(&m_buf[pos+1]);
+
+		if (m_buf.size() - pos - BINARY_LOG_RECORD_HEADER_SIZE < payloadSize)
+			break; // Incomplete record.
+
+		handleRecord(&m_buf[pos], BINARY_LOG_RECORD_HEADER_SIZE + payloadSize);
+		pos += BINARY_LOG_RECORD_HEADER_SIZE + payloadSize;
+	}
+
+	m_buf.erase(m_buf.begin(), m_buf.begin()+pos);
+
+	notifyCaseDataUpdated();
+}
+
+void BinaryTestLogParser::handleRecord (const deUint8* record, size_t recordSize)
+{
+	const int				type	= (int)record[0];
+	BinaryLogRecordReader	reader	(record + BINARY_LOG_RECORD_HEADER_SIZE, recordSize - BINARY_LOG_RECORD_HEADER_SIZE);
+
+	switch (type)
+	{
+		case BINARYLOGRECORD_SESSION_INFO:
+		{
+			if (m_inSession)
+				throw BinaryLogParseError("Unexpected session info record");
+
+			const string	attribute	= reader.readString();
+			const string	value		= reader.readString();
+
+			setSessionInfoAttribute(m_sessionInfo, attribute.c_str(), value.c_str());
+			break;
+		}
+
+		case BINARYLOGRECORD_BEGIN_SESSION:
+			if (m_inSession)
+				throw BinaryLogParseError("Unexpected begin session record");
+
+			m_handler->setSessionInfo(m_sessionInfo);
+			m_inSession = true;
+			break;
+
+		case BINARYLOGRECORD_END_SESSION:
+			if (!m_inSession)
+				throw BinaryLogParseError("Unexpected end session record");
+
+			m_inSession = false;
+			break;
+
+		case BINARYLOGRECORD_BEGIN_TEST_CASE_RESULT:
+		{
+			if (!m_inSession)
+				throw BinaryLogParseError("Unexpected begin test case result record");
+
+			const string casePath = reader.readString();
+
+			if (m_currentCaseData)
+				completeCase(TESTSTATUSCODE_TERMINATED, "Unexpected begin test case result");
+
+			m_currentCaseData = m_handler->startTestCaseResult(casePath.c_str());
+
+			// Clear and set to running state.
+			m_currentCaseData->setDataSize(0);
+			m_currentCaseData->setDataFormat(TESTCASEDATAFORMAT_BINARY);
+			m_currentCaseData->setTestResult(TESTSTATUSCODE_RUNNING, "Running");
+
+			m_handler->testCaseResultUpdated(m_currentCaseData);
+			break;
+		}
+
+		case BINARYLOGRECORD_END_TEST_CASE_RESULT:
+			if (m_currentCaseData)
+				completeCase(TESTSTATUSCODE_LAST, "");
+			break;
+
+		case BINARYLOGRECORD_TERMINATE_TEST_CASE_RESULT:
+			if (m_currentCaseData)
+			{
+				TestStatusCode	statusCode	= TESTSTATUSCODE_CRASH;
+				const string	reason		= reader.readString();
+				try
+				{
+					statusCode = getTestStatusCode(reason.c_str());
+				}
+				catch (const xe::ParseError&)
+				{
+					// Could not map status code.
+				}
+				completeCase(statusCode, reason.c_str());
+			}
+			break;
+
+		case BINARYLOGRECORD_XML_START_DOCUMENT:
+		case BINARYLOGRECORD_XML_END_DOCUMENT:
+		case BINARYLOGRECORD_XML_START_ELEMENT:
+		case BINARYLOGRECORD_XML_END_ELEMENT:
+		case BINARYLOGRECORD_XML_STRING:
+		case BINARYLOGRECORD_XML_DATA:
+			// XML outside test case results is ignored, as in text logs.
+			if (m_currentCaseData)
+				appendCaseData(record, recordSize);
+			break;
+
+		default:
+			// Unknown records are skipped to allow extending the format.
+			break;
+	}
+}
+
+void BinaryTestLogParser::handleEndOfString (void)
+{
+	// Terminate current case, as with text logs.
+	if (m_currentCaseData)
+		completeCase(TESTSTATUSCODE_TERMINATED, "Unexpected end of string");
+}
+
+void BinaryTestLogParser::appendCaseData (const deUint8* bytes, size_t numBytes)
+{
+	const int offset = m_currentCaseData->getDataSize();
+
+	m_currentCaseData->setDataSize(offset + (int)numBytes);
+	deMemcpy(m_currentCaseData->getData()+offset, bytes, numBytes);
+
+	m_caseDataUpdated = true;
+}
+
+void BinaryTestLogParser::completeCase (TestStatusCode statusCode, const char* description)
+{
+	DE_ASSERT(m_currentCaseData);
+
+	notifyCaseDataUpdated();
+	m_currentCaseData->setTestResult(statusCode, description);
+	m_handler->testCaseResultComplete(m_currentCaseData);
+	m_currentCaseData.clear();
+}
+
+void BinaryTestLogParser::notifyCaseDataUpdated (void)
+{
+	if (m_currentCaseData && m_caseDataUpdated)
+		m_handler->testCaseResultUpdated(m_currentCaseData);
+
+	m_caseDataUpdated = false;
+}
+
+} // xe
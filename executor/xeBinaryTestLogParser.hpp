@@ -0,0 +1,145 @@
+#ifndef _XEBINARYTESTLOGPARSER_HPP
+#define _XEBINARYTESTLOGPARSER_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Binary test log parser.
+ *
+ * Binary logs are written by test binaries with --deqp-log-format=binary.
+ * The format is described in qpTestLog.h and qpXmlWriter.h.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeBatchResult.hpp"
+
+#include <string>
+#include <vector>
+
+namespace xe
+{
+
+class TestLogHandler;
+
+class BinaryLogParseError : public ParseError
+{
+public:
+	BinaryLogParseError (const std::string& message) : ParseError(message) {}
+};
+
+enum
+{
+	BINARY_TEST_LOG_MAGIC_SIZE		= 8,
+	BINARY_TEST_LOG_VERSION			= 1,
+	BINARY_LOG_RECORD_HEADER_SIZE	= 5		//!< Type byte and deUint32 payload size.
+};
+
+//! Binary log record types. Must match qpBinaryLogRecordType and qpXmlBinaryRecordType.
+enum BinaryLogRecordType
+{
+	BINARYLOGRECORD_XML_START_DOCUMENT		= 1,
+	BINARYLOGRECORD_XML_END_DOCUMENT,
+	BINARYLOGRECORD_XML_START_ELEMENT,
+	BINARYLOGRECORD_XML_END_ELEMENT,
+	BINARYLOGRECORD_XML_STRING,
+	BINARYLOGRECORD_XML_DATA,
+
+	BINARYLOGRECORD_SESSION_INFO			= 0x10,
+	BINARYLOGRECORD_BEGIN_SESSION,
+	BINARYLOGRECORD_END_SESSION,
+	BINARYLOGRECORD_BEGIN_TEST_CASE_RESULT,
+	BINARYLOGRECORD_END_TEST_CASE_RESULT,
+	BINARYLOGRECORD_TERMINATE_TEST_CASE_RESULT
+};
+
+//! Get binary log magic, BINARY_TEST_LOG_MAGIC_SIZE bytes.
+const deUint8*	getBinaryTestLogMagic		(void);
+
+//! Check if log data matches binary log magic. Only first min(numBytes, BINARY_TEST_LOG_MAGIC_SIZE) bytes are compared.
+bool			matchesBinaryTestLogMagic	(const deUint8* bytes, int numBytes);
+
+//! Get name of control character that text logs write as "<name>", or null if character is written as is.
+const char*		getControlCharacterName		(char c);
+
+inline deUint32 readBinaryLogUint32 (const deUint8* bytes)
+{
+	return (deUint32)bytes[0] | ((deUint32)bytes[1] << 8) | ((deUint32)bytes[2] << 16) | ((deUint32)bytes[3] << 24);
+}
+
+//! Reader for fields of binary log record payload.
+class BinaryLogRecordReader
+{
+public:
+					BinaryLogRecordReader	(const deUint8* data, size_t dataSize);
+
+	const deUint8*	readBytes				(size_t numBytes);
+	deUint32		readUint32				(void);
+	std::string		readString				(void);
+
+private:
+	const deUint8*	m_data;
+	size_t			m_dataSize;
+	size_t			m_pos;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Streaming parser for binary test logs
+ *
+ * XML records of test case results are stored to case data as is, with
+ * data format TESTCASEDATAFORMAT_BINARY. TestResultParser parses them
+ * directly to result items.
+ *
+ * A zero byte in place of a record marks end of log data, like in text
+ * logs. Open test case is then completed with TESTSTATUSCODE_TERMINATED.
+ * Case that is still open when next case begins is terminated likewise.
+ *//*--------------------------------------------------------------------*/
+class BinaryTestLogParser
+{
+public:
+							BinaryTestLogParser		(TestLogHandler* handler);
+							~BinaryTestLogParser	(void);
+
+	void					reset					(void);
+
+	void					parse					(const deUint8* bytes, int numBytes);
+
+private:
+							BinaryTestLogParser		(const BinaryTestLogParser& other);
+	BinaryTestLogParser&	operator=				(const BinaryTestLogParser& other);
+
+	void					handleRecord			(const deUint8* record, size_t recordSize);
+	void					handleEndOfString		(void);
+	void					appendCaseData			(const deUint8* bytes, size_t numBytes);
+	void					completeCase			(TestStatusCode statusCode, const char* description);
+	void					notifyCaseDataUpdated	(void);
+
+	TestLogHandler*			m_handler;
+
+	std::vector<deUint8>	m_buf;					//!< Unparsed data, starts at record boundary.
+	bool					m_headerParsed;
+
+	SessionInfo				m_sessionInfo;
+	TestCaseResultPtr		m_currentCaseData;
+	bool					m_inSession;
+	bool					m_caseDataUpdated;		//!< Case data has changed since handler was last notified.
+};
+
+} // xe
+
+#endif // _XEBINARYTESTLOGPARSER_HPP
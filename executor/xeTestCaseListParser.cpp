@@ -23,6 +23,7 @@
 
 #include "xeTestCaseListParser.hpp"
 #include "deString.h"
+#include "deMemory.h"
 
 using std::vector;
 using std::string;
@@ -143,4 +144,104 @@ void TestCaseListParser::parse (const deUint8* bytes, int numBytes)
 	}
 }
 
+namespace
+{
+
+class BinaryCaseListReader
+{
+public:
+	BinaryCaseListReader (const deUint8* bytes, int numBytes)
+		: m_bytes		(bytes)
+		, m_numBytes	(numBytes)
+		, m_pos			(0)
+	{
+	}
+
+	bool isFinished (void) const
+	{
+		return m_pos == m_numBytes;
+	}
+
+	const deUint8* readBytes (int numBytes)
+	{
+		XE_CHECK_MSG(numBytes >= 0 && numBytes <= m_numBytes - m_pos, "Unexpected end of binary case list");
+		m_pos += numBytes;
+		return m_bytes + m_pos - numBytes;
+	}
+
+	deUint32 readUint32 (void)
+	{
+		const deUint8* bytes = readBytes(4);
+		return (deUint32)bytes[0] | ((deUint32)bytes[1] << 8) | ((deUint32)bytes[2] << 16) | ((deUint32)bytes[3] << 24);
+	}
+
+	string readString (void)
+	{
+		const deUint32	length	= readUint32();
+		const deUint8*	bytes	= readBytes((int)de::min<deUint32>(length, 0x7fffffffu));
+
+		return string((const char*)bytes, (const char*)bytes + length);
+	}
+
+private:
+	const deUint8*	m_bytes;
+	int				m_numBytes;
+	int				m_pos;
+};
+
+//! Read node and its children, returns number of nodes read
+deUint32 readBinaryTestNode (BinaryCaseListReader& reader, TestGroup* parent)
+{
+	// Node types: 0 = group, 1..4 = test case types in TestCaseType order
+	const deUint32	nodeType	= reader.readUint32();
+	const deUint32	numChildren	= reader.readUint32();
+	const string	name		= reader.readString();
+	const string	description	= reader.readString();
+	deUint32		numNodes	= 1;
+
+	XE_CHECK_MSG(nodeType <= (deUint32)TESTCASETYPE_LAST, "Unknown node type in binary case list");
+
+	if (nodeType == 0)
+	{
+		TestGroup* const group = parent->createGroup(name.c_str(), description.c_str());
+
+		for (deUint32 childNdx = 0; childNdx < numChildren; childNdx++)
+			numNodes += readBinaryTestNode(reader, group);
+	}
+	else
+	{
+		XE_CHECK_MSG(numChildren == 0, "Only TestGroups are allowed to have child nodes");
+		parent->createCase((TestCaseType)(nodeType-1), name.c_str(), description.c_str());
+	}
+
+	return numNodes;
+}
+
+} // anonymous
+
+void parseBinaryTestCaseList (TestGroup* rootGroup, const deUint8* bytes, int numBytes)
+{
+	static const char		s_magic[]	= { 'd', 'E', 'Q', 'P', 'h', 'i', 'e', 'r' };
+	BinaryCaseListReader	reader		(bytes, numBytes);
+
+	XE_CHECK_MSG(deMemCmp(reader.readBytes((int)sizeof(s_magic)), s_magic, sizeof(s_magic)) == 0, "Not a binary case list");
+	XE_CHECK_MSG(reader.readUint32() == 1, "Unsupported binary case list version");
+
+	reader.readUint32();	// Release id
+	reader.readString();	// Release name
+	reader.readString();	// Target name
+	reader.readString();	// Package name
+	reader.readString();	// Package description
+
+	{
+		const deUint32	numNodes	= reader.readUint32();
+		deUint32		numRead		= 0;
+
+		while (numRead < numNodes)
+			numRead += readBinaryTestNode(reader, rootGroup);
+
+		XE_CHECK_MSG(numRead == numNodes && reader.isFinished(), "Malformed binary case list");
+	}
+}
+
 } // xe
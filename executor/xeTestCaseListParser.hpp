@@ -53,6 +53,15 @@ private:
 	std::vector<TestNode*>	m_nodeStack;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Parse binary test hierarchy cache
+ *
+ * Reads package hierarchy written by test binaries with
+ * --deqp-caselist-cache-dir into rootGroup. Release info stored in the
+ * cache is not checked. See tcuTestHierarchyCache.hpp for the format.
+ *//*--------------------------------------------------------------------*/
+void parseBinaryTestCaseList (TestGroup* rootGroup, const deUint8* bytes, int numBytes);
+
 } // xe
 
 #endif // _XETESTCASELISTPARSER_HPP
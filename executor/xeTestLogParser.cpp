@@ -22,7 +22,6 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeTestLogParser.hpp"
-#include "deString.h"
 
 using std::string;
 using std::vector;
@@ -32,8 +31,10 @@ namespace xe
 {
 
 TestLogParser::TestLogParser (TestLogHandler* handler)
-	: m_handler		(handler)
-	, m_inSession	(false)
+	: m_format			(LOGFORMAT_UNKNOWN)
+	, m_binaryParser	(handler)
+	, m_handler			(handler)
+	, m_inSession		(false)
 {
 }
 
@@ -43,13 +44,44 @@ TestLogParser::~TestLogParser (void)
 
 void TestLogParser::reset (void)
 {
+	m_format = LOGFORMAT_UNKNOWN;
+	m_formatDetectBuf.clear();
 	m_containerParser.clear();
+	m_binaryParser.reset();
 	m_currentCaseData.clear();
 	m_sessionInfo	= SessionInfo();
 	m_inSession		= false;
 }
 
 void TestLogParser::parse (const deUint8* bytes, int numBytes)
+{
+	if (m_format == LOGFORMAT_UNKNOWN)
+	{
+		m_formatDetectBuf.insert(m_formatDetectBuf.end(), bytes, bytes+numBytes);
+
+		if (m_formatDetectBuf.empty())
+			return;
+
+		if (!matchesBinaryTestLogMagic(&m_formatDetectBuf[0], (int)m_formatDetectBuf.size()))
+			m_format = LOGFORMAT_TEXT;
+		else if (m_formatDetectBuf.size() >= BINARY_TEST_LOG_MAGIC_SIZE)
+			m_format = LOGFORMAT_BINARY;
+		else
+			return; // Need more data to decide.
+
+		{
+			const vector<deUint8> buffered = m_formatDetectBuf;
+			m_formatDetectBuf.clear();
+			parse(&buffered[0], (int)buffered.size());
+		}
+	}
+	else if (m_format == LOGFORMAT_BINARY)
+		m_binaryParser.parse(bytes, numBytes);
+	else
+		parseText(bytes, numBytes);
+}
+
+void TestLogParser::parseText (const deUint8* bytes, int numBytes)
 {
 	m_containerParser.feed(bytes, numBytes);
 
@@ -86,25 +118,7 @@ void TestLogParser::parse (const deUint8* bytes, int numBytes)
 				if (m_inSession)
 					throw Error("Unexpected #sessionInfo");
 
-				const char*		attribute	= m_containerParser.getSessionInfoAttribute();
-				const char*		value		= m_containerParser.getSessionInfoValue();
-
-				if (deStringEqual(attribute, "releaseName"))
-					m_sessionInfo.releaseName = value;
-				else if (deStringEqual(attribute, "releaseId"))
-					m_sessionInfo.releaseId = value;
-				else if (deStringEqual(attribute, "targetName"))
-					m_sessionInfo.targetName = value;
-				else if (deStringEqual(attribute, "candyTargetName"))
-					m_sessionInfo.candyTargetName = value;
-				else if (deStringEqual(attribute, "configName"))
-					m_sessionInfo.configName = value;
-				else if (deStringEqual(attribute, "resultName"))
-					m_sessionInfo.resultName = value;
-				else if (deStringEqual(attribute, "timestamp"))
-					m_sessionInfo.timestamp = value;
-
-				// \todo [2012-06-09 pyry] What to do with unknown/duplicate attributes? Currently just ignored.
+				setSessionInfoAttribute(m_sessionInfo, m_containerParser.getSessionInfoAttribute(), m_containerParser.getSessionInfoValue());
 				break;
 			}
 
@@ -118,6 +132,7 @@ void TestLogParser::parse (const deUint8* bytes, int numBytes)
 
 				// Clear and set to running state.
 				m_currentCaseData->setDataSize(0);
+				m_currentCaseData->setDataFormat(TESTCASEDATAFORMAT_XML);
 				m_currentCaseData->setTestResult(TESTSTATUSCODE_RUNNING, "Running");
 
 				m_handler->testCaseResultUpdated(m_currentCaseData);
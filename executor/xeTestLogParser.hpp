@@ -28,6 +28,7 @@
 #include "xeContainerFormatParser.hpp"
 #include "xeTestResultParser.hpp"
 #include "xeBatchResult.hpp"
+#include "xeBinaryTestLogParser.hpp"
 
 #include <string>
 #include <vector>
@@ -48,6 +49,12 @@ public:
 	virtual void				testCaseResultComplete		(const TestCaseResultPtr& resultData)	= DE_NULL;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Test log parser
+ *
+ * Both text and binary logs are accepted. Format is detected from the
+ * beginning of log data.
+ *//*--------------------------------------------------------------------*/
 class TestLogParser
 {
 public:
@@ -62,7 +69,22 @@ private:
 							TestLogParser			(const TestLogParser& other);
 	TestLogParser&			operator=				(const TestLogParser& other);
 
+	void					parseText				(const deUint8* bytes, int numBytes);
+
+	enum LogFormat
+	{
+		LOGFORMAT_UNKNOWN = 0,
+		LOGFORMAT_TEXT,
+		LOGFORMAT_BINARY,
+
+		LOGFORMAT_LAST
+	};
+
+	LogFormat				m_format;
+	std::vector<deUint8>	m_formatDetectBuf;		//!< Data received before format was detected.
+
 	ContainerFormatParser	m_containerParser;
+	BinaryTestLogParser		m_binaryParser;
 	TestLogHandler*			m_handler;
 
 	SessionInfo				m_sessionInfo;
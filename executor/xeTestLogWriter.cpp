@@ -23,9 +23,11 @@
 
 #include "xeTestLogWriter.hpp"
 #include "xeXMLWriter.hpp"
+#include "xeBinaryTestLogParser.hpp"
 #include "deStringUtil.hpp"
 
 #include <fstream>
+#include <cstring>
 
 namespace xe
 {
@@ -61,7 +63,7 @@ std::ostream& operator<< (std::ostream& stream, const ContainerValue& value)
 	return stream;
 }
 
-static void writeSessionInfo (const SessionInfo& info, std::ostream& stream)
+void writeSessionInfo (const SessionInfo& info, std::ostream& stream)
 {
 	if (!info.releaseName.empty())
 		stream << "#sessionInfo releaseName " << ContainerValue(info.releaseName) << "\n";
@@ -86,8 +88,11 @@ static void writeSessionInfo (const SessionInfo& info, std::ostream& stream)
 		stream << "#sessionInfo timestamp " << info.timestamp << "\n";
 }
 
-static void writeTestCase (const TestCaseResultData& caseData, std::ostream& stream)
+void writeTestCaseResultData (const TestCaseResultData& caseData, std::ostream& stream)
 {
+	if (caseData.getDataFormat() != TESTCASEDATAFORMAT_XML)
+		throw Error("Binary test case data can't be written to text log");
+
 	stream << "\n#beginTestCaseResult " << caseData.getTestCasePath() << "\n";
 
 	if (caseData.getDataSize() > 0)
@@ -108,8 +113,120 @@ static void writeTestCase (const TestCaseResultData& caseData, std::ostream& str
 		stream << "#endTestCaseResult\n";
 }
 
+/* Binary batch result writer. */
+
+static void writeBinaryUint32 (std::ostream& stream, deUint32 value)
+{
+	deUint8 bytes[4];
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(bytes); ndx++)
+		bytes[ndx] = (deUint8)(value >> (8*ndx));
+
+	stream.write((const char*)&bytes[0], sizeof(bytes));
+}
+
+//! Write binary log container record with up to two string values, as qpTestLog does.
+static void writeBinaryRecord (std::ostream& stream, BinaryLogRecordType type, const char* value0, const char* value1)
+{
+	const char* const	values[]	= { value0, value1 };
+	size_t				payloadSize	= 0;
+
+	DE_ASSERT(value0 || !value1);
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(values) && values[ndx]; ndx++)
+		payloadSize += 4 + strlen(values[ndx]);
+
+	stream.put((char)type);
+	writeBinaryUint32(stream, (deUint32)payloadSize);
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(values) && values[ndx]; ndx++)
+	{
+		writeBinaryUint32(stream, (deUint32)strlen(values[ndx]));
+		stream.write(values[ndx], strlen(values[ndx]));
+	}
+}
+
+static void writeBinarySessionInfo (const SessionInfo& info, std::ostream& stream)
+{
+	const struct
+	{
+		const char*			name;
+		const std::string&	value;
+	} attributes[] =
+	{
+		{ "releaseName",		info.releaseName		},
+		{ "releaseId",			info.releaseId			},
+		{ "targetName",			info.targetName			},
+		{ "candyTargetName",	info.candyTargetName	},
+		{ "configName",			info.configName			},
+		{ "resultName",			info.resultName			},
+		{ "timestamp",			info.timestamp			}
+	};
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(attributes); ndx++)
+	{
+		if (!attributes[ndx].value.empty())
+			writeBinaryRecord(stream, BINARYLOGRECORD_SESSION_INFO, attributes[ndx].name, attributes[ndx].value.c_str());
+	}
+}
+
+static void writeBinaryTestCaseResultData (const TestCaseResultData& caseData, std::ostream& stream)
+{
+	if (caseData.getDataSize() > 0 && caseData.getDataFormat() != TESTCASEDATAFORMAT_BINARY)
+		throw Error("Text test case data can't be written to binary log");
+
+	writeBinaryRecord(stream, BINARYLOGRECORD_BEGIN_TEST_CASE_RESULT, caseData.getTestCasePath(), DE_NULL);
+
+	if (caseData.getDataSize() > 0)
+		stream.write((const char*)caseData.getData(), caseData.getDataSize());
+
+	TestStatusCode dataCode = caseData.getStatusCode();
+	if (dataCode == TESTSTATUSCODE_CRASH	||
+		dataCode == TESTSTATUSCODE_TIMEOUT	||
+		dataCode == TESTSTATUSCODE_TERMINATED)
+		writeBinaryRecord(stream, BINARYLOGRECORD_TERMINATE_TEST_CASE_RESULT, getTestStatusCodeName(dataCode), DE_NULL);
+	else
+		writeBinaryRecord(stream, BINARYLOGRECORD_END_TEST_CASE_RESULT, DE_NULL, DE_NULL);
+}
+
+static void writeBinaryTestLog (const BatchResult& result, std::ostream& stream)
+{
+	stream.write((const char*)getBinaryTestLogMagic(), BINARY_TEST_LOG_MAGIC_SIZE);
+	writeBinaryUint32(stream, BINARY_TEST_LOG_VERSION);
+
+	writeBinarySessionInfo(result.getSessionInfo(), stream);
+
+	writeBinaryRecord(stream, BINARYLOGRECORD_BEGIN_SESSION, DE_NULL, DE_NULL);
+
+	for (int ndx = 0; ndx < result.getNumTestCaseResults(); ndx++)
+	{
+		ConstTestCaseResultPtr caseData = result.getTestCaseResult(ndx);
+		writeBinaryTestCaseResultData(*caseData, stream);
+	}
+
+	writeBinaryRecord(stream, BINARYLOGRECORD_END_SESSION, DE_NULL, DE_NULL);
+}
+
+static bool hasBinaryTestCaseResultData (const BatchResult& result)
+{
+	for (int ndx = 0; ndx < result.getNumTestCaseResults(); ndx++)
+	{
+		if (result.getTestCaseResult(ndx)->getDataFormat() == TESTCASEDATAFORMAT_BINARY)
+			return true;
+	}
+
+	return false;
+}
+
 void writeTestLog (const BatchResult& result, std::ostream& stream)
 {
+	// Results parsed from binary log are written as binary log, testlog-to-qpa converts it to text.
+	if (hasBinaryTestCaseResultData(result))
+	{
+		writeBinaryTestLog(result, stream);
+		return;
+	}
+
 	writeSessionInfo(result.getSessionInfo(), stream);
 
 	stream << "#beginSession\n";
@@ -117,7 +234,7 @@ void writeTestLog (const BatchResult& result, std::ostream& stream)
 	for (int ndx = 0; ndx < result.getNumTestCaseResults(); ndx++)
 	{
 		ConstTestCaseResultPtr caseData = result.getTestCaseResult(ndx);
-		writeTestCase(*caseData, stream);
+		writeTestCaseResultData(*caseData, stream);
 	}
 
 	stream << "\n#endSession\n";
@@ -37,6 +37,11 @@ namespace xml
 class Writer;
 }
 
+// Container parts of text test log, for writing logs incrementally. Case data must be in TESTCASEDATAFORMAT_XML.
+void	writeSessionInfo		(const SessionInfo& info, std::ostream& stream);
+void	writeTestCaseResultData	(const TestCaseResultData& caseData, std::ostream& stream);
+
+// Batch results that contain case data of binary logs are written as binary log.
 void	writeTestLog			(const BatchResult& batchResult, std::ostream& stream);
 void	writeBatchResultToFile	(const BatchResult& batchResult, const char* filename);
 
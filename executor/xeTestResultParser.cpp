@@ -24,6 +24,7 @@
 #include "xeTestResultParser.hpp"
 #include "xeTestCaseResult.hpp"
 #include "xeBatchResult.hpp"
+#include "xeBinaryTestLogParser.hpp"
 #include "deString.h"
 #include "deInt32.h"
 
@@ -36,6 +37,11 @@ using std::vector;
 namespace xe
 {
 
+enum
+{
+	MAX_REFERENCEABLE_IMAGE_BYTES	= 64*1024*1024	//!< Must match QP_TEST_LOG_MAX_REFERENCEABLE_IMAGE_BYTES in qpTestLog.h.
+};
+
 static inline int toInt (const char* str)
 {
 	return atoi(str);
@@ -164,7 +170,8 @@ static const EnumMapEntry s_logVersionMap[] =
 	{ 0x0b7db0d4,	"0.3.0",		TESTLOGVERSION_0_3_0	},
 	{ 0x0b7db0d5,	"0.3.1",		TESTLOGVERSION_0_3_1	},
 	{ 0x0b7db0d6,	"0.3.2",		TESTLOGVERSION_0_3_2	},
-	{ 0x0b7db0d7,	"0.3.3",		TESTLOGVERSION_0_3_3	}
+	{ 0x0b7db0d7,	"0.3.3",		TESTLOGVERSION_0_3_3	},
+	{ 0x0b7db0d8,	"0.3.4",		TESTLOGVERSION_0_3_4	}
 };
 
 static const EnumMapEntry s_sampleValueTagMap[] =
@@ -285,11 +292,13 @@ static ri::NumericValue getNumericValue (const std::string& value)
 }
 
 TestResultParser::TestResultParser (void)
-	: m_result				(DE_NULL)
+	: m_dataFormat			(TESTCASEDATAFORMAT_XML)
+	, m_result				(DE_NULL)
 	, m_state				(STATE_NOT_INITIALIZED)
 	, m_logVersion			(TESTLOGVERSION_LAST)
 	, m_curItemList			(DE_NULL)
 	, m_base64DecodeOffset	(0)
+	, m_imageBlobBytes		(0)
 {
 }
 
@@ -300,19 +309,32 @@ TestResultParser::~TestResultParser (void)
 void TestResultParser::clear (void)
 {
 	m_xmlParser.clear();
+	m_binaryBuf.clear();
+	m_binaryElementName.clear();
+	m_binaryAttributes.clear();
 	m_itemStack.clear();
 
+	m_dataFormat			= TESTCASEDATAFORMAT_XML;
 	m_result				= DE_NULL;
 	m_state					= STATE_NOT_INITIALIZED;
 	m_logVersion			= TESTLOGVERSION_LAST;
 	m_curItemList			= DE_NULL;
 	m_base64DecodeOffset	= 0;
 	m_curNumValue.clear();
+	m_curImageHash.clear();
+	m_caseImageBlobs.clear();
+	m_caseImageOrder.clear();
 }
 
 void TestResultParser::init (TestCaseResult* dstResult)
+{
+	init(dstResult, TESTCASEDATAFORMAT_XML);
+}
+
+void TestResultParser::init (TestCaseResult* dstResult, TestCaseDataFormat dataFormat)
 {
 	clear();
+	m_dataFormat	= dataFormat;
 	m_result		= dstResult;
 	m_state			= STATE_INITIALIZED;
 	m_curItemList	= &dstResult->resultItems;
@@ -326,40 +348,23 @@ TestResultParser::ParseResult TestResultParser::parse (const deUint8* bytes, int
 	{
 		bool resultChanged = false;
 
-		m_xmlParser.feed(bytes, numBytes);
-
-		for (;;)
+		if (m_dataFormat == TESTCASEDATAFORMAT_BINARY)
+			resultChanged = parseBinary(bytes, numBytes);
+		else
 		{
-			xml::Element curElement = m_xmlParser.getElement();
-
-			if (curElement == xml::ELEMENT_INCOMPLETE	||
-				curElement == xml::ELEMENT_END_OF_STRING)
-				break;
+			resultChanged = parseXml(bytes, numBytes);
 
-			switch (curElement)
+			if (m_xmlParser.getElement() == xml::ELEMENT_END_OF_STRING)
 			{
-				case xml::ELEMENT_START:	handleElementStart();		break;
-				case xml::ELEMENT_END:		handleElementEnd();			break;
-				case xml::ELEMENT_DATA:		handleData();				break;
+				if (m_state != STATE_TEST_CASE_RESULT_ENDED)
+					throw TestResultParseError("Unexpected end of log data");
 
-				default:
-					DE_ASSERT(false);
+				return PARSERESULT_COMPLETE;
 			}
-
-			resultChanged = true;
-			m_xmlParser.advance();
 		}
 
-		if (m_xmlParser.getElement() == xml::ELEMENT_END_OF_STRING)
-		{
-			if (m_state != STATE_TEST_CASE_RESULT_ENDED)
-				throw TestResultParseError("Unexpected end of log data");
-
-			return PARSERESULT_COMPLETE;
-		}
-		else
-			return resultChanged ? PARSERESULT_CHANGED
-								 : PARSERESULT_NOT_CHANGED;
+		return resultChanged ? PARSERESULT_CHANGED
+							 : PARSERESULT_NOT_CHANGED;
 	}
 	catch (const TestResultParseError& e)
 	{
@@ -377,14 +382,168 @@ TestResultParser::ParseResult TestResultParser::parse (const deUint8* bytes, int
 
 		return PARSERESULT_ERROR;
 	}
+	catch (const BinaryLogParseError& e)
+	{
+		// Set error code to result.
+		m_result->statusCode	= TESTSTATUSCODE_INTERNAL_ERROR;
+		m_result->statusDetails	= e.what();
+
+		return PARSERESULT_ERROR;
+	}
+}
+
+bool TestResultParser::parseXml (const deUint8* bytes, int numBytes)
+{
+	bool resultChanged = false;
+
+	m_xmlParser.feed(bytes, numBytes);
+
+	for (;;)
+	{
+		xml::Element curElement = m_xmlParser.getElement();
+
+		if (curElement == xml::ELEMENT_INCOMPLETE	||
+			curElement == xml::ELEMENT_END_OF_STRING)
+			break;
+
+		switch (curElement)
+		{
+			case xml::ELEMENT_START:	handleElementStart();		break;
+			case xml::ELEMENT_END:		handleElementEnd();			break;
+			case xml::ELEMENT_DATA:		handleData();				break;
+
+			default:
+				DE_ASSERT(false);
+		}
+
+		resultChanged = true;
+		m_xmlParser.advance();
+	}
+
+	return resultChanged;
+}
+
+//! Parse XML records of binary log. Records are handled in place, only incomplete record at end is buffered.
+bool TestResultParser::parseBinary (const deUint8* bytes, int numBytes)
+{
+	const bool		isBuffered		= !m_binaryBuf.empty();
+	bool			resultChanged	= false;
+	size_t			pos				= 0;
+
+	if (isBuffered)
+		m_binaryBuf.insert(m_binaryBuf.end(), bytes, bytes+numBytes);
+
+	{
+		const deUint8* const	data		= isBuffered ? &m_binaryBuf[0] : bytes;
+		const size_t			dataSize	= isBuffered ? m_binaryBuf.size() : (size_t)numBytes;
+
+		while (dataSize - pos >= BINARY_LOG_RECORD_HEADER_SIZE)
+		{
+			const size_t payloadSize = (size_t)readBinaryLogUint32(data + pos + 1);
+
+			if (dataSize - pos - BINARY_LOG_RECORD_HEADER_SIZE < payloadSize)
+				break; // Incomplete record.
+
+			handleBinaryRecord(data + pos, BINARY_LOG_RECORD_HEADER_SIZE + payloadSize);
+
+			resultChanged	= true;
+			pos				+= BINARY_LOG_RECORD_HEADER_SIZE + payloadSize;
+		}
+
+		if (isBuffered)
+			m_binaryBuf.erase(m_binaryBuf.begin(), m_binaryBuf.begin() + pos);
+		else
+			m_binaryBuf.assign(data + pos, data + dataSize);
+	}
+
+	return resultChanged;
+}
+
+void TestResultParser::handleBinaryRecord (const deUint8* record, size_t recordSize)
+{
+	const deUint8* const	payload		= record + BINARY_LOG_RECORD_HEADER_SIZE;
+	const size_t			payloadSize	= recordSize - BINARY_LOG_RECORD_HEADER_SIZE;
+	BinaryLogRecordReader	reader		(payload, payloadSize);
+
+	switch (record[0])
+	{
+		case BINARYLOGRECORD_XML_START_DOCUMENT:
+		case BINARYLOGRECORD_XML_END_DOCUMENT:
+			break;
+
+		case BINARYLOGRECORD_XML_START_ELEMENT:
+		{
+			m_binaryElementName = reader.readString();
+
+			const deUint32 numAttribs = reader.readUint32();
+
+			m_binaryAttributes.resize(numAttribs);
+
+			for (deUint32 attribNdx = 0; attribNdx < numAttribs; attribNdx++)
+			{
+				m_binaryAttributes[attribNdx].first		= reader.readString();
+				m_binaryAttributes[attribNdx].second	= reader.readString();
+			}
+
+			handleElementStart();
+			break;
+		}
+
+		case BINARYLOGRECORD_XML_END_ELEMENT:
+			m_binaryElementName = reader.readString();
+			m_binaryAttributes.clear();
+			handleElementEnd();
+			break;
+
+		case BINARYLOGRECORD_XML_STRING:
+			handleBinaryString(payload, payloadSize);
+			break;
+
+		case BINARYLOGRECORD_XML_DATA:
+			handleBinaryData(payload, payloadSize);
+			break;
+
+		default:
+			throw TestResultParseError("Unexpected record in binary test case data");
+	}
+}
+
+const char* TestResultParser::getElementName (void) const
+{
+	if (m_dataFormat == TESTCASEDATAFORMAT_BINARY)
+		return m_binaryElementName.c_str();
+	else
+		return m_xmlParser.getElementName();
+}
+
+const string* TestResultParser::findBinaryAttribute (const char* name) const
+{
+	for (vector<Attribute>::const_iterator attrib = m_binaryAttributes.begin(); attrib != m_binaryAttributes.end(); ++attrib)
+	{
+		if (attrib->first == name)
+			return &attrib->second;
+	}
+
+	return DE_NULL;
+}
+
+bool TestResultParser::hasAttribute (const char* name) const
+{
+	if (m_dataFormat == TESTCASEDATAFORMAT_BINARY)
+		return findBinaryAttribute(name) != DE_NULL;
+	else
+		return m_xmlParser.hasAttribute(name);
 }
 
 const char* TestResultParser::getAttribute (const char* name)
 {
-	if (!m_xmlParser.hasAttribute(name))
-		throw TestResultParseError(string("Missing attribute '") + name + "' in <" + m_xmlParser.getElementName() + ">");
+	if (!hasAttribute(name))
+		throw TestResultParseError(string("Missing attribute '") + name + "' in <" + getElementName() + ">");
 
-	return m_xmlParser.getAttribute(name);
+	if (m_dataFormat == TESTCASEDATAFORMAT_BINARY)
+		return findBinaryAttribute(name)->c_str();
+	else
+		return m_xmlParser.getAttribute(name);
 }
 
 ri::Item* TestResultParser::getCurrentItem (void)
@@ -438,7 +597,7 @@ void TestResultParser::popItem (void)
 
 void TestResultParser::handleElementStart (void)
 {
-	const char* elemName = m_xmlParser.getElementName();
+	const char* elemName = getElementName();
 
 	if (m_state == STATE_INITIALIZED)
 	{
@@ -453,8 +612,8 @@ void TestResultParser::handleElementStart (void)
 		m_result->casePath	= getAttribute("CasePath");
 		m_result->caseType	= TESTCASETYPE_SELF_VALIDATE;
 
-		if (m_xmlParser.hasAttribute("CaseType"))
-			m_result->caseType = getTestCaseType(m_xmlParser.getAttribute("CaseType"));
+		if (hasAttribute("CaseType"))
+			m_result->caseType = getTestCaseType(getAttribute("CaseType"));
 		else
 		{
 			// Do guess based on path for legacy log files.
@@ -503,8 +662,8 @@ void TestResultParser::handleElementStart (void)
 				number->description	= getAttribute("Description");
 				number->unit		= getAttribute("Unit");
 
-				if (m_xmlParser.hasAttribute("Tag"))
-					number->tag = m_xmlParser.getAttribute("Tag");
+				if (hasAttribute("Tag"))
+					number->tag = getAttribute("Tag");
 
 				item = number;
 
@@ -523,13 +682,35 @@ void TestResultParser::handleElementStart (void)
 
 			case ri::TYPE_IMAGE:
 			{
+				if (hasAttribute("Ref") && !findImageBlob(getAttribute("Ref")))
+					throw TestResultParseError(string("Unresolved image reference '") + getAttribute("Ref") + "'");
+
 				ri::Image* image = curList->allocItem<ri::Image>();
 				image->name			= getAttribute("Name");
 				image->description	= getAttribute("Description");
-				image->width		= toInt(getAttribute("Width"));
-				image->height		= toInt(getAttribute("Height"));
-				image->format		= getImageFormat(getAttribute("Format"));
-				image->compression	= getImageCompression(getAttribute("CompressionMode"));
+
+				if (hasAttribute("Ref"))
+				{
+					// Deduplicated image, contents were logged earlier with matching Hash.
+					const ImageBlob* blob = findImageBlob(getAttribute("Ref"));
+
+					image->width		= blob->width;
+					image->height		= blob->height;
+					image->format		= blob->format;
+					image->compression	= blob->compression;
+					image->data			= blob->data;
+				}
+				else
+				{
+					image->width		= toInt(getAttribute("Width"));
+					image->height		= toInt(getAttribute("Height"));
+					image->format		= getImageFormat(getAttribute("Format"));
+					image->compression	= getImageCompression(getAttribute("CompressionMode"));
+
+					if (hasAttribute("Hash"))
+						m_curImageHash = getAttribute("Hash");
+				}
+
 				item = image;
 				break;
 			}
@@ -592,7 +773,7 @@ void TestResultParser::handleElementStart (void)
 			{
 				ri::EglConfigSet* set = curList->allocItem<ri::EglConfigSet>();
 				set->name			= getAttribute("Name");
-				set->description	= m_xmlParser.hasAttribute("Description") ? m_xmlParser.getAttribute("Description") : "";
+				set->description	= hasAttribute("Description") ? getAttribute("Description") : "";
 				item = set;
 				break;
 			}
@@ -667,7 +848,7 @@ void TestResultParser::handleElementStart (void)
 				valueInfo->description	= getAttribute("Description");
 				valueInfo->tag			= getSampleValueTag(getAttribute("Tag"));
 
-				if (m_xmlParser.hasAttribute("Unit"))
+				if (hasAttribute("Unit"))
 					valueInfo->unit = getAttribute("Unit");
 
 				item = valueInfo;
@@ -712,7 +893,7 @@ void TestResultParser::handleElementStart (void)
 
 void TestResultParser::handleElementEnd (void)
 {
-	const char* elemName = m_xmlParser.getElementName();
+	const char* elemName = getElementName();
 
 	if (m_state != STATE_IN_TEST_CASE_RESULT)
 		throw TestResultParseError(string("Unexpected </") + elemName + "> outside of <TestCaseResult>");
@@ -724,6 +905,8 @@ void TestResultParser::handleElementEnd (void)
 		// \todo [2012-11-22 pyry] Log warning.
 
 		m_state = STATE_TEST_CASE_RESULT_ENDED;
+
+		commitCaseImages();
 	}
 	else
 	{
@@ -752,105 +935,190 @@ void TestResultParser::handleElementEnd (void)
 			value->value = getNumericValue(m_curNumValue);
 			m_curNumValue.clear();
 		}
+		else if (itemType == ri::TYPE_IMAGE && !m_curImageHash.empty())
+		{
+			// Store image for later references.
+			const ri::Image*	image	= static_cast<const ri::Image*>(curItem);
+			ImageBlob&			blob	= m_caseImageBlobs[m_curImageHash];
+
+			blob.width			= image->width;
+			blob.height			= image->height;
+			blob.format			= image->format;
+			blob.compression	= image->compression;
+			blob.data			= image->data;
+
+			m_caseImageOrder.push_back(ImageBlobEntry(m_curImageHash, image->data.size()));
+			m_curImageHash.clear();
+		}
 
 		popItem();
 	}
 }
 
-void TestResultParser::handleData (void)
+const TestResultParser::ImageBlob* TestResultParser::findImageBlob (const std::string& hash) const
+{
+	ImageBlobMap::const_iterator blob = m_caseImageBlobs.find(hash);
+
+	if (blob != m_caseImageBlobs.end())
+		return &blob->second;
+
+	blob = m_imageBlobs.find(hash);
+
+	return blob != m_imageBlobs.end() ? &blob->second : DE_NULL;
+}
+
+//! Make images of completed result referenceable by later results.
+//! Oldest images are dropped in the same order as qpTestLog stops referencing them.
+void TestResultParser::commitCaseImages (void)
+{
+	for (std::vector<ImageBlobEntry>::const_iterator entry = m_caseImageOrder.begin(); entry != m_caseImageOrder.end(); ++entry)
+	{
+		const ImageBlobMap::iterator caseBlob = m_caseImageBlobs.find(entry->first);
+
+		if (caseBlob != m_caseImageBlobs.end())
+		{
+			std::swap(m_imageBlobs[entry->first], caseBlob->second);
+			m_caseImageBlobs.erase(caseBlob);
+		}
+
+		m_imageBlobOrder.push_back(*entry);
+		m_imageBlobBytes += entry->second;
+	}
+
+	m_caseImageBlobs.clear();
+	m_caseImageOrder.clear();
+
+	while (m_imageBlobBytes > (size_t)MAX_REFERENCEABLE_IMAGE_BYTES)
+	{
+		m_imageBlobs.erase(m_imageBlobOrder.front().first);
+		m_imageBlobBytes -= m_imageBlobOrder.front().second;
+		m_imageBlobOrder.pop_front();
+	}
+}
+
+//! Get string that data of current item is appended to, or null if item has no text data.
+string* TestResultParser::getCurrentItemDataStr (void)
 {
 	ri::Item*	curItem		= getCurrentItem();
 	ri::Type	type		= curItem ? curItem->getType() : ri::TYPE_LAST;
 
 	switch (type)
 	{
-		case ri::TYPE_RESULT:
-			m_xmlParser.appendDataStr(static_cast<ri::Result*>(curItem)->details);
-			break;
+		case ri::TYPE_RESULT:			return &static_cast<ri::Result*>(curItem)->details;
+		case ri::TYPE_TEXT:				return &static_cast<ri::Text*>(curItem)->text;
+		case ri::TYPE_SHADERSOURCE:		return &static_cast<ri::ShaderSource*>(curItem)->source;
+		case ri::TYPE_INFOLOG:			return &static_cast<ri::InfoLog*>(curItem)->log;
+		case ri::TYPE_KERNELSOURCE:		return &static_cast<ri::KernelSource*>(curItem)->source;
 
-		case ri::TYPE_TEXT:
-			m_xmlParser.appendDataStr(static_cast<ri::Text*>(curItem)->text);
-			break;
+		case ri::TYPE_NUMBER:
+		case ri::TYPE_SAMPLEVALUE:
+			return &m_curNumValue;
 
-		case ri::TYPE_SHADERSOURCE:
-			m_xmlParser.appendDataStr(static_cast<ri::ShaderSource*>(curItem)->source);
-			break;
+		default:
+			return DE_NULL;
+	}
+}
 
-		case ri::TYPE_INFOLOG:
-			m_xmlParser.appendDataStr(static_cast<ri::InfoLog*>(curItem)->log);
-			break;
+void TestResultParser::handleData (void)
+{
+	ri::Item*	curItem		= getCurrentItem();
+	string*		dataStr		= getCurrentItemDataStr();
 
-		case ri::TYPE_KERNELSOURCE:
-			m_xmlParser.appendDataStr(static_cast<ri::KernelSource*>(curItem)->source);
-			break;
+	if (dataStr)
+		m_xmlParser.appendDataStr(*dataStr);
+	else if (curItem && curItem->getType() == ri::TYPE_IMAGE)
+	{
+		ri::Image* image = static_cast<ri::Image*>(curItem);
 
-		case ri::TYPE_NUMBER:
-		case ri::TYPE_SAMPLEVALUE:
-			m_xmlParser.appendDataStr(m_curNumValue);
-			break;
+		// Base64 decode.
+		int numBytesIn = m_xmlParser.getDataSize();
 
-		case ri::TYPE_IMAGE:
+		for (int inNdx = 0; inNdx < numBytesIn; inNdx++)
 		{
-			ri::Image* image = static_cast<ri::Image*>(curItem);
+			deUint8		byte		= m_xmlParser.getDataByte(inNdx);
+			deUint8		decodedBits	= 0;
+
+			if (de::inRange<deInt8>(byte, 'A', 'Z'))
+				decodedBits = byte - 'A';
+			else if (de::inRange<deInt8>(byte, 'a', 'z'))
+				decodedBits = ('Z'-'A'+1) + (byte-'a');
+			else if (de::inRange<deInt8>(byte, '0', '9'))
+				decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + (byte-'0');
+			else if (byte == '+')
+				decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + ('9'-'0'+1);
+			else if (byte == '/')
+				decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + ('9'-'0'+2);
+			else if (byte == '=')
+			{
+				// Padding at end - remove last byte.
+				if (image->data.empty())
+					throw TestResultParseError("Malformed base64 data");
+				image->data.pop_back();
+				continue;
+			}
+			else
+				continue; // Not an B64 input character.
 
-			// Base64 decode.
-			int numBytesIn = m_xmlParser.getDataSize();
+			int phase = m_base64DecodeOffset % 4;
 
-			for (int inNdx = 0; inNdx < numBytesIn; inNdx++)
-			{
-				deUint8		byte		= m_xmlParser.getDataByte(inNdx);
-				deUint8		decodedBits	= 0;
-
-				if (de::inRange<deInt8>(byte, 'A', 'Z'))
-					decodedBits = byte - 'A';
-				else if (de::inRange<deInt8>(byte, 'a', 'z'))
-					decodedBits = ('Z'-'A'+1) + (byte-'a');
-				else if (de::inRange<deInt8>(byte, '0', '9'))
-					decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + (byte-'0');
-				else if (byte == '+')
-					decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + ('9'-'0'+1);
-				else if (byte == '/')
-					decodedBits = ('Z'-'A'+1) + ('z'-'a'+1) + ('9'-'0'+2);
-				else if (byte == '=')
-				{
-					// Padding at end - remove last byte.
-					if (image->data.empty())
-						throw TestResultParseError("Malformed base64 data");
-					image->data.pop_back();
-					continue;
-				}
-				else
-					continue; // Not an B64 input character.
+			if (phase == 0)
+				image->data.resize(image->data.size()+3, 0);
 
-				int phase = m_base64DecodeOffset % 4;
+			if ((int)image->data.size() < (m_base64DecodeOffset>>2)*3 + 3)
+				throw TestResultParseError("Malformed base64 data");
+			deUint8* outPtr = &image->data[(m_base64DecodeOffset>>2)*3];
+
+			switch (phase)
+			{
+				case 0: outPtr[0] |= decodedBits<<2;											break;
+				case 1: outPtr[0] |= (decodedBits>>4);	outPtr[1] |= ((decodedBits&0xF)<<4);	break;
+				case 2: outPtr[1] |= (decodedBits>>2);	outPtr[2] |= ((decodedBits&0x3)<<6);	break;
+				case 3: outPtr[2] |= decodedBits;												break;
+				default:
+					DE_ASSERT(false);
+			}
 
-				if (phase == 0)
-					image->data.resize(image->data.size()+3, 0);
+			m_base64DecodeOffset += 1;
+		}
+	}
+	// Other data is just ignored.
+}
 
-				if ((int)image->data.size() < (m_base64DecodeOffset>>2)*3 + 3)
-					throw TestResultParseError("Malformed base64 data");
-				deUint8* outPtr = &image->data[(m_base64DecodeOffset>>2)*3];
+//! Append unescaped string of binary log. String ends at first null byte and control characters are named as in text logs.
+void TestResultParser::handleBinaryString (const deUint8* bytes, size_t numBytes)
+{
+	string* const dataStr = getCurrentItemDataStr();
 
-				switch (phase)
-				{
-					case 0: outPtr[0] |= decodedBits<<2;											break;
-					case 1: outPtr[0] |= (decodedBits>>4);	outPtr[1] |= ((decodedBits&0xF)<<4);	break;
-					case 2: outPtr[1] |= (decodedBits>>2);	outPtr[2] |= ((decodedBits&0x3)<<6);	break;
-					case 3: outPtr[2] |= decodedBits;												break;
-					default:
-						DE_ASSERT(false);
-				}
+	if (!dataStr)
+		return; // Just ignore data.
 
-				m_base64DecodeOffset += 1;
-			}
+	for (size_t ndx = 0; ndx < numBytes && bytes[ndx] != 0; ndx++)
+	{
+		const char			c		= (char)bytes[ndx];
+		const char* const	name	= getControlCharacterName(c);
 
-			break;
+		if (name)
+		{
+			*dataStr += '<';
+			*dataStr += name;
+			*dataStr += '>';
 		}
+		else
+			*dataStr += c;
+	}
+}
 
-		default:
-			// Just ignore data.
-			break;
+//! Append raw data of binary log, which text logs have base64 encoded.
+void TestResultParser::handleBinaryData (const deUint8* bytes, size_t numBytes)
+{
+	ri::Item* curItem = getCurrentItem();
+
+	if (curItem && curItem->getType() == ri::TYPE_IMAGE)
+	{
+		ri::Image* image = static_cast<ri::Image*>(curItem);
+		image->data.insert(image->data.end(), bytes, bytes + numBytes);
 	}
+	// Other data is just ignored.
 }
 
 //! Helper for parsing TestCaseResult from TestCaseResultData.
@@ -866,7 +1134,7 @@ void parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* resu
 
 	if (data.getDataSize() > 0)
 	{
-		parser->init(result);
+		parser->init(result, data.getDataFormat());
 
 		const TestResultParser::ParseResult parseResult = parser->parse(data.getData(), data.getDataSize());
 
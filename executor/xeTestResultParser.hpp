@@ -26,8 +26,12 @@
 #include "xeDefs.hpp"
 #include "xeXMLParser.hpp"
 #include "xeTestCaseResult.hpp"
+#include "xeBatchResult.hpp"
 
 #include <vector>
+#include <map>
+#include <deque>
+#include <string>
 
 namespace xe
 {
@@ -39,6 +43,7 @@ enum TestLogVersion
 	TESTLOGVERSION_0_3_1,
 	TESTLOGVERSION_0_3_2,
 	TESTLOGVERSION_0_3_3,
+	TESTLOGVERSION_0_3_4,
 
 	TESTLOGVERSION_LAST
 };
@@ -66,6 +71,7 @@ public:
 							~TestResultParser			(void);
 
 	void					init						(TestCaseResult* dstResult);
+	void					init						(TestCaseResult* dstResult, TestCaseDataFormat dataFormat);
 	ParseResult				parse						(const deUint8* bytes, int numBytes);
 
 private:
@@ -74,11 +80,22 @@ private:
 
 	void					clear						(void);
 
+	bool					parseXml					(const deUint8* bytes, int numBytes);
+	bool					parseBinary					(const deUint8* bytes, int numBytes);
+	void					handleBinaryRecord			(const deUint8* record, size_t recordSize);
+
 	void					handleElementStart			(void);
 	void					handleElementEnd			(void);
 	void					handleData					(void);
+	void					handleBinaryString			(const deUint8* bytes, size_t numBytes);
+	void					handleBinaryData			(const deUint8* bytes, size_t numBytes);
 
+	const char*				getElementName				(void) const;
+	bool					hasAttribute				(const char* name) const;
 	const char*				getAttribute				(const char* name);
+	const std::string*		findBinaryAttribute			(const char* name) const;
+
+	std::string*			getCurrentItemDataStr		(void);
 
 	ri::Item*				getCurrentItem				(void);
 	ri::List*				getCurrentItemList			(void);
@@ -86,6 +103,8 @@ private:
 	void					popItem						(void);
 	void					updateCurrentItemList		(void);
 
+	void					commitCaseImages			(void);
+
 	enum State
 	{
 		STATE_NOT_INITIALIZED = 0,
@@ -96,9 +115,29 @@ private:
 		STATE_LAST
 	};
 
+	struct ImageBlob
+	{
+		int							width;
+		int							height;
+		ri::Image::Format			format;
+		ri::Image::Compression		compression;
+		std::vector<deUint8>		data;
+	};
+
+	typedef std::map<std::string, ImageBlob>		ImageBlobMap;
+	typedef std::pair<std::string, size_t>			ImageBlobEntry;		//!< Hash and data size.
+	typedef std::pair<std::string, std::string>		Attribute;
+
+	const ImageBlob*		findImageBlob				(const std::string& hash) const;
+
+	TestCaseDataFormat		m_dataFormat;
 	xml::Parser				m_xmlParser;
 	TestCaseResult*			m_result;
 
+	std::vector<deUint8>	m_binaryBuf;		//!< Incomplete binary record.
+	std::string				m_binaryElementName;
+	std::vector<Attribute>	m_binaryAttributes;
+
 	State					m_state;
 	TestLogVersion			m_logVersion;		//!< Only valid in STATE_IN_TEST_CASE_RESULT.
 
@@ -108,6 +147,14 @@ private:
 	int						m_base64DecodeOffset;
 
 	std::string				m_curNumValue;
+	std::string				m_curImageHash;		//!< Hash of image being parsed, empty if image is not referenceable.
+
+	ImageBlobMap				m_caseImageBlobs;	//!< Referenceable images of current test case result.
+	std::vector<ImageBlobEntry>	m_caseImageOrder;
+
+	ImageBlobMap				m_imageBlobs;		//!< Referenceable images of completed test case results.
+	std::deque<ImageBlobEntry>	m_imageBlobOrder;	//!< Oldest first.
+	size_t						m_imageBlobBytes;
 };
 
 // Helpers exposed to other parsers.
@@ -115,8 +162,6 @@ TestStatusCode	getTestStatusCode			(const char* statusCode);
 
 // Parsing helpers.
 
-class TestCaseResultData;
-
 void			parseTestCaseResultFromData	(TestResultParser* parser, TestCaseResult* result, const TestCaseResultData& data);
 
 } // xe
@@ -28,6 +28,11 @@
 #include "tcuTestHierarchyUtil.hpp"
 #include "tcuCommandLine.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuImageCompare.hpp"
+#include "tcuImageCompareThreads.hpp"
+#include "tcuRefRenderThreads.hpp"
+#include "tcuDecompressedTextureCache.hpp"
+#include "deStringUtil.hpp"
 #include "qpInfo.h"
 #include "qpDebugOut.h"
 #include "deMath.h"
@@ -70,6 +75,44 @@ App::App (Platform& platform, Archive& archive, TestLog& log, const CommandLine&
 		if (cmdLine.isCrashHandlingEnabled())
 			TCU_CHECK_INTERNAL(m_crashHandler = qpCrashHandler_create(onCrash, this));
 
+		// Configure image comparison and reference renderer threads.
+		setImageCompareNumThreads(cmdLine.getCompareThreadCount());
+		setRefRenderNumThreads(cmdLine.getRefRenderThreadCount());
+
+		// Configure image comparison time logging.
+		setImageCompareTimeLogging(cmdLine.isCompareTimeLoggingEnabled());
+
+		// Configure decompressed texture cache.
+		setDecompressedTextureCacheSize((size_t)de::max(cmdLine.getDecompressionCacheSize(), 0) * 1024 * 1024);
+
+		// Configure background compression of logged images.
+		{
+			qpImageEncoderConfig imageEncoderConfig;
+
+			qpImageEncoderConfig_init(&imageEncoderConfig);
+
+			imageEncoderConfig.numThreads		= de::max(cmdLine.getLogImageThreadCount(), 0);
+			imageEncoderConfig.compressionLevel	= de::clamp(cmdLine.getLogImageCompressionLevel(), -1, 9);
+			imageEncoderConfig.strategy			= cmdLine.getLogImageCompressionStrategy();
+			imageEncoderConfig.maxPendingBytes	= (size_t)de::max(cmdLine.getLogImageMemoryBudget(), 0) * 1024 * 1024;
+
+			log.setImageEncoderConfig(imageEncoderConfig);
+		}
+
+		// Configure test log output buffering.
+		{
+			qpTestLogBufferConfig bufferConfig;
+
+			qpTestLogBufferConfig_init(&bufferConfig);
+
+			bufferConfig.bufferSize			= (size_t)de::max(cmdLine.getLogBufferSize(), 0) * 1024 * 1024;
+			bufferConfig.flushPolicy		= cmdLine.getLogFlushPolicy();
+			bufferConfig.flushNumCases		= de::max(cmdLine.getLogFlushCaseCount(), 1);
+			bufferConfig.flushIntervalMs	= de::max(cmdLine.getLogFlushInterval(), 0);
+
+			log.setBufferConfig(bufferConfig);
+		}
+
 		// Create test context
 		m_testCtx = new TestContext(m_platform, archive, log, cmdLine, m_watchDog);
 
@@ -104,6 +147,8 @@ void App::cleanup (void)
 	delete m_testRoot;
 	delete m_testCtx;
 
+	clearDecompressedTextureCache();
+
 	if (m_crashHandler)
 		qpCrashHandler_destroy(m_crashHandler);
 
@@ -161,6 +206,19 @@ bool App::iterate (void)
 			print("  Warnings:      %d/%d (%.1f%%)\n", result.numWarnings,		result.numExecuted, (result.numExecuted > 0 ? (100.0f * result.numWarnings		/ result.numExecuted) : 0.0f));
 			if (!result.isComplete)
 				print("Test run was ABORTED!\n");
+
+			// Report decompressed texture cache usage.
+			{
+				const DecompressedTextureCacheStats cacheStats = getDecompressedTextureCacheStats();
+
+				if (cacheStats.numHits + cacheStats.numMisses > 0)
+				{
+					print("\nDecompressed texture cache:\n");
+					print("  Hits:          %s/%s\n", de::toString(cacheStats.numHits).c_str(), de::toString(cacheStats.numHits + cacheStats.numMisses).c_str());
+					print("  Evictions:     %s\n", de::toString(cacheStats.numEvictions).c_str());
+					print("  Size:          %s bytes in %d textures\n", de::toString(cacheStats.numBytes).c_str(), cacheStats.numEntries);
+				}
+			}
 		}
 	}
 
@@ -221,8 +279,14 @@ void App::onCrash (void)
 		m_testCtx->getLog().terminateCase(QP_TEST_RESULT_CRASH);
 	}
 	else
+	{
 		qpCrashHandler_writeCrashInfo(m_crashHandler, writeCrashToConsole, DE_NULL);
 
+		// Don't lose results of completed cases that are still buffered.
+		if (m_testCtx)
+			m_testCtx->getLog().flush();
+	}
+
 	die("Test program crashed");
 }
 
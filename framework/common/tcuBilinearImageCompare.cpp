@@ -25,6 +25,10 @@
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuRGBA.hpp"
+#include "tcuImageCompareThreads.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace tcu
 {
@@ -188,6 +192,51 @@ bool comparePixelRGBA8 (const ConstPixelBufferAccess& reference, const ConstPixe
 	return false;
 }
 
+class BilinearCompareRGBA8Job : public RowBandJob
+{
+public:
+	BilinearCompareRGBA8Job (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const RGBA threshold, int numBands)
+		: m_reference	(reference)
+		, m_result		(result)
+		, m_errorMask	(errorMask)
+		, m_threshold	(threshold)
+		, m_bandOk		(numBands, DE_TRUE)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		bool allOk = true;
+
+		for (int y = beginRow; y < endRow; y++)
+		{
+			for (int x = 0; x < m_reference.getWidth(); x++)
+			{
+				if (!comparePixelRGBA8(m_reference, m_result, m_threshold, x, y) &&
+					!comparePixelRGBA8(m_result, m_reference, m_threshold, x, y))
+				{
+					allOk = false;
+					m_errorMask.setPixel(Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y);
+				}
+			}
+		}
+
+		m_bandOk[bandNdx] = allOk ? DE_TRUE : DE_FALSE;
+	}
+
+	bool isOk (void) const
+	{
+		return std::find(m_bandOk.begin(), m_bandOk.end(), (deBool)DE_FALSE) == m_bandOk.end();
+	}
+
+private:
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+	const PixelBufferAccess&		m_errorMask;
+	const RGBA						m_threshold;
+	std::vector<deBool>				m_bandOk;	//!< \note Not vector<bool>, bands are written concurrently.
+};
+
 bool bilinearCompareRGBA8 (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const RGBA threshold)
 {
 	DE_ASSERT(reference.getFormat() == TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8) &&
@@ -196,22 +245,13 @@ bool bilinearCompareRGBA8 (const ConstPixelBufferAccess& reference, const ConstP
 	// Clear error mask first to green (faster this way).
 	clear(errorMask, Vec4(0.0f, 1.0f, 0.0f, 1.0f));
 
-	bool allOk = true;
+	const int				numRows		= reference.getHeight();
+	const int				numBands	= getNumRowBands(numRows, reference.getWidth());
+	BilinearCompareRGBA8Job	job			(reference, result, errorMask, threshold, numBands);
 
-	for (int y = 0; y < reference.getHeight(); y++)
-	{
-		for (int x = 0; x < reference.getWidth(); x++)
-		{
-			if (!comparePixelRGBA8(reference, result, threshold, x, y) &&
-				!comparePixelRGBA8(result, reference, threshold, x, y))
-			{
-				allOk = false;
-				errorMask.setPixel(Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y);
-			}
-		}
-	}
+	executeRowBands(job, numRows, numBands);
 
-	return allOk;
+	return job.isOk();
 }
 
 } // anonymous
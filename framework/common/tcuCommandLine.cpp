@@ -27,6 +27,7 @@
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
 #include "deString.h"
+#include "deMemory.h"
 #include "deInt32.h"
 #include "deCommandLine.h"
 #include "qpTestLog.h"
@@ -37,6 +38,7 @@
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 
 using std::string;
 using std::vector;
@@ -80,7 +82,23 @@ DE_DECLARE_COMMAND_LINE_OPT(EGLDisplayType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(EGLWindowType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(EGLPixmapType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(LogImages,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogDedupImages,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(TestOOM,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(RefRenderThreads,	int);
+DE_DECLARE_COMMAND_LINE_OPT(CompareThreads,		int);
+DE_DECLARE_COMMAND_LINE_OPT(LogCompareTime,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(DecompressionCacheSize,	int);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageThreads,	int);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageCompressionLevel,	int);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageCompressionStrategy,	qpImageCompressionStrategy);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageMemory,		int);
+DE_DECLARE_COMMAND_LINE_OPT(ResourcePack,		std::string);
+DE_DECLARE_COMMAND_LINE_OPT(CaseListCacheDir,	std::string);
+DE_DECLARE_COMMAND_LINE_OPT(LogBufferSize,		int);
+DE_DECLARE_COMMAND_LINE_OPT(LogFlushPolicy,		qpTestLogFlushPolicy);
+DE_DECLARE_COMMAND_LINE_OPT(LogFlushCases,		int);
+DE_DECLARE_COMMAND_LINE_OPT(LogFlushInterval,	int);
+DE_DECLARE_COMMAND_LINE_OPT(LogBinaryFormat,	bool);
 
 static void parseIntList (const char* src, std::vector<int>* dst)
 {
@@ -132,6 +150,25 @@ void registerOptions (de::cmdline::Parser& parser)
 		{ "180",			SCREENROTATION_180			},
 		{ "270",			SCREENROTATION_270			}
 	};
+	static const NamedValue<qpImageCompressionStrategy> s_imageCompressionStrategies[] =
+	{
+		{ "default",		QP_IMAGE_COMPRESSION_STRATEGY_DEFAULT		},
+		{ "filtered",		QP_IMAGE_COMPRESSION_STRATEGY_FILTERED		},
+		{ "huffman",		QP_IMAGE_COMPRESSION_STRATEGY_HUFFMAN_ONLY	},
+		{ "rle",			QP_IMAGE_COMPRESSION_STRATEGY_RLE			}
+	};
+	static const NamedValue<bool> s_logFormats[] =
+	{
+		{ "xml",			false										},
+		{ "binary",			true										}
+	};
+	static const NamedValue<qpTestLogFlushPolicy> s_logFlushPolicies[] =
+	{
+		{ "case",			QP_TEST_LOG_FLUSH_POLICY_CASE				},
+		{ "cases",			QP_TEST_LOG_FLUSH_POLICY_NUM_CASES			},
+		{ "time",			QP_TEST_LOG_FLUSH_POLICY_TIME				},
+		{ "crash",			QP_TEST_LOG_FLUSH_POLICY_CRASH				}
+	};
 
 	parser
 		<< Option<CasePath>				("n",		"deqp-case",					"Test case(s) to run, supports wildcards (e.g. dEQP-GLES2.info.*)")
@@ -161,7 +198,23 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<EGLWindowType>		(DE_NULL,	"deqp-egl-window-type",			"EGL native window type")
 		<< Option<EGLPixmapType>		(DE_NULL,	"deqp-egl-pixmap-type",			"EGL native pixmap type")
 		<< Option<LogImages>			(DE_NULL,	"deqp-log-images",				"Enable or disable logging of result images",		s_enableNames,		"enable")
-		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT);
+		<< Option<LogDedupImages>		(DE_NULL,	"deqp-log-dedup-images",		"Write identical images once and reference them afterwards",	s_enableNames,	"disable")
+		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT)
+		<< Option<RefRenderThreads>		(DE_NULL,	"deqp-refrender-threads",		"Number of reference renderer threads (0 = number of logical cores)",	"1")
+		<< Option<CompareThreads>		(DE_NULL,	"deqp-compare-threads",			"Number of image comparison threads (0 = number of logical cores)",		"1")
+		<< Option<LogCompareTime>		(DE_NULL,	"deqp-log-compare-time",		"Log time taken by image comparisons",				s_enableNames,		"disable")
+		<< Option<DecompressionCacheSize>	(DE_NULL,	"deqp-decompression-cache-size",	"Decompressed texture cache size in megabytes (0 = disabled)",			"64")
+		<< Option<LogImageThreads>		(DE_NULL,	"deqp-log-image-threads",		"Number of threads compressing logged images in background (0 = compress synchronously)",	"0")
+		<< Option<LogImageCompressionLevel>	(DE_NULL,	"deqp-log-image-compression-level",	"PNG compression level of logged images (0-9, -1 = default)",			"-1")
+		<< Option<LogImageCompressionStrategy>	(DE_NULL,	"deqp-log-image-compression-strategy",	"PNG compression strategy of logged images",	s_imageCompressionStrategies,	"default")
+		<< Option<LogImageMemory>		(DE_NULL,	"deqp-log-image-memory",		"Memory budget in megabytes for images compressed in background",		"64")
+		<< Option<ResourcePack>			(DE_NULL,	"deqp-resource-pack",			"Load test resources from given pack file instead of data directory")
+		<< Option<CaseListCacheDir>		(DE_NULL,	"deqp-caselist-cache-dir",		"Reuse and update test hierarchy cache in given directory when writing case lists")
+		<< Option<LogBufferSize>		(DE_NULL,	"deqp-log-buffer-size",			"Test log output buffer size in megabytes, written in background (0 = write directly to file)",	"0")
+		<< Option<LogFlushPolicy>		(DE_NULL,	"deqp-log-flush",				"When to flush test log: every case, every N cases, at time interval, or only on crash and exit",	s_logFlushPolicies,	"case")
+		<< Option<LogFlushCases>		(DE_NULL,	"deqp-log-flush-cases",			"Number of test cases between test log flushes with --deqp-log-flush=cases",	"100")
+		<< Option<LogFlushInterval>		(DE_NULL,	"deqp-log-flush-interval",		"Minimum interval in milliseconds between test log flushes with --deqp-log-flush=time",	"1000")
+		<< Option<LogBinaryFormat>		(DE_NULL,	"deqp-log-format",				"Test log format, binary logs can be converted to XML with testlog-to-qpa",	s_logFormats,	"xml");
 }
 
 void registerLegacyOptions (de::cmdline::Parser& parser)
@@ -233,10 +286,18 @@ void DebugOutStreambuf::flushLine (void)
 	m_curLine.str("");
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Case list trie node
+ *
+ * Children are kept sorted by name hash so that lookups don't need to
+ * compare every child name. Lookups by (name, length) don't allocate,
+ * which allows walking the trie directly with components of a dotted
+ * case path.
+ *//*--------------------------------------------------------------------*/
 class CaseTreeNode
 {
 public:
-										CaseTreeNode		(const std::string& name) : m_name(name) {}
+										CaseTreeNode		(const std::string& name);
 										~CaseTreeNode		(void);
 
 	const std::string&					getName				(void) const { return m_name;				}
@@ -245,8 +306,9 @@ public:
 	bool								hasChild			(const std::string& name) const;
 	const CaseTreeNode*					getChild			(const std::string& name) const;
 	CaseTreeNode*						getChild			(const std::string& name);
+	const CaseTreeNode*					getChild			(const char* name, int nameLen) const;
 
-	void								addChild			(CaseTreeNode* child) { m_children.push_back(child); }
+	void								addChild			(CaseTreeNode* child);
 
 private:
 										CaseTreeNode		(const CaseTreeNode&);
@@ -254,43 +316,69 @@ private:
 
 	enum { NOT_FOUND = -1 };
 
-	// \todo [2014-10-30 pyry] Speed up with hash / sorting
-	int									findChildNdx		(const std::string& name) const;
+	static deUint32						hashName			(const char* name, int nameLen) { return deMemoryHash(name, nameLen); }
+	static bool							compareHash			(const CaseTreeNode* node, deUint32 hash) { return node->m_nameHash < hash; }
+
+	int									findChildNdx		(const char* name, int nameLen) const;
 
 	std::string							m_name;
-	std::vector<CaseTreeNode*>			m_children;
+	deUint32							m_nameHash;
+	std::vector<CaseTreeNode*>			m_children;		//!< Sorted by name hash
 };
 
+CaseTreeNode::CaseTreeNode (const std::string& name)
+	: m_name		(name)
+	, m_nameHash	(hashName(name.c_str(), (int)name.length()))
+{
+}
+
 CaseTreeNode::~CaseTreeNode (void)
 {
 	for (vector<CaseTreeNode*>::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
 		delete *i;
 }
 
-int CaseTreeNode::findChildNdx (const std::string& name) const
+int CaseTreeNode::findChildNdx (const char* name, int nameLen) const
 {
-	for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
+	const deUint32							hash	= hashName(name, nameLen);
+	vector<CaseTreeNode*>::const_iterator	iter	= std::lower_bound(m_children.begin(), m_children.end(), hash, compareHash);
+
+	for (; iter != m_children.end() && (*iter)->m_nameHash == hash; ++iter)
 	{
-		if (m_children[ndx]->getName() == name)
-			return ndx;
+		const std::string& childName = (*iter)->getName();
+
+		if ((int)childName.length() == nameLen && deMemCmp(childName.c_str(), name, nameLen) == 0)
+			return (int)(iter - m_children.begin());
 	}
+
 	return NOT_FOUND;
 }
 
+void CaseTreeNode::addChild (CaseTreeNode* child)
+{
+	vector<CaseTreeNode*>::iterator pos = std::lower_bound(m_children.begin(), m_children.end(), child->m_nameHash, compareHash);
+	m_children.insert(pos, child);
+}
+
 inline bool CaseTreeNode::hasChild (const std::string& name) const
 {
-	return findChildNdx(name) != NOT_FOUND;
+	return findChildNdx(name.c_str(), (int)name.length()) != NOT_FOUND;
 }
 
 inline const CaseTreeNode* CaseTreeNode::getChild (const std::string& name) const
 {
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
+	return getChild(name.c_str(), (int)name.length());
 }
 
 inline CaseTreeNode* CaseTreeNode::getChild (const std::string& name)
 {
-	const int ndx = findChildNdx(name);
+	const int ndx = findChildNdx(name.c_str(), (int)name.length());
+	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
+}
+
+inline const CaseTreeNode* CaseTreeNode::getChild (const char* name, int nameLen) const
+{
+	const int ndx = findChildNdx(name, nameLen);
 	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
 }
 
@@ -309,7 +397,7 @@ static const CaseTreeNode* findNode (const CaseTreeNode* root, const char* path)
 
 	for (;;)
 	{
-		curNode = curNode->getChild(std::string(curPath, curPath+curLen));
+		curNode = curNode->getChild(curPath, curLen);
 
 		if (!curNode)
 			break;
@@ -514,55 +602,101 @@ static CaseTreeNode* parseCaseList (std::istream& in)
 	}
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Compiled --deqp-case patterns
+ *
+ * Patterns are split at construction time and the literal prefix before
+ * the first wildcard is located, so matching a path only compares that
+ * prefix and, if the pattern has wildcards, runs a non-recursive glob
+ * match on the rest. No strings are allocated while matching.
+ *
+ * With allowPrefix the query answers whether any descendant of the given
+ * group path may match, which allows pruning whole groups.
+ *//*--------------------------------------------------------------------*/
 class CasePaths
 {
 public:
 							CasePaths	(const string& pathList);
-	bool					matches		(const string& caseName, bool allowPrefix=false) const;
+	bool					matches		(const char* caseName, bool allowPrefix=false) const;
 
 private:
-	const vector<string>	m_casePatterns;
+	struct Pattern
+	{
+		string				pattern;
+		int					prefixLen;		//!< Length of literal prefix before first wildcard
+	};
+
+	vector<Pattern>			m_casePatterns;
 };
 
 CasePaths::CasePaths (const string& pathList)
-	: m_casePatterns(de::splitString(pathList, ','))
 {
-}
+	const vector<string> patterns = de::splitString(pathList, ',');
 
-// Match a single path component against a pattern component that may contain *-wildcards.
-static bool matchWildcards(string::const_iterator	patternStart,
-						   string::const_iterator	patternEnd,
-						   string::const_iterator	pathStart,
-						   string::const_iterator	pathEnd,
-						   bool						allowPrefix)
-{
-	string::const_iterator	pattern	= patternStart;
-	string::const_iterator	path	= pathStart;
+	m_casePatterns.resize(patterns.size());
 
-	while (pattern != patternEnd && path != pathEnd && *pattern == *path)
+	for (size_t ndx = 0; ndx < patterns.size(); ++ndx)
 	{
-		++pattern;
-		++path;
+		const string::size_type wildcardPos = patterns[ndx].find('*');
+
+		m_casePatterns[ndx].pattern		= patterns[ndx];
+		m_casePatterns[ndx].prefixLen	= (int)(wildcardPos == string::npos ? patterns[ndx].length() : wildcardPos);
 	}
+}
+
+// Match a path against a pattern that may contain *-wildcards. With allowPrefix
+// the path also matches if it can be extended to match the pattern.
+static bool matchWildcards (const char* pattern, const char* path, bool allowPrefix)
+{
+	const char*	starPattern	= DE_NULL;
+	const char*	starPath	= DE_NULL;
 
-	if (pattern == patternEnd)
-		return (path == pathEnd);
-	else if (*pattern == '*')
+	while (*path != 0)
 	{
-		for (; path != pathEnd; ++path)
+		if (*pattern == '*')
 		{
-			if (matchWildcards(pattern + 1, patternEnd, path, pathEnd, allowPrefix))
-				return true;
+			// Remember wildcard position and first try to match it to empty string
+			starPattern	= ++pattern;
+			starPath	= path;
 		}
-
-		if (matchWildcards(pattern + 1, patternEnd, pathEnd, pathEnd, allowPrefix))
-			return true;
+		else if (*pattern != 0 && *pattern == *path)
+		{
+			++pattern;
+			++path;
+		}
+		else if (starPattern)
+		{
+			// Backtrack: let last wildcard consume one more character
+			pattern	= starPattern;
+			path	= ++starPath;
+		}
+		else
+			return false;
 	}
-	else if (path == pathEnd && allowPrefix)
+
+	if (allowPrefix)
 		return true;
 
-	return false;
+	while (*pattern == '*')
+		++pattern;
+
+	return *pattern == 0;
+}
+
+#if !defined(TCU_HIERARCHICAL_CASEPATHS)
+static bool matchCompiledPattern (const char* pattern, int prefixLen, const char* path, bool allowPrefix)
+{
+	for (int ndx = 0; ndx < prefixLen; ++ndx)
+	{
+		if (path[ndx] == 0)
+			return allowPrefix;
+		else if (path[ndx] != pattern[ndx])
+			return false;
+	}
+
+	return matchWildcards(pattern + prefixLen, path + prefixLen, allowPrefix);
 }
+#endif
 
 #if defined(TCU_HIERARCHICAL_CASEPATHS)
 // Match a list of pattern components to a list of path components. A pattern
@@ -578,8 +712,7 @@ static bool patternMatches(vector<string>::const_iterator	patternStart,
 	vector<string>::const_iterator	path	= pathStart;
 
 	while (pattern != patternEnd && path != pathEnd && *pattern != "**" &&
-		   (*pattern == *path || matchWildcards(pattern->begin(), pattern->end(),
-												path->begin(), path->end(), false)))
+		   (*pattern == *path || matchWildcards(pattern->c_str(), path->c_str(), false)))
 	{
 		++pattern;
 		++path;
@@ -600,21 +733,22 @@ static bool patternMatches(vector<string>::const_iterator	patternStart,
 }
 #endif
 
-bool CasePaths::matches (const string& caseName, bool allowPrefix) const
+bool CasePaths::matches (const char* caseName, bool allowPrefix) const
 {
+#if defined(TCU_HIERARCHICAL_CASEPATHS)
 	const vector<string> components = de::splitString(caseName, '.');
+#endif
 
 	for (size_t ndx = 0; ndx < m_casePatterns.size(); ++ndx)
 	{
 #if defined(TCU_HIERARCHICAL_CASEPATHS)
-		const vector<string> patternComponents = de::splitString(m_casePatterns[ndx], '.');
+		const vector<string> patternComponents = de::splitString(m_casePatterns[ndx].pattern, '.');
 
 		if (patternMatches(patternComponents.begin(), patternComponents.end(),
 						   components.begin(), components.end(), allowPrefix))
 			return true;
 #else
-		if (matchWildcards(m_casePatterns[ndx].begin(), m_casePatterns[ndx].end(),
-						   caseName.begin(), caseName.end(), allowPrefix))
+		if (matchCompiledPattern(m_casePatterns[ndx].pattern.c_str(), m_casePatterns[ndx].prefixLen, caseName, allowPrefix))
 			return true;
 #endif
 	}
@@ -715,6 +849,12 @@ bool CommandLine::parse (int argc, const char* const* argv)
 	if (!m_cmdLine.getOption<opt::LogImages>())
 		m_logFlags |= QP_TEST_LOG_EXCLUDE_IMAGES;
 
+	if (m_cmdLine.getOption<opt::LogDedupImages>())
+		m_logFlags |= QP_TEST_LOG_DEDUPLICATE_IMAGES;
+
+	if (m_cmdLine.getOption<opt::LogBinaryFormat>())
+		m_logFlags |= QP_TEST_LOG_BINARY_FORMAT;
+
 	if ((m_cmdLine.hasOption<opt::CasePath>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseList>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseListFile>()?1:0) +
@@ -801,6 +941,18 @@ int						CommandLine::getGLConfigId				(void) const	{ return m_cmdLine.getOption
 int						CommandLine::getCLPlatformId			(void) const	{ return m_cmdLine.getOption<opt::CLPlatformID>();				}
 const std::vector<int>&	CommandLine::getCLDeviceIds				(void) const	{ return m_cmdLine.getOption<opt::CLDeviceIDs>();				}
 bool					CommandLine::isOutOfMemoryTestEnabled	(void) const	{ return m_cmdLine.getOption<opt::TestOOM>();					}
+int						CommandLine::getRefRenderThreadCount	(void) const	{ return m_cmdLine.getOption<opt::RefRenderThreads>();			}
+int						CommandLine::getCompareThreadCount		(void) const	{ return m_cmdLine.getOption<opt::CompareThreads>();			}
+bool					CommandLine::isCompareTimeLoggingEnabled	(void) const	{ return m_cmdLine.getOption<opt::LogCompareTime>();			}
+int						CommandLine::getDecompressionCacheSize	(void) const	{ return m_cmdLine.getOption<opt::DecompressionCacheSize>();	}
+int						CommandLine::getLogImageThreadCount		(void) const	{ return m_cmdLine.getOption<opt::LogImageThreads>();			}
+int						CommandLine::getLogImageCompressionLevel	(void) const	{ return m_cmdLine.getOption<opt::LogImageCompressionLevel>();	}
+qpImageCompressionStrategy	CommandLine::getLogImageCompressionStrategy	(void) const	{ return m_cmdLine.getOption<opt::LogImageCompressionStrategy>();	}
+int						CommandLine::getLogImageMemoryBudget	(void) const	{ return m_cmdLine.getOption<opt::LogImageMemory>();			}
+int						CommandLine::getLogBufferSize			(void) const	{ return m_cmdLine.getOption<opt::LogBufferSize>();				}
+qpTestLogFlushPolicy	CommandLine::getLogFlushPolicy			(void) const	{ return m_cmdLine.getOption<opt::LogFlushPolicy>();			}
+int						CommandLine::getLogFlushCaseCount		(void) const	{ return m_cmdLine.getOption<opt::LogFlushCases>();				}
+int						CommandLine::getLogFlushInterval		(void) const	{ return m_cmdLine.getOption<opt::LogFlushInterval>();			}
 
 const char* CommandLine::getGLContextType (void) const
 {
@@ -857,6 +1009,14 @@ const char* CommandLine::getEGLPixmapType (void) const
 		return DE_NULL;
 }
 
+const char* CommandLine::getResourcePackFileName (void) const
+{
+	if (m_cmdLine.hasOption<opt::ResourcePack>())
+		return m_cmdLine.getOption<opt::ResourcePack>().c_str();
+	else
+		return DE_NULL;
+}
+
 static bool checkTestGroupName (const CaseTreeNode* root, const char* groupPath)
 {
 	const CaseTreeNode* node = findNode(root, groupPath);
@@ -869,6 +1029,19 @@ static bool checkTestCaseName (const CaseTreeNode* root, const char* casePath)
 	return node && !node->hasChildren();
 }
 
+const char* CommandLine::getCaseListCacheDir (void) const
+{
+	if (m_cmdLine.hasOption<opt::CaseListCacheDir>())
+		return m_cmdLine.getOption<opt::CaseListCacheDir>().c_str();
+	else
+		return DE_NULL;
+}
+
+bool CommandLine::hasCaseFilter (void) const
+{
+	return m_casePaths.get() != DE_NULL || m_caseTree != DE_NULL;
+}
+
 bool CommandLine::checkTestGroupName (const char* groupName) const
 {
 	if (m_casePaths)
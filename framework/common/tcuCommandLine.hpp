@@ -26,6 +26,7 @@
 #include "tcuDefs.hpp"
 #include "deCommandLine.hpp"
 #include "deUniquePtr.hpp"
+#include "qpTestLog.h"
 
 #include <string>
 #include <vector>
@@ -175,6 +176,51 @@ public:
 	//! Should we run tests that exhaust memory (--deqp-test-oom)
 	bool							isOutOfMemoryTestEnabled(void) const;
 
+	//! Get number of reference renderer threads, 0 means number of logical cores (--deqp-refrender-threads)
+	int								getRefRenderThreadCount		(void) const;
+
+	//! Get number of image comparison threads, 0 means number of logical cores (--deqp-compare-threads)
+	int								getCompareThreadCount		(void) const;
+
+	//! Should image comparisons log the time they took (--deqp-log-compare-time)
+	bool							isCompareTimeLoggingEnabled	(void) const;
+
+	//! Get decompressed texture cache size in megabytes, 0 means disabled (--deqp-decompression-cache-size)
+	int								getDecompressionCacheSize	(void) const;
+
+	//! Get number of background image compression threads, 0 means synchronous (--deqp-log-image-threads)
+	int								getLogImageThreadCount		(void) const;
+
+	//! Get PNG compression level of logged images, -1 means default (--deqp-log-image-compression-level)
+	int								getLogImageCompressionLevel	(void) const;
+
+	//! Get PNG compression strategy of logged images (--deqp-log-image-compression-strategy)
+	qpImageCompressionStrategy		getLogImageCompressionStrategy	(void) const;
+
+	//! Get memory budget in megabytes for images compressed in background (--deqp-log-image-memory)
+	int								getLogImageMemoryBudget		(void) const;
+
+	//! Get test log output buffer size in megabytes, 0 means unbuffered (--deqp-log-buffer-size)
+	int								getLogBufferSize			(void) const;
+
+	//! Get test log flush policy (--deqp-log-flush)
+	qpTestLogFlushPolicy			getLogFlushPolicy			(void) const;
+
+	//! Get number of test cases between test log flushes (--deqp-log-flush-cases)
+	int								getLogFlushCaseCount		(void) const;
+
+	//! Get minimum interval in milliseconds between test log flushes (--deqp-log-flush-interval)
+	int								getLogFlushInterval			(void) const;
+
+	//! Get resource pack file name, null if resources are loaded from data directory (--deqp-resource-pack)
+	const char*						getResourcePackFileName		(void) const;
+
+	//! Get test hierarchy cache directory, null if cache is not used (--deqp-caselist-cache-dir)
+	const char*						getCaseListCacheDir			(void) const;
+
+	//! Check if test cases are limited by a case list or pattern.
+	bool							hasCaseFilter				(void) const;
+
 	//! Check if test group is in supplied test case list.
 	bool							checkTestGroupName			(const char* groupName) const;
 
@@ -23,11 +23,16 @@
 
 #include "tcuCompressedTexture.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuImageCompareThreads.hpp"
+#include "tcuDecompressedTextureCache.hpp"
 
 #include "deStringUtil.hpp"
+#include "deUniquePtr.hpp"
 #include "deFloat16.h"
+#include "deMemory.h"
 
 #include <algorithm>
+#include <new>
 
 namespace tcu
 {
@@ -825,24 +830,40 @@ void decompressEAC11Block (deUint8 dst[ETC2_UNCOMPRESSED_BLOCK_SIZE_R11], deUint
 
 } // EtcDecompressInternal
 
+void writeETCRGB8Block (const PixelBufferAccess& dst, const deUint8* uncompressedBlock)
+{
+	using namespace EtcDecompressInternal;
+
+	deUint8* const	dstPtr		= (deUint8*)dst.getDataPtr();
+	const int		dstRowPitch	= dst.getRowPitch();
+	const int		rowSize		= ETC2_BLOCK_WIDTH*ETC2_UNCOMPRESSED_PIXEL_SIZE_RGB8;
+
+	DE_ASSERT(dst.getPixelPitch() == ETC2_UNCOMPRESSED_PIXEL_SIZE_RGB8);
+
+	for (int y = 0; y < (int)ETC2_BLOCK_HEIGHT; y++)
+		deMemcpy(dstPtr + y*dstRowPitch, uncompressedBlock + y*rowSize, rowSize);
+}
+
 void decompressETC1 (const PixelBufferAccess& dst, const deUint8* src)
 {
 	using namespace EtcDecompressInternal;
 
-	deUint8* const	dstPtr			= (deUint8*)dst.getDataPtr();
 	const deUint64	compressedBlock = get64BitBlock(src, 0);
+	deUint8			uncompressedBlock[ETC2_UNCOMPRESSED_BLOCK_SIZE_RGB8];
 
-	decompressETC1Block(dstPtr, compressedBlock);
+	decompressETC1Block(uncompressedBlock, compressedBlock);
+	writeETCRGB8Block(dst, uncompressedBlock);
 }
 
 void decompressETC2 (const PixelBufferAccess& dst, const deUint8* src)
 {
 	using namespace EtcDecompressInternal;
 
-	deUint8* const	dstPtr			= (deUint8*)dst.getDataPtr();
 	const deUint64	compressedBlock = get64BitBlock(src, 0);
+	deUint8			uncompressedBlock[ETC2_UNCOMPRESSED_BLOCK_SIZE_RGB8];
 
-	decompressETC2Block(dstPtr, compressedBlock, NULL, false);
+	decompressETC2Block(uncompressedBlock, compressedBlock, NULL, false);
+	writeETCRGB8Block(dst, uncompressedBlock);
 }
 
 void decompressETC2_EAC_RGBA8 (const PixelBufferAccess& dst, const deUint8* src)
@@ -1238,6 +1259,13 @@ struct TexelWeightPair
 	deUint32 w[2];
 };
 
+//! Weight grid infill coefficients for one texel.
+struct WeightInfill
+{
+	deUint8 v0;		//!< Index of the top-left weight grid point.
+	deUint8 w[4];	//!< Weights for grid points v0, v0+1, v0+gridWidth and v0+gridWidth+1.
+};
+
 ASTCBlockMode getASTCBlockMode (deUint32 blockModeData)
 {
 	ASTCBlockMode blockMode;
@@ -2196,42 +2224,58 @@ void unquantizeWeights (deUint32* dst, const ISEDecodedResult* weightGrid, const
 		dst[weightNdx] += dst[weightNdx] > 32 ? 1 : 0;
 }
 
-void interpolateWeights (TexelWeightPair* dst, const deUint32* unquantizedWeights, int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+void computeWeightInfill (WeightInfill* dst, int blockWidth, int blockHeight, int gridWidth, int gridHeight)
 {
-	const int		numWeightsPerTexel	= blockMode.isDualPlane ? 2 : 1;
-	const deUint32	scaleX				= (1024 + blockWidth/2) / (blockWidth-1);
-	const deUint32	scaleY				= (1024 + blockHeight/2) / (blockHeight-1);
+	const deUint32	scaleX	= (1024 + blockWidth/2) / (blockWidth-1);
+	const deUint32	scaleY	= (1024 + blockHeight/2) / (blockHeight-1);
 
 	for (int texelY = 0; texelY < blockHeight; texelY++)
 	{
 		for (int texelX = 0; texelX < blockWidth; texelX++)
 		{
-			const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
-			const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
-			const deUint32 jX	= gX >> 4;
-			const deUint32 jY	= gY >> 4;
-			const deUint32 fX	= gX & 0xf;
-			const deUint32 fY	= gY & 0xf;
-			const deUint32 w11	= (fX*fY + 8) >> 4;
-			const deUint32 w10	= fY - w11;
-			const deUint32 w01	= fX - w11;
-			const deUint32 w00	= 16 - fX - fY + w11;
-			const deUint32 v0	= jY*blockMode.weightGridWidth + jX;
-
-			for (int texelWeightNdx = 0; texelWeightNdx < numWeightsPerTexel; texelWeightNdx++)
-			{
-				const deUint32 p00	= unquantizedWeights[(v0)									* numWeightsPerTexel + texelWeightNdx];
-				const deUint32 p01	= unquantizedWeights[(v0 + 1)								* numWeightsPerTexel + texelWeightNdx];
-				const deUint32 p10	= unquantizedWeights[(v0 + blockMode.weightGridWidth)		* numWeightsPerTexel + texelWeightNdx];
-				const deUint32 p11	= unquantizedWeights[(v0 + blockMode.weightGridWidth + 1)	* numWeightsPerTexel + texelWeightNdx];
+			const deUint32	gX		= (scaleX*texelX*(gridWidth-1) + 32) >> 6;
+			const deUint32	gY		= (scaleY*texelY*(gridHeight-1) + 32) >> 6;
+			const deUint32	jX		= gX >> 4;
+			const deUint32	jY		= gY >> 4;
+			const deUint32	fX		= gX & 0xf;
+			const deUint32	fY		= gY & 0xf;
+			const deUint32	w11		= (fX*fY + 8) >> 4;
+			WeightInfill&	infill	= dst[texelY*blockWidth + texelX];
+
+			infill.v0	= (deUint8)(jY*gridWidth + jX);
+			infill.w[0]	= (deUint8)(16 - fX - fY + w11);
+			infill.w[1]	= (deUint8)(fX - w11);
+			infill.w[2]	= (deUint8)(fY - w11);
+			infill.w[3]	= (deUint8)w11;
+		}
+	}
+}
 
-				dst[texelY*blockWidth + texelX].w[texelWeightNdx] = (p00*w00 + p01*w01 + p10*w10 + p11*w11 + 8) >> 4;
-			}
+void interpolateWeights (TexelWeightPair* dst, const deUint32* unquantizedWeights, const WeightInfill* infill, int numTexels, const ASTCBlockMode& blockMode)
+{
+	const int numWeightsPerTexel = blockMode.isDualPlane ? 2 : 1;
+
+	for (int texelNdx = 0; texelNdx < numTexels; texelNdx++)
+	{
+		const deUint32 v0	= infill[texelNdx].v0;
+		const deUint32 w00	= infill[texelNdx].w[0];
+		const deUint32 w01	= infill[texelNdx].w[1];
+		const deUint32 w10	= infill[texelNdx].w[2];
+		const deUint32 w11	= infill[texelNdx].w[3];
+
+		for (int texelWeightNdx = 0; texelWeightNdx < numWeightsPerTexel; texelWeightNdx++)
+		{
+			const deUint32 p00	= unquantizedWeights[(v0)									* numWeightsPerTexel + texelWeightNdx];
+			const deUint32 p01	= unquantizedWeights[(v0 + 1)								* numWeightsPerTexel + texelWeightNdx];
+			const deUint32 p10	= unquantizedWeights[(v0 + blockMode.weightGridWidth)		* numWeightsPerTexel + texelWeightNdx];
+			const deUint32 p11	= unquantizedWeights[(v0 + blockMode.weightGridWidth + 1)	* numWeightsPerTexel + texelWeightNdx];
+
+			dst[texelNdx].w[texelWeightNdx] = (p00*w00 + p01*w01 + p10*w10 + p11*w11 + 8) >> 4;
 		}
 	}
 }
 
-void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, const WeightInfill* infill, int numTexels, const ASTCBlockMode& blockMode)
 {
 	ISEDecodedResult weightGrid[64];
 
@@ -2243,7 +2287,7 @@ void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int b
 	{
 		deUint32 unquantizedWeights[64];
 		unquantizeWeights(&unquantizedWeights[0], &weightGrid[0], blockMode);
-		interpolateWeights(dst, &unquantizedWeights[0], blockWidth, blockHeight, blockMode);
+		interpolateWeights(dst, &unquantizedWeights[0], infill, numTexels, blockMode);
 	}
 }
 
@@ -2303,11 +2347,95 @@ int computeTexelPartition (deUint32 seedIn, deUint32 xIn, deUint32 yIn, deUint32
 		 :								  3;
 }
 
-void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPair* texelWeights, int ccs, deUint32 partitionIndexSeed,
+/*--------------------------------------------------------------------*//*!
+ * \brief Precomputed decoding tables for one ASTC block size
+ *
+ * Texel partition assignments depend only on block size, partition count
+ * and partition seed, and weight infill coefficients only on block size
+ * and weight grid size. Both are computed on first use. Returned pointers
+ * are valid until the next call.
+ *//*--------------------------------------------------------------------*/
+class ASTCDecodeTables
+{
+public:
+						ASTCDecodeTables		(int blockWidth, int blockHeight);
+
+	int					getBlockWidth			(void) const { return m_blockWidth;		}
+	int					getBlockHeight			(void) const { return m_blockHeight;	}
+
+	const deUint8*		getTexelPartitions		(deUint32 seed, int numPartitions);
+	const WeightInfill*	getWeightInfill			(int gridWidth, int gridHeight);
+
+private:
+	enum
+	{
+		NUM_PARTITION_SEEDS		= 1<<10,
+		GRID_SIZE_STRIDE		= ASTC_MAX_BLOCK_WIDTH+1
+	};
+
+	int							m_blockWidth;
+	int							m_blockHeight;
+	std::vector<int>			m_partitionOffsets;
+	std::vector<deUint8>		m_partitions;
+	std::vector<int>			m_infillOffsets;
+	std::vector<WeightInfill>	m_infills;
+};
+
+ASTCDecodeTables::ASTCDecodeTables (int blockWidth, int blockHeight)
+	: m_blockWidth			(blockWidth)
+	, m_blockHeight			(blockHeight)
+	, m_partitionOffsets	(3*NUM_PARTITION_SEEDS, -1)
+	, m_infillOffsets		(GRID_SIZE_STRIDE*(ASTC_MAX_BLOCK_HEIGHT+1), -1)
+{
+	DE_ASSERT(de::inRange(blockWidth, 1, (int)ASTC_MAX_BLOCK_WIDTH) && de::inRange(blockHeight, 1, (int)ASTC_MAX_BLOCK_HEIGHT));
+}
+
+const deUint8* ASTCDecodeTables::getTexelPartitions (deUint32 seed, int numPartitions)
+{
+	DE_ASSERT(de::inRange(numPartitions, 2, 4) && seed < (deUint32)NUM_PARTITION_SEEDS);
+
+	int& offset = m_partitionOffsets[(numPartitions-2)*NUM_PARTITION_SEEDS + seed];
+
+	if (offset < 0)
+	{
+		const bool	smallBlock	= m_blockWidth*m_blockHeight < 31;
+		const int	newOffset	= (int)m_partitions.size();
+
+		m_partitions.resize(newOffset + m_blockWidth*m_blockHeight);
+
+		for (int texelY = 0; texelY < m_blockHeight; texelY++)
+		for (int texelX = 0; texelX < m_blockWidth; texelX++)
+			m_partitions[newOffset + texelY*m_blockWidth + texelX] = (deUint8)computeTexelPartition(seed, texelX, texelY, 0, numPartitions, smallBlock);
+
+		offset = newOffset;
+	}
+
+	return &m_partitions[offset];
+}
+
+const WeightInfill* ASTCDecodeTables::getWeightInfill (int gridWidth, int gridHeight)
+{
+	DE_ASSERT(gridWidth <= m_blockWidth && gridHeight <= m_blockHeight);
+
+	int& offset = m_infillOffsets[gridHeight*GRID_SIZE_STRIDE + gridWidth];
+
+	if (offset < 0)
+	{
+		const int newOffset = (int)m_infills.size();
+
+		m_infills.resize(newOffset + m_blockWidth*m_blockHeight);
+		computeWeightInfill(&m_infills[newOffset], m_blockWidth, m_blockHeight, gridWidth, gridHeight);
+
+		offset = newOffset;
+	}
+
+	return &m_infills[offset];
+}
+
+void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPair* texelWeights, int ccs, const deUint8* texelPartitions,
 							int numPartitions, int blockWidth, int blockHeight, bool isSRGB, bool isLDRMode, const deUint32* colorEndpointModes)
 {
-	const bool	smallBlock = blockWidth*blockHeight < 31;
-	bool		isHDREndpoint[4];
+	bool isHDREndpoint[4];
 
 	for (int i = 0; i < numPartitions; i++)
 		isHDREndpoint[i] = isColorEndpointModeHDR(colorEndpointModes[i]);
@@ -2316,7 +2444,7 @@ void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPa
 	for (int texelX = 0; texelX < blockWidth; texelX++)
 	{
 		const int				texelNdx			= texelY*blockWidth + texelX;
-		const int				colorEndpointNdx	= numPartitions == 1 ? 0 : computeTexelPartition(partitionIndexSeed, texelX, texelY, 0, numPartitions, smallBlock);
+		const int				colorEndpointNdx	= numPartitions == 1 ? 0 : texelPartitions[texelNdx];
 		DE_ASSERT(colorEndpointNdx < numPartitions);
 		const UVec4&			e0					= colorEndpoints[colorEndpointNdx].e0;
 		const UVec4&			e1					= colorEndpoints[colorEndpointNdx].e1;
@@ -2376,10 +2504,13 @@ void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPa
 	}
 }
 
-void decompressASTCBlock (void* dst, const Block128& blockData, int blockWidth, int blockHeight, bool isSRGB, bool isLDR)
+void decompressASTCBlock (void* dst, const Block128& blockData, ASTCDecodeTables& tables, bool isSRGB, bool isLDR)
 {
 	DE_ASSERT(isLDR || !isSRGB);
 
+	const int blockWidth	= tables.getBlockWidth();
+	const int blockHeight	= tables.getBlockHeight();
+
 	// Decode block mode.
 
 	const ASTCBlockMode blockMode = getASTCBlockMode(blockData.getBits(0, 10));
@@ -2454,23 +2585,24 @@ void decompressASTCBlock (void* dst, const Block128& blockData, int blockWidth,
 	// Compute texel weights.
 
 	TexelWeightPair texelWeights[ASTC_MAX_BLOCK_WIDTH*ASTC_MAX_BLOCK_HEIGHT];
-	computeTexelWeights(&texelWeights[0], blockData, blockWidth, blockHeight, blockMode);
+	computeTexelWeights(&texelWeights[0], blockData, tables.getWeightInfill(blockMode.weightGridWidth, blockMode.weightGridHeight), blockWidth*blockHeight, blockMode);
 
 	// Set texel colors.
 
-	const int		ccs						= blockMode.isDualPlane ? (int)blockData.getBits(extraCemBitsStart-2, extraCemBitsStart-1) : -1;
-	const deUint32	partitionIndexSeed		= numPartitions > 1 ? blockData.getBits(13, 22) : (deUint32)-1;
+	const int				ccs					= blockMode.isDualPlane ? (int)blockData.getBits(extraCemBitsStart-2, extraCemBitsStart-1) : -1;
+	const deUint8* const	texelPartitions		= numPartitions > 1 ? tables.getTexelPartitions(blockData.getBits(13, 22), numPartitions) : DE_NULL;
 
-	setTexelColors(dst, &colorEndpoints[0], &texelWeights[0], ccs, partitionIndexSeed, numPartitions, blockWidth, blockHeight, isSRGB, isLDR, &colorEndpointModes[0]);
+	setTexelColors(dst, &colorEndpoints[0], &texelWeights[0], ccs, texelPartitions, numPartitions, blockWidth, blockHeight, isSRGB, isLDR, &colorEndpointModes[0]);
 }
 
 } // ASTCDecompressInternal
 
-void decompressASTC (const PixelBufferAccess& dst, const deUint8* data, bool isSRGB, bool isLDR)
+void decompressASTC (const PixelBufferAccess& dst, const deUint8* data, bool isSRGB, bool isLDR, ASTCDecompressInternal::ASTCDecodeTables& tables)
 {
 	using namespace ASTCDecompressInternal;
 
 	DE_ASSERT(isLDR || !isSRGB);
+	DE_ASSERT(dst.getWidth() == tables.getBlockWidth() && dst.getHeight() == tables.getBlockHeight());
 
 	const int blockWidth = dst.getWidth();
 	const int blockHeight = dst.getHeight();
@@ -2483,33 +2615,32 @@ void decompressASTC (const PixelBufferAccess& dst, const deUint8* data, bool isS
 
 	const Block128 blockData(data);
 	decompressASTCBlock(isSRGB ? (void*)&decompressedBuffer.sRGB[0] : (void*)&decompressedBuffer.linear[0],
-						blockData, dst.getWidth(), dst.getHeight(), isSRGB, isLDR);
+						blockData, tables, isSRGB, isLDR);
 
+	// \note Destination is sRGBA8 or RGBA16F, texels are stored directly.
 	if (isSRGB)
 	{
+		DE_ASSERT(dst.getFormat() == TextureFormat(TextureFormat::sRGBA, TextureFormat::UNORM_INT8) && dst.getPixelPitch() == 4);
+
 		for (int i = 0; i < blockHeight; i++)
-		for (int j = 0; j < blockWidth; j++)
-		{
-			dst.setPixel(IVec4(decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 0],
-									decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 1],
-									decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 2],
-									decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 3]), j, i);
-		}
+			deMemcpy(dst.getPixelPtr(0, i), &decompressedBuffer.sRGB[i*blockWidth*4], blockWidth*4);
 	}
 	else
 	{
+		DE_ASSERT(dst.getFormat() == TextureFormat(TextureFormat::RGBA, TextureFormat::HALF_FLOAT) && dst.getPixelPitch() == 8);
+
 		for (int i = 0; i < blockHeight; i++)
-		for (int j = 0; j < blockWidth; j++)
 		{
-			dst.setPixel(Vec4(decompressedBuffer.linear[(i*blockWidth + j) * 4 + 0],
-								   decompressedBuffer.linear[(i*blockWidth + j) * 4 + 1],
-								   decompressedBuffer.linear[(i*blockWidth + j) * 4 + 2],
-								   decompressedBuffer.linear[(i*blockWidth + j) * 4 + 3]), j, i);
+			deFloat16* const	dstRow	= (deFloat16*)dst.getPixelPtr(0, i);
+			const float* const	srcRow	= &decompressedBuffer.linear[i*blockWidth*4];
+
+			for (int ndx = 0; ndx < blockWidth*4; ndx++)
+				dstRow[ndx] = deFloat32To16(srcRow[ndx]);
 		}
 	}
 }
 
-void decompressBlock (CompressedTexFormat format, const PixelBufferAccess& dst, const deUint8* src, const TexDecompressionParams& params)
+void decompressBlock (CompressedTexFormat format, const PixelBufferAccess& dst, const deUint8* src, const TexDecompressionParams& params, ASTCDecompressInternal::ASTCDecodeTables* astcTables)
 {
 	// No 3D blocks supported right now
 	DE_ASSERT(dst.getDepth() == 1);
@@ -2558,9 +2689,10 @@ void decompressBlock (CompressedTexFormat format, const PixelBufferAccess& dst,
 		case COMPRESSEDTEXFORMAT_ASTC_12x12_SRGB8_ALPHA8:
 		{
 			DE_ASSERT(params.astcMode == TexDecompressionParams::ASTCMODE_LDR || params.astcMode == TexDecompressionParams::ASTCMODE_HDR);
+			DE_ASSERT(astcTables);
 
 			const bool isSRGBFormat = isAstcSRGBFormat(format);
-			decompressASTC(dst, src, isSRGBFormat, isSRGBFormat || params.astcMode == TexDecompressionParams::ASTCMODE_LDR);
+			decompressASTC(dst, src, isSRGBFormat, isSRGBFormat || params.astcMode == TexDecompressionParams::ASTCMODE_LDR, *astcTables);
 
 			break;
 		}
@@ -2576,36 +2708,130 @@ int componentSum (const IVec3& vec)
 	return vec.x() + vec.y() + vec.z();
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Decompresses rows of blocks
+ *
+ * Rows are block rows of all slices, i.e. row index is
+ * blockZ*blockCount.y + blockY. Each band has its own scratch block
+ * and ASTC decoding tables. Blocks that are fully inside dst are
+ * decompressed directly into dst. Errors are recorded per band and
+ * rethrown by throwErrors() on the calling thread.
+ *//*--------------------------------------------------------------------*/
+class DecompressBlockRowsJob : public RowBandJob
+{
+public:
+									DecompressBlockRowsJob	(const PixelBufferAccess& dst, CompressedTexFormat format, const deUint8* src, const TexDecompressionParams& params, int numBands);
+
+	void							processRows				(int bandNdx, int beginRow, int endRow);
+	void							throwErrors				(void) const;
+
+private:
+	void							decompressRows			(int beginRow, int endRow);
+
+	const PixelBufferAccess			m_dst;
+	const CompressedTexFormat		m_format;
+	const deUint8* const			m_src;
+	const TexDecompressionParams	m_params;
+	const IVec3						m_blockPixelSize;
+	const IVec3						m_blockCount;
+	const IVec3						m_blockPitches;
+	const bool						m_directWrite;
+	std::vector<deBool>				m_outOfMemory;
+	std::vector<std::string>		m_errors;
+};
+
+DecompressBlockRowsJob::DecompressBlockRowsJob (const PixelBufferAccess& dst, CompressedTexFormat format, const deUint8* src, const TexDecompressionParams& params, int numBands)
+	: m_dst				(dst)
+	, m_format			(format)
+	, m_src				(src)
+	, m_params			(params)
+	, m_blockPixelSize	(getBlockPixelSize(format))
+	, m_blockCount		(divRoundUp(dst.getWidth(),		m_blockPixelSize.x()),
+						 divRoundUp(dst.getHeight(),	m_blockPixelSize.y()),
+						 divRoundUp(dst.getDepth(),		m_blockPixelSize.z()))
+	, m_blockPitches	(getBlockSize(format), getBlockSize(format) * m_blockCount.x(), getBlockSize(format) * m_blockCount.x() * m_blockCount.y())
+	, m_directWrite		(dst.getPixelPitch() == dst.getFormat().getPixelSize())
+	, m_outOfMemory		(numBands, DE_FALSE)
+	, m_errors			(numBands)
+{
+}
+
+void DecompressBlockRowsJob::processRows (int bandNdx, int beginRow, int endRow)
+{
+	try
+	{
+		decompressRows(beginRow, endRow);
+	}
+	catch (const std::bad_alloc&)
+	{
+		m_outOfMemory[bandNdx] = DE_TRUE;
+	}
+	catch (const InternalError& e)
+	{
+		m_errors[bandNdx] = e.getMessage();
+	}
+}
+
+void DecompressBlockRowsJob::throwErrors (void) const
+{
+	if (std::find(m_outOfMemory.begin(), m_outOfMemory.end(), (deBool)DE_TRUE) != m_outOfMemory.end())
+		throw std::bad_alloc();
+
+	for (size_t bandNdx = 0; bandNdx < m_errors.size(); bandNdx++)
+	{
+		if (!m_errors[bandNdx].empty())
+			throw InternalError(m_errors[bandNdx]);
+	}
+}
+
+void DecompressBlockRowsJob::decompressRows (int beginRow, int endRow)
+{
+	using ASTCDecompressInternal::ASTCDecodeTables;
+
+	std::vector<deUint8>					uncompressedBlock	(m_dst.getFormat().getPixelSize() * m_blockPixelSize.x() * m_blockPixelSize.y() * m_blockPixelSize.z());
+	const PixelBufferAccess					blockAccess			(m_dst.getFormat(), m_blockPixelSize.x(), m_blockPixelSize.y(), m_blockPixelSize.z(), &uncompressedBlock[0]);
+	const de::UniquePtr<ASTCDecodeTables>	astcTables			(isAstcFormat(m_format) ? new ASTCDecodeTables(m_blockPixelSize.x(), m_blockPixelSize.y()) : DE_NULL);
+
+	for (int rowNdx = beginRow; rowNdx < endRow; rowNdx++)
+	for (int blockX = 0; blockX < m_blockCount.x(); blockX++)
+	{
+		const IVec3				blockPos	(blockX, rowNdx % m_blockCount.y(), rowNdx / m_blockCount.y());
+		const deUint8* const	blockPtr	= m_src + componentSum(blockPos * m_blockPitches);
+		const IVec3				copySize	(de::min(m_blockPixelSize.x(), m_dst.getWidth()		- blockPos.x() * m_blockPixelSize.x()),
+											 de::min(m_blockPixelSize.y(), m_dst.getHeight()	- blockPos.y() * m_blockPixelSize.y()),
+											 de::min(m_blockPixelSize.z(), m_dst.getDepth()		- blockPos.z() * m_blockPixelSize.z()));
+		const IVec3				dstPixelPos	= blockPos * m_blockPixelSize;
+		const PixelBufferAccess	dstRegion	= getSubregion(m_dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z());
+
+		if (m_directWrite && copySize == m_blockPixelSize)
+			decompressBlock(m_format, dstRegion, blockPtr, m_params, astcTables.get());
+		else
+		{
+			decompressBlock(m_format, blockAccess, blockPtr, m_params, astcTables.get());
+			copy(dstRegion, getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
+		}
+	}
+}
+
 } // anonymous
 
 void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
 {
-	const int				blockSize			= getBlockSize(fmt);
 	const IVec3				blockPixelSize		(getBlockPixelSize(fmt));
-	const IVec3				blockCount			(divRoundUp(dst.getWidth(),		blockPixelSize.x()),
-												 divRoundUp(dst.getHeight(),	blockPixelSize.y()),
-												 divRoundUp(dst.getDepth(),		blockPixelSize.z()));
-	const IVec3				blockPitches		(blockSize, blockSize * blockCount.x(), blockSize * blockCount.x() * blockCount.y());
-
-	std::vector<deUint8>	uncompressedBlock	(dst.getFormat().getPixelSize() * blockPixelSize.x() * blockPixelSize.y() * blockPixelSize.z());
-	const PixelBufferAccess	blockAccess			(getUncompressedFormat(fmt), blockPixelSize.x(), blockPixelSize.y(), blockPixelSize.z(), &uncompressedBlock[0]);
+	const int				numBlockRows		= divRoundUp(dst.getHeight(), blockPixelSize.y()) * divRoundUp(dst.getDepth(), blockPixelSize.z());
+	const int				numBlocksPerRow		= divRoundUp(dst.getWidth(), blockPixelSize.x());
+	const int				numBands			= getNumRowBands(numBlockRows, numBlocksPerRow * blockPixelSize.x() * blockPixelSize.y() * blockPixelSize.z());
 
 	DE_ASSERT(dst.getFormat() == getUncompressedFormat(fmt));
 
-	for (int blockZ = 0; blockZ < blockCount.z(); blockZ++)
-	for (int blockY = 0; blockY < blockCount.y(); blockY++)
-	for (int blockX = 0; blockX < blockCount.x(); blockX++)
-	{
-		const IVec3				blockPos	(blockX, blockY, blockZ);
-		const deUint8* const	blockPtr	= src + componentSum(blockPos * blockPitches);
-		const IVec3				copySize	(de::min(blockPixelSize.x(), dst.getWidth()		- blockPos.x() * blockPixelSize.x()),
-											 de::min(blockPixelSize.y(), dst.getHeight()	- blockPos.y() * blockPixelSize.y()),
-											 de::min(blockPixelSize.z(), dst.getDepth()		- blockPos.z() * blockPixelSize.z()));
-		const IVec3				dstPixelPos	= blockPos * blockPixelSize;
+	if (numBlockRows == 0 || numBlocksPerRow == 0)
+		return;
 
-		decompressBlock(fmt, blockAccess, blockPtr, params);
+	{
+		DecompressBlockRowsJob job (dst, fmt, src, params, numBands);
 
-		copy(getSubregion(dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z()), getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
+		executeRowBands(job, numBlockRows, numBands);
+		job.throwErrors();
 	}
 }
 
@@ -2664,7 +2890,10 @@ void CompressedTexture::decompress (const PixelBufferAccess& dst, const TexDecom
 	DE_ASSERT(dst.getWidth() == m_width && dst.getHeight() == m_height && dst.getDepth() == m_depth);
 	DE_ASSERT(dst.getFormat() == getUncompressedFormat(m_format));
 
-	tcu::decompress(dst, m_format, &m_data[0], params);
+	if (getDecompressedTextureCacheSize() > 0)
+		copy(dst, getDecompressedTexture(*this, params).getAccess());
+	else
+		tcu::decompress(dst, m_format, &m_data[0], params);
 }
 
 } // tcu
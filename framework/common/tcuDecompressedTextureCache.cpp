@@ -0,0 +1,307 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Process-wide cache of decompressed textures.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDecompressedTextureCache.hpp"
+#include "deMutex.hpp"
+#include "deString.h"
+#include "deMemory.h"
+
+#include <list>
+#include <map>
+
+namespace tcu
+{
+namespace
+{
+
+struct CacheKey
+{
+	CompressedTexFormat					format;
+	IVec3								size;
+	TexDecompressionParams::AstcMode	astcMode;
+	int									dataSize;
+	deUint32							dataHash;
+
+	bool operator< (const CacheKey& other) const
+	{
+		if (format != other.format)		return format < other.format;
+		if (size.x() != other.size.x())	return size.x() < other.size.x();
+		if (size.y() != other.size.y())	return size.y() < other.size.y();
+		if (size.z() != other.size.z())	return size.z() < other.size.z();
+		if (astcMode != other.astcMode)	return astcMode < other.astcMode;
+		if (dataSize != other.dataSize)	return dataSize < other.dataSize;
+		return dataHash < other.dataHash;
+	}
+};
+
+CacheKey getCacheKey (const CompressedTexture& texture, const TexDecompressionParams& params)
+{
+	CacheKey key;
+
+	key.format		= texture.getFormat();
+	key.size		= IVec3(texture.getWidth(), texture.getHeight(), texture.getDepth());
+	key.astcMode	= isAstcFormat(texture.getFormat()) ? params.astcMode : TexDecompressionParams::ASTCMODE_LAST; // Mode only affects ASTC decoding
+	key.dataSize	= texture.getDataSize();
+	key.dataHash	= deMemoryHash(texture.getData(), texture.getDataSize());
+
+	return key;
+}
+
+size_t getDecompressedSize (const CompressedTexture& texture)
+{
+	return (size_t)getUncompressedFormat(texture.getFormat()).getPixelSize() * (size_t)texture.getWidth() * (size_t)texture.getHeight() * (size_t)texture.getDepth();
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief LRU cache of decompressed textures
+ *
+ * Entries are keyed by texture format, size, decompression parameters
+ * and a hash of the compressed data. Entries also keep a copy of the
+ * compressed data so that hash collisions are never returned as hits.
+ * Both copies count towards the byte budget.
+ *
+ * Decompression happens outside the cache lock; concurrent misses on
+ * the same texture may decompress it more than once.
+ *//*--------------------------------------------------------------------*/
+class DecompressedTextureCache
+{
+public:
+									DecompressedTextureCache	(void);
+
+	void							setMaxBytes					(size_t maxBytes);
+	size_t							getMaxBytes					(void);
+
+	void							clear						(void);
+	DecompressedTextureCacheStats	getStats					(void);
+
+	DecompressedTexture				get							(const CompressedTexture& texture, const TexDecompressionParams& params);
+
+private:
+	struct Entry
+	{
+		CacheKey						key;
+		std::vector<deUint8>			compressedData;
+		de::SharedPtr<TextureLevel>		level;
+		size_t							numBytes;
+	};
+
+	typedef std::list<Entry>							EntryList;		//!< Most recently used first
+	typedef std::map<CacheKey, EntryList::iterator>		EntryMap;
+
+	DecompressedTexture				find						(const CacheKey& key, const CompressedTexture& texture);
+	void							insert						(const CacheKey& key, const CompressedTexture& texture, const de::SharedPtr<TextureLevel>& level, size_t numBytes);
+	void							evict						(size_t maxBytes);
+
+	de::Mutex						m_lock;
+	size_t							m_maxBytes;
+	EntryList						m_entries;
+	EntryMap						m_entryMap;
+	DecompressedTextureCacheStats	m_stats;
+};
+
+DecompressedTextureCache::DecompressedTextureCache (void)
+	: m_maxBytes(0)
+{
+}
+
+void DecompressedTextureCache::setMaxBytes (size_t maxBytes)
+{
+	const de::ScopedLock lock (m_lock);
+
+	m_maxBytes = maxBytes;
+	evict(maxBytes);
+}
+
+size_t DecompressedTextureCache::getMaxBytes (void)
+{
+	const de::ScopedLock lock (m_lock);
+	return m_maxBytes;
+}
+
+void DecompressedTextureCache::clear (void)
+{
+	const de::ScopedLock lock (m_lock);
+
+	m_entries.clear();
+	m_entryMap.clear();
+	m_stats.numBytes	= 0;
+	m_stats.numEntries	= 0;
+}
+
+DecompressedTextureCacheStats DecompressedTextureCache::getStats (void)
+{
+	const de::ScopedLock lock (m_lock);
+	return m_stats;
+}
+
+DecompressedTexture DecompressedTextureCache::get (const CompressedTexture& texture, const TexDecompressionParams& params)
+{
+	const CacheKey	key			= getCacheKey(texture, params);
+	const size_t	numBytes	= getDecompressedSize(texture) + (size_t)texture.getDataSize();
+
+	{
+		const de::ScopedLock		lock	(m_lock);
+		const DecompressedTexture	cached	= find(key, texture);
+
+		if (!cached.isNull())
+		{
+			m_stats.numHits += 1;
+			return cached;
+		}
+
+		m_stats.numMisses += 1;
+	}
+
+	{
+		const de::SharedPtr<TextureLevel> level (new TextureLevel(getUncompressedFormat(texture.getFormat()), texture.getWidth(), texture.getHeight(), texture.getDepth()));
+
+		decompress(level->getAccess(), texture.getFormat(), (const deUint8*)texture.getData(), params);
+
+		{
+			const de::ScopedLock lock (m_lock);
+
+			if (numBytes <= m_maxBytes)
+				insert(key, texture, level, numBytes);
+		}
+
+		return DecompressedTexture(level);
+	}
+}
+
+DecompressedTexture DecompressedTextureCache::find (const CacheKey& key, const CompressedTexture& texture)
+{
+	const EntryMap::iterator pos = m_entryMap.find(key);
+
+	if (pos == m_entryMap.end())
+		return DecompressedTexture();
+
+	{
+		const EntryList::iterator entry = pos->second;
+
+		if (deMemCmp(&entry->compressedData[0], texture.getData(), texture.getDataSize()) != 0)
+			return DecompressedTexture(); // Hash collision
+
+		m_entries.splice(m_entries.begin(), m_entries, entry);
+
+		return DecompressedTexture(entry->level);
+	}
+}
+
+void DecompressedTextureCache::insert (const CacheKey& key, const CompressedTexture& texture, const de::SharedPtr<TextureLevel>& level, size_t numBytes)
+{
+	const EntryMap::iterator existing = m_entryMap.find(key);
+
+	// Replace colliding or concurrently inserted entry
+	if (existing != m_entryMap.end())
+	{
+		m_stats.numBytes	-= existing->second->numBytes;
+		m_stats.numEntries	-= 1;
+		m_entries.erase(existing->second);
+		m_entryMap.erase(existing);
+	}
+
+	{
+		std::vector<deUint8> compressedData ((const deUint8*)texture.getData(), (const deUint8*)texture.getData() + texture.getDataSize());
+
+		evict(m_maxBytes - numBytes);
+
+		m_entries.push_front(Entry());
+
+		try
+		{
+			Entry& entry = m_entries.front();
+
+			entry.key		= key;
+			entry.level		= level;
+			entry.numBytes	= numBytes;
+			entry.compressedData.swap(compressedData);
+
+			m_entryMap[key] = m_entries.begin();
+		}
+		catch (...)
+		{
+			m_entries.pop_front();
+			throw;
+		}
+	}
+
+	m_stats.numBytes	+= numBytes;
+	m_stats.numEntries	+= 1;
+}
+
+//! Evict least recently used entries until at most maxBytes are used
+void DecompressedTextureCache::evict (size_t maxBytes)
+{
+	while (m_stats.numBytes > maxBytes)
+	{
+		DE_ASSERT(!m_entries.empty());
+
+		const Entry& entry = m_entries.back();
+
+		m_stats.numBytes		-= entry.numBytes;
+		m_stats.numEntries		-= 1;
+		m_stats.numEvictions	+= 1;
+
+		m_entryMap.erase(entry.key);
+		m_entries.pop_back();
+	}
+}
+
+static DecompressedTextureCache s_decompressedTextureCache;
+
+} // anonymous
+
+void setDecompressedTextureCacheSize (size_t maxBytes)
+{
+	s_decompressedTextureCache.setMaxBytes(maxBytes);
+}
+
+size_t getDecompressedTextureCacheSize (void)
+{
+	return s_decompressedTextureCache.getMaxBytes();
+}
+
+//! Drop all entries. Statistics are kept and borrowed textures stay valid.
+void clearDecompressedTextureCache (void)
+{
+	s_decompressedTextureCache.clear();
+}
+
+DecompressedTextureCacheStats getDecompressedTextureCacheStats (void)
+{
+	return s_decompressedTextureCache.getStats();
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get decompressed texture from the cache
+ *
+ * Decompresses the texture on a miss. The result is added to the cache
+ * if it fits in the byte budget, otherwise it is only owned by the
+ * returned object.
+ *//*--------------------------------------------------------------------*/
+DecompressedTexture getDecompressedTexture (const CompressedTexture& texture, const TexDecompressionParams& params)
+{
+	return s_decompressedTextureCache.get(texture, params);
+}
+
+} // tcu
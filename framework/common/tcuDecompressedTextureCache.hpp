@@ -0,0 +1,82 @@
+#ifndef _TCUDECOMPRESSEDTEXTURECACHE_HPP
+#define _TCUDECOMPRESSEDTEXTURECACHE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Process-wide cache of decompressed textures.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "tcuCompressedTexture.hpp"
+#include "deSharedPtr.hpp"
+
+namespace tcu
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Decompressed texture borrowed from the cache
+ *
+ * Holds a reference to the decoded texels, which stay valid for the
+ * lifetime of the object even if the cache evicts the entry. The texels
+ * must not be modified.
+ *//*--------------------------------------------------------------------*/
+class DecompressedTexture
+{
+public:
+									DecompressedTexture		(void) {}
+	explicit						DecompressedTexture		(const de::SharedPtr<TextureLevel>& level) : m_level(level) {}
+
+	bool							isNull					(void) const { return !m_level;					}
+	ConstPixelBufferAccess			getAccess				(void) const { return m_level->getAccess();	}
+
+private:
+	de::SharedPtr<TextureLevel>		m_level;
+};
+
+struct DecompressedTextureCacheStats
+{
+	deUint64	numHits;
+	deUint64	numMisses;
+	deUint64	numEvictions;
+	size_t		numBytes;		//!< Bytes currently held by cache entries
+	int			numEntries;
+
+	DecompressedTextureCacheStats (void)
+		: numHits		(0)
+		, numMisses		(0)
+		, numEvictions	(0)
+		, numBytes		(0)
+		, numEntries	(0)
+	{
+	}
+};
+
+// Cache byte budget, 0 disables the cache. Shrinking the budget evicts entries immediately.
+void							setDecompressedTextureCacheSize		(size_t maxBytes);
+size_t							getDecompressedTextureCacheSize		(void);
+
+void							clearDecompressedTextureCache		(void);
+DecompressedTextureCacheStats	getDecompressedTextureCacheStats	(void);
+
+DecompressedTexture				getDecompressedTexture				(const CompressedTexture& texture, const TexDecompressionParams& params = TexDecompressionParams());
+
+} // tcu
+
+#endif // _TCUDECOMPRESSEDTEXTURECACHE_HPP
@@ -26,6 +26,7 @@
 #include "tcuTextureUtil.hpp"
 #include "deMath.h"
 #include "deRandom.hpp"
+#include "tcuImageCompareThreads.hpp"
 
 #include <vector>
 
@@ -157,58 +158,120 @@ inline deUint32 bilinearSample (const ConstPixelBufferAccess& src, float u, floa
 }
 
 template<int DstChannels, int SrcChannels>
-static void separableConvolve (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shiftX, int shiftY, const std::vector<float>& kernelX, const std::vector<float>& kernelY)
+class HorizontalConvolveJob : public RowBandJob
 {
-	DE_ASSERT(dst.getWidth() == src.getWidth() && dst.getHeight() == src.getHeight());
+public:
+	HorizontalConvolveJob (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shift, const std::vector<float>& kernel)
+		: m_dst		(dst)
+		, m_src		(src)
+		, m_shift	(shift)
+		, m_kernel	(kernel)
+	{
+	}
 
-	TextureLevel		tmp			(dst.getFormat(), dst.getHeight(), dst.getWidth());
-	PixelBufferAccess	tmpAccess	= tmp.getAccess();
+	// \note Destination surface is written in column-wise order
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int kw = (int)m_kernel.size();
 
-	int kw = (int)kernelX.size();
-	int kh = (int)kernelY.size();
+		DE_UNREF(bandNdx);
 
-	// Horizontal pass
-	// \note Temporary surface is written in column-wise order
-	for (int j = 0; j < src.getHeight(); j++)
-	{
-		for (int i = 0; i < src.getWidth(); i++)
+		for (int j = beginRow; j < endRow; j++)
 		{
-			Vec4 sum(0);
-
-			for (int kx = 0; kx < kw; kx++)
+			for (int i = 0; i < m_src.getWidth(); i++)
 			{
-				float		f = kernelX[kw-kx-1];
-				deUint32	p = readUnorm8<SrcChannels>(src, de::clamp(i+kx-shiftX, 0, src.getWidth()-1), j);
+				Vec4 sum(0);
 
-				sum += toFloatVec(p)*f;
-			}
+				for (int kx = 0; kx < kw; kx++)
+				{
+					float		f = m_kernel[kw-kx-1];
+					deUint32	p = readUnorm8<SrcChannels>(m_src, de::clamp(i+kx-m_shift, 0, m_src.getWidth()-1), j);
 
-			writeUnorm8<DstChannels>(tmpAccess, j, i, toColor(sum));
+					sum += toFloatVec(p)*f;
+				}
+
+				writeUnorm8<DstChannels>(m_dst, j, i, toColor(sum));
+			}
 		}
 	}
 
-	// Vertical pass
-	for (int j = 0; j < src.getHeight(); j++)
+private:
+	const PixelBufferAccess&		m_dst;
+	const ConstPixelBufferAccess&	m_src;
+	const int						m_shift;
+	const std::vector<float>&		m_kernel;
+};
+
+template<int DstChannels>
+class VerticalConvolveJob : public RowBandJob
+{
+public:
+	VerticalConvolveJob (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shift, const std::vector<float>& kernel)
+		: m_dst		(dst)
+		, m_src		(src)
+		, m_shift	(shift)
+		, m_kernel	(kernel)
 	{
-		for (int i = 0; i < src.getWidth(); i++)
-		{
-			Vec4 sum(0.0f);
+	}
+
+	// \note Source surface is read in column-wise order
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int kh = (int)m_kernel.size();
+
+		DE_UNREF(bandNdx);
 
-			for (int ky = 0; ky < kh; ky++)
+		for (int j = beginRow; j < endRow; j++)
+		{
+			for (int i = 0; i < m_dst.getWidth(); i++)
 			{
-				float		f = kernelY[kh-ky-1];
-				deUint32	p = readUnorm8<DstChannels>(tmpAccess, de::clamp(j+ky-shiftY, 0, tmp.getWidth()-1), i);
+				Vec4 sum(0.0f);
 
-				sum += toFloatVec(p)*f;
-			}
+				for (int ky = 0; ky < kh; ky++)
+				{
+					float		f = m_kernel[kh-ky-1];
+					deUint32	p = readUnorm8<DstChannels>(m_src, de::clamp(j+ky-m_shift, 0, m_src.getWidth()-1), i);
+
+					sum += toFloatVec(p)*f;
+				}
 
-			writeUnorm8<DstChannels>(dst, i, j, toColor(sum));
+				writeUnorm8<DstChannels>(m_dst, i, j, toColor(sum));
+			}
 		}
 	}
+
+private:
+	const PixelBufferAccess&		m_dst;
+	const ConstPixelBufferAccess&	m_src;
+	const int						m_shift;
+	const std::vector<float>&		m_kernel;
+};
+
+template<int DstChannels, int SrcChannels>
+static void separableConvolve (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shiftX, int shiftY, const std::vector<float>& kernelX, const std::vector<float>& kernelY)
+{
+	DE_ASSERT(dst.getWidth() == src.getWidth() && dst.getHeight() == src.getHeight());
+
+	TextureLevel		tmp			(dst.getFormat(), dst.getHeight(), dst.getWidth());
+	PixelBufferAccess	tmpAccess	= tmp.getAccess();
+	const int			numRows		= src.getHeight();
+	const int			numBands	= getNumRowBands(numRows, src.getWidth());
+
+	// Horizontal pass
+	{
+		HorizontalConvolveJob<DstChannels, SrcChannels> job (tmpAccess, src, shiftX, kernelX);
+		executeRowBands(job, numRows, numBands);
+	}
+
+	// Vertical pass
+	{
+		VerticalConvolveJob<DstChannels> job (dst, tmpAccess, shiftY, kernelY);
+		executeRowBands(job, numRows, numBands);
+	}
 }
 
 template<int NumChannels>
-static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rnd, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y)
+static float compareToNeighborPixels (const FuzzyCompareParams& params, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y)
 {
 	float minErr = +100.f;
 
@@ -243,6 +306,16 @@ static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rn
 			return minErr;
 	}
 
+	return minErr;
+}
+
+template<int NumChannels>
+static float compareToBilinearSamples (const FuzzyCompareParams& params, de::Random& rnd, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y, float minErr)
+{
+	// \note No random numbers are consumed if neighbor pixels already matched exactly.
+	if (minErr == 0.0f)
+		return minErr;
+
 	// Random bilinear-interpolated samples around (x, y)
 	for (int s = 0; s < 32; s++)
 	{
@@ -259,6 +332,12 @@ static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rn
 	return minErr;
 }
 
+template<int NumChannels>
+static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rnd, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y)
+{
+	return compareToBilinearSamples<NumChannels>(params, rnd, pixel, surface, x, y, compareToNeighborPixels<NumChannels>(params, pixel, surface, x, y));
+}
+
 static inline float toGrayscale (const Vec4& c)
 {
 	return 0.2126f*c[0] + 0.7152f*c[1] + 0.0722f*c[2];
@@ -269,6 +348,90 @@ static bool isFormatSupported (const TextureFormat& format)
 	return format.type == TextureFormat::UNORM_INT8 && (format.order == TextureFormat::RGB || format.order == TextureFormat::RGBA);
 }
 
+static inline Vec4 getErrorMaskColor (const Vec4& cmpPixel, float err)
+{
+	float	red		= err * 500.0f;
+	float	luma	= toGrayscale(cmpPixel);
+	float	rF		= 0.7f + 0.3f*luma;
+	return Vec4(red*rF, (1.0f-red)*rF, 0.0f, 1.0f);
+}
+
+static inline void setErrorMaskPixel (const ConstPixelBufferAccess& cmp, const PixelBufferAccess& errorMask, int x, int y, float err)
+{
+	errorMask.setPixel(getErrorMaskColor(cmp.getPixel(x, y), err), x, y);
+}
+
+//! Computes neighbor pixel errors for both comparison directions of all inner pixels.
+class NeighborErrorJob : public RowBandJob
+{
+public:
+	NeighborErrorJob (const FuzzyCompareParams& params, const ConstPixelBufferAccess& ref, const ConstPixelBufferAccess& cmp, float* dst)
+		: m_params	(params)
+		, m_ref		(ref)
+		, m_cmp		(cmp)
+		, m_dst		(dst)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int width = m_ref.getWidth();
+
+		DE_UNREF(bandNdx);
+
+		for (int y = de::max(beginRow, 1); y < de::min(endRow, m_ref.getHeight()-1); y++)
+		{
+			for (int x = 1; x < width-1; x++)
+			{
+				m_dst[(y*width + x)*2 + 0] = compareToNeighborPixels<4>(m_params, readUnorm8<4>(m_ref, x, y), m_cmp, x, y);
+				m_dst[(y*width + x)*2 + 1] = compareToNeighborPixels<4>(m_params, readUnorm8<4>(m_cmp, x, y), m_ref, x, y);
+			}
+		}
+	}
+
+private:
+	const FuzzyCompareParams&		m_params;
+	const ConstPixelBufferAccess&	m_ref;
+	const ConstPixelBufferAccess&	m_cmp;
+	float* const					m_dst;
+};
+
+//! Writes error image for all inner pixels.
+class ErrorMaskJob : public RowBandJob
+{
+public:
+	ErrorMaskJob (const ConstPixelBufferAccess& cmp, const PixelBufferAccess& errorMask, const float* pixelErr)
+		: m_cmp			(cmp)
+		, m_errorMask	(errorMask)
+		, m_pixelErr	(pixelErr)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int		width		= m_cmp.getWidth();
+		const int		numPixels	= width-2;
+		vector<Vec4>	row			(de::max(numPixels, 0));
+
+		DE_UNREF(bandNdx);
+
+		for (int y = de::max(beginRow, 1); y < de::min(endRow, m_cmp.getHeight()-1) && numPixels > 0; y++)
+		{
+			m_cmp.getPixelRow(1, y, 0, numPixels, &row[0]);
+
+			for (int x = 0; x < numPixels; x++)
+				row[x] = getErrorMaskColor(row[x], m_pixelErr[y*width + x + 1]);
+
+			m_errorMask.setPixelRow(&row[0], 1, y, 0, numPixels);
+		}
+	}
+
+private:
+	const ConstPixelBufferAccess&	m_cmp;
+	const PixelBufferAccess&		m_errorMask;
+	const float* const				m_pixelErr;
+};
+
 float fuzzyCompare (const FuzzyCompareParams& params, const ConstPixelBufferAccess& ref, const ConstPixelBufferAccess& cmp, const PixelBufferAccess& errorMask)
 {
 	DE_ASSERT(ref.getWidth() == cmp.getWidth() && ref.getHeight() == cmp.getHeight());
@@ -315,24 +478,61 @@ float fuzzyCompare (const FuzzyCompareParams& params, const ConstPixelBufferAcce
 	ConstPixelBufferAccess refAccess = refFiltered.getAccess();
 	ConstPixelBufferAccess cmpAccess = cmpFiltered.getAccess();
 
-	for (int y = 1; y < height-1; y++)
+	const int numBands = getNumRowBands(height, width);
+
+	if (numBands > 1 && params.maxSampleSkip == 0)
 	{
-		for (int x = 1; x < width-1; x += params.maxSampleSkip > 0 ? (int)rnd.getInt(0, params.maxSampleSkip) : 1)
+		// Every pixel is sampled: compare to neighbor pixels and build error image
+		// in parallel. Random samples consume a single random sequence and are
+		// taken serially in the original order.
+		const int			numPixels	= width*height;
+		vector<float>		neighborErr	(numPixels*2);
+		vector<float>		pixelErr	(numPixels);
+
 		{
-			const float	err0	= compareToNeighbor<4>(params, rnd, readUnorm8<4>(refAccess, x, y), cmpAccess, x, y);
-			const float	err1	= compareToNeighbor<4>(params, rnd, readUnorm8<4>(cmpAccess, x, y), refAccess, x, y);
-			float		err		= deFloatMin(err0, err1);
+			NeighborErrorJob job (params, refAccess, cmpAccess, &neighborErr[0]);
+			executeRowBands(job, height, numBands);
+		}
 
-			err = deFloatPow(err, params.errExp);
+		for (int y = 1; y < height-1; y++)
+		{
+			for (int x = 1; x < width-1; x++)
+			{
+				const int	ndx		= y*width + x;
+				const float	err0	= compareToBilinearSamples<4>(params, rnd, readUnorm8<4>(refAccess, x, y), cmpAccess, x, y, neighborErr[ndx*2 + 0]);
+				const float	err1	= compareToBilinearSamples<4>(params, rnd, readUnorm8<4>(cmpAccess, x, y), refAccess, x, y, neighborErr[ndx*2 + 1]);
+				float		err		= deFloatMin(err0, err1);
 
-			errSum		+= err;
-			numSamples	+= 1;
+				err = deFloatPow(err, params.errExp);
 
-			// Build error image.
-			float	red		= err * 500.0f;
-			float	luma	= toGrayscale(cmp.getPixel(x, y));
-			float	rF		= 0.7f + 0.3f*luma;
-			errorMask.setPixel(Vec4(red*rF, (1.0f-red)*rF, 0.0f, 1.0f), x, y);
+				errSum			+= err;
+				numSamples		+= 1;
+				pixelErr[ndx]	 = err;
+			}
+		}
+
+		{
+			ErrorMaskJob job (cmp, errorMask, &pixelErr[0]);
+			executeRowBands(job, height, numBands);
+		}
+	}
+	else
+	{
+		for (int y = 1; y < height-1; y++)
+		{
+			for (int x = 1; x < width-1; x += params.maxSampleSkip > 0 ? (int)rnd.getInt(0, params.maxSampleSkip) : 1)
+			{
+				const float	err0	= compareToNeighbor<4>(params, rnd, readUnorm8<4>(refAccess, x, y), cmpAccess, x, y);
+				const float	err1	= compareToNeighbor<4>(params, rnd, readUnorm8<4>(cmpAccess, x, y), refAccess, x, y);
+				float		err		= deFloatMin(err0, err1);
+
+				err = deFloatPow(err, params.errExp);
+
+				errSum		+= err;
+				numSamples	+= 1;
+
+				setErrorMaskPixel(cmp, errorMask, x, y, err);
+			}
 		}
 	}
 
@@ -32,12 +32,23 @@
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuImageCompareThreads.hpp"
+#include "deClock.h"
+#include "deMemory.h"
 
 #include <string.h>
+#include <vector>
+
+#if (DE_CPU == DE_CPU_X86_64) || ((DE_CPU == DE_CPU_X86) && defined(__SSE2__))
+#	define TCU_IMAGE_COMPARE_SSE2
+#	include <emmintrin.h>
+#endif
 
 namespace tcu
 {
 
+using std::vector;
+
 namespace
 {
 
@@ -88,40 +99,551 @@ void computeScaleAndBias (const ConstPixelBufferAccess& reference, const ConstPi
 	}
 }
 
-static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+/*--------------------------------------------------------------------*//*!
+ * Returns the index of float in a float space without denormals
+ * so that:
+ * 1) f(0.0) = 0
+ * 2) f(-0.0) = 0
+ * 3) f(b) = f(a) + 1  <==>  b = nextAfter(a)
+ *
+ * See computeFloatFlushRelaxedULPDiff for details
+ *//*--------------------------------------------------------------------*/
+static deInt32 getPositionOfIEEEFloatWithoutDenormals (float x)
 {
-	const tcu::IVec4	okColor				(0, 255, 0, 255);
-	const tcu::IVec4	errorColor			(255, 0, 0, 255);
-	const int			width				= reference.getWidth();
-	const int			height				= reference.getHeight();
-	const int			depth				= reference.getDepth();
-	int					numFailingPixels	= 0;
+	DE_ASSERT(!deIsNaN(x)); // not sane
 
-	// Accept pixels "sampling" over the image bounds pixels since "taps" could be anything
-	const int			beginX				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.x()) : (0);
-	const int			beginY				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.y()) : (0);
-	const int			beginZ				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.z()) : (0);
-	const int			endX				= (acceptOutOfBoundsAsAnyValue) ? (width  - maxPositionDeviation.x()) : (0);
-	const int			endY				= (acceptOutOfBoundsAsAnyValue) ? (height - maxPositionDeviation.y()) : (0);
-	const int			endZ				= (acceptOutOfBoundsAsAnyValue) ? (depth  - maxPositionDeviation.z()) : (0);
+	if (x == 0.0f)
+		return 0;
+	else if (x < 0.0f)
+		return -getPositionOfIEEEFloatWithoutDenormals(-x);
+	else
+	{
+		DE_ASSERT(x > 0.0f);
 
-	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
+		const tcu::Float32 f(x);
 
-	tcu::clear(errorMask, okColor);
+		if (f.isDenorm())
+		{
+			// Denorms are flushed to zero
+			return 0;
+		}
+		else
+		{
+			// sign is 0, and it's a normal number. Natural position is its bit
+			// pattern but since we've collapsed the denorms, we must remove
+			// the gap here too to keep the float enumeration continuous.
+			//
+			// Denormals occupy one exponent pattern. Removing one from
+			// exponent should to the trick.
+			return (deInt32)(f.bits() - (1u << 23u));
+		}
+	}
+}
+
+static deUint32 computeFloatFlushRelaxedULPDiff (float a, float b)
+{
+	if (deIsNaN(a) && deIsNaN(b))
+		return 0;
+	else if (deIsNaN(a) || deIsNaN(b))
+	{
+		return 0xFFFFFFFFu;
+	}
+	else
+	{
+		// Using the "definition 5" in Muller, Jean-Michel. "On the definition of ulp (x)" (2005)
+		// assuming a floating point space is IEEE single precision floating point space without
+		// denormals (and signed zeros).
+		const deInt32 aIndex = getPositionOfIEEEFloatWithoutDenormals(a);
+		const deInt32 bIndex = getPositionOfIEEEFloatWithoutDenormals(b);
+		return (deUint32)de::abs(aIndex - bIndex);
+	}
+}
+
+static tcu::UVec4 computeFlushRelaxedULPDiff (const tcu::Vec4& a, const tcu::Vec4& b)
+{
+	return tcu::UVec4(computeFloatFlushRelaxedULPDiff(a.x(), b.x()),
+					  computeFloatFlushRelaxedULPDiff(a.y(), b.y()),
+					  computeFloatFlushRelaxedULPDiff(a.z(), b.z()),
+					  computeFloatFlushRelaxedULPDiff(a.w(), b.w()));
+}
+
+enum
+{
+	MASK_PIXEL_SIZE	= 3	//!< Error masks are RGB, UNORM_INT8.
+};
+
+static inline bool isRGBA8 (const ConstPixelBufferAccess& access)
+{
+	return access.getFormat() == TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8) && access.getPixelPitch() == 4;
+}
+
+static inline bool isRGBA32F (const ConstPixelBufferAccess& access)
+{
+	return access.getFormat() == TextureFormat(TextureFormat::RGBA, TextureFormat::FLOAT) && access.getPixelPitch() == 4*(int)sizeof(float);
+}
+
+static inline void writeMaskPixel (deUint8* dst, bool isOk)
+{
+	dst[0] = isOk ? 0x00 : 0xff;
+	dst[1] = isOk ? 0xff : 0x00;
+	dst[2] = 0x00;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row conversion storage, one row per band
+ *
+ * Comparison jobs process rows of all slices as one sequence of
+ * height*depth rows, row r being (y, z) = (r % height, r / height).
+ *//*--------------------------------------------------------------------*/
+template<typename T>
+class BandRowBuffer
+{
+public:
+	BandRowBuffer (int width, int numBands)
+		: m_width	(width)
+		, m_data	(width*numBands)
+	{
+	}
+
+	T* get (int bandNdx)
+	{
+		return (m_width > 0) ? (&m_data[bandNdx*m_width]) : (DE_NULL);
+	}
+
+private:
+	const int		m_width;
+	vector<T>		m_data;
+};
+
+class FloatUlpThresholdCompareJob : public RowBandJob
+{
+public:
+	FloatUlpThresholdCompareJob (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const PixelBufferAccess& errorMask, int numBands)
+		: m_reference	(reference)
+		, m_result		(result)
+		, m_threshold	(threshold)
+		, m_errorMask	(errorMask)
+		, m_refRows		(reference.getWidth(), numBands)
+		, m_cmpRows		(reference.getWidth(), numBands)
+		, m_maskRows	(reference.getWidth(), numBands)
+		, m_maxDiff		(numBands, UVec4(0))
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int	width	= m_reference.getWidth();
+		const int	height	= m_reference.getHeight();
+		Vec4*		refRow	= m_refRows.get(bandNdx);
+		Vec4*		cmpRow	= m_cmpRows.get(bandNdx);
+		IVec4*		maskRow	= m_maskRows.get(bandNdx);
+		UVec4		maxDiff	(0, 0, 0, 0);
+
+		for (int row = beginRow; row < endRow && width > 0; row++)
+		{
+			const int y = row % height;
+			const int z = row / height;
+
+			m_reference.getPixelRow(0, y, z, width, refRow);
+			m_result.getPixelRow(0, y, z, width, cmpRow);
+
+			for (int x = 0; x < width; x++)
+			{
+				const UVec4	diff	= computeFlushRelaxedULPDiff(refRow[x], cmpRow[x]);
+				const bool	isOk	= boolAll(lessThanEqual(diff, m_threshold));
+
+				maxDiff = max(maxDiff, diff);
+
+				maskRow[x] = isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff);
+			}
+
+			m_errorMask.setPixelRow(maskRow, 0, y, z, width);
+		}
+
+		m_maxDiff[bandNdx] = maxDiff;
+	}
+
+	UVec4 getMaxDiff (void) const
+	{
+		UVec4 maxDiff (0, 0, 0, 0);
+
+		for (size_t bandNdx = 0; bandNdx < m_maxDiff.size(); bandNdx++)
+			maxDiff = max(maxDiff, m_maxDiff[bandNdx]);
+
+		return maxDiff;
+	}
+
+private:
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+	const UVec4						m_threshold;
+	const PixelBufferAccess&		m_errorMask;
+	BandRowBuffer<Vec4>				m_refRows;
+	BandRowBuffer<Vec4>				m_cmpRows;
+	BandRowBuffer<IVec4>			m_maskRows;
+	vector<UVec4>					m_maxDiff;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Float threshold comparison against reference image or color
+ *
+ * Maximum difference is folded with max(maxDiff, diff) in pixel order.
+ * The fold is not associative if differences contain NaNs: a NaN replaces
+ * the running maximum which is then replaced by the next difference.
+ * Bands start the fold from NaN and record whether they contain NaNs so
+ * that merging bands in order reproduces the serial result exactly.
+ *//*--------------------------------------------------------------------*/
+class FloatThresholdCompareJob : public RowBandJob
+{
+public:
+	FloatThresholdCompareJob (const ConstPixelBufferAccess* reference, const Vec4& referenceColor, const ConstPixelBufferAccess& result, const Vec4& threshold, const PixelBufferAccess& errorMask, int numBands)
+		: m_reference		(reference)
+		, m_referenceColor	(referenceColor)
+		, m_result			(result)
+		, m_threshold		(threshold)
+		, m_errorMask		(errorMask)
+		, m_refRows			(reference ? result.getWidth() : 0, numBands)
+		, m_cmpRows			(result.getWidth(), numBands)
+		, m_maskRows		(result.getWidth(), numBands)
+		, m_bands			(numBands)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		Band& band = m_bands[bandNdx];
+
+		band.maxDiff	= Vec4(Float32::nan().asFloat());
+		band.hasNaN		= BVec4(false);
+		band.isEmpty	= beginRow == endRow || m_result.getWidth() == 0;
+
+#if defined(TCU_IMAGE_COMPARE_SSE2)
+		if (isRGBA32F(m_result) && (!m_reference || isRGBA32F(*m_reference)))
+			processRowsSSE2(bandNdx, beginRow, endRow, band);
+		else
+#endif
+			processRowsGeneric(bandNdx, beginRow, endRow, band);
+	}
+
+	Vec4 getMaxDiff (void) const
+	{
+		Vec4 maxDiff (0.0f, 0.0f, 0.0f, 0.0f);
+
+		for (size_t bandNdx = 0; bandNdx < m_bands.size(); bandNdx++)
+		{
+			const Band& band = m_bands[bandNdx];
+
+			if (band.isEmpty)
+				continue;
+
+			for (int c = 0; c < 4; c++)
+				maxDiff[c] = band.hasNaN[c] ? band.maxDiff[c] : de::max(maxDiff[c], band.maxDiff[c]);
+		}
+
+		return maxDiff;
+	}
+
+private:
+	struct Band
+	{
+		Vec4	maxDiff;
+		BVec4	hasNaN;
+		bool	isEmpty;
+	};
+
+	void processRowsGeneric (int bandNdx, int beginRow, int endRow, Band& band)
+	{
+		const int	width	= m_result.getWidth();
+		const int	height	= m_result.getHeight();
+		Vec4*		refRow	= m_refRows.get(bandNdx);
+		Vec4*		cmpRow	= m_cmpRows.get(bandNdx);
+		IVec4*		maskRow	= m_maskRows.get(bandNdx);
+		Vec4		maxDiff	= band.maxDiff;
+		BVec4		hasNaN	= band.hasNaN;
+
+		for (int row = beginRow; row < endRow && width > 0; row++)
+		{
+			const int y = row % height;
+			const int z = row / height;
+
+			if (m_reference)
+				m_reference->getPixelRow(0, y, z, width, refRow);
+			m_result.getPixelRow(0, y, z, width, cmpRow);
+
+			for (int x = 0; x < width; x++)
+			{
+				const Vec4	diff	= abs((m_reference ? refRow[x] : m_referenceColor) - cmpRow[x]);
+				const bool	isOk	= boolAll(lessThanEqual(diff, m_threshold));
+
+				maxDiff = max(maxDiff, diff);
+
+				for (int c = 0; c < 4; c++)
+					hasNaN[c] = hasNaN[c] || deIsNaN(diff[c]);
+
+				maskRow[x] = isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff);
+			}
+
+			m_errorMask.setPixelRow(maskRow, 0, y, z, width);
+		}
+
+		band.maxDiff	= maxDiff;
+		band.hasNaN		= hasNaN;
+	}
+
+#if defined(TCU_IMAGE_COMPARE_SSE2)
+	void processRowsSSE2 (int bandNdx, int beginRow, int endRow, Band& band)
+	{
+		const int		width		= m_result.getWidth();
+		const int		height		= m_result.getHeight();
+		const __m128	zero		= _mm_setzero_ps();
+		const __m128	signBit		= _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+		const __m128	threshold	= _mm_loadu_ps(m_threshold.getPtr());
+		const __m128	refColor	= _mm_loadu_ps(m_referenceColor.getPtr());
+		__m128			maxDiff		= _mm_loadu_ps(band.maxDiff.getPtr());
+		__m128			hasNaN		= zero;
+
+		DE_UNREF(bandNdx);
+		DE_ASSERT(m_errorMask.getPixelPitch() == MASK_PIXEL_SIZE);
+
+		for (int row = beginRow; row < endRow; row++)
+		{
+			const int		y		= row % height;
+			const int		z		= row / height;
+			const float*	refRow	= m_reference ? (const float*)m_reference->getPixelPtr(0, y, z) : DE_NULL;
+			const float*	cmpRow	= (const float*)m_result.getPixelPtr(0, y, z);
+			deUint8*		maskRow	= (deUint8*)m_errorMask.getPixelPtr(0, y, z);
+
+			for (int x = 0; x < width; x++)
+			{
+				const __m128	ref		= refRow ? _mm_loadu_ps(refRow + x*4) : refColor;
+				const __m128	sub		= _mm_sub_ps(ref, _mm_loadu_ps(cmpRow + x*4));
+				// de::abs(): x < 0 ? -x : x, keeps signs of zeros and NaNs
+				const __m128	diff	= _mm_xor_ps(sub, _mm_and_ps(_mm_cmplt_ps(sub, zero), signBit));
+				const bool		isOk	= _mm_movemask_ps(_mm_cmple_ps(diff, threshold)) == 0xf;
+				// de::max(): maxDiff >= diff ? maxDiff : diff
+				const __m128	keepMax	= _mm_cmpge_ps(maxDiff, diff);
+
+				maxDiff	= _mm_or_ps(_mm_and_ps(keepMax, maxDiff), _mm_andnot_ps(keepMax, diff));
+				hasNaN	= _mm_or_ps(hasNaN, _mm_cmpunord_ps(diff, diff));
+
+				writeMaskPixel(maskRow + x*MASK_PIXEL_SIZE, isOk);
+			}
+		}
+
+		{
+			const int nanBits = _mm_movemask_ps(hasNaN);
+
+			_mm_storeu_ps(band.maxDiff.getPtr(), maxDiff);
+
+			for (int c = 0; c < 4; c++)
+				band.hasNaN[c] = (nanBits & (1 << c)) != 0;
+		}
+	}
+#endif
+
+	const ConstPixelBufferAccess*	m_reference;
+	const Vec4						m_referenceColor;
+	const ConstPixelBufferAccess&	m_result;
+	const Vec4						m_threshold;
+	const PixelBufferAccess&		m_errorMask;
+	BandRowBuffer<Vec4>				m_refRows;
+	BandRowBuffer<Vec4>				m_cmpRows;
+	BandRowBuffer<IVec4>			m_maskRows;
+	vector<Band>					m_bands;
+};
+
+class IntThresholdCompareJob : public RowBandJob
+{
+public:
+	IntThresholdCompareJob (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const PixelBufferAccess& errorMask, int numBands)
+		: m_reference	(reference)
+		, m_result		(result)
+		, m_threshold	(threshold)
+		, m_errorMask	(errorMask)
+		, m_refRows		(reference.getWidth(), numBands)
+		, m_cmpRows		(reference.getWidth(), numBands)
+		, m_maskRows	(reference.getWidth(), numBands)
+		, m_maxDiff		(numBands, UVec4(0))
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+#if defined(TCU_IMAGE_COMPARE_SSE2)
+		if (isRGBA8(m_reference) && isRGBA8(m_result))
+			processRowsSSE2(bandNdx, beginRow, endRow);
+		else
+#endif
+			processRowsGeneric(bandNdx, beginRow, endRow);
+	}
+
+	UVec4 getMaxDiff (void) const
+	{
+		UVec4 maxDiff (0, 0, 0, 0);
+
+		for (size_t bandNdx = 0; bandNdx < m_maxDiff.size(); bandNdx++)
+			maxDiff = max(maxDiff, m_maxDiff[bandNdx]);
+
+		return maxDiff;
+	}
+
+private:
+	void processRowsGeneric (int bandNdx, int beginRow, int endRow)
+	{
+		const int	width	= m_reference.getWidth();
+		const int	height	= m_reference.getHeight();
+		IVec4*		refRow	= m_refRows.get(bandNdx);
+		IVec4*		cmpRow	= m_cmpRows.get(bandNdx);
+		IVec4*		maskRow	= m_maskRows.get(bandNdx);
+		UVec4		maxDiff	(0, 0, 0, 0);
+
+		for (int row = beginRow; row < endRow && width > 0; row++)
+		{
+			const int y = row % height;
+			const int z = row / height;
+
+			m_reference.getPixelRowInt(0, y, z, width, refRow);
+			m_result.getPixelRowInt(0, y, z, width, cmpRow);
+
+			for (int x = 0; x < width; x++)
+			{
+				const UVec4	diff	= abs(refRow[x] - cmpRow[x]).cast<deUint32>();
+				const bool	isOk	= boolAll(lessThanEqual(diff, m_threshold));
+
+				maxDiff = max(maxDiff, diff);
+
+				maskRow[x] = isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff);
+			}
+
+			m_errorMask.setPixelRow(maskRow, 0, y, z, width);
+		}
+
+		m_maxDiff[bandNdx] = maxDiff;
+	}
 
-	for (int z = beginZ; z < endZ; z++)
+#if defined(TCU_IMAGE_COMPARE_SSE2)
+	void processRowsSSE2 (int bandNdx, int beginRow, int endRow)
 	{
-		for (int y = beginY; y < endY; y++)
+		const int		width		= m_reference.getWidth();
+		const int		height		= m_reference.getHeight();
+		const UVec4		thresholdU8	= min(m_threshold, UVec4(0xff));
+		const deUint8	thrBytes[4]	= { (deUint8)thresholdU8[0], (deUint8)thresholdU8[1], (deUint8)thresholdU8[2], (deUint8)thresholdU8[3] };
+		deInt32			thrPacked;
+		const __m128i	zero		= _mm_setzero_si128();
+		__m128i			maxDiff		= zero;
+		deUint8			maxBytes[16];
+		UVec4			tailMax		(0, 0, 0, 0);
+
+		DE_ASSERT(m_errorMask.getPixelPitch() == MASK_PIXEL_SIZE);
+		deMemcpy(&thrPacked, &thrBytes[0], sizeof(thrPacked));
+
+		{
+			const __m128i threshold = _mm_set1_epi32(thrPacked);
+
+			for (int row = beginRow; row < endRow; row++)
+			{
+				const int		y		= row % height;
+				const int		z		= row / height;
+				const deUint8*	refRow	= (const deUint8*)m_reference.getPixelPtr(0, y, z);
+				const deUint8*	cmpRow	= (const deUint8*)m_result.getPixelPtr(0, y, z);
+				deUint8*		maskRow	= (deUint8*)m_errorMask.getPixelPtr(0, y, z);
+				int				x		= 0;
+
+				for (; x+4 <= width; x += 4)
+				{
+					const __m128i	ref		= _mm_loadu_si128((const __m128i*)(refRow + x*4));
+					const __m128i	cmp		= _mm_loadu_si128((const __m128i*)(cmpRow + x*4));
+					const __m128i	diff	= _mm_or_si128(_mm_subs_epu8(ref, cmp), _mm_subs_epu8(cmp, ref));
+					const __m128i	excess	= _mm_subs_epu8(diff, threshold);
+					const int		okBits	= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(excess, zero)));
+
+					maxDiff = _mm_max_epu8(maxDiff, diff);
+
+					for (int i = 0; i < 4; i++)
+						writeMaskPixel(maskRow + (x+i)*MASK_PIXEL_SIZE, (okBits & (1 << i)) != 0);
+				}
+
+				for (; x < width; x++)
+				{
+					bool isOk = true;
+
+					for (int c = 0; c < 4; c++)
+					{
+						const deUint32 diff = (deUint32)de::abs((int)refRow[x*4+c] - (int)cmpRow[x*4+c]);
+
+						tailMax[c]	= de::max(tailMax[c], diff);
+						isOk		= isOk && diff <= m_threshold[c];
+					}
+
+					writeMaskPixel(maskRow + x*MASK_PIXEL_SIZE, isOk);
+				}
+			}
+		}
+
+		_mm_storeu_si128((__m128i*)&maxBytes[0], maxDiff);
+
+		for (int i = 0; i < 4; i++)
+		for (int c = 0; c < 4; c++)
+			tailMax[c] = de::max(tailMax[c], (deUint32)maxBytes[i*4+c]);
+
+		m_maxDiff[bandNdx] = tailMax;
+	}
+#endif
+
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+	const UVec4						m_threshold;
+	const PixelBufferAccess&		m_errorMask;
+	BandRowBuffer<IVec4>			m_refRows;
+	BandRowBuffer<IVec4>			m_cmpRows;
+	BandRowBuffer<IVec4>			m_maskRows;
+	vector<UVec4>					m_maxDiff;
+};
+
+class PositionDeviationCompareJob : public RowBandJob
+{
+public:
+	PositionDeviationCompareJob (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const IVec3& maxPositionDeviation, const IVec3& begin, const IVec3& size, int numBands)
+		: m_errorMask				(errorMask)
+		, m_reference				(reference)
+		, m_result					(result)
+		, m_threshold				(threshold)
+		, m_maxPositionDeviation	(maxPositionDeviation)
+		, m_begin					(begin)
+		, m_size					(size)
+		, m_refRows					(size.x(), numBands)
+		, m_cmpRows					(size.x(), numBands)
+		, m_numFailingPixels		(numBands, 0)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const tcu::IVec4	errorColor			(255, 0, 0, 255);
+		const int			width				= m_reference.getWidth();
+		const int			height				= m_reference.getHeight();
+		const int			depth				= m_reference.getDepth();
+		IVec4*				refRow				= m_refRows.get(bandNdx);
+		IVec4*				cmpRow				= m_cmpRows.get(bandNdx);
+		int					numFailingPixels	= 0;
+
+		for (int row = beginRow; row < endRow && m_size.x() > 0; row++)
 		{
-			for (int x = beginX; x < endX; x++)
+			const int y = m_begin.y() + row % m_size.y();
+			const int z = m_begin.z() + row / m_size.y();
+
+			m_reference.getPixelRowInt(m_begin.x(), y, z, m_size.x(), refRow);
+			m_result.getPixelRowInt(m_begin.x(), y, z, m_size.x(), cmpRow);
+
+			for (int x = m_begin.x(); x < m_begin.x() + m_size.x(); x++)
 			{
-				const IVec4	refPix = reference.getPixelInt(x, y, z);
-				const IVec4	cmpPix = result.getPixelInt(x, y, z);
+				const IVec4	refPix = refRow[x - m_begin.x()];
+				const IVec4	cmpPix = cmpRow[x - m_begin.x()];
 
 				// Exact match
 				{
 					const UVec4	diff = abs(refPix - cmpPix).cast<deUint32>();
-					const bool	isOk = boolAll(lessThanEqual(diff, threshold));
+					const bool	isOk = boolAll(lessThanEqual(diff, m_threshold));
 
 					if (isOk)
 						continue;
@@ -134,20 +656,20 @@ static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& error
 
 					// Find deviated result pixel for reference
 
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForReference; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForReference; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForReference; ++sx)
+					for (int sz = de::max(0, z - m_maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + m_maxPositionDeviation.z()) && !pixelFoundForReference; ++sz)
+					for (int sy = de::max(0, y - m_maxPositionDeviation.y()); sy <= de::min(height - 1, y + m_maxPositionDeviation.y()) && !pixelFoundForReference; ++sy)
+					for (int sx = de::max(0, x - m_maxPositionDeviation.x()); sx <= de::min(width  - 1, x + m_maxPositionDeviation.x()) && !pixelFoundForReference; ++sx)
 					{
-						const IVec4	deviatedCmpPix	= result.getPixelInt(sx, sy, sz);
+						const IVec4	deviatedCmpPix	= m_result.getPixelInt(sx, sy, sz);
 						const UVec4	diff			= abs(refPix - deviatedCmpPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
+						const bool	isOk			= boolAll(lessThanEqual(diff, m_threshold));
 
 						pixelFoundForReference		= isOk;
 					}
 
 					if (!pixelFoundForReference)
 					{
-						errorMask.setPixel(errorColor, x, y, z);
+						m_errorMask.setPixel(errorColor, x, y, z);
 						++numFailingPixels;
 						continue;
 					}
@@ -157,33 +679,171 @@ static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& error
 
 					// Find deviated reference pixel for result
 
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForResult; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForResult; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForResult; ++sx)
+					for (int sz = de::max(0, z - m_maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + m_maxPositionDeviation.z()) && !pixelFoundForResult; ++sz)
+					for (int sy = de::max(0, y - m_maxPositionDeviation.y()); sy <= de::min(height - 1, y + m_maxPositionDeviation.y()) && !pixelFoundForResult; ++sy)
+					for (int sx = de::max(0, x - m_maxPositionDeviation.x()); sx <= de::min(width  - 1, x + m_maxPositionDeviation.x()) && !pixelFoundForResult; ++sx)
 					{
-						const IVec4	deviatedRefPix	= reference.getPixelInt(sx, sy, sz);
+						const IVec4	deviatedRefPix	= m_reference.getPixelInt(sx, sy, sz);
 						const UVec4	diff			= abs(cmpPix - deviatedRefPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
+						const bool	isOk			= boolAll(lessThanEqual(diff, m_threshold));
 
 						pixelFoundForResult			= isOk;
 					}
 
 					if (!pixelFoundForResult)
 					{
-						errorMask.setPixel(errorColor, x, y, z);
+						m_errorMask.setPixel(errorColor, x, y, z);
 						++numFailingPixels;
 						continue;
 					}
 				}
 			}
 		}
+
+		m_numFailingPixels[bandNdx] = numFailingPixels;
+	}
+
+	int getNumFailingPixels (void) const
+	{
+		int numFailingPixels = 0;
+
+		for (size_t bandNdx = 0; bandNdx < m_numFailingPixels.size(); bandNdx++)
+			numFailingPixels += m_numFailingPixels[bandNdx];
+
+		return numFailingPixels;
+	}
+
+private:
+	const PixelBufferAccess&		m_errorMask;
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+	const UVec4						m_threshold;
+	const IVec3						m_maxPositionDeviation;
+	const IVec3						m_begin;
+	const IVec3						m_size;
+	BandRowBuffer<IVec4>			m_refRows;
+	BandRowBuffer<IVec4>			m_cmpRows;
+	vector<int>						m_numFailingPixels;
+};
+
+static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+{
+	const tcu::IVec4	okColor				(0, 255, 0, 255);
+	const int			width				= reference.getWidth();
+	const int			height				= reference.getHeight();
+	const int			depth				= reference.getDepth();
+
+	// Accept pixels "sampling" over the image bounds pixels since "taps" could be anything
+	const int			beginX				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.x()) : (0);
+	const int			beginY				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.y()) : (0);
+	const int			beginZ				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.z()) : (0);
+	const int			endX				= (acceptOutOfBoundsAsAnyValue) ? (width  - maxPositionDeviation.x()) : (0);
+	const int			endY				= (acceptOutOfBoundsAsAnyValue) ? (height - maxPositionDeviation.y()) : (0);
+	const int			endZ				= (acceptOutOfBoundsAsAnyValue) ? (depth  - maxPositionDeviation.z()) : (0);
+	const IVec3			begin				(beginX, beginY, beginZ);
+	const IVec3			size				(de::max(endX - beginX, 0), de::max(endY - beginY, 0), de::max(endZ - beginZ, 0));
+	const int			numRows				= size.y()*size.z();
+	const int			numBands			= getNumRowBands(numRows, size.x());
+
+	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
+
+	tcu::clear(errorMask, okColor);
+
+	{
+		PositionDeviationCompareJob job (errorMask, reference, result, threshold, maxPositionDeviation, begin, size, numBands);
+
+		executeRowBands(job, numRows, numBands);
+
+		return job.getNumFailingPixels();
+	}
+}
+
+class SquaredDiffSumJob : public RowBandJob
+{
+public:
+	SquaredDiffSumJob (const ConstPixelBufferAccess& ref, const ConstPixelBufferAccess& cmp, const PixelBufferAccess& diffMask, int diffFactor, int numBands)
+		: m_ref			(ref)
+		, m_cmp			(cmp)
+		, m_diffMask	(diffMask)
+		, m_diffFactor	(diffFactor)
+		, m_refRows		(cmp.getWidth(), numBands)
+		, m_cmpRows		(cmp.getWidth(), numBands)
+		, m_maskRows	(cmp.getWidth(), numBands)
+		, m_diffSum		(numBands, 0)
+	{
+	}
+
+	void processRows (int bandNdx, int beginRow, int endRow)
+	{
+		const int	width	= m_cmp.getWidth();
+		IVec4*		refRow	= m_refRows.get(bandNdx);
+		IVec4*		cmpRow	= m_cmpRows.get(bandNdx);
+		IVec4*		maskRow	= m_maskRows.get(bandNdx);
+		deInt64		diffSum	= 0;
+
+		for (int y = beginRow; y < endRow && width > 0; y++)
+		{
+			m_ref.getPixelRowInt(0, y, 0, width, refRow);
+			m_cmp.getPixelRowInt(0, y, 0, width, cmpRow);
+
+			for (int x = 0; x < width; x++)
+			{
+				IVec4	diff	= abs(refRow[x] - cmpRow[x]);
+				int		sum		= diff.x() + diff.y() + diff.z() + diff.w();
+				int		sqSum	= diff.x()*diff.x() + diff.y()*diff.y() + diff.z()*diff.z() + diff.w()*diff.w();
+
+				maskRow[x] = IVec4(deClamp32(sum*m_diffFactor, 0, 255), deClamp32(255-sum*m_diffFactor, 0, 255), 0, 255);
+
+				diffSum += (deInt64)sqSum;
+			}
+
+			m_diffMask.setPixelRow(maskRow, 0, y, 0, width);
+		}
+
+		m_diffSum[bandNdx] = diffSum;
 	}
 
-	return numFailingPixels;
+	deInt64 getDiffSum (void) const
+	{
+		deInt64 diffSum = 0;
+
+		for (size_t bandNdx = 0; bandNdx < m_diffSum.size(); bandNdx++)
+			diffSum += m_diffSum[bandNdx];
+
+		return diffSum;
+	}
+
+private:
+	const ConstPixelBufferAccess&	m_ref;
+	const ConstPixelBufferAccess&	m_cmp;
+	const PixelBufferAccess&		m_diffMask;
+	const int						m_diffFactor;
+	BandRowBuffer<IVec4>			m_refRows;
+	BandRowBuffer<IVec4>			m_cmpRows;
+	BandRowBuffer<IVec4>			m_maskRows;
+	vector<deInt64>					m_diffSum;
+};
+
+static volatile deUint32 s_logCompareTime = 0;
+
+static void logCompareTime (TestLog& log, deUint64 compareTimeUs)
+{
+	if (s_logCompareTime)
+		log << TestLog::Integer("CompareTime", "Image comparison time", "us", QP_KEY_TAG_TIME, (deInt64)compareTimeUs);
 }
 
 } // anonymous
 
+void setImageCompareTimeLogging (bool enabled)
+{
+	s_logCompareTime = enabled ? 1u : 0u;
+}
+
+bool isImageCompareTimeLoggingEnabled (void)
+{
+	return s_logCompareTime != 0;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Fuzzy image comparison
  *
@@ -217,7 +877,9 @@ bool fuzzyCompare (TestLog& log, const char* imageSetName, const char* imageSetD
 {
 	FuzzyCompareParams	params;		// Use defaults.
 	TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
+	const deUint64		startTime		= deGetMicroseconds();
 	float				difference		= fuzzyCompare(params, reference, result, errorMask.getAccess());
+	const deUint64		compareTime		= deGetMicroseconds() - startTime;
 	bool				isOk			= difference <= threshold;
 	Vec4				pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
@@ -250,6 +912,9 @@ bool fuzzyCompare (TestLog& log, const char* imageSetName, const char* imageSetD
 			<< TestLog::EndImageSet;
 	}
 
+	if (!isOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return isOk;
 }
 
@@ -293,25 +958,13 @@ static deInt64 computeSquaredDiffSum (const ConstPixelBufferAccess& ref, const C
 	DE_ASSERT(ref.getWidth() == cmp.getWidth() && ref.getWidth() == diffMask.getWidth());
 	DE_ASSERT(ref.getHeight() == cmp.getHeight() && ref.getHeight() == diffMask.getHeight());
 
-	deInt64 diffSum = 0;
+	const int			numRows		= cmp.getHeight();
+	const int			numBands	= getNumRowBands(numRows, cmp.getWidth());
+	SquaredDiffSumJob	job			(ref, cmp, diffMask, diffFactor, numBands);
 
-	for (int y = 0; y < cmp.getHeight(); y++)
-	{
-		for (int x = 0; x < cmp.getWidth(); x++)
-		{
-			IVec4	a		= ref.getPixelInt(x, y);
-			IVec4	b		= cmp.getPixelInt(x, y);
-			IVec4	diff	= abs(a - b);
-			int		sum		= diff.x() + diff.y() + diff.z() + diff.w();
-			int		sqSum	= diff.x()*diff.x() + diff.y()*diff.y() + diff.z()*diff.z() + diff.w()*diff.w();
-
-			diffMask.setPixel(tcu::RGBA(deClamp32(sum*diffFactor, 0, 255), deClamp32(255-sum*diffFactor, 0, 255), 0, 255).toVec(), x, y);
+	executeRowBands(job, numRows, numBands);
 
-			diffSum += (deInt64)sqSum;
-		}
-	}
-
-	return diffSum;
+	return job.getDiffSum();
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -335,7 +988,9 @@ int measurePixelDiffAccuracy (TestLog& log, const char* imageSetName, const char
 {
 	TextureLevel	diffMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
 	int				diffFactor		= 8;
+	const deUint64	startTime		= deGetMicroseconds();
 	deInt64			squaredSum		= computeSquaredDiffSum(reference, result, diffMask.getAccess(), diffFactor);
+	const deUint64	compareTime		= deGetMicroseconds() - startTime;
 	float			sum				= deFloatSqrt((float)squaredSum);
 	int				score			= deClamp32(deFloorFloatToInt32(100.0f - (de::max(sum-(float)bestScoreDiff, 0.0f) / (float)(worstScoreDiff-bestScoreDiff))*100.0f), 0, 100);
 	const int		failThreshold	= 10;
@@ -364,8 +1019,11 @@ int measurePixelDiffAccuracy (TestLog& log, const char* imageSetName, const char
 	}
 
 	if (logMode != COMPARE_LOG_ON_ERROR || score <= failThreshold)
+	{
 		log << TestLog::Integer("DiffSum", "Squared difference sum", "", QP_KEY_TAG_NONE, squaredSum)
 			<< TestLog::Integer("Score", "Score", "", QP_KEY_TAG_QUALITY, score);
+		logCompareTime(log, compareTime);
+	}
 
 	return score;
 }
@@ -392,74 +1050,6 @@ int measurePixelDiffAccuracy (TestLog& log, const char* imageSetName, const char
 	return measurePixelDiffAccuracy(log, imageSetName, imageSetDesc, reference.getAccess(), result.getAccess(), bestScoreDiff, worstScoreDiff, logMode);
 }
 
-/*--------------------------------------------------------------------*//*!
- * Returns the index of float in a float space without denormals
- * so that:
- * 1) f(0.0) = 0
- * 2) f(-0.0) = 0
- * 3) f(b) = f(a) + 1  <==>  b = nextAfter(a)
- *
- * See computeFloatFlushRelaxedULPDiff for details
- *//*--------------------------------------------------------------------*/
-static deInt32 getPositionOfIEEEFloatWithoutDenormals (float x)
-{
-	DE_ASSERT(!deIsNaN(x)); // not sane
-
-	if (x == 0.0f)
-		return 0;
-	else if (x < 0.0f)
-		return -getPositionOfIEEEFloatWithoutDenormals(-x);
-	else
-	{
-		DE_ASSERT(x > 0.0f);
-
-		const tcu::Float32 f(x);
-
-		if (f.isDenorm())
-		{
-			// Denorms are flushed to zero
-			return 0;
-		}
-		else
-		{
-			// sign is 0, and it's a normal number. Natural position is its bit
-			// pattern but since we've collapsed the denorms, we must remove
-			// the gap here too to keep the float enumeration continuous.
-			//
-			// Denormals occupy one exponent pattern. Removing one from
-			// exponent should to the trick.
-			return (deInt32)(f.bits() - (1u << 23u));
-		}
-	}
-}
-
-static deUint32 computeFloatFlushRelaxedULPDiff (float a, float b)
-{
-	if (deIsNaN(a) && deIsNaN(b))
-		return 0;
-	else if (deIsNaN(a) || deIsNaN(b))
-	{
-		return 0xFFFFFFFFu;
-	}
-	else
-	{
-		// Using the "definition 5" in Muller, Jean-Michel. "On the definition of ulp (x)" (2005)
-		// assuming a floating point space is IEEE single precision floating point space without
-		// denormals (and signed zeros).
-		const deInt32 aIndex = getPositionOfIEEEFloatWithoutDenormals(a);
-		const deInt32 bIndex = getPositionOfIEEEFloatWithoutDenormals(b);
-		return (deUint32)de::abs(aIndex - bIndex);
-	}
-}
-
-static tcu::UVec4 computeFlushRelaxedULPDiff (const tcu::Vec4& a, const tcu::Vec4& b)
-{
-	return tcu::UVec4(computeFloatFlushRelaxedULPDiff(a.x(), b.x()),
-					  computeFloatFlushRelaxedULPDiff(a.y(), b.y()),
-					  computeFloatFlushRelaxedULPDiff(a.z(), b.z()),
-					  computeFloatFlushRelaxedULPDiff(a.w(), b.w()));
-}
-
 /*--------------------------------------------------------------------*//*!
  * \brief Per-pixel threshold-based comparison
  *
@@ -490,31 +1080,24 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
 	int					depth				= reference.getDepth();
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	UVec4				maxDiff				(0, 0, 0, 0);
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
 	TCU_CHECK(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	refPix	= reference.getPixel(x, y, z);
-				const Vec4	cmpPix	= result.getPixel(x, y, z);
-				const UVec4	diff	= computeFlushRelaxedULPDiff(refPix, cmpPix);
-				const bool	isOk	= boolAll(lessThanEqual(diff, threshold));
+		const int					numRows		= height*depth;
+		const int					numBands	= getNumRowBands(numRows, width);
+		FloatUlpThresholdCompareJob	job			(reference, result, threshold, errorMask, numBands);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeRowBands(job, numRows, numBands);
+		maxDiff = job.getMaxDiff();
 	}
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const deUint64	compareTime	= deGetMicroseconds() - compareStartTime;
+	bool			compareOk	= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
@@ -545,6 +1128,9 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -576,32 +1162,24 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 	int					depth				= reference.getDepth();
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	Vec4				maxDiff				(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Vec4	refPix		= reference.getPixel(x, y, z);
-				Vec4	cmpPix		= result.getPixel(x, y, z);
-
-				Vec4	diff		= abs(refPix - cmpPix);
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
+		const int					numRows		= height*depth;
+		const int					numBands	= getNumRowBands(numRows, width);
+		FloatThresholdCompareJob	job			(&reference, Vec4(0.0f), result, threshold, errorMask, numBands);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeRowBands(job, numRows, numBands);
+		maxDiff = job.getMaxDiff();
 	}
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const deUint64	compareTime	= deGetMicroseconds() - compareStartTime;
+	bool			compareOk	= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
@@ -632,6 +1210,9 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -664,28 +1245,22 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	Vec4				maxDiff				(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	cmpPix		= result.getPixel(x, y, z);
-				const Vec4	diff		= abs(reference - cmpPix);
-				const bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
+		const int					numRows		= height*depth;
+		const int					numBands	= getNumRowBands(numRows, width);
+		FloatThresholdCompareJob	job			(DE_NULL, reference, result, threshold, errorMask, numBands);
 
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeRowBands(job, numRows, numBands);
+		maxDiff = job.getMaxDiff();
 	}
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const deUint64	compareTime	= deGetMicroseconds() - compareStartTime;
+	bool			compareOk	= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
@@ -714,6 +1289,9 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -745,32 +1323,24 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
 	int					depth				= reference.getDepth();
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	UVec4				maxDiff				(0, 0, 0, 0);
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				IVec4	refPix		= reference.getPixelInt(x, y, z);
-				IVec4	cmpPix		= result.getPixelInt(x, y, z);
-
-				UVec4	diff		= abs(refPix - cmpPix).cast<deUint32>();
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
+		const int				numRows		= height*depth;
+		const int				numBands	= getNumRowBands(numRows, width);
+		IntThresholdCompareJob	job			(reference, result, threshold, errorMask, numBands);
 
-				errorMask.setPixel(isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff), x, y, z);
-			}
-		}
+		executeRowBands(job, numRows, numBands);
+		maxDiff = job.getMaxDiff();
 	}
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const deUint64	compareTime	= deGetMicroseconds() - compareStartTime;
+	bool			compareOk	= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
@@ -801,6 +1371,9 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -840,7 +1413,9 @@ bool intThresholdPositionDeviationCompare (TestLog& log, const char* imageSetNam
 	const int			depth				= reference.getDepth();
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	const int			numFailingPixels	= findNumPositionDeviationFailingPixels(errorMask, reference, result, threshold, maxPositionDeviation, acceptOutOfBoundsAsAnyValue);
+	const deUint64		compareTime			= deGetMicroseconds() - compareStartTime;
 	const bool			compareOk			= numFailingPixels == 0;
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
@@ -878,6 +1453,9 @@ bool intThresholdPositionDeviationCompare (TestLog& log, const char* imageSetNam
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -919,7 +1497,9 @@ bool intThresholdPositionDeviationErrorThresholdCompare (TestLog& log, const cha
 	const int			depth				= reference.getDepth();
 	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
 	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
+	const deUint64		compareStartTime	= deGetMicroseconds();
 	const int			numFailingPixels	= findNumPositionDeviationFailingPixels(errorMask, reference, result, threshold, maxPositionDeviation, acceptOutOfBoundsAsAnyValue);
+	const deUint64		compareTime			= deGetMicroseconds() - compareStartTime;
 	const bool			compareOk			= numFailingPixels <= maxAllowedFailingPixels;
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
@@ -958,6 +1538,9 @@ bool intThresholdPositionDeviationErrorThresholdCompare (TestLog& log, const cha
 			<< TestLog::EndImageSet;
 	}
 
+	if (!compareOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return compareOk;
 }
 
@@ -1005,7 +1588,9 @@ bool pixelThresholdCompare (TestLog& log, const char* imageSetName, const char*
 bool bilinearCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const RGBA threshold, CompareLogMode logMode)
 {
 	TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
+	const deUint64		startTime		= deGetMicroseconds();
 	bool				isOk			= bilinearCompare(reference, result, errorMask, threshold);
+	const deUint64		compareTime		= deGetMicroseconds() - startTime;
 	Vec4				pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -1033,6 +1618,9 @@ bool bilinearCompare (TestLog& log, const char* imageSetName, const char* imageS
 			<< TestLog::EndImageSet;
 	}
 
+	if (!isOk || logMode != COMPARE_LOG_ON_ERROR)
+		logCompareTime(log, compareTime);
+
 	return isOk;
 }
 
@@ -43,6 +43,10 @@ enum CompareLogMode
 	COMPARE_LOG_LAST
 };
 
+// Log time taken by image comparisons along with the images (--deqp-log-compare-time). Disabled by default.
+void	setImageCompareTimeLogging			(bool enabled);
+bool	isImageCompareTimeLoggingEnabled	(void);
+
 // Utilities for comparing and logging.
 bool	pixelThresholdCompare								(TestLog& log, const char* imageSetName, const char* imageSetDesc, const Surface& reference, const Surface& result, const RGBA& threshold, CompareLogMode logMode);
 bool	fuzzyCompare										(TestLog& log, const char* imageSetName, const char* imageSetDesc, const Surface& reference, const Surface& result, float threshold, CompareLogMode logMode);
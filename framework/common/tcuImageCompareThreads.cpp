@@ -0,0 +1,210 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Row-band parallel execution for image comparisons.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuImageCompareThreads.hpp"
+#include "deThreadPool.hpp"
+#include "deSharedPtr.hpp"
+#include "deMutex.hpp"
+#include "deThread.h"
+
+namespace tcu
+{
+namespace
+{
+
+enum
+{
+	MIN_PIXELS_PER_BAND		= 16*1024,	//!< Images smaller than two bands are compared on the calling thread.
+	NUM_BANDS_PER_THREAD	= 4			//!< Bands are handed out dynamically, extra bands balance uneven rows.
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Process-wide worker pool for image comparisons
+ *
+ * The pool is created on first use and recreated when the thread count
+ * changes. Comparisons from different threads run concurrently on the
+ * shared workers. A pool replaced while comparisons are running is
+ * destroyed once they finish.
+ *//*--------------------------------------------------------------------*/
+class CompareThreadPool
+{
+public:
+								CompareThreadPool	(void);
+
+	void						setNumThreads		(int numThreads);
+	int							getNumThreads		(void);
+	int							getNumWorkers		(void);
+
+	void						run					(de::ThreadPool::Job& job, int numItems);
+
+private:
+	static int					resolveNumWorkers	(int numThreads);
+
+	de::Mutex						m_lock;			//!< Protects m_numThreads and m_pool, not held while running jobs
+	int								m_numThreads;
+	de::SharedPtr<de::ThreadPool>	m_pool;
+};
+
+CompareThreadPool::CompareThreadPool (void)
+	: m_numThreads	(1)
+{
+}
+
+int CompareThreadPool::resolveNumWorkers (int numThreads)
+{
+	return (numThreads == 0) ? ((int)deGetNumAvailableLogicalCores()) : (numThreads);
+}
+
+void CompareThreadPool::setNumThreads (int numThreads)
+{
+	const de::ScopedLock lock (m_lock);
+
+	DE_ASSERT(numThreads >= 0);
+
+	if (numThreads != m_numThreads)
+	{
+		m_pool			= de::SharedPtr<de::ThreadPool>();
+		m_numThreads	= numThreads;
+	}
+}
+
+int CompareThreadPool::getNumThreads (void)
+{
+	const de::ScopedLock lock (m_lock);
+	return m_numThreads;
+}
+
+int CompareThreadPool::getNumWorkers (void)
+{
+	const de::ScopedLock lock (m_lock);
+	return resolveNumWorkers(m_numThreads);
+}
+
+void CompareThreadPool::run (de::ThreadPool::Job& job, int numItems)
+{
+	de::SharedPtr<de::ThreadPool> pool;
+
+	{
+		const de::ScopedLock lock (m_lock);
+
+		if (!m_pool)
+			m_pool = de::SharedPtr<de::ThreadPool>(new de::ThreadPool(resolveNumWorkers(m_numThreads)));
+
+		pool = m_pool;
+	}
+
+	pool->run(job, numItems);
+}
+
+static CompareThreadPool s_compareThreadPool;
+
+class RowBandPoolJob : public de::ThreadPool::Job
+{
+public:
+	RowBandPoolJob (RowBandJob& job, int numRows, int numBands)
+		: m_job			(job)
+		, m_numRows		(numRows)
+		, m_numBands	(numBands)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		DE_UNREF(workerNdx);
+		m_job.processRows(itemNdx, getBandBegin(itemNdx), getBandBegin(itemNdx+1));
+	}
+
+private:
+	int getBandBegin (int bandNdx) const
+	{
+		return (int)(((deInt64)m_numRows * bandNdx) / m_numBands);
+	}
+
+	RowBandJob&		m_job;
+	const int		m_numRows;
+	const int		m_numBands;
+};
+
+} // anonymous
+
+void setImageCompareNumThreads (int numThreads)
+{
+	s_compareThreadPool.setNumThreads(numThreads);
+}
+
+int getImageCompareNumThreads (void)
+{
+	return s_compareThreadPool.getNumThreads();
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get number of row bands to split a comparison into
+ *
+ * Returns 1 if comparisons are single-threaded or the image is too small
+ * to benefit from threading.
+ *//*--------------------------------------------------------------------*/
+int getNumRowBands (int numRows, int numPixelsPerRow)
+{
+	return getNumRowBands(numRows, numPixelsPerRow, MIN_PIXELS_PER_BAND);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get number of row bands with custom minimum band size
+ *
+ * Jobs with expensive per-pixel work, such as texture lookup
+ * verification, can use smaller bands than plain image comparisons.
+ *//*--------------------------------------------------------------------*/
+int getNumRowBands (int numRows, int numPixelsPerRow, int minPixelsPerBand)
+{
+	const int		numWorkers	= s_compareThreadPool.getNumWorkers();
+	const deInt64	numPixels	= (deInt64)numRows * (deInt64)de::max(numPixelsPerRow, 0);
+
+	DE_ASSERT(minPixelsPerBand > 0);
+
+	if (numWorkers <= 1 || numPixels < 2*(deInt64)minPixelsPerBand)
+		return 1;
+
+	return (int)de::min(de::min((deInt64)numRows, numPixels / minPixelsPerBand), (deInt64)(numWorkers*NUM_BANDS_PER_THREAD));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Process rows [0, numRows) split into numBands bands
+ *
+ * Bands are contiguous and cover the rows in order. Band boundaries
+ * depend only on numRows and numBands. Returns once every band has been
+ * processed.
+ *//*--------------------------------------------------------------------*/
+void executeRowBands (RowBandJob& job, int numRows, int numBands)
+{
+	DE_ASSERT(numBands >= 1 && (numBands <= numRows || numBands == 1));
+
+	if (numBands <= 1)
+		job.processRows(0, 0, numRows);
+	else
+	{
+		RowBandPoolJob poolJob (job, numRows, numBands);
+		s_compareThreadPool.run(poolJob, numBands);
+	}
+}
+
+} // tcu
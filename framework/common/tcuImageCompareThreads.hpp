@@ -0,0 +1,60 @@
+#ifndef _TCUIMAGECOMPARETHREADS_HPP
+#define _TCUIMAGECOMPARETHREADS_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Row-band parallel execution for image comparisons.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+
+namespace tcu
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Job processing bands of consecutive image rows
+ *
+ * Image comparisons split their work into bands of consecutive rows that
+ * may be processed concurrently and in any order. A job may only write
+ * to the rows of the band it is processing and must keep per-band partial
+ * results, which the caller merges in band order once all bands are done.
+ * Merging in band order keeps results independent of the number of
+ * threads and bands.
+ *
+ * \note processRows() must not throw.
+ *//*--------------------------------------------------------------------*/
+class RowBandJob
+{
+public:
+	virtual			~RowBandJob		(void) {}
+	virtual void	processRows		(int bandNdx, int beginRow, int endRow) = 0;
+};
+
+// Number of image comparison threads, 0 means number of logical cores.
+void	setImageCompareNumThreads	(int numThreads);
+int		getImageCompareNumThreads	(void);
+
+int		getNumRowBands				(int numRows, int numPixelsPerRow);
+int		getNumRowBands				(int numRows, int numPixelsPerRow, int minPixelsPerBand);
+void	executeRowBands				(RowBandJob& job, int numRows, int numBands);
+
+} // tcu
+
+#endif // _TCUIMAGECOMPARETHREADS_HPP
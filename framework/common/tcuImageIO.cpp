@@ -70,22 +70,13 @@ static void pngReadResource (png_structp png_ptr, png_bytep data, png_size_t len
 }
 DE_END_EXTERN_C
 
-/*--------------------------------------------------------------------*//*!
- * \brief Load PNG image from resource
- *
- * TextureLevel storage is set to match image data.
- *
- * \param dst		Destination pixel container
- * \param archive	Resource archive
- * \param fileName	Resource file name
- *//*--------------------------------------------------------------------*/
-void loadPNG (TextureLevel& dst, const tcu::Archive& archive, const char* fileName)
+static void loadPNG (TextureLevel& dst, tcu::Resource& resource)
 {
-	de::UniquePtr<Resource> resource(archive.getResource(fileName));
+	const char* const fileName = resource.getName().c_str();
 
 	// Verify header.
 	deUint8 header[8];
-	resource->read(header, sizeof(header));
+	resource.read(header, sizeof(header));
 	TCU_CHECK(png_sig_cmp((png_bytep)&header[0], 0, DE_LENGTH_OF_ARRAY(header)) == 0);
 
 	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, DE_NULL, DE_NULL, DE_NULL);
@@ -97,7 +88,7 @@ void loadPNG (TextureLevel& dst, const tcu::Archive& archive, const char* fileNa
 	if (setjmp(png_jmpbuf(png_ptr)))
 		throw InternalError("An error occured when loading PNG", fileName, __FILE__, __LINE__);
 
-	png_set_read_fn(png_ptr, resource.get(), pngReadResource);
+	png_set_read_fn(png_ptr, &resource, pngReadResource);
 	png_set_sig_bytes(png_ptr, 8);
 
 	png_read_info(png_ptr, info_ptr);
@@ -132,6 +123,40 @@ void loadPNG (TextureLevel& dst, const tcu::Archive& archive, const char* fileNa
 	png_destroy_read_struct(&png_ptr, DE_NULL, DE_NULL);
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Load PNG image from resource
+ *
+ * TextureLevel storage is set to match image data. Resources that are
+ * resident in memory, such as mapped files, are decoded in place.
+ *
+ * \param dst		Destination pixel container
+ * \param archive	Resource archive
+ * \param fileName	Resource file name
+ *//*--------------------------------------------------------------------*/
+void loadPNG (TextureLevel& dst, const tcu::Archive& archive, const char* fileName)
+{
+	const de::UniquePtr<Resource>	resource	(archive.getResource(fileName));
+	std::vector<deUint8>			storage;
+	MemoryResource					contents	(resource->getName(), getResourceData(*resource, storage), resource->getSize());
+
+	loadPNG(dst, contents);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Load PNG image from memory
+ *
+ * TextureLevel storage is set to match image data.
+ *
+ * \param dst		Destination pixel container
+ * \param data		PNG file contents
+ * \param size		Size of data in bytes
+ *//*--------------------------------------------------------------------*/
+void loadPNG (TextureLevel& dst, const deUint8* data, int size)
+{
+	MemoryResource resource ("<memory>", data, size);
+	loadPNG(dst, resource);
+}
+
 static int textureFormatToPNGFormat (const TextureFormat& format)
 {
 	if (format == TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8))
@@ -210,46 +235,67 @@ enum PkmImageFormat
 	ETC1_RGBA_MIPMAPS		= 3
 };
 
-static inline deUint16 readBigEndianShort (tcu::Resource* resource)
+static inline deUint16 readBigEndianShort (tcu::Resource& resource)
 {
 	deUint16 val;
-	resource->read((deUint8*)&val, sizeof(val));
+	resource.read((deUint8*)&val, sizeof(val));
 	return ((val >> 8) & 0xFF) | ((val << 8) & 0xFF00);
 }
 
-/*--------------------------------------------------------------------*//*!
- * \brief Load compressed image data from PKM file
- *
- * \note			Only ETC1_RGB8_NO_MIPMAPS format is supported
- * \param dst		Destination pixel container
- * \param archive	Resource archive
- * \param fileName	Resource file name
- *//*--------------------------------------------------------------------*/
-void loadPKM (CompressedTexture& dst, const tcu::Archive& archive, const char* fileName)
+static void loadPKM (CompressedTexture& dst, tcu::Resource& resource)
 {
-	de::UniquePtr<Resource> resource(archive.getResource(fileName));
-
 	// Check magic and version.
 	deUint8 refMagic[] = {'P', 'K', 'M', ' ', '1', '0'};
 	deUint8 magic[6];
-	resource->read(magic, DE_LENGTH_OF_ARRAY(magic));
+	resource.read(magic, DE_LENGTH_OF_ARRAY(magic));
 
 	if (memcmp(refMagic, magic, sizeof(magic)) != 0)
-		throw InternalError("Signature doesn't match PKM signature", resource->getName().c_str(), __FILE__, __LINE__);
+		throw InternalError("Signature doesn't match PKM signature", resource.getName().c_str(), __FILE__, __LINE__);
 
-	deUint16 type = readBigEndianShort(resource.get());
+	deUint16 type = readBigEndianShort(resource);
 	if (type != ETC1_RGB_NO_MIPMAPS)
-		throw InternalError("Unsupported PKM type", resource->getName().c_str(), __FILE__, __LINE__);
+		throw InternalError("Unsupported PKM type", resource.getName().c_str(), __FILE__, __LINE__);
 
-	deUint16	width			= readBigEndianShort(resource.get());
-	deUint16	height			= readBigEndianShort(resource.get());
-	deUint16	activeWidth		= readBigEndianShort(resource.get());
-	deUint16	activeHeight	= readBigEndianShort(resource.get());
+	deUint16	width			= readBigEndianShort(resource);
+	deUint16	height			= readBigEndianShort(resource);
+	deUint16	activeWidth		= readBigEndianShort(resource);
+	deUint16	activeHeight	= readBigEndianShort(resource);
 
     DE_UNREF(width && height);
 
 	dst.setStorage(COMPRESSEDTEXFORMAT_ETC1_RGB8, (int)activeWidth, (int)activeHeight);
-	resource->read((deUint8*)dst.getData(), dst.getDataSize());
+	resource.read((deUint8*)dst.getData(), dst.getDataSize());
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Load compressed image data from PKM file
+ *
+ * \note			Only ETC1_RGB8_NO_MIPMAPS format is supported
+ * \param dst		Destination pixel container
+ * \param archive	Resource archive
+ * \param fileName	Resource file name
+ *//*--------------------------------------------------------------------*/
+void loadPKM (CompressedTexture& dst, const tcu::Archive& archive, const char* fileName)
+{
+	const de::UniquePtr<Resource>	resource	(archive.getResource(fileName));
+	std::vector<deUint8>			storage;
+	MemoryResource					contents	(resource->getName(), getResourceData(*resource, storage), resource->getSize());
+
+	loadPKM(dst, contents);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Load compressed image data from PKM file contents in memory
+ *
+ * \note			Only ETC1_RGB8_NO_MIPMAPS format is supported
+ * \param dst		Destination pixel container
+ * \param data		PKM file contents
+ * \param size		Size of data in bytes
+ *//*--------------------------------------------------------------------*/
+void loadPKM (CompressedTexture& dst, const deUint8* data, int size)
+{
+	MemoryResource resource ("<memory>", data, size);
+	loadPKM(dst, resource);
 }
 
 } // ImageIO
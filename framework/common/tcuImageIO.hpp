@@ -39,9 +39,11 @@ namespace ImageIO
 void				loadImage				(TextureLevel& dst, const tcu::Archive& archive, const char* fileName);
 
 void				loadPNG					(TextureLevel& dst, const tcu::Archive& archive, const char* fileName);
+void				loadPNG					(TextureLevel& dst, const deUint8* data, int size);
 void				savePNG					(const ConstPixelBufferAccess& src, const char* fileName);
 
 void				loadPKM					(CompressedTexture& dst, const tcu::Archive& archive, const char* fileName);
+void				loadPKM					(CompressedTexture& dst, const deUint8* data, int size);
 
 } // ImageIO
 } // tcu
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Reference renderer thread configuration.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuRefRenderThreads.hpp"
+
+namespace tcu
+{
+
+static volatile deInt32 s_refRenderNumThreads = 1;
+
+void setRefRenderNumThreads (int numThreads)
+{
+	DE_ASSERT(numThreads >= 0);
+	s_refRenderNumThreads = numThreads;
+}
+
+int getRefRenderNumThreads (void)
+{
+	return s_refRenderNumThreads;
+}
+
+} // tcu
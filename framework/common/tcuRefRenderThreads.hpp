@@ -0,0 +1,40 @@
+#ifndef _TCUREFRENDERTHREADS_HPP
+#define _TCUREFRENDERTHREADS_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Reference renderer thread configuration.
+ *
+ * The thread count is configured by tcu::App together with the image
+ * comparison threads and used by default-constructed rr::Renderers.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+
+namespace tcu
+{
+
+// Number of reference renderer threads, 0 means number of logical cores.
+void	setRefRenderNumThreads	(int numThreads);
+int		getRefRenderNumThreads	(void);
+
+} // tcu
+
+#endif // _TCUREFRENDERTHREADS_HPP
@@ -22,6 +22,8 @@
  *//*--------------------------------------------------------------------*/
 
 #include "tcuResource.hpp"
+#include "deFile.h"
+#include "deMemory.h"
 
 #include <stdio.h>
 
@@ -83,6 +85,207 @@ void FileResource::setPosition (int position)
 	fseek(m_file, (size_t)position, SEEK_SET);
 }
 
+// MemoryResource
+
+MemoryResource::MemoryResource (const std::string& name, const deUint8* data, int size)
+	: Resource		(name)
+	, m_data		(data)
+	, m_size		(size)
+	, m_position	(0)
+{
+	DE_ASSERT(size >= 0);
+}
+
+void MemoryResource::setData (const deUint8* data, int size)
+{
+	DE_ASSERT(size >= 0);
+
+	m_data		= data;
+	m_size		= size;
+	m_position	= 0;
+}
+
+void MemoryResource::read (deUint8* dst, int numBytes)
+{
+	TCU_CHECK(numBytes >= 0 && numBytes <= m_size - m_position);
+
+	if (numBytes > 0)
+		deMemcpy(dst, m_data + m_position, numBytes);
+
+	m_position += numBytes;
+}
+
+void MemoryResource::setPosition (int position)
+{
+	m_position = de::clamp(position, 0, m_size);
+}
+
+// MappedFileResource
+
+MappedFileResource::MappedFileResource (const char* filename)
+	: MemoryResource	(std::string(filename), DE_NULL, 0)
+	, m_file			(deMappedFile_create(filename))
+{
+	if (!m_file)
+		throw ResourceError("Failed to map file", filename, __FILE__, __LINE__);
+
+	if (deMappedFile_getSize(m_file) > (deInt64)0x7fffffff)
+	{
+		deMappedFile_destroy(m_file);
+		throw ResourceError("File is too large", filename, __FILE__, __LINE__);
+	}
+
+	setData((const deUint8*)deMappedFile_getData(m_file), (int)deMappedFile_getSize(m_file));
+}
+
+MappedFileResource::~MappedFileResource (void)
+{
+	deMappedFile_destroy(m_file);
+}
+
+// MappedDirArchive
+
+MappedDirArchive::MappedDirArchive (const char* path)
+	: m_path(path)
+{
+	// Append leading / if necessary
+	if (m_path.length() > 0 && m_path[m_path.length()-1] != '/')
+		m_path += "/";
+}
+
+Resource* MappedDirArchive::getResource (const char* name) const
+{
+	const std::string filename = m_path + name;
+
+	try
+	{
+		return new MappedFileResource(filename.c_str());
+	}
+	catch (const ResourceError&)
+	{
+		// Platform doesn't support mapping or file doesn't exist; FileResource reports the latter.
+		return new FileResource(filename.c_str());
+	}
+}
+
+// PackedArchive
+
+namespace
+{
+
+const char	s_packMagic[]	= { 'd', 'E', 'Q', 'P', 'p', 'a', 'c', 'k' };
+const int	s_packVersion	= 1;
+
+class IndexReader
+{
+public:
+	IndexReader (const char* filename, const deUint8* data, int size)
+		: m_filename	(filename)
+		, m_data		(data)
+		, m_size		(size)
+		, m_position	(0)
+	{
+	}
+
+	const deUint8* getBytes (int numBytes)
+	{
+		const deUint8* bytes = m_data + m_position;
+
+		if (numBytes < 0 || numBytes > m_size - m_position)
+			throw ResourceError("Truncated pack file index", m_filename, __FILE__, __LINE__);
+
+		m_position += numBytes;
+		return bytes;
+	}
+
+	int getInt (void)
+	{
+		const deUint8*	bytes	= getBytes(4);
+		const deUint32	value	= (deUint32)bytes[0] | ((deUint32)bytes[1] << 8) | ((deUint32)bytes[2] << 16) | ((deUint32)bytes[3] << 24);
+
+		if (value > 0x7fffffffu)
+			throw ResourceError("Invalid value in pack file index", m_filename, __FILE__, __LINE__);
+
+		return (int)value;
+	}
+
+private:
+	const char*			m_filename;
+	const deUint8*		m_data;
+	int					m_size;
+	int					m_position;
+};
+
+} // anonymous
+
+PackedArchive::PackedArchive (const char* filename)
+	: m_filename	(filename)
+	, m_file		(deMappedFile_create(filename))
+{
+	if (!m_file)
+		throw ResourceError("Failed to map pack file", filename, __FILE__, __LINE__);
+
+	try
+	{
+		if (deMappedFile_getSize(m_file) > (deInt64)0x7fffffff)
+			throw ResourceError("Pack file is too large", filename, __FILE__, __LINE__);
+
+		readIndex((const deUint8*)deMappedFile_getData(m_file), (int)deMappedFile_getSize(m_file));
+	}
+	catch (...)
+	{
+		deMappedFile_destroy(m_file);
+		throw;
+	}
+}
+
+PackedArchive::~PackedArchive (void)
+{
+	deMappedFile_destroy(m_file);
+}
+
+void PackedArchive::readIndex (const deUint8* data, int size)
+{
+	IndexReader reader (m_filename.c_str(), data, size);
+
+	if (deMemCmp(reader.getBytes(DE_LENGTH_OF_ARRAY(s_packMagic)), s_packMagic, DE_LENGTH_OF_ARRAY(s_packMagic)) != 0)
+		throw ResourceError("Not a pack file", m_filename.c_str(), __FILE__, __LINE__);
+
+	if (reader.getInt() != s_packVersion)
+		throw ResourceError("Unsupported pack file version", m_filename.c_str(), __FILE__, __LINE__);
+
+	{
+		const int numEntries = reader.getInt();
+
+		for (int entryNdx = 0; entryNdx < numEntries; entryNdx++)
+		{
+			const int		nameLen		= reader.getInt();
+			const char*		name		= (const char*)reader.getBytes(nameLen);
+			Entry			entry;
+
+			entry.offset	= reader.getInt();
+			entry.size		= reader.getInt();
+
+			if (entry.size > size - entry.offset)
+				throw ResourceError("Resource data out of pack file bounds", m_filename.c_str(), __FILE__, __LINE__);
+
+			m_entries[std::string(name, name + nameLen)] = entry;
+		}
+	}
+}
+
+Resource* PackedArchive::getResource (const char* name) const
+{
+	const EntryMap::const_iterator pos = m_entries.find(name);
+
+	if (pos == m_entries.end())
+		throw ResourceError("Resource not found in pack file", name, __FILE__, __LINE__);
+
+	return new MemoryResource(name, (const deUint8*)deMappedFile_getData(m_file) + pos->second.offset, pos->second.size);
+}
+
+// ResourcePrefix
+
 ResourcePrefix::ResourcePrefix (const Archive& archive, const char* prefix)
 	: m_archive	(archive)
 	, m_prefix	(prefix)
@@ -94,4 +297,25 @@ Resource* ResourcePrefix::getResource (const char* name) const
 	return m_archive.getResource((m_prefix + name).c_str());
 }
 
+const deUint8* getResourceData (Resource& resource, std::vector<deUint8>& storage)
+{
+	const deUint8* data = resource.getData();
+
+	if (!data)
+	{
+		const int size = resource.getSize();
+
+		storage.resize(size);
+
+		if (size > 0)
+		{
+			resource.setPosition(0);
+			resource.read(&storage[0], size);
+			data = &storage[0];
+		}
+	}
+
+	return data;
+}
+
 } // tcu
@@ -26,6 +26,10 @@
 #include "tcuDefs.hpp"
 
 #include <string>
+#include <vector>
+#include <map>
+
+typedef struct deMappedFile_s deMappedFile;
 
 // \todo [2010-07-31 pyry] Move Archive and File* to separate files
 
@@ -41,24 +45,32 @@ namespace tcu
  *
  * Resource objects are requested from Archive object provided by Platform.
  * The user is responsible of disposing the objects afterwards.
+ *
+ * Resources that are resident in memory (for example memory-mapped files)
+ * expose their contents directly with getData(). The returned span covers
+ * the whole resource regardless of the read position and stays valid for
+ * the lifetime of the resource object.
  *//*--------------------------------------------------------------------*/
 class Resource
 {
 public:
-	virtual				~Resource		(void) {}
+	virtual					~Resource		(void) {}
 
-	virtual void		read			(deUint8* dst, int numBytes) = 0;
-	virtual int			getSize			(void) const = 0;
-	virtual int			getPosition		(void) const = 0;
-	virtual void		setPosition		(int position) = 0;
+	virtual void			read			(deUint8* dst, int numBytes) = 0;
+	virtual int				getSize			(void) const = 0;
+	virtual int				getPosition		(void) const = 0;
+	virtual void			setPosition		(int position) = 0;
 
-	const std::string&	getName			(void) const { return m_name; }
+	//! Get pointer to resource contents, or null if contents must be accessed with read()
+	virtual const deUint8*	getData			(void) const { return DE_NULL; }
+
+	const std::string&		getName			(void) const { return m_name; }
 
 protected:
-						Resource		(const std::string& name) : m_name(name) {}
+							Resource		(const std::string& name) : m_name(name) {}
 
 private:
-	std::string			m_name;
+	std::string				m_name;
 };
 
 /*--------------------------------------------------------------------*//*!
@@ -123,6 +135,103 @@ private:
 	FILE*				m_file;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Resource backed by memory
+ *
+ * Memory is not owned by the resource and must outlive it.
+ *//*--------------------------------------------------------------------*/
+class MemoryResource : public Resource
+{
+public:
+							MemoryResource	(const std::string& name, const deUint8* data, int size);
+
+	void					read			(deUint8* dst, int numBytes);
+	int						getSize			(void) const { return m_size;		}
+	int						getPosition		(void) const { return m_position;	}
+	void					setPosition		(int position);
+
+	const deUint8*			getData			(void) const { return m_data;		}
+
+protected:
+	void					setData			(const deUint8* data, int size);
+
+private:
+	const deUint8*			m_data;
+	int						m_size;
+	int						m_position;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Read-only memory-mapped file resource
+ *//*--------------------------------------------------------------------*/
+class MappedFileResource : public MemoryResource
+{
+public:
+							MappedFileResource	(const char* filename);
+							~MappedFileResource	(void);
+
+private:
+							MappedFileResource	(const MappedFileResource& other);
+	MappedFileResource&		operator=			(const MappedFileResource& other);
+
+	deMappedFile*			m_file;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Directory-based archive serving memory-mapped files
+ *
+ * Falls back to FileResource if the file can't be mapped.
+ *//*--------------------------------------------------------------------*/
+class MappedDirArchive : public Archive
+{
+public:
+						MappedDirArchive	(const char* path);
+
+	Resource*			getResource			(const char* name) const;
+
+private:
+	std::string			m_path;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Archive stored in a single memory-mapped pack file
+ *
+ * Pack file consists of a header, an index of resource names and
+ * a data section. All integers are little-endian deUint32s.
+ *
+ *   header:	magic "dEQPpack", version, number of entries
+ *   entry:		name length, name (not terminated), data offset, data size
+ *
+ * Data offsets are relative to the beginning of the file. Resources
+ * share the mapping of the archive and must not outlive it.
+ *//*--------------------------------------------------------------------*/
+class PackedArchive : public Archive
+{
+public:
+						PackedArchive		(const char* filename);
+						~PackedArchive		(void);
+
+	Resource*			getResource			(const char* name) const;
+
+private:
+						PackedArchive		(const PackedArchive& other);
+	PackedArchive&		operator=			(const PackedArchive& other);
+
+	struct Entry
+	{
+		int		offset;
+		int		size;
+	};
+
+	typedef std::map<std::string, Entry> EntryMap;
+
+	void				readIndex			(const deUint8* data, int size);
+
+	std::string			m_filename;
+	deMappedFile*		m_file;
+	EntryMap			m_entries;
+};
+
 class ResourcePrefix : public Archive
 {
 public:
@@ -136,6 +245,9 @@ private:
 	std::string					m_prefix;
 };
 
+// Get resource contents, reading them to storage if resource is not resident in memory
+const deUint8*			getResourceData		(Resource& resource, std::vector<deUint8>& storage);
+
 } // tcu
 
 #endif // _TCURESOURCE_HPP
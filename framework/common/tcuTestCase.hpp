@@ -148,6 +148,39 @@ public:
 	virtual IterateResult	iterate			(void);
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Test case group that creates its children in init()
+ *
+ * Children are created by calling createChildren(group) when the group
+ * is entered. Test hierarchy iterator only enters groups that pass the
+ * case filter, so wrapping large sub-hierarchies into lazy groups avoids
+ * constructing them when none of their cases are selected.
+ *
+ * CreateChildren can be a function pointer or a copyable functor that
+ * takes TestCaseGroup*.
+ *//*--------------------------------------------------------------------*/
+template<typename CreateChildren>
+class LazyTestCaseGroup : public TestCaseGroup
+{
+public:
+							LazyTestCaseGroup	(TestContext& testCtx, const char* name, const char* description, const CreateChildren& createChildren)
+								: TestCaseGroup		(testCtx, name, description)
+								, m_createChildren	(createChildren)
+							{
+							}
+
+	void					init				(void) { m_createChildren(this); }
+
+private:
+	const CreateChildren	m_createChildren;
+};
+
+template<typename CreateChildren>
+inline TestCaseGroup* createLazyTestCaseGroup (TestContext& testCtx, const char* name, const char* description, const CreateChildren& createChildren)
+{
+	return new LazyTestCaseGroup<CreateChildren>(testCtx, name, description, createChildren);
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Test case class
  *
@@ -0,0 +1,302 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Serialized test hierarchy cache.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuTestHierarchyCache.hpp"
+#include "qpInfo.h"
+#include "deFilePath.hpp"
+#include "deMemory.h"
+
+#include <fstream>
+
+namespace tcu
+{
+
+using std::string;
+using std::vector;
+
+namespace
+{
+
+static const char		s_cacheMagic[]	= { 'd', 'E', 'Q', 'P', 'h', 'i', 'e', 'r' };
+static const deUint32	s_cacheVersion	= 1;
+
+enum CachedNodeType
+{
+	CACHEDNODETYPE_GROUP = 0,
+	CACHEDNODETYPE_SELF_VALIDATE,
+	CACHEDNODETYPE_CAPABILITY,
+	CACHEDNODETYPE_ACCURACY,
+	CACHEDNODETYPE_PERFORMANCE,
+
+	CACHEDNODETYPE_LAST
+};
+
+CachedNodeType getCachedNodeType (TestNodeType nodeType)
+{
+	switch (nodeType)
+	{
+		case NODETYPE_GROUP:			return CACHEDNODETYPE_GROUP;
+		case NODETYPE_SELF_VALIDATE:	return CACHEDNODETYPE_SELF_VALIDATE;
+		case NODETYPE_CAPABILITY:		return CACHEDNODETYPE_CAPABILITY;
+		case NODETYPE_ACCURACY:			return CACHEDNODETYPE_ACCURACY;
+		case NODETYPE_PERFORMANCE:		return CACHEDNODETYPE_PERFORMANCE;
+		default:
+			throw InternalError("Node type can't be cached");
+	}
+}
+
+TestNodeType getTestNodeType (CachedNodeType nodeType)
+{
+	static const TestNodeType s_nodeTypes[] =
+	{
+		NODETYPE_GROUP,
+		NODETYPE_SELF_VALIDATE,
+		NODETYPE_CAPABILITY,
+		NODETYPE_ACCURACY,
+		NODETYPE_PERFORMANCE
+	};
+	DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_nodeTypes) == CACHEDNODETYPE_LAST);
+	DE_ASSERT(de::inBounds<int>(nodeType, 0, CACHEDNODETYPE_LAST));
+
+	return s_nodeTypes[nodeType];
+}
+
+void writeUint32 (vector<deUint8>& dst, deUint32 value)
+{
+	for (int byteNdx = 0; byteNdx < 4; byteNdx++)
+		dst.push_back((deUint8)(value >> (8*byteNdx)));
+}
+
+void writeString (vector<deUint8>& dst, const string& str)
+{
+	writeUint32(dst, (deUint32)str.size());
+	dst.insert(dst.end(), str.begin(), str.end());
+}
+
+class CacheReader
+{
+public:
+	CacheReader (const deUint8* data, size_t dataSize)
+		: m_data		(data)
+		, m_dataSize	(dataSize)
+		, m_pos			(0)
+	{
+	}
+
+	bool isFinished (void) const
+	{
+		return m_pos == m_dataSize;
+	}
+
+	const deUint8* readBytes (size_t numBytes)
+	{
+		if (numBytes > m_dataSize - m_pos)
+			throw Exception("Malformed test hierarchy cache: unexpected end of data");
+
+		m_pos += numBytes;
+		return m_data + m_pos - numBytes;
+	}
+
+	deUint32 readUint32 (void)
+	{
+		const deUint8* const bytes = readBytes(4);
+		return (deUint32)bytes[0] | ((deUint32)bytes[1] << 8) | ((deUint32)bytes[2] << 16) | ((deUint32)bytes[3] << 24);
+	}
+
+	string readString (void)
+	{
+		const deUint32			length	= readUint32();
+		const deUint8* const	bytes	= readBytes(length);
+
+		return string((const char*)bytes, (const char*)bytes + length);
+	}
+
+private:
+	const deUint8*	m_data;
+	size_t			m_dataSize;
+	size_t			m_pos;
+};
+
+//! Read node records without checking tree structure
+void readCachedNodes (CacheReader& reader, vector<CachedTestNode>& dst, int numNodes)
+{
+	for (int nodeNdx = 0; nodeNdx < numNodes; nodeNdx++)
+	{
+		const deUint32	nodeType	= reader.readUint32();
+		const deUint32	numChildren	= reader.readUint32();
+
+		if (nodeType >= CACHEDNODETYPE_LAST || (nodeType != CACHEDNODETYPE_GROUP && numChildren != 0))
+			throw Exception("Malformed test hierarchy cache: invalid node");
+
+		dst.push_back(CachedTestNode());
+
+		{
+			CachedTestNode& node = dst.back();
+
+			node.nodeType		= getTestNodeType((CachedNodeType)nodeType);
+			node.numChildren	= (int)numChildren;
+			node.name			= reader.readString();
+			node.description	= reader.readString();
+		}
+	}
+}
+
+} // anonymous
+
+void collectCachedTestPackage (TestHierarchyIterator& iter, CachedTestPackage& dst)
+{
+	vector<int> openGroups; //!< Indices of groups that are being collected
+
+	DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE &&
+			  iter.getNode()->getNodeType() == NODETYPE_PACKAGE);
+
+	dst.name		= iter.getNode()->getName();
+	dst.description	= iter.getNode()->getDescription();
+	dst.nodes.clear();
+
+	iter.next();
+
+	while (iter.getNode()->getNodeType() != NODETYPE_PACKAGE)
+	{
+		const TestNode* const node = iter.getNode();
+
+		if (iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE)
+		{
+			if (!openGroups.empty())
+				dst.nodes[openGroups.back()].numChildren += 1;
+
+			dst.nodes.push_back(CachedTestNode(node->getNodeType(), node->getName(), node->getDescription()));
+
+			if (node->getNodeType() == NODETYPE_GROUP)
+				openGroups.push_back((int)dst.nodes.size()-1);
+		}
+		else if (node->getNodeType() == NODETYPE_GROUP)
+			openGroups.pop_back();
+
+		iter.next();
+	}
+
+	DE_ASSERT(openGroups.empty());
+	DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_LEAVE_NODE);
+}
+
+void serializeTestHierarchyCache (const CachedTestPackage& package, vector<deUint8>& dst)
+{
+	dst.clear();
+	dst.insert(dst.end(), DE_ARRAY_BEGIN(s_cacheMagic), DE_ARRAY_END(s_cacheMagic));
+
+	writeUint32(dst, s_cacheVersion);
+	writeUint32(dst, qpGetReleaseId());
+	writeString(dst, qpGetReleaseName());
+	writeString(dst, qpGetTargetName());
+	writeString(dst, package.name);
+	writeString(dst, package.description);
+	writeUint32(dst, (deUint32)package.nodes.size());
+
+	for (vector<CachedTestNode>::const_iterator node = package.nodes.begin(); node != package.nodes.end(); ++node)
+	{
+		writeUint32(dst, (deUint32)getCachedNodeType(node->nodeType));
+		writeUint32(dst, (deUint32)node->numChildren);
+		writeString(dst, node->name);
+		writeString(dst, node->description);
+	}
+}
+
+bool deserializeTestHierarchyCache (const deUint8* data, size_t dataSize, CachedTestPackage& dst)
+{
+	CacheReader reader (data, dataSize);
+
+	if (deMemCmp(reader.readBytes(sizeof(s_cacheMagic)), s_cacheMagic, sizeof(s_cacheMagic)) != 0)
+		throw Exception("Malformed test hierarchy cache: invalid magic");
+
+	// Caches from other versions or builds are stale, not malformed
+	if (reader.readUint32() != s_cacheVersion	||
+		reader.readUint32() != qpGetReleaseId()	||
+		reader.readString() != qpGetReleaseName()	||
+		reader.readString() != qpGetTargetName())
+		return false;
+
+	dst.name		= reader.readString();
+	dst.description	= reader.readString();
+	dst.nodes.clear();
+
+	{
+		const deUint32	numNodes		= reader.readUint32();
+		int				numUnclaimed	= 0;	//!< Sub-trees after current node not yet claimed by a parent group
+
+		if (numNodes > dataSize)
+			throw Exception("Malformed test hierarchy cache: invalid node count");
+
+		readCachedNodes(reader, dst.nodes, (int)numNodes);
+
+		// Every group's children must fit in the node list
+		for (int nodeNdx = (int)dst.nodes.size()-1; nodeNdx >= 0; nodeNdx--)
+		{
+			if (dst.nodes[nodeNdx].numChildren > numUnclaimed)
+				throw Exception("Malformed test hierarchy cache: invalid child count");
+
+			numUnclaimed += 1 - dst.nodes[nodeNdx].numChildren;
+		}
+	}
+
+	if (!reader.isFinished())
+		throw Exception("Malformed test hierarchy cache: trailing data");
+
+	return true;
+}
+
+string getTestHierarchyCacheFilename (const char* cacheDir, const char* packageName)
+{
+	return de::FilePath::join(cacheDir, string(packageName) + "-cases.bin").getPath();
+}
+
+void writeTestHierarchyCache (const string& filename, const CachedTestPackage& package)
+{
+	vector<deUint8>	data;
+	std::ofstream	out		(filename.c_str(), std::ios_base::binary);
+
+	serializeTestHierarchyCache(package, data);
+
+	if (!out.is_open() || !out.write((const char*)&data[0], (std::streamsize)data.size()))
+		throw Exception("Failed to write test hierarchy cache to " + filename);
+}
+
+bool readTestHierarchyCache (const string& filename, CachedTestPackage& dst)
+{
+	std::ifstream		in		(filename.c_str(), std::ios_base::binary);
+	vector<deUint8>		data;
+
+	if (!in.is_open())
+		return false;
+
+	in.seekg(0, std::ios_base::end);
+	data.resize((size_t)in.tellg());
+	in.seekg(0, std::ios_base::beg);
+
+	if (data.empty() || !in.read((char*)&data[0], (std::streamsize)data.size()))
+		throw Exception("Failed to read test hierarchy cache from " + filename);
+
+	return deserializeTestHierarchyCache(&data[0], data.size(), dst);
+}
+
+} // tcu
@@ -0,0 +1,95 @@
+#ifndef _TCUTESTHIERARCHYCACHE_HPP
+#define _TCUTESTHIERARCHYCACHE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Serialized test hierarchy cache.
+ *
+ * Binary format (all integers are little-endian deUint32, strings are
+ * stored as length followed by bytes without terminator):
+ *
+ *  magic "dEQPhier", version, release id, release name, target name,
+ *  package name, package description, node count,
+ *  nodes in depth-first pre-order:
+ *    node type, child count, name, description
+ *
+ * Node types are 0 = group, 1 = self-validate, 2 = capability,
+ * 3 = accuracy and 4 = performance.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "tcuTestCase.hpp"
+#include "tcuTestHierarchyIterator.hpp"
+
+#include <string>
+#include <vector>
+
+namespace tcu
+{
+
+struct CachedTestNode
+{
+	TestNodeType	nodeType;
+	std::string		name;
+	std::string		description;
+	int				numChildren;
+
+	CachedTestNode (void)
+		: nodeType		(NODETYPE_GROUP)
+		, numChildren	(0)
+	{
+	}
+
+	CachedTestNode (TestNodeType nodeType_, const std::string& name_, const std::string& description_)
+		: nodeType		(nodeType_)
+		, name			(name_)
+		, description	(description_)
+		, numChildren	(0)
+	{
+	}
+};
+
+struct CachedTestPackage
+{
+	std::string						name;
+	std::string						description;
+	std::vector<CachedTestNode>		nodes;			//!< Package children in depth-first pre-order
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Build cached package from test hierarchy iterator
+ *
+ * Iterator must be in STATE_ENTER_NODE of a package node. Nodes are
+ * collected until the package is left and the iterator is left at the
+ * STATE_LEAVE_NODE of the package.
+ *//*--------------------------------------------------------------------*/
+void		collectCachedTestPackage		(TestHierarchyIterator& iter, CachedTestPackage& dst);
+
+// Deserialization and reading return false if the cache is missing or was written by a different build. Malformed cache throws.
+void		serializeTestHierarchyCache		(const CachedTestPackage& package, std::vector<deUint8>& dst);
+bool		deserializeTestHierarchyCache	(const deUint8* data, size_t dataSize, CachedTestPackage& dst);
+
+std::string	getTestHierarchyCacheFilename	(const char* cacheDir, const char* packageName);
+void		writeTestHierarchyCache			(const std::string& filename, const CachedTestPackage& package);
+bool		readTestHierarchyCache			(const std::string& filename, CachedTestPackage& dst);
+
+} // tcu
+
+#endif // _TCUTESTHIERARCHYCACHE_HPP
@@ -23,6 +23,7 @@
 
 #include "tcuTestHierarchyIterator.hpp"
 #include "tcuCommandLine.hpp"
+#include "deClock.h"
 
 namespace tcu
 {
@@ -43,7 +44,8 @@ TestHierarchyInflater::~TestHierarchyInflater (void)
 // DefaultHierarchyInflater
 
 DefaultHierarchyInflater::DefaultHierarchyInflater (TestContext& testCtx)
-	: m_testCtx(testCtx)
+	: m_testCtx					(testCtx)
+	, m_packageInflationTime	(0)
 {
 }
 
@@ -62,8 +64,14 @@ void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, vecto
 			m_testCtx.setCurrentArchive(m_testCtx.getRootArchive());
 	}
 
-	testPackage->init();
-	testPackage->getChildren(children);
+	{
+		const deUint64 startTime = deGetMicroseconds();
+
+		testPackage->init();
+		testPackage->getChildren(children);
+
+		m_packageInflationTime = deGetMicroseconds() - startTime;
+	}
 }
 
 void DefaultHierarchyInflater::leaveTestPackage (TestPackage* testPackage)
@@ -74,8 +82,12 @@ void DefaultHierarchyInflater::leaveTestPackage (TestPackage* testPackage)
 
 void DefaultHierarchyInflater::enterGroupNode (TestCaseGroup* testGroup, vector<TestNode*>& children)
 {
+	const deUint64 startTime = deGetMicroseconds();
+
 	testGroup->init();
 	testGroup->getChildren(children);
+
+	m_packageInflationTime += deGetMicroseconds() - startTime;
 }
 
 void DefaultHierarchyInflater::leaveGroupNode (TestCaseGroup* testGroup)
@@ -69,8 +69,14 @@ public:
 	virtual void					enterGroupNode				(TestCaseGroup* testGroup, std::vector<TestNode*>& children);
 	virtual void					leaveGroupNode				(TestCaseGroup* testGroup);
 
+	//! Get time in microseconds spent in init() of current test package and its groups
+	deUint64						getPackageInflationTime		(void) const { return m_packageInflationTime;	}
+
 protected:
 	TestContext&					m_testCtx;
+
+private:
+	deUint64						m_packageInflationTime;
 };
 
 /*--------------------------------------------------------------------*//*!
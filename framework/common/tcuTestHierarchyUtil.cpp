@@ -22,6 +22,8 @@
  *//*--------------------------------------------------------------------*/
 
 #include "tcuTestHierarchyUtil.hpp"
+#include "tcuTestHierarchyCache.hpp"
+#include "tcuCommandLine.hpp"
 #include "tcuStringTemplate.hpp"
 #include "qpXmlWriter.h"
 
@@ -57,138 +59,216 @@ static std::string makePackageFilename (const std::string& pattern, const std::s
 	return StringTemplate(pattern).specialize(args);
 }
 
-void writeXmlCaselists (TestPackageRoot& root, TestContext& testCtx, const tcu::CommandLine& cmdLine)
+/*--------------------------------------------------------------------*//*!
+ * \brief Hierarchy inflater for case list writing
+ *
+ * Package entered after skipPackage() is not initialized and appears
+ * empty to the iterator. Skipping ends when the package is left.
+ *//*--------------------------------------------------------------------*/
+class CaselistInflater : public DefaultHierarchyInflater
 {
-	const  char* const			filenamePattern	= "${packageName}-cases.${typeExtension}";	// \todo [2015-02-27 pyry] Make this command line argument
-	DefaultHierarchyInflater	inflater		(testCtx);
-	TestHierarchyIterator		iter			(root, inflater, cmdLine);
-	FILE*						curFile			= DE_NULL;
-	qpXmlWriter*				writer			= DE_NULL;
+public:
+					CaselistInflater	(TestContext& testCtx)
+						: DefaultHierarchyInflater	(testCtx)
+						, m_skipPackage				(false)
+					{
+					}
 
+	void			skipPackage			(void) { m_skipPackage = true; }
+
+	void			enterTestPackage	(TestPackage* testPackage, std::vector<TestNode*>& children)
+	{
+		if (!m_skipPackage)
+			DefaultHierarchyInflater::enterTestPackage(testPackage, children);
+	}
+
+	void			leaveTestPackage	(TestPackage* testPackage)
+	{
+		if (!m_skipPackage)
+			DefaultHierarchyInflater::leaveTestPackage(testPackage);
+
+		m_skipPackage = false;
+	}
+
+private:
+	bool			m_skipPackage;
+};
+
+static bool readCachedPackage (const string& filename, CachedTestPackage& dst)
+{
 	try
 	{
-		while (iter.getState() != TestHierarchyIterator::STATE_FINISHED)
+		return readTestHierarchyCache(filename, dst);
+	}
+	catch (const Exception& e)
+	{
+		print("Ignoring test hierarchy cache: %s\n", e.what());
+		return false;
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get package from cache or by walking the hierarchy
+ *
+ * Iterator must be at STATE_ENTER_NODE of a package and is left at
+ * STATE_LEAVE_NODE of the same package. Cache is only used if the case
+ * list is not filtered.
+ *//*--------------------------------------------------------------------*/
+static void getCaselistPackage (TestHierarchyIterator& iter, CaselistInflater& inflater, const tcu::CommandLine& cmdLine, CachedTestPackage& dst)
+{
+	const char* const	cacheDir		= cmdLine.hasCaseFilter() ? DE_NULL : cmdLine.getCaseListCacheDir();
+	const string		cacheFilename	= cacheDir ? getTestHierarchyCacheFilename(cacheDir, iter.getNode()->getName()) : string();
+
+	DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE &&
+			  iter.getNode()->getNodeType() == NODETYPE_PACKAGE);
+
+	if (cacheDir && readCachedPackage(cacheFilename, dst) && dst.name == iter.getNode()->getName())
+	{
+		print("Using cached test hierarchy from '%s'\n", cacheFilename.c_str());
+
+		inflater.skipPackage();
+		iter.next();
+	}
+	else
+	{
+		collectCachedTestPackage(iter, dst);
+
+		if (cacheDir)
 		{
-			const TestNode* const	node		= iter.getNode();
-			const TestNodeType		nodeType	= node->getNodeType();
-			const bool				isEnter		= iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE;
-
-			DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE ||
-					  iter.getState() == TestHierarchyIterator::STATE_LEAVE_NODE);
-
-			if (nodeType == NODETYPE_PACKAGE)
-			{
-				if (isEnter)
-				{
-					const string	filename	= makePackageFilename(filenamePattern, node->getName(), "xml");
-					qpXmlAttribute	attribs[2];
-					int				numAttribs	= 0;
-
-					DE_ASSERT(!curFile && !writer);
-
-					print("Writing test cases from '%s' to file '%s'..\n", node->getName(), filename.c_str());
-
-					curFile = fopen(filename.c_str(), "wb");
-					if (!curFile)
-						throw Exception("Failed to open " + filename);
-
-					writer = qpXmlWriter_createFileWriter(curFile, DE_FALSE);
-					if (!writer)
-						throw Exception("Failed to create qpXmlWriter");
-
-					attribs[numAttribs++] = qpSetStringAttrib("PackageName",	node->getName());
-					attribs[numAttribs++] = qpSetStringAttrib("Description",	node->getDescription());
-					DE_ASSERT(numAttribs <= DE_LENGTH_OF_ARRAY(attribs));
-
-					if (!qpXmlWriter_startDocument(writer) ||
-						!qpXmlWriter_startElement(writer, "TestCaseList", numAttribs, attribs))
-						throw Exception("Failed to start XML document");
-				}
-				else
-				{
-					if (!qpXmlWriter_endElement(writer, "TestCaseList") ||
-						!qpXmlWriter_endDocument(writer))
-						throw Exception("Failed to terminate XML document");
-
-					qpXmlWriter_destroy(writer);
-					fclose(curFile);
-
-					writer	= DE_NULL;
-					curFile	= DE_NULL;
-				}
-			}
-			else
-			{
-				if (isEnter)
-				{
-					const string	caseName	= node->getName();
-					const string	description	= node->getDescription();
-					qpXmlAttribute	attribs[3];
-					int				numAttribs = 0;
-
-					attribs[numAttribs++] = qpSetStringAttrib("Name",			caseName.c_str());
-					attribs[numAttribs++] = qpSetStringAttrib("CaseType",		getNodeTypeName(nodeType));
-					attribs[numAttribs++] = qpSetStringAttrib("Description",	description.c_str());
-					DE_ASSERT(numAttribs <= DE_LENGTH_OF_ARRAY(attribs));
-
-					if (!qpXmlWriter_startElement(writer, "TestCase", numAttribs, attribs))
-						throw Exception("Writing to case list file failed");
-				}
-				else
-				{
-					if (!qpXmlWriter_endElement(writer, "TestCase"))
-						throw tcu::Exception("Writing to case list file failed");
-				}
-			}
-
-			iter.next();
+			print("Writing test hierarchy cache to '%s'\n", cacheFilename.c_str());
+			writeTestHierarchyCache(cacheFilename, dst);
 		}
 	}
-	catch (...)
+
+	DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_LEAVE_NODE &&
+			  iter.getNode()->getNodeType() == NODETYPE_PACKAGE);
+}
+
+static void writeXmlCaselistNode (qpXmlWriter* writer, const std::vector<CachedTestNode>& nodes, int& nodeNdx)
+{
+	const CachedTestNode&	node		= nodes[nodeNdx++];
+	qpXmlAttribute			attribs[3];
+	int						numAttribs	= 0;
+
+	attribs[numAttribs++] = qpSetStringAttrib("Name",			node.name.c_str());
+	attribs[numAttribs++] = qpSetStringAttrib("CaseType",		getNodeTypeName(node.nodeType));
+	attribs[numAttribs++] = qpSetStringAttrib("Description",	node.description.c_str());
+	DE_ASSERT(numAttribs <= DE_LENGTH_OF_ARRAY(attribs));
+
+	if (!qpXmlWriter_startElement(writer, "TestCase", numAttribs, attribs))
+		throw Exception("Writing to case list file failed");
+
+	for (int childNdx = 0; childNdx < node.numChildren; childNdx++)
+		writeXmlCaselistNode(writer, nodes, nodeNdx);
+
+	if (!qpXmlWriter_endElement(writer, "TestCase"))
+		throw tcu::Exception("Writing to case list file failed");
+}
+
+static void writeXmlCaselist (qpXmlWriter* writer, const CachedTestPackage& package)
+{
+	qpXmlAttribute	attribs[2];
+	int				numAttribs	= 0;
+
+	attribs[numAttribs++] = qpSetStringAttrib("PackageName",	package.name.c_str());
+	attribs[numAttribs++] = qpSetStringAttrib("Description",	package.description.c_str());
+	DE_ASSERT(numAttribs <= DE_LENGTH_OF_ARRAY(attribs));
+
+	if (!qpXmlWriter_startDocument(writer) ||
+		!qpXmlWriter_startElement(writer, "TestCaseList", numAttribs, attribs))
+		throw Exception("Failed to start XML document");
+
+	for (int nodeNdx = 0; nodeNdx < (int)package.nodes.size();)
+		writeXmlCaselistNode(writer, package.nodes, nodeNdx);
+
+	if (!qpXmlWriter_endElement(writer, "TestCaseList") ||
+		!qpXmlWriter_endDocument(writer))
+		throw Exception("Failed to terminate XML document");
+}
+
+void writeXmlCaselists (TestPackageRoot& root, TestContext& testCtx, const tcu::CommandLine& cmdLine)
+{
+	const  char* const			filenamePattern	= "${packageName}-cases.${typeExtension}";	// \todo [2015-02-27 pyry] Make this command line argument
+	CaselistInflater			inflater		(testCtx);
+	TestHierarchyIterator		iter			(root, inflater, cmdLine);
+
+	while (iter.getState() != TestHierarchyIterator::STATE_FINISHED)
 	{
-		if (writer)
-			qpXmlWriter_destroy(writer);
+		CachedTestPackage	package;
+		const string		filename	= makePackageFilename(filenamePattern, iter.getNode()->getName(), "xml");
+		FILE*				curFile		= DE_NULL;
+		qpXmlWriter*		writer		= DE_NULL;
+
+		getCaselistPackage(iter, inflater, cmdLine, package);
 
-		if (curFile)
-			fclose(curFile);
+		print("Writing test cases from '%s' to file '%s'..\n", package.name.c_str(), filename.c_str());
 
-		throw;
+		try
+		{
+			curFile = fopen(filename.c_str(), "wb");
+			if (!curFile)
+				throw Exception("Failed to open " + filename);
+
+			writer = qpXmlWriter_createFileWriter(curFile, DE_FALSE);
+			if (!writer)
+				throw Exception("Failed to create qpXmlWriter");
+
+			writeXmlCaselist(writer, package);
+		}
+		catch (...)
+		{
+			if (writer)
+				qpXmlWriter_destroy(writer);
+
+			if (curFile)
+				fclose(curFile);
+
+			throw;
+		}
+
+		qpXmlWriter_destroy(writer);
+		fclose(curFile);
+
+		iter.next();
 	}
+}
+
+static void writeTxtCaselistNode (std::ostream& out, const string& parentPath, const std::vector<CachedTestNode>& nodes, int& nodeNdx)
+{
+	const CachedTestNode&	node	= nodes[nodeNdx++];
+	const string			path	= parentPath + "." + node.name;
 
-	DE_ASSERT(!curFile && !writer);
+	out << (isTestNodeTypeExecutable(node.nodeType) ? "TEST" : "GROUP") << ": " << path << "\n";
+
+	for (int childNdx = 0; childNdx < node.numChildren; childNdx++)
+		writeTxtCaselistNode(out, path, nodes, nodeNdx);
 }
 
 void writeTxtCaselists (TestPackageRoot& root, TestContext& testCtx, const tcu::CommandLine& cmdLine)
 {
 	const  char* const			filenamePattern	= "${packageName}-cases.${typeExtension}";	// \todo [2015-02-27 pyry] Make this command line argument
-	DefaultHierarchyInflater	inflater		(testCtx);
+	CaselistInflater			inflater		(testCtx);
 	TestHierarchyIterator		iter			(root, inflater, cmdLine);
 
 	while (iter.getState() != TestHierarchyIterator::STATE_FINISHED)
 	{
-		DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE &&
-				  iter.getNode()->getNodeType() == NODETYPE_PACKAGE);
+		CachedTestPackage	package;
+		const string		filename	= makePackageFilename(filenamePattern, iter.getNode()->getName(), "txt");
 
-		const char*		pkgName		= iter.getNode()->getName();
-		const string	filename	= makePackageFilename(filenamePattern, pkgName, "txt");
-		std::ofstream	out			(filename.c_str(), std::ios_base::binary);
+		getCaselistPackage(iter, inflater, cmdLine, package);
 
-		if (!out.is_open() || !out.good())
-			throw Exception("Failed to open " + filename);
+		{
+			std::ofstream out (filename.c_str(), std::ios_base::binary);
 
-		print("Writing test cases from '%s' to file '%s'..\n", pkgName, filename.c_str());
+			if (!out.is_open() || !out.good())
+				throw Exception("Failed to open " + filename);
 
-		iter.next();
+			print("Writing test cases from '%s' to file '%s'..\n", package.name.c_str(), filename.c_str());
 
-		while (iter.getNode()->getNodeType() != NODETYPE_PACKAGE)
-		{
-			if (iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE)
-				out << (isTestNodeTypeExecutable(iter.getNode()->getNodeType()) ? "TEST" : "GROUP") << ": " << iter.getNodePath() << "\n";
-			iter.next();
+			for (int nodeNdx = 0; nodeNdx < (int)package.nodes.size();)
+				writeTxtCaselistNode(out, package.name, package.nodes, nodeNdx);
 		}
 
-		DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_LEAVE_NODE &&
-				  iter.getNode()->getNodeType() == NODETYPE_PACKAGE);
 		iter.next();
 	}
 }
@@ -122,6 +122,24 @@ TestLog::~TestLog (void)
 	qpTestLog_destroy(m_log);
 }
 
+//! Configure background compression of logged images. Falls back to synchronous compression if encoder threads can't be created.
+void TestLog::setImageEncoderConfig (const qpImageEncoderConfig& config)
+{
+	qpTestLog_setImageEncoderConfig(m_log, &config);
+}
+
+//! Configure output buffering and flush policy. Keeps previous configuration if output buffer can't be created.
+void TestLog::setBufferConfig (const qpTestLogBufferConfig& config)
+{
+	qpTestLog_setBufferConfig(m_log, &config);
+}
+
+//! Write out all buffered output. Safe to call from crash handlers.
+void TestLog::flush (void)
+{
+	qpTestLog_flush(m_log);
+}
+
 void TestLog::writeMessage (const char* msgStr)
 {
 	if (qpTestLog_writeText(m_log, DE_NULL, DE_NULL, QP_KEY_TAG_LAST, msgStr) == DE_FALSE)
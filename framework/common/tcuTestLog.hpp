@@ -129,6 +129,10 @@ public:
 	SampleBuilder		operator<<				(const BeginSampleToken&);
 	TestLog&			operator<<				(const EndSampleListToken&);
 
+	void				setImageEncoderConfig	(const qpImageEncoderConfig& config);
+	void				setBufferConfig			(const qpTestLogBufferConfig& config);
+	void				flush					(void);
+
 	// Raw api
 	void				writeMessage			(const char* message);
 
@@ -46,13 +46,14 @@ static qpTestCaseType nodeTypeToTestCaseType (TestNodeType nodeType)
 }
 
 TestSessionExecutor::TestSessionExecutor (TestPackageRoot& root, TestContext& testCtx)
-	: m_testCtx			(testCtx)
-	, m_inflater		(testCtx)
-	, m_iterator		(root, m_inflater, testCtx.getCommandLine())
-	, m_state			(STATE_TRAVERSE_HIERARCHY)
-	, m_abortSession	(false)
-	, m_isInTestCase	(false)
-	, m_testStartTime	(0)
+	: m_testCtx				(testCtx)
+	, m_inflater			(testCtx)
+	, m_iterator			(root, m_inflater, testCtx.getCommandLine())
+	, m_state				(STATE_TRAVERSE_HIERARCHY)
+	, m_abortSession		(false)
+	, m_isInTestCase		(false)
+	, m_testStartTime		(0)
+	, m_loggedInflationTime	(0)
 {
 }
 
@@ -152,11 +153,13 @@ void TestSessionExecutor::enterTestPackage (TestPackage* testPackage)
 	// Create test case wrapper
 	DE_ASSERT(!m_caseExecutor);
 	m_caseExecutor = de::MovePtr<TestCaseExecutor>(testPackage->createExecutor());
+
+	m_loggedInflationTime = 0;
 }
 
 void TestSessionExecutor::leaveTestPackage (TestPackage* testPackage)
 {
-	DE_UNREF(testPackage);
+	print("\nTest hierarchy of '%s' inflated in %.2f ms\n", testPackage->getName(), (double)m_inflater.getPackageInflationTime() / 1000.0);
 	m_caseExecutor.clear();
 }
 
@@ -172,6 +175,15 @@ bool TestSessionExecutor::enterTestCase (TestCase* testCase, const std::string&
 	m_testCtx.setTerminateAfter(false);
 	log.startCase(casePath.c_str(), caseType);
 
+	// Hierarchy is inflated lazily while iterating, so report time spent on it in the case that needed it.
+	if (m_inflater.getPackageInflationTime() > m_loggedInflationTime)
+	{
+		const deUint64 inflationTime = m_inflater.getPackageInflationTime() - m_loggedInflationTime;
+
+		log << TestLog::Integer("HierarchyInflationTime", "Time spent creating test hierarchy before test case in microseconds", "us", QP_KEY_TAG_TIME, (deInt64)inflationTime);
+		m_loggedInflationTime += inflationTime;
+	}
+
 	m_isInTestCase	= true;
 	m_testStartTime	= deGetMicroseconds();
 
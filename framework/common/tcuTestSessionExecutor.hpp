@@ -95,6 +95,7 @@ private:
 	bool							m_abortSession;
 	bool							m_isInTestCase;
 	deUint64						m_testStartTime;
+	deUint64						m_loggedInflationTime;	//!< Part of package inflation time that has been written to the test log
 };
 
 } // tcu
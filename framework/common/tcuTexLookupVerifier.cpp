@@ -26,7 +26,12 @@
 #include "tcuTexVerifierUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuImageCompareThreads.hpp"
 #include "deMath.h"
+#include "deAtomic.h"
+#include "deThreadLocal.hpp"
+
+#include <vector>
 
 namespace tcu
 {
@@ -52,6 +57,130 @@ static inline bool coordsInBounds (const ConstPixelBufferAccess& access, int x,
 	return de::inBounds(x, 0, access.getWidth()) && de::inBounds(y, 0, access.getHeight()) && de::inBounds(z, 0, access.getDepth());
 }
 
+static inline Vec4 fetchTexel (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	const Vec4 p = access.getPixel(i, j, k);
+	return isSRGB(access.getFormat()) ? sRGBToLinear(p) : p;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Direct-mapped cache of fetched texels
+ *
+ * Neighboring lookups share most of their texels. Batch verification
+ * installs a cache for the current thread and resets it for each tile,
+ * after which float lookups decode each texel only once per tile.
+ * Entries are keyed by texel address and format.
+ *//*--------------------------------------------------------------------*/
+class TexelCache
+{
+public:
+	enum
+	{
+		CACHE_SIZE_LOG2	= 9,
+		CACHE_SIZE		= 1<<CACHE_SIZE_LOG2
+	};
+
+	TexelCache (void)
+		: m_generation(1)
+	{
+		clear();
+	}
+
+	void reset (void)
+	{
+		// Entries from earlier generations are stale.
+		if (++m_generation == 0)
+		{
+			clear();
+			m_generation = 1;
+		}
+	}
+
+	Vec4 fetch (const ConstPixelBufferAccess& access, int i, int j, int k)
+	{
+		const void* const	ptr		= access.getPixelPtr(i, j, k);
+		const deUint64		addr	= (deUint64)(deUintptr)ptr;
+		const deUint32		hash	= ((deUint32)(addr ^ (addr >> 32)) * 2654435761u) >> (32 - CACHE_SIZE_LOG2);
+		Entry&				entry	= m_entries[hash];
+
+		if (entry.generation != m_generation || entry.ptr != ptr || entry.format != access.getFormat())
+		{
+			entry.ptr			= ptr;
+			entry.format		= access.getFormat();
+			entry.generation	= m_generation;
+			entry.color			= fetchTexel(access, i, j, k);
+		}
+
+		return entry.color;
+	}
+
+private:
+	struct Entry
+	{
+		const void*		ptr;
+		TextureFormat	format;
+		deUint32		generation;
+		Vec4			color;
+	};
+
+	void clear (void)
+	{
+		for (int ndx = 0; ndx < CACHE_SIZE; ndx++)
+		{
+			m_entries[ndx].ptr			= DE_NULL;
+			m_entries[ndx].generation	= 0;
+		}
+	}
+
+	deUint32		m_generation;
+	Entry			m_entries[CACHE_SIZE];
+};
+
+#if defined(DE_THREAD_LOCAL)
+
+// Thread-local texel cache, set only during batch verification.
+static DE_THREAD_LOCAL TexelCache*	s_currentTexelCache	= DE_NULL;
+
+static inline void setCurrentTexelCache (TexelCache* cache)
+{
+	s_currentTexelCache = cache;
+}
+
+static inline TexelCache* getCurrentTexelCache (void)
+{
+	return s_currentTexelCache;
+}
+
+#else // defined(DE_THREAD_LOCAL)
+
+static de::ThreadLocal s_currentTexelCache;
+
+static inline void setCurrentTexelCache (TexelCache* cache)
+{
+	s_currentTexelCache.set(cache);
+}
+
+static inline TexelCache* getCurrentTexelCache (void)
+{
+	return (TexelCache*)s_currentTexelCache.get();
+}
+
+#endif // defined(DE_THREAD_LOCAL)
+
+class ScopedCurrentTexelCache
+{
+public:
+	ScopedCurrentTexelCache (TexelCache& cache)
+	{
+		setCurrentTexelCache(&cache);
+	}
+
+	~ScopedCurrentTexelCache (void)
+	{
+		setCurrentTexelCache(DE_NULL);
+	}
+};
+
 template<typename ScalarType>
 inline Vector<ScalarType, 4> lookup (const ConstPixelBufferAccess& access, const Sampler& sampler, int i, int j, int k)
 {
@@ -67,8 +196,8 @@ inline Vector<float, 4> lookup (const ConstPixelBufferAccess& access, const Samp
 	// Specialization for float lookups: sRGB conversion is performed as specified in format.
 	if (coordsInBounds(access, i, j, k))
 	{
-		const Vec4 p = access.getPixel(i, j, k);
-		return isSRGB(access.getFormat()) ? sRGBToLinear(p) : p;
+		TexelCache* const cache = getCurrentTexelCache();
+		return cache ? cache->fetch(access, i, j, k) : fetchTexel(access, i, j, k);
 	}
 	else
 		return sampleTextureBorder<float>(access.getFormat(), sampler);
@@ -2040,6 +2169,276 @@ bool isLookupResultValid (const TextureCubeArrayView& texture, const Sampler& sa
 	return false;
 }
 
+// Batch verification
+
+namespace
+{
+
+enum
+{
+	LOOKUP_BATCH_TILE_SIZE				= 16,	//!< Lookups are verified in square tiles, texel cache is reset per tile.
+	LOOKUP_BATCH_MIN_PIXELS_PER_BAND	= LOOKUP_BATCH_TILE_SIZE*LOOKUP_BATCH_TILE_SIZE
+};
+
+inline int getNumLookupBatchTiles (int size)
+{
+	return (size + LOOKUP_BATCH_TILE_SIZE - 1) / LOOKUP_BATCH_TILE_SIZE;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Verifies a batch of lookups tile by tile
+ *
+ * Tiles are numbered in row-major order and handed out as row bands.
+ * Each band has its own texel cache. Failed lookups are counted with a
+ * shared atomic counter so that early-out can stop all bands.
+ *//*--------------------------------------------------------------------*/
+class LookupBatchJob : public RowBandJob
+{
+public:
+								LookupBatchJob		(const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures, int numBands);
+
+	int							getNumTiles			(void) const { return m_numTilesX*m_numTilesY; }
+	LookupBatchResult			getResult			(void) const;
+
+	void						processRows			(int bandNdx, int beginTile, int endTile);
+
+protected:
+	virtual bool				isLookupValid		(const Vec4& coord, const Vec2& lodBounds, const Vec4& result) const = 0;
+
+private:
+	bool						isDone				(void) const { return m_maxFailures > 0 && m_numFailed >= m_maxFailures; }
+
+	const LookupBatch			m_batch;
+	const PixelBufferAccess		m_errorMask;
+	const int					m_maxFailures;
+	const int					m_numTilesX;
+	const int					m_numTilesY;
+
+	volatile deInt32			m_numFailed;
+	std::vector<int>			m_bandNumChecked;
+	std::vector<TexelCache>		m_bandCaches;
+};
+
+LookupBatchJob::LookupBatchJob (const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures, int numBands)
+	: m_batch			(batch)
+	, m_errorMask		(errorMask)
+	, m_maxFailures		(maxFailures)
+	, m_numTilesX		(getNumLookupBatchTiles(batch.results.getWidth()))
+	, m_numTilesY		(getNumLookupBatchTiles(batch.results.getHeight()))
+	, m_numFailed		(0)
+	, m_bandNumChecked	(numBands, 0)
+	, m_bandCaches		(numBands)
+{
+	DE_ASSERT(batch.coords.getWidth() == batch.results.getWidth() && batch.coords.getHeight() == batch.results.getHeight());
+	DE_ASSERT(batch.lodBounds.getWidth() == batch.results.getWidth() && batch.lodBounds.getHeight() == batch.results.getHeight());
+	DE_ASSERT(batch.verifyMask.getWidth() == 0 || (batch.verifyMask.getWidth() == batch.results.getWidth() && batch.verifyMask.getHeight() == batch.results.getHeight()));
+	DE_ASSERT(errorMask.getWidth() == batch.results.getWidth() && errorMask.getHeight() == batch.results.getHeight());
+	DE_ASSERT(maxFailures >= 0);
+}
+
+LookupBatchResult LookupBatchJob::getResult (void) const
+{
+	LookupBatchResult result;
+
+	for (int bandNdx = 0; bandNdx < (int)m_bandNumChecked.size(); bandNdx++)
+		result.numChecked += m_bandNumChecked[bandNdx];
+
+	result.numFailed = m_numFailed;
+
+	return result;
+}
+
+void LookupBatchJob::processRows (int bandNdx, int beginTile, int endTile)
+{
+	const bool						useMask		= m_batch.verifyMask.getWidth() > 0;
+	const int						width		= m_batch.results.getWidth();
+	const int						height		= m_batch.results.getHeight();
+	TexelCache&						cache		= m_bandCaches[bandNdx];
+	const ScopedCurrentTexelCache	scopedCache	(cache);
+	int								numChecked	= 0;
+
+	for (int tileNdx = beginTile; tileNdx < endTile && !isDone(); tileNdx++)
+	{
+		const int	x0	= (tileNdx % m_numTilesX) * LOOKUP_BATCH_TILE_SIZE;
+		const int	y0	= (tileNdx / m_numTilesX) * LOOKUP_BATCH_TILE_SIZE;
+		const int	x1	= de::min(x0 + LOOKUP_BATCH_TILE_SIZE, width);
+		const int	y1	= de::min(y0 + LOOKUP_BATCH_TILE_SIZE, height);
+
+		cache.reset();
+
+		for (int y = y0; y < y1; y++)
+		for (int x = x0; x < x1; x++)
+		{
+			if (useMask && m_batch.verifyMask.getPixel(x, y).x() == 0.0f)
+				continue;
+
+			if (isDone())
+				break;
+
+			numChecked += 1;
+
+			if (!isLookupValid(m_batch.coords.getPixel(x, y), m_batch.lodBounds.getPixel(x, y).swizzle(0, 1), m_batch.results.getPixel(x, y)))
+			{
+				m_errorMask.setPixel(Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y);
+				deAtomicIncrement32(&m_numFailed);
+			}
+		}
+	}
+
+	m_bandNumChecked[bandNdx] = numChecked;
+}
+
+inline bool isBatchLookupValid (const Texture1DView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.x(), lodBounds, result);
+}
+
+inline bool isBatchLookupValid (const Texture2DView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.swizzle(0, 1), lodBounds, result);
+}
+
+inline bool isBatchLookupValid (const TextureCubeView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.swizzle(0, 1, 2), lodBounds, result);
+}
+
+inline bool isBatchLookupValid (const Texture1DArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.swizzle(0, 1), lodBounds, result);
+}
+
+inline bool isBatchLookupValid (const Texture2DArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.swizzle(0, 1, 2), lodBounds, result);
+}
+
+inline bool isBatchLookupValid (const Texture3DView& texture, const Sampler& sampler, const LookupPrecision& prec, const Vec4& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValid(texture, sampler, prec, coord.swizzle(0, 1, 2), lodBounds, result);
+}
+
+template<typename TextureViewType>
+class TextureLookupBatchJob : public LookupBatchJob
+{
+public:
+	TextureLookupBatchJob (const TextureViewType& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures, int numBands)
+		: LookupBatchJob	(batch, errorMask, maxFailures, numBands)
+		, m_texture			(texture)
+		, m_sampler			(sampler)
+		, m_prec			(prec)
+	{
+	}
+
+protected:
+	bool isLookupValid (const Vec4& coord, const Vec2& lodBounds, const Vec4& result) const
+	{
+		return isBatchLookupValid(m_texture, m_sampler, m_prec, coord, lodBounds, result);
+	}
+
+private:
+	const TextureViewType&	m_texture;
+	const Sampler&			m_sampler;
+	const LookupPrecision&	m_prec;
+};
+
+class CubeArrayLookupBatchJob : public LookupBatchJob
+{
+public:
+	CubeArrayLookupBatchJob (const TextureCubeArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const IVec4& coordBits, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures, int numBands)
+		: LookupBatchJob	(batch, errorMask, maxFailures, numBands)
+		, m_texture			(texture)
+		, m_sampler			(sampler)
+		, m_prec			(prec)
+		, m_coordBits		(coordBits)
+	{
+	}
+
+protected:
+	bool isLookupValid (const Vec4& coord, const Vec2& lodBounds, const Vec4& result) const
+	{
+		return isLookupResultValid(m_texture, m_sampler, m_prec, m_coordBits, coord, lodBounds, result);
+	}
+
+private:
+	const TextureCubeArrayView&	m_texture;
+	const Sampler&				m_sampler;
+	const LookupPrecision&		m_prec;
+	const IVec4					m_coordBits;
+};
+
+int getNumLookupBatchBands (const LookupBatch& batch)
+{
+	const int numTiles = getNumLookupBatchTiles(batch.results.getWidth()) * getNumLookupBatchTiles(batch.results.getHeight());
+	return getNumRowBands(numTiles, LOOKUP_BATCH_TILE_SIZE*LOOKUP_BATCH_TILE_SIZE, LOOKUP_BATCH_MIN_PIXELS_PER_BAND);
+}
+
+template<typename TextureViewType>
+LookupBatchResult verifyTextureLookupBatch (const TextureViewType& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	const int								numBands	= getNumLookupBatchBands(batch);
+	TextureLookupBatchJob<TextureViewType>	job			(texture, sampler, prec, batch, errorMask, maxFailures, numBands);
+
+	executeRowBands(job, job.getNumTiles(), numBands);
+
+	return job.getResult();
+}
+
+} // anonymous
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Verify a batch of lookups
+ *
+ * Lookups are verified in tiles, in parallel on the image comparison
+ * threads. Each rejected lookup is marked red in errorMask, other pixels
+ * are left untouched.
+ *
+ * If maxFailures is positive, verification stops once that many lookups
+ * have been rejected. In that case numFailed may exceed maxFailures and
+ * the set of marked pixels depends on the number of threads, but
+ * numFailed >= maxFailures holds exactly when at least maxFailures
+ * lookups in the batch are invalid.
+ *//*--------------------------------------------------------------------*/
+LookupBatchResult verifyLookupBatch (const Texture1DView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const Texture2DView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const TextureCubeView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const Texture1DArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const Texture2DArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const Texture3DView& texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	return verifyTextureLookupBatch(texture, sampler, prec, batch, errorMask, maxFailures);
+}
+
+LookupBatchResult verifyLookupBatch (const TextureCubeArrayView& texture, const Sampler& sampler, const LookupPrecision& prec, const IVec4& coordBits, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures)
+{
+	const int				numBands	= getNumLookupBatchBands(batch);
+	CubeArrayLookupBatchJob	job			(texture, sampler, prec, coordBits, batch, errorMask, maxFailures, numBands);
+
+	executeRowBands(job, job.getNumTiles(), numBands);
+
+	return job.getResult();
+}
+
 Vec4 computeFixedPointThreshold (const IVec4& bits)
 {
 	return computeFixedPointError(bits);
@@ -95,6 +95,45 @@ enum TexLookupScaleMode
 	TEX_LOOKUP_SCALE_MODE_LAST
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Batch of lookup results to verify.
+ *
+ * Lookup for pixel (x, y) is described by coords(x, y), lod bounds in
+ * lodBounds(x, y).xy and the lookup result in results(x, y). Only the
+ * coordinate components used by the texture type are read. All accesses
+ * must be of the same size. If verifyMask is not empty, only pixels with
+ * non-zero red component in it are verified.
+ *//*--------------------------------------------------------------------*/
+struct LookupBatch
+{
+	ConstPixelBufferAccess	results;		//!< Lookup results.
+	ConstPixelBufferAccess	coords;			//!< Lookup coordinates.
+	ConstPixelBufferAccess	lodBounds;		//!< Lod bounds in xy.
+	ConstPixelBufferAccess	verifyMask;		//!< Pixels to verify, or empty to verify all.
+
+	LookupBatch (void) {}
+
+	LookupBatch (const ConstPixelBufferAccess& results_, const ConstPixelBufferAccess& coords_, const ConstPixelBufferAccess& lodBounds_, const ConstPixelBufferAccess& verifyMask_ = ConstPixelBufferAccess())
+		: results		(results_)
+		, coords		(coords_)
+		, lodBounds		(lodBounds_)
+		, verifyMask	(verifyMask_)
+	{
+	}
+};
+
+struct LookupBatchResult
+{
+	int			numChecked;		//!< Number of lookups verified.
+	int			numFailed;		//!< Number of lookups rejected.
+
+	LookupBatchResult (void)
+		: numChecked	(0)
+		, numFailed		(0)
+	{
+	}
+};
+
 Vec4		computeFixedPointThreshold			(const IVec4& bits);
 Vec4		computeFloatingPointThreshold		(const IVec4& bits, const Vec4& value);
 
@@ -113,6 +152,14 @@ bool		isLookupResultValid					(const Texture2DArrayView&		texture, const Sampler
 bool		isLookupResultValid					(const Texture3DView&			texture, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
 bool		isLookupResultValid					(const TextureCubeArrayView&	texture, const Sampler& sampler, const LookupPrecision& prec, const IVec4& coordBits, const Vec4& coord, const Vec2& lodBounds, const Vec4& result);
 
+LookupBatchResult	verifyLookupBatch		(const Texture1DView&			texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const Texture2DView&			texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const TextureCubeView&			texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const Texture1DArrayView&		texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const Texture2DArrayView&		texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const Texture3DView&			texture, const Sampler& sampler, const LookupPrecision& prec, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+LookupBatchResult	verifyLookupBatch		(const TextureCubeArrayView&	texture, const Sampler& sampler, const LookupPrecision& prec, const IVec4& coordBits, const LookupBatch& batch, const PixelBufferAccess& errorMask, int maxFailures = 0);
+
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const LookupPrecision& prec, const float coordX, const int coordY, const Vec4& result);
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const IntLookupPrecision& prec, const float coordX, const int coordY, const IVec4& result);
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const IntLookupPrecision& prec, const float coordX, const int coordY, const UVec4& result);
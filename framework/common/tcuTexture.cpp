@@ -265,7 +265,7 @@ inline int channelToInt (const deUint8* value, TextureFormat::ChannelType type)
 	}
 }
 
-void floatToChannel (deUint8* dst, float src, TextureFormat::ChannelType type)
+inline void floatToChannel (deUint8* dst, float src, TextureFormat::ChannelType type)
 {
 	// make sure this table is updated if format table is updated
 	DE_STATIC_ASSERT(TextureFormat::CHANNELTYPE_LAST == 27);
@@ -321,7 +321,7 @@ static inline deUint32 convertSatUint24 (S src)
 		return (deUint32)src;
 }
 
-void intToChannel (deUint8* dst, int src, TextureFormat::ChannelType type)
+inline void intToChannel (deUint8* dst, int src, TextureFormat::ChannelType type)
 {
 	// make sure this table is updated if format table is updated
 	DE_STATIC_ASSERT(TextureFormat::CHANNELTYPE_LAST == 27);
@@ -1121,6 +1121,530 @@ void PixelBufferAccess::setPixStencil (int stencil, int x, int y, int z) const
 #undef PU
 }
 
+namespace
+{
+
+// Row converters.
+//
+// Converters are specialized for a single channel type and convert numPixels
+// consecutive pixels per call. Channel order is resolved once per row.
+
+enum
+{
+	CHANNEL_OFFSET_ZERO	= -1,	//!< Channel is not stored, reads as 0.
+	CHANNEL_OFFSET_ONE	= -2	//!< Channel is not stored, reads as 1.
+};
+
+inline bool isPackedChannelType (TextureFormat::ChannelType type)
+{
+	// make sure this table is updated if format table is updated
+	DE_STATIC_ASSERT(TextureFormat::CHANNELTYPE_LAST == 27);
+
+	switch (type)
+	{
+		case TextureFormat::UNORM_SHORT_565:
+		case TextureFormat::UNORM_SHORT_555:
+		case TextureFormat::UNORM_SHORT_4444:
+		case TextureFormat::UNORM_SHORT_5551:
+		case TextureFormat::UNORM_INT_101010:
+		case TextureFormat::UNORM_INT_1010102_REV:
+		case TextureFormat::UNSIGNED_INT_1010102_REV:
+		case TextureFormat::UNSIGNED_INT_11F_11F_10F_REV:
+		case TextureFormat::UNSIGNED_INT_999_E5_REV:
+		case TextureFormat::UNSIGNED_INT_24_8:
+		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+//! Byte offset of each read swizzle component within a pixel, or CHANNEL_OFFSET_ZERO / CHANNEL_OFFSET_ONE.
+IVec4 getChannelReadOffsets (TextureFormat::ChannelOrder order, int channelSize)
+{
+	const TextureSwizzle::Channel* const	channelMap	= getChannelReadSwizzle(order).components;
+	IVec4									offsets;
+
+	for (int c = 0; c < 4; c++)
+	{
+		switch (channelMap[c])
+		{
+			case TextureSwizzle::CHANNEL_0:
+			case TextureSwizzle::CHANNEL_1:
+			case TextureSwizzle::CHANNEL_2:
+			case TextureSwizzle::CHANNEL_3:
+				offsets[c] = channelSize*(int)channelMap[c];
+				break;
+
+			case TextureSwizzle::CHANNEL_ZERO:
+				offsets[c] = CHANNEL_OFFSET_ZERO;
+				break;
+
+			case TextureSwizzle::CHANNEL_ONE:
+				offsets[c] = CHANNEL_OFFSET_ONE;
+				break;
+
+			default:
+				DE_ASSERT(false);
+				offsets[c] = CHANNEL_OFFSET_ZERO;
+		}
+	}
+
+	return offsets;
+}
+
+#define UB16(OFFS, COUNT)		((*((const deUint16*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
+#define UB32(OFFS, COUNT)		((*((const deUint32*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
+#define NB16(OFFS, COUNT)		channelToNormFloat(UB16(OFFS, COUNT), (COUNT))
+#define NB32(OFFS, COUNT)		channelToNormFloat(UB32(OFFS, COUNT), (COUNT))
+#define PN(VAL, OFFS, BITS)		(normFloatToChannel((VAL), (BITS)) << (OFFS))
+#define PU(VAL, OFFS, BITS)		(uintToChannel((deUint32)(VAL), (BITS)) << (OFFS))
+
+// \note Packed pixel accessors must match ConstPixelBufferAccess::getPixel*() and PixelBufferAccess::setPixel().
+
+template <TextureFormat::ChannelType Type>
+inline Vec4 readPackedPixelFloat (const deUint8* pixelPtr, TextureFormat::ChannelOrder order)
+{
+	switch (Type)
+	{
+		case TextureFormat::UNORM_SHORT_565:			return Vec4(NB16(11,  5), NB16( 5,  6), NB16( 0,  5), 1.0f);
+		case TextureFormat::UNORM_SHORT_555:			return Vec4(NB16(10,  5), NB16( 5,  5), NB16( 0,  5), 1.0f);
+		case TextureFormat::UNORM_SHORT_4444:			return Vec4(NB16(12,  4), NB16( 8,  4), NB16( 4,  4), NB16( 0, 4));
+		case TextureFormat::UNORM_SHORT_5551:			return Vec4(NB16(11,  5), NB16( 6,  5), NB16( 1,  5), NB16( 0, 1));
+		case TextureFormat::UNORM_INT_101010:			return Vec4(NB32(22, 10), NB32(12, 10), NB32( 2, 10), 1.0f);
+		case TextureFormat::UNORM_INT_1010102_REV:		return Vec4(NB32( 0, 10), NB32(10, 10), NB32(20, 10), NB32(30, 2));
+		case TextureFormat::UNSIGNED_INT_1010102_REV:	return UVec4(UB32(0, 10), UB32(10, 10), UB32(20, 10), UB32(30, 2)).cast<float>();
+		case TextureFormat::UNSIGNED_INT_999_E5_REV:	return unpackRGB999E5(*((const deUint32*)pixelPtr));
+
+		case TextureFormat::UNSIGNED_INT_11F_11F_10F_REV:
+			return Vec4(Float11(UB32(0, 11)).asFloat(), Float11(UB32(11, 11)).asFloat(), Float10(UB32(22, 10)).asFloat(), 1.0f);
+
+		case TextureFormat::UNSIGNED_INT_24_8:
+			// \note Stencil is always ignored.
+			DE_ASSERT(order == TextureFormat::D || order == TextureFormat::DS);
+			return Vec4(NB32(8, 24), 0.0f, 0.0f, 1.0f);
+
+		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
+			// \note Stencil is ignored.
+			DE_ASSERT(order == TextureFormat::DS);
+			return Vec4(*((const float*)pixelPtr), 0.0f, 0.0f, 1.0f);
+
+		default:
+			DE_ASSERT(false);
+			DE_UNREF(order);
+			return Vec4(0.0f);
+	}
+}
+
+template <TextureFormat::ChannelType Type>
+inline IVec4 readPackedPixelInt (const deUint8* pixelPtr, TextureFormat::ChannelOrder order)
+{
+	switch (Type)
+	{
+		case TextureFormat::UNORM_SHORT_565:			return UVec4(UB16(11,  5), UB16( 5,  6), UB16( 0,  5), 1).cast<int>();
+		case TextureFormat::UNORM_SHORT_555:			return UVec4(UB16(10,  5), UB16( 5,  5), UB16( 0,  5), 1).cast<int>();
+		case TextureFormat::UNORM_SHORT_4444:			return UVec4(UB16(12,  4), UB16( 8,  4), UB16( 4,  4), UB16( 0, 4)).cast<int>();
+		case TextureFormat::UNORM_SHORT_5551:			return UVec4(UB16(11,  5), UB16( 6,  5), UB16( 1,  5), UB16( 0, 1)).cast<int>();
+		case TextureFormat::UNORM_INT_101010:			return UVec4(UB32(22, 10), UB32(12, 10), UB32( 2, 10), 1).cast<int>();
+		case TextureFormat::UNORM_INT_1010102_REV:		return UVec4(UB32( 0, 10), UB32(10, 10), UB32(20, 10), UB32(30, 2)).cast<int>();
+		case TextureFormat::UNSIGNED_INT_1010102_REV:	return UVec4(UB32( 0, 10), UB32(10, 10), UB32(20, 10), UB32(30, 2)).cast<int>();
+
+		case TextureFormat::UNSIGNED_INT_24_8:
+			switch (order)
+			{
+				case TextureFormat::D:	return UVec4(UB32(8, 24), 0, 0, 1).cast<int>();
+				case TextureFormat::S:	return UVec4(0, 0, 0, UB32(8, 24)).cast<int>();
+				case TextureFormat::DS:	return UVec4(UB32(8, 24), 0, 0, UB32(0, 8)).cast<int>();
+				default:
+					DE_ASSERT(false);
+					return IVec4(0);
+			}
+
+		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
+		{
+			DE_ASSERT(order == TextureFormat::DS);
+			const float		d	= *((const float*)pixelPtr);
+			const deUint8	s	= *((const deUint32*)(pixelPtr+4)) & 0xffu;
+			// \note Returns bit-representation of depth floating-point value.
+			return UVec4(tcu::Float32(d).bits(), 0, 0, s).cast<int>();
+		}
+
+		default:
+			// \note Integer access is not supported for packed floating-point formats.
+			DE_ASSERT(false);
+			return IVec4(0, 0, 0, 1);
+	}
+}
+
+template <TextureFormat::ChannelType Type>
+inline void writePackedPixelFloat (deUint8* pixelPtr, TextureFormat::ChannelOrder order, const Vec4& color)
+{
+	switch (Type)
+	{
+		case TextureFormat::UNORM_SHORT_565:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 5, 6) | PN(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_555:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 10, 5) | PN(color[1], 5, 5) | PN(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_4444:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 12, 4) | PN(color[1], 8, 4) | PN(color[2], 4, 4) | PN(color[3], 0, 4));	break;
+		case TextureFormat::UNORM_SHORT_5551:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 6, 5) | PN(color[2], 1, 5) | PN(color[3], 0, 1));	break;
+		case TextureFormat::UNORM_INT_101010:		*((deUint32*)pixelPtr) = PN(color[0], 22, 10) | PN(color[1], 12, 10) | PN(color[2], 2, 10);									break;
+		case TextureFormat::UNORM_INT_1010102_REV:	*((deUint32*)pixelPtr) = PN(color[0],  0, 10) | PN(color[1], 10, 10) | PN(color[2], 20, 10) | PN(color[3], 30, 2);			break;
+
+		case TextureFormat::UNSIGNED_INT_1010102_REV:
+		{
+			const UVec4 u = color.cast<deUint32>();
+			*((deUint32*)pixelPtr) = PU(u[0], 0, 10) | PU(u[1], 10, 10) | PU(u[2], 20, 10) | PU(u[3], 30, 2);
+			break;
+		}
+
+		case TextureFormat::UNSIGNED_INT_11F_11F_10F_REV:
+			*((deUint32*)pixelPtr) = Float11(color[0]).bits() | (Float11(color[1]).bits() << 11) | (Float10(color[2]).bits() << 22);
+			break;
+
+		case TextureFormat::UNSIGNED_INT_999_E5_REV:
+			*((deUint32*)pixelPtr) = packRGB999E5(color);
+			break;
+
+		case TextureFormat::UNSIGNED_INT_24_8:
+			switch (order)
+			{
+				case TextureFormat::D:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24);									break;
+				case TextureFormat::S:		*((deUint32*)pixelPtr) = PN(color[3], 8, 24);									break;
+				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);	break;
+				default:
+					DE_ASSERT(false);
+			}
+			break;
+
+		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
+			DE_ASSERT(order == TextureFormat::DS);
+			*((float*)pixelPtr)			= color[0];
+			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
+			break;
+
+		default:
+			DE_ASSERT(false);
+	}
+}
+
+template <TextureFormat::ChannelType Type>
+inline void writePackedPixelInt (deUint8* pixelPtr, TextureFormat::ChannelOrder order, const IVec4& color)
+{
+	switch (Type)
+	{
+		case TextureFormat::UNORM_SHORT_565:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 5, 6) | PU(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_555:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 10, 5) | PU(color[1], 5, 5) | PU(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_4444:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 12, 4) | PU(color[1], 8, 4) | PU(color[2], 4, 4) | PU(color[3], 0, 4));	break;
+		case TextureFormat::UNORM_SHORT_5551:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 6, 5) | PU(color[2], 1, 5) | PU(color[3], 0, 1));	break;
+		case TextureFormat::UNORM_INT_101010:			*((deUint32*)pixelPtr) = PU(color[0], 22, 10) | PU(color[1], 12, 10) | PU(color[2], 2, 10);									break;
+		case TextureFormat::UNORM_INT_1010102_REV:		*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
+		case TextureFormat::UNSIGNED_INT_1010102_REV:	*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
+
+		case TextureFormat::UNSIGNED_INT_24_8:
+			switch (order)
+			{
+				case TextureFormat::D:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24);									break;
+				case TextureFormat::S:		*((deUint32*)pixelPtr) = PU(color[3], 8, 24);									break;
+				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);	break;
+				default:
+					DE_ASSERT(false);
+			}
+			break;
+
+		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
+			DE_ASSERT(order == TextureFormat::DS);
+			*((deUint32*)pixelPtr)		= color[0];
+			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
+			break;
+
+		default:
+			// \note Integer access is not supported for packed floating-point formats.
+			DE_ASSERT(false);
+	}
+}
+
+#undef UB16
+#undef UB32
+#undef NB16
+#undef NB32
+#undef PN
+#undef PU
+
+template <TextureFormat::ChannelType Type>
+void readPixelRowFloat (const deUint8* src, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, Vec4* dst)
+{
+	if (isPackedChannelType(Type))
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readPackedPixelFloat<Type>(src + i*pixelPitch, order);
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGBA)
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readRGBA8888Float(src + i*pixelPitch);
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGB)
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readRGB888Float(src + i*pixelPitch);
+	}
+	else
+	{
+		const IVec4 offsets = getChannelReadOffsets(order, getChannelSize(Type));
+
+		for (int i = 0; i < numPixels; i++)
+		{
+			const deUint8* const pixelPtr = src + i*pixelPitch;
+
+			for (int c = 0; c < 4; c++)
+				dst[i][c] = (offsets[c] >= 0) ? channelToFloat(pixelPtr + offsets[c], Type) : (offsets[c] == CHANNEL_OFFSET_ONE ? 1.0f : 0.0f);
+		}
+	}
+}
+
+template <TextureFormat::ChannelType Type, typename ScalarType>
+void readPixelRowInt (const deUint8* src, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, Vector<ScalarType, 4>* dst)
+{
+	if (isPackedChannelType(Type))
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readPackedPixelInt<Type>(src + i*pixelPitch, order).template cast<ScalarType>();
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGBA)
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readRGBA8888Int(src + i*pixelPitch).template cast<ScalarType>();
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGB)
+	{
+		for (int i = 0; i < numPixels; i++)
+			dst[i] = readRGB888Int(src + i*pixelPitch).template cast<ScalarType>();
+	}
+	else
+	{
+		const IVec4 offsets = getChannelReadOffsets(order, getChannelSize(Type));
+
+		for (int i = 0; i < numPixels; i++)
+		{
+			const deUint8* const pixelPtr = src + i*pixelPitch;
+
+			for (int c = 0; c < 4; c++)
+				dst[i][c] = (ScalarType)((offsets[c] >= 0) ? channelToInt(pixelPtr + offsets[c], Type) : (offsets[c] == CHANNEL_OFFSET_ONE ? 1 : 0));
+		}
+	}
+}
+
+template <TextureFormat::ChannelType Type>
+void writePixelRowFloat (deUint8* dst, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, const Vec4* src)
+{
+	if (isPackedChannelType(Type))
+	{
+		for (int i = 0; i < numPixels; i++)
+			writePackedPixelFloat<Type>(dst + i*pixelPitch, order, src[i]);
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGBA)
+	{
+		for (int i = 0; i < numPixels; i++)
+			writeRGBA8888Float(dst + i*pixelPitch, src[i]);
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGB)
+	{
+		for (int i = 0; i < numPixels; i++)
+			writeRGB888Float(dst + i*pixelPitch, src[i]);
+	}
+	else
+	{
+		const int						numChannels	= getNumUsedChannels(order);
+		const TextureSwizzle::Channel*	map			= getChannelWriteSwizzle(order).components;
+		const int						channelSize	= getChannelSize(Type);
+
+		for (int i = 0; i < numPixels; i++)
+		{
+			deUint8* const pixelPtr = dst + i*pixelPitch;
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				DE_ASSERT(deInRange32(map[c], TextureSwizzle::CHANNEL_0, TextureSwizzle::CHANNEL_3));
+				floatToChannel(pixelPtr + channelSize*c, src[i][map[c]], Type);
+			}
+		}
+	}
+}
+
+template <TextureFormat::ChannelType Type, typename ScalarType>
+void writePixelRowInt (deUint8* dst, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, const Vector<ScalarType, 4>* src)
+{
+	if (isPackedChannelType(Type))
+	{
+		for (int i = 0; i < numPixels; i++)
+			writePackedPixelInt<Type>(dst + i*pixelPitch, order, src[i].template cast<int>());
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGBA)
+	{
+		for (int i = 0; i < numPixels; i++)
+			writeRGBA8888Int(dst + i*pixelPitch, src[i].template cast<int>());
+	}
+	else if (Type == TextureFormat::UNORM_INT8 && order == TextureFormat::RGB)
+	{
+		for (int i = 0; i < numPixels; i++)
+			writeRGB888Int(dst + i*pixelPitch, src[i].template cast<int>());
+	}
+	else
+	{
+		const int						numChannels	= getNumUsedChannels(order);
+		const TextureSwizzle::Channel*	map			= getChannelWriteSwizzle(order).components;
+		const int						channelSize	= getChannelSize(Type);
+
+		for (int i = 0; i < numPixels; i++)
+		{
+			deUint8* const pixelPtr = dst + i*pixelPitch;
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				DE_ASSERT(deInRange32(map[c], TextureSwizzle::CHANNEL_0, TextureSwizzle::CHANNEL_3));
+				intToChannel(pixelPtr + channelSize*c, (int)src[i][map[c]], Type);
+			}
+		}
+	}
+}
+
+struct PixelRowConverters
+{
+	void	(*readFloat)	(const deUint8* src, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, Vec4* dst);
+	void	(*readInt)		(const deUint8* src, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, IVec4* dst);
+	void	(*readUint)		(const deUint8* src, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, UVec4* dst);
+	void	(*writeFloat)	(deUint8* dst, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, const Vec4* src);
+	void	(*writeInt)		(deUint8* dst, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, const IVec4* src);
+	void	(*writeUint)	(deUint8* dst, int pixelPitch, TextureFormat::ChannelOrder order, int numPixels, const UVec4* src);
+};
+
+const PixelRowConverters& getPixelRowConverters (TextureFormat::ChannelType type)
+{
+	// make sure this table is updated if format table is updated
+	DE_STATIC_ASSERT(TextureFormat::CHANNELTYPE_LAST == 27);
+
+#define ROW_CONVERTERS(TYPE)																\
+	{																						\
+		&readPixelRowFloat<TextureFormat::TYPE>,											\
+		&readPixelRowInt<TextureFormat::TYPE, deInt32>,										\
+		&readPixelRowInt<TextureFormat::TYPE, deUint32>,									\
+		&writePixelRowFloat<TextureFormat::TYPE>,											\
+		&writePixelRowInt<TextureFormat::TYPE, deInt32>,									\
+		&writePixelRowInt<TextureFormat::TYPE, deUint32>									\
+	}
+
+	static const PixelRowConverters s_converters[] =
+	{
+		ROW_CONVERTERS(SNORM_INT8),
+		ROW_CONVERTERS(SNORM_INT16),
+		ROW_CONVERTERS(SNORM_INT32),
+		ROW_CONVERTERS(UNORM_INT8),
+		ROW_CONVERTERS(UNORM_INT16),
+		ROW_CONVERTERS(UNORM_INT24),
+		ROW_CONVERTERS(UNORM_INT32),
+		ROW_CONVERTERS(UNORM_SHORT_565),
+		ROW_CONVERTERS(UNORM_SHORT_555),
+		ROW_CONVERTERS(UNORM_SHORT_4444),
+		ROW_CONVERTERS(UNORM_SHORT_5551),
+		ROW_CONVERTERS(UNORM_INT_101010),
+		ROW_CONVERTERS(UNORM_INT_1010102_REV),
+		ROW_CONVERTERS(UNSIGNED_INT_1010102_REV),
+		ROW_CONVERTERS(UNSIGNED_INT_11F_11F_10F_REV),
+		ROW_CONVERTERS(UNSIGNED_INT_999_E5_REV),
+		ROW_CONVERTERS(UNSIGNED_INT_24_8),
+		ROW_CONVERTERS(SIGNED_INT8),
+		ROW_CONVERTERS(SIGNED_INT16),
+		ROW_CONVERTERS(SIGNED_INT32),
+		ROW_CONVERTERS(UNSIGNED_INT8),
+		ROW_CONVERTERS(UNSIGNED_INT16),
+		ROW_CONVERTERS(UNSIGNED_INT24),
+		ROW_CONVERTERS(UNSIGNED_INT32),
+		ROW_CONVERTERS(HALF_FLOAT),
+		ROW_CONVERTERS(FLOAT),
+		ROW_CONVERTERS(FLOAT_UNSIGNED_INT_24_8_REV),
+	};
+
+#undef ROW_CONVERTERS
+
+	DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_converters) == TextureFormat::CHANNELTYPE_LAST);
+	DE_ASSERT(de::inBounds<int>(type, 0, DE_LENGTH_OF_ARRAY(s_converters)));
+
+	return s_converters[type];
+}
+
+} // anonymous
+
+void ConstPixelBufferAccess::getPixelRow (int x, int y, int z, int numPixels, Vec4* dst) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).readFloat((const deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, dst);
+}
+
+void ConstPixelBufferAccess::getPixelRowInt (int x, int y, int z, int numPixels, IVec4* dst) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).readInt((const deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, dst);
+}
+
+void ConstPixelBufferAccess::getPixelRowUint (int x, int y, int z, int numPixels, UVec4* dst) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).readUint((const deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, dst);
+}
+
+template<>
+void ConstPixelBufferAccess::getPixelRowT (int x, int y, int z, int numPixels, Vec4* dst) const
+{
+	getPixelRow(x, y, z, numPixels, dst);
+}
+
+template<>
+void ConstPixelBufferAccess::getPixelRowT (int x, int y, int z, int numPixels, IVec4* dst) const
+{
+	getPixelRowInt(x, y, z, numPixels, dst);
+}
+
+template<>
+void ConstPixelBufferAccess::getPixelRowT (int x, int y, int z, int numPixels, UVec4* dst) const
+{
+	getPixelRowUint(x, y, z, numPixels, dst);
+}
+
+void PixelBufferAccess::setPixelRow (const Vec4* src, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).writeFloat((deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, src);
+}
+
+void PixelBufferAccess::setPixelRow (const IVec4* src, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).writeInt((deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, src);
+}
+
+void PixelBufferAccess::setPixelRow (const UVec4* src, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(x >= 0 && numPixels >= 0 && x+numPixels <= m_size.x());
+	DE_ASSERT(de::inBounds(y, 0, m_size.y()));
+	DE_ASSERT(de::inBounds(z, 0, m_size.z()));
+
+	getPixelRowConverters(m_format.type).writeUint((deUint8*)getPixelPtr(x, y, z), m_pitch.x(), m_format.order, numPixels, src);
+}
+
 static inline int imod (int a, int b)
 {
 	int m = a % b;
@@ -1285,22 +1809,219 @@ static inline float execCompare (const tcu::Vec4& color, Sampler::CompareMode co
 	return res ? 1.0f : 0.0f;
 }
 
-static Vec4 sampleNearest1D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, const IVec2& offset)
+template<Sampler::WrapMode Mode>
+static int wrapCoord (int c, int size)
+{
+	return wrap(Mode, c, size);
+}
+
+template<Sampler::WrapMode Mode>
+static float unnormalizeCoord (float c, int size)
+{
+	return unnormalize(Mode, c, size);
+}
+
+template<Sampler::CompareMode Mode>
+static float compareTexel (const Vec4& color, int chanNdx, float ref, bool isFixedPoint)
+{
+	return execCompare(color, Mode, chanNdx, ref, isFixedPoint);
+}
+
+static CompiledSampler::WrapFunc getWrapFunc (Sampler::WrapMode mode)
+{
+	switch (mode)
+	{
+		case Sampler::CLAMP_TO_EDGE:		return wrapCoord<Sampler::CLAMP_TO_EDGE>;
+		case Sampler::CLAMP_TO_BORDER:		return wrapCoord<Sampler::CLAMP_TO_BORDER>;
+		case Sampler::REPEAT_GL:			return wrapCoord<Sampler::REPEAT_GL>;
+		case Sampler::REPEAT_CL:			return wrapCoord<Sampler::REPEAT_CL>;
+		case Sampler::MIRRORED_REPEAT_GL:	return wrapCoord<Sampler::MIRRORED_REPEAT_GL>;
+		case Sampler::MIRRORED_REPEAT_CL:	return wrapCoord<Sampler::MIRRORED_REPEAT_CL>;
+		default:							return wrapCoord<Sampler::WRAPMODE_LAST>; // \note Asserts on use, like wrap().
+	}
+}
+
+static CompiledSampler::UnnormalizeFunc getUnnormalizeFunc (Sampler::WrapMode mode)
+{
+	switch (mode)
+	{
+		case Sampler::CLAMP_TO_EDGE:		return unnormalizeCoord<Sampler::CLAMP_TO_EDGE>;
+		case Sampler::CLAMP_TO_BORDER:		return unnormalizeCoord<Sampler::CLAMP_TO_BORDER>;
+		case Sampler::REPEAT_GL:			return unnormalizeCoord<Sampler::REPEAT_GL>;
+		case Sampler::REPEAT_CL:			return unnormalizeCoord<Sampler::REPEAT_CL>;
+		case Sampler::MIRRORED_REPEAT_GL:	return unnormalizeCoord<Sampler::MIRRORED_REPEAT_GL>;
+		case Sampler::MIRRORED_REPEAT_CL:	return unnormalizeCoord<Sampler::MIRRORED_REPEAT_CL>;
+		default:							return unnormalizeCoord<Sampler::WRAPMODE_LAST>;
+	}
+}
+
+static CompiledSampler::CompareFunc getCompareFunc (Sampler::CompareMode mode)
+{
+	switch (mode)
+	{
+		case Sampler::COMPAREMODE_LESS:				return compareTexel<Sampler::COMPAREMODE_LESS>;
+		case Sampler::COMPAREMODE_LESS_OR_EQUAL:	return compareTexel<Sampler::COMPAREMODE_LESS_OR_EQUAL>;
+		case Sampler::COMPAREMODE_GREATER:			return compareTexel<Sampler::COMPAREMODE_GREATER>;
+		case Sampler::COMPAREMODE_GREATER_OR_EQUAL:	return compareTexel<Sampler::COMPAREMODE_GREATER_OR_EQUAL>;
+		case Sampler::COMPAREMODE_EQUAL:			return compareTexel<Sampler::COMPAREMODE_EQUAL>;
+		case Sampler::COMPAREMODE_NOT_EQUAL:		return compareTexel<Sampler::COMPAREMODE_NOT_EQUAL>;
+		case Sampler::COMPAREMODE_ALWAYS:			return compareTexel<Sampler::COMPAREMODE_ALWAYS>;
+		case Sampler::COMPAREMODE_NEVER:			return compareTexel<Sampler::COMPAREMODE_NEVER>;
+		default:									return compareTexel<Sampler::COMPAREMODE_LAST>; // \note Asserts on use, like execCompare().
+	}
+}
+
+static inline bool usesBorderColor (const Sampler& sampler)
+{
+	return sampler.wrapS == Sampler::CLAMP_TO_BORDER ||
+		   sampler.wrapT == Sampler::CLAMP_TO_BORDER ||
+		   sampler.wrapR == Sampler::CLAMP_TO_BORDER;
+}
+
+CompiledSampler::CompiledSampler (void)
+	: m_sampler				()
+	, m_format				()
+	, m_compare				(getCompareFunc(Sampler::COMPAREMODE_NONE))
+	, m_isSRGB				(false)
+	, m_isFixedPointDepth	(false)
+	, m_hasBorderColor		(false)
+	, m_borderColor			(0.0f)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_wrap[axis]		= getWrapFunc(Sampler::WRAPMODE_LAST);
+		m_unnormalize[axis]	= getUnnormalizeFunc(Sampler::WRAPMODE_LAST);
+	}
+}
+
+CompiledSampler::CompiledSampler (const Sampler& sampler, const TextureFormat& format)
+	: m_sampler				(sampler)
+	, m_format				(format)
+	, m_compare				(getCompareFunc(sampler.compare))
+	, m_isSRGB				(isSRGB(format))
+	, m_isFixedPointDepth	(false)
+	, m_hasBorderColor		(false)
+	, m_borderColor			(0.0f)
+{
+	const Sampler::WrapMode wrapModes[] = { sampler.wrapS, sampler.wrapT, sampler.wrapR };
+
+	for (int axis = 0; axis < DE_LENGTH_OF_ARRAY(wrapModes); axis++)
+	{
+		m_wrap[axis]		= getWrapFunc(wrapModes[axis]);
+		m_unnormalize[axis]	= getUnnormalizeFunc(wrapModes[axis]);
+	}
+
+	// \note Format properties are resolved only when the sampler can use them to avoid asserting on formats that don't support them.
+	if (sampler.compare != Sampler::COMPAREMODE_NONE && (format.order == TextureFormat::D || format.order == TextureFormat::DS))
+		m_isFixedPointDepth = isFixedPointDepthTextureFormat(format);
+
+	if (usesBorderColor(sampler) && !isCombinedDepthStencilType(format.type))
+	{
+		m_hasBorderColor	= true;
+		m_borderColor		= lookupBorder(format, sampler);
+	}
+}
+
+// Sampler state accessors for the sampling functions below. Sampling
+// functions are instantiated for both; DynamicSamplerState resolves wrap
+// modes and format properties from a Sampler at every lookup while
+// CompiledSamplerState uses the ones resolved by a CompiledSampler.
+
+class DynamicSamplerState
+{
+public:
+	explicit		DynamicSamplerState		(const Sampler& sampler) : m_sampler(sampler) {}
+
+	const Sampler&	getSampler				(void) const												{ return m_sampler;									}
+
+	int				wrapS					(int c, int size) const										{ return wrap(m_sampler.wrapS, c, size);			}
+	int				wrapT					(int c, int size) const										{ return wrap(m_sampler.wrapT, c, size);			}
+	int				wrapR					(int c, int size) const										{ return wrap(m_sampler.wrapR, c, size);			}
+
+	float			unnormalizeS			(float c, int size) const									{ return unnormalize(m_sampler.wrapS, c, size);		}
+	float			unnormalizeT			(float c, int size) const									{ return unnormalize(m_sampler.wrapT, c, size);		}
+	float			unnormalizeR			(float c, int size) const									{ return unnormalize(m_sampler.wrapR, c, size);		}
+
+	Vec4			lookup					(const ConstPixelBufferAccess& access, int i, int j, int k) const	{ return tcu::lookup(access, i, j, k);		}
+	Vec4			lookupBorder			(const TextureFormat& format) const							{ return tcu::lookupBorder(format, m_sampler);		}
+	bool			isFixedPointDepth		(const TextureFormat& format) const							{ return isFixedPointDepthTextureFormat(format);	}
+
+	float			compare					(const Vec4& color, int chanNdx, float ref, bool isFixedPoint) const
+	{
+		return execCompare(color, m_sampler.compare, chanNdx, ref, isFixedPoint);
+	}
+
+private:
+	const Sampler&	m_sampler;
+};
+
+class CompiledSamplerState
+{
+public:
+	explicit		CompiledSamplerState	(const CompiledSampler& sampler) : m_sampler(sampler) {}
+
+	const Sampler&	getSampler				(void) const												{ return m_sampler.m_sampler;						}
+
+	int				wrapS					(int c, int size) const										{ return m_sampler.m_wrap[0](c, size);				}
+	int				wrapT					(int c, int size) const										{ return m_sampler.m_wrap[1](c, size);				}
+	int				wrapR					(int c, int size) const										{ return m_sampler.m_wrap[2](c, size);				}
+
+	float			unnormalizeS			(float c, int size) const									{ return m_sampler.m_unnormalize[0](c, size);		}
+	float			unnormalizeT			(float c, int size) const									{ return m_sampler.m_unnormalize[1](c, size);		}
+	float			unnormalizeR			(float c, int size) const									{ return m_sampler.m_unnormalize[2](c, size);		}
+
+	Vec4			lookup					(const ConstPixelBufferAccess& access, int i, int j, int k) const
+	{
+		DE_ASSERT(access.getFormat() == m_sampler.m_format);
+
+		const Vec4 p = access.getPixel(i, j, k);
+		return m_sampler.m_isSRGB ? sRGBToLinear(p) : p;
+	}
+
+	Vec4			lookupBorder			(const TextureFormat& format) const
+	{
+		// "lookup" for a combined format does not make sense, disallow
+		DE_ASSERT(format == m_sampler.m_format && m_sampler.m_hasBorderColor);
+		DE_UNREF(format);
+
+		return m_sampler.m_borderColor;
+	}
+
+	bool			isFixedPointDepth		(const TextureFormat& format) const
+	{
+		DE_ASSERT(format == m_sampler.m_format);
+		DE_UNREF(format);
+
+		return m_sampler.m_isFixedPointDepth;
+	}
+
+	float			compare					(const Vec4& color, int chanNdx, float ref, bool isFixedPoint) const
+	{
+		return m_sampler.m_compare(color, chanNdx, ref, isFixedPoint);
+	}
+
+private:
+	const CompiledSampler&	m_sampler;
+};
+
+template<class SamplerState>
+static Vec4 sampleNearest1D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, const IVec2& offset)
 {
 	int width	= access.getWidth();
 
 	int x = deFloorFloatToInt32(u)+offset.x();
 
 	// Check for CLAMP_TO_BORDER.
-	if (sampler.wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width))
-		return lookupBorder(access.getFormat(), sampler);
+	if (state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width))
+		return state.lookupBorder(access.getFormat());
 
-	int i = wrap(sampler.wrapS, x, width);
+	int i = state.wrapS(x, width);
 
-	return lookup(access, i, offset.y(), 0);
+	return state.lookup(access, i, offset.y(), 0);
 }
 
-static Vec4 sampleNearest2D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, float v, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleNearest2D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, float v, const IVec3& offset)
 {
 	int width	= access.getWidth();
 	int height	= access.getHeight();
@@ -1309,17 +2030,18 @@ static Vec4 sampleNearest2D (const ConstPixelBufferAccess& access, const Sampler
 	int y = deFloorFloatToInt32(v)+offset.y();
 
 	// Check for CLAMP_TO_BORDER.
-	if ((sampler.wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width)) ||
-		(sampler.wrapT == Sampler::CLAMP_TO_BORDER && !deInBounds32(y, 0, height)))
-		return lookupBorder(access.getFormat(), sampler);
+	if ((state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width)) ||
+		(state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !deInBounds32(y, 0, height)))
+		return state.lookupBorder(access.getFormat());
 
-	int i = wrap(sampler.wrapS, x, width);
-	int j = wrap(sampler.wrapT, y, height);
+	int i = state.wrapS(x, width);
+	int j = state.wrapT(y, height);
 
-	return lookup(access, i, j, offset.z());
+	return state.lookup(access, i, j, offset.z());
 }
 
-static Vec4 sampleNearest3D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, float v, float w, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleNearest3D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, float v, float w, const IVec3& offset)
 {
 	int width	= access.getWidth();
 	int height	= access.getHeight();
@@ -1330,42 +2052,44 @@ static Vec4 sampleNearest3D (const ConstPixelBufferAccess& access, const Sampler
 	int z = deFloorFloatToInt32(w)+offset.z();
 
 	// Check for CLAMP_TO_BORDER.
-	if ((sampler.wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width))	||
-		(sampler.wrapT == Sampler::CLAMP_TO_BORDER && !deInBounds32(y, 0, height))	||
-		(sampler.wrapR == Sampler::CLAMP_TO_BORDER && !deInBounds32(z, 0, depth)))
-		return lookupBorder(access.getFormat(), sampler);
+	if ((state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x, 0, width))	||
+		(state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !deInBounds32(y, 0, height))	||
+		(state.getSampler().wrapR == Sampler::CLAMP_TO_BORDER && !deInBounds32(z, 0, depth)))
+		return state.lookupBorder(access.getFormat());
 
-	int i = wrap(sampler.wrapS, x, width);
-	int j = wrap(sampler.wrapT, y, height);
-	int k = wrap(sampler.wrapR, z, depth);
+	int i = state.wrapS(x, width);
+	int j = state.wrapT(y, height);
+	int k = state.wrapR(z, depth);
 
-	return lookup(access, i, j, k);
+	return state.lookup(access, i, j, k);
 }
 
-static Vec4 sampleLinear1D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, const IVec2& offset)
+template<class SamplerState>
+static Vec4 sampleLinear1D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, const IVec2& offset)
 {
 	int w = access.getWidth();
 
 	int x0 = deFloorFloatToInt32(u-0.5f)+offset.x();
 	int x1 = x0+1;
 
-	int i0 = wrap(sampler.wrapS, x0, w);
-	int i1 = wrap(sampler.wrapS, x1, w);
+	int i0 = state.wrapS(x0, w);
+	int i1 = state.wrapS(x1, w);
 
 	float a = deFloatFrac(u-0.5f);
 
-	bool i0UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
-	bool i1UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
+	bool i0UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
+	bool i1UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
 
 	// Border color for out-of-range coordinates if using CLAMP_TO_BORDER, otherwise execute lookups.
-	Vec4 p0 = i0UseBorder ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, offset.y(), 0);
-	Vec4 p1 = i1UseBorder ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, offset.y(), 0);
+	Vec4 p0 = i0UseBorder ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, offset.y(), 0);
+	Vec4 p1 = i1UseBorder ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, offset.y(), 0);
 
 	// Interpolate.
 	return p0 * (1.0f - a) + p1 * a;
 }
 
-static Vec4 sampleLinear2D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, float v, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleLinear2D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, float v, const IVec3& offset)
 {
 	int w = access.getWidth();
 	int h = access.getHeight();
@@ -1375,24 +2099,24 @@ static Vec4 sampleLinear2D (const ConstPixelBufferAccess& access, const Sampler&
 	int y0 = deFloorFloatToInt32(v-0.5f)+offset.y();
 	int y1 = y0+1;
 
-	int i0 = wrap(sampler.wrapS, x0, w);
-	int i1 = wrap(sampler.wrapS, x1, w);
-	int j0 = wrap(sampler.wrapT, y0, h);
-	int j1 = wrap(sampler.wrapT, y1, h);
+	int i0 = state.wrapS(x0, w);
+	int i1 = state.wrapS(x1, w);
+	int j0 = state.wrapT(y0, h);
+	int j1 = state.wrapT(y1, h);
 
 	float a = deFloatFrac(u-0.5f);
 	float b = deFloatFrac(v-0.5f);
 
-	bool i0UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
-	bool i1UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
-	bool j0UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, h);
-	bool j1UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, h);
+	bool i0UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
+	bool i1UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
+	bool j0UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, h);
+	bool j1UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, h);
 
 	// Border color for out-of-range coordinates if using CLAMP_TO_BORDER, otherwise execute lookups.
-	Vec4 p00 = (i0UseBorder || j0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j0, offset.z());
-	Vec4 p10 = (i1UseBorder || j0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j0, offset.z());
-	Vec4 p01 = (i0UseBorder || j1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j1, offset.z());
-	Vec4 p11 = (i1UseBorder || j1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j1, offset.z());
+	Vec4 p00 = (i0UseBorder || j0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j0, offset.z());
+	Vec4 p10 = (i1UseBorder || j0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j0, offset.z());
+	Vec4 p01 = (i0UseBorder || j1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j1, offset.z());
+	Vec4 p11 = (i1UseBorder || j1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j1, offset.z());
 
 	// Interpolate.
 	return (p00*(1.0f-a)*(1.0f-b)) +
@@ -1401,34 +2125,36 @@ static Vec4 sampleLinear2D (const ConstPixelBufferAccess& access, const Sampler&
 		   (p11*(     a)*(     b));
 }
 
-static float sampleLinear1DCompare (const ConstPixelBufferAccess& access, const Sampler& sampler, float ref, float u, const IVec2& offset, bool isFixedPointDepthFormat)
+template<class SamplerState>
+static float sampleLinear1DCompare (const ConstPixelBufferAccess& access, const SamplerState& state, float ref, float u, const IVec2& offset, bool isFixedPointDepthFormat)
 {
 	int w = access.getWidth();
 
 	int x0 = deFloorFloatToInt32(u-0.5f)+offset.x();
 	int x1 = x0+1;
 
-	int i0 = wrap(sampler.wrapS, x0, w);
-	int i1 = wrap(sampler.wrapS, x1, w);
+	int i0 = state.wrapS(x0, w);
+	int i1 = state.wrapS(x1, w);
 
 	float a = deFloatFrac(u-0.5f);
 
-	bool i0UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
-	bool i1UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
+	bool i0UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
+	bool i1UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
 
 	// Border color for out-of-range coordinates if using CLAMP_TO_BORDER, otherwise execute lookups.
-	Vec4 p0Clr = i0UseBorder  ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, offset.y(), 0);
-	Vec4 p1Clr = i1UseBorder  ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, offset.y(), 0);
+	Vec4 p0Clr = i0UseBorder  ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, offset.y(), 0);
+	Vec4 p1Clr = i1UseBorder  ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, offset.y(), 0);
 
 	// Execute comparisons.
-	float p0 = execCompare(p0Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
-	float p1 = execCompare(p1Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
+	float p0 = state.compare(p0Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
+	float p1 = state.compare(p1Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
 
 	// Interpolate.
 	return (p0 * (1.0f - a)) + (p1 * a);
 }
 
-static float sampleLinear2DCompare (const ConstPixelBufferAccess& access, const Sampler& sampler, float ref, float u, float v, const IVec3& offset, bool isFixedPointDepthFormat)
+template<class SamplerState>
+static float sampleLinear2DCompare (const ConstPixelBufferAccess& access, const SamplerState& state, float ref, float u, float v, const IVec3& offset, bool isFixedPointDepthFormat)
 {
 	int w = access.getWidth();
 	int h = access.getHeight();
@@ -1438,30 +2164,30 @@ static float sampleLinear2DCompare (const ConstPixelBufferAccess& access, const
 	int y0 = deFloorFloatToInt32(v-0.5f)+offset.y();
 	int y1 = y0+1;
 
-	int i0 = wrap(sampler.wrapS, x0, w);
-	int i1 = wrap(sampler.wrapS, x1, w);
-	int j0 = wrap(sampler.wrapT, y0, h);
-	int j1 = wrap(sampler.wrapT, y1, h);
+	int i0 = state.wrapS(x0, w);
+	int i1 = state.wrapS(x1, w);
+	int j0 = state.wrapT(y0, h);
+	int j1 = state.wrapT(y1, h);
 
 	float a = deFloatFrac(u-0.5f);
 	float b = deFloatFrac(v-0.5f);
 
-	bool i0UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
-	bool i1UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
-	bool j0UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, h);
-	bool j1UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, h);
+	bool i0UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, w);
+	bool i1UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, w);
+	bool j0UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, h);
+	bool j1UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, h);
 
 	// Border color for out-of-range coordinates if using CLAMP_TO_BORDER, otherwise execute lookups.
-	Vec4 p00Clr = (i0UseBorder || j0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j0, offset.z());
-	Vec4 p10Clr = (i1UseBorder || j0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j0, offset.z());
-	Vec4 p01Clr = (i0UseBorder || j1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j1, offset.z());
-	Vec4 p11Clr = (i1UseBorder || j1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j1, offset.z());
+	Vec4 p00Clr = (i0UseBorder || j0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j0, offset.z());
+	Vec4 p10Clr = (i1UseBorder || j0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j0, offset.z());
+	Vec4 p01Clr = (i0UseBorder || j1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j1, offset.z());
+	Vec4 p11Clr = (i1UseBorder || j1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j1, offset.z());
 
 	// Execute comparisons.
-	float p00 = execCompare(p00Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
-	float p10 = execCompare(p10Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
-	float p01 = execCompare(p01Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
-	float p11 = execCompare(p11Clr, sampler.compare, sampler.compareChannel, ref, isFixedPointDepthFormat);
+	float p00 = state.compare(p00Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
+	float p10 = state.compare(p10Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
+	float p01 = state.compare(p01Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
+	float p11 = state.compare(p11Clr, state.getSampler().compareChannel, ref, isFixedPointDepthFormat);
 
 	// Interpolate.
 	return (p00*(1.0f-a)*(1.0f-b)) +
@@ -1470,7 +2196,8 @@ static float sampleLinear2DCompare (const ConstPixelBufferAccess& access, const
 		   (p11*(     a)*(     b));
 }
 
-static Vec4 sampleLinear3D (const ConstPixelBufferAccess& access, const Sampler& sampler, float u, float v, float w, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleLinear3D (const ConstPixelBufferAccess& access, const SamplerState& state, float u, float v, float w, const IVec3& offset)
 {
 	int width	= access.getWidth();
 	int height	= access.getHeight();
@@ -1483,33 +2210,33 @@ static Vec4 sampleLinear3D (const ConstPixelBufferAccess& access, const Sampler&
 	int z0 = deFloorFloatToInt32(w-0.5f)+offset.z();
 	int z1 = z0+1;
 
-	int i0 = wrap(sampler.wrapS, x0, width);
-	int i1 = wrap(sampler.wrapS, x1, width);
-	int j0 = wrap(sampler.wrapT, y0, height);
-	int j1 = wrap(sampler.wrapT, y1, height);
-	int k0 = wrap(sampler.wrapR, z0, depth);
-	int k1 = wrap(sampler.wrapR, z1, depth);
+	int i0 = state.wrapS(x0, width);
+	int i1 = state.wrapS(x1, width);
+	int j0 = state.wrapT(y0, height);
+	int j1 = state.wrapT(y1, height);
+	int k0 = state.wrapR(z0, depth);
+	int k1 = state.wrapR(z1, depth);
 
 	float a = deFloatFrac(u-0.5f);
 	float b = deFloatFrac(v-0.5f);
 	float c = deFloatFrac(w-0.5f);
 
-	bool i0UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, width);
-	bool i1UseBorder = sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, width);
-	bool j0UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, height);
-	bool j1UseBorder = sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, height);
-	bool k0UseBorder = sampler.wrapR == Sampler::CLAMP_TO_BORDER && !de::inBounds(k0, 0, depth);
-	bool k1UseBorder = sampler.wrapR == Sampler::CLAMP_TO_BORDER && !de::inBounds(k1, 0, depth);
+	bool i0UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0, 0, width);
+	bool i1UseBorder = state.getSampler().wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1, 0, width);
+	bool j0UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0, 0, height);
+	bool j1UseBorder = state.getSampler().wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1, 0, height);
+	bool k0UseBorder = state.getSampler().wrapR == Sampler::CLAMP_TO_BORDER && !de::inBounds(k0, 0, depth);
+	bool k1UseBorder = state.getSampler().wrapR == Sampler::CLAMP_TO_BORDER && !de::inBounds(k1, 0, depth);
 
 	// Border color for out-of-range coordinates if using CLAMP_TO_BORDER, otherwise execute lookups.
-	Vec4 p000 = (i0UseBorder || j0UseBorder || k0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j0, k0);
-	Vec4 p100 = (i1UseBorder || j0UseBorder || k0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j0, k0);
-	Vec4 p010 = (i0UseBorder || j1UseBorder || k0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j1, k0);
-	Vec4 p110 = (i1UseBorder || j1UseBorder || k0UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j1, k0);
-	Vec4 p001 = (i0UseBorder || j0UseBorder || k1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j0, k1);
-	Vec4 p101 = (i1UseBorder || j0UseBorder || k1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j0, k1);
-	Vec4 p011 = (i0UseBorder || j1UseBorder || k1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i0, j1, k1);
-	Vec4 p111 = (i1UseBorder || j1UseBorder || k1UseBorder) ? lookupBorder(access.getFormat(), sampler) : lookup(access, i1, j1, k1);
+	Vec4 p000 = (i0UseBorder || j0UseBorder || k0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j0, k0);
+	Vec4 p100 = (i1UseBorder || j0UseBorder || k0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j0, k0);
+	Vec4 p010 = (i0UseBorder || j1UseBorder || k0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j1, k0);
+	Vec4 p110 = (i1UseBorder || j1UseBorder || k0UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j1, k0);
+	Vec4 p001 = (i0UseBorder || j0UseBorder || k1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j0, k1);
+	Vec4 p101 = (i1UseBorder || j0UseBorder || k1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j0, k1);
+	Vec4 p011 = (i0UseBorder || j1UseBorder || k1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i0, j1, k1);
+	Vec4 p111 = (i1UseBorder || j1UseBorder || k1UseBorder) ? state.lookupBorder(access.getFormat()) : state.lookup(access, i1, j1, k1);
 
 	// Interpolate.
 	return (p000*(1.0f-a)*(1.0f-b)*(1.0f-c)) +
@@ -1522,153 +2249,183 @@ static Vec4 sampleLinear3D (const ConstPixelBufferAccess& access, const Sampler&
 		   (p111*(     a)*(     b)*(     c));
 }
 
-Vec4 ConstPixelBufferAccess::sample1D (const Sampler& sampler, Sampler::FilterMode filter, float s, int level) const
-{
-	// check selected layer exists
-	DE_ASSERT(de::inBounds(level, 0, m_size.y()));
-
-	return sample1DOffset(sampler, filter, s, tcu::IVec2(0, level));
-}
-
-Vec4 ConstPixelBufferAccess::sample2D (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, int depth) const
-{
-	// check selected layer exists
-	DE_ASSERT(de::inBounds(depth, 0, m_size.z()));
-
-	return sample2DOffset(sampler, filter, s, t, tcu::IVec3(0, 0, depth));
-}
-
-Vec4 ConstPixelBufferAccess::sample3D (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, float r) const
-{
-	return sample3DOffset(sampler, filter, s, t, r, tcu::IVec3(0, 0, 0));
-}
-
-Vec4 ConstPixelBufferAccess::sample1DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, const IVec2& offset) const
+template<class SamplerState>
+static Vec4 sampleLevel1D (const ConstPixelBufferAccess& access, const SamplerState& state, Sampler::FilterMode filter, float s, const IVec2& offset)
 {
 	// check selected layer exists
 	// \note offset.x is X offset, offset.y is the selected layer
-	DE_ASSERT(de::inBounds(offset.y(), 0, m_size.y()));
+	DE_ASSERT(de::inBounds(offset.y(), 0, access.getHeight()));
 
 	// Non-normalized coordinates.
 	float u = s;
 
-	if (sampler.normalizedCoords)
-		u = unnormalize(sampler.wrapS, s, m_size.x());
+	if (state.getSampler().normalizedCoords)
+		u = state.unnormalizeS(s, access.getWidth());
 
 	switch (filter)
 	{
-		case Sampler::NEAREST:	return sampleNearest1D	(*this, sampler, u, offset);
-		case Sampler::LINEAR:	return sampleLinear1D	(*this, sampler, u, offset);
+		case Sampler::NEAREST:	return sampleNearest1D	(access, state, u, offset);
+		case Sampler::LINEAR:	return sampleLinear1D	(access, state, u, offset);
 		default:
 			DE_ASSERT(DE_FALSE);
 			return Vec4(0.0f);
 	}
 }
 
-Vec4 ConstPixelBufferAccess::sample2DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, const IVec3& offset) const
+template<class SamplerState>
+static Vec4 sampleLevel2D (const ConstPixelBufferAccess& access, const SamplerState& state, Sampler::FilterMode filter, float s, float t, const IVec3& offset)
 {
 	// check selected layer exists
 	// \note offset.xy is the XY offset, offset.z is the selected layer
-	DE_ASSERT(de::inBounds(offset.z(), 0, m_size.z()));
+	DE_ASSERT(de::inBounds(offset.z(), 0, access.getDepth()));
 
 	// Non-normalized coordinates.
 	float u = s;
 	float v = t;
 
-	if (sampler.normalizedCoords)
+	if (state.getSampler().normalizedCoords)
 	{
-		u = unnormalize(sampler.wrapS, s, m_size.x());
-		v = unnormalize(sampler.wrapT, t, m_size.y());
+		u = state.unnormalizeS(s, access.getWidth());
+		v = state.unnormalizeT(t, access.getHeight());
 	}
 
 	switch (filter)
 	{
-		case Sampler::NEAREST:	return sampleNearest2D	(*this, sampler, u, v, offset);
-		case Sampler::LINEAR:	return sampleLinear2D	(*this, sampler, u, v, offset);
+		case Sampler::NEAREST:	return sampleNearest2D	(access, state, u, v, offset);
+		case Sampler::LINEAR:	return sampleLinear2D	(access, state, u, v, offset);
 		default:
 			DE_ASSERT(DE_FALSE);
 			return Vec4(0.0f);
 	}
 }
 
-Vec4 ConstPixelBufferAccess::sample3DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, float r, const IVec3& offset) const
+template<class SamplerState>
+static Vec4 sampleLevel3D (const ConstPixelBufferAccess& access, const SamplerState& state, Sampler::FilterMode filter, float s, float t, float r, const IVec3& offset)
 {
 	// Non-normalized coordinates.
 	float u = s;
 	float v = t;
 	float w = r;
 
-	if (sampler.normalizedCoords)
+	if (state.getSampler().normalizedCoords)
 	{
-		u = unnormalize(sampler.wrapS, s, m_size.x());
-		v = unnormalize(sampler.wrapT, t, m_size.y());
-		w = unnormalize(sampler.wrapR, r, m_size.z());
+		u = state.unnormalizeS(s, access.getWidth());
+		v = state.unnormalizeT(t, access.getHeight());
+		w = state.unnormalizeR(r, access.getDepth());
 	}
 
 	switch (filter)
 	{
-		case Sampler::NEAREST:	return sampleNearest3D	(*this, sampler, u, v, w, offset);
-		case Sampler::LINEAR:	return sampleLinear3D	(*this, sampler, u, v, w, offset);
+		case Sampler::NEAREST:	return sampleNearest3D	(access, state, u, v, w, offset);
+		case Sampler::LINEAR:	return sampleLinear3D	(access, state, u, v, w, offset);
 		default:
 			DE_ASSERT(DE_FALSE);
 			return Vec4(0.0f);
 	}
 }
 
-float ConstPixelBufferAccess::sample1DCompare (const Sampler& sampler, Sampler::FilterMode filter, float ref, float s, const IVec2& offset) const
+template<class SamplerState>
+static float sampleLevel1DCompare (const ConstPixelBufferAccess& access, const SamplerState& state, Sampler::FilterMode filter, float ref, float s, const IVec2& offset)
 {
 	// check selected layer exists
 	// \note offset.x is X offset, offset.y is the selected layer
-	DE_ASSERT(de::inBounds(offset.y(), 0, m_size.y()));
+	DE_ASSERT(de::inBounds(offset.y(), 0, access.getHeight()));
 
 	// Format information for comparison function
-	const bool isFixedPointDepth = isFixedPointDepthTextureFormat(m_format);
+	const bool isFixedPointDepth = state.isFixedPointDepth(access.getFormat());
 
 	// Non-normalized coordinates.
 	float u = s;
 
-	if (sampler.normalizedCoords)
-		u = unnormalize(sampler.wrapS, s, m_size.x());
+	if (state.getSampler().normalizedCoords)
+		u = state.unnormalizeS(s, access.getWidth());
 
 	switch (filter)
 	{
-		case Sampler::NEAREST:	return execCompare(sampleNearest1D(*this, sampler, u, offset), sampler.compare, sampler.compareChannel, ref, isFixedPointDepth);
-		case Sampler::LINEAR:	return sampleLinear1DCompare(*this, sampler, ref, u, offset, isFixedPointDepth);
+		case Sampler::NEAREST:	return state.compare(sampleNearest1D(access, state, u, offset), state.getSampler().compareChannel, ref, isFixedPointDepth);
+		case Sampler::LINEAR:	return sampleLinear1DCompare(access, state, ref, u, offset, isFixedPointDepth);
 		default:
 			DE_ASSERT(DE_FALSE);
 			return 0.0f;
 	}
 }
 
-float ConstPixelBufferAccess::sample2DCompare (const Sampler& sampler, Sampler::FilterMode filter, float ref, float s, float t, const IVec3& offset) const
+template<class SamplerState>
+static float sampleLevel2DCompare (const ConstPixelBufferAccess& access, const SamplerState& state, Sampler::FilterMode filter, float ref, float s, float t, const IVec3& offset)
 {
 	// check selected layer exists
 	// \note offset.xy is XY offset, offset.z is the selected layer
-	DE_ASSERT(de::inBounds(offset.z(), 0, m_size.z()));
+	DE_ASSERT(de::inBounds(offset.z(), 0, access.getDepth()));
 
 	// Format information for comparison function
-	const bool isFixedPointDepth = isFixedPointDepthTextureFormat(m_format);
+	const bool isFixedPointDepth = state.isFixedPointDepth(access.getFormat());
 
 	// Non-normalized coordinates.
 	float u = s;
 	float v = t;
 
-	if (sampler.normalizedCoords)
+	if (state.getSampler().normalizedCoords)
 	{
-		u = unnormalize(sampler.wrapS, s, m_size.x());
-		v = unnormalize(sampler.wrapT, t, m_size.y());
+		u = state.unnormalizeS(s, access.getWidth());
+		v = state.unnormalizeT(t, access.getHeight());
 	}
 
 	switch (filter)
 	{
-		case Sampler::NEAREST:	return execCompare(sampleNearest2D(*this, sampler, u, v, offset), sampler.compare, sampler.compareChannel, ref, isFixedPointDepth);
-		case Sampler::LINEAR:	return sampleLinear2DCompare(*this, sampler, ref, u, v, offset, isFixedPointDepth);
+		case Sampler::NEAREST:	return state.compare(sampleNearest2D(access, state, u, v, offset), state.getSampler().compareChannel, ref, isFixedPointDepth);
+		case Sampler::LINEAR:	return sampleLinear2DCompare(access, state, ref, u, v, offset, isFixedPointDepth);
 		default:
 			DE_ASSERT(DE_FALSE);
 			return 0.0f;
 	}
 }
 
+Vec4 ConstPixelBufferAccess::sample1D (const Sampler& sampler, Sampler::FilterMode filter, float s, int level) const
+{
+	// check selected layer exists
+	DE_ASSERT(de::inBounds(level, 0, m_size.y()));
+
+	return sample1DOffset(sampler, filter, s, tcu::IVec2(0, level));
+}
+
+Vec4 ConstPixelBufferAccess::sample2D (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, int depth) const
+{
+	// check selected layer exists
+	DE_ASSERT(de::inBounds(depth, 0, m_size.z()));
+
+	return sample2DOffset(sampler, filter, s, t, tcu::IVec3(0, 0, depth));
+}
+
+Vec4 ConstPixelBufferAccess::sample3D (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, float r) const
+{
+	return sample3DOffset(sampler, filter, s, t, r, tcu::IVec3(0, 0, 0));
+}
+
+Vec4 ConstPixelBufferAccess::sample1DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, const IVec2& offset) const
+{
+	return sampleLevel1D(*this, DynamicSamplerState(sampler), filter, s, offset);
+}
+
+Vec4 ConstPixelBufferAccess::sample2DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, const IVec3& offset) const
+{
+	return sampleLevel2D(*this, DynamicSamplerState(sampler), filter, s, t, offset);
+}
+
+Vec4 ConstPixelBufferAccess::sample3DOffset (const Sampler& sampler, Sampler::FilterMode filter, float s, float t, float r, const IVec3& offset) const
+{
+	return sampleLevel3D(*this, DynamicSamplerState(sampler), filter, s, t, r, offset);
+}
+
+float ConstPixelBufferAccess::sample1DCompare (const Sampler& sampler, Sampler::FilterMode filter, float ref, float s, const IVec2& offset) const
+{
+	return sampleLevel1DCompare(*this, DynamicSamplerState(sampler), filter, ref, s, offset);
+}
+
+float ConstPixelBufferAccess::sample2DCompare (const Sampler& sampler, Sampler::FilterMode filter, float ref, float s, float t, const IVec3& offset) const
+{
+	return sampleLevel2DCompare(*this, DynamicSamplerState(sampler), filter, ref, s, t, offset);
+}
+
 TextureLevel::TextureLevel (void)
 	: m_format	()
 	, m_size	(0)
@@ -1722,15 +2479,31 @@ Vec4 sampleLevelArray3D (const ConstPixelBufferAccess* levels, int numLevels, co
 	return sampleLevelArray3DOffset(levels, numLevels, sampler, s, t, r, lod, IVec3(0, 0, 0));
 }
 
-Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float lod, const IVec2& offset)
+Vec4 sampleLevelArray1D (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, int depth, float lod)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	return sampleLevelArray1DOffset(levels, numLevels, sampler, s, lod, IVec2(0, depth)); // y-offset in 1D textures is layer selector
+}
+
+Vec4 sampleLevelArray2D (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, int depth, float lod)
+{
+	return sampleLevelArray2DOffset(levels, numLevels, sampler, s, t, lod, IVec3(0, 0, depth)); // z-offset in 2D textures is layer selector
+}
+
+Vec4 sampleLevelArray3D (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float r, float lod)
+{
+	return sampleLevelArray3DOffset(levels, numLevels, sampler, s, t, r, lod, IVec3(0, 0, 0));
+}
+
+template<class SamplerState>
+static Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLevels, const SamplerState& state, float s, float lod, const IVec2& offset)
+{
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
-		case Sampler::NEAREST:	return levels[0].sample1DOffset(sampler, filterMode, s, offset);
-		case Sampler::LINEAR:	return levels[0].sample1DOffset(sampler, filterMode, s, offset);
+		case Sampler::NEAREST:	return sampleLevel1D(levels[0], state, filterMode, s, offset);
+		case Sampler::LINEAR:	return sampleLevel1D(levels[0], state, filterMode, s, offset);
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
 		case Sampler::LINEAR_MIPMAP_NEAREST:
@@ -1739,7 +2512,7 @@ Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level		= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
-			return levels[level].sample1DOffset(sampler, levelFilter, s, offset);
+			return sampleLevel1D(levels[level], state, levelFilter, s, offset);
 		}
 
 		case Sampler::NEAREST_MIPMAP_LINEAR:
@@ -1750,8 +2523,8 @@ Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level1		= de::min(maxLevel, level0 + 1);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
 			float				f			= deFloatFrac(lod);
-			tcu::Vec4			t0			= levels[level0].sample1DOffset(sampler, levelFilter, s, offset);
-			tcu::Vec4			t1			= levels[level1].sample1DOffset(sampler, levelFilter, s, offset);
+			tcu::Vec4			t0			= sampleLevel1D(levels[level0], state, levelFilter, s, offset);
+			tcu::Vec4			t1			= sampleLevel1D(levels[level1], state, levelFilter, s, offset);
 
 			return t0*(1.0f - f) + t1*f;
 		}
@@ -1762,15 +2535,16 @@ Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
-Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float lod, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLevels, const SamplerState& state, float s, float t, float lod, const IVec3& offset)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
-		case Sampler::NEAREST:	return levels[0].sample2DOffset(sampler, filterMode, s, t, offset);
-		case Sampler::LINEAR:	return levels[0].sample2DOffset(sampler, filterMode, s, t, offset);
+		case Sampler::NEAREST:	return sampleLevel2D(levels[0], state, filterMode, s, t, offset);
+		case Sampler::LINEAR:	return sampleLevel2D(levels[0], state, filterMode, s, t, offset);
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
 		case Sampler::LINEAR_MIPMAP_NEAREST:
@@ -1779,7 +2553,7 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level		= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
-			return levels[level].sample2DOffset(sampler, levelFilter, s, t, offset);
+			return sampleLevel2D(levels[level], state, levelFilter, s, t, offset);
 		}
 
 		case Sampler::NEAREST_MIPMAP_LINEAR:
@@ -1790,8 +2564,8 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level1		= de::min(maxLevel, level0 + 1);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
 			float				f			= deFloatFrac(lod);
-			tcu::Vec4			t0			= levels[level0].sample2DOffset(sampler, levelFilter, s, t, offset);
-			tcu::Vec4			t1			= levels[level1].sample2DOffset(sampler, levelFilter, s, t, offset);
+			tcu::Vec4			t0			= sampleLevel2D(levels[level0], state, levelFilter, s, t, offset);
+			tcu::Vec4			t1			= sampleLevel2D(levels[level1], state, levelFilter, s, t, offset);
 
 			return t0*(1.0f - f) + t1*f;
 		}
@@ -1802,15 +2576,16 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
-Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset)
+template<class SamplerState>
+static Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const SamplerState& state, float s, float t, float r, float lod, const IVec3& offset)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
-		case Sampler::NEAREST:	return levels[0].sample3DOffset(sampler, filterMode, s, t, r, offset);
-		case Sampler::LINEAR:	return levels[0].sample3DOffset(sampler, filterMode, s, t, r, offset);
+		case Sampler::NEAREST:	return sampleLevel3D(levels[0], state, filterMode, s, t, r, offset);
+		case Sampler::LINEAR:	return sampleLevel3D(levels[0], state, filterMode, s, t, r, offset);
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
 		case Sampler::LINEAR_MIPMAP_NEAREST:
@@ -1819,7 +2594,7 @@ Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level		= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
-			return levels[level].sample3DOffset(sampler, levelFilter, s, t, r, offset);
+			return sampleLevel3D(levels[level], state, levelFilter, s, t, r, offset);
 		}
 
 		case Sampler::NEAREST_MIPMAP_LINEAR:
@@ -1830,8 +2605,8 @@ Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLeve
 			int					level1		= de::min(maxLevel, level0 + 1);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
 			float				f			= deFloatFrac(lod);
-			tcu::Vec4			t0			= levels[level0].sample3DOffset(sampler, levelFilter, s, t, r, offset);
-			tcu::Vec4			t1			= levels[level1].sample3DOffset(sampler, levelFilter, s, t, r, offset);
+			tcu::Vec4			t0			= sampleLevel3D(levels[level0], state, levelFilter, s, t, r, offset);
+			tcu::Vec4			t1			= sampleLevel3D(levels[level1], state, levelFilter, s, t, r, offset);
 
 			return t0*(1.0f - f) + t1*f;
 		}
@@ -1842,15 +2617,16 @@ Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
-float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float lod, const IVec2& offset)
+template<class SamplerState>
+static float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLevels, const SamplerState& state, float ref, float s, float lod, const IVec2& offset)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
-		case Sampler::NEAREST:	return levels[0].sample1DCompare(sampler, filterMode, ref, s, offset);
-		case Sampler::LINEAR:	return levels[0].sample1DCompare(sampler, filterMode, ref, s, offset);
+		case Sampler::NEAREST:	return sampleLevel1DCompare(levels[0], state, filterMode, ref, s, offset);
+		case Sampler::LINEAR:	return sampleLevel1DCompare(levels[0], state, filterMode, ref, s, offset);
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
 		case Sampler::LINEAR_MIPMAP_NEAREST:
@@ -1859,7 +2635,7 @@ float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLe
 			int					level		= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
-			return levels[level].sample1DCompare(sampler, levelFilter, ref, s, offset);
+			return sampleLevel1DCompare(levels[level], state, levelFilter, ref, s, offset);
 		}
 
 		case Sampler::NEAREST_MIPMAP_LINEAR:
@@ -1870,8 +2646,8 @@ float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLe
 			int					level1		= de::min(maxLevel, level0 + 1);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
 			float				f			= deFloatFrac(lod);
-			float				t0			= levels[level0].sample1DCompare(sampler, levelFilter, ref, s, offset);
-			float				t1			= levels[level1].sample1DCompare(sampler, levelFilter, ref, s, offset);
+			float				t0			= sampleLevel1DCompare(levels[level0], state, levelFilter, ref, s, offset);
+			float				t1			= sampleLevel1DCompare(levels[level1], state, levelFilter, ref, s, offset);
 
 			return t0*(1.0f - f) + t1*f;
 		}
@@ -1882,15 +2658,16 @@ float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLe
 	}
 }
 
-float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float t, float lod, const IVec3& offset)
+template<class SamplerState>
+static float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLevels, const SamplerState& state, float ref, float s, float t, float lod, const IVec3& offset)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
-		case Sampler::NEAREST:	return levels[0].sample2DCompare(sampler, filterMode, ref, s, t, offset);
-		case Sampler::LINEAR:	return levels[0].sample2DCompare(sampler, filterMode, ref, s, t, offset);
+		case Sampler::NEAREST:	return sampleLevel2DCompare(levels[0], state, filterMode, ref, s, t, offset);
+		case Sampler::LINEAR:	return sampleLevel2DCompare(levels[0], state, filterMode, ref, s, t, offset);
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
 		case Sampler::LINEAR_MIPMAP_NEAREST:
@@ -1899,7 +2676,7 @@ float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLe
 			int					level		= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
-			return levels[level].sample2DCompare(sampler, levelFilter, ref, s, t, offset);
+			return sampleLevel2DCompare(levels[level], state, levelFilter, ref, s, t, offset);
 		}
 
 		case Sampler::NEAREST_MIPMAP_LINEAR:
@@ -1910,8 +2687,8 @@ float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLe
 			int					level1		= de::min(maxLevel, level0 + 1);
 			Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
 			float				f			= deFloatFrac(lod);
-			float				t0			= levels[level0].sample2DCompare(sampler, levelFilter, ref, s, t, offset);
-			float				t1			= levels[level1].sample2DCompare(sampler, levelFilter, ref, s, t, offset);
+			float				t0			= sampleLevel2DCompare(levels[level0], state, levelFilter, ref, s, t, offset);
+			float				t1			= sampleLevel2DCompare(levels[level1], state, levelFilter, ref, s, t, offset);
 
 			return t0*(1.0f - f) + t1*f;
 		}
@@ -1922,6 +2699,56 @@ float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLe
 	}
 }
 
+Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float lod, const IVec2& offset)
+{
+	return sampleLevelArray1DOffset(levels, numLevels, DynamicSamplerState(sampler), s, lod, offset);
+}
+
+Vec4 sampleLevelArray1DOffset (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float lod, const IVec2& offset)
+{
+	return sampleLevelArray1DOffset(levels, numLevels, CompiledSamplerState(sampler), s, lod, offset);
+}
+
+Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float lod, const IVec3& offset)
+{
+	return sampleLevelArray2DOffset(levels, numLevels, DynamicSamplerState(sampler), s, t, lod, offset);
+}
+
+Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float lod, const IVec3& offset)
+{
+	return sampleLevelArray2DOffset(levels, numLevels, CompiledSamplerState(sampler), s, t, lod, offset);
+}
+
+Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset)
+{
+	return sampleLevelArray3DOffset(levels, numLevels, DynamicSamplerState(sampler), s, t, r, lod, offset);
+}
+
+Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec3& offset)
+{
+	return sampleLevelArray3DOffset(levels, numLevels, CompiledSamplerState(sampler), s, t, r, lod, offset);
+}
+
+float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float lod, const IVec2& offset)
+{
+	return sampleLevelArray1DCompare(levels, numLevels, DynamicSamplerState(sampler), ref, s, lod, offset);
+}
+
+float sampleLevelArray1DCompare (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float ref, float s, float lod, const IVec2& offset)
+{
+	return sampleLevelArray1DCompare(levels, numLevels, CompiledSamplerState(sampler), ref, s, lod, offset);
+}
+
+float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float t, float lod, const IVec3& offset)
+{
+	return sampleLevelArray2DCompare(levels, numLevels, DynamicSamplerState(sampler), ref, s, t, lod, offset);
+}
+
+float sampleLevelArray2DCompare (const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float ref, float s, float t, float lod, const IVec3& offset)
+{
+	return sampleLevelArray2DCompare(levels, numLevels, CompiledSamplerState(sampler), ref, s, t, lod, offset);
+}
+
 static Vec4 fetchGatherArray2DOffsets (const ConstPixelBufferAccess& src, const Sampler& sampler, float s, float t, int depth, int componentNdx, const IVec2 (&offsets)[4])
 {
 	DE_ASSERT(de::inBounds(componentNdx, 0, 4));
@@ -1976,12 +2803,20 @@ Vec4 gatherArray2DOffsetsCompare (const ConstPixelBufferAccess& src, const Sampl
 	return result;
 }
 
-static Vec4 sampleCubeSeamlessNearest (const ConstPixelBufferAccess& faceAccess, const Sampler& sampler, float s, float t, int depth)
+template<class SamplerState>
+static Vec4 sampleCubeSeamlessNearest (const ConstPixelBufferAccess& faceAccess, const SamplerState& state, float s, float t, int depth)
 {
-	Sampler clampingSampler = sampler;
-	clampingSampler.wrapS = Sampler::CLAMP_TO_EDGE;
-	clampingSampler.wrapT = Sampler::CLAMP_TO_EDGE;
-	return faceAccess.sample2D(clampingSampler, Sampler::NEAREST, s, t, depth);
+	// \note Equivalent to NEAREST sampling with CLAMP_TO_EDGE wrap mode in both directions.
+	DE_ASSERT(de::inBounds(depth, 0, faceAccess.getDepth()));
+
+	const int	width	= faceAccess.getWidth();
+	const int	height	= faceAccess.getHeight();
+	const float	u		= state.getSampler().normalizedCoords ? unnormalize(Sampler::CLAMP_TO_EDGE, s, width) : s;
+	const float	v		= state.getSampler().normalizedCoords ? unnormalize(Sampler::CLAMP_TO_EDGE, t, height) : t;
+	const int	i		= deClamp32(deFloorFloatToInt32(u), 0, width-1);
+	const int	j		= deClamp32(deFloorFloatToInt32(v), 0, height-1);
+
+	return state.lookup(faceAccess, i, j, depth);
 }
 
 CubeFace selectCubeFace (const Vec3& coords)
@@ -2118,7 +2953,8 @@ CubeFaceIntCoords remapCubeEdgeCoords (const CubeFaceIntCoords& origCoords, int
 	return CubeFaceIntCoords(CUBEFACE_LAST, IVec2(-1));
 }
 
-static void getCubeLinearSamples (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], CubeFace baseFace, float u, float v, int depth, Vec4 (&dst)[4])
+template<class SamplerState>
+static void getCubeLinearSamples (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], const SamplerState& state, CubeFace baseFace, float u, float v, int depth, Vec4 (&dst)[4])
 {
 	DE_ASSERT(faceAccesses[0].getWidth() == faceAccesses[0].getHeight());
 	int		size					= faceAccesses[0].getWidth();
@@ -2143,7 +2979,7 @@ static void getCubeLinearSamples (const ConstPixelBufferAccess (&faceAccesses)[C
 		CubeFaceIntCoords coords = remapCubeEdgeCoords(CubeFaceIntCoords(baseFace, baseSampleCoords[i]), size);
 		hasBothCoordsOutOfBounds[i] = coords.face == CUBEFACE_LAST;
 		if (!hasBothCoordsOutOfBounds[i])
-			sampleColors[i] = lookup(faceAccesses[coords.face], coords.s, coords.t, depth);
+			sampleColors[i] = state.lookup(faceAccesses[coords.face], coords.s, coords.t, depth);
 	}
 
 	// If a sample was out of bounds in both u and v, we get its color from the average of the three other samples.
@@ -2177,7 +3013,8 @@ static void getCubeLinearSamples (const ConstPixelBufferAccess (&faceAccesses)[C
 }
 
 // \todo [2014-02-19 pyry] Optimize faceAccesses
-static Vec4 sampleCubeSeamlessLinear (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], CubeFace baseFace, const Sampler& sampler, float s, float t, int depth)
+template<class SamplerState>
+static Vec4 sampleCubeSeamlessLinear (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], CubeFace baseFace, const SamplerState& state, float s, float t, int depth)
 {
 	DE_ASSERT(faceAccesses[0].getWidth() == faceAccesses[0].getHeight());
 
@@ -2186,16 +3023,16 @@ static Vec4 sampleCubeSeamlessLinear (const ConstPixelBufferAccess (&faceAccesse
 	float	u		= s;
 	float	v		= t;
 
-	if (sampler.normalizedCoords)
+	if (state.getSampler().normalizedCoords)
 	{
-		u = unnormalize(sampler.wrapS, s, size);
-		v = unnormalize(sampler.wrapT, t, size);
+		u = state.unnormalizeS(s, size);
+		v = state.unnormalizeT(t, size);
 	}
 
 	// Get sample colors.
 
 	Vec4 sampleColors[4];
-	getCubeLinearSamples(faceAccesses, baseFace, u, v, depth, sampleColors);
+	getCubeLinearSamples(faceAccesses, state, baseFace, u, v, depth, sampleColors);
 
 	// Interpolate.
 
@@ -2208,15 +3045,16 @@ static Vec4 sampleCubeSeamlessLinear (const ConstPixelBufferAccess (&faceAccesse
 		   (sampleColors[3]*(     a)*(     b));
 }
 
-static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&faces)[CUBEFACE_LAST], int numLevels, CubeFace face, const Sampler& sampler, float s, float t, int depth, float lod)
+template<class SamplerState>
+static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&faces)[CUBEFACE_LAST], int numLevels, CubeFace face, const SamplerState& state, float s, float t, int depth, float lod)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
 		case Sampler::NEAREST:
-			return sampleCubeSeamlessNearest(faces[face][0], sampler, s, t, depth);
+			return sampleCubeSeamlessNearest(faces[face][0], state, s, t, depth);
 
 		case Sampler::LINEAR:
 		{
@@ -2224,7 +3062,7 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 			for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 				faceAccesses[i] = faces[i][0];
 
-			return sampleCubeSeamlessLinear(faceAccesses, face, sampler, s, t, depth);
+			return sampleCubeSeamlessLinear(faceAccesses, face, state, s, t, depth);
 		}
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
@@ -2235,7 +3073,7 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 			Sampler::FilterMode		levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
 			if (levelFilter == Sampler::NEAREST)
-				return sampleCubeSeamlessNearest(faces[face][level], sampler, s, t, depth);
+				return sampleCubeSeamlessNearest(faces[face][level], state, s, t, depth);
 			else
 			{
 				DE_ASSERT(levelFilter == Sampler::LINEAR);
@@ -2244,7 +3082,7 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 				for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 					faceAccesses[i] = faces[i][level];
 
-				return sampleCubeSeamlessLinear(faceAccesses, face, sampler, s, t, depth);
+				return sampleCubeSeamlessLinear(faceAccesses, face, state, s, t, depth);
 			}
 		}
 
@@ -2261,8 +3099,8 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 
 			if (levelFilter == Sampler::NEAREST)
 			{
-				t0 = sampleCubeSeamlessNearest(faces[face][level0], sampler, s, t, depth);
-				t1 = sampleCubeSeamlessNearest(faces[face][level1], sampler, s, t, depth);
+				t0 = sampleCubeSeamlessNearest(faces[face][level0], state, s, t, depth);
+				t1 = sampleCubeSeamlessNearest(faces[face][level1], state, s, t, depth);
 			}
 			else
 			{
@@ -2276,8 +3114,8 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 					faceAccesses1[i] = faces[i][level1];
 				}
 
-				t0 = sampleCubeSeamlessLinear(faceAccesses0, face, sampler, s, t, depth);
-				t1 = sampleCubeSeamlessLinear(faceAccesses1, face, sampler, s, t, depth);
+				t0 = sampleCubeSeamlessLinear(faceAccesses0, face, state, s, t, depth);
+				t1 = sampleCubeSeamlessLinear(faceAccesses1, face, state, s, t, depth);
 			}
 
 			return t0*(1.0f - f) + t1*f;
@@ -2289,15 +3127,16 @@ static Vec4 sampleLevelArrayCubeSeamless (const ConstPixelBufferAccess* const (&
 	}
 }
 
-static float sampleCubeSeamlessNearestCompare (const ConstPixelBufferAccess& faceAccess, const Sampler& sampler, float ref, float s, float t, int depth = 0)
+template<class SamplerState>
+static float sampleCubeSeamlessNearestCompare (const ConstPixelBufferAccess& faceAccess, const SamplerState& state, float ref, float s, float t, int depth = 0)
 {
-	Sampler clampingSampler = sampler;
-	clampingSampler.wrapS = Sampler::CLAMP_TO_EDGE;
-	clampingSampler.wrapT = Sampler::CLAMP_TO_EDGE;
-	return faceAccess.sample2DCompare(clampingSampler, Sampler::NEAREST, ref, s, t, IVec3(0, 0, depth));
+	const bool isFixedPointDepth = state.isFixedPointDepth(faceAccess.getFormat());
+
+	return state.compare(sampleCubeSeamlessNearest(faceAccess, state, s, t, depth), state.getSampler().compareChannel, ref, isFixedPointDepth);
 }
 
-static float sampleCubeSeamlessLinearCompare (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], CubeFace baseFace, const Sampler& sampler, float ref, float s, float t)
+template<class SamplerState>
+static float sampleCubeSeamlessLinearCompare (const ConstPixelBufferAccess (&faceAccesses)[CUBEFACE_LAST], CubeFace baseFace, const SamplerState& state, float ref, float s, float t)
 {
 	DE_ASSERT(faceAccesses[0].getWidth() == faceAccesses[0].getHeight());
 
@@ -2306,10 +3145,10 @@ static float sampleCubeSeamlessLinearCompare (const ConstPixelBufferAccess (&fac
 	float	u		= s;
 	float	v		= t;
 
-	if (sampler.normalizedCoords)
+	if (state.getSampler().normalizedCoords)
 	{
-		u = unnormalize(sampler.wrapS, s, size);
-		v = unnormalize(sampler.wrapT, t, size);
+		u = state.unnormalizeS(s, size);
+		v = state.unnormalizeT(t, size);
 	}
 
 	int			x0						= deFloorFloatToInt32(u-0.5f);
@@ -2335,9 +3174,9 @@ static float sampleCubeSeamlessLinearCompare (const ConstPixelBufferAccess (&fac
 
 		if (!hasBothCoordsOutOfBounds[i])
 		{
-			const bool isFixedPointDepth = isFixedPointDepthTextureFormat(faceAccesses[coords.face].getFormat());
+			const bool isFixedPointDepth = state.isFixedPointDepth(faceAccesses[coords.face].getFormat());
 
-			sampleRes[i] = execCompare(faceAccesses[coords.face].getPixel(coords.s, coords.t), sampler.compare, sampler.compareChannel, ref, isFixedPointDepth);
+			sampleRes[i] = state.compare(faceAccesses[coords.face].getPixel(coords.s, coords.t), state.getSampler().compareChannel, ref, isFixedPointDepth);
 		}
 	}
 
@@ -2378,15 +3217,16 @@ static float sampleCubeSeamlessLinearCompare (const ConstPixelBufferAccess (&fac
 		   (sampleRes[3]*(     a)*(     b));
 }
 
-static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess* const (&faces)[CUBEFACE_LAST], int numLevels, CubeFace face, const Sampler& sampler, float ref, float s, float t, float lod)
+template<class SamplerState>
+static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess* const (&faces)[CUBEFACE_LAST], int numLevels, CubeFace face, const SamplerState& state, float ref, float s, float t, float lod)
 {
-	bool					magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode		filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	bool					magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode		filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
 		case Sampler::NEAREST:
-			return sampleCubeSeamlessNearestCompare(faces[face][0], sampler, ref, s, t);
+			return sampleCubeSeamlessNearestCompare(faces[face][0], state, ref, s, t);
 
 		case Sampler::LINEAR:
 		{
@@ -2394,7 +3234,7 @@ static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess*
 			for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 				faceAccesses[i] = faces[i][0];
 
-			return sampleCubeSeamlessLinearCompare(faceAccesses, face, sampler, ref, s, t);
+			return sampleCubeSeamlessLinearCompare(faceAccesses, face, state, ref, s, t);
 		}
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
@@ -2405,7 +3245,7 @@ static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess*
 			Sampler::FilterMode		levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
 			if (levelFilter == Sampler::NEAREST)
-				return sampleCubeSeamlessNearestCompare(faces[face][level], sampler, ref, s, t);
+				return sampleCubeSeamlessNearestCompare(faces[face][level], state, ref, s, t);
 			else
 			{
 				DE_ASSERT(levelFilter == Sampler::LINEAR);
@@ -2414,7 +3254,7 @@ static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess*
 				for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 					faceAccesses[i] = faces[i][level];
 
-				return sampleCubeSeamlessLinearCompare(faceAccesses, face, sampler, ref, s, t);
+				return sampleCubeSeamlessLinearCompare(faceAccesses, face, state, ref, s, t);
 			}
 		}
 
@@ -2431,8 +3271,8 @@ static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess*
 
 			if (levelFilter == Sampler::NEAREST)
 			{
-				t0 = sampleCubeSeamlessNearestCompare(faces[face][level0], sampler, ref, s, t);
-				t1 = sampleCubeSeamlessNearestCompare(faces[face][level1], sampler, ref, s, t);
+				t0 = sampleCubeSeamlessNearestCompare(faces[face][level0], state, ref, s, t);
+				t1 = sampleCubeSeamlessNearestCompare(faces[face][level1], state, ref, s, t);
 			}
 			else
 			{
@@ -2446,8 +3286,8 @@ static float sampleLevelArrayCubeSeamlessCompare (const ConstPixelBufferAccess*
 					faceAccesses1[i] = faces[i][level1];
 				}
 
-				t0 = sampleCubeSeamlessLinearCompare(faceAccesses0, face, sampler, ref, s, t);
-				t1 = sampleCubeSeamlessLinearCompare(faceAccesses1, face, sampler, ref, s, t);
+				t0 = sampleCubeSeamlessLinearCompare(faceAccesses0, face, state, ref, s, t);
+				t1 = sampleCubeSeamlessLinearCompare(faceAccesses1, face, state, ref, s, t);
 			}
 
 			return t0*(1.0f - f) + t1*f;
@@ -2469,16 +3309,17 @@ static inline ConstPixelBufferAccess getCubeArrayFaceAccess (const ConstPixelBuf
 	return getSubregion(level, 0, 0, depth, level.getWidth(), level.getHeight(), 1);
 }
 
-static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels, int numLevels, int slice, CubeFace face, const Sampler& sampler, float s, float t, float lod)
+template<class SamplerState>
+static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels, int numLevels, int slice, CubeFace face, const SamplerState& state, float s, float t, float lod)
 {
 	const int					faceDepth	= (slice * 6) + getCubeArrayFaceIndex(face);
-	const bool					magnified	= lod <= sampler.lodThreshold;
-	const Sampler::FilterMode	filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	const bool					magnified	= lod <= state.getSampler().lodThreshold;
+	const Sampler::FilterMode	filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
 		case Sampler::NEAREST:
-			return sampleCubeSeamlessNearest(levels[0], sampler, s, t, faceDepth);
+			return sampleCubeSeamlessNearest(levels[0], state, s, t, faceDepth);
 
 		case Sampler::LINEAR:
 		{
@@ -2486,7 +3327,7 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 			for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 				faceAccesses[i] = getCubeArrayFaceAccess(levels, 0, slice, (CubeFace)i);
 
-			return sampleCubeSeamlessLinear(faceAccesses, face, sampler, s, t, 0);
+			return sampleCubeSeamlessLinear(faceAccesses, face, state, s, t, 0);
 		}
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
@@ -2497,7 +3338,7 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 			Sampler::FilterMode		levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
 			if (levelFilter == Sampler::NEAREST)
-				return sampleCubeSeamlessNearest(levels[level], sampler, s, t, faceDepth);
+				return sampleCubeSeamlessNearest(levels[level], state, s, t, faceDepth);
 			else
 			{
 				DE_ASSERT(levelFilter == Sampler::LINEAR);
@@ -2506,7 +3347,7 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 				for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 					faceAccesses[i] = getCubeArrayFaceAccess(levels, level, slice, (CubeFace)i);
 
-				return sampleCubeSeamlessLinear(faceAccesses, face, sampler, s, t, 0);
+				return sampleCubeSeamlessLinear(faceAccesses, face, state, s, t, 0);
 			}
 		}
 
@@ -2523,8 +3364,8 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 
 			if (levelFilter == Sampler::NEAREST)
 			{
-				t0 = sampleCubeSeamlessNearest(levels[level0], sampler, s, t, faceDepth);
-				t1 = sampleCubeSeamlessNearest(levels[level1], sampler, s, t, faceDepth);
+				t0 = sampleCubeSeamlessNearest(levels[level0], state, s, t, faceDepth);
+				t1 = sampleCubeSeamlessNearest(levels[level1], state, s, t, faceDepth);
 			}
 			else
 			{
@@ -2538,8 +3379,8 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 					faceAccesses1[i] = getCubeArrayFaceAccess(levels, level1, slice, (CubeFace)i);
 				}
 
-				t0 = sampleCubeSeamlessLinear(faceAccesses0, face, sampler, s, t, 0);
-				t1 = sampleCubeSeamlessLinear(faceAccesses1, face, sampler, s, t, 0);
+				t0 = sampleCubeSeamlessLinear(faceAccesses0, face, state, s, t, 0);
+				t1 = sampleCubeSeamlessLinear(faceAccesses1, face, state, s, t, 0);
 			}
 
 			return t0*(1.0f - f) + t1*f;
@@ -2551,16 +3392,17 @@ static Vec4 sampleCubeArraySeamless (const ConstPixelBufferAccess* const levels,
 	}
 }
 
-static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const levels, int numLevels, int slice, CubeFace face, const Sampler& sampler, float ref, float s, float t, float lod)
+template<class SamplerState>
+static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const levels, int numLevels, int slice, CubeFace face, const SamplerState& state, float ref, float s, float t, float lod)
 {
 	const int			faceDepth	= (slice * 6) + getCubeArrayFaceIndex(face);
-	const bool			magnified	= lod <= sampler.lodThreshold;
-	Sampler::FilterMode	filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	const bool			magnified	= lod <= state.getSampler().lodThreshold;
+	Sampler::FilterMode	filterMode	= magnified ? state.getSampler().magFilter : state.getSampler().minFilter;
 
 	switch (filterMode)
 	{
 		case Sampler::NEAREST:
-			return sampleCubeSeamlessNearestCompare(levels[0], sampler, ref, s, t, faceDepth);
+			return sampleCubeSeamlessNearestCompare(levels[0], state, ref, s, t, faceDepth);
 
 		case Sampler::LINEAR:
 		{
@@ -2568,7 +3410,7 @@ static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const
 			for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 				faceAccesses[i] = getCubeArrayFaceAccess(levels, 0, slice, (CubeFace)i);
 
-			return sampleCubeSeamlessLinearCompare(faceAccesses, face, sampler, ref, s, t);
+			return sampleCubeSeamlessLinearCompare(faceAccesses, face, state, ref, s, t);
 		}
 
 		case Sampler::NEAREST_MIPMAP_NEAREST:
@@ -2579,7 +3421,7 @@ static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const
 			Sampler::FilterMode		levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
 
 			if (levelFilter == Sampler::NEAREST)
-				return sampleCubeSeamlessNearestCompare(levels[level], sampler, ref, s, t, faceDepth);
+				return sampleCubeSeamlessNearestCompare(levels[level], state, ref, s, t, faceDepth);
 			else
 			{
 				DE_ASSERT(levelFilter == Sampler::LINEAR);
@@ -2588,7 +3430,7 @@ static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const
 				for (int i = 0; i < (int)CUBEFACE_LAST; i++)
 					faceAccesses[i] = getCubeArrayFaceAccess(levels, level, slice, (CubeFace)i);
 
-				return sampleCubeSeamlessLinearCompare(faceAccesses, face, sampler, ref, s, t);
+				return sampleCubeSeamlessLinearCompare(faceAccesses, face, state, ref, s, t);
 			}
 		}
 
@@ -2605,8 +3447,8 @@ static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const
 
 			if (levelFilter == Sampler::NEAREST)
 			{
-				t0 = sampleCubeSeamlessNearestCompare(levels[level0], sampler, ref, s, t, faceDepth);
-				t1 = sampleCubeSeamlessNearestCompare(levels[level1], sampler, ref, s, t, faceDepth);
+				t0 = sampleCubeSeamlessNearestCompare(levels[level0], state, ref, s, t, faceDepth);
+				t1 = sampleCubeSeamlessNearestCompare(levels[level1], state, ref, s, t, faceDepth);
 			}
 			else
 			{
@@ -2620,8 +3462,8 @@ static float sampleCubeArraySeamlessCompare (const ConstPixelBufferAccess* const
 					faceAccesses1[i] = getCubeArrayFaceAccess(levels, level1, slice, (CubeFace)i);
 				}
 
-				t0 = sampleCubeSeamlessLinearCompare(faceAccesses0, face, sampler, ref, s, t);
-				t1 = sampleCubeSeamlessLinearCompare(faceAccesses1, face, sampler, ref, s, t);
+				t0 = sampleCubeSeamlessLinearCompare(faceAccesses0, face, state, ref, s, t);
+				t1 = sampleCubeSeamlessLinearCompare(faceAccesses1, face, state, ref, s, t);
 			}
 
 			return t0*(1.0f - f) + t1*f;
@@ -2655,51 +3497,86 @@ inline int getMipPyramidLevelSize (int baseLevelSize, int levelNdx)
 
 // TextureLevelPyramid
 
-TextureLevelPyramid::TextureLevelPyramid (const TextureFormat& format, int numLevels)
-	: m_format	(format)
-	, m_data	(numLevels)
-	, m_access	(numLevels)
+namespace
 {
-}
 
-TextureLevelPyramid::TextureLevelPyramid (const TextureLevelPyramid& other)
-	: m_format	(other.m_format)
-	, m_data	(other.getNumLevels())
-	, m_access	(other.getNumLevels())
+//! Box filter src into dst. Axes where src and dst sizes match (array layers) are not filtered.
+void downsampleLevel (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 {
-	for (int levelNdx = 0; levelNdx < other.getNumLevels(); levelNdx++)
+	const TextureFormat&		format		= dst.getFormat();
+	const TextureChannelClass	chnClass	= getTextureChannelClass(format.type);
+	const bool					isDepth		= format.order == TextureFormat::D;
+	const bool					isInteger	= chnClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || chnClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
+	const bool					isSRGBFmt	= isSRGB(format);
+	const IVec3					footprint	(dst.getWidth()		== src.getWidth()	? 1 : 2,
+											 dst.getHeight()	== src.getHeight()	? 1 : 2,
+											 dst.getDepth()		== src.getDepth()	? 1 : 2);
+	const int					numSamples	= footprint.x()*footprint.y()*footprint.z();
+
+	DE_ASSERT(format.order != TextureFormat::S && format.order != TextureFormat::DS);
+
+	for (int z = 0; z < dst.getDepth(); z++)
+	for (int y = 0; y < dst.getHeight(); y++)
+	for (int x = 0; x < dst.getWidth(); x++)
 	{
-		if (!other.isLevelEmpty(levelNdx))
-		{
-			const tcu::ConstPixelBufferAccess& srcLevel = other.getLevel(levelNdx);
+		Vec4	sum		(0.0f);
+		IVec4	intSum	(0);
 
-			m_data[levelNdx] = other.m_data[levelNdx];
-			m_access[levelNdx] = PixelBufferAccess(srcLevel.getFormat(), srcLevel.getWidth(), srcLevel.getHeight(), srcLevel.getDepth(), m_data[levelNdx].getPtr());
+		for (int dz = 0; dz < footprint.z(); dz++)
+		for (int dy = 0; dy < footprint.y(); dy++)
+		for (int dx = 0; dx < footprint.x(); dx++)
+		{
+			const int sx = de::min(x*footprint.x() + dx, src.getWidth()-1);
+			const int sy = de::min(y*footprint.y() + dy, src.getHeight()-1);
+			const int sz = de::min(z*footprint.z() + dz, src.getDepth()-1);
+
+			if (isDepth)
+				sum.x() += src.getPixDepth(sx, sy, sz);
+			else if (isInteger)
+				intSum += src.getPixelInt(sx, sy, sz);
+			else if (isSRGBFmt)
+				sum += sRGBToLinear(src.getPixel(sx, sy, sz));
+			else
+				sum += src.getPixel(sx, sy, sz);
 		}
+
+		if (isDepth)
+			dst.setPixDepth(sum.x() / float(numSamples), x, y, z);
+		else if (isInteger)
+			dst.setPixel(intSum / IVec4(numSamples), x, y, z);
+		else if (isSRGBFmt)
+			dst.setPixel(linearToSRGB(sum / float(numSamples)), x, y, z);
+		else
+			dst.setPixel(sum / float(numSamples), x, y, z);
 	}
 }
 
+} // anonymous
+
+TextureLevelPyramid::TextureLevelPyramid (const TextureFormat& format, int numLevels)
+	: m_format			(format)
+	, m_data			(numLevels)
+	, m_access			(numLevels)
+	, m_isLevelExposed	(numLevels, false)
+	, m_isLevelLazy		(numLevels, false)
+	, m_numLazyLevels	(0)
+{
+}
+
+TextureLevelPyramid::TextureLevelPyramid (const TextureLevelPyramid& other)
+	: m_format			(other.m_format)
+	, m_numLazyLevels	(0)
+{
+	copyLevels(other);
+}
+
 TextureLevelPyramid& TextureLevelPyramid::operator= (const TextureLevelPyramid& other)
 {
 	if (this == &other)
 		return *this;
 
 	m_format = other.m_format;
-	m_data.resize(other.getNumLevels());
-	m_access.resize(other.getNumLevels());
-
-	for (int levelNdx = 0; levelNdx < other.getNumLevels(); levelNdx++)
-	{
-		if (!other.isLevelEmpty(levelNdx))
-		{
-			const tcu::ConstPixelBufferAccess& srcLevel = other.getLevel(levelNdx);
-
-			m_data[levelNdx] = other.m_data[levelNdx];
-			m_access[levelNdx] = PixelBufferAccess(srcLevel.getFormat(), srcLevel.getWidth(), srcLevel.getHeight(), srcLevel.getDepth(), m_data[levelNdx].getPtr());
-		}
-		else if (!isLevelEmpty(levelNdx))
-			clearLevel(levelNdx);
-	}
+	copyLevels(other);
 
 	return *this;
 }
@@ -2708,22 +3585,130 @@ TextureLevelPyramid::~TextureLevelPyramid (void)
 {
 }
 
+//! Share level data with other, except for levels that other may still be writing to or generating.
+void TextureLevelPyramid::copyLevels (const TextureLevelPyramid& other)
+{
+	const int numLevels = other.getNumLevels();
+
+	m_data				= other.m_data;
+	m_access			= other.m_access;
+	m_isLevelExposed	= std::vector<bool>(numLevels, false);
+
+	if (other.m_lazyLevelLock)
+	{
+		const de::ScopedLock lock (*other.m_lazyLevelLock);
+
+		m_isLevelLazy	= other.m_isLevelLazy;
+		m_numLazyLevels	= other.m_numLazyLevels;
+	}
+	else
+	{
+		m_isLevelLazy	= std::vector<bool>(numLevels, false);
+		m_numLazyLevels	= 0;
+	}
+
+	m_lazyLevelLock = m_numLazyLevels > 0 ? de::SharedPtr<de::Mutex>(new de::Mutex()) : de::SharedPtr<de::Mutex>();
+
+	for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+	{
+		if (m_isLevelLazy[levelNdx])
+		{
+			// Generated separately in each copy
+			m_data[levelNdx]	= LevelDataPtr(new LevelData(m_data[levelNdx]->size()));
+			m_access[levelNdx]	= PixelBufferAccess(m_format, m_access[levelNdx].getSize(), m_data[levelNdx]->getPtr());
+		}
+		else if (other.m_isLevelExposed[levelNdx] && m_data[levelNdx])
+			makeLevelUnique(levelNdx);
+	}
+}
+
 void TextureLevelPyramid::allocLevel (int levelNdx, int width, int height, int depth)
 {
 	const int	size	= m_format.getPixelSize()*width*height*depth;
 
 	DE_ASSERT(isLevelEmpty(levelNdx));
 
-	m_data[levelNdx].setStorage(size);
-	m_access[levelNdx] = PixelBufferAccess(m_format, width, height, depth, m_data[levelNdx].getPtr());
+	m_data[levelNdx]			= LevelDataPtr(new LevelData(size));
+	m_access[levelNdx]			= PixelBufferAccess(m_format, width, height, depth, m_data[levelNdx]->getPtr());
+	m_isLevelExposed[levelNdx]	= false;
+}
+
+//! Allocate level that is generated from the previous level's contents on first access.
+void TextureLevelPyramid::allocLevelLazy (int levelNdx, int width, int height, int depth)
+{
+	DE_ASSERT(levelNdx > 0 && !isLevelEmpty(levelNdx-1));
+	DE_ASSERT(m_format.order != TextureFormat::S && m_format.order != TextureFormat::DS);
+
+	allocLevel(levelNdx, width, height, depth);
+
+	if (!m_lazyLevelLock)
+		m_lazyLevelLock = de::SharedPtr<de::Mutex>(new de::Mutex());
+
+	m_isLevelLazy[levelNdx]	= true;
+	m_numLazyLevels			+= 1;
 }
 
 void TextureLevelPyramid::clearLevel (int levelNdx)
 {
 	DE_ASSERT(!isLevelEmpty(levelNdx));
 
+	if (m_isLevelLazy[levelNdx])
+	{
+		m_isLevelLazy[levelNdx]	= false;
+		m_numLazyLevels			-= 1;
+	}
+
 	m_data[levelNdx].clear();
-	m_access[levelNdx] = PixelBufferAccess();
+	m_access[levelNdx]			= PixelBufferAccess();
+	m_isLevelExposed[levelNdx]	= false;
+}
+
+bool TextureLevelPyramid::isLevelLazy (int levelNdx) const
+{
+	if (!m_lazyLevelLock)
+		return false;
+
+	const de::ScopedLock lock (*m_lazyLevelLock);
+	return m_isLevelLazy[levelNdx];
+}
+
+void TextureLevelPyramid::finishLevelWrites (void)
+{
+	m_isLevelExposed = std::vector<bool>(getNumLevels(), false);
+}
+
+void TextureLevelPyramid::generateLevels (int beginNdx, int endNdx) const
+{
+	const de::ScopedLock lock (*m_lazyLevelLock);
+
+	for (int levelNdx = beginNdx; m_numLazyLevels > 0 && levelNdx < endNdx; levelNdx++)
+	{
+		if (m_isLevelLazy[levelNdx])
+			generateLevelLocked(levelNdx);
+	}
+}
+
+void TextureLevelPyramid::generateLevelLocked (int levelNdx) const
+{
+	DE_ASSERT(m_isLevelLazy[levelNdx]);
+	DE_ASSERT(!isLevelEmpty(levelNdx-1));
+
+	if (m_isLevelLazy[levelNdx-1])
+		generateLevelLocked(levelNdx-1);
+
+	downsampleLevel(m_access[levelNdx], m_access[levelNdx-1]);
+
+	m_isLevelLazy[levelNdx]	= false;
+	m_numLazyLevels			-= 1;
+}
+
+//! Copy shared level data before it is accessed for writing.
+void TextureLevelPyramid::makeLevelUnique (int levelNdx)
+{
+	const LevelDataPtr data (new LevelData(*m_data[levelNdx]));
+
+	m_data[levelNdx]	= data;
+	m_access[levelNdx]	= PixelBufferAccess(m_format, m_access[levelNdx].getSize(), data->getPtr());
 }
 
 // Texture1D
@@ -2768,6 +3753,15 @@ void Texture1D::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, width, 1, 1);
 }
 
+void Texture1D::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int width = getMipPyramidLevelSize(m_width, levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, width, 1, 1);
+}
+
 // Texture2D
 
 Texture2D::Texture2D (const TextureFormat& format, int width, int height)
@@ -2814,6 +3808,16 @@ void Texture2D::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, width, height, 1);
 }
 
+void Texture2D::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int	width	= getMipPyramidLevelSize(m_width, levelNdx);
+	const int	height	= getMipPyramidLevelSize(m_height, levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, width, height, 1);
+}
+
 // TextureCubeView
 
 TextureCubeView::TextureCubeView (void)
@@ -2837,7 +3841,7 @@ tcu::Vec4 TextureCubeView::sample (const Sampler& sampler, float s, float t, flo
 	// Computes (face, s, t).
 	const CubeFaceFloatCoords coords = getCubeFaceCoords(Vec3(s, t, r));
 	if (sampler.seamlessCubeMap)
-		return sampleLevelArrayCubeSeamless(m_levels, m_numLevels, coords.face, sampler, coords.s, coords.t, 0 /* depth */, lod);
+		return sampleLevelArrayCubeSeamless(m_levels, m_numLevels, coords.face, DynamicSamplerState(sampler), coords.s, coords.t, 0 /* depth */, lod);
 	else
 		return sampleLevelArray2D(m_levels[coords.face], m_numLevels, sampler, coords.s, coords.t, 0 /* depth */, lod);
 }
@@ -2849,7 +3853,31 @@ float TextureCubeView::sampleCompare (const Sampler& sampler, float ref, float s
 	// Computes (face, s, t).
 	const CubeFaceFloatCoords coords = getCubeFaceCoords(Vec3(s, t, r));
 	if (sampler.seamlessCubeMap)
-		return sampleLevelArrayCubeSeamlessCompare(m_levels, m_numLevels, coords.face, sampler, ref, coords.s, coords.t, lod);
+		return sampleLevelArrayCubeSeamlessCompare(m_levels, m_numLevels, coords.face, DynamicSamplerState(sampler), ref, coords.s, coords.t, lod);
+	else
+		return sampleLevelArray2DCompare(m_levels[coords.face], m_numLevels, sampler, ref, coords.s, coords.t, lod, IVec3(0, 0, 0));
+}
+
+tcu::Vec4 TextureCubeView::sample (const CompiledSampler& sampler, float s, float t, float r, float lod) const
+{
+	DE_ASSERT(sampler.getSampler().compare == Sampler::COMPAREMODE_NONE);
+
+	// Computes (face, s, t).
+	const CubeFaceFloatCoords coords = getCubeFaceCoords(Vec3(s, t, r));
+	if (sampler.getSampler().seamlessCubeMap)
+		return sampleLevelArrayCubeSeamless(m_levels, m_numLevels, coords.face, CompiledSamplerState(sampler), coords.s, coords.t, 0 /* depth */, lod);
+	else
+		return sampleLevelArray2D(m_levels[coords.face], m_numLevels, sampler, coords.s, coords.t, 0 /* depth */, lod);
+}
+
+float TextureCubeView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float t, float r, float lod) const
+{
+	DE_ASSERT(sampler.getSampler().compare != Sampler::COMPAREMODE_NONE);
+
+	// Computes (face, s, t).
+	const CubeFaceFloatCoords coords = getCubeFaceCoords(Vec3(s, t, r));
+	if (sampler.getSampler().seamlessCubeMap)
+		return sampleLevelArrayCubeSeamlessCompare(m_levels, m_numLevels, coords.face, CompiledSamplerState(sampler), ref, coords.s, coords.t, lod);
 	else
 		return sampleLevelArray2DCompare(m_levels[coords.face], m_numLevels, sampler, ref, coords.s, coords.t, lod, IVec3(0, 0, 0));
 }
@@ -2875,7 +3903,7 @@ Vec4 TextureCubeView::gather (const Sampler& sampler, float s, float t, float r,
 	}
 
 	Vec4 sampleColors[4];
-	getCubeLinearSamples(faceAccesses, coords.face, u, v, 0, sampleColors);
+	getCubeLinearSamples(faceAccesses, DynamicSamplerState(sampler), coords.face, u, v, 0, sampleColors);
 
 	const int	sampleIndices[4] = { 2, 3, 1, 0 }; // \note Gather returns the samples in a non-obvious order.
 	Vec4		result;
@@ -2908,48 +3936,17 @@ Vec4 TextureCubeView::gatherCompare (const Sampler& sampler, float ref, float s,
 TextureCube::TextureCube (const TextureFormat& format, int size)
 	: m_format	(format)
 	, m_size	(size)
+	, m_faces	(CUBEFACE_LAST, TextureLevelPyramid(format, computeMipPyramidLevels(size)))
 {
-	const int						numLevels		= computeMipPyramidLevels(m_size);
-	const ConstPixelBufferAccess*	levels[CUBEFACE_LAST];
-
-	for (int face = 0; face < CUBEFACE_LAST; face++)
-	{
-		m_data[face].resize(numLevels);
-		m_access[face].resize(numLevels);
-		levels[face] = &m_access[face][0];
-	}
-
-	m_view = TextureCubeView(numLevels, levels);
+	updateView();
 }
 
 TextureCube::TextureCube (const TextureCube& other)
 	: m_format	(other.m_format)
 	, m_size	(other.m_size)
+	, m_faces	(other.m_faces)
 {
-	const int						numLevels		= computeMipPyramidLevels(m_size);
-	const ConstPixelBufferAccess*	levels[CUBEFACE_LAST];
-
-	for (int face = 0; face < CUBEFACE_LAST; face++)
-	{
-		m_data[face].resize(numLevels);
-		m_access[face].resize(numLevels);
-		levels[face] = &m_access[face][0];
-	}
-
-	m_view = TextureCubeView(numLevels, levels);
-
-	for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
-	{
-		for (int face = 0; face < CUBEFACE_LAST; face++)
-		{
-			if (!other.isLevelEmpty((CubeFace)face, levelNdx))
-			{
-				allocLevel((CubeFace)face, levelNdx);
-				copy(getLevelFace(levelNdx, (CubeFace)face),
-					 other.getLevelFace(levelNdx, (CubeFace)face));
-			}
-		}
-	}
+	updateView();
 }
 
 TextureCube& TextureCube::operator= (const TextureCube& other)
@@ -2957,35 +3954,11 @@ TextureCube& TextureCube::operator= (const TextureCube& other)
 	if (this == &other)
 		return *this;
 
-	const int						numLevels		= computeMipPyramidLevels(other.m_size);
-	const ConstPixelBufferAccess*	levels[CUBEFACE_LAST];
-
-	for (int face = 0; face < CUBEFACE_LAST; face++)
-	{
-		m_data[face].resize(numLevels);
-		m_access[face].resize(numLevels);
-		levels[face] = &m_access[face][0];
-	}
-
 	m_format	= other.m_format;
 	m_size		= other.m_size;
-	m_view		= TextureCubeView(numLevels, levels);
-
-	for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
-	{
-		for (int face = 0; face < CUBEFACE_LAST; face++)
-		{
-			if (!isLevelEmpty((CubeFace)face, levelNdx))
-				clearLevel((CubeFace)face, levelNdx);
+	m_faces		= other.m_faces;
 
-			if (!other.isLevelEmpty((CubeFace)face, levelNdx))
-			{
-				allocLevel((CubeFace)face, levelNdx);
-				copy(getLevelFace(levelNdx, (CubeFace)face),
-					 other.getLevelFace(levelNdx, (CubeFace)face));
-			}
-		}
-	}
+	updateView();
 
 	return *this;
 }
@@ -2997,18 +3970,30 @@ TextureCube::~TextureCube (void)
 void TextureCube::allocLevel (tcu::CubeFace face, int levelNdx)
 {
 	const int	size		= getMipPyramidLevelSize(m_size, levelNdx);
-	const int	dataSize	= m_format.getPixelSize()*size*size;
-	DE_ASSERT(isLevelEmpty(face, levelNdx));
 
-	m_data[face][levelNdx].setStorage(dataSize);
-	m_access[face][levelNdx] = PixelBufferAccess(m_format, size, size, 1, m_data[face][levelNdx].getPtr());
+	m_faces[face].allocLevel(levelNdx, size, size, 1);
+}
+
+void TextureCube::allocLevelLazy (tcu::CubeFace face, int levelNdx)
+{
+	const int	size		= getMipPyramidLevelSize(m_size, levelNdx);
+
+	m_faces[face].allocLevelLazy(levelNdx, size, size, 1);
 }
 
 void TextureCube::clearLevel (tcu::CubeFace face, int levelNdx)
 {
-	DE_ASSERT(!isLevelEmpty(face, levelNdx));
-	m_data[face][levelNdx].clear();
-	m_access[face][levelNdx] = PixelBufferAccess();
+	m_faces[face].clearLevel(levelNdx);
+}
+
+void TextureCube::updateView (void)
+{
+	const ConstPixelBufferAccess*	levels[CUBEFACE_LAST];
+
+	for (int face = 0; face < CUBEFACE_LAST; face++)
+		levels[face] = m_faces[face].getLevels();
+
+	m_view = TextureCubeView(getNumLevels(), levels);
 }
 
 // Texture1DArrayView
@@ -3030,21 +4015,41 @@ Vec4 Texture1DArrayView::sample (const Sampler& sampler, float s, float t, float
 	return sampleLevelArray1D(m_levels, m_numLevels, sampler, s, selectLayer(t), lod);
 }
 
+Vec4 Texture1DArrayView::sample (const CompiledSampler& sampler, float s, float t, float lod) const
+{
+	return sampleLevelArray1D(m_levels, m_numLevels, sampler, s, selectLayer(t), lod);
+}
+
 Vec4 Texture1DArrayView::sampleOffset (const Sampler& sampler, float s, float t, float lod, deInt32 offset) const
 {
 	return sampleLevelArray1DOffset(m_levels, m_numLevels, sampler, s, lod, IVec2(offset, selectLayer(t)));
 }
 
+Vec4 Texture1DArrayView::sampleOffset (const CompiledSampler& sampler, float s, float t, float lod, deInt32 offset) const
+{
+	return sampleLevelArray1DOffset(m_levels, m_numLevels, sampler, s, lod, IVec2(offset, selectLayer(t)));
+}
+
 float Texture1DArrayView::sampleCompare (const Sampler& sampler, float ref, float s, float t, float lod) const
 {
 	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(0, selectLayer(t)));
 }
 
+float Texture1DArrayView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float t, float lod) const
+{
+	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(0, selectLayer(t)));
+}
+
 float Texture1DArrayView::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float lod, deInt32 offset) const
 {
 	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(offset, selectLayer(t)));
 }
 
+float Texture1DArrayView::sampleCompareOffset (const CompiledSampler& sampler, float ref, float s, float t, float lod, deInt32 offset) const
+{
+	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(offset, selectLayer(t)));
+}
+
 // Texture2DArrayView
 
 Texture2DArrayView::Texture2DArrayView (int numLevels, const ConstPixelBufferAccess* levels)
@@ -3064,21 +4069,41 @@ Vec4 Texture2DArrayView::sample (const Sampler& sampler, float s, float t, float
 	return sampleLevelArray2D(m_levels, m_numLevels, sampler, s, t, selectLayer(r), lod);
 }
 
+Vec4 Texture2DArrayView::sample (const CompiledSampler& sampler, float s, float t, float r, float lod) const
+{
+	return sampleLevelArray2D(m_levels, m_numLevels, sampler, s, t, selectLayer(r), lod);
+}
+
 float Texture2DArrayView::sampleCompare (const Sampler& sampler, float ref, float s, float t, float r, float lod) const
 {
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(0, 0, selectLayer(r)));
 }
 
+float Texture2DArrayView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float t, float r, float lod) const
+{
+	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(0, 0, selectLayer(r)));
+}
+
 Vec4 Texture2DArrayView::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec2& offset) const
 {
 	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), selectLayer(r)));
 }
 
+Vec4 Texture2DArrayView::sampleOffset (const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec2& offset) const
+{
+	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), selectLayer(r)));
+}
+
 float Texture2DArrayView::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float r, float lod, const IVec2& offset) const
 {
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(offset.x(), offset.y(), selectLayer(r)));
 }
 
+float Texture2DArrayView::sampleCompareOffset (const CompiledSampler& sampler, float ref, float s, float t, float r, float lod, const IVec2& offset) const
+{
+	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(offset.x(), offset.y(), selectLayer(r)));
+}
+
 Vec4 Texture2DArrayView::gatherOffsets (const Sampler& sampler, float s, float t, float r, int componentNdx, const IVec2 (&offsets)[4]) const
 {
 	return gatherArray2DOffsets(m_levels[0], sampler, s, t, selectLayer(r), componentNdx, offsets);
@@ -3134,6 +4159,15 @@ void Texture1DArray::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, width, m_numLayers, 1);
 }
 
+void Texture1DArray::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int width = getMipPyramidLevelSize(m_width, levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, width, m_numLayers, 1);
+}
+
 // Texture2DArray
 
 Texture2DArray::Texture2DArray (const TextureFormat& format, int width, int height, int numLayers)
@@ -3183,6 +4217,16 @@ void Texture2DArray::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, width, height, m_numLayers);
 }
 
+void Texture2DArray::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int	width	= getMipPyramidLevelSize(m_width,	levelNdx);
+	const int	height	= getMipPyramidLevelSize(m_height,	levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, width, height, m_numLayers);
+}
+
 // Texture3DView
 
 Texture3DView::Texture3DView (int numLevels, const ConstPixelBufferAccess* levels)
@@ -3241,6 +4285,17 @@ void Texture3D::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, width, height, depth);
 }
 
+void Texture3D::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int width		= getMipPyramidLevelSize(m_width,	levelNdx);
+	const int height	= getMipPyramidLevelSize(m_height,	levelNdx);
+	const int depth		= getMipPyramidLevelSize(m_depth,	levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, width, height, depth);
+}
+
 // TextureCubeArrayView
 
 TextureCubeArrayView::TextureCubeArrayView (int numLevels, const ConstPixelBufferAccess* levels)
@@ -3266,7 +4321,7 @@ tcu::Vec4 TextureCubeArrayView::sample (const Sampler& sampler, float s, float t
 	DE_ASSERT(sampler.compare == Sampler::COMPAREMODE_NONE);
 
 	if (sampler.seamlessCubeMap)
-		return sampleCubeArraySeamless(m_levels, m_numLevels, layer, coords.face, sampler, coords.s, coords.t, lod);
+		return sampleCubeArraySeamless(m_levels, m_numLevels, layer, coords.face, DynamicSamplerState(sampler), coords.s, coords.t, lod);
 	else
 		return sampleLevelArray2D(m_levels, m_numLevels, sampler, coords.s, coords.t, faceDepth, lod);
 }
@@ -3280,11 +4335,51 @@ float TextureCubeArrayView::sampleCompare (const Sampler& sampler, float ref, fl
 	DE_ASSERT(sampler.compare != Sampler::COMPAREMODE_NONE);
 
 	if (sampler.seamlessCubeMap)
-		return sampleCubeArraySeamlessCompare(m_levels, m_numLevels, layer, coords.face, sampler, ref, coords.s, coords.t, lod);
+		return sampleCubeArraySeamlessCompare(m_levels, m_numLevels, layer, coords.face, DynamicSamplerState(sampler), ref, coords.s, coords.t, lod);
+	else
+		return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, coords.s, coords.t, lod, IVec3(0, 0, faceDepth));
+}
+
+tcu::Vec4 TextureCubeArrayView::sample (const CompiledSampler& sampler, float s, float t, float r, float q, float lod) const
+{
+	const CubeFaceFloatCoords	coords		= getCubeFaceCoords(Vec3(s, t, r));
+	const int					layer		= selectLayer(q);
+	const int					faceDepth	= (layer * 6) + getCubeArrayFaceIndex(coords.face);
+
+	DE_ASSERT(sampler.getSampler().compare == Sampler::COMPAREMODE_NONE);
+
+	if (sampler.getSampler().seamlessCubeMap)
+		return sampleCubeArraySeamless(m_levels, m_numLevels, layer, coords.face, CompiledSamplerState(sampler), coords.s, coords.t, lod);
+	else
+		return sampleLevelArray2D(m_levels, m_numLevels, sampler, coords.s, coords.t, faceDepth, lod);
+}
+
+float TextureCubeArrayView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float t, float r, float q, float lod) const
+{
+	const CubeFaceFloatCoords	coords		= getCubeFaceCoords(Vec3(s, t, r));
+	const int					layer		= selectLayer(q);
+	const int					faceDepth	= (layer * 6) + getCubeArrayFaceIndex(coords.face);
+
+	DE_ASSERT(sampler.getSampler().compare != Sampler::COMPAREMODE_NONE);
+
+	if (sampler.getSampler().seamlessCubeMap)
+		return sampleCubeArraySeamlessCompare(m_levels, m_numLevels, layer, coords.face, CompiledSamplerState(sampler), ref, coords.s, coords.t, lod);
 	else
 		return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, coords.s, coords.t, lod, IVec3(0, 0, faceDepth));
 }
 
+float TextureCubeArrayView::sampleCompareOffset (const CompiledSampler& sampler, float ref, float s, float t, float r, float q, float lod, const IVec2& offset) const
+{
+	const CubeFaceFloatCoords	coords		= getCubeFaceCoords(Vec3(s, t, r));
+	const int					layer		= selectLayer(q);
+	const int					faceDepth	= (layer * 6) + getCubeArrayFaceIndex(coords.face);
+
+	DE_ASSERT(sampler.getSampler().compare != Sampler::COMPAREMODE_NONE);
+	DE_ASSERT(!sampler.getSampler().seamlessCubeMap); // \note Offset is applied within the selected face.
+
+	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, coords.s, coords.t, lod, IVec3(offset.x(), offset.y(), faceDepth));
+}
+
 // TextureCubeArray
 
 TextureCubeArray::TextureCubeArray (const TextureFormat& format, int size, int depth)
@@ -3334,6 +4429,15 @@ void TextureCubeArray::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, size, size, m_depth);
 }
 
+void TextureCubeArray::allocLevelLazy (int levelNdx)
+{
+	DE_ASSERT(de::inBounds(levelNdx, 0, getNumLevels()));
+
+	const int size = getMipPyramidLevelSize(m_size, levelNdx);
+
+	TextureLevelPyramid::allocLevelLazy(levelNdx, size, size, m_depth);
+}
+
 std::ostream& operator<< (std::ostream& str, TextureFormat::ChannelOrder order)
 {
 	const char* const orderStrings[] =
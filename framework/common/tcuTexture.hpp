@@ -27,6 +27,8 @@
 #include "tcuVector.hpp"
 #include "rrGenericVector.hpp"
 #include "deArrayBuffer.hpp"
+#include "deSharedPtr.hpp"
+#include "deMutex.hpp"
 
 #include <vector>
 #include <ostream>
@@ -279,6 +281,46 @@ public:
 	}
 } DE_WARN_UNUSED_TYPE;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Sampler bound to a texture format
+ *
+ * CompiledSampler resolves the per-lookup decisions of a Sampler once:
+ * wrap, unnormalization and comparison modes are bound to specialized
+ * functions, and format properties (sRGB conversion, border color and
+ * fixed-point depth comparison) are computed for the given format.
+ *
+ * Sampling a texture of the bound format with a compiled sampler gives
+ * results identical to sampling with the original Sampler.
+ *//*--------------------------------------------------------------------*/
+class CompiledSampler
+{
+public:
+	typedef int		(*WrapFunc)			(int c, int size);
+	typedef float	(*UnnormalizeFunc)	(float c, int size);
+	typedef float	(*CompareFunc)		(const Vec4& color, int chanNdx, float ref, bool isFixedPoint);
+
+							CompiledSampler		(void);
+							CompiledSampler		(const Sampler& sampler, const TextureFormat& format);
+
+	const Sampler&			getSampler			(void) const	{ return m_sampler;	}
+	const TextureFormat&	getFormat			(void) const	{ return m_format;	}
+
+private:
+	Sampler					m_sampler;
+	TextureFormat			m_format;
+
+	WrapFunc				m_wrap[3];			//!< Indexed with S, T, R.
+	UnnormalizeFunc			m_unnormalize[3];	//!< Indexed with S, T, R.
+	CompareFunc				m_compare;
+
+	bool					m_isSRGB;
+	bool					m_isFixedPointDepth;
+	bool					m_hasBorderColor;
+	Vec4					m_borderColor;
+
+	friend class CompiledSamplerState;
+} DE_WARN_UNUSED_TYPE;
+
 // Calculate pitches for pixel data with no padding.
 IVec3 calculatePackedPitch (const TextureFormat& format, const IVec3& size);
 
@@ -327,6 +369,14 @@ public:
 	float					getPixDepth					(int x, int y, int z = 0) const;
 	int						getPixStencil				(int x, int y, int z = 0) const;
 
+	// Row access: converts numPixels consecutive pixels starting from (x, y, z). Format is resolved once per call.
+	void					getPixelRow					(int x, int y, int z, int numPixels, Vec4* dst) const;
+	void					getPixelRowInt				(int x, int y, int z, int numPixels, IVec4* dst) const;
+	void					getPixelRowUint				(int x, int y, int z, int numPixels, UVec4* dst) const;
+
+	template<typename T>
+	void					getPixelRowT				(int x, int y, int z, int numPixels, Vector<T, 4>* dst) const;
+
 	Vec4					sample1D					(const Sampler& sampler, Sampler::FilterMode filter, float s, int level) const;
 	Vec4					sample2D					(const Sampler& sampler, Sampler::FilterMode filter, float s, float t, int depth) const;
 	Vec4					sample3D					(const Sampler& sampler, Sampler::FilterMode filter, float s, float t, float r) const;
@@ -373,6 +423,10 @@ public:
 
 	void				setPixDepth			(float depth, int x, int y, int z = 0) const;
 	void				setPixStencil		(int stencil, int x, int y, int z = 0) const;
+
+	void				setPixelRow			(const tcu::Vec4* src, int x, int y, int z, int numPixels) const;
+	void				setPixelRow			(const tcu::IVec4* src, int x, int y, int z, int numPixels) const;
+	void				setPixelRow			(const tcu::UVec4* src, int x, int y, int z, int numPixels) const;
 } DE_WARN_UNUSED_TYPE;
 
 /*--------------------------------------------------------------------*//*!
@@ -425,6 +479,17 @@ Vec4	sampleLevelArray3DOffset		(const ConstPixelBufferAccess* levels, int numLev
 float	sampleLevelArray1DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float lod, const IVec2& offset);
 float	sampleLevelArray2DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float t, float lod, const IVec3& offset);
 
+Vec4	sampleLevelArray1D				(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, int level, float lod);
+Vec4	sampleLevelArray2D				(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, int depth, float lod);
+Vec4	sampleLevelArray3D				(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float r, float lod);
+
+Vec4	sampleLevelArray1DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float lod, const IVec2& offset);
+Vec4	sampleLevelArray2DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float lod, const IVec3& offset);
+Vec4	sampleLevelArray3DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec3& offset);
+
+float	sampleLevelArray1DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float ref, float s, float lod, const IVec2& offset);
+float	sampleLevelArray2DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const CompiledSampler& sampler, float ref, float s, float t, float lod, const IVec3& offset);
+
 Vec4	gatherArray2DOffsets			(const ConstPixelBufferAccess& src, const Sampler& sampler, float s, float t, int depth, int componentNdx, const IVec2 (&offsets)[4]);
 Vec4	gatherArray2DOffsetsCompare		(const ConstPixelBufferAccess& src, const Sampler& sampler, float ref, float s, float t, int depth, const IVec2 (&offsets)[4]);
 
@@ -480,6 +545,11 @@ public:
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float lod, deInt32 offset) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float lod) const;
+	Vec4							sampleOffset		(const CompiledSampler& sampler, float s, float lod, deInt32 offset) const;
+	float							sampleCompare		(const CompiledSampler& sampler, float ref, float s, float lod) const;
+	float							sampleCompareOffset	(const CompiledSampler& sampler, float ref, float s, float lod, deInt32 offset) const;
+
 protected:
 	int								m_numLevels;
 	const ConstPixelBufferAccess*	m_levels;
@@ -497,21 +567,41 @@ inline Vec4 Texture1DView::sample (const Sampler& sampler, float s, float lod) c
 	return sampleLevelArray1D(m_levels, m_numLevels, sampler, s, 0 /* depth */, lod);
 }
 
+inline Vec4 Texture1DView::sample (const CompiledSampler& sampler, float s, float lod) const
+{
+	return sampleLevelArray1D(m_levels, m_numLevels, sampler, s, 0 /* depth */, lod);
+}
+
 inline Vec4 Texture1DView::sampleOffset (const Sampler& sampler, float s, float lod, deInt32 offset) const
 {
 	return sampleLevelArray1DOffset(m_levels, m_numLevels, sampler, s, lod, IVec2(offset, 0));
 }
 
+inline Vec4 Texture1DView::sampleOffset (const CompiledSampler& sampler, float s, float lod, deInt32 offset) const
+{
+	return sampleLevelArray1DOffset(m_levels, m_numLevels, sampler, s, lod, IVec2(offset, 0));
+}
+
 inline float Texture1DView::sampleCompare (const Sampler& sampler, float ref, float s, float lod) const
 {
 	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(0, 0));
 }
 
+inline float Texture1DView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float lod) const
+{
+	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(0, 0));
+}
+
 inline float Texture1DView::sampleCompareOffset (const Sampler& sampler, float ref, float s, float lod, deInt32 offset) const
 {
 	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(offset, 0));
 }
 
+inline float Texture1DView::sampleCompareOffset (const CompiledSampler& sampler, float ref, float s, float lod, deInt32 offset) const
+{
+	return sampleLevelArray1DCompare(m_levels, m_numLevels, sampler, ref, s, lod, IVec2(offset, 0));
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief 2D Texture View
  *//*--------------------------------------------------------------------*/
@@ -531,6 +621,11 @@ public:
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float t, float lod) const;
+	Vec4							sampleOffset		(const CompiledSampler& sampler, float s, float t, float lod, const IVec2& offset) const;
+	float							sampleCompare		(const CompiledSampler& sampler, float ref, float s, float t, float lod) const;
+	float							sampleCompareOffset	(const CompiledSampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
+
 	Vec4							gatherOffsets		(const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const;
 	Vec4							gatherOffsetsCompare(const Sampler& sampler, float ref, float s, float t, const IVec2 (&offsets)[4]) const;
 
@@ -551,21 +646,41 @@ inline Vec4 Texture2DView::sample (const Sampler& sampler, float s, float t, flo
 	return sampleLevelArray2D(m_levels, m_numLevels, sampler, s, t, 0 /* depth */, lod);
 }
 
+inline Vec4 Texture2DView::sample (const CompiledSampler& sampler, float s, float t, float lod) const
+{
+	return sampleLevelArray2D(m_levels, m_numLevels, sampler, s, t, 0 /* depth */, lod);
+}
+
 inline Vec4 Texture2DView::sampleOffset (const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const
 {
 	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), 0));
 }
 
+inline Vec4 Texture2DView::sampleOffset (const CompiledSampler& sampler, float s, float t, float lod, const IVec2& offset) const
+{
+	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), 0));
+}
+
 inline float Texture2DView::sampleCompare (const Sampler& sampler, float ref, float s, float t, float lod) const
 {
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(0, 0, 0));
 }
 
+inline float Texture2DView::sampleCompare (const CompiledSampler& sampler, float ref, float s, float t, float lod) const
+{
+	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(0, 0, 0));
+}
+
 inline float Texture2DView::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const
 {
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(offset.x(), offset.y(), 0));
 }
 
+inline float Texture2DView::sampleCompareOffset (const CompiledSampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const
+{
+	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(offset.x(), offset.y(), 0));
+}
+
 inline Vec4 Texture2DView::gatherOffsets (const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const
 {
 	return gatherArray2DOffsets(m_levels[0], sampler, s, t, 0, componentNdx, offsets);
@@ -578,6 +693,19 @@ inline Vec4 Texture2DView::gatherOffsetsCompare (const Sampler& sampler, float r
 
 /*--------------------------------------------------------------------*//*!
  * \brief Base class for textures that have single mip-map pyramid
+ *
+ * Level storage is reference-counted and copy-on-write: copying a pyramid
+ * shares the level data. A level is copied when it is requested through a
+ * non-const getter while shared. Levels that have been handed out through
+ * a non-const getter since the last finishLevelWrites() are copied when
+ * the pyramid is copied, so that writes through earlier accesses do not
+ * show up in the copy. glu textures call finishLevelWrites() after
+ * upload().
+ *
+ * Lazy levels are allocated with allocLevelLazy() and generated from the
+ * previous level with a box filter on first access. Generation is
+ * serialized with a per-pyramid lock, so const textures with lazy levels
+ * can be read from multiple threads.
  *//*--------------------------------------------------------------------*/
 class TextureLevelPyramid
 {
@@ -587,28 +715,74 @@ public:
 									~TextureLevelPyramid(void);
 
 	const TextureFormat&			getFormat			(void) const			{ return m_format;					}
-	bool							isLevelEmpty		(int levelNdx) const	{ return m_data[levelNdx].empty();	}
+	bool							isLevelEmpty		(int levelNdx) const	{ return !m_data[levelNdx];			}
+	bool							isLevelLazy			(int levelNdx) const;
 
 	int								getNumLevels		(void) const			{ return (int)m_access.size();		}
-	const ConstPixelBufferAccess&	getLevel			(int ndx) const			{ return m_access[ndx];				}
-	const PixelBufferAccess&		getLevel			(int ndx)				{ return m_access[ndx];				}
+	const ConstPixelBufferAccess&	getLevel			(int ndx) const;
+	const PixelBufferAccess&		getLevel			(int ndx);
 
+	//! Level accesses for texture views. Lazy levels are not generated.
 	const ConstPixelBufferAccess*	getLevels			(void) const			{ return &m_access[0];				}
-	const PixelBufferAccess*		getLevels			(void)					{ return &m_access[0];				}
 
 	void							allocLevel			(int levelNdx, int width, int height, int depth);
+	void							allocLevelLazy		(int levelNdx, int width, int height, int depth);
 	void							clearLevel			(int levelNdx);
 
+	void							generateLazyLevels	(void) const;
+
+	//! Declare that accesses returned by non-const getters are no longer written to. Levels are shared with later copies.
+	void							finishLevelWrites	(void);
+
 	TextureLevelPyramid&			operator=			(const TextureLevelPyramid& other);
 
 private:
-	typedef de::ArrayBuffer<deUint8> LevelData;
+	typedef de::ArrayBuffer<deUint8>	LevelData;
+	typedef de::SharedPtr<LevelData>	LevelDataPtr;
+
+	void							copyLevels			(const TextureLevelPyramid& other);
+	void							makeLevelUnique		(int levelNdx);
+	void							generateLevels		(int beginNdx, int endNdx) const;
+	void							generateLevelLocked	(int levelNdx) const;
 
 	TextureFormat					m_format;
-	std::vector<LevelData>			m_data;
+	std::vector<LevelDataPtr>		m_data;
 	std::vector<PixelBufferAccess>	m_access;
+	std::vector<bool>				m_isLevelExposed;	//!< Level has been returned by non-const getLevel().
+
+	// Lazy levels have their storage allocated up front and are filled on first access, also through const getters.
+	de::SharedPtr<de::Mutex>		m_lazyLevelLock;	//!< Created by allocLevelLazy(). Guards m_isLevelLazy and contents of lazy levels.
+	mutable std::vector<bool>		m_isLevelLazy;
+	mutable int						m_numLazyLevels;
 } DE_WARN_UNUSED_TYPE;
 
+inline const ConstPixelBufferAccess& TextureLevelPyramid::getLevel (int ndx) const
+{
+	if (m_lazyLevelLock)
+		generateLevels(ndx, ndx+1);
+
+	return m_access[ndx];
+}
+
+inline const PixelBufferAccess& TextureLevelPyramid::getLevel (int ndx)
+{
+	if (m_lazyLevelLock)
+		generateLevels(ndx, ndx+1);
+
+	if (m_data[ndx] && !m_data[ndx].isUnique())
+		makeLevelUnique(ndx);
+
+	m_isLevelExposed[ndx] = true;
+
+	return m_access[ndx];
+}
+
+inline void TextureLevelPyramid::generateLazyLevels (void) const
+{
+	if (m_lazyLevelLock)
+		generateLevels(0, getNumLevels());
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief 1D Texture reference implementation
  *//*--------------------------------------------------------------------*/
@@ -620,9 +794,10 @@ public:
 									~Texture1D			(void);
 
 	int								getWidth			(void) const	{ return m_width;	}
-	const Texture1DView&			getView				(void) const	{ return m_view;	}
+	const Texture1DView&			getView				(void) const	{ generateLazyLevels(); return m_view;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	// Sampling
 	Vec4							sample				(const Sampler& sampler, float s, float lod) const;
@@ -633,10 +808,13 @@ public:
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Texture1D&						operator=			(const Texture1D& other);
 
-	operator Texture1DView (void) const { return m_view; }
+	operator Texture1DView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_width;
@@ -645,11 +823,13 @@ private:
 
 inline Vec4 Texture1D::sample (const Sampler& sampler, float s, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, lod);
 }
 
 inline Vec4 Texture1D::sampleOffset (const Sampler& sampler, float s, float lod, deInt32 offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, lod, offset);
 }
 
@@ -665,9 +845,10 @@ public:
 
 	int								getWidth			(void) const	{ return m_width;	}
 	int								getHeight			(void) const	{ return m_height;	}
-	const Texture2DView&			getView				(void) const	{ return m_view;	}
+	const Texture2DView&			getView				(void) const	{ generateLazyLevels(); return m_view;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	// Sampling
 	Vec4							sample				(const Sampler& sampler, float s, float t, float lod) const;
@@ -683,10 +864,13 @@ public:
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Texture2D&						operator=			(const Texture2D& other);
 
-	operator Texture2DView (void) const { return m_view; }
+	operator Texture2DView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_width;
@@ -696,31 +880,37 @@ private:
 
 inline Vec4 Texture2D::sample (const Sampler& sampler, float s, float t, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, lod);
 }
 
 inline Vec4 Texture2D::sampleOffset (const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, t, lod, offset);
 }
 
 inline float Texture2D::sampleCompare (const Sampler& sampler, float ref, float s, float t, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompare(sampler, ref, s, t, lod);
 }
 
 inline float Texture2D::sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompareOffset(sampler, ref, s, t, lod, offset);
 }
 
 inline Vec4 Texture2D::gatherOffsets (const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const
 {
+	generateLazyLevels();
 	return m_view.gatherOffsets(sampler, s, t, componentNdx, offsets);
 }
 
 inline Vec4 Texture2D::gatherOffsetsCompare (const Sampler& sampler, float ref, float s, float t, const IVec2 (&offsets)[4]) const
 {
+	generateLazyLevels();
 	return m_view.gatherOffsetsCompare(sampler, ref, s, t, offsets);
 }
 
@@ -741,6 +931,9 @@ public:
 	Vec4							sample				(const Sampler& sampler, float s, float t, float p, float lod) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float r, float lod) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float t, float p, float lod) const;
+	float							sampleCompare		(const CompiledSampler& sampler, float ref, float s, float t, float r, float lod) const;
+
 	Vec4							gather				(const Sampler& sampler, float s, float t, float r, int componentNdx) const;
 	Vec4							gatherCompare		(const Sampler& sampler, float ref, float s, float t, float r) const;
 
@@ -762,13 +955,20 @@ public:
 	const TextureFormat&			getFormat			(void) const	{ return m_format;	}
 	int								getSize				(void) const	{ return m_size;	}
 
-	int								getNumLevels		(void) const					{ return (int)m_access[0].size();	}
-	const ConstPixelBufferAccess&	getLevelFace		(int ndx, CubeFace face) const	{ return m_access[face][ndx];		}
-	const PixelBufferAccess&		getLevelFace		(int ndx, CubeFace face)		{ return m_access[face][ndx];		}
+	int								getNumLevels		(void) const					{ return m_faces[0].getNumLevels();		}
+	const ConstPixelBufferAccess&	getLevelFace		(int ndx, CubeFace face) const	{ return m_faces[face].getLevel(ndx);	}
+	const PixelBufferAccess&		getLevelFace		(int ndx, CubeFace face)		{ return m_faces[face].getLevel(ndx);	}
 
 	void							allocLevel			(CubeFace face, int levelNdx);
+	void							allocLevelLazy		(CubeFace face, int levelNdx);
 	void							clearLevel			(CubeFace face, int levelNdx);
-	bool							isLevelEmpty		(CubeFace face, int levelNdx) const		{ return m_data[face][levelNdx].empty();	}
+	bool							isLevelEmpty		(CubeFace face, int levelNdx) const		{ return m_faces[face].isLevelEmpty(levelNdx);	}
+	bool							isLevelLazy			(CubeFace face, int levelNdx) const		{ return m_faces[face].isLevelLazy(levelNdx);	}
+
+	void							generateLazyLevels	(void) const;
+	void							finishLevelWrites	(void);
+
+	const TextureCubeView&			getView				(void) const							{ generateLazyLevels(); return m_view;	}
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float p, float lod) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float r, float lod) const;
@@ -778,35 +978,50 @@ public:
 
 	TextureCube&					operator=			(const TextureCube& other);
 
-	operator TextureCubeView (void) const { return m_view; }
+	operator TextureCubeView (void) const { generateLazyLevels(); return m_view; }
 
 private:
-	typedef de::ArrayBuffer<deUint8> LevelData;
+	void							updateView			(void);
 
 	TextureFormat					m_format;
 	int								m_size;
-	std::vector<LevelData>			m_data[CUBEFACE_LAST];
-	std::vector<PixelBufferAccess>	m_access[CUBEFACE_LAST];
+	std::vector<TextureLevelPyramid>	m_faces;
 	TextureCubeView					m_view;
 } DE_WARN_UNUSED_TYPE;
 
+inline void TextureCube::generateLazyLevels (void) const
+{
+	for (int face = 0; face < CUBEFACE_LAST; face++)
+		m_faces[face].generateLazyLevels();
+}
+
+inline void TextureCube::finishLevelWrites (void)
+{
+	for (int face = 0; face < CUBEFACE_LAST; face++)
+		m_faces[face].finishLevelWrites();
+}
+
 inline Vec4 TextureCube::sample (const Sampler& sampler, float s, float t, float p, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, p, lod);
 }
 
 inline float TextureCube::sampleCompare (const Sampler& sampler, float ref, float s, float t, float r, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompare(sampler, ref, s, t, r, lod);
 }
 
 inline Vec4 TextureCube::gather (const Sampler& sampler, float s, float t, float r, int componentNdx) const
 {
+	generateLazyLevels();
 	return m_view.gather(sampler, s, t, r, componentNdx);
 }
 
 inline Vec4 TextureCube::gatherCompare (const Sampler& sampler, float ref, float s, float t, float r) const
 {
+	generateLazyLevels();
 	return m_view.gatherCompare(sampler, ref, s, t, r);
 }
 
@@ -829,6 +1044,11 @@ public:
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, deInt32 offset) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float t, float lod) const;
+	Vec4							sampleOffset		(const CompiledSampler& sampler, float s, float t, float lod, deInt32 offset) const;
+	float							sampleCompare		(const CompiledSampler& sampler, float ref, float s, float t, float lod) const;
+	float							sampleCompareOffset	(const CompiledSampler& sampler, float ref, float s, float t, float lod, deInt32 offset) const;
+
 protected:
 	int								selectLayer			(float r) const;
 
@@ -856,6 +1076,11 @@ public:
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float r, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float r, float lod, const IVec2& offset) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float t, float r, float lod) const;
+	Vec4							sampleOffset		(const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec2& offset) const;
+	float							sampleCompare		(const CompiledSampler& sampler, float ref, float s, float t, float r, float lod) const;
+	float							sampleCompareOffset	(const CompiledSampler& sampler, float ref, float s, float t, float r, float lod, const IVec2& offset) const;
+
 	Vec4							gatherOffsets		(const Sampler& sampler, float s, float t, float r, int componentNdx, const IVec2 (&offsets)[4]) const;
 	Vec4							gatherOffsetsCompare(const Sampler& sampler, float ref, float s, float t, float r, const IVec2 (&offsets)[4]) const;
 
@@ -880,12 +1105,16 @@ public:
 	int								getNumLayers		(void) const	{ return m_numLayers;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	using TextureLevelPyramid::getFormat;
 	using TextureLevelPyramid::getNumLevels;
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float lod) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, deInt32 offset) const;
@@ -894,7 +1123,7 @@ public:
 
 	Texture1DArray&					operator=			(const Texture1DArray& other);
 
-	operator Texture1DArrayView (void) const { return m_view; }
+	operator Texture1DArrayView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_width;
@@ -904,21 +1133,25 @@ private:
 
 inline Vec4 Texture1DArray::sample (const Sampler& sampler, float s, float t, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, lod);
 }
 
 inline Vec4 Texture1DArray::sampleOffset (const Sampler& sampler, float s, float t, float lod, deInt32 offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, t, lod, offset);
 }
 
 inline float Texture1DArray::sampleCompare (const Sampler& sampler, float ref, float s, float t, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompare(sampler, ref, s, t, lod);
 }
 
 inline float Texture1DArray::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float lod, deInt32 offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompareOffset(sampler, ref, s, t, lod, offset);
 }
 
@@ -937,12 +1170,16 @@ public:
 	int								getNumLayers		(void) const	{ return m_numLayers;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	using TextureLevelPyramid::getFormat;
 	using TextureLevelPyramid::getNumLevels;
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float lod) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float lod, const IVec2& offset) const;
@@ -954,7 +1191,7 @@ public:
 
 	Texture2DArray&					operator=			(const Texture2DArray& other);
 
-	operator Texture2DArrayView (void) const { return m_view; }
+	operator Texture2DArrayView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_width;
@@ -965,31 +1202,37 @@ private:
 
 inline Vec4 Texture2DArray::sample (const Sampler& sampler, float s, float t, float r, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, r, lod);
 }
 
 inline Vec4 Texture2DArray::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, t, r, lod, offset);
 }
 
 inline float Texture2DArray::sampleCompare (const Sampler& sampler, float ref, float s, float t, float r, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompare(sampler, ref, s, t, r, lod);
 }
 
 inline float Texture2DArray::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float r, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompareOffset(sampler, ref, s, t, r, lod, offset);
 }
 
 inline Vec4 Texture2DArray::gatherOffsets (const Sampler& sampler, float s, float t, float r, int componentNdx, const IVec2 (&offsets)[4]) const
 {
+	generateLazyLevels();
 	return m_view.gatherOffsets(sampler, s, t, r, componentNdx, offsets);
 }
 
 inline Vec4 Texture2DArray::gatherOffsetsCompare (const Sampler& sampler, float ref, float s, float t, float r, const IVec2 (&offsets)[4]) const
 {
+	generateLazyLevels();
 	return m_view.gatherOffsetsCompare(sampler, ref, s, t, r, offsets);
 }
 
@@ -1011,6 +1254,9 @@ public:
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float lod) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const;
 
+	Vec4							sample				(const CompiledSampler& sampler, float s, float t, float r, float lod) const;
+	Vec4							sampleOffset		(const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const;
+
 protected:
 	int								m_numLevels;
 	const ConstPixelBufferAccess*	m_levels;
@@ -1021,11 +1267,21 @@ inline Vec4 Texture3DView::sample (const Sampler& sampler, float s, float t, flo
 	return sampleLevelArray3D(m_levels, m_numLevels, sampler, s, t, r, lod);
 }
 
+inline Vec4 Texture3DView::sample (const CompiledSampler& sampler, float s, float t, float r, float lod) const
+{
+	return sampleLevelArray3D(m_levels, m_numLevels, sampler, s, t, r, lod);
+}
+
 inline Vec4 Texture3DView::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const
 {
 	return sampleLevelArray3DOffset(m_levels, m_numLevels, sampler, s, t, r, lod, offset);
 }
 
+inline Vec4 Texture3DView::sampleOffset (const CompiledSampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const
+{
+	return sampleLevelArray3DOffset(m_levels, m_numLevels, sampler, s, t, r, lod, offset);
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief 3D Texture reference implementation
  *//*--------------------------------------------------------------------*/
@@ -1041,19 +1297,23 @@ public:
 	int								getDepth			(void) const	{ return m_depth;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	using TextureLevelPyramid::getFormat;
 	using TextureLevelPyramid::getNumLevels;
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float lod) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const;
 
 	Texture3D&						operator=			(const Texture3D& other);
 
-	operator Texture3DView (void) const { return m_view; }
+	operator Texture3DView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_width;
@@ -1064,11 +1324,13 @@ private:
 
 inline Vec4 Texture3D::sample (const Sampler& sampler, float s, float t, float r, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, r, lod);
 }
 
 inline Vec4 Texture3D::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, t, r, lod, offset);
 }
 
@@ -1092,6 +1354,10 @@ public:
 	float							sampleCompare			(const Sampler& sampler, float ref, float s, float t, float r, float q, float lod) const;
 	float							sampleCompareOffset		(const Sampler& sampler, float ref, float s, float t, float r, float q, float lod, const IVec2& offset) const;
 
+	Vec4							sample					(const CompiledSampler& sampler, float s, float t, float r, float q, float lod) const;
+	float							sampleCompare			(const CompiledSampler& sampler, float ref, float s, float t, float r, float q, float lod) const;
+	float							sampleCompareOffset		(const CompiledSampler& sampler, float ref, float s, float t, float r, float q, float lod, const IVec2& offset) const;
+
 protected:
 	int								selectLayer				(float q) const;
 
@@ -1113,12 +1379,16 @@ public:
 	int								getDepth			(void) const	{ return m_depth;	}
 
 	void							allocLevel			(int levelNdx);
+	void							allocLevelLazy		(int levelNdx);
 
 	using TextureLevelPyramid::getFormat;
 	using TextureLevelPyramid::getNumLevels;
 	using TextureLevelPyramid::getLevel;
 	using TextureLevelPyramid::clearLevel;
 	using TextureLevelPyramid::isLevelEmpty;
+	using TextureLevelPyramid::isLevelLazy;
+	using TextureLevelPyramid::generateLazyLevels;
+	using TextureLevelPyramid::finishLevelWrites;
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float q, float lod) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float q, float lod, const IVec2& offset) const;
@@ -1127,7 +1397,7 @@ public:
 
 	TextureCubeArray&				operator=			(const TextureCubeArray& other);
 
-	operator TextureCubeArrayView (void) const { return m_view; }
+	operator TextureCubeArrayView (void) const { generateLazyLevels(); return m_view; }
 
 private:
 	int								m_size;
@@ -1137,21 +1407,25 @@ private:
 
 inline Vec4 TextureCubeArray::sample (const Sampler& sampler, float s, float t, float r, float q, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sample(sampler, s, t, r, q, lod);
 }
 
 inline Vec4 TextureCubeArray::sampleOffset (const Sampler& sampler, float s, float t, float r, float q, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleOffset(sampler, s, t, r, q, lod, offset);
 }
 
 inline float TextureCubeArray::sampleCompare (const Sampler& sampler, float ref, float s, float t, float r, float q, float lod) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompare(sampler, ref, s, t, r, q, lod);
 }
 
 inline float TextureCubeArray::sampleCompareOffset (const Sampler& sampler, float ref, float s, float t, float r, float q, float lod, const IVec2& offset) const
 {
+	generateLazyLevels();
 	return m_view.sampleCompareOffset(sampler, ref, s, t, r, q, lod, offset);
 }
 
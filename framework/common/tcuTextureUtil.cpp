@@ -28,6 +28,7 @@
 #include "deMemory.h"
 
 #include <limits>
+#include <vector>
 
 namespace tcu
 {
@@ -460,6 +461,44 @@ enum
 	CLEAR_OPTIMIZE_MAX_PIXEL_SIZE	= 8
 };
 
+//! Write full row y of slice z. row must hold getWidth() pixels.
+template <typename T>
+static void writePixelRow (const PixelBufferAccess& access, const std::vector<Vector<T, 4> >& row, int y, int z)
+{
+	DE_ASSERT((int)row.size() == access.getWidth());
+
+	if (!row.empty())
+		access.setPixelRow(&row[0], 0, y, z, (int)row.size());
+}
+
+template <typename PixelType>
+static void clearPixelRows (const PixelBufferAccess& access, const PixelType& color)
+{
+	const std::vector<PixelType> row (access.getWidth(), color);
+
+	for (int z = 0; z < access.getDepth(); z++)
+		for (int y = 0; y < access.getHeight(); y++)
+			writePixelRow(access, row, y, z);
+}
+
+template <typename T>
+static void copyPixelRows (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
+{
+	DE_ASSERT(src.getSize() == dst.getSize());
+
+	std::vector<Vector<T, 4> > row (dst.getWidth());
+
+	if (row.empty())
+		return;
+
+	for (int z = 0; z < dst.getDepth(); z++)
+	for (int y = 0; y < dst.getHeight(); y++)
+	{
+		src.getPixelRowT<T>(0, y, z, (int)row.size(), &row[0]);
+		dst.setPixelRow(&row[0], 0, y, z, (int)row.size());
+	}
+}
+
 inline void fillRow (const PixelBufferAccess& dst, int y, int z, int pixelSize, const deUint8* pixel)
 {
 	DE_ASSERT(dst.getPixelPitch() == pixelSize); // only tightly packed
@@ -515,10 +554,7 @@ void clear (const PixelBufferAccess& access, const Vec4& color)
 	}
 	else
 	{
-		for (int z = 0; z < access.getDepth(); z++)
-			for (int y = 0; y < access.getHeight(); y++)
-				for (int x = 0; x < access.getWidth(); x++)
-					access.setPixel(color, x, y, z);
+		clearPixelRows(access, color);
 	}
 }
 
@@ -546,10 +582,7 @@ void clear (const PixelBufferAccess& access, const IVec4& color)
 	}
 	else
 	{
-		for (int z = 0; z < access.getDepth(); z++)
-			for (int y = 0; y < access.getHeight(); y++)
-				for (int x = 0; x < access.getWidth(); x++)
-					access.setPixel(color, x, y, z);
+		clearPixelRows(access, color);
 	}
 }
 
@@ -575,6 +608,9 @@ void clearStencil (const PixelBufferAccess& access, int stencil)
 static void fillWithComponentGradients1D (const PixelBufferAccess& access, const Vec4& minVal, const Vec4& maxVal)
 {
 	DE_ASSERT(access.getHeight() == 1);
+
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int x = 0; x < access.getWidth(); x++)
 	{
 		float s = ((float)x + 0.5f) / (float)access.getWidth();
@@ -584,12 +620,16 @@ static void fillWithComponentGradients1D (const PixelBufferAccess& access, const
 		float b = linearInterpolate(s, minVal.z(), maxVal.z());
 		float a = linearInterpolate(s, minVal.w(), maxVal.w());
 
-		access.setPixel(tcu::Vec4(r, g, b, a), x, 0);
+		row[x] = tcu::Vec4(r, g, b, a);
 	}
+
+	writePixelRow(access, row, 0, 0);
 }
 
 static void fillWithComponentGradients2D (const PixelBufferAccess& access, const Vec4& minVal, const Vec4& maxVal)
 {
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int y = 0; y < access.getHeight(); y++)
 	{
 		for (int x = 0; x < access.getWidth(); x++)
@@ -602,13 +642,17 @@ static void fillWithComponentGradients2D (const PixelBufferAccess& access, const
 			float b = linearInterpolate(((1.0f-s) +       t) *0.5f, minVal.z(), maxVal.z());
 			float a = linearInterpolate(((1.0f-s) + (1.0f-t))*0.5f, minVal.w(), maxVal.w());
 
-			access.setPixel(tcu::Vec4(r, g, b, a), x, y);
+			row[x] = tcu::Vec4(r, g, b, a);
 		}
+
+		writePixelRow(access, row, y, 0);
 	}
 }
 
 static void fillWithComponentGradients3D (const PixelBufferAccess& dst, const Vec4& minVal, const Vec4& maxVal)
 {
+	std::vector<Vec4> row (dst.getWidth());
+
 	for (int z = 0; z < dst.getDepth(); z++)
 	{
 		for (int y = 0; y < dst.getHeight(); y++)
@@ -624,8 +668,10 @@ static void fillWithComponentGradients3D (const PixelBufferAccess& dst, const Ve
 				float b = linearInterpolate(p,						minVal.z(), maxVal.z());
 				float a = linearInterpolate(1.0f - (s+t+p)/3.0f,	minVal.w(), maxVal.w());
 
-				dst.setPixel(tcu::Vec4(r, g, b, a), x, y, z);
+				row[x] = tcu::Vec4(r, g, b, a);
 			}
+
+			writePixelRow(dst, row, y, z);
 		}
 	}
 }
@@ -658,19 +704,22 @@ void fillWithComponentGradients (const PixelBufferAccess& access, const Vec4& mi
 
 static void fillWithGrid1D (const PixelBufferAccess& access, int cellSize, const Vec4& colorA, const Vec4& colorB)
 {
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int x = 0; x < access.getWidth(); x++)
 	{
 		int mx = (x / cellSize) % 2;
 
-		if (mx)
-			access.setPixel(colorB, x, 0);
-		else
-			access.setPixel(colorA, x, 0);
+		row[x] = mx ? colorB : colorA;
 	}
+
+	writePixelRow(access, row, 0, 0);
 }
 
 static void fillWithGrid2D (const PixelBufferAccess& access, int cellSize, const Vec4& colorA, const Vec4& colorB)
 {
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int y = 0; y < access.getHeight(); y++)
 	{
 		for (int x = 0; x < access.getWidth(); x++)
@@ -678,16 +727,17 @@ static void fillWithGrid2D (const PixelBufferAccess& access, int cellSize, const
 			int mx = (x / cellSize) % 2;
 			int my = (y / cellSize) % 2;
 
-			if (mx ^ my)
-				access.setPixel(colorB, x, y);
-			else
-				access.setPixel(colorA, x, y);
+			row[x] = (mx ^ my) ? colorB : colorA;
 		}
+
+		writePixelRow(access, row, y, 0);
 	}
 }
 
 static void fillWithGrid3D (const PixelBufferAccess& access, int cellSize, const Vec4& colorA, const Vec4& colorB)
 {
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int z = 0; z < access.getDepth(); z++)
 	{
 		for (int y = 0; y < access.getHeight(); y++)
@@ -698,11 +748,10 @@ static void fillWithGrid3D (const PixelBufferAccess& access, int cellSize, const
 				int my = (y / cellSize) % 2;
 				int mz = (z / cellSize) % 2;
 
-				if (mx ^ my ^ mz)
-					access.setPixel(colorB, x, y, z);
-				else
-					access.setPixel(colorA, x, y, z);
+				row[x] = (mx ^ my ^ mz) ? colorB : colorA;
 			}
+
+			writePixelRow(access, row, y, z);
 		}
 	}
 }
@@ -735,6 +784,8 @@ void fillWithGrid (const PixelBufferAccess& access, int cellSize, const Vec4& co
 
 void fillWithRepeatableGradient (const PixelBufferAccess& access, const Vec4& colorA, const Vec4& colorB)
 {
+	std::vector<Vec4> row (access.getWidth());
+
 	for (int y = 0; y < access.getHeight(); y++)
 	{
 		for (int x = 0; x < access.getWidth(); x++)
@@ -746,8 +797,10 @@ void fillWithRepeatableGradient (const PixelBufferAccess& access, const Vec4& co
 			float b = t > 0.5f ? (2.0f - 2.0f*t) : 2.0f*t;
 
 			float p = deFloatClamp(deFloatSqrt(a*a + b*b), 0.0f, 1.0f);
-			access.setPixel(linearInterpolate(p, colorA, colorB), x, y);
+			row[x] = linearInterpolate(p, colorA, colorB);
 		}
+
+		writePixelRow(access, row, y, 0);
 	}
 }
 
@@ -770,6 +823,7 @@ void fillWithMetaballs (const PixelBufferAccess& dst, int numBalls, deUint32 see
 {
 	TCU_CHECK_INTERNAL(dst.getDepth() == 1);
 	std::vector<Vec2>	points(numBalls);
+	std::vector<Vec4>	row(dst.getWidth());
 	de::Random			rnd(seed);
 
 	for (int i = 0; i < numBalls; i++)
@@ -780,20 +834,24 @@ void fillWithMetaballs (const PixelBufferAccess& dst, int numBalls, deUint32 see
 	}
 
 	for (int y = 0; y < dst.getHeight(); y++)
-	for (int x = 0; x < dst.getWidth(); x++)
 	{
-		Vec2 p((float)x/(float)dst.getWidth(), (float)y/(float)dst.getHeight());
-
-		float sum = 0.0f;
-		for (std::vector<Vec2>::const_iterator i = points.begin(); i != points.end(); i++)
+		for (int x = 0; x < dst.getWidth(); x++)
 		{
-			Vec2	d = p - *i;
-			float	f = 0.01f / (d.x()*d.x() + d.y()*d.y());
+			Vec2 p((float)x/(float)dst.getWidth(), (float)y/(float)dst.getHeight());
+
+			float sum = 0.0f;
+			for (std::vector<Vec2>::const_iterator i = points.begin(); i != points.end(); i++)
+			{
+				Vec2	d = p - *i;
+				float	f = 0.01f / (d.x()*d.x() + d.y()*d.y());
+
+				sum += f;
+			}
 
-			sum += f;
+			row[x] = Vec4(sum);
 		}
 
-		dst.setPixel(Vec4(sum), x, y);
+		writePixelRow(dst, row, y, 0);
 	}
 }
 
@@ -838,10 +896,7 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 
 		if (dstHasDepth && srcHasDepth)
 		{
-			for (int z = 0; z < depth; z++)
-			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixDepth(src.getPixDepth(x, y, z), x, y, z);
+			copyPixelRows<float>(getEffectiveDepthStencilAccess(dst, Sampler::MODE_DEPTH), getEffectiveDepthStencilAccess(src, Sampler::MODE_DEPTH));
 		}
 		else if (dstHasDepth && !srcHasDepth)
 		{
@@ -851,10 +906,7 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 
 		if (dstHasStencil && srcHasStencil)
 		{
-			for (int z = 0; z < depth; z++)
-			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixStencil(src.getPixStencil(x, y, z), x, y, z);
+			copyPixelRows<deInt32>(getEffectiveDepthStencilAccess(dst, Sampler::MODE_STENCIL), getEffectiveDepthStencilAccess(src, Sampler::MODE_STENCIL));
 		}
 		else if (dstHasStencil && !srcHasStencil)
 		{
@@ -870,19 +922,9 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 		bool					dstIsInt	= dstClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || dstClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
 
 		if (srcIsInt && dstIsInt)
-		{
-			for (int z = 0; z < depth; z++)
-			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixelInt(x, y, z), x, y, z);
-		}
+			copyPixelRows<deInt32>(dst, src);
 		else
-		{
-			for (int z = 0; z < depth; z++)
-			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixel(x, y, z), x, y, z);
-		}
+			copyPixelRows<float>(dst, src);
 	}
 }
 
@@ -897,18 +939,28 @@ void scale (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, Sam
 	float sY = (float)src.getHeight() / (float)dst.getHeight();
 	float sZ = (float)src.getDepth() / (float)dst.getDepth();
 
+	std::vector<Vec4> row (dst.getWidth());
+
 	if (dst.getDepth() == 1 && src.getDepth() == 1)
 	{
 		for (int y = 0; y < dst.getHeight(); y++)
-		for (int x = 0; x < dst.getWidth(); x++)
-			dst.setPixel(src.sample2D(sampler, filter, (x+0.5f)*sX, (y+0.5f)*sY, 0), x, y);
+		{
+			for (int x = 0; x < dst.getWidth(); x++)
+				row[x] = src.sample2D(sampler, filter, (x+0.5f)*sX, (y+0.5f)*sY, 0);
+
+			writePixelRow(dst, row, y, 0);
+		}
 	}
 	else
 	{
 		for (int z = 0; z < dst.getDepth(); z++)
 		for (int y = 0; y < dst.getHeight(); y++)
-		for (int x = 0; x < dst.getWidth(); x++)
-			dst.setPixel(src.sample3D(sampler, filter, (x+0.5f)*sX, (y+0.5f)*sY, (z+0.5f)*sZ), x, y, z);
+		{
+			for (int x = 0; x < dst.getWidth(); x++)
+				row[x] = src.sample3D(sampler, filter, (x+0.5f)*sX, (y+0.5f)*sY, (z+0.5f)*sZ);
+
+			writePixelRow(dst, row, y, z);
+		}
 	}
 }
 
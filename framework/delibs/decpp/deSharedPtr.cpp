@@ -255,6 +255,21 @@ void SharedPtr_selfTest (void)
 		DE_TEST_ASSERT(!exists);
 	}
 
+	// Uniqueness test.
+	{
+		bool exists = false;
+		SharedPtr<Object> ptrA;
+		DE_TEST_ASSERT(!ptrA.isUnique());
+		ptrA = SharedPtr<Object>(new Object(exists));
+		DE_TEST_ASSERT(ptrA.isUnique());
+		{
+			SharedPtr<Object>	ptrB(ptrA);
+			WeakPtr<Object>		weak(ptrA);
+			DE_TEST_ASSERT(!ptrA.isUnique() && !ptrB.isUnique());
+		}
+		DE_TEST_ASSERT(ptrA.isUnique());
+	}
+
 	// Basic multi-reference via assignment to empty.
 	{
 		bool exists = false;
@@ -136,6 +136,8 @@ public:
 
 	operator					bool				(void) const throw() { return !!m_ptr;	}
 
+	bool						isUnique			(void) const throw();
+
 	void						swap				(SharedPtr<T>& other);
 
 	void						clear				(void);
@@ -442,6 +444,18 @@ inline bool operator!= (const SharedPtr<T>& a, const SharedPtr<U>& b) throw()
 	return a.get() != b.get();
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Check if this is the only SharedPtr owning the object
+ *
+ * \note WeakPtrs are not counted. Result may be stale if other threads
+ *		 copy or release pointers to the same object concurrently.
+ *//*--------------------------------------------------------------------*/
+template<typename T>
+inline bool SharedPtr<T>::isUnique (void) const throw()
+{
+	return m_state && m_state->strongRefCount == 1;
+}
+
 /** Swap pointer contents. */
 template<typename T>
 inline void SharedPtr<T>::swap (SharedPtr<T>& other)
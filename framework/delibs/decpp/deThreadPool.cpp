@@ -0,0 +1,355 @@
+/*-------------------------------------------------------------------------
+ * drawElements C++ Base Library
+ * -----------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Fixed-size worker thread pool.
+ *//*--------------------------------------------------------------------*/
+
+#include "deThreadPool.hpp"
+#include "deThread.hpp"
+#include "deSemaphore.hpp"
+#include "deAtomic.h"
+
+namespace de
+{
+
+class ThreadPoolWorker : public Thread
+{
+public:
+					ThreadPoolWorker	(ThreadPool& pool, int workerNdx);
+
+	void			run					(void);
+
+private:
+	ThreadPool&		m_pool;
+	const int		m_workerNdx;
+};
+
+struct ThreadPool::RunState
+{
+	Job* const			job;
+	const int			numItems;
+	volatile deInt32	nextItem;
+	int					numActiveWorkers;	//!< Pool workers executing items of this job, protected by ThreadPool::m_lock
+	bool				isWaiting;			//!< Caller waits for active workers, protected by ThreadPool::m_lock
+	Semaphore			done;
+
+	RunState (Job& job_, int numItems_)
+		: job				(&job_)
+		, numItems			(numItems_)
+		, nextItem			(0)
+		, numActiveWorkers	(0)
+		, isWaiting			(false)
+		, done				(0)
+	{
+	}
+};
+
+ThreadPoolWorker::ThreadPoolWorker (ThreadPool& pool, int workerNdx)
+	: m_pool		(pool)
+	, m_workerNdx	(workerNdx)
+{
+}
+
+void ThreadPoolWorker::run (void)
+{
+	for (;;)
+	{
+		m_pool.m_workAvailable.decrement();
+
+		if (!m_pool.executePendingRun(m_workerNdx))
+			break;
+	}
+}
+
+ThreadPool::ThreadPool (int numThreads)
+	: m_numThreads		(de::max(numThreads, 1))
+	, m_workAvailable	(0)
+	, m_stop			(false)
+{
+	try
+	{
+		for (int workerNdx = 1; workerNdx < m_numThreads; workerNdx++)
+		{
+			m_workers.push_back(DE_NULL);
+			m_workers.back() = new ThreadPoolWorker(*this, workerNdx);
+			m_workers.back()->start();
+		}
+	}
+	catch (...)
+	{
+		{
+			const ScopedLock lock (m_lock);
+			m_stop = true;
+		}
+
+		for (size_t ndx = 0; ndx < m_workers.size(); ndx++)
+			m_workAvailable.increment();
+
+		for (size_t ndx = 0; ndx < m_workers.size(); ndx++)
+		{
+			if (m_workers[ndx] && m_workers[ndx]->isStarted())
+				m_workers[ndx]->join();
+			delete m_workers[ndx];
+		}
+		throw;
+	}
+}
+
+ThreadPool::~ThreadPool (void)
+{
+	DE_ASSERT(m_pendingRuns.empty());
+
+	{
+		const ScopedLock lock (m_lock);
+		m_stop = true;
+	}
+
+	for (size_t ndx = 0; ndx < m_workers.size(); ndx++)
+		m_workAvailable.increment();
+
+	for (size_t ndx = 0; ndx < m_workers.size(); ndx++)
+	{
+		m_workers[ndx]->join();
+		delete m_workers[ndx];
+	}
+}
+
+void ThreadPool::executeItems (RunState& state, int workerNdx)
+{
+	for (;;)
+	{
+		const int itemNdx = deAtomicIncrement32(&state.nextItem) - 1;
+
+		if (itemNdx >= state.numItems)
+			break;
+
+		state.job->execute(itemNdx, workerNdx);
+	}
+}
+
+void ThreadPool::removePendingRun (RunState* state)
+{
+	for (std::vector<RunState*>::iterator iter = m_pendingRuns.begin(); iter != m_pendingRuns.end(); ++iter)
+	{
+		if (*iter == state)
+		{
+			m_pendingRuns.erase(iter);
+			break;
+		}
+	}
+}
+
+//! Help with the oldest job that still has items left. Called by pool workers, returns false if the worker should stop.
+bool ThreadPool::executePendingRun (int workerNdx)
+{
+	RunState* state = DE_NULL;
+
+	{
+		const ScopedLock lock (m_lock);
+
+		if (m_stop)
+			return false;
+
+		if (m_pendingRuns.empty())
+			return true; // Job was finished by other threads before this worker woke up
+
+		state = m_pendingRuns.front();
+		state->numActiveWorkers += 1;
+	}
+
+	executeItems(*state, workerNdx);
+
+	{
+		const ScopedLock lock (m_lock);
+
+		// All items have been handed out
+		removePendingRun(state);
+
+		state->numActiveWorkers -= 1;
+
+		if (state->numActiveWorkers == 0 && state->isWaiting)
+			state->done.increment();
+	}
+
+	return true;
+}
+
+void ThreadPool::run (Job& job, int numItems)
+{
+	if (numItems <= 0)
+		return;
+
+	if (m_workers.empty() || numItems == 1)
+	{
+		for (int itemNdx = 0; itemNdx < numItems; itemNdx++)
+			job.execute(itemNdx, 0);
+		return;
+	}
+
+	{
+		RunState	state		(job, numItems);
+		const int	numWakeups	= de::min((int)m_workers.size(), numItems-1);
+		bool		needWait	= false;
+
+		{
+			const ScopedLock lock (m_lock);
+			m_pendingRuns.push_back(&state);
+		}
+
+		for (int ndx = 0; ndx < numWakeups; ndx++)
+			m_workAvailable.increment();
+
+		executeItems(state, 0);
+
+		// No worker can join the job after it has been removed, wait for the ones still executing items
+		{
+			const ScopedLock lock (m_lock);
+
+			removePendingRun(&state);
+
+			state.isWaiting	= state.numActiveWorkers > 0;
+			needWait		= state.isWaiting;
+		}
+
+		if (needWait)
+			state.done.decrement();
+	}
+}
+
+namespace
+{
+
+class CountJob : public ThreadPool::Job
+{
+public:
+	CountJob (int numItems, int numThreads)
+		: m_itemCounts		(numItems, 0)
+		, m_workerCounts	(numThreads, 0)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		// Items are never shared between workers, so no locking is required
+		m_itemCounts[itemNdx]		+= 1;
+		m_workerCounts[workerNdx]	+= 1;
+	}
+
+	std::vector<int>	m_itemCounts;
+	std::vector<int>	m_workerCounts;
+};
+
+void poolTest (int numThreads, int numItems, int numRuns)
+{
+	ThreadPool	pool	(numThreads);
+	CountJob	job		(numItems, pool.getNumThreads());
+
+	DE_TEST_ASSERT(pool.getNumThreads() == de::max(numThreads, 1));
+
+	for (int runNdx = 0; runNdx < numRuns; runNdx++)
+		pool.run(job, numItems);
+
+	{
+		int totalCount = 0;
+
+		for (int itemNdx = 0; itemNdx < numItems; itemNdx++)
+			DE_TEST_ASSERT(job.m_itemCounts[itemNdx] == numRuns);
+
+		for (int workerNdx = 0; workerNdx < pool.getNumThreads(); workerNdx++)
+			totalCount += job.m_workerCounts[workerNdx];
+
+		DE_TEST_ASSERT(totalCount == numItems*numRuns);
+	}
+}
+
+class RunnerThread : public Thread
+{
+public:
+	RunnerThread (ThreadPool& pool, int numItems, int numRuns)
+		: m_pool		(pool)
+		, m_job			(numItems, pool.getNumThreads())
+		, m_numItems	(numItems)
+		, m_numRuns		(numRuns)
+	{
+	}
+
+	void run (void)
+	{
+		for (int runNdx = 0; runNdx < m_numRuns; runNdx++)
+			m_pool.run(m_job, m_numItems);
+	}
+
+	bool isComplete (void) const
+	{
+		for (int itemNdx = 0; itemNdx < m_numItems; itemNdx++)
+		{
+			if (m_job.m_itemCounts[itemNdx] != m_numRuns)
+				return false;
+		}
+		return true;
+	}
+
+private:
+	ThreadPool&		m_pool;
+	CountJob		m_job;
+	const int		m_numItems;
+	const int		m_numRuns;
+};
+
+//! Jobs run concurrently from multiple threads must all complete fully
+void concurrentRunTest (int numThreads, int numRunners, int numItems, int numRuns)
+{
+	ThreadPool					pool	(numThreads);
+	std::vector<RunnerThread*>	runners;
+
+	for (int runnerNdx = 0; runnerNdx < numRunners; runnerNdx++)
+		runners.push_back(new RunnerThread(pool, numItems + runnerNdx, numRuns));
+
+	for (int runnerNdx = 0; runnerNdx < numRunners; runnerNdx++)
+		runners[runnerNdx]->start();
+
+	for (int runnerNdx = 0; runnerNdx < numRunners; runnerNdx++)
+		runners[runnerNdx]->join();
+
+	for (int runnerNdx = 0; runnerNdx < numRunners; runnerNdx++)
+	{
+		DE_TEST_ASSERT(runners[runnerNdx]->isComplete());
+		delete runners[runnerNdx];
+	}
+}
+
+} // anonymous
+
+void ThreadPool_selfTest (void)
+{
+	poolTest(0,		10,		1);
+	poolTest(1,		10,		3);
+	poolTest(2,		0,		3);
+	poolTest(2,		1,		3);
+	poolTest(2,		100,	10);
+	poolTest(4,		3,		50);
+	poolTest(8,		1000,	20);
+
+	concurrentRunTest(2,	2,	10,		20);
+	concurrentRunTest(4,	4,	100,	20);
+	concurrentRunTest(8,	3,	1000,	5);
+}
+
+} // de
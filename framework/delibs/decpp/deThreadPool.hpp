@@ -0,0 +1,98 @@
+#ifndef _DETHREADPOOL_HPP
+#define _DETHREADPOOL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements C++ Base Library
+ * -----------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Fixed-size worker thread pool.
+ *//*--------------------------------------------------------------------*/
+
+#include "deDefs.hpp"
+#include "deMutex.hpp"
+#include "deSemaphore.hpp"
+
+#include <vector>
+
+namespace de
+{
+
+class ThreadPoolWorker;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Fixed-size worker thread pool
+ *
+ * ThreadPool runs a job consisting of numItems independent work items on
+ * a set of persistent worker threads. The calling thread participates in
+ * the work as worker 0, so a pool created with numThreads == 1 doesn't
+ * spawn any threads and executes everything on the calling thread.
+ *
+ * Items are handed out dynamically in increasing order. Each item is
+ * executed exactly once, and the worker index passed to Job::execute()
+ * is stable for the duration of the item so that jobs can keep per-worker
+ * scratch data in an array of getNumThreads() elements.
+ *
+ * run() returns only after all items of the job have been executed.
+ * run() may be called concurrently from multiple threads. Concurrent jobs
+ * share the worker threads and each caller waits only for its own job,
+ * so a single pool can be shared by independent users.
+ *
+ * \note Job::execute() must not throw.
+ *//*--------------------------------------------------------------------*/
+class ThreadPool
+{
+public:
+	class Job
+	{
+	public:
+		virtual			~Job		(void) {}
+		virtual void	execute		(int itemNdx, int workerNdx) = 0;
+	};
+
+							ThreadPool		(int numThreads);
+							~ThreadPool		(void);
+
+	int						getNumThreads	(void) const { return m_numThreads; }
+	void					run				(Job& job, int numItems);
+
+private:
+							ThreadPool		(const ThreadPool&); // not allowed!
+	ThreadPool&				operator=		(const ThreadPool&); // not allowed!
+
+	friend class ThreadPoolWorker;
+
+	struct RunState;
+
+	void					executeItems		(RunState& state, int workerNdx);
+	bool					executePendingRun	(int workerNdx);
+	void					removePendingRun	(RunState* state);
+
+	const int						m_numThreads;
+	std::vector<ThreadPoolWorker*>	m_workers;
+
+	Mutex							m_lock;				//!< Protects m_pendingRuns, m_stop and RunState worker counts
+	std::vector<RunState*>			m_pendingRuns;		//!< Jobs with items not yet handed out, in start order
+	Semaphore						m_workAvailable;	//!< Wakes up idle workers
+	bool							m_stop;
+};
+
+void	ThreadPool_selfTest		(void);
+
+} // de
+
+#endif // _DETHREADPOOL_HPP
@@ -24,6 +24,12 @@
 #include "deFile.h"
 #include "deMemory.h"
 
+struct deMappedFile_s
+{
+	void*	data;
+	deInt64	size;
+};
+
 #if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX) || (DE_OS == DE_OS_IOS) || (DE_OS == DE_OS_ANDROID) || (DE_OS == DE_OS_SYMBIAN)
 
 #include <sys/types.h>
@@ -31,6 +37,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <sys/mman.h>
 
 struct deFile_s
 {
@@ -203,6 +210,59 @@ deFileResult deFile_write (deFile* file, const void* buf, deInt64 bufSize, deInt
 	return mapReadWriteResult(numWritten);
 }
 
+deMappedFile* deMappedFile_create (const char* filename)
+{
+	int				fd		= open(filename, O_RDONLY);
+	struct stat		st;
+	deMappedFile*	file	= DE_NULL;
+
+	if (fd < 0)
+		return DE_NULL;
+
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+		close(fd);
+		return DE_NULL;
+	}
+
+	file = (deMappedFile*)deCalloc(sizeof(deMappedFile));
+	if (!file)
+	{
+		close(fd);
+		return DE_NULL;
+	}
+
+	file->size = (deInt64)st.st_size;
+
+	/* Empty files can't be mapped. */
+	if (file->size > 0)
+	{
+		void* data = mmap(DE_NULL, (size_t)file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (data == MAP_FAILED)
+		{
+			close(fd);
+			deFree(file);
+			return DE_NULL;
+		}
+
+		file->data = data;
+	}
+
+	/* Mapping stays valid after closing the descriptor. */
+	close(fd);
+
+	return file;
+}
+
+void deMappedFile_destroy (deMappedFile* file)
+{
+	if (file->data)
+		munmap(file->data, (size_t)file->size);
+
+	deFree(file);
+}
+
 #elif (DE_OS == DE_OS_WIN32)
 
 #define VC_EXTRALEAN
@@ -395,6 +455,76 @@ deFileResult deFile_write (deFile* file, const void* buf, deInt64 bufSize, deInt
 	return mapReadWriteResult(result, numWritten32);
 }
 
+deMappedFile* deMappedFile_create (const char* filename)
+{
+	HANDLE			handle		= CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, DE_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, DE_NULL);
+	HANDLE			mapping		= DE_NULL;
+	DWORD			highBits	= 0;
+	DWORD			lowBits		= 0;
+	deMappedFile*	file		= DE_NULL;
+
+	if (handle == INVALID_HANDLE_VALUE)
+		return DE_NULL;
+
+	lowBits = GetFileSize(handle, &highBits);
+	if (lowBits == INVALID_FILE_SIZE && GetLastError() != NO_ERROR)
+	{
+		CloseHandle(handle);
+		return DE_NULL;
+	}
+
+	file = (deMappedFile*)deCalloc(sizeof(deMappedFile));
+	if (!file)
+	{
+		CloseHandle(handle);
+		return DE_NULL;
+	}
+
+	file->size = (deInt64)(((deUint64)highBits << 32) | (deUint64)lowBits);
+
+	/* Empty files can't be mapped. */
+	if (file->size > 0)
+	{
+		mapping = CreateFileMapping(handle, DE_NULL, PAGE_READONLY, 0, 0, DE_NULL);
+
+		if (mapping)
+		{
+			file->data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+
+		if (!file->data)
+		{
+			CloseHandle(handle);
+			deFree(file);
+			return DE_NULL;
+		}
+	}
+
+	/* View stays valid after closing the file and mapping handles. */
+	CloseHandle(handle);
+
+	return file;
+}
+
+void deMappedFile_destroy (deMappedFile* file)
+{
+	if (file->data)
+		UnmapViewOfFile(file->data);
+
+	deFree(file);
+}
+
 #else
 #	error Implement deFile for your OS.
 #endif
+
+const void* deMappedFile_getData (const deMappedFile* file)
+{
+	return file->data;
+}
+
+deInt64 deMappedFile_getSize (const deMappedFile* file)
+{
+	return file->size;
+}
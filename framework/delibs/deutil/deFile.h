@@ -29,6 +29,7 @@ DE_BEGIN_EXTERN_C
 
 /* File types. */
 typedef struct deFile_s deFile;
+typedef struct deMappedFile_s deMappedFile;
 
 typedef enum deFileMode_e
 {
@@ -82,6 +83,14 @@ deInt64			deFile_getSize			(const deFile* file);
 deFileResult	deFile_read				(deFile* file, void* buf, deInt64 bufSize, deInt64* numRead);
 deFileResult	deFile_write			(deFile* file, const void* buf, deInt64 bufSize, deInt64* numWritten);
 
+/* Read-only memory-mapped file API. */
+
+deMappedFile*	deMappedFile_create		(const char* filename);
+void			deMappedFile_destroy	(deMappedFile* file);
+
+const void*		deMappedFile_getData	(const deMappedFile* file);
+deInt64			deMappedFile_getSize	(const deMappedFile* file);
+
 DE_END_EXTERN_C
 
 #endif /* _DEFILE_H */
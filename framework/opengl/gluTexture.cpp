@@ -97,6 +97,8 @@ void Texture1D::upload (void)
 		gl.texImage1D(GL_TEXTURE_1D, levelNdx, m_format, access.getWidth(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -181,6 +183,8 @@ void Texture2D::upload (void)
 		gl.texImage2D(GL_TEXTURE_2D, levelNdx, m_format, access.getWidth(), access.getHeight(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -369,6 +373,8 @@ void TextureCube::upload (void)
 		}
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -487,6 +493,8 @@ void Texture1DArray::upload (void)
 		gl.texImage2D(GL_TEXTURE_1D_ARRAY, levelNdx, m_format, access.getWidth(), access.getHeight(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -575,6 +583,8 @@ void Texture2DArray::upload (void)
 		gl.texImage3D(GL_TEXTURE_2D_ARRAY, levelNdx, m_format, access.getWidth(), access.getHeight(), access.getDepth(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -697,6 +707,8 @@ void Texture3D::upload (void)
 		gl.texImage3D(GL_TEXTURE_3D, levelNdx, m_format, access.getWidth(), access.getHeight(), access.getDepth(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
@@ -788,6 +800,8 @@ void TextureCubeArray::upload (void)
 		gl.texImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, levelNdx, m_format, access.getWidth(), access.getHeight(), access.getDepth(), 0 /* border */, transferFormat.format, transferFormat.dataType, access.getDataPtr());
 	}
 
+	m_refTexture.finishLevelWrites();
+
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
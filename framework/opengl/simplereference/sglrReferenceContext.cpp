@@ -4292,7 +4292,6 @@ void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, i
 													 (m_currentProgram->m_program->m_hasGeometryShader) ? (m_currentProgram->m_program->getGeometryShader()) : (DE_NULL));
 	rr::RenderState						state		((rr::ViewportState)(colorBuf0));
 
-	const rr::Renderer					referenceRenderer;
 	std::vector<rr::VertexAttrib>		vertexAttribs;
 
 	// Gen state
@@ -4530,7 +4529,7 @@ void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, i
 		}
 	}
 
-	referenceRenderer.drawInstanced(rr::DrawCommand(state, renderTarget, program, (int)vertexAttribs.size(), &vertexAttribs[0], primitives), instanceCount);
+	m_renderer.drawInstanced(rr::DrawCommand(state, renderTarget, program, (int)vertexAttribs.size(), &vertexAttribs[0], primitives), instanceCount);
 }
 
 deUint32 ReferenceContext::createProgram (ShaderProgram* program)
@@ -4780,7 +4779,7 @@ bool Texture1D::isComplete (void) const
 
 tcu::Vec4 Texture1D::sample (float s, float lod) const
 {
-	return m_view.sample(getSampler(), s, 0.0f, lod);
+	return m_view.sample(m_compiledSampler, s, 0.0f, lod);
 }
 
 void Texture1D::sample4 (tcu::Vec4 output[4], const float packetTexcoords[4], float lodBias) const
@@ -4818,9 +4817,13 @@ void Texture1D::updateView (tcu::Sampler::DepthStencilMode mode)
 
 		m_levels.updateSamplerMode(mode);
 		m_view = tcu::Texture2DView(numLevels, m_levels.getEffectiveLevels() + baseLevel);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevel(0).getFormat());
 	}
 	else
+	{
 		m_view = tcu::Texture2DView(0, DE_NULL);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 Texture2D::Texture2D (deUint32 name)
@@ -4892,14 +4895,18 @@ void Texture2D::updateView (tcu::Sampler::DepthStencilMode mode)
 
 		m_levels.updateSamplerMode(mode);
 		m_view = tcu::Texture2DView(numLevels, m_levels.getEffectiveLevels() + baseLevel);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevel(0).getFormat());
 	}
 	else
+	{
 		m_view = tcu::Texture2DView(0, DE_NULL);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 tcu::Vec4 Texture2D::sample (float s, float t, float lod) const
 {
-	return m_view.sample(getSampler(), s, t, lod);
+	return m_view.sample(m_compiledSampler, s, t, lod);
 }
 
 void Texture2D::sample4 (tcu::Vec4 output[4], const tcu::Vec2 packetTexcoords[4], float lodBias) const
@@ -5010,14 +5017,18 @@ void TextureCube::updateView (tcu::Sampler::DepthStencilMode mode)
 		}
 
 		m_view = tcu::TextureCubeView(numLevels, faces);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevelFace(0, tcu::CUBEFACE_NEGATIVE_X).getFormat());
 	}
 	else
+	{
 		m_view = tcu::TextureCubeView(0, faces);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 tcu::Vec4 TextureCube::sample (float s, float t, float p, float lod) const
 {
-	return m_view.sample(getSampler(), s, t, p, lod);
+	return m_view.sample(m_compiledSampler, s, t, p, lod);
 }
 
 void TextureCube::sample4 (tcu::Vec4 output[4], const tcu::Vec3 packetTexcoords[4], float lodBias) const
@@ -5125,14 +5136,18 @@ void Texture2DArray::updateView (tcu::Sampler::DepthStencilMode mode)
 
 		m_levels.updateSamplerMode(mode);
 		m_view = tcu::Texture2DArrayView(numLevels, m_levels.getEffectiveLevels() + baseLevel);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevel(0).getFormat());
 	}
 	else
+	{
 		m_view = tcu::Texture2DArrayView(0, DE_NULL);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 tcu::Vec4 Texture2DArray::sample (float s, float t, float r, float lod) const
 {
-	return m_view.sample(getSampler(), s, t, r, lod);
+	return m_view.sample(m_compiledSampler, s, t, r, lod);
 }
 
 void Texture2DArray::sample4 (tcu::Vec4 output[4], const tcu::Vec3 packetTexcoords[4], float lodBias) const
@@ -5231,14 +5246,18 @@ void TextureCubeArray::updateView (tcu::Sampler::DepthStencilMode mode)
 
 		m_levels.updateSamplerMode(mode);
 		m_view = tcu::TextureCubeArrayView(numLevels, m_levels.getEffectiveLevels() + baseLevel);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevel(0).getFormat());
 	}
 	else
+	{
 		m_view = tcu::TextureCubeArrayView(0, DE_NULL);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 tcu::Vec4 TextureCubeArray::sample (float s, float t, float r, float q, float lod) const
 {
-	return m_view.sample(getSampler(), s, t, r, q, lod);
+	return m_view.sample(m_compiledSampler, s, t, r, q, lod);
 }
 
 void TextureCubeArray::sample4 (tcu::Vec4 output[4], const tcu::Vec4 packetTexcoords[4], float lodBias) const
@@ -5341,7 +5360,7 @@ bool Texture3D::isComplete (void) const
 
 tcu::Vec4 Texture3D::sample (float s, float t, float r, float lod) const
 {
-	return m_view.sample(getSampler(), s, t, r, lod);
+	return m_view.sample(m_compiledSampler, s, t, r, lod);
 }
 
 void Texture3D::sample4 (tcu::Vec4 output[4], const tcu::Vec3 packetTexcoords[4], float lodBias) const
@@ -5385,9 +5404,13 @@ void Texture3D::updateView (tcu::Sampler::DepthStencilMode mode)
 
 		m_levels.updateSamplerMode(mode);
 		m_view = tcu::Texture3DView(numLevels, m_levels.getEffectiveLevels() + baseLevel);
+		m_compiledSampler = tcu::CompiledSampler(getSampler(), m_view.getLevel(0).getFormat());
 	}
 	else
+	{
 		m_view = tcu::Texture3DView(0, DE_NULL);
+		m_compiledSampler = tcu::CompiledSampler();
+	}
 }
 
 Renderbuffer::Renderbuffer (deUint32 name)
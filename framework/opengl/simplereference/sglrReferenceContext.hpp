@@ -162,6 +162,7 @@ public:
 private:
 	TextureLevelArray					m_levels;
 	tcu::Texture2DView					m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class Texture2D : public Texture
@@ -188,6 +189,7 @@ public:
 private:
 	TextureLevelArray					m_levels;
 	tcu::Texture2DView					m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class TextureCube : public Texture
@@ -213,6 +215,7 @@ public:
 private:
 	TextureLevelArray					m_levels[tcu::CUBEFACE_LAST];
 	tcu::TextureCubeView				m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class Texture2DArray : public Texture
@@ -239,6 +242,7 @@ public:
 private:
 	TextureLevelArray					m_levels;
 	tcu::Texture2DArrayView				m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class Texture3D : public Texture
@@ -265,6 +269,7 @@ public:
 private:
 	TextureLevelArray					m_levels;
 	tcu::Texture3DView					m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class TextureCubeArray : public Texture
@@ -291,6 +296,7 @@ public:
 private:
 	TextureLevelArray					m_levels;
 	tcu::TextureCubeArrayView			m_view;
+	tcu::CompiledSampler				m_compiledSampler;	//!< Sampler state resolved against m_view in updateView().
 };
 
 class Renderbuffer : public NamedObject
@@ -961,6 +967,7 @@ private:
 
 	deUint32									m_lastError;
 
+	rr::Renderer								m_renderer;
 	rr::FragmentProcessor						m_fragmentProcessor;
 	std::vector<rr::Fragment>					m_fragmentBuffer;
 	std::vector<float>							m_fragmentDepths;
@@ -235,6 +235,9 @@ public:
 	inline const rr::FragmentShader*		getFragmentShader	(void) const { return static_cast<const rr::FragmentShader*>(this); }
 	inline const rr::GeometryShader*		getGeometryShader	(void) const { return static_cast<const rr::GeometryShader*>(this); }
 
+	//! Programs that modify shared state while shading must return false so that they are not shaded from multiple threads.
+	virtual bool							isThreadSafe		(void) const { return true; }
+
 private:
 	virtual void							shadeVertices		(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const = 0;
 	virtual void							shadeFragments		(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const = 0;
@@ -80,5 +80,11 @@ int AssetResource::getSize (void) const
 	return (int)AAsset_getLength(m_asset);
 }
 
+const deUint8* AssetResource::getData (void) const
+{
+	// Maps uncompressed assets, compressed assets are inflated to memory
+	return (const deUint8*)AAsset_getBuffer(m_asset);
+}
+
 } // Android
 } // tcu
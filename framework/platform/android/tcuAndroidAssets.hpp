@@ -56,6 +56,7 @@ public:
 	void				setPosition			(int position);
 	bool				isFinished			(void) const;
 	int					getSize				(void) const;
+	const deUint8*		getData				(void) const;
 
 private:
 						AssetResource		(const AssetResource& other);
@@ -34,6 +34,14 @@
 // Implement this in your platform port.
 tcu::Platform* createPlatform (void);
 
+static tcu::Archive* createArchive (const tcu::CommandLine& cmdLine)
+{
+	if (cmdLine.getResourcePackFileName())
+		return new tcu::PackedArchive(cmdLine.getResourcePackFileName());
+	else
+		return new tcu::MappedDirArchive(".");
+}
+
 int main (int argc, const char* argv[])
 {
 #if (DE_OS != DE_OS_WIN32)
@@ -44,10 +52,10 @@ int main (int argc, const char* argv[])
 	try
 	{
 		tcu::CommandLine				cmdLine		(argc, argv);
-		tcu::DirArchive					archive		(".");
+		de::UniquePtr<tcu::Archive>		archive		(createArchive(cmdLine));
 		tcu::TestLog					log			(cmdLine.getLogFileName(), cmdLine.getLogFlags());
 		de::UniquePtr<tcu::Platform>	platform	(createPlatform());
-		de::UniquePtr<tcu::App>			app			(new tcu::App(*platform, archive, log, cmdLine));
+		de::UniquePtr<tcu::App>			app			(new tcu::App(*platform, *archive, log, cmdLine));
 
 		// Main loop.
 		for (;;)
@@ -31,14 +31,22 @@
 #include "deString.h"
 
 #include "deMutex.h"
+#include "deSemaphore.h"
+#include "deThread.h"
+#include "deClock.h"
+
+#include "deMemPool.h"
+#include "dePoolSet.h"
 
 #if defined(QP_SUPPORT_PNG)
 #	include <png.h>
+#	include <zlib.h>
 #endif
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 
 #if (DE_OS == DE_OS_WIN32)
 #	include <windows.h>
@@ -119,6 +127,30 @@ DE_INLINE ContainerType ContainerStack_getTop (const ContainerStack* stack)
 
 #endif
 
+/* Set of image content hashes. */
+DE_DECLARE_POOL_SET(qpImageHashSet, deUint64);
+DE_IMPLEMENT_POOL_SET(qpImageHashSet, deUint64, deUint64Hash, deUint64Equal);
+
+/* Growable byte buffer. */
+typedef struct Buffer_s
+{
+	int			capacity;
+	int			size;
+	deUint8*	data;
+} Buffer;
+
+void	Buffer_deinit	(Buffer* buffer);
+
+/* Referenceable image, stored in write order. */
+typedef struct LoggedImage_s
+{
+	deUint64	hash;
+	size_t		numBytes;		/*!< Size of image data in <Image> element.	*/
+} LoggedImage;
+
+typedef struct PendingImage_s PendingImage;
+typedef struct OutputBuffer_s OutputBuffer;
+
 /* qpTestLog instance */
 struct qpTestLog_s
 {
@@ -128,13 +160,37 @@ struct qpTestLog_s
 
 	/* State protected by lock. */
 	FILE*					outputFile;
+	OutputBuffer*			outputBuffer;		/*!< Buffered output, null when writing directly to file.	*/
 	qpXmlWriter*			writer;
+	qpTestLogBufferConfig	bufferConfig;
+	int						numCasesSinceFlush;
+	deUint64				lastFlushTime;		/*!< Time of last flush in microseconds.	*/
 	deBool					isSessionOpen;
 	deBool					isCaseOpen;
+	PendingImage*			pendingHead;		/*!< Images waiting to be written.		*/
+	PendingImage*			pendingTail;
+	deThread*				encoderThreads;
+	deMemPool*				imageHashPool;
+	qpImageHashSet*			loggedImages;		/*!< Images written in completed test cases.	*/
+	qpImageHashSet*			caseImages;			/*!< Images written in current test case.		*/
+	Buffer					loggedImageOrder;	/*!< LoggedImage entries of loggedImages, oldest first.		*/
+	int						firstLoggedImage;	/*!< Index of oldest entry in loggedImageOrder.				*/
+	size_t					loggedImageBytes;	/*!< Image data in loggedImages.							*/
+	Buffer					caseImageOrder;		/*!< LoggedImage entries of written caseImages in order.	*/
 
 #if defined(DE_DEBUG)
 	ContainerStack			containerStack;		/*!< For container usage verification.	*/
 #endif
+
+	deMutex					imageLock;			/*!< Lock for image encoder state below.	*/
+
+	/* State protected by imageLock. */
+	qpImageEncoderConfig	imageEncoderConfig;
+	int						numEncoderThreads;
+	PendingImage*			nextEncodeJob;		/*!< First pending image not yet claimed by an encoder thread.	*/
+	size_t					pendingBytes;		/*!< Pixel and compressed data held by pending images.			*/
+
+	deSemaphore				encodeJobs;			/*!< Queued images and encoder thread stop requests.	*/
 };
 
 /* Maps integer to string. */
@@ -144,7 +200,11 @@ typedef struct qpKeyStringMap_s
 	char*	string;
 } qpKeyStringMap;
 
-static const char* LOG_FORMAT_VERSION = "0.3.3";
+static const char* LOG_FORMAT_VERSION			= "0.3.3";
+static const char* LOG_FORMAT_VERSION_DEDUP		= "0.3.4"; /* Image Hash and Ref attributes. */
+
+static const char		s_binaryLogMagic[]	= { 'd', 'E', 'Q', 'P', 'b', 'l', 'o', 'g' };
+static const deUint32	BINARY_LOG_VERSION	= 1;
 
 /* Mapping enum to above strings... */
 static const qpKeyStringMap s_qpTestTypeMap[] =
@@ -248,16 +308,371 @@ static const qpKeyStringMap s_qpShaderTypeMap[] =
 
 DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_qpShaderTypeMap) == QP_SHADER_TYPE_LAST + 1);
 
-static void qpTestLog_flushFile (qpTestLog* log)
+static void flushOutputFile (FILE* file)
 {
-	DE_ASSERT(log && log->outputFile);
-	fflush(log->outputFile);
+	DE_ASSERT(file);
+	fflush(file);
 #if (DE_OS == DE_OS_WIN32) && (DE_COMPILER == DE_COMPILER_MSC)
 	/* \todo [petri] Is this really necessary? */
-	FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(log->outputFile)));
+	FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(file)));
 #endif
 }
 
+/* Buffered output.
+ *
+ * Log output is copied into a ring buffer by the thread holding log lock
+ * and written to file by a writer thread. Written data is handed to the
+ * writer thread in batches so that most writes take no locks and make no
+ * system calls.
+ */
+
+struct OutputBuffer_s
+{
+	FILE*			file;
+	deUint8*		data;
+	size_t			size;
+	deThread		thread;
+
+	/* Producer state, accessed only by thread holding log lock. */
+	deUint64		writePos;			/*!< Total bytes written to buffer.				*/
+	deUint64		publishedPos;		/*!< Write position last handed to writer.		*/
+	deUint64		knownReadPos;		/*!< Read position when last synchronized.		*/
+
+	deMutex			lock;				/*!< Lock for shared state below.				*/
+
+	/* State protected by lock. */
+	deUint64		availablePos;		/*!< Data before this position can be written to file.	*/
+	deUint64		readPos;			/*!< Data before this position has been written to file.	*/
+	deBool			isWriteRequested;
+	deBool			isFlushRequested;
+	deBool			isWaitingForFlush;
+	deBool			isWaitingForSpace;
+	deBool			isStopRequested;
+
+	deSemaphore		writeRequest;		/*!< Wakes up writer thread.			*/
+	deSemaphore		spaceFreed;			/*!< Signaled if producer waits for space.	*/
+	deSemaphore		flushDone;			/*!< Signaled if producer waits for flush.	*/
+};
+
+static void outputWriterThread (void* arg)
+{
+	OutputBuffer*	buffer			= (OutputBuffer*)arg;
+	deBool			isStopRequested	= DE_FALSE;
+
+	while (!isStopRequested)
+	{
+		deUint64	readPos;
+		deUint64	availablePos;
+		deBool		isFlushRequested;
+		deBool		isWaitingForFlush;
+
+		deSemaphore_decrement(buffer->writeRequest);
+
+		deMutex_lock(buffer->lock);
+		readPos						= buffer->readPos;
+		availablePos				= buffer->availablePos;
+		isFlushRequested			= buffer->isFlushRequested;
+		isWaitingForFlush			= buffer->isWaitingForFlush;
+		isStopRequested				= buffer->isStopRequested;
+		buffer->isWriteRequested	= DE_FALSE;
+		buffer->isFlushRequested	= DE_FALSE;
+		buffer->isWaitingForFlush	= DE_FALSE;
+		deMutex_unlock(buffer->lock);
+
+		while (readPos < availablePos)
+		{
+			const size_t	offset		= (size_t)(readPos % buffer->size);
+			size_t			numBytes	= buffer->size - offset;
+
+			if ((deUint64)numBytes > availablePos - readPos)
+				numBytes = (size_t)(availablePos - readPos);
+
+			fwrite(buffer->data + offset, 1, numBytes, buffer->file);
+			readPos += numBytes;
+
+			deMutex_lock(buffer->lock);
+			buffer->readPos = readPos;
+			if (buffer->isWaitingForSpace)
+			{
+				buffer->isWaitingForSpace = DE_FALSE;
+				deSemaphore_increment(buffer->spaceFreed);
+			}
+			deMutex_unlock(buffer->lock);
+		}
+
+		if (isFlushRequested)
+			flushOutputFile(buffer->file);
+
+		if (isWaitingForFlush)
+			deSemaphore_increment(buffer->flushDone);
+	}
+}
+
+/* Caller must hold buffer lock. */
+static void OutputBuffer_requestWrite (OutputBuffer* buffer)
+{
+	if (!buffer->isWriteRequested)
+	{
+		buffer->isWriteRequested = DE_TRUE;
+		deSemaphore_increment(buffer->writeRequest);
+	}
+}
+
+/* Hand written data to writer thread and optionally flush file. Caller must hold log lock. */
+static void OutputBuffer_publish (OutputBuffer* buffer, deBool flush, deBool waitForFlush)
+{
+	DE_ASSERT(flush || !waitForFlush);
+
+	deMutex_lock(buffer->lock);
+	buffer->availablePos	= buffer->writePos;
+	buffer->knownReadPos	= buffer->readPos;
+
+	if (flush)
+		buffer->isFlushRequested = DE_TRUE;
+
+	if (waitForFlush)
+		buffer->isWaitingForFlush = DE_TRUE;
+
+	OutputBuffer_requestWrite(buffer);
+	deMutex_unlock(buffer->lock);
+
+	buffer->publishedPos = buffer->writePos;
+
+	if (waitForFlush)
+		deSemaphore_decrement(buffer->flushDone);
+}
+
+/* Wait until writer thread has freed space in buffer. Caller must hold log lock. */
+static void OutputBuffer_waitForSpace (OutputBuffer* buffer)
+{
+	deMutex_lock(buffer->lock);
+	buffer->availablePos = buffer->writePos;
+
+	if (buffer->writePos - buffer->readPos == (deUint64)buffer->size)
+	{
+		buffer->isWaitingForSpace = DE_TRUE;
+		OutputBuffer_requestWrite(buffer);
+		deMutex_unlock(buffer->lock);
+
+		deSemaphore_decrement(buffer->spaceFreed);
+
+		deMutex_lock(buffer->lock);
+	}
+
+	buffer->knownReadPos = buffer->readPos;
+	deMutex_unlock(buffer->lock);
+
+	buffer->publishedPos = buffer->writePos;
+}
+
+/* Caller must hold log lock. */
+static void OutputBuffer_write (OutputBuffer* buffer, const void* data, size_t numBytes)
+{
+	const deUint8* src = (const deUint8*)data;
+
+	while (numBytes > 0)
+	{
+		const size_t	offset		= (size_t)(buffer->writePos % buffer->size);
+		const size_t	numFree		= buffer->size - (size_t)(buffer->writePos - buffer->knownReadPos);
+		size_t			numCopied	= numBytes;
+
+		if (numFree == 0)
+		{
+			OutputBuffer_waitForSpace(buffer);
+			continue;
+		}
+
+		if (numCopied > numFree)
+			numCopied = numFree;
+
+		if (numCopied > buffer->size - offset)
+			numCopied = buffer->size - offset;
+
+		deMemcpy(buffer->data + offset, src, numCopied);
+
+		src					+= numCopied;
+		numBytes			-= numCopied;
+		buffer->writePos	+= numCopied;
+
+		if (buffer->writePos - buffer->publishedPos >= (deUint64)(buffer->size/4))
+			OutputBuffer_publish(buffer, DE_FALSE, DE_FALSE);
+	}
+}
+
+/* Writes out and flushes all buffered data. Caller must hold log lock, or be the only user of log. */
+static void OutputBuffer_destroy (OutputBuffer* buffer)
+{
+	if (buffer->thread)
+	{
+		OutputBuffer_publish(buffer, DE_TRUE, DE_TRUE);
+
+		deMutex_lock(buffer->lock);
+		buffer->isStopRequested = DE_TRUE;
+		OutputBuffer_requestWrite(buffer);
+		deMutex_unlock(buffer->lock);
+
+		deThread_join(buffer->thread);
+		deThread_destroy(buffer->thread);
+	}
+
+	if (buffer->lock)
+		deMutex_destroy(buffer->lock);
+
+	if (buffer->writeRequest)
+		deSemaphore_destroy(buffer->writeRequest);
+
+	if (buffer->spaceFreed)
+		deSemaphore_destroy(buffer->spaceFreed);
+
+	if (buffer->flushDone)
+		deSemaphore_destroy(buffer->flushDone);
+
+	deFree(buffer->data);
+	deFree(buffer);
+}
+
+static OutputBuffer* OutputBuffer_create (FILE* file, size_t size)
+{
+	OutputBuffer* buffer = (OutputBuffer*)deCalloc(sizeof(OutputBuffer));
+	if (!buffer)
+		return DE_NULL;
+
+	DE_ASSERT(file && size > 0);
+
+	buffer->file			= file;
+	buffer->size			= size;
+	buffer->data			= (deUint8*)deMalloc(size);
+	buffer->lock			= deMutex_create(DE_NULL);
+	buffer->writeRequest	= deSemaphore_create(0, DE_NULL);
+	buffer->spaceFreed		= deSemaphore_create(0, DE_NULL);
+	buffer->flushDone		= deSemaphore_create(0, DE_NULL);
+
+	if (!buffer->data || !buffer->lock || !buffer->writeRequest || !buffer->spaceFreed || !buffer->flushDone)
+	{
+		OutputBuffer_destroy(buffer);
+		return DE_NULL;
+	}
+
+	buffer->thread = deThread_create(outputWriterThread, buffer, DE_NULL);
+
+	if (!buffer->thread)
+	{
+		OutputBuffer_destroy(buffer);
+		return DE_NULL;
+	}
+
+	return buffer;
+}
+
+/* Write data to log output. Caller must hold log lock, or be the only user of log. */
+static void writeOutputData (qpTestLog* log, const void* data, size_t numBytes)
+{
+	if (log->outputBuffer)
+		OutputBuffer_write(log->outputBuffer, data, numBytes);
+	else
+		fwrite(data, 1, numBytes, log->outputFile);
+}
+
+static void writeOutput (qpTestLog* log, const char* str)
+{
+	writeOutputData(log, str, strlen(str));
+}
+
+static void writeXmlOutput (void* userPtr, const char* data, size_t numBytes)
+{
+	writeOutputData((qpTestLog*)userPtr, data, numBytes);
+}
+
+static qpXmlWriter* createXmlWriter (qpTestLog* log, deBool isBuffered)
+{
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+		return qpXmlWriter_createBinaryWriter(writeXmlOutput, log);
+	else if (isBuffered)
+		return qpXmlWriter_createCallbackWriter(writeXmlOutput, log);
+	else
+		return qpXmlWriter_createFileWriter(log->outputFile, 0);
+}
+
+static void writeUint32 (deUint8* dst, deUint32 value)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < 4; ndx++)
+		dst[ndx] = (deUint8)(value >> (8*ndx));
+}
+
+/* Write binary log container record with up to two string values. Caller must hold log lock, or be the only user of log. */
+static void writeContainerRecord (qpTestLog* log, qpBinaryLogRecordType type, const char* value0, const char* value1)
+{
+	const char*	values[2];
+	deUint8		header[5];
+	deUint8		length[4];
+	size_t		payloadSize	= 0;
+	int			ndx;
+
+	DE_ASSERT(value0 || !value1);
+
+	values[0] = value0;
+	values[1] = value1;
+
+	for (ndx = 0; ndx < DE_LENGTH_OF_ARRAY(values) && values[ndx]; ndx++)
+		payloadSize += 4 + strlen(values[ndx]);
+
+	header[0] = (deUint8)type;
+	writeUint32(&header[1], (deUint32)payloadSize);
+	writeOutputData(log, header, sizeof(header));
+
+	for (ndx = 0; ndx < DE_LENGTH_OF_ARRAY(values) && values[ndx]; ndx++)
+	{
+		writeUint32(length, (deUint32)strlen(values[ndx]));
+		writeOutputData(log, length, sizeof(length));
+		writeOutput(log, values[ndx]);
+	}
+}
+
+/* Flush log output to file. Caller must hold log lock, or be the only user of log. */
+static void flushOutput (qpTestLog* log, deBool waitForFlush)
+{
+	log->numCasesSinceFlush	= 0;
+	log->lastFlushTime		= deGetMicroseconds();
+
+	if (log->outputBuffer)
+		OutputBuffer_publish(log->outputBuffer, DE_TRUE, waitForFlush);
+	else
+		flushOutputFile(log->outputFile);
+}
+
+/* Flush log output after test case according to flush policy. Caller must hold log lock. */
+static void flushAfterCase (qpTestLog* log)
+{
+	const qpTestLogBufferConfig* config = &log->bufferConfig;
+
+	log->numCasesSinceFlush += 1;
+
+	switch (config->flushPolicy)
+	{
+		case QP_TEST_LOG_FLUSH_POLICY_CASE:
+			flushOutput(log, DE_TRUE);
+			break;
+
+		case QP_TEST_LOG_FLUSH_POLICY_NUM_CASES:
+			if (log->numCasesSinceFlush >= config->flushNumCases)
+				flushOutput(log, DE_FALSE);
+			break;
+
+		case QP_TEST_LOG_FLUSH_POLICY_TIME:
+			if (deGetMicroseconds() - log->lastFlushTime >= (deUint64)config->flushIntervalMs*1000u)
+				flushOutput(log, DE_FALSE);
+			break;
+
+		case QP_TEST_LOG_FLUSH_POLICY_CRASH:
+			break;
+
+		default:
+			DE_ASSERT(DE_FALSE);
+	}
+}
+
 #define QP_LOOKUP_STRING(KEYMAP, KEY)	qpLookupString(KEYMAP, DE_LENGTH_OF_ARRAY(KEYMAP), (int)(KEY))
 
 static const char* qpLookupString (const qpKeyStringMap* keyMap, int keyMapSize, int key)
@@ -291,16 +706,41 @@ DE_INLINE void doubleToString (double value, char* buf, int bufSize)
 
 static deBool beginSession (qpTestLog* log)
 {
+	char releaseIdStr[32];
+
 	DE_ASSERT(log && !log->isSessionOpen);
 
-	/* Write session info. */
-	fprintf(log->outputFile, "#sessionInfo releaseName %s\n", qpGetReleaseName());
-	fprintf(log->outputFile, "#sessionInfo releaseId 0x%08x\n", qpGetReleaseId());
-	fprintf(log->outputFile, "#sessionInfo targetName \"%s\"\n", qpGetTargetName());
+	deSprintf(releaseIdStr, sizeof(releaseIdStr), "0x%08x", qpGetReleaseId());
+
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+	{
+		deUint8 header[sizeof(s_binaryLogMagic) + 4];
+
+		deMemcpy(header, s_binaryLogMagic, sizeof(s_binaryLogMagic));
+		writeUint32(&header[sizeof(s_binaryLogMagic)], BINARY_LOG_VERSION);
+		writeOutputData(log, header, sizeof(header));
+
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_SESSION_INFO, "releaseName", qpGetReleaseName());
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_SESSION_INFO, "releaseId", releaseIdStr);
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_SESSION_INFO, "targetName", qpGetTargetName());
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_BEGIN_SESSION, DE_NULL, DE_NULL);
+	}
+	else
+	{
+		/* Write session info. */
+		writeOutput(log, "#sessionInfo releaseName ");
+		writeOutput(log, qpGetReleaseName());
+		writeOutput(log, "\n#sessionInfo releaseId ");
+		writeOutput(log, releaseIdStr);
+		writeOutput(log, "\n#sessionInfo targetName \"");
+		writeOutput(log, qpGetTargetName());
+		writeOutput(log, "\"\n");
+
+		/* Write out #beginSession. */
+		writeOutput(log, "#beginSession\n");
+	}
 
-    /* Write out #beginSession. */
-	fprintf(log->outputFile, "#beginSession\n");
-	qpTestLog_flushFile(log);
+	flushOutput(log, DE_TRUE);
 
 	log->isSessionOpen = DE_TRUE;
 
@@ -315,14 +755,24 @@ static deBool endSession (qpTestLog* log)
     qpXmlWriter_flush(log->writer);
 
     /* Write out #endSession. */
-	fprintf(log->outputFile, "\n#endSession\n");
-	qpTestLog_flushFile(log);
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_END_SESSION, DE_NULL, DE_NULL);
+	else
+		writeOutput(log, "\n#endSession\n");
+
+	flushOutput(log, DE_TRUE);
 
 	log->isSessionOpen = DE_FALSE;
 
 	return DE_TRUE;
 }
 
+static deBool	writePendingImages		(qpTestLog* log);
+static void		discardPendingImages	(qpTestLog* log);
+static void		stopImageEncoderThreads	(qpTestLog* log);
+static void		commitCaseImages		(qpTestLog* log);
+static void		resetCaseImages			(qpTestLog* log);
+
 /*--------------------------------------------------------------------*//*!
  * \brief Create a file based logger instance
  * \param fileName Name of the file where to put logs
@@ -350,10 +800,15 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 	}
 
 	log->flags			= flags;
-	log->writer			= qpXmlWriter_createFileWriter(log->outputFile, 0);
+	log->writer			= createXmlWriter(log, DE_FALSE);
 	log->lock			= deMutex_create(DE_NULL);
+	log->imageLock		= deMutex_create(DE_NULL);
 	log->isSessionOpen	= DE_FALSE;
 	log->isCaseOpen		= DE_FALSE;
+	log->lastFlushTime	= deGetMicroseconds();
+
+	qpImageEncoderConfig_init(&log->imageEncoderConfig);
+	qpTestLogBufferConfig_init(&log->bufferConfig);
 
 	if (!log->writer)
 	{
@@ -362,13 +817,27 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 		return DE_NULL;
 	}
 
-	if (!log->lock)
+	if (!log->lock || !log->imageLock)
 	{
 		qpPrintf("ERROR: Unable to create mutex.\n");
 		qpTestLog_destroy(log);
 		return DE_NULL;
 	}
 
+	if (flags & QP_TEST_LOG_DEDUPLICATE_IMAGES)
+	{
+		log->imageHashPool	= deMemPool_createRoot(DE_NULL, 0);
+		log->loggedImages	= log->imageHashPool ? qpImageHashSet_create(log->imageHashPool) : DE_NULL;
+		log->caseImages		= log->imageHashPool ? qpImageHashSet_create(log->imageHashPool) : DE_NULL;
+
+		if (!log->loggedImages || !log->caseImages)
+		{
+			qpPrintf("ERROR: Unable to create image hash set.\n");
+			qpTestLog_destroy(log);
+			return DE_NULL;
+		}
+	}
+
 	beginSession(log);
 
 	return log;
@@ -382,9 +851,18 @@ void qpTestLog_destroy (qpTestLog* log)
 {
 	DE_ASSERT(log);
 
+	if (log->encoderThreads)
+	{
+		writePendingImages(log);
+		stopImageEncoderThreads(log);
+	}
+
 	if (log->isSessionOpen)
 		endSession(log);
 
+	if (log->outputBuffer)
+		OutputBuffer_destroy(log->outputBuffer);
+
 	if (log->writer)
 		qpXmlWriter_destroy(log->writer);
 
@@ -394,6 +872,15 @@ void qpTestLog_destroy (qpTestLog* log)
 	if (log->lock)
 		deMutex_destroy(log->lock);
 
+	if (log->imageLock)
+		deMutex_destroy(log->imageLock);
+
+	if (log->imageHashPool)
+		deMemPool_destroy(log->imageHashPool);
+
+	Buffer_deinit(&log->loggedImageOrder);
+	Buffer_deinit(&log->caseImageOrder);
+
 	deFree(log);
 }
 
@@ -412,19 +899,31 @@ deBool qpTestLog_startCase (qpTestLog* log, const char* testCasePath, qpTestCase
 
 	DE_ASSERT(log && testCasePath && (testCasePath[0] != 0));
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	DE_ASSERT(!log->isCaseOpen);
 	DE_ASSERT(ContainerStack_isEmpty(&log->containerStack));
 
 	/* Flush XML and write out #beginTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#beginTestCaseResult %s\n", testCasePath);
-	qpTestLog_flushFile(log);
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_BEGIN_TEST_CASE_RESULT, testCasePath, DE_NULL);
+	else
+	{
+		writeOutput(log, "\n#beginTestCaseResult ");
+		writeOutput(log, testCasePath);
+		writeOutput(log, "\n");
+	}
+
+	if (log->bufferConfig.flushPolicy == QP_TEST_LOG_FLUSH_POLICY_CASE)
+		flushOutput(log, DE_TRUE);
 
 	log->isCaseOpen = DE_TRUE;
 
+	resetCaseImages(log);
+
 	/* Fill in attributes. */
-	resultAttribs[numResultAttribs++] = qpSetStringAttrib("Version", LOG_FORMAT_VERSION);
+	resultAttribs[numResultAttribs++] = qpSetStringAttrib("Version", (log->flags & QP_TEST_LOG_DEDUPLICATE_IMAGES) ? LOG_FORMAT_VERSION_DEDUP : LOG_FORMAT_VERSION);
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("CasePath", testCasePath);
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("CaseType", typeStr);
 
@@ -455,6 +954,7 @@ deBool qpTestLog_endCase (qpTestLog* log, qpTestResult result, const char* resul
 	DE_ASSERT(log && log->isCaseOpen);
 	DE_ASSERT(ContainerStack_isEmpty(&log->containerStack));
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	/* <Result StatusCode="Pass">Result details</Result>
 	 * </TestCaseResult>
@@ -472,11 +972,17 @@ deBool qpTestLog_endCase (qpTestLog* log, qpTestResult result, const char* resul
 
 	/* Flush XML and write #endTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#endTestCaseResult\n");
-	qpTestLog_flushFile(log);
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_END_TEST_CASE_RESULT, DE_NULL, DE_NULL);
+	else
+		writeOutput(log, "\n#endTestCaseResult\n");
+
+	flushAfterCase(log);
 
 	log->isCaseOpen = DE_FALSE;
 
+	commitCaseImages(log);
+
 	deMutex_unlock(log->lock);
 	return DE_TRUE;
 }
@@ -496,19 +1002,35 @@ deBool qpTestLog_terminateCase (qpTestLog* log, qpTestResult result)
 
 	deMutex_lock(log->lock);
 
+	/* Don't wait for encoder threads. Pending images of the terminated case are not written. */
+	discardPendingImages(log);
+
 	if (!log->isCaseOpen)
 	{
+		/* Make sure buffered output from completed cases is not lost. */
+		flushOutput(log, DE_TRUE);
 		deMutex_unlock(log->lock);
 		return DE_FALSE; /* Soft error. This is called from error handler. */
 	}
 
 	/* Flush XML and write #terminateTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#terminateTestCaseResult %s\n", resultStr);
-	qpTestLog_flushFile(log);
+	if (log->flags & QP_TEST_LOG_BINARY_FORMAT)
+		writeContainerRecord(log, QP_BINARY_LOG_RECORD_TERMINATE_TEST_CASE_RESULT, resultStr, DE_NULL);
+	else
+	{
+		writeOutput(log, "\n#terminateTestCaseResult ");
+		writeOutput(log, resultStr);
+		writeOutput(log, "\n");
+	}
+
+	flushOutput(log, DE_TRUE);
 
 	log->isCaseOpen = DE_FALSE;
 
+	/* Result parsers skip terminated cases, so their images can't be referenced. */
+	resetCaseImages(log);
+
 #if defined(DE_DEBUG)
 	ContainerStack_reset(&log->containerStack);
 #endif
@@ -525,6 +1047,7 @@ static deBool qpTestLog_writeKeyValuePair (qpTestLog* log, const char* elementNa
 
 	DE_ASSERT(log && elementName && text);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	/* Fill in attributes. */
 	if (name)			attribs[numAttribs++] = qpSetStringAttrib("Name", name);
@@ -625,13 +1148,6 @@ deBool qpTestLog_writeFloat (qpTestLog* log, const char* name, const char* descr
 	return qpTestLog_writeKeyValuePair(log, "Number", name, description, unit, tag, tmpString);
 }
 
-typedef struct Buffer_s
-{
-	int			capacity;
-	int			size;
-	deUint8*	data;
-} Buffer;
-
 void Buffer_init (Buffer* buffer)
 {
 	buffer->capacity	= 0;
@@ -712,7 +1228,20 @@ static deBool writeCompressedPNG (png_structp png, png_infop info, png_byte** ro
 		return DE_FALSE;
 }
 
-static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int rowStride, const void* data)
+static int getZlibStrategy (qpImageCompressionStrategy strategy)
+{
+	switch (strategy)
+	{
+		case QP_IMAGE_COMPRESSION_STRATEGY_FILTERED:		return Z_FILTERED;
+		case QP_IMAGE_COMPRESSION_STRATEGY_HUFFMAN_ONLY:	return Z_HUFFMAN_ONLY;
+		case QP_IMAGE_COMPRESSION_STRATEGY_RLE:				return Z_RLE;
+		default:
+			DE_ASSERT(DE_FALSE);
+			return Z_DEFAULT_STRATEGY;
+	}
+}
+
+static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int rowStride, const void* data, int compressionLevel, qpImageCompressionStrategy strategy)
 {
 	deBool			compressOk		= DE_FALSE;
 	png_structp		png				= DE_NULL;
@@ -740,6 +1269,12 @@ static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int w
 		/* Set our own write function. */
 		png_set_write_fn(png, buffer, pngWriteData, pngFlushData);
 
+		if (compressionLevel >= 0)
+			png_set_compression_level(png, compressionLevel);
+
+		if (strategy != QP_IMAGE_COMPRESSION_STRATEGY_DEFAULT)
+			png_set_compression_strategy(png, getZlibStrategy(strategy));
+
 		compressOk = writeCompressedPNG(png, info, rowPointers, width, height,
 										hasAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB);
 	}
@@ -758,55 +1293,564 @@ static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int w
 }
 #endif /* QP_SUPPORT_PNG */
 
-/*--------------------------------------------------------------------*//*!
- * \brief Start image set
- * \param log			qpTestLog instance
- * \param name			Unique identifier for the set
- * \param description	Human readable description
- * \return true if ok, false otherwise
- *//*--------------------------------------------------------------------*/
-deBool qpTestLog_startImageSet (qpTestLog* log, const char* name, const char* description)
+static deBool packImagePixels (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
 {
-	qpXmlAttribute	attribs[4];
-	int				numAttribs = 0;
-
-	DE_ASSERT(log && name);
-	deMutex_lock(log->lock);
-
-	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
-	if (description)
-		attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+	int pixelSize		= imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+	int packedStride	= pixelSize*width;
+	int row;
 
-	/* <ImageSet Name="<name>"> */
-	if (!qpXmlWriter_startElement(log->writer, "ImageSet", numAttribs, attribs))
-	{
-		qpPrintf("qpTestLog_startImageSet(): Writing XML failed\n");
-		deMutex_unlock(log->lock);
+	if (!Buffer_resize(buffer, packedStride*height))
 		return DE_FALSE;
-	}
 
-	DE_ASSERT(ContainerStack_push(&log->containerStack, CONTAINERTYPE_IMAGESET));
+	for (row = 0; row < height; row++)
+		memcpy(&buffer->data[packedStride*row], &((const deUint8*)data)[row*stride], packedStride);
 
-	deMutex_unlock(log->lock);
 	return DE_TRUE;
 }
 
-/*--------------------------------------------------------------------*//*!
- * \brief End image set
- * \param log			qpTestLog instance
- * \return true if ok, false otherwise
- *//*--------------------------------------------------------------------*/
-deBool qpTestLog_endImageSet (qpTestLog* log)
+static deUint64 hashBytes (deUint64 hash, const deUint8* bytes, int numBytes)
 {
-	DE_ASSERT(log);
-	deMutex_lock(log->lock);
+	/* 64-bit FNV-1a */
+	const deUint64	prime	= ((deUint64)0x00000100u << 32) | 0x000001b3u;
+	int				ndx;
 
-	/* <ImageSet Name="<name>"> */
-	if (!qpXmlWriter_endElement(log->writer, "ImageSet"))
+	for (ndx = 0; ndx < numBytes; ndx++)
+		hash = (hash ^ bytes[ndx]) * prime;
+
+	return hash;
+}
+
+/* Hash of image contents and the attributes describing them. */
+static deUint64 computeImageHash (qpImageCompressionMode compressionMode, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	const int	rowSize		= (imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4)*width;
+	deUint64	hash		= ((deUint64)0xcbf29ce4u << 32) | 0x84222325u;
+	deUint8		header[16];
+	int			ndx;
+
+	for (ndx = 0; ndx < 4; ndx++)
 	{
-		qpPrintf("qpTestLog_endImageSet(): Writing XML failed\n");
-		deMutex_unlock(log->lock);
-		return DE_FALSE;
+		header[ndx+ 0] = (deUint8)((deUint32)compressionMode	>> (ndx*8));
+		header[ndx+ 4] = (deUint8)((deUint32)imageFormat		>> (ndx*8));
+		header[ndx+ 8] = (deUint8)((deUint32)width				>> (ndx*8));
+		header[ndx+12] = (deUint8)((deUint32)height				>> (ndx*8));
+	}
+
+	hash = hashBytes(hash, header, DE_LENGTH_OF_ARRAY(header));
+
+	for (ndx = 0; ndx < height; ndx++)
+		hash = hashBytes(hash, (const deUint8*)data + ndx*stride, rowSize);
+
+	return hash;
+}
+
+static void imageHashToString (deUint64 hash, char* dst)
+{
+	sprintf(dst, "%08x%08x", (deUint32)(hash >> 32), (deUint32)(hash & 0xffffffffu));
+}
+
+/* Caller must hold log lock. */
+static deBool isImageLogged (const qpTestLog* log, deUint64 hash)
+{
+	return qpImageHashSet_exists(log->loggedImages, hash) || qpImageHashSet_exists(log->caseImages, hash);
+}
+
+/* Forget all referenceable images. Result parsers may keep them, which is harmless. Caller must hold log lock. */
+static void forgetLoggedImages (qpTestLog* log)
+{
+	qpImageHashSet_reset(log->loggedImages);
+	qpImageHashSet_reset(log->caseImages);
+
+	log->loggedImageOrder.size	= 0;
+	log->firstLoggedImage		= 0;
+	log->loggedImageBytes		= 0;
+	log->caseImageOrder.size	= 0;
+}
+
+/* Caller must hold log lock. */
+static void resetCaseImages (qpTestLog* log)
+{
+	if (!log->caseImages)
+		return;
+
+	qpImageHashSet_reset(log->caseImages);
+	log->caseImageOrder.size = 0;
+}
+
+/* Record size of image written with Hash attribute. Caller must hold log lock. */
+static void addCaseImage (qpTestLog* log, deUint64 hash, size_t numBytes)
+{
+	LoggedImage image;
+
+	image.hash		= hash;
+	image.numBytes	= numBytes;
+
+	if (!Buffer_append(&log->caseImageOrder, (const deUint8*)&image, (int)sizeof(LoggedImage)))
+		forgetLoggedImages(log); /* Out of memory, images are written again when logged next time. */
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Make images of current case available for later cases to reference
+ *
+ * Result parsers keep referenceable images in memory. Oldest images are
+ * dropped once their total size exceeds QP_TEST_LOG_MAX_REFERENCEABLE_IMAGE_BYTES.
+ * Parsers drop images in the same order, so images that are still
+ * referenced are never dropped. Caller must hold log lock.
+ *//*--------------------------------------------------------------------*/
+static void commitCaseImages (qpTestLog* log)
+{
+	const int	numCaseImages	= log->caseImageOrder.size / (int)sizeof(LoggedImage);
+	int			ndx;
+
+	if (!log->caseImages)
+		return;
+
+	if (!Buffer_append(&log->loggedImageOrder, log->caseImageOrder.data, log->caseImageOrder.size))
+	{
+		forgetLoggedImages(log); /* Out of memory, images are written again when logged next time. */
+		return;
+	}
+
+	for (ndx = 0; ndx < numCaseImages; ndx++)
+	{
+		const LoggedImage* image = (const LoggedImage*)log->caseImageOrder.data + ndx;
+
+		/* On failure image is written again when logged next time, but it still counts towards the limit. */
+		qpImageHashSet_safeInsert(log->loggedImages, image->hash);
+		log->loggedImageBytes += image->numBytes;
+	}
+
+	resetCaseImages(log);
+
+	while (log->loggedImageBytes > QP_TEST_LOG_MAX_REFERENCEABLE_IMAGE_BYTES)
+	{
+		const LoggedImage* oldest = (const LoggedImage*)log->loggedImageOrder.data + log->firstLoggedImage;
+
+		if (qpImageHashSet_exists(log->loggedImages, oldest->hash))
+			qpImageHashSet_delete(log->loggedImages, oldest->hash);
+
+		log->loggedImageBytes	-= oldest->numBytes;
+		log->firstLoggedImage	+= 1;
+	}
+
+	/* Compact once half of the entries have been dropped. */
+	if (log->firstLoggedImage > 0 && log->firstLoggedImage*2*(int)sizeof(LoggedImage) >= log->loggedImageOrder.size)
+	{
+		const int numBytes = log->loggedImageOrder.size - log->firstLoggedImage*(int)sizeof(LoggedImage);
+
+		memmove(log->loggedImageOrder.data, log->loggedImageOrder.data + log->firstLoggedImage*(int)sizeof(LoggedImage), numBytes);
+		log->loggedImageOrder.size	= numBytes;
+		log->firstLoggedImage		= 0;
+	}
+}
+
+/* Write <Image> element referencing an earlier image with same contents. Caller must hold log lock. */
+static deBool writeImageRefElement (qpTestLog* log, const char* name, const char* description, qpImageFormat imageFormat, int width, int height, deUint64 hash)
+{
+	char			widthStr[32];
+	char			heightStr[32];
+	char			hashStr[17];
+	qpXmlAttribute	attribs[8];
+	int				numAttribs			= 0;
+
+	int32ToString(width, widthStr);
+	int32ToString(height, heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
+	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
+	imageHashToString(hash, hashStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Ref", hashStr);
+	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+
+	/* <Image Name="Foobar" Width="640" Height="480" Format="RGB888" Ref="0123456789abcdef"/> */
+	if (!qpXmlWriter_startElement(log->writer, "Image", numAttribs, attribs) ||
+		!qpXmlWriter_endElement(log->writer, "Image"))
+	{
+		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+		return DE_FALSE;
+	}
+
+	return DE_TRUE;
+}
+
+/* Write <Image> element. Hash is written for deduplicated images, otherwise null. Caller must hold log lock. */
+static deBool writeImageElement (qpTestLog* log, const char* name, const char* description, qpImageCompressionMode compressionMode, qpImageFormat imageFormat, int width, int height, const void* data, int numBytes, const deUint64* hash)
+{
+	char			widthStr[32];
+	char			heightStr[32];
+	char			hashStr[17];
+	qpXmlAttribute	attribs[8];
+	int				numAttribs			= 0;
+
+	/* Fill in attributes. */
+	int32ToString(width, widthStr);
+	int32ToString(height, heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
+	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
+	attribs[numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
+	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+	if (hash)
+	{
+		imageHashToString(*hash, hashStr);
+		attribs[numAttribs++] = qpSetStringAttrib("Hash", hashStr);
+	}
+
+	/* <Image ID="result" Name="Foobar" Width="640" Height="480" Format="RGB888" CompressionMode="None">base64 data</Image> */
+	if (!qpXmlWriter_startElement(log->writer, "Image", numAttribs, attribs) ||
+		!qpXmlWriter_writeBase64(log->writer, (const deUint8*)data, numBytes) ||
+		!qpXmlWriter_endElement(log->writer, "Image"))
+	{
+		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+		return DE_FALSE;
+	}
+
+	if (hash)
+		addCaseImage(log, *hash, (size_t)numBytes);
+
+	return DE_TRUE;
+}
+
+/* Image queued for compression in an encoder thread. */
+struct PendingImage_s
+{
+	char*						name;
+	char*						description;
+	deUint64					hash;
+	deBool						hasHash;		/*!< Image is deduplicated and written with hash.		*/
+	qpImageFormat				imageFormat;
+	int							width;
+	int							height;
+	int							compressionLevel;
+	qpImageCompressionStrategy	strategy;
+
+	Buffer						pixels;			/*!< Packed copy of pixel data, freed once compressed.	*/
+	Buffer						compressed;
+	deBool						compressOk;
+	size_t						numBytes;		/*!< Bytes accounted in qpTestLog::pendingBytes.		*/
+	deBool						isDiscarded;	/*!< Image is dropped without writing. Protected by imageLock.	*/
+	deSemaphore					encodeDone;
+
+	PendingImage*				next;
+};
+
+static void PendingImage_destroy (PendingImage* image)
+{
+	if (image->encodeDone)
+		deSemaphore_destroy(image->encodeDone);
+
+	Buffer_deinit(&image->pixels);
+	Buffer_deinit(&image->compressed);
+	deFree(image->name);
+	deFree(image->description);
+	deFree(image);
+}
+
+static PendingImage* PendingImage_create (const char* name, const char* description, const deUint64* hash, qpImageFormat imageFormat, int width, int height, int stride, const void* data, const qpImageEncoderConfig* config)
+{
+	PendingImage* image = (PendingImage*)deCalloc(sizeof(PendingImage));
+	if (!image)
+		return DE_NULL;
+
+	Buffer_init(&image->pixels);
+	Buffer_init(&image->compressed);
+
+	image->name				= deStrdup(name);
+	image->description		= description ? deStrdup(description) : DE_NULL;
+	image->hash				= hash ? *hash : 0;
+	image->hasHash			= hash != DE_NULL;
+	image->imageFormat		= imageFormat;
+	image->width			= width;
+	image->height			= height;
+	image->compressionLevel	= config->compressionLevel;
+	image->strategy			= config->strategy;
+	image->encodeDone		= deSemaphore_create(0, DE_NULL);
+
+	if (!image->name || (description && !image->description) || !image->encodeDone ||
+		!packImagePixels(&image->pixels, imageFormat, width, height, stride, data))
+	{
+		PendingImage_destroy(image);
+		return DE_NULL;
+	}
+
+	return image;
+}
+
+#if defined(QP_SUPPORT_PNG)
+static void imageEncoderThread (void* arg)
+{
+	qpTestLog* log = (qpTestLog*)arg;
+
+	for (;;)
+	{
+		PendingImage*	image;
+		deBool			isDiscarded	= DE_FALSE;
+		int				pixelSize;
+		size_t			numBytes;
+
+		deSemaphore_decrement(log->encodeJobs);
+
+		deMutex_lock(log->imageLock);
+		image = log->nextEncodeJob;
+		if (image)
+		{
+			log->nextEncodeJob	= image->next;
+			isDiscarded			= image->isDiscarded;
+		}
+		deMutex_unlock(log->imageLock);
+
+		if (!image)
+			break; /* Stop requested. */
+
+		pixelSize			= image->imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+		image->compressOk	= !isDiscarded && compressImagePNG(&image->compressed, image->imageFormat, image->width, image->height, pixelSize*image->width,
+																   image->pixels.data, image->compressionLevel, image->strategy);
+
+		/* Pixels are kept for uncompressed fall-back. */
+		if (isDiscarded)
+		{
+			Buffer_deinit(&image->pixels);
+			Buffer_deinit(&image->compressed);
+		}
+		else if (image->compressOk)
+			Buffer_deinit(&image->pixels);
+		else
+			Buffer_deinit(&image->compressed);
+
+		numBytes = (size_t)image->pixels.size + (size_t)image->compressed.size;
+
+		deMutex_lock(log->imageLock);
+		log->pendingBytes	= log->pendingBytes + numBytes - image->numBytes;
+		image->numBytes		= numBytes;
+		deMutex_unlock(log->imageLock);
+
+		deSemaphore_increment(image->encodeDone);
+	}
+}
+
+/* Caller must hold log lock. */
+static deBool startImageEncoderThreads (qpTestLog* log, int numThreads)
+{
+	int ndx;
+
+	DE_ASSERT(!log->encoderThreads && numThreads > 0);
+
+	log->encodeJobs		= deSemaphore_create(0, DE_NULL);
+	log->encoderThreads	= (deThread*)deCalloc(sizeof(deThread)*numThreads);
+
+	if (!log->encodeJobs || !log->encoderThreads)
+	{
+		stopImageEncoderThreads(log);
+		return DE_FALSE;
+	}
+
+	for (ndx = 0; ndx < numThreads; ndx++)
+	{
+		log->encoderThreads[ndx] = deThread_create(imageEncoderThread, log, DE_NULL);
+
+		if (!log->encoderThreads[ndx])
+		{
+			stopImageEncoderThreads(log);
+			return DE_FALSE;
+		}
+
+		log->numEncoderThreads = ndx+1;
+	}
+
+	return DE_TRUE;
+}
+#endif /* QP_SUPPORT_PNG */
+
+/* Caller must hold log lock, or be the only user of log, and have written pending images. */
+static void stopImageEncoderThreads (qpTestLog* log)
+{
+	int numThreads;
+	int ndx;
+
+	DE_ASSERT(!log->pendingHead);
+
+	deMutex_lock(log->imageLock);
+	numThreads				= log->numEncoderThreads;
+	log->numEncoderThreads	= 0;
+	deMutex_unlock(log->imageLock);
+
+	for (ndx = 0; ndx < numThreads; ndx++)
+		deSemaphore_increment(log->encodeJobs);
+
+	for (ndx = 0; ndx < numThreads; ndx++)
+	{
+		deThread_join(log->encoderThreads[ndx]);
+		deThread_destroy(log->encoderThreads[ndx]);
+	}
+
+	if (log->encodeJobs)
+		deSemaphore_destroy(log->encodeJobs);
+
+	deFree(log->encoderThreads);
+
+	log->encodeJobs		= 0;
+	log->encoderThreads	= DE_NULL;
+}
+
+/* Queue image for compression in encoder threads. Returns false if image must be written synchronously. */
+static deBool queueImage (qpTestLog* log, const char* name, const char* description, const deUint64* hash, qpImageFormat imageFormat, int width, int height, int stride, const void* data, const qpImageEncoderConfig* config)
+{
+	const size_t	numBytes	= (size_t)(imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4)*(size_t)width*(size_t)height;
+	PendingImage*	image		= DE_NULL;
+	deBool			isQueued	= DE_FALSE;
+
+	/* Reserve memory budget. */
+	deMutex_lock(log->imageLock);
+	if (log->pendingBytes + numBytes <= config->maxPendingBytes)
+	{
+		log->pendingBytes	+= numBytes;
+		isQueued			= DE_TRUE;
+	}
+	deMutex_unlock(log->imageLock);
+
+	if (!isQueued)
+		return DE_FALSE;
+
+	image = PendingImage_create(name, description, hash, imageFormat, width, height, stride, data, config);
+
+	deMutex_lock(log->lock);
+	deMutex_lock(log->imageLock);
+
+	/* Encoder threads may have been stopped meanwhile. */
+	isQueued = image && log->numEncoderThreads > 0;
+
+	if (isQueued)
+	{
+		image->numBytes = numBytes;
+
+		if (log->pendingTail)
+			log->pendingTail->next = image;
+		else
+			log->pendingHead = image;
+
+		log->pendingTail = image;
+
+		if (!log->nextEncodeJob)
+			log->nextEncodeJob = image;
+	}
+	else
+		log->pendingBytes -= numBytes;
+
+	deMutex_unlock(log->imageLock);
+
+	if (isQueued)
+		deSemaphore_increment(log->encodeJobs);
+
+	deMutex_unlock(log->lock);
+
+	if (!isQueued && image)
+		PendingImage_destroy(image);
+
+	return isQueued;
+}
+
+/* Write pending images in order, waiting for their compression to finish. Caller must hold log lock. */
+static deBool writePendingImages (qpTestLog* log)
+{
+	deBool allOk = DE_TRUE;
+
+	while (log->pendingHead)
+	{
+		PendingImage*	image	= log->pendingHead;
+		deBool			writeOk;
+
+		deSemaphore_decrement(image->encodeDone);
+
+		if (image->isDiscarded)
+			writeOk = DE_TRUE;
+		else if (image->compressOk)
+			writeOk = writeImageElement(log, image->name, image->description, QP_IMAGE_COMPRESSION_MODE_PNG, image->imageFormat, image->width, image->height, image->compressed.data, image->compressed.size, image->hasHash ? &image->hash : DE_NULL);
+		else
+		{
+			qpPrintf("WARNING: PNG compression failed -- storing image uncompressed.\n");
+			writeOk = writeImageElement(log, image->name, image->description, QP_IMAGE_COMPRESSION_MODE_NONE, image->imageFormat, image->width, image->height, image->pixels.data, image->pixels.size, image->hasHash ? &image->hash : DE_NULL);
+		}
+
+		allOk = allOk && writeOk;
+
+		deMutex_lock(log->imageLock);
+		log->pendingBytes -= image->numBytes;
+		deMutex_unlock(log->imageLock);
+
+		log->pendingHead = image->next;
+		if (!log->pendingHead)
+			log->pendingTail = DE_NULL;
+
+		PendingImage_destroy(image);
+	}
+
+	return allOk;
+}
+
+/* Drop pending images without waiting for their compression. They are released by the next writePendingImages(). Caller must hold log lock. */
+static void discardPendingImages (qpTestLog* log)
+{
+	PendingImage* image;
+
+	deMutex_lock(log->imageLock);
+	for (image = log->pendingHead; image; image = image->next)
+		image->isDiscarded = DE_TRUE;
+	deMutex_unlock(log->imageLock);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Start image set
+ * \param log			qpTestLog instance
+ * \param name			Unique identifier for the set
+ * \param description	Human readable description
+ * \return true if ok, false otherwise
+ *//*--------------------------------------------------------------------*/
+deBool qpTestLog_startImageSet (qpTestLog* log, const char* name, const char* description)
+{
+	qpXmlAttribute	attribs[4];
+	int				numAttribs = 0;
+
+	DE_ASSERT(log && name);
+	deMutex_lock(log->lock);
+	writePendingImages(log);
+
+	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
+	if (description)
+		attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+
+	/* <ImageSet Name="<name>"> */
+	if (!qpXmlWriter_startElement(log->writer, "ImageSet", numAttribs, attribs))
+	{
+		qpPrintf("qpTestLog_startImageSet(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
+	}
+
+	DE_ASSERT(ContainerStack_push(&log->containerStack, CONTAINERTYPE_IMAGESET));
+
+	deMutex_unlock(log->lock);
+	return DE_TRUE;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief End image set
+ * \param log			qpTestLog instance
+ * \return true if ok, false otherwise
+ *//*--------------------------------------------------------------------*/
+deBool qpTestLog_endImageSet (qpTestLog* log)
+{
+	DE_ASSERT(log);
+	deMutex_lock(log->lock);
+	writePendingImages(log);
+
+	/* <ImageSet Name="<name>"> */
+	if (!qpXmlWriter_endElement(log->writer, "ImageSet"))
+	{
+		qpPrintf("qpTestLog_endImageSet(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
 	}
 
 	DE_ASSERT(ContainerStack_pop(&log->containerStack) == CONTAINERTYPE_IMAGESET);
@@ -839,13 +1883,14 @@ deBool qpTestLog_writeImage	(
 	int						stride,
 	const void*				data)
 {
-	char			widthStr[32];
-	char			heightStr[32];
-	qpXmlAttribute	attribs[8];
-	int				numAttribs			= 0;
-	Buffer			compressedBuffer;
-	const void*		writeDataPtr		= DE_NULL;
-	int				writeDataBytes		= -1;
+	Buffer					compressedBuffer;
+	const void*				writeDataPtr		= DE_NULL;
+	int						writeDataBytes		= -1;
+	qpImageEncoderConfig	encoderConfig;
+	int						numEncoderThreads;
+	deUint64				imageHash			= 0;
+	const deUint64*			hash				= DE_NULL;
+	deBool					writeOk;
 
 	DE_ASSERT(log && name);
 	DE_ASSERT(deInRange32(width, 1, 16384));
@@ -867,11 +1912,46 @@ deBool qpTestLog_writeImage	(
 #endif
 	}
 
+	/* Reference identical image logged earlier, or register image for later references. */
+	if (log->flags & QP_TEST_LOG_DEDUPLICATE_IMAGES)
+	{
+		deBool isLogged;
+
+		imageHash = computeImageHash(compressionMode, imageFormat, width, height, stride, data);
+
+		deMutex_lock(log->lock);
+
+		isLogged = isImageLogged(log, imageHash);
+
+		if (isLogged)
+		{
+			writeOk = writePendingImages(log);
+			writeOk = writeImageRefElement(log, name, description, imageFormat, width, height, imageHash) && writeOk;
+		}
+		else if (qpImageHashSet_insert(log->caseImages, imageHash))
+			hash = &imageHash;
+
+		deMutex_unlock(log->lock);
+
+		if (isLogged)
+			return writeOk;
+	}
+
+	deMutex_lock(log->imageLock);
+	encoderConfig		= log->imageEncoderConfig;
+	numEncoderThreads	= log->numEncoderThreads;
+	deMutex_unlock(log->imageLock);
+
 #if defined(QP_SUPPORT_PNG)
+	/* Try compressing in encoder threads. */
+	if (compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG && numEncoderThreads > 0 &&
+		queueImage(log, name, description, hash, imageFormat, width, height, stride, data, &encoderConfig))
+		return DE_TRUE;
+
 	/* Try storing with PNG compression. */
 	if (compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG)
 	{
-		deBool compressOk = compressImagePNG(&compressedBuffer, imageFormat, width, height, stride, data);
+		deBool compressOk = compressImagePNG(&compressedBuffer, imageFormat, width, height, stride, data, encoderConfig.compressionLevel, encoderConfig.strategy);
 		if (compressOk)
 		{
 			writeDataPtr	= compressedBuffer.data;
@@ -884,6 +1964,9 @@ deBool qpTestLog_writeImage	(
 			compressionMode	= QP_IMAGE_COMPRESSION_MODE_NONE;
 		}
 	}
+#else
+	DE_UNREF(encoderConfig);
+	DE_UNREF(numEncoderThreads);
 #endif
 
 	/* Handle image compression. */
@@ -899,12 +1982,8 @@ deBool qpTestLog_writeImage	(
 			else
 			{
 				/* Need to re-pack pixels. */
-				if (Buffer_resize(&compressedBuffer, packedStride*height))
-				{
-					int row;
-					for (row = 0; row < height; row++)
-						memcpy(&compressedBuffer.data[packedStride*row], &((const deUint8*)data)[row*stride], pixelSize*width);
-				}
+				if (packImagePixels(&compressedBuffer, imageFormat, width, height, stride, data))
+					writeDataPtr = compressedBuffer.data;
 				else
 				{
 					qpPrintf("ERROR: Failed to pack pixels for writing.\n");
@@ -929,36 +2008,18 @@ deBool qpTestLog_writeImage	(
 			return DE_FALSE;
 	}
 
-	/* Fill in attributes. */
-	int32ToString(width, widthStr);
-	int32ToString(height, heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
-	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
-	attribs[numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
-	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
-
 	/* \note Log lock is acquired after compression! */
 	deMutex_lock(log->lock);
 
-	/* <Image ID="result" Name="Foobar" Width="640" Height="480" Format="RGB888" CompressionMode="None">base64 data</Image> */
-	if (!qpXmlWriter_startElement(log->writer, "Image", numAttribs, attribs) ||
-		!qpXmlWriter_writeBase64(log->writer, (const deUint8*)writeDataPtr, writeDataBytes) ||
-		!qpXmlWriter_endElement(log->writer, "Image"))
-	{
-		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
-		deMutex_unlock(log->lock);
-		Buffer_deinit(&compressedBuffer);
-		return DE_FALSE;
-	}
+	writeOk = writePendingImages(log);
+	writeOk = writeImageElement(log, name, description, compressionMode, imageFormat, width, height, writeDataPtr, writeDataBytes, hash) && writeOk;
 
 	deMutex_unlock(log->lock);
 
 	/* Free compressed data if allocated. */
 	Buffer_deinit(&compressedBuffer);
 
-	return DE_TRUE;
+	return writeOk;
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -973,6 +2034,7 @@ deBool qpTestLog_startShaderProgram (qpTestLog* log, deBool linkOk, const char*
 
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	programAttribs[numProgramAttribs++] = qpSetStringAttrib("LinkStatus", linkOk ? "OK" : "Fail");
 
@@ -999,6 +2061,7 @@ deBool qpTestLog_endShaderProgram (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	/* </ShaderProgram> */
 	if (!qpXmlWriter_endElement(log->writer, "ShaderProgram"))
@@ -1030,6 +2093,7 @@ deBool qpTestLog_writeShader (qpTestLog* log, qpShaderType type, const char* sou
 	DE_ASSERT(log && source);
 	DE_ASSERT(ContainerStack_getTop(&log->containerStack) == CONTAINERTYPE_SHADERPROGRAM);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	shaderAttribs[numShaderAttribs++]	= qpSetStringAttrib("CompileStatus", compileOk ? "OK" : "Fail");
 
@@ -1057,6 +2121,7 @@ deBool qpTestLog_startEglConfigSet (qpTestLog* log, const char* name, const char
 
 	DE_ASSERT(log && name);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
 	if (description)
@@ -1083,6 +2148,7 @@ deBool qpTestLog_endEglConfigSet (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	/* <EglConfigSet Name="<name>"> */
 	if (!qpXmlWriter_endElement(log->writer, "EglConfigSet"))
@@ -1109,6 +2175,7 @@ deBool qpTestLog_writeEglConfig (qpTestLog* log, const qpEglConfigInfo* config)
 
 	DE_ASSERT(log && config);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	attribs[numAttribs++] = qpSetIntAttrib		("BufferSize", config->bufferSize);
 	attribs[numAttribs++] = qpSetIntAttrib		("RedSize", config->redSize);
@@ -1168,6 +2235,7 @@ deBool qpTestLog_startSection (qpTestLog* log, const char* name, const char* des
 
 	DE_ASSERT(log && name);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
 	if (description)
@@ -1196,6 +2264,7 @@ deBool qpTestLog_endSection (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	/* </Section> */
 	if (!qpXmlWriter_endElement(log->writer, "Section"))
@@ -1218,6 +2287,7 @@ deBool qpTestLog_writeKernelSource (qpTestLog* log, const char* source)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	if (!qpXmlWriter_writeStringElement(log->writer, "KernelSource", source))
 	{
@@ -1240,6 +2310,7 @@ deBool qpTestLog_writeCompileInfo (qpTestLog* log, const char* name, const char*
 
 	DE_ASSERT(log && name && description && infoLog);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
 	attribs[numAttribs++] = qpSetStringAttrib("Description", description);
@@ -1265,6 +2336,7 @@ deBool qpTestLog_startSampleList (qpTestLog* log, const char* name, const char*
 
 	DE_ASSERT(log && name && description);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
 	attribs[numAttribs++] = qpSetStringAttrib("Description", description);
@@ -1286,6 +2358,7 @@ deBool qpTestLog_startSampleInfo (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	if (!qpXmlWriter_startElement(log->writer, "SampleInfo", 0, DE_NULL))
 	{
@@ -1308,6 +2381,7 @@ deBool qpTestLog_writeValueInfo (qpTestLog* log, const char* name, const char* d
 
 	DE_ASSERT(log && name && description && tagName);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	DE_ASSERT(ContainerStack_getTop(&log->containerStack) == CONTAINERTYPE_SAMPLEINFO);
 
@@ -1334,6 +2408,7 @@ deBool qpTestLog_endSampleInfo (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	if (!qpXmlWriter_endElement(log->writer, "SampleInfo"))
 	{
@@ -1352,6 +2427,7 @@ deBool qpTestLog_startSample (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	DE_ASSERT(ContainerStack_getTop(&log->containerStack) == CONTAINERTYPE_SAMPLELIST);
 
@@ -1374,6 +2450,7 @@ deBool qpTestLog_writeValueFloat (qpTestLog* log, double value)
 	doubleToString(value, tmpString, (int)sizeof(tmpString));
 
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	DE_ASSERT(ContainerStack_getTop(&log->containerStack) == CONTAINERTYPE_SAMPLE);
 
@@ -1394,6 +2471,7 @@ deBool qpTestLog_writeValueInteger (qpTestLog* log, deInt64 value)
 	int64ToString(value, tmpString);
 
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	DE_ASSERT(ContainerStack_getTop(&log->containerStack) == CONTAINERTYPE_SAMPLE);
 
@@ -1412,6 +2490,7 @@ deBool qpTestLog_endSample (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	if (!qpXmlWriter_endElement(log->writer, "Sample"))
 	{
@@ -1430,6 +2509,7 @@ deBool qpTestLog_endSampleList (qpTestLog* log)
 {
 	DE_ASSERT(log);
 	deMutex_lock(log->lock);
+	writePendingImages(log);
 
 	if (!qpXmlWriter_endElement(log->writer, "SampleList"))
 	{
@@ -1450,6 +2530,150 @@ deUint32 qpTestLog_getLogFlags (const qpTestLog* log)
 	return log->flags;
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Initialize image encoder config to defaults
+ *
+ * Defaults encode images synchronously with default zlib settings.
+ *//*--------------------------------------------------------------------*/
+void qpImageEncoderConfig_init (qpImageEncoderConfig* config)
+{
+	DE_ASSERT(config);
+
+	config->numThreads			= 0;
+	config->compressionLevel	= -1;
+	config->strategy			= QP_IMAGE_COMPRESSION_STRATEGY_DEFAULT;
+	config->maxPendingBytes		= 64*1024*1024;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Configure image encoding
+ *
+ * Pending images are written before the configuration is changed.
+ * Encoder threads are not used if PNG compression is not supported.
+ * \param log		qpTestLog instance
+ * \param config	Image encoder configuration
+ * \return true if ok, false if encoder threads could not be created
+ *//*--------------------------------------------------------------------*/
+deBool qpTestLog_setImageEncoderConfig (qpTestLog* log, const qpImageEncoderConfig* config)
+{
+	deBool isOk = DE_TRUE;
+
+	DE_ASSERT(log && config);
+	DE_ASSERT(config->numThreads >= 0);
+	DE_ASSERT(deInRange32(config->compressionLevel, -1, 9));
+	DE_ASSERT(deInBounds32(config->strategy, 0, QP_IMAGE_COMPRESSION_STRATEGY_LAST));
+
+	deMutex_lock(log->lock);
+	writePendingImages(log);
+
+	if (log->encoderThreads)
+		stopImageEncoderThreads(log);
+
+	deMutex_lock(log->imageLock);
+	log->imageEncoderConfig = *config;
+	deMutex_unlock(log->imageLock);
+
+#if defined(QP_SUPPORT_PNG)
+	if (config->numThreads > 0 && !startImageEncoderThreads(log, config->numThreads))
+	{
+		qpPrintf("WARNING: Failed to create image encoder threads -- encoding images synchronously.\n");
+		isOk = DE_FALSE;
+	}
+#endif
+
+	deMutex_unlock(log->lock);
+	return isOk;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Initialize test log buffer config to defaults
+ *
+ * Defaults write directly to file and flush at start and end of each case.
+ *//*--------------------------------------------------------------------*/
+void qpTestLogBufferConfig_init (qpTestLogBufferConfig* config)
+{
+	DE_ASSERT(config);
+
+	config->bufferSize		= 0;
+	config->flushPolicy		= QP_TEST_LOG_FLUSH_POLICY_CASE;
+	config->flushNumCases	= 100;
+	config->flushIntervalMs	= 1000;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Configure test log output buffering
+ *
+ * Must not be called while a test case is open. Previously buffered
+ * output is written out before the configuration is changed.
+ * \param log		qpTestLog instance
+ * \param config	Buffer configuration
+ * \return true if ok, false if output buffer could not be created
+ *//*--------------------------------------------------------------------*/
+deBool qpTestLog_setBufferConfig (qpTestLog* log, const qpTestLogBufferConfig* config)
+{
+	OutputBuffer*	buffer	= DE_NULL;
+	qpXmlWriter*	writer	= DE_NULL;
+
+	DE_ASSERT(log && config);
+	DE_ASSERT(deInBounds32(config->flushPolicy, 0, QP_TEST_LOG_FLUSH_POLICY_LAST));
+	DE_ASSERT(config->flushNumCases > 0 && config->flushIntervalMs >= 0);
+
+	deMutex_lock(log->lock);
+	writePendingImages(log);
+
+	DE_ASSERT(!log->isCaseOpen);
+
+	if (config->bufferSize > 0)
+	{
+		buffer = OutputBuffer_create(log->outputFile, config->bufferSize);
+		writer = buffer ? createXmlWriter(log, DE_TRUE) : DE_NULL;
+	}
+	else
+		writer = createXmlWriter(log, DE_FALSE);
+
+	if (!writer)
+	{
+		if (buffer)
+			OutputBuffer_destroy(buffer);
+
+		qpPrintf("WARNING: Failed to create test log output buffer -- keeping previous configuration.\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
+	}
+
+	qpXmlWriter_flush(log->writer);
+	qpXmlWriter_destroy(log->writer);
+
+	if (log->outputBuffer)
+		OutputBuffer_destroy(log->outputBuffer);
+
+	log->outputBuffer	= buffer;
+	log->writer			= writer;
+	log->bufferConfig	= *config;
+
+	flushOutput(log, DE_TRUE);
+
+	deMutex_unlock(log->lock);
+	return DE_TRUE;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Write out all buffered log output and flush file
+ *
+ * Waits until data has been written. Safe to call from error handlers.
+ * \param log		qpTestLog instance
+ *//*--------------------------------------------------------------------*/
+void qpTestLog_flush (qpTestLog* log)
+{
+	DE_ASSERT(log);
+
+	deMutex_lock(log->lock);
+	writePendingImages(log);
+	qpXmlWriter_flush(log->writer);
+	flushOutput(log, DE_TRUE);
+	deMutex_unlock(log->lock);
+}
+
 const char* qpGetTestResultName (qpTestResult result)
 {
 	return QP_LOOKUP_STRING(s_qpTestResultMap, result);
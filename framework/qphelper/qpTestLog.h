@@ -129,12 +129,117 @@ typedef enum qpImageFormat_e
 	QP_IMAGE_FORMAT_LAST
 } qpImageFormat;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief PNG compression strategy
+ *
+ * Maps to zlib deflate strategies.
+ *//*--------------------------------------------------------------------*/
+typedef enum qpImageCompressionStrategy_e
+{
+	QP_IMAGE_COMPRESSION_STRATEGY_DEFAULT = 0,		/*!< libpng default.	*/
+	QP_IMAGE_COMPRESSION_STRATEGY_FILTERED,
+	QP_IMAGE_COMPRESSION_STRATEGY_HUFFMAN_ONLY,
+	QP_IMAGE_COMPRESSION_STRATEGY_RLE,
+
+	QP_IMAGE_COMPRESSION_STRATEGY_LAST
+} qpImageCompressionStrategy;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Image encoder configuration
+ *
+ * With numThreads > 0 pixel data of PNG images is copied and compressed
+ * in background threads. Images are written in order: any other log
+ * write first waits for pending images. Images that would exceed
+ * maxPendingBytes of copied and compressed data are compressed
+ * synchronously. Pending images are dropped when a case is terminated.
+ *//*--------------------------------------------------------------------*/
+typedef struct qpImageEncoderConfig_s
+{
+	int							numThreads;			/*!< Number of encoding threads, 0 encodes synchronously.	*/
+	int							compressionLevel;	/*!< zlib compression level 0-9, -1 for zlib default.		*/
+	qpImageCompressionStrategy	strategy;
+	size_t						maxPendingBytes;	/*!< Memory budget for pending images.						*/
+} qpImageEncoderConfig;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Test log flush policy
+ *
+ * Flush policy controls when written log data is flushed to the file.
+ * Log is always flushed when a case is terminated, when qpTestLog_flush()
+ * is called, and when the log is destroyed.
+ *//*--------------------------------------------------------------------*/
+typedef enum qpTestLogFlushPolicy_e
+{
+	QP_TEST_LOG_FLUSH_POLICY_CASE = 0,		/*!< Flush at start and end of each case and wait for completion.	*/
+	QP_TEST_LOG_FLUSH_POLICY_NUM_CASES,		/*!< Flush after every flushNumCases cases.							*/
+	QP_TEST_LOG_FLUSH_POLICY_TIME,			/*!< Flush after case if flushIntervalMs has passed since last flush.	*/
+	QP_TEST_LOG_FLUSH_POLICY_CRASH,			/*!< Flush only when required.										*/
+
+	QP_TEST_LOG_FLUSH_POLICY_LAST
+} qpTestLogFlushPolicy;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Test log output buffering configuration
+ *
+ * With bufferSize > 0 log data is collected into a ring buffer of given
+ * size and written to the file by a background thread. Writes only wait
+ * for the thread if the buffer is full. Flushes other than those
+ * required by QP_TEST_LOG_FLUSH_POLICY_CASE, case termination or
+ * qpTestLog_flush() do not wait for completion.
+ *//*--------------------------------------------------------------------*/
+typedef struct qpTestLogBufferConfig_s
+{
+	size_t					bufferSize;			/*!< Output buffer size, 0 writes directly to file.	*/
+	qpTestLogFlushPolicy	flushPolicy;
+	int						flushNumCases;		/*!< Cases between flushes with QP_TEST_LOG_FLUSH_POLICY_NUM_CASES.	*/
+	int						flushIntervalMs;	/*!< Minimum flush interval with QP_TEST_LOG_FLUSH_POLICY_TIME.		*/
+} qpTestLogBufferConfig;
+
 /* Test log flags. */
 typedef enum qpTestLogFlag_e
 {
-	QP_TEST_LOG_EXCLUDE_IMAGES	= (1<<0)		/*!< Do not log images. This reduces log size considerably.		*/
+	QP_TEST_LOG_EXCLUDE_IMAGES		= (1<<0),	/*!< Do not log images. This reduces log size considerably.		*/
+	QP_TEST_LOG_DEDUPLICATE_IMAGES	= (1<<1),	/*!< Write identical images once, repeats reference the first.	*/
+	QP_TEST_LOG_BINARY_FORMAT		= (1<<2)	/*!< Write compact binary log instead of XML.					*/
 } qpTestLogFlag;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Limit for images referenced by deduplicated images
+ *
+ * Image written with Hash attribute in a completed case can be referenced
+ * until images written after it, including itself, total more than this
+ * many bytes of image data. Images of the current case can always be
+ * referenced. Result parsers drop images using the same rule.
+ *//*--------------------------------------------------------------------*/
+enum
+{
+	QP_TEST_LOG_MAX_REFERENCEABLE_IMAGE_BYTES	= 64*1024*1024
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Container record types of binary test log
+ *
+ * Binary logs start with magic "dEQPblog" and little-endian deUint32
+ * format version (currently 1), followed by records. Each record is a
+ * type byte, little-endian deUint32 payload size and payload. Strings
+ * are stored as deUint32 length followed by characters.
+ *
+ * Container records replace the # lines of the text format. Test case
+ * results are written as qpXmlWriter binary records (see
+ * qpXmlBinaryRecordType). Readers should skip unknown records.
+ *//*--------------------------------------------------------------------*/
+typedef enum qpBinaryLogRecordType_e
+{
+	QP_BINARY_LOG_RECORD_SESSION_INFO = 0x10,			/*!< Attribute and value strings.	*/
+	QP_BINARY_LOG_RECORD_BEGIN_SESSION,					/*!< Empty payload.					*/
+	QP_BINARY_LOG_RECORD_END_SESSION,					/*!< Empty payload.					*/
+	QP_BINARY_LOG_RECORD_BEGIN_TEST_CASE_RESULT,		/*!< Test case path string.			*/
+	QP_BINARY_LOG_RECORD_END_TEST_CASE_RESULT,			/*!< Empty payload.					*/
+	QP_BINARY_LOG_RECORD_TERMINATE_TEST_CASE_RESULT,	/*!< Result code string.			*/
+
+	QP_BINARY_LOG_RECORD_LAST
+} qpBinaryLogRecordType;
+
 /* Shader type. */
 typedef enum qpShaderType_e
 {
@@ -229,6 +334,13 @@ deBool			qpTestLog_endSampleList			(qpTestLog* log);
 
 deUint32		qpTestLog_getLogFlags			(const qpTestLog* log);
 
+void			qpImageEncoderConfig_init		(qpImageEncoderConfig* config);
+deBool			qpTestLog_setImageEncoderConfig	(qpTestLog* log, const qpImageEncoderConfig* config);
+
+void			qpTestLogBufferConfig_init		(qpTestLogBufferConfig* config);
+deBool			qpTestLog_setBufferConfig		(qpTestLog* log, const qpTestLogBufferConfig* config);
+void			qpTestLog_flush					(qpTestLog* log);
+
 const char*		qpGetTestResultName				(qpTestResult result);
 
 DE_END_EXTERN_C
@@ -25,6 +25,7 @@
 
 #include "deMemory.h"
 #include "deInt32.h"
+#include "deString.h"
 
 /*------------------------------------------------------------------------
  * qpXmlWriter stand-alone implementation.
@@ -36,15 +37,83 @@
 struct qpXmlWriter_s
 {
 	FILE*				outputFile;
+	qpXmlWriteFunc		writeFunc;			/*!< Used instead of outputFile if set.	*/
+	void*				writeUserPtr;
+	deBool				isBinary;			/*!< Write binary records instead of XML.	*/
 
 	deBool				xmlPrevIsStartElement;
 	deBool				xmlIsWriting;
 	int					xmlElementDepth;
 };
 
+static void writeStr (qpXmlWriter* writer, const char* str)
+{
+	if (writer->writeFunc)
+		writer->writeFunc(writer->writeUserPtr, str, strlen(str));
+	else
+		fputs(str, writer->outputFile);
+}
+
+static void writeBytes (qpXmlWriter* writer, const void* data, size_t numBytes)
+{
+	if (writer->writeFunc)
+		writer->writeFunc(writer->writeUserPtr, (const char*)data, numBytes);
+	else
+		fwrite(data, 1, numBytes, writer->outputFile);
+}
+
+static void writeUint32 (qpXmlWriter* writer, deUint32 value)
+{
+	deUint8	bytes[4];
+	int		ndx;
+
+	for (ndx = 0; ndx < 4; ndx++)
+		bytes[ndx] = (deUint8)(value >> (8*ndx));
+
+	writeBytes(writer, bytes, sizeof(bytes));
+}
+
+static void writeRecordHeader (qpXmlWriter* writer, qpXmlBinaryRecordType type, size_t payloadSize)
+{
+	const deUint8 typeByte = (deUint8)type;
+
+	DE_ASSERT(payloadSize <= 0xffffffffu);
+
+	writeBytes(writer, &typeByte, 1);
+	writeUint32(writer, (deUint32)payloadSize);
+}
+
+static void writeBinaryString (qpXmlWriter* writer, const char* str)
+{
+	const size_t length = strlen(str);
+
+	writeUint32(writer, (deUint32)length);
+	writeBytes(writer, str, length);
+}
+
+static const char* getAttribValueStr (const qpXmlAttribute* attrib, char* buf, int bufSize)
+{
+	switch (attrib->type)
+	{
+		case QP_XML_ATTRIBUTE_STRING:
+			return attrib->stringValue;
+
+		case QP_XML_ATTRIBUTE_INT:
+			deSprintf(buf, bufSize, "%d", attrib->intValue);
+			return buf;
+
+		case QP_XML_ATTRIBUTE_BOOL:
+			return attrib->boolValue ? "True" : "False";
+
+		default:
+			DE_ASSERT(DE_FALSE);
+			return "";
+	}
+}
+
 static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 {
-	char		buf[256 + 10];
+	char		buf[256 + 16];
 	char*		d		= &buf[0];
 	const char*	s		= str;
 	deBool		isEOS	= DE_FALSE;
@@ -105,16 +174,17 @@ static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 		else
 			*d++ = *s++;
 
-		/* Write buffer if EOS or buffer full. */
-		if (isEOS || ((d - &buf[0]) >= 4))
+		/* Write buffer if EOS or buffer full. Longest escape sequence is 11 chars. */
+		if (isEOS || ((d - &buf[0]) >= 256))
 		{
 			*d = 0;
-			fprintf(writer->outputFile, "%s", buf);
+			writeStr(writer, buf);
 			d = &buf[0];
 		}
 	} while (!isEOS);
 
-	fflush(writer->outputFile);
+	if (writer->outputFile)
+		fflush(writer->outputFile);
 	DE_ASSERT(d == &buf[0]); /* buffer must be empty */
 	return DE_TRUE;
 }
@@ -132,6 +202,31 @@ qpXmlWriter* qpXmlWriter_createFileWriter (FILE* outputFile, deBool useCompressi
 	return writer;
 }
 
+qpXmlWriter* qpXmlWriter_createCallbackWriter (qpXmlWriteFunc writeFunc, void* userPtr)
+{
+	qpXmlWriter* writer = (qpXmlWriter*)deCalloc(sizeof(qpXmlWriter));
+	if (!writer)
+		return DE_NULL;
+
+	DE_ASSERT(writeFunc);
+
+	writer->writeFunc		= writeFunc;
+	writer->writeUserPtr	= userPtr;
+
+	return writer;
+}
+
+qpXmlWriter* qpXmlWriter_createBinaryWriter (qpXmlWriteFunc writeFunc, void* userPtr)
+{
+	qpXmlWriter* writer = qpXmlWriter_createCallbackWriter(writeFunc, userPtr);
+	if (!writer)
+		return DE_NULL;
+
+	writer->isBinary = DE_TRUE;
+
+	return writer;
+}
+
 void qpXmlWriter_destroy (qpXmlWriter* writer)
 {
 	DE_ASSERT(writer);
@@ -143,7 +238,7 @@ static deBool closePending (qpXmlWriter* writer)
 {
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">\n");
+		writeStr(writer, ">\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
@@ -161,7 +256,12 @@ deBool qpXmlWriter_startDocument (qpXmlWriter* writer)
 	writer->xmlIsWriting			= DE_TRUE;
 	writer->xmlElementDepth			= 0;
 	writer->xmlPrevIsStartElement	= DE_FALSE;
-	fprintf(writer->outputFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
+	if (writer->isBinary)
+		writeRecordHeader(writer, QP_XML_BINARY_RECORD_START_DOCUMENT, 0);
+	else
+		writeStr(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
 	return DE_TRUE;
 }
 
@@ -179,54 +279,79 @@ deBool qpXmlWriter_endDocument (qpXmlWriter* writer)
 	DE_ASSERT(writer->xmlElementDepth == 0);
 	closePending(writer);
 	writer->xmlIsWriting = DE_FALSE;
+
+	if (writer->isBinary)
+		writeRecordHeader(writer, QP_XML_BINARY_RECORD_END_DOCUMENT, 0);
+
 	return DE_TRUE;
 }
 
 deBool qpXmlWriter_writeString (qpXmlWriter* writer, const char* str)
 {
+	if (writer->isBinary)
+	{
+		const size_t length = strlen(str);
+
+		writeRecordHeader(writer, QP_XML_BINARY_RECORD_STRING, length);
+		writeBytes(writer, str, length);
+		return DE_TRUE;
+	}
+
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">");
+		writeStr(writer, ">");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
 	return writeEscaped(writer, str);
 }
 
+static deBool writeBinaryStartElement (qpXmlWriter* writer, const char* elementName, int numAttribs, const qpXmlAttribute* attribs)
+{
+	size_t	payloadSize	= 4 + strlen(elementName) + 4;
+	char	buf[64];
+	int		ndx;
+
+	for (ndx = 0; ndx < numAttribs; ndx++)
+		payloadSize += 4 + strlen(attribs[ndx].name) + 4 + strlen(getAttribValueStr(&attribs[ndx], buf, (int)sizeof(buf)));
+
+	writeRecordHeader(writer, QP_XML_BINARY_RECORD_START_ELEMENT, payloadSize);
+	writeBinaryString(writer, elementName);
+	writeUint32(writer, (deUint32)numAttribs);
+
+	for (ndx = 0; ndx < numAttribs; ndx++)
+	{
+		writeBinaryString(writer, attribs[ndx].name);
+		writeBinaryString(writer, getAttribValueStr(&attribs[ndx], buf, (int)sizeof(buf)));
+	}
+
+	writer->xmlElementDepth++;
+	return DE_TRUE;
+}
+
 deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, int numAttribs, const qpXmlAttribute* attribs)
 {
 	int ndx;
 
+	if (writer->isBinary)
+		return writeBinaryStartElement(writer, elementName, numAttribs, attribs);
+
 	closePending(writer);
 
-	fprintf(writer->outputFile, "%s<%s", getIndentStr(writer->xmlElementDepth), elementName);
+	writeStr(writer, getIndentStr(writer->xmlElementDepth));
+	writeStr(writer, "<");
+	writeStr(writer, elementName);
 
 	for (ndx = 0; ndx < numAttribs; ndx++)
 	{
-		const qpXmlAttribute* attrib = &attribs[ndx];
-		fprintf(writer->outputFile, " %s=\"", attrib->name);
-		switch (attrib->type)
-		{
-			case QP_XML_ATTRIBUTE_STRING:
-				writeEscaped(writer, attrib->stringValue);
-				break;
-
-			case QP_XML_ATTRIBUTE_INT:
-			{
-				char buf[64];
-				sprintf(buf, "%d", attrib->intValue);
-				writeEscaped(writer, buf);
-				break;
-			}
-
-			case QP_XML_ATTRIBUTE_BOOL:
-				writeEscaped(writer, attrib->boolValue ? "True" : "False");
-				break;
-
-			default:
-				DE_ASSERT(DE_FALSE);
-		}
-		fprintf(writer->outputFile, "\"");
+		const qpXmlAttribute*	attrib	= &attribs[ndx];
+		char					buf[64];
+
+		writeStr(writer, " ");
+		writeStr(writer, attrib->name);
+		writeStr(writer, "=\"");
+		writeEscaped(writer, getAttribValueStr(attrib, buf, (int)sizeof(buf)));
+		writeStr(writer, "\"");
 	}
 
 	writer->xmlElementDepth++;
@@ -239,13 +364,24 @@ deBool qpXmlWriter_endElement (qpXmlWriter* writer, const char* elementName)
 	DE_ASSERT(writer && writer->xmlElementDepth > 0);
 	writer->xmlElementDepth--;
 
+	if (writer->isBinary)
+	{
+		writeRecordHeader(writer, QP_XML_BINARY_RECORD_END_ELEMENT, 4 + strlen(elementName));
+		writeBinaryString(writer, elementName);
+		return DE_TRUE;
+	}
+
 	if (writer->xmlPrevIsStartElement) /* leave flag as-is */
 	{
-		fprintf(writer->outputFile, " />\n");
+		writeStr(writer, " />\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 	else
-		fprintf(writer->outputFile, "</%s>\n", /*getIndentStr(writer->xmlElementDepth),*/ elementName);
+	{
+		writeStr(writer, "</");
+		writeStr(writer, elementName);
+		writeStr(writer, ">\n");
+	}
 
 	return DE_TRUE;
 }
@@ -268,6 +404,13 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int nu
 
 	DE_ASSERT(writer && data && (numBytes > 0));
 
+	if (writer->isBinary)
+	{
+		writeRecordHeader(writer, QP_XML_BINARY_RECORD_DATA, (size_t)numBytes);
+		writeBytes(writer, data, (size_t)numBytes);
+		return DE_TRUE;
+	}
+
 	/* Close and pending writes. */
 	closePending(writer);
 
@@ -294,18 +437,18 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int nu
 		/* Write indent (if needed). */
 		if (writeIndent)
 		{
-			fprintf(writer->outputFile, "%s", indentStr);
+			writeStr(writer, indentStr);
 			writeIndent = DE_FALSE;
 		}
 
 		/* Write data. */
-		fprintf(writer->outputFile, "%s", &d[0]);
+		writeStr(writer, &d[0]);
 
 		/* EOL every now and then. */
 		numWritten += 4;
 		if (numWritten >= 64)
 		{
-			fprintf(writer->outputFile, "\n");
+			writeStr(writer, "\n");
 			numWritten = 0;
 			writeIndent = DE_TRUE;
 		}
@@ -313,7 +456,7 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int nu
 
 	/* Last EOL. */
 	if (numWritten > 0)
-		fprintf(writer->outputFile, "\n");
+		writeStr(writer, "\n");
 
 	DE_ASSERT(srcNdx == numBytes);
 	return DE_TRUE;
@@ -31,6 +31,28 @@ DE_BEGIN_EXTERN_C
 
 typedef struct qpXmlWriter_s	qpXmlWriter;
 
+typedef void (*qpXmlWriteFunc) (void* userPtr, const char* data, size_t numBytes);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Record types written by binary XML writers
+ *
+ * Each writer call is written as a record: type byte, little-endian
+ * deUint32 payload size and payload. Strings inside payloads are stored
+ * as deUint32 length followed by characters without terminator.
+ * Attribute values are stored as they would appear in XML.
+ *//*--------------------------------------------------------------------*/
+typedef enum qpXmlBinaryRecordType_e
+{
+	QP_XML_BINARY_RECORD_START_DOCUMENT = 1,	/*!< Empty payload.												*/
+	QP_XML_BINARY_RECORD_END_DOCUMENT,			/*!< Empty payload.												*/
+	QP_XML_BINARY_RECORD_START_ELEMENT,			/*!< Name, deUint32 attribute count, attribute names and values.	*/
+	QP_XML_BINARY_RECORD_END_ELEMENT,			/*!< Name.														*/
+	QP_XML_BINARY_RECORD_STRING,				/*!< Unescaped string data as payload.							*/
+	QP_XML_BINARY_RECORD_DATA,					/*!< Raw data as payload, base64 encoded in XML.				*/
+
+	QP_XML_BINARY_RECORD_LAST
+} qpXmlBinaryRecordType;
+
 typedef enum qpXmlAttributeType_e
 {
 	QP_XML_ATTRIBUTE_STRING = 0,
@@ -89,6 +111,29 @@ DE_INLINE qpXmlAttribute qpSetBoolAttrib (const char* name, deBool value)
  *//*--------------------------------------------------------------------*/
 qpXmlWriter*	qpXmlWriter_createFileWriter (FILE* outFile, deBool useCompression);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Create XML Writer instance that outputs through a callback
+ *
+ * Callback writers never flush, caller is responsible for flushing the
+ * output written by the callback.
+ * \param writeFunc Function called with each chunk of output
+ * \param userPtr User pointer passed to writeFunc
+ * \return qpXmlWriter instance, or DE_NULL if out of memory
+ *//*--------------------------------------------------------------------*/
+qpXmlWriter*	qpXmlWriter_createCallbackWriter (qpXmlWriteFunc writeFunc, void* userPtr);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Create writer that outputs binary records through a callback
+ *
+ * Binary writers encode the same document as a stream of length-prefixed
+ * records (see qpXmlBinaryRecordType) without escaping or base64
+ * encoding. Output is never flushed.
+ * \param writeFunc Function called with each chunk of output
+ * \param userPtr User pointer passed to writeFunc
+ * \return qpXmlWriter instance, or DE_NULL if out of memory
+ *//*--------------------------------------------------------------------*/
+qpXmlWriter*	qpXmlWriter_createBinaryWriter (qpXmlWriteFunc writeFunc, void* userPtr);
+
 /*--------------------------------------------------------------------*//*!
  * \brief XML Writer instance
  * \param a	qpXmlWriter instance
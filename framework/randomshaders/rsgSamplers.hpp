@@ -42,18 +42,18 @@ public:
 
 	Sampler2D (const tcu::Texture2D* texture, const tcu::Sampler& sampler)
 		: m_texture	(texture)
-		, m_sampler	(sampler)
+		, m_sampler	(sampler, texture->getFormat())
 	{
 	}
 
 	inline tcu::Vec4 sample (float s, float t, float lod) const
 	{
-		return m_texture->sample(m_sampler, s, t, lod);
+		return m_texture->getView().sample(m_sampler, s, t, lod);
 	}
 
 private:
 	const tcu::Texture2D*		m_texture;
-	tcu::Sampler				m_sampler;
+	tcu::CompiledSampler		m_sampler;
 };
 
 class SamplerCube
@@ -67,18 +67,18 @@ public:
 
 	SamplerCube (const tcu::TextureCube* texture, const tcu::Sampler& sampler)
 		: m_texture	(texture)
-		, m_sampler	(sampler)
+		, m_sampler	(sampler, texture->getFormat())
 	{
 	}
 
 	inline tcu::Vec4 sample (float s, float t, float r, float lod) const
 	{
-		return m_texture->sample(m_sampler, s, t, r, lod);
+		return m_texture->getView().sample(m_sampler, s, t, r, lod);
 	}
 
 private:
 	const tcu::TextureCube*		m_texture;
-	tcu::Sampler				m_sampler;
+	tcu::CompiledSampler		m_sampler;
 };
 
 typedef std::map<int, Sampler2D>	Sampler2DMap;
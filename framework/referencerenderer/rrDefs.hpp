@@ -25,6 +25,11 @@
 
 #include "deDefs.hpp"
 
+//! Per-stage profiling counters in rr::Renderer. Enabled with DEQP_RR_ENABLE_PROFILING in CMake.
+#if !defined(RR_ENABLE_PROFILING)
+#	define RR_ENABLE_PROFILING 0
+#endif
+
 /*--------------------------------------------------------------------*//*!
  * \brief Reference renderer
  *//*--------------------------------------------------------------------*/
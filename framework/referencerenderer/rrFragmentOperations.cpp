@@ -69,8 +69,46 @@ void clearMultisampleColorBuffer	(const tcu::PixelBufferAccess& dst, const UVec4
 void clearMultisampleDepthBuffer	(const tcu::PixelBufferAccess& dst, float v,		const WindowRectangle& r)	{ tcu::clearDepth(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v);			}
 void clearMultisampleStencilBuffer	(const tcu::PixelBufferAccess& dst, int v,			const WindowRectangle& r)	{ tcu::clearStencil(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v);			}
 
+// Convert depth value to 24-bit unorm the same way tcu::PixelBufferAccess::setPixDepth() does for UNSIGNED_INT_24_8.
+// \note Values outside [0, 1] saturate, so the result is the same whether or not the input is clamped first.
+static inline deUint32 depthToUnorm24 (float depth)
+{
+	const deUint32	maxVal	= (1u << 24) - 1;
+	const float		value	= depth * (float)maxVal;
+
+	if (!(value > 0.0f))
+		return 0u;
+	else if (value >= (float)maxVal)
+		return maxVal;
+	else
+	{
+		const float	frac	= deFloatFrac(value);
+		deUint32	intVal	= (deUint32)(value - frac);
+
+		// Round to nearest even.
+		if (frac > 0.5f || (frac == 0.5f && (intVal % 2) != 0))
+			intVal++;
+
+		return de::min(maxVal, intVal);
+	}
+}
+
+static inline bool isD24Format (const tcu::TextureFormat& format)
+{
+	return format.type == tcu::TextureFormat::UNSIGNED_INT_24_8 &&
+		   (format.order == tcu::TextureFormat::D || format.order == tcu::TextureFormat::DS);
+}
+
+static inline bool isSrcAlphaBlendState (const BlendState& state)
+{
+	return state.equation	== BLENDEQUATION_ADD		&&
+		   state.srcFunc	== BLENDFUNC_SRC_ALPHA		&&
+		   state.dstFunc	== BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+}
+
 FragmentProcessor::FragmentProcessor (void)
-	: m_sampleRegister()
+	: m_fastPathsEnabled	(true)
+	, m_sampleRegister		()
 {
 }
 
@@ -736,6 +774,122 @@ void FragmentProcessor::executeUnsignedValueWrite (int fragNdxOffset, int numSam
 	}
 }
 
+FragmentProcessor::Pipeline FragmentProcessor::compilePipeline (const tcu::ConstPixelBufferAccess&	colorBuffer,
+																const tcu::ConstPixelBufferAccess&	depthBuffer,
+																const tcu::ConstPixelBufferAccess&	stencilBuffer,
+																const FragmentOperationState&		state)
+{
+	const bool	hasDepth		= depthBuffer.getWidth() > 0	&& depthBuffer.getHeight() > 0		&& depthBuffer.getDepth() > 0;
+	const bool	hasStencil		= stencilBuffer.getWidth() > 0	&& stencilBuffer.getHeight() > 0	&& stencilBuffer.getDepth() > 0;
+	const bool	doDepthTest		= hasDepth && state.depthTestEnabled;
+	const bool	doStencilTest	= hasStencil && state.stencilTestEnabled;
+	bool		depthTestLess	= false;
+	bool		alphaBlend		= false;
+
+	if (colorBuffer.getFormat() != tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8))
+		return PIPELINE_GENERIC;
+
+	if (!(state.colorMask[0] && state.colorMask[1] && state.colorMask[2] && state.colorMask[3]))
+		return PIPELINE_GENERIC;
+
+	if (doStencilTest)
+		return PIPELINE_GENERIC;
+
+	if (doDepthTest)
+	{
+		if (state.depthFunc != TESTFUNC_LESS || !isD24Format(depthBuffer.getFormat()))
+			return PIPELINE_GENERIC;
+
+		depthTestLess = true;
+	}
+
+	if (state.blendMode == BLENDMODE_STANDARD)
+	{
+		if (!isSrcAlphaBlendState(state.blendRGBState) || !isSrcAlphaBlendState(state.blendAState))
+			return PIPELINE_GENERIC;
+
+		alphaBlend = true;
+	}
+	else if (state.blendMode != BLENDMODE_NONE)
+		return PIPELINE_GENERIC;
+
+	if (depthTestLess)
+		return (alphaBlend) ? (PIPELINE_RGBA8_DEPTH_LESS_ALPHA_BLEND) : (PIPELINE_RGBA8_DEPTH_LESS);
+	else
+		return (alphaBlend) ? (PIPELINE_RGBA8_ALPHA_BLEND) : (PIPELINE_RGBA8);
+}
+
+template<bool DepthTestLess, bool AlphaBlend>
+void FragmentProcessor::renderRGBA8 (const tcu::PixelBufferAccess&	colorBuffer,
+									 const tcu::PixelBufferAccess&	depthBuffer,
+									 const Fragment*				inputFragments,
+									 int							numFragments,
+									 const FragmentOperationState&	state)
+{
+	// \note Since no two fragments share a pixel, running all stages for one sample at a time
+	//		 produces the same result as the generic pipeline running each stage for a group of samples.
+
+	const int			numSamplesPerFragment	= colorBuffer.getWidth();
+	const tcu::IVec3	colorPitch				= colorBuffer.getPitch();
+	deUint8* const		colorBasePtr			= (deUint8*)colorBuffer.getDataPtr();
+	const tcu::IVec3	depthPitch				= (DepthTestLess) ? (depthBuffer.getPitch()) : (tcu::IVec3(0));
+	deUint8* const		depthBasePtr			= (DepthTestLess) ? ((deUint8*)depthBuffer.getDataPtr()) : (DE_NULL);
+	const deUint32		depthPreserveMask		= (DepthTestLess && depthBuffer.getFormat().order == tcu::TextureFormat::DS) ? (0x000000ffu) : (0u);
+	const bool			depthWrite				= DepthTestLess && state.depthMask;
+
+	for (int fragNdx = 0; fragNdx < numFragments; fragNdx++)
+	{
+		const Fragment&	frag		= inputFragments[fragNdx];
+		const int		pixelX		= frag.pixelCoord.x();
+		const int		pixelY		= frag.pixelCoord.y();
+		const Vec4		value		= frag.value.get<float>();
+
+		if (state.scissorTestEnabled && !isInsideRect(frag.pixelCoord, state.scissorRectangle))
+			continue;
+
+		for (int fragSampleNdx = 0; fragSampleNdx < numSamplesPerFragment; fragSampleNdx++)
+		{
+			if ((frag.coverage & (1u << fragSampleNdx)) == 0)
+				continue;
+
+			if (DepthTestLess)
+			{
+				deUint32* const	depthPtr		= (deUint32*)(depthBasePtr + fragSampleNdx*depthPitch.x() + pixelX*depthPitch.y() + pixelY*depthPitch.z());
+				const deUint32	bufferWord		= *depthPtr;
+				const deUint32	sampleDepth		= depthToUnorm24(frag.sampleDepths[fragSampleNdx]);
+
+				if (!(sampleDepth < (bufferWord >> 8)))
+					continue;
+
+				if (depthWrite)
+					*depthPtr = (bufferWord & depthPreserveMask) | (sampleDepth << 8);
+			}
+
+			deUint8* const	colorPtr	= colorBasePtr + fragSampleNdx*colorPitch.x() + pixelX*colorPitch.y() + pixelY*colorPitch.z();
+
+			if (AlphaBlend)
+			{
+				const Vec4	src			= clamp(value, Vec4(0.0f), Vec4(1.0f));
+				const Vec4	dst			= clamp(Vec4(colorPtr[0]/255.0f, colorPtr[1]/255.0f, colorPtr[2]/255.0f, colorPtr[3]/255.0f), Vec4(0.0f), Vec4(1.0f));
+				const float	srcFactor	= clamp(src.w(), 0.0f, 1.0f);
+				const float	dstFactor	= clamp(1.0f - src.w(), 0.0f, 1.0f);
+
+				colorPtr[0] = tcu::floatToU8(src.x()*srcFactor + dst.x()*dstFactor);
+				colorPtr[1] = tcu::floatToU8(src.y()*srcFactor + dst.y()*dstFactor);
+				colorPtr[2] = tcu::floatToU8(src.z()*srcFactor + dst.z()*dstFactor);
+				colorPtr[3] = tcu::floatToU8(src.w()*srcFactor + dst.w()*dstFactor);
+			}
+			else
+			{
+				colorPtr[0] = tcu::floatToU8(value.x());
+				colorPtr[1] = tcu::floatToU8(value.y());
+				colorPtr[2] = tcu::floatToU8(value.z());
+				colorPtr[3] = tcu::floatToU8(value.w());
+			}
+		}
+	}
+}
+
 void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColorBuffer,
 								const rr::MultisamplePixelBufferAccess&		msDepthBuffer,
 								const rr::MultisamplePixelBufferAccess&		msStencilBuffer,
@@ -763,6 +917,21 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 	DE_ASSERT((!hasDepth || colorBuffer.getHeight() == depthBuffer.getHeight())	&& (!hasStencil || colorBuffer.getHeight() == stencilBuffer.getHeight()));
 	DE_ASSERT((!hasDepth || colorBuffer.getDepth() == depthBuffer.getDepth())	&& (!hasStencil || colorBuffer.getDepth() == stencilBuffer.getDepth()));
 
+	if (m_fastPathsEnabled)
+	{
+		switch (compilePipeline(colorBuffer, depthBuffer, stencilBuffer, state))
+		{
+			case PIPELINE_RGBA8:							renderRGBA8<false,	false>	(colorBuffer, depthBuffer, inputFragments, numFragments, state);	return;
+			case PIPELINE_RGBA8_DEPTH_LESS:					renderRGBA8<true,	false>	(colorBuffer, depthBuffer, inputFragments, numFragments, state);	return;
+			case PIPELINE_RGBA8_ALPHA_BLEND:				renderRGBA8<false,	true>	(colorBuffer, depthBuffer, inputFragments, numFragments, state);	return;
+			case PIPELINE_RGBA8_DEPTH_LESS_ALPHA_BLEND:		renderRGBA8<true,	true>	(colorBuffer, depthBuffer, inputFragments, numFragments, state);	return;
+			case PIPELINE_GENERIC:
+				break;
+			default:
+				DE_ASSERT(DE_FALSE);
+		}
+	}
+
 	int						numSamplesPerFragment		= colorBuffer.getWidth();
 	int						totalNumSamples				= numFragments*numSamplesPerFragment;
 	int						numSampleGroups				= (totalNumSamples - 1) / SAMPLE_REGISTER_SIZE + 1; // \note totalNumSamples/SAMPLE_REGISTER_SIZE rounded up.
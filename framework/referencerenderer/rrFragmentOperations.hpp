@@ -92,12 +92,23 @@ void clearMultisampleStencilBuffer		(const tcu::PixelBufferAccess& dst, int
  * FragmentProcessor.render() draws a given set of fragments. No two
  * fragments given in one render() call should have the same pixel
  * coordinates coordinates, and they must all have the same facing.
+ *
+ * At the beginning of each render() call the fragment operation state and
+ * the buffer formats are compiled into a pipeline variant. Common RGBA8
+ * configurations (no blending or source alpha blending, with or without
+ * a LESS depth test against a 24-bit depth buffer) are executed with
+ * fused per-sample loops instead of the generic per-stage passes over
+ * the sample register. Output of the fast paths is identical to that of
+ * the generic pipeline, which can be forced with setFastPathsEnabled().
  *//*--------------------------------------------------------------------*/
 class FragmentProcessor
 {
 public:
 				FragmentProcessor	(void);
 
+	void		setFastPathsEnabled	(bool enabled) { m_fastPathsEnabled = enabled;	}
+	bool		getFastPathsEnabled	(void) const { return m_fastPathsEnabled;		}
+
 	void		render				(const rr::MultisamplePixelBufferAccess&	colorMultisampleBuffer,
 									 const rr::MultisamplePixelBufferAccess&	depthMultisampleBuffer,
 									 const rr::MultisamplePixelBufferAccess&	stencilMultisampleBuffer,
@@ -111,6 +122,22 @@ private:
 	{
 		SAMPLE_REGISTER_SIZE = 64
 	};
+
+	enum Pipeline
+	{
+		PIPELINE_GENERIC = 0,						//!< Generic per-stage pipeline
+		PIPELINE_RGBA8,								//!< RGBA8 color, no depth test, no blending
+		PIPELINE_RGBA8_DEPTH_LESS,					//!< RGBA8 color, LESS depth test on 24-bit depth, no blending
+		PIPELINE_RGBA8_ALPHA_BLEND,					//!< RGBA8 color, no depth test, source alpha blending
+		PIPELINE_RGBA8_DEPTH_LESS_ALPHA_BLEND,		//!< RGBA8 color, LESS depth test on 24-bit depth, source alpha blending
+
+		PIPELINE_LAST
+	};
+
+	static Pipeline	compilePipeline				(const tcu::ConstPixelBufferAccess& colorBuffer, const tcu::ConstPixelBufferAccess& depthBuffer, const tcu::ConstPixelBufferAccess& stencilBuffer, const FragmentOperationState& state);
+
+	template<bool DepthTestLess, bool AlphaBlend>
+	static void		renderRGBA8					(const tcu::PixelBufferAccess& colorBuffer, const tcu::PixelBufferAccess& depthBuffer, const Fragment* inputFragments, int numFragments, const FragmentOperationState& state);
 	struct SampleData
 	{
 		bool						isAlive;
@@ -148,6 +175,7 @@ private:
 	void		executeSignedValueWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer);
 	void		executeUnsignedValueWrite		(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer);
 
+	bool		m_fastPathsEnabled;
 	SampleData	m_sampleRegister[SAMPLE_REGISTER_SIZE];
 } DE_WARN_UNUSED_TYPE;
 
@@ -25,6 +25,14 @@
 #include "deMath.h"
 #include "tcuVectorUtil.hpp"
 
+#if (DE_CPU == DE_CPU_X86_64) || ((DE_CPU == DE_CPU_X86) && defined(__SSE2__))
+#	define RR_EDGE_EVAL_SSE2
+#	include <emmintrin.h>
+#elif (DE_CPU == DE_CPU_ARM_64)
+#	define RR_EDGE_EVAL_NEON
+#	include <arm_neon.h>
+#endif
+
 namespace rr
 {
 
@@ -91,6 +99,134 @@ static inline bool isInsideCCW (const EdgeFunction& edge, const deInt64 edgeVal)
 	return edge.inclusive ? (edgeVal >= 0) : (edgeVal > 0);
 }
 
+namespace EdgeEvalUtil
+{
+
+// Two-lane 64-bit integer vector. Lanes hold edge values for a pair of
+// horizontally adjacent fragments in a quad.
+
+#if defined(RR_EDGE_EVAL_SSE2)
+
+typedef __m128i Int64x2;
+
+static inline Int64x2	load		(const deInt64* ptr)		{ return _mm_loadu_si128((const __m128i*)ptr);			}
+static inline void		store		(deInt64* ptr, Int64x2 v)	{ _mm_storeu_si128((__m128i*)ptr, v);					}
+static inline Int64x2	splat		(deInt64 v)					{ return _mm_set1_epi64x(v);							}
+static inline Int64x2	add			(Int64x2 a, Int64x2 b)		{ return _mm_add_epi64(a, b);							}
+static inline Int64x2	bitwiseOr	(Int64x2 a, Int64x2 b)		{ return _mm_or_si128(a, b);							}
+static inline int		signBits	(Int64x2 v)					{ return _mm_movemask_pd(_mm_castsi128_pd(v));			}
+
+#elif defined(RR_EDGE_EVAL_NEON)
+
+typedef int64x2_t Int64x2;
+
+static inline Int64x2	load		(const deInt64* ptr)		{ return vld1q_s64((const int64_t*)ptr);				}
+static inline void		store		(deInt64* ptr, Int64x2 v)	{ vst1q_s64((int64_t*)ptr, v);							}
+static inline Int64x2	splat		(deInt64 v)					{ return vdupq_n_s64(v);								}
+static inline Int64x2	add			(Int64x2 a, Int64x2 b)		{ return vaddq_s64(a, b);								}
+static inline Int64x2	bitwiseOr	(Int64x2 a, Int64x2 b)		{ return vorrq_s64(a, b);								}
+static inline int		signBits	(Int64x2 v)					{ return (int)(((deUint64)vgetq_lane_s64(v, 0) >> 63) | (((deUint64)vgetq_lane_s64(v, 1) >> 63) << 1)); }
+
+#else
+
+struct Int64x2
+{
+	deInt64 v[2];
+};
+
+static inline Int64x2	load		(const deInt64* ptr)		{ const Int64x2 r = { { ptr[0], ptr[1] } };				return r;	}
+static inline void		store		(deInt64* ptr, Int64x2 v)	{ ptr[0] = v.v[0]; ptr[1] = v.v[1];									}
+static inline Int64x2	splat		(deInt64 v)					{ const Int64x2 r = { { v, v } };							return r;	}
+static inline Int64x2	add			(Int64x2 a, Int64x2 b)		{ const Int64x2 r = { { a.v[0]+b.v[0], a.v[1]+b.v[1] } };	return r;	}
+static inline Int64x2	bitwiseOr	(Int64x2 a, Int64x2 b)		{ const Int64x2 r = { { a.v[0]|b.v[0], a.v[1]|b.v[1] } };	return r;	}
+static inline int		signBits	(Int64x2 v)					{ return (int)(((deUint64)v.v[0] >> 63) | (((deUint64)v.v[1] >> 63) << 1));	}
+
+#endif
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Incremental quad edge evaluator
+ *
+ * Edge values at quad origin are computed once per quad and the values
+ * at each fragment and sample are obtained by adding precomputed offsets
+ * a*dx + b*dy. Since integer addition is associative the results are
+ * identical to evaluating a*x + b*y + c directly.
+ *
+ * Non-inclusive edges are handled by biasing the value by -1, so that
+ * a fragment is inside all edges iff none of the biased values is
+ * negative.
+ *//*--------------------------------------------------------------------*/
+class QuadEdgeEvaluator
+{
+public:
+	QuadEdgeEvaluator (const EdgeFunction& edge01, const EdgeFunction& edge12, const EdgeFunction& edge20, const deInt64* offsets01, const deInt64* offsets12, const deInt64* offsets20)
+	{
+		m_edges[0]		= &edge01;
+		m_edges[1]		= &edge12;
+		m_edges[2]		= &edge20;
+		m_offsets[0]	= offsets01;
+		m_offsets[1]	= offsets12;
+		m_offsets[2]	= offsets20;
+
+		for (int edgeNdx = 0; edgeNdx < 3; edgeNdx++)
+			m_bias[edgeNdx] = splat(m_edges[edgeNdx]->inclusive ? 0 : -1);
+	}
+
+	void setQuad (const deInt64 x, const deInt64 y)
+	{
+		for (int edgeNdx = 0; edgeNdx < 3; edgeNdx++)
+			m_base[edgeNdx] = splat(evaluateEdge(*m_edges[edgeNdx], x, y));
+	}
+
+	//! Compute edge values at slot for all fragments in quad. Returns 4-bit mask of fragments inside the triangle.
+	int evaluate (const int slotNdx, tcu::Vector<deInt64, 4>& e01, tcu::Vector<deInt64, 4>& e12, tcu::Vector<deInt64, 4>& e20) const
+	{
+		int insideMask = 0;
+
+		for (int pairNdx = 0; pairNdx < 2; pairNdx++)
+		{
+			const int		offset	= slotNdx*4 + pairNdx*2;
+			const Int64x2	v01		= add(m_base[0], load(m_offsets[0] + offset));
+			const Int64x2	v12		= add(m_base[1], load(m_offsets[1] + offset));
+			const Int64x2	v20		= add(m_base[2], load(m_offsets[2] + offset));
+			const Int64x2	outside	= bitwiseOr(bitwiseOr(add(v01, m_bias[0]), add(v12, m_bias[1])), add(v20, m_bias[2]));
+
+			store(e01.getPtr() + pairNdx*2, v01);
+			store(e12.getPtr() + pairNdx*2, v12);
+			store(e20.getPtr() + pairNdx*2, v20);
+
+			insideMask |= (~signBits(outside) & 0x3) << (pairNdx*2);
+		}
+
+		return insideMask;
+	}
+
+private:
+	const EdgeFunction*	m_edges[3];
+	const deInt64*		m_offsets[3];
+	Int64x2				m_bias[3];
+	Int64x2				m_base[3];
+};
+
+//! Expand 4-bit fragment mask from QuadEdgeEvaluator::evaluate() into coverage bits for sample.
+static inline deUint64 getQuadCoverage (const int insideMask, const int numSamples, const int sampleNdx)
+{
+	return	((deUint64)((insideMask >> 0) & 1) << (getCoverageOffset(numSamples, 0, 0) + sampleNdx)) |
+			((deUint64)((insideMask >> 1) & 1) << (getCoverageOffset(numSamples, 1, 0) + sampleNdx)) |
+			((deUint64)((insideMask >> 2) & 1) << (getCoverageOffset(numSamples, 0, 1) + sampleNdx)) |
+			((deUint64)((insideMask >> 3) & 1) << (getCoverageOffset(numSamples, 1, 1) + sampleNdx));
+}
+
+//! Get coverage bits of quad fragments that are within rasterization area.
+static inline deUint64 getQuadAreaMask (const int numSamples, const bool outX0, const bool outY0, const bool outX1, const bool outY1)
+{
+	return	(!outX0 && !outY0 ? getCoverageFragmentSampleBits(numSamples, 0, 0) : 0) |
+			(!outX1 && !outY0 ? getCoverageFragmentSampleBits(numSamples, 1, 0) : 0) |
+			(!outX0 && !outY1 ? getCoverageFragmentSampleBits(numSamples, 0, 1) : 0) |
+			(!outX1 && !outY1 ? getCoverageFragmentSampleBits(numSamples, 1, 1) : 0);
+}
+
+} // EdgeEvalUtil
+
 namespace LineRasterUtil
 {
 
@@ -447,12 +583,36 @@ bool doesLineSegmentExitDiamond (const SubpixelLineSegment& line, const tcu::Vec
 
 TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state)
 	: m_viewport		(viewport)
+	, m_area			(viewport)
+	, m_numSamples		(numSamples)
+	, m_winding			(state.winding)
+	, m_horizontalFill	(state.horizontalFill)
+	, m_verticalFill	(state.verticalFill)
+	, m_edgeEvaluation	(state.edgeEvaluation)
+	, m_traversal		(state.traversal)
+	, m_face			(FACETYPE_LAST)
+	, m_blockCoverage	(BLOCKCOVERAGE_NONE)
+	, m_subBlockNdx		(-1)
+	, m_subBlockCoverage(BLOCKCOVERAGE_NONE)
+{
+}
+
+TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const tcu::IVec4& area, const int numSamples, const RasterizationState& state)
+	: m_viewport		(viewport)
+	, m_area			(area)
 	, m_numSamples		(numSamples)
 	, m_winding			(state.winding)
 	, m_horizontalFill	(state.horizontalFill)
 	, m_verticalFill	(state.verticalFill)
+	, m_edgeEvaluation	(state.edgeEvaluation)
+	, m_traversal		(state.traversal)
 	, m_face			(FACETYPE_LAST)
+	, m_blockCoverage	(BLOCKCOVERAGE_NONE)
+	, m_subBlockNdx		(-1)
+	, m_subBlockCoverage(BLOCKCOVERAGE_NONE)
 {
+	DE_ASSERT(area.x() >= viewport.x() && area.x() + area.z() <= viewport.x() + viewport.z());
+	DE_ASSERT(area.y() >= viewport.y() && area.y() + area.w() <= viewport.y() + viewport.w());
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -503,6 +663,9 @@ void TriangleRasterizer::init (const tcu::Vec4& v0, const tcu::Vec4& v1, const t
 		reverseEdge(m_edge20);
 	}
 
+	if (m_edgeEvaluation == EDGEEVALUATION_SIMD)
+		initEdgeOffsets();
+
 	// Bounding box
 	const deInt64	xMin	= de::min(de::min(x0, x1), x2);
 	const deInt64	xMax	= de::max(de::max(x0, x1), x2);
@@ -525,7 +688,175 @@ void TriangleRasterizer::init (const tcu::Vec4& v0, const tcu::Vec4& v1, const t
 	m_bboxMax.x() = de::clamp(m_bboxMax.x(), wX0, wX1);
 	m_bboxMax.y() = de::clamp(m_bboxMax.y(), wY0, wY1);
 
-	m_curPos = m_bboxMin;
+	// Restrict to rasterization area. Start is moved in steps of whole quads so
+	// that quad positions (and thus derivatives) are the same as without area.
+	if (m_area != m_viewport)
+	{
+		const int	aX0		= m_area.x();
+		const int	aY0		= m_area.y();
+		const int	aX1		= aX0 + m_area.z() - 1;
+		const int	aY1		= aY0 + m_area.w() - 1;
+
+		if (m_bboxMin.x() < aX0)
+			m_bboxMin.x() += (aX0 - m_bboxMin.x()) & ~1;
+		if (m_bboxMin.y() < aY0)
+			m_bboxMin.y() += (aY0 - m_bboxMin.y()) & ~1;
+
+		m_bboxMax.x() = de::min(m_bboxMax.x(), aX1);
+		m_bboxMax.y() = de::min(m_bboxMax.y(), aY1);
+	}
+
+	m_curPos		= m_bboxMin;
+	m_blockPos		= m_bboxMin;
+	m_subBlockNdx	= -1;
+
+	// Nothing to rasterize?
+	if (m_bboxMin.x() > m_bboxMax.x())
+	{
+		m_curPos.y()	= m_bboxMax.y() + 1;
+		m_blockPos.y()	= m_bboxMax.y() + 1;
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Classify block of size x size pixels against triangle edges
+ *
+ * All sample positions of pixels in block are within the closed subpixel
+ * rectangle spanned by block corners, so evaluating edges at the corners
+ * gives conservative bounds for edge values at any sample in the block.
+ *//*--------------------------------------------------------------------*/
+TriangleRasterizer::BlockCoverage TriangleRasterizer::classifyBlock (const tcu::IVec2& pos, int size) const
+{
+	const deInt64			sx0			= toSubpixelCoord(pos.x());
+	const deInt64			sy0			= toSubpixelCoord(pos.y());
+	const deInt64			sx1			= toSubpixelCoord(pos.x() + size);
+	const deInt64			sy1			= toSubpixelCoord(pos.y() + size);
+	const EdgeFunction*		edges[]		= { &m_edge01, &m_edge12, &m_edge20 };
+	bool					allInside	= true;
+
+	for (int edgeNdx = 0; edgeNdx < DE_LENGTH_OF_ARRAY(edges); edgeNdx++)
+	{
+		const EdgeFunction&	edge		= *edges[edgeNdx];
+		const deInt64		minValue	= evaluateEdge(edge, edge.a >= 0 ? sx0 : sx1, edge.b >= 0 ? sy0 : sy1);
+		const deInt64		maxValue	= evaluateEdge(edge, edge.a >= 0 ? sx1 : sx0, edge.b >= 0 ? sy1 : sy0);
+
+		if (!isInsideCCW(edge, maxValue))
+			return BLOCKCOVERAGE_NONE;
+
+		if (!isInsideCCW(edge, minValue))
+			allInside = false;
+	}
+
+	return allInside ? BLOCKCOVERAGE_FULL : BLOCKCOVERAGE_PARTIAL;
+}
+
+void TriangleRasterizer::nextBlock (void)
+{
+	m_subBlockNdx	 = -1;
+	m_blockPos.x()	+= BLOCK_SIZE;
+
+	if (m_blockPos.x() > m_bboxMax.x())
+	{
+		m_blockPos.x()	 = m_bboxMin.x();
+		m_blockPos.y()	+= BLOCK_SIZE;
+	}
+}
+
+//! Advance to next sub-block that may contain covered samples. Returns false when whole bounding box has been visited.
+bool TriangleRasterizer::nextSubBlock (void)
+{
+	for (;;)
+	{
+		if (m_subBlockNdx < 0)
+		{
+			if (m_blockPos.y() > m_bboxMax.y())
+				return false;
+
+			m_blockCoverage = classifyBlock(m_blockPos, BLOCK_SIZE);
+
+			if (m_blockCoverage == BLOCKCOVERAGE_NONE)
+			{
+				nextBlock();
+				continue;
+			}
+		}
+
+		m_subBlockNdx += 1;
+
+		if (m_subBlockNdx == 4)
+		{
+			nextBlock();
+			continue;
+		}
+
+		{
+			const tcu::IVec2	subBlockPos	= m_blockPos + tcu::IVec2((m_subBlockNdx % 2) * SUB_BLOCK_SIZE, (m_subBlockNdx / 2) * SUB_BLOCK_SIZE);
+
+			if (subBlockPos.x() > m_bboxMax.x() || subBlockPos.y() > m_bboxMax.y())
+				continue;
+
+			m_subBlockCoverage = (m_blockCoverage == BLOCKCOVERAGE_FULL) ? BLOCKCOVERAGE_FULL : classifyBlock(subBlockPos, SUB_BLOCK_SIZE);
+
+			if (m_subBlockCoverage == BLOCKCOVERAGE_NONE)
+				continue;
+
+			m_subBlockMin	= subBlockPos;
+			m_subBlockMax	= tcu::min(subBlockPos + tcu::IVec2(SUB_BLOCK_SIZE-1), m_bboxMax);
+			m_curPos		= subBlockPos;
+
+			return true;
+		}
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get next quad to rasterize
+ * \param quadPos		Position of quad
+ * \param fullyCovered	True if all samples of quad are known to be inside triangle
+ * \return False if there are no more quads
+ *//*--------------------------------------------------------------------*/
+bool TriangleRasterizer::nextQuad (tcu::IVec2& quadPos, bool& fullyCovered)
+{
+	if (m_traversal == TRIANGLETRAVERSAL_SCANLINE)
+	{
+		if (m_curPos.y() > m_bboxMax.y())
+			return false;
+
+		quadPos			= m_curPos;
+		fullyCovered	= false;
+
+		// Advance to next location
+		m_curPos.x() += 2;
+		if (m_curPos.x() > m_bboxMax.x())
+		{
+			m_curPos.y() += 2;
+			m_curPos.x()  = m_bboxMin.x();
+		}
+
+		return true;
+	}
+	else
+	{
+		DE_ASSERT(m_traversal == TRIANGLETRAVERSAL_HIERARCHICAL);
+
+		if (m_subBlockNdx < 0 || m_curPos.y() > m_subBlockMax.y())
+		{
+			if (!nextSubBlock())
+				return false;
+		}
+
+		quadPos			= m_curPos;
+		fullyCovered	= m_subBlockCoverage == BLOCKCOVERAGE_FULL;
+
+		m_curPos.x() += 2;
+		if (m_curPos.x() > m_subBlockMax.x())
+		{
+			m_curPos.y() += 2;
+			m_curPos.x()  = m_subBlockMin.x();
+		}
+
+		return true;
+	}
 }
 
 void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
@@ -542,10 +873,15 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 	const float		zb			= m_v1.z()-m_v2.z();
 	const float		zc			= m_v2.z();
 
-	while (m_curPos.y() <= m_bboxMax.y() && packetNdx < maxFragmentPackets)
+	EdgeEvalUtil::QuadEdgeEvaluator	evaluator	(m_edge01, m_edge12, m_edge20, m_edgeOffsets[0], m_edgeOffsets[1], m_edgeOffsets[2]);
+
+	tcu::IVec2		quadPos;
+	bool			fullyCovered	= false;
+
+	while (packetNdx < maxFragmentPackets && nextQuad(quadPos, fullyCovered))
 	{
-		const int		x0		= m_curPos.x();
-		const int		y0		= m_curPos.y();
+		const int		x0		= quadPos.x();
+		const int		y0		= quadPos.y();
 
 		// Subpixel coords
 		const deInt64	sx0		= toSubpixelCoord(x0)	+ halfPixel;
@@ -556,12 +892,14 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 		const deInt64	sx[4]	= { sx0, sx1, sx0, sx1 };
 		const deInt64	sy[4]	= { sy0, sy0, sy1, sy1 };
 
-		// Viewport test
-		const bool		outX1	= x0+1 == m_viewport.x()+m_viewport.z();
-		const bool		outY1	= y0+1 == m_viewport.y()+m_viewport.w();
+		// Viewport & area test
+		const bool		outX0	= x0 < m_area.x();
+		const bool		outY0	= y0 < m_area.y();
+		const bool		outX1	= x0+1 == m_area.x()+m_area.z();
+		const bool		outY1	= y0+1 == m_area.y()+m_area.w();
 
-		DE_ASSERT(x0 < m_viewport.x()+m_viewport.z());
-		DE_ASSERT(y0 < m_viewport.y()+m_viewport.w());
+		DE_ASSERT(x0 < m_area.x()+m_area.z());
+		DE_ASSERT(y0 < m_area.y()+m_area.w());
 
 		// Edge values
 		tcu::Vector<deInt64, 4>	e01;
@@ -571,26 +909,34 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 		// Coverage
 		deUint64		coverage	= 0;
 
-		// Evaluate edge values
-		for (int i = 0; i < 4; i++)
+		// \note Edge values are needed for depth and barycentrics even if quad is fully covered.
+		if (m_edgeEvaluation == EDGEEVALUATION_SIMD)
 		{
-			e01[i] = evaluateEdge(m_edge01, sx[i], sy[i]);
-			e12[i] = evaluateEdge(m_edge12, sx[i], sy[i]);
-			e20[i] = evaluateEdge(m_edge20, sx[i], sy[i]);
-		}
+			evaluator.setQuad(toSubpixelCoord(x0), toSubpixelCoord(y0));
 
-		// Compute coverage mask
-		coverage = setCoverageValue(coverage, 1, 0, 0, 0,						isInsideCCW(m_edge01, e01[0]) && isInsideCCW(m_edge12, e12[0]) && isInsideCCW(m_edge20, e20[0]));
-		coverage = setCoverageValue(coverage, 1, 1, 0, 0, !outX1 &&				isInsideCCW(m_edge01, e01[1]) && isInsideCCW(m_edge12, e12[1]) && isInsideCCW(m_edge20, e20[1]));
-		coverage = setCoverageValue(coverage, 1, 0, 1, 0, !outY1 &&				isInsideCCW(m_edge01, e01[2]) && isInsideCCW(m_edge12, e12[2]) && isInsideCCW(m_edge20, e20[2]));
-		coverage = setCoverageValue(coverage, 1, 1, 1, 0, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[3]) && isInsideCCW(m_edge12, e12[3]) && isInsideCCW(m_edge20, e20[3]));
+			coverage = EdgeEvalUtil::getQuadCoverage(evaluator.evaluate(0, e01, e12, e20), 1, 0)
+					 & EdgeEvalUtil::getQuadAreaMask(1, outX0, outY0, outX1, outY1);
+		}
+		else
+		{
+			// Evaluate edge values
+			for (int i = 0; i < 4; i++)
+			{
+				e01[i] = evaluateEdge(m_edge01, sx[i], sy[i]);
+				e12[i] = evaluateEdge(m_edge12, sx[i], sy[i]);
+				e20[i] = evaluateEdge(m_edge20, sx[i], sy[i]);
+			}
+		}
 
-		// Advance to next location
-		m_curPos.x() += 2;
-		if (m_curPos.x() > m_bboxMax.x())
+		if (fullyCovered)
+			coverage = EdgeEvalUtil::getQuadAreaMask(1, outX0, outY0, outX1, outY1);
+		else if (m_edgeEvaluation == EDGEEVALUATION_SCALAR)
 		{
-			m_curPos.y() += 2;
-			m_curPos.x()  = m_bboxMin.x();
+			// Compute coverage mask
+			coverage = setCoverageValue(coverage, 1, 0, 0, 0, !outX0 && !outY0 &&	isInsideCCW(m_edge01, e01[0]) && isInsideCCW(m_edge12, e12[0]) && isInsideCCW(m_edge20, e20[0]));
+			coverage = setCoverageValue(coverage, 1, 1, 0, 0, !outX1 && !outY0 &&	isInsideCCW(m_edge01, e01[1]) && isInsideCCW(m_edge12, e12[1]) && isInsideCCW(m_edge20, e20[1]));
+			coverage = setCoverageValue(coverage, 1, 0, 1, 0, !outX0 && !outY1 &&	isInsideCCW(m_edge01, e01[2]) && isInsideCCW(m_edge12, e12[2]) && isInsideCCW(m_edge20, e20[2]));
+			coverage = setCoverageValue(coverage, 1, 1, 1, 0, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[3]) && isInsideCCW(m_edge12, e12[3]) && isInsideCCW(m_edge20, e20[3]));
 		}
 
 		if (coverage == 0)
@@ -698,6 +1044,48 @@ DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_samplePos16) == 16*2);
 #undef SAMPLE_POS
 #undef SAMPLE_POS_TO_SUBPIXEL_COORD
 
+static const deInt64* getSamplePositions (const int numSamples)
+{
+	switch (numSamples)
+	{
+		case 2:		return s_samplePos2;
+		case 4:		return s_samplePos4;
+		case 8:		return s_samplePos8;
+		case 16:	return s_samplePos16;
+		default:
+			DE_ASSERT(false);
+			return DE_NULL;
+	}
+}
+
+void TriangleRasterizer::initEdgeOffsets (void)
+{
+	const deInt64			pixelSize	= 1ll << RASTERIZER_SUBPIXEL_BITS;
+	const deInt64			halfPixel	= 1ll << (RASTERIZER_SUBPIXEL_BITS-1);
+	const deInt64* const	samplePos	= (m_numSamples > 1) ? getSamplePositions(m_numSamples) : DE_NULL;
+	// Single-sample rasterization samples only pixel center, otherwise center comes after samples.
+	const int				numSlots	= (m_numSamples > 1) ? m_numSamples+1 : 1;
+	const EdgeFunction*		edges[]		= { &m_edge01, &m_edge12, &m_edge20 };
+
+	DE_ASSERT(numSlots <= NUM_EDGE_OFFSET_SLOTS);
+
+	for (int slotNdx = 0; slotNdx < numSlots; slotNdx++)
+	{
+		const bool		isCenter	= m_numSamples == 1 || slotNdx == m_numSamples;
+		const deInt64	ox			= isCenter ? halfPixel : samplePos[slotNdx*2 + 0];
+		const deInt64	oy			= isCenter ? halfPixel : samplePos[slotNdx*2 + 1];
+
+		for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+		{
+			const deInt64 dx = (fragNdx & 1)	? pixelSize + ox : ox;
+			const deInt64 dy = (fragNdx & 2)	? pixelSize + oy : oy;
+
+			for (int edgeNdx = 0; edgeNdx < DE_LENGTH_OF_ARRAY(edges); edgeNdx++)
+				m_edgeOffsets[edgeNdx][slotNdx*4 + fragNdx] = edges[edgeNdx]->a*dx + edges[edgeNdx]->b*dy;
+		}
+	}
+}
+
 template<int NumSamples>
 void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
 {
@@ -722,10 +1110,15 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 			DE_ASSERT(false);
 	}
 
-	while (m_curPos.y() <= m_bboxMax.y() && packetNdx < maxFragmentPackets)
+	EdgeEvalUtil::QuadEdgeEvaluator	evaluator	(m_edge01, m_edge12, m_edge20, m_edgeOffsets[0], m_edgeOffsets[1], m_edgeOffsets[2]);
+
+	tcu::IVec2		quadPos;
+	bool			fullyCovered	= false;
+
+	while (packetNdx < maxFragmentPackets && nextQuad(quadPos, fullyCovered))
 	{
-		const int		x0		= m_curPos.x();
-		const int		y0		= m_curPos.y();
+		const int		x0		= quadPos.x();
+		const int		y0		= quadPos.y();
 
 		// Base subpixel coords
 		const deInt64	sx0		= toSubpixelCoord(x0);
@@ -736,12 +1129,14 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 		const deInt64	sx[4]	= { sx0, sx1, sx0, sx1 };
 		const deInt64	sy[4]	= { sy0, sy0, sy1, sy1 };
 
-		// Viewport test
-		const bool		outX1	= x0+1 == m_viewport.x()+m_viewport.z();
-		const bool		outY1	= y0+1 == m_viewport.y()+m_viewport.w();
+		// Viewport & area test
+		const bool		outX0	= x0 < m_area.x();
+		const bool		outY0	= y0 < m_area.y();
+		const bool		outX1	= x0+1 == m_area.x()+m_area.z();
+		const bool		outY1	= y0+1 == m_area.y()+m_area.w();
 
-		DE_ASSERT(x0 < m_viewport.x()+m_viewport.z());
-		DE_ASSERT(y0 < m_viewport.y()+m_viewport.w());
+		DE_ASSERT(x0 < m_area.x()+m_area.z());
+		DE_ASSERT(y0 < m_area.y()+m_area.w());
 
 		// Edge values
 		tcu::Vector<deInt64, 4>	e01[NumSamples];
@@ -751,35 +1146,50 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 		// Coverage
 		deUint64		coverage	= 0;
 
-		// Evaluate edge values at sample positions
-		for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
+		// Per-sample edge values are only needed for inside tests and depth.
+		const bool		needSampleEdgeValues	= !fullyCovered || depthValues;
+
+		if (m_edgeEvaluation == EDGEEVALUATION_SIMD)
 		{
-			const deInt64 ox = samplePos[sampleNdx*2 + 0];
-			const deInt64 oy = samplePos[sampleNdx*2 + 1];
+			evaluator.setQuad(sx0, sy0);
 
-			for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+			if (needSampleEdgeValues)
 			{
-				e01[sampleNdx][fragNdx] = evaluateEdge(m_edge01, sx[fragNdx] + ox, sy[fragNdx] + oy);
-				e12[sampleNdx][fragNdx] = evaluateEdge(m_edge12, sx[fragNdx] + ox, sy[fragNdx] + oy);
-				e20[sampleNdx][fragNdx] = evaluateEdge(m_edge20, sx[fragNdx] + ox, sy[fragNdx] + oy);
+				for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
+					coverage |= EdgeEvalUtil::getQuadCoverage(evaluator.evaluate(sampleNdx, e01[sampleNdx], e12[sampleNdx], e20[sampleNdx]), NumSamples, sampleNdx);
 			}
-		}
 
-		// Compute coverage mask
-		for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
+			coverage &= EdgeEvalUtil::getQuadAreaMask(NumSamples, outX0, outY0, outX1, outY1);
+		}
+		else if (needSampleEdgeValues)
 		{
-			coverage = setCoverageValue(coverage, NumSamples, 0, 0, sampleNdx,						isInsideCCW(m_edge01, e01[sampleNdx][0]) && isInsideCCW(m_edge12, e12[sampleNdx][0]) && isInsideCCW(m_edge20, e20[sampleNdx][0]));
-			coverage = setCoverageValue(coverage, NumSamples, 1, 0, sampleNdx, !outX1 &&			isInsideCCW(m_edge01, e01[sampleNdx][1]) && isInsideCCW(m_edge12, e12[sampleNdx][1]) && isInsideCCW(m_edge20, e20[sampleNdx][1]));
-			coverage = setCoverageValue(coverage, NumSamples, 0, 1, sampleNdx, !outY1 &&			isInsideCCW(m_edge01, e01[sampleNdx][2]) && isInsideCCW(m_edge12, e12[sampleNdx][2]) && isInsideCCW(m_edge20, e20[sampleNdx][2]));
-			coverage = setCoverageValue(coverage, NumSamples, 1, 1, sampleNdx, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[sampleNdx][3]) && isInsideCCW(m_edge12, e12[sampleNdx][3]) && isInsideCCW(m_edge20, e20[sampleNdx][3]));
+			// Evaluate edge values at sample positions
+			for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
+			{
+				const deInt64 ox = samplePos[sampleNdx*2 + 0];
+				const deInt64 oy = samplePos[sampleNdx*2 + 1];
+
+				for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+				{
+					e01[sampleNdx][fragNdx] = evaluateEdge(m_edge01, sx[fragNdx] + ox, sy[fragNdx] + oy);
+					e12[sampleNdx][fragNdx] = evaluateEdge(m_edge12, sx[fragNdx] + ox, sy[fragNdx] + oy);
+					e20[sampleNdx][fragNdx] = evaluateEdge(m_edge20, sx[fragNdx] + ox, sy[fragNdx] + oy);
+				}
+			}
 		}
 
-		// Advance to next location
-		m_curPos.x() += 2;
-		if (m_curPos.x() > m_bboxMax.x())
+		if (fullyCovered)
+			coverage = EdgeEvalUtil::getQuadAreaMask(NumSamples, outX0, outY0, outX1, outY1);
+		else if (m_edgeEvaluation == EDGEEVALUATION_SCALAR)
 		{
-			m_curPos.y() += 2;
-			m_curPos.x()  = m_bboxMin.x();
+			// Compute coverage mask
+			for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
+			{
+				coverage = setCoverageValue(coverage, NumSamples, 0, 0, sampleNdx, !outX0 && !outY0 &&	isInsideCCW(m_edge01, e01[sampleNdx][0]) && isInsideCCW(m_edge12, e12[sampleNdx][0]) && isInsideCCW(m_edge20, e20[sampleNdx][0]));
+				coverage = setCoverageValue(coverage, NumSamples, 1, 0, sampleNdx, !outX1 && !outY0 &&	isInsideCCW(m_edge01, e01[sampleNdx][1]) && isInsideCCW(m_edge12, e12[sampleNdx][1]) && isInsideCCW(m_edge20, e20[sampleNdx][1]));
+				coverage = setCoverageValue(coverage, NumSamples, 0, 1, sampleNdx, !outX0 && !outY1 &&	isInsideCCW(m_edge01, e01[sampleNdx][2]) && isInsideCCW(m_edge12, e12[sampleNdx][2]) && isInsideCCW(m_edge20, e20[sampleNdx][2]));
+				coverage = setCoverageValue(coverage, NumSamples, 1, 1, sampleNdx, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[sampleNdx][3]) && isInsideCCW(m_edge12, e12[sampleNdx][3]) && isInsideCCW(m_edge20, e20[sampleNdx][3]));
+			}
 		}
 
 		if (coverage == 0)
@@ -815,11 +1225,26 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 			tcu::Vec4			e12f;
 			tcu::Vec4			e20f;
 
-			for (int i = 0; i < 4; i++)
+			if (m_edgeEvaluation == EDGEEVALUATION_SIMD)
+			{
+				tcu::Vector<deInt64, 4>	c01;
+				tcu::Vector<deInt64, 4>	c12;
+				tcu::Vector<deInt64, 4>	c20;
+
+				evaluator.evaluate(NumSamples, c01, c12, c20);
+
+				e01f = c01.asFloat();
+				e12f = c12.asFloat();
+				e20f = c20.asFloat();
+			}
+			else
 			{
-				e01f[i] = float(evaluateEdge(m_edge01, sx[i] + halfPixel, sy[i] + halfPixel));
-				e12f[i] = float(evaluateEdge(m_edge12, sx[i] + halfPixel, sy[i] + halfPixel));
-				e20f[i] = float(evaluateEdge(m_edge20, sx[i] + halfPixel, sy[i] + halfPixel));
+				for (int i = 0; i < 4; i++)
+				{
+					e01f[i] = float(evaluateEdge(m_edge01, sx[i] + halfPixel, sy[i] + halfPixel));
+					e12f[i] = float(evaluateEdge(m_edge12, sx[i] + halfPixel, sy[i] + halfPixel));
+					e20f[i] = float(evaluateEdge(m_edge20, sx[i] + halfPixel, sy[i] + halfPixel));
+				}
 			}
 
 			// Barycentrics & scale.
@@ -1022,6 +1447,13 @@ MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, cons
 {
 }
 
+MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& area)
+	: m_numSamples			(numSamples)
+	, m_triangleRasterizer0 (viewport, area, m_numSamples, RasterizationState())
+	, m_triangleRasterizer1 (viewport, area, m_numSamples, RasterizationState())
+{
+}
+
 MultiSampleLineRasterizer::~MultiSampleLineRasterizer ()
 {
 }
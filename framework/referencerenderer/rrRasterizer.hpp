@@ -123,11 +123,28 @@ struct EdgeFunction
  *  - Culling - logic can be implemented outside by querying visible face
  *  - Scissoring (this can be done by controlling viewport rectangle)
  *  - Any per-fragment operations
+ *
+ * Rasterization can be limited to a sub-rectangle (area) of the viewport.
+ * Fragment packets are still aligned as if the whole viewport was
+ * rasterized, so rasterizing a set of disjoint areas covering the viewport
+ * produces exactly the same packets (with coverage split between the
+ * areas) as rasterizing the whole viewport at once.
+ *
+ * Edge functions are evaluated either with plain scalar code or, when
+ * RasterizationState::edgeEvaluation is EDGEEVALUATION_SIMD, incrementally
+ * from per-triangle sample offsets using 2-wide 64-bit vector operations
+ * (SSE2 or NEON when available). Both methods produce bit-exact results.
+ *
+ * With TRIANGLETRAVERSAL_HIERARCHICAL the bounding box is walked in 16x16
+ * pixel blocks that are split into 8x8 sub-blocks. Blocks are classified
+ * against the edge functions: blocks outside the triangle are skipped
+ * and quads in fully covered blocks skip the per-sample inside tests.
  *//*--------------------------------------------------------------------*/
 class TriangleRasterizer
 {
 public:
 							TriangleRasterizer		(const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state);
+							TriangleRasterizer		(const tcu::IVec4& viewport, const tcu::IVec4& area, const int numSamples, const RasterizationState& state);
 
 	void					init					(const tcu::Vec4& v0, const tcu::Vec4& v1, const tcu::Vec4& v2);
 
@@ -141,12 +158,36 @@ private:
 	template<int NumSamples>
 	void					rasterizeMultiSample	(FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized);
 
+	void					initEdgeOffsets			(void);
+
+	enum BlockCoverage
+	{
+		BLOCKCOVERAGE_NONE = 0,		//!< No samples in block are inside triangle
+		BLOCKCOVERAGE_PARTIAL,		//!< Some samples may be inside triangle
+		BLOCKCOVERAGE_FULL			//!< All samples in block are inside triangle
+	};
+
+	BlockCoverage			classifyBlock			(const tcu::IVec2& pos, int size) const;
+	bool					nextSubBlock			(void);
+	void					nextBlock				(void);
+	bool					nextQuad				(tcu::IVec2& quadPos, bool& fullyCovered);
+
+	enum
+	{
+		NUM_EDGE_OFFSET_SLOTS	= RASTERIZER_MAX_SAMPLES_PER_FRAGMENT + 1,	//!< Sample positions and pixel center.
+		BLOCK_SIZE				= 16,
+		SUB_BLOCK_SIZE			= 8
+	};
+
 	// Constant rasterization state.
 	const tcu::IVec4		m_viewport;
+	const tcu::IVec4		m_area;			//!< Rasterized sub-rectangle of the viewport.
 	const int				m_numSamples;
 	const Winding			m_winding;
 	const HorizontalFill	m_horizontalFill;
 	const VerticalFill		m_verticalFill;
+	const EdgeEvaluation	m_edgeEvaluation;
+	const TriangleTraversal	m_traversal;
 
 	// Per-triangle rasterization state.
 	tcu::Vec4				m_v0;
@@ -159,6 +200,17 @@ private:
 	tcu::IVec2				m_bboxMin;		//!< Bounding box min (inclusive).
 	tcu::IVec2				m_bboxMax;		//!< Bounding box max (inclusive).
 	tcu::IVec2				m_curPos;		//!< Current rasterization position.
+
+	// Hierarchical traversal state.
+	tcu::IVec2				m_blockPos;				//!< Current block origin.
+	BlockCoverage			m_blockCoverage;
+	int						m_subBlockNdx;			//!< Current sub-block in block, -1 if block is not yet classified.
+	BlockCoverage			m_subBlockCoverage;
+	tcu::IVec2				m_subBlockMin;			//!< Sub-block quad range min (inclusive).
+	tcu::IVec2				m_subBlockMax;			//!< Sub-block quad range max (inclusive).
+
+	//! Edge function values relative to quad origin, [edge][slotNdx*4 + fragNdx]. Only used with EDGEEVALUATION_SIMD.
+	deInt64					m_edgeOffsets[3][NUM_EDGE_OFFSET_SLOTS*4];
 } DE_WARN_UNUSED_TYPE;
 
 
@@ -219,6 +271,7 @@ class MultiSampleLineRasterizer
 {
 public:
 								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport);
+								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& area);
 								~MultiSampleLineRasterizer	();
 
 	void						init						(const tcu::Vec4& v0, const tcu::Vec4& v1, float lineWidth);
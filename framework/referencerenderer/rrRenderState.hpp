@@ -63,18 +63,40 @@ enum CullMode
 	CULLMODE_LAST
 };
 
+//! Triangle edge function evaluation method
+enum EdgeEvaluation
+{
+	EDGEEVALUATION_SCALAR = 0,	//!< Evaluate edge functions separately for each sample
+	EDGEEVALUATION_SIMD,		//!< Evaluate edge functions incrementally, two fragments at a time
+
+	EDGEEVALUATION_LAST
+};
+
+//! Triangle traversal order
+enum TriangleTraversal
+{
+	TRIANGLETRAVERSAL_SCANLINE = 0,	//!< Visit every quad in bounding box in scanline order
+	TRIANGLETRAVERSAL_HIERARCHICAL,	//!< Classify 16x16 and 8x8 blocks first, skip blocks outside triangle
+
+	TRIANGLETRAVERSAL_LAST
+};
+
 struct RasterizationState
 {
 	RasterizationState (void)
 		: winding			(WINDING_CCW)
 		, horizontalFill	(FILL_LEFT)
 		, verticalFill		(FILL_BOTTOM)
+		, edgeEvaluation	(EDGEEVALUATION_SIMD)
+		, traversal			(TRIANGLETRAVERSAL_HIERARCHICAL)
 	{
 	}
 
-	Winding			winding;
-	HorizontalFill	horizontalFill;
-	VerticalFill	verticalFill;
+	Winding				winding;
+	HorizontalFill		horizontalFill;
+	VerticalFill		verticalFill;
+	EdgeEvaluation		edgeEvaluation;	//!< Both methods produce identical results.
+	TriangleTraversal	traversal;		//!< Only affects order of generated fragment packets.
 };
 
 enum TestFunc
@@ -346,17 +368,28 @@ struct RestartState
 	}
 };
 
+//! Triangle clipping method
+enum ClipMode
+{
+	CLIPMODE_FULL = 0,		//!< Clip triangles to all clip volume planes
+	CLIPMODE_GUARD_BAND,	//!< Clip triangles to side planes only if they leave the guard band. Near and far planes are always clipped.
+
+	CLIPMODE_LAST
+};
+
 struct RenderState
 {
 	explicit RenderState (const ViewportState& viewport_)
 		: cullMode					(CULLMODE_NONE)
 		, provokingVertexConvention	(PROVOKINGVERTEX_LAST)
+		, clipMode					(CLIPMODE_GUARD_BAND)
 		, viewport					(viewport_)
 	{
 	}
 
 	CullMode					cullMode;
 	ProvokingVertex				provokingVertexConvention;
+	ClipMode					clipMode;
 	RasterizationState			rasterization;
 	FragmentOperationState		fragOps;
 	PointState					point;
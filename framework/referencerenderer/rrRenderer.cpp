@@ -25,12 +25,20 @@
 #include "tcuVectorUtil.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuRefRenderThreads.hpp"
 #include "rrPrimitiveAssembler.hpp"
 #include "rrFragmentOperations.hpp"
 #include "rrRasterizer.hpp"
 #include "deMemory.h"
+#include "deInt32.h"
+#include "deClock.h"
+#include "deThread.h"
+#include "deThreadPool.hpp"
+#include "deMutex.hpp"
+#include "deUniquePtr.hpp"
+#include "deArrayUtil.hpp"
 
-#include <set>
+#include <map>
 
 namespace rr
 {
@@ -41,14 +49,69 @@ typedef double ClipFloat; // floating point type used in clipping
 
 typedef tcu::Vector<ClipFloat, 4> ClipVec4;
 
+enum
+{
+	RASTERIZATION_TILE_SIZE		= 64,	//!< Size of screen-space tiles used in parallel rasterization
+	VERTEX_SHADING_CHUNK_SIZE	= 256,	//!< Number of vertex packets shaded by one work item in parallel vertex shading
+	CLIP_GUARD_BAND_LIMIT		= 1<<14	//!< Maximum window coordinate magnitude of triangles accepted without side plane clipping
+};
+
 struct RasterizationInternalBuffers
 {
 	std::vector<FragmentPacket>		fragmentPackets;
 	std::vector<GenericVec4>		shaderOutputs;
 	std::vector<Fragment>			shadedFragments;
+	std::vector<float>				depthValues;
 	float*							fragmentDepthBuffer;
+
+	// Structure-of-arrays shading, used if supported by the fragment shader
+	bool							useFragmentBatches;
+	std::vector<float>				batchVaryings;
+	std::vector<float>				batchOutputs;
+
+	// Rasterization and fragment stage profiles, merged to renderer statistics after rasterization
+	StageProfile					stages[PROFILESTAGE_LAST];
 };
 
+//! Start time for addStageProfile()
+inline deUint64 getProfileTime (void)
+{
+#if RR_ENABLE_PROFILING
+	return deGetNanoseconds();
+#else
+	return 0;
+#endif
+}
+
+//! Accumulate time since startTime to profile. Returns current time for profiling the next stage.
+inline deUint64 addStageProfile (StageProfile& profile, deUint64 startTime, deUint64 numItems)
+{
+#if RR_ENABLE_PROFILING
+	const deUint64 endTime = deGetNanoseconds();
+
+	profile.timeNs		+= endTime - startTime;
+	profile.numItems	+= numItems;
+
+	return endTime;
+#else
+	DE_UNREF(profile);
+	DE_UNREF(startTime);
+	DE_UNREF(numItems);
+
+	return 0;
+#endif
+}
+
+void mergeStageProfiles (StageProfile* dst, StageProfile* src)
+{
+	for (int stageNdx = 0; stageNdx < PROFILESTAGE_LAST; ++stageNdx)
+	{
+		dst[stageNdx].timeNs	+= src[stageNdx].timeNs;
+		dst[stageNdx].numItems	+= src[stageNdx].numItems;
+		src[stageNdx]			= StageProfile();
+	}
+}
+
 deUint32 readIndexArray (const IndexType type, const void* ptr, size_t ndx)
 {
 	switch (type)
@@ -88,16 +151,6 @@ bool isEmpty (const rr::MultisampleConstPixelBufferAccess& access)
 	return access.raw().getWidth() == 0 || access.raw().getHeight() == 0 || access.raw().getDepth() == 0;
 }
 
-struct DrawContext
-{
-	int primitiveID;
-
-	DrawContext (void)
-		: primitiveID(0)
-	{
-	}
-};
-
 /*--------------------------------------------------------------------*//*!
  * \brief Calculates intersection of two rects given as (left, bottom, width, height)
  *//*--------------------------------------------------------------------*/
@@ -260,6 +313,44 @@ ClipVec4 ComponentPlane<Sign, CompNdx>::getLineIntersectionPoint (const ClipVec4
 	}
 }
 
+enum ClipPlaneBit
+{
+	CLIPPLANE_POS_X	= (1<<0),
+	CLIPPLANE_NEG_X	= (1<<1),
+	CLIPPLANE_POS_Y	= (1<<2),
+	CLIPPLANE_NEG_Y	= (1<<3),
+	CLIPPLANE_POS_Z	= (1<<4),
+	CLIPPLANE_NEG_Z	= (1<<5),
+
+	CLIPPLANE_XY	= CLIPPLANE_POS_X|CLIPPLANE_NEG_X|CLIPPLANE_POS_Y|CLIPPLANE_NEG_Y,
+	CLIPPLANE_Z		= CLIPPLANE_POS_Z|CLIPPLANE_NEG_Z
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get mask of clip volume planes the point is outside of
+ *
+ * Bit i corresponds to ComponentPlane i in order +X, -X, +Y, -Y, +Z, -Z and
+ * is set exactly when ComponentPlane::pointInClipVolume() would return
+ * false, including for NaN coordinates.
+ *//*--------------------------------------------------------------------*/
+deUint32 getClipOutcode (const tcu::Vec4& p)
+{
+	return (( p.x() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_POS_X))
+		 | ((-p.x() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_NEG_X))
+		 | (( p.y() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_POS_Y))
+		 | ((-p.y() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_NEG_Y))
+		 | (( p.z() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_POS_Z))
+		 | ((-p.z() <= p.w()) ? (0u) : ((deUint32)CLIPPLANE_NEG_Z));
+}
+
+//! Is point in front of the eye and inside guard band (minX, minY, maxX, maxY) given in normalized device coordinates
+bool pointInGuardBand (const tcu::Vec4& p, const tcu::Vec4& guardBand)
+{
+	return p.w() > 0.0f &&
+		   p.x() >= guardBand.x() * p.w() && p.x() <= guardBand.z() * p.w() &&
+		   p.y() >= guardBand.y() * p.w() && p.y() <= guardBand.w() * p.w();
+}
+
 struct TriangleVertex
 {
 	ClipVec4	position;
@@ -471,6 +562,283 @@ void clipTriangleToPlane (std::vector<TriangleVertex>& clippedEdges, const Trian
 
 } // cliputil
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Post-transform vertex cache
+ *
+ * Maps vertex indices to vertex packet slots so that each distinct vertex
+ * of an indexed draw is set up and shaded only once. The cache is valid
+ * for a single run of vertices (up to a primitive restart) of a single
+ * instance. Open addressing with linear probing is used, and clear() only
+ * advances the generation counter so that short runs don't pay for
+ * clearing the whole table.
+ *//*--------------------------------------------------------------------*/
+class VertexCache
+{
+public:
+	enum
+	{
+		NOT_FOUND = -1
+	};
+
+						VertexCache		(void);
+
+	void				reset			(size_t maxEntries);
+	void				clear			(void);
+	int					lookupOrInsert	(size_t vertexNdx, int newSlot);
+
+private:
+	struct Entry
+	{
+		size_t			vertexNdx;
+		int				slot;
+		deUint32		generation;
+	};
+
+	std::vector<Entry>	m_entries;
+	size_t				m_mask;
+	deUint32			m_generation;
+};
+
+VertexCache::VertexCache (void)
+	: m_mask		(0)
+	, m_generation	(1)
+{
+}
+
+//! Makes room for maxEntries entries and clears the cache. The table is never shrunk.
+void VertexCache::reset (size_t maxEntries)
+{
+	// Keep load factor at most 0.5
+	const size_t	tableSize	= (size_t)1 << deLog2Ceil32((deInt32)de::max<size_t>(maxEntries * 2, 1));
+	const Entry		emptyEntry	= { 0, 0, 0 };
+
+	if (tableSize > m_entries.size())
+	{
+		m_entries.assign(tableSize, emptyEntry);
+		m_mask			= tableSize - 1;
+		m_generation	= 1;
+	}
+	else
+		clear();
+}
+
+void VertexCache::clear (void)
+{
+	if (++m_generation == 0)
+	{
+		// Generation wrapped, entries from previous rounds could become valid again
+		for (size_t ndx = 0; ndx < m_entries.size(); ++ndx)
+			m_entries[ndx].generation = 0;
+
+		m_generation = 1;
+	}
+}
+
+//! Returns slot of an existing entry, or inserts (vertexNdx, newSlot) and returns NOT_FOUND.
+int VertexCache::lookupOrInsert (size_t vertexNdx, int newSlot)
+{
+	DE_ASSERT(!m_entries.empty());
+
+	for (size_t entryNdx = (size_t)deInt32Hash((deInt32)vertexNdx) & m_mask;; entryNdx = (entryNdx + 1) & m_mask)
+	{
+		Entry& entry = m_entries[entryNdx];
+
+		if (entry.generation != m_generation)
+		{
+			entry.vertexNdx		= vertexNdx;
+			entry.slot			= newSlot;
+			entry.generation	= m_generation;
+			return NOT_FOUND;
+		}
+		else if (entry.vertexNdx == vertexNdx)
+			return entry.slot;
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Set of vertex packets
+ *
+ * Flat open-addressed set used for finding vertices shared between
+ * primitives. Like VertexCache, clearing is done by advancing a generation
+ * counter, and the table is kept over draw calls.
+ *//*--------------------------------------------------------------------*/
+class VertexPacketSet
+{
+public:
+							VertexPacketSet	(void);
+
+	void					reset			(size_t maxEntries);
+	bool					insert			(const VertexPacket* packet);
+
+private:
+	struct Entry
+	{
+		const VertexPacket*	packet;
+		deUint32			generation;
+	};
+
+	std::vector<Entry>		m_entries;
+	size_t					m_mask;
+	deUint32				m_generation;
+};
+
+VertexPacketSet::VertexPacketSet (void)
+	: m_mask		(0)
+	, m_generation	(1)
+{
+}
+
+//! Makes room for maxEntries packets and removes all packets from the set.
+void VertexPacketSet::reset (size_t maxEntries)
+{
+	// Keep load factor at most 0.5
+	const size_t	tableSize	= (size_t)1 << deLog2Ceil32((deInt32)de::max<size_t>(maxEntries * 2, 1));
+	const Entry		emptyEntry	= { DE_NULL, 0 };
+
+	if (tableSize > m_entries.size())
+	{
+		m_entries.assign(tableSize, emptyEntry);
+		m_mask			= tableSize - 1;
+		m_generation	= 1;
+	}
+	else if (++m_generation == 0)
+	{
+		for (size_t ndx = 0; ndx < m_entries.size(); ++ndx)
+			m_entries[ndx].generation = 0;
+
+		m_generation = 1;
+	}
+}
+
+//! Inserts packet to the set. Returns false if the packet was already in the set.
+bool VertexPacketSet::insert (const VertexPacket* packet)
+{
+	DE_ASSERT(!m_entries.empty());
+
+	for (size_t entryNdx = (size_t)dePointerHash(packet) & m_mask;; entryNdx = (entryNdx + 1) & m_mask)
+	{
+		Entry& entry = m_entries[entryNdx];
+
+		if (entry.generation != m_generation)
+		{
+			entry.packet		= packet;
+			entry.generation	= m_generation;
+			return true;
+		}
+		else if (entry.packet == packet)
+			return false;
+	}
+}
+
+template <typename Primitive>
+struct PrimitiveBuffers
+{
+	std::vector<Primitive>	assembled;	//!< Output of primitive assembly
+	std::vector<Primitive>	base;		//!< Primitives converted to base type
+	std::vector<Primitive>	clipped;	//!< Output of clipping
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Buffers used by draw calls
+ *
+ * Owned by a Renderer and kept over draw calls so that a draw only
+ * allocates memory when it is larger than any of the previous draws.
+ * Buffers are resized (or cleared) before use and their contents are not
+ * valid between draws.
+ *//*--------------------------------------------------------------------*/
+struct DrawBuffers
+{
+	VertexPacketAllocator						vertexAllocator;		//!< Vertex shader outputs and vertices created by the pipeline
+	VertexPacketAllocator						geometryAllocator;		//!< Geometry shader outputs
+	std::vector<VertexPacket*>					vertexPackets;			//!< Vertex shader invocations
+	std::vector<VertexPacket*>					vertexRefs;				//!< Per-element packets of indexed draws, refer to vertexPackets
+	VertexCache									vertexCache;
+	VertexPacketSet								distinctVertices;
+
+	PrimitiveBuffers<pa::Triangle>				triangles;
+	PrimitiveBuffers<pa::Line>					lines;
+	PrimitiveBuffers<pa::Point>					points;
+	PrimitiveBuffers<pa::TriangleAdjacency>		triangleAdjacencies;
+	PrimitiveBuffers<pa::LineAdjacency>			lineAdjacencies;
+
+	// Triangle clipping
+	std::vector<cliputil::SubTriangle>			subTriangles;
+	std::vector<cliputil::SubTriangle>			nextPhaseSubTriangles;
+	std::vector<cliputil::TriangleVertex>		convexPrimitive;
+
+	// Rasterization
+	RasterizationInternalBuffers				rasterization;			//!< Used in serial rasterization
+	std::vector<RasterizationInternalBuffers>	workerRasterization;	//!< Per-thread buffers for tiled rasterization
+	std::vector<std::vector<int> >				tilePrimitives;			//!< Primitive indices binned to each tile
+	std::vector<int>							activeTiles;			//!< Indices of non-empty tiles
+	std::vector<tcu::IVec4>						activeTileRects;		//!< Rects of non-empty tiles
+
+	DrawBuffers (void)
+		: vertexAllocator	(0)
+		, geometryAllocator	(0)
+	{
+	}
+};
+
+template <typename Primitive>
+PrimitiveBuffers<Primitive>& getPrimitiveBuffers (DrawBuffers& buffers);
+
+template <> PrimitiveBuffers<pa::Triangle>&				getPrimitiveBuffers<pa::Triangle>			(DrawBuffers& buffers) { return buffers.triangles;				}
+template <> PrimitiveBuffers<pa::Line>&					getPrimitiveBuffers<pa::Line>				(DrawBuffers& buffers) { return buffers.lines;					}
+template <> PrimitiveBuffers<pa::Point>&				getPrimitiveBuffers<pa::Point>				(DrawBuffers& buffers) { return buffers.points;					}
+template <> PrimitiveBuffers<pa::TriangleAdjacency>&	getPrimitiveBuffers<pa::TriangleAdjacency>	(DrawBuffers& buffers) { return buffers.triangleAdjacencies;	}
+template <> PrimitiveBuffers<pa::LineAdjacency>&		getPrimitiveBuffers<pa::LineAdjacency>		(DrawBuffers& buffers) { return buffers.lineAdjacencies;		}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get triangle clipping guard band
+ *
+ * Returns the clip-space region (minX, minY, maxX, maxY), relative to w,
+ * that maps to window coordinates within CLIP_GUARD_BAND_LIMIT of the
+ * origin. Returns false if guard band can't be used for the viewport.
+ *//*--------------------------------------------------------------------*/
+bool getGuardBand (const ViewportState& viewport, tcu::Vec4& guardBand)
+{
+	const float	halfW	= (float)(viewport.rect.width) / 2.0f;
+	const float	halfH	= (float)(viewport.rect.height) / 2.0f;
+	const float	oX		= (float)viewport.rect.left + halfW;
+	const float	oY		= (float)viewport.rect.bottom + halfH;
+	const float	limit	= (float)CLIP_GUARD_BAND_LIMIT;
+
+	if (halfW <= 0.0f || halfH <= 0.0f)
+		return false;
+
+	guardBand = tcu::Vec4((-limit - oX) / halfW,
+						  (-limit - oY) / halfH,
+						  ( limit - oX) / halfW,
+						  ( limit - oY) / halfH);
+
+	// Viewport origin is too far for the guard band to be useful
+	return guardBand.x() < -1.0f && guardBand.y() < -1.0f && guardBand.z() > 1.0f && guardBand.w() > 1.0f;
+}
+
+struct DrawContext
+{
+	int					primitiveID;
+	de::ThreadPool*		threadPool;					//!< Tile workers, or null if rasterization is serial
+	int					fragmentPacketBatchSize;	//!< Maximum number of fragment packets shaded at once
+	bool				useGuardBand;				//!< Accept triangles within guardBand without side plane clipping
+	tcu::Vec4			guardBand;					//!< Guard band in normalized device coordinates
+	DrawBuffers&		buffers;
+	RenderStatistics&	statistics;
+
+	DrawContext (const RenderState& state, de::ThreadPool* threadPool_, int fragmentPacketBatchSize_, DrawBuffers& buffers_, RenderStatistics& statistics_)
+		: primitiveID				(0)
+		, threadPool				(threadPool_)
+		, fragmentPacketBatchSize	(fragmentPacketBatchSize_)
+		, useGuardBand				(false)
+		, buffers					(buffers_)
+		, statistics				(statistics_)
+	{
+		if (state.clipMode == CLIPMODE_GUARD_BAND)
+			useGuardBand = getGuardBand(state.viewport, guardBand);
+	}
+};
+
 tcu::Vec2 to2DCartesian (const tcu::Vec4& p)
 {
 	return tcu::Vec2(p.x(), p.y()) / p.w();
@@ -516,11 +884,19 @@ void flatshadeVertices (const Program& program, ContainerType& list)
 
 /*--------------------------------------------------------------------*//*!
  * Clip triangles to the clip volume.
+ *
+ * Triangles entirely inside the clip volume are accepted and triangles
+ * entirely outside any of the planes are discarded based on vertex
+ * outcodes. If guard band is enabled, triangles that only cross the side
+ * planes and stay in front of the eye and inside the guard band are also
+ * accepted as is; rasterization restricts them to the viewport. Triangles
+ * crossing the near or far plane are always clipped.
  *//*--------------------------------------------------------------------*/
 void clipPrimitives (std::vector<pa::Triangle>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 DrawContext&					drawContext)
 {
 	using namespace cliputil;
 
@@ -534,55 +910,63 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 	const std::vector<rr::VertexVaryingInfo>&	fragInputs			= (program.geometryShader) ? (program.geometryShader->getOutputs()) : (program.vertexShader->getOutputs());
 	const ClipVolumePlane*						planes[]			= { &clipPosX, &clipNegX, &clipPosY, &clipNegY, &clipPosZ, &clipNegZ };
 	const int									numPlanes			= (clipWithZPlanes) ? (6) : (4);
+	const deUint32								planeMask			= (clipWithZPlanes) ? ((deUint32)(CLIPPLANE_XY|CLIPPLANE_Z)) : ((deUint32)CLIPPLANE_XY);
 
-	std::vector<pa::Triangle>					outputTriangles;
+	DrawBuffers&								buffers				= drawContext.buffers;
+	RenderStatistics&							statistics			= drawContext.statistics;
+	std::vector<pa::Triangle>&					outputTriangles		= buffers.triangles.clipped;
+
+	outputTriangles.clear();
 
 	for (int inputTriangleNdx = 0; inputTriangleNdx < (int)list.size(); ++inputTriangleNdx)
 	{
-		bool clippedByPlane[6];
+		const pa::Triangle&	triangle	= list[inputTriangleNdx];
+		deUint32			crossedPlanes;
 
 		// Needs clipping?
 		{
-			bool discardPrimitive	= false;
-			bool fullyInClipVolume	= true;
+			const deUint32	outcode0	= getClipOutcode(triangle.v0->position) & planeMask;
+			const deUint32	outcode1	= getClipOutcode(triangle.v1->position) & planeMask;
+			const deUint32	outcode2	= getClipOutcode(triangle.v2->position) & planeMask;
 
-			for (int planeNdx = 0; planeNdx < numPlanes; ++planeNdx)
+			// Fully outside of some plane
+			if ((outcode0 & outcode1 & outcode2) != 0)
 			{
-				const ClipVolumePlane*	plane			= planes[planeNdx];
-				const bool				v0InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v0->position));
-				const bool				v1InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v1->position));
-				const bool				v2InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v2->position));
-
-				// Fully outside
-				if (!v0InsidePlane && !v1InsidePlane && !v2InsidePlane)
-				{
-					discardPrimitive = true;
-					break;
-				}
-				// Partially outside
-				else if (!v0InsidePlane || !v1InsidePlane || !v2InsidePlane)
-				{
-					clippedByPlane[planeNdx] = true;
-					fullyInClipVolume = false;
-				}
-				// Fully inside
-				else
-					clippedByPlane[planeNdx] = false;
+				statistics.numTrivialRejectedTriangles += 1;
+				continue;
 			}
 
-			if (discardPrimitive)
+			crossedPlanes = outcode0 | outcode1 | outcode2;
+
+			// Fully inside
+			if (crossedPlanes == 0)
+			{
+				statistics.numTrivialAcceptedTriangles += 1;
+				outputTriangles.push_back(triangle);
 				continue;
+			}
 
-			if (fullyInClipVolume)
+			// Crosses only side planes within guard band
+			if (drawContext.useGuardBand &&
+				(crossedPlanes & (deUint32)CLIPPLANE_Z) == 0 &&
+				pointInGuardBand(triangle.v0->position, drawContext.guardBand) &&
+				pointInGuardBand(triangle.v1->position, drawContext.guardBand) &&
+				pointInGuardBand(triangle.v2->position, drawContext.guardBand))
 			{
-				outputTriangles.push_back(list[inputTriangleNdx]);
+				statistics.numGuardBandTriangles += 1;
+				outputTriangles.push_back(triangle);
 				continue;
 			}
+
+			statistics.numClippedTriangles += 1;
 		}
 
 		// Clip
 		{
-			std::vector<SubTriangle>	subTriangles	(1);
+			std::vector<SubTriangle>&	subTriangles	= buffers.subTriangles;
+
+			subTriangles.resize(1);
+
 			SubTriangle&				initialTri		= subTriangles[0];
 
 			initialTri.vertices[0].position = vec4ToClipVec4(list[inputTriangleNdx].v0->position);
@@ -603,14 +987,18 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 			// Clip all subtriangles to all relevant planes
 			for (int planeNdx = 0; planeNdx < numPlanes; ++planeNdx)
 			{
-				std::vector<SubTriangle> nextPhaseSubTriangles;
+				std::vector<SubTriangle>& nextPhaseSubTriangles = buffers.nextPhaseSubTriangles;
 
-				if (!clippedByPlane[planeNdx])
+				if ((crossedPlanes & (1u << planeNdx)) == 0)
 					continue;
 
+				nextPhaseSubTriangles.clear();
+
 				for (int subTriangleNdx = 0; subTriangleNdx < (int)subTriangles.size(); ++subTriangleNdx)
 				{
-					std::vector<TriangleVertex> convexPrimitive;
+					std::vector<TriangleVertex>& convexPrimitive = buffers.convexPrimitive;
+
+					convexPrimitive.clear();
 
 					// Clip triangle and form a convex n-gon ( n c {3, 4} )
 					clipTriangleToPlane(convexPrimitive, subTriangles[subTriangleNdx].vertices, *planes[planeNdx]);
@@ -710,7 +1098,8 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 void clipPrimitives (std::vector<pa::Line>& 		list,
 					 const Program& 				program,
 					 bool 							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 DrawContext&					drawContext)
 {
 	DE_UNREF(vpalloc);
 
@@ -719,12 +1108,14 @@ void clipPrimitives (std::vector<pa::Line>& 		list,
 	// Lines are clipped only by the far and the near planes here. Line clipping by other planes done in the rasterization phase
 
 	const std::vector<rr::VertexVaryingInfo>&	fragInputs	= (program.geometryShader) ? (program.geometryShader->getOutputs()) : (program.vertexShader->getOutputs());
-	std::vector<pa::Line>						visibleLines;
+	std::vector<pa::Line>&						visibleLines	= drawContext.buffers.lines.clipped;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
 		return;
 
+	visibleLines.clear();
+
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
 		pa::Line& l = list[ndx];
@@ -781,17 +1172,20 @@ void clipPrimitives (std::vector<pa::Line>& 		list,
 void clipPrimitives (std::vector<pa::Point>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 DrawContext&					drawContext)
 {
 	DE_UNREF(vpalloc);
 	DE_UNREF(program);
 
-	std::vector<pa::Point> visiblePoints;
+	std::vector<pa::Point>& visiblePoints = drawContext.buffers.points.clipped;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
 		return;
 
+	visiblePoints.clear();
+
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
 		pa::Point& p = list[ndx];
@@ -857,14 +1251,10 @@ void transformClipCoordsToWindowCoords (const RenderState& state, ContainerType&
 		transformPrimitiveClipCoordsToWindowCoords(state, *it);
 }
 
-void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticeDistinct (VertexPacket*& packet, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	// distinct
-	if (vertices.find(packet) == vertices.end())
-	{
-		vertices.insert(packet);
-	}
-	else
+	if (!vertices.insert(packet))
 	{
 		VertexPacket* newPacket = vpalloc.alloc();
 
@@ -881,28 +1271,28 @@ void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, s
 	}
 }
 
-void makeSharedVerticesDistinct (pa::Triangle& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Triangle& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v2, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Line& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Line& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Point& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Point& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 }
 
 template <typename ContainerType>
-void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc, VertexPacketSet& vertices)
 {
-	std::set<VertexPacket*, std::less<void*> > vertices;
+	vertices.reset(list.size() * ContainerType::value_type::NUM_VERTICES);
 
 	for (typename ContainerType::iterator it = list.begin(); it != list.end(); ++it)
 		makeSharedVerticesDistinct(*it, vertices, vpalloc);
@@ -1022,13 +1412,14 @@ static float findPrimitiveMinimumResolvableDifference (const pa::Triangle& trian
 	return 0.0f;
 }
 
-void writeFragmentPackets (const RenderState&					state,
+int writeFragmentPackets (const RenderState&					state,
 						   const RenderTarget&					renderTarget,
 						   const Program&						program,
 						   const FragmentPacket*				fragmentPackets,
 						   int									numRasterizedPackets,
 						   rr::FaceType							facetype,
 						   const std::vector<rr::GenericVec4>&	fragmentOutputArray,
+						   const FragmentBatch*					fragmentBatch,
 						   const float*							depthValues,
 						   std::vector<Fragment>&				fragmentBuffer)
 {
@@ -1039,6 +1430,8 @@ void writeFragmentPackets (const RenderState&					state,
 	DE_ASSERT(fragmentOutputArray.size() >= (size_t)numRasterizedPackets*4*numOutputs);
 	DE_ASSERT(fragmentBuffer.size()      >= (size_t)numRasterizedPackets*4);
 
+	int					numFragments	= 0;
+
 	// Translate fragments but do not set the value yet
 	{
 		int	fragCount = 0;
@@ -1058,6 +1451,8 @@ void writeFragmentPackets (const RenderState&					state,
 				fragment.sampleDepths	= (depthValues) ? (&depthValues[(packetNdx*4 + yo*2 + xo)*numSamples]) : (DE_NULL);
 			}
 		}
+
+		numFragments = fragCount;
 	}
 
 	// Set per output output values
@@ -1084,8 +1479,19 @@ void writeFragmentPackets (const RenderState&					state,
 				// Add only fragments that have live samples to shaded fragments queue.
 				if (getCoverageAnyFragmentSampleLive(packet.coverage, numSamples, xo, yo))
 				{
-					Fragment& fragment		= fragmentBuffer[fragCount++];
-					fragment.value			= fragmentOutputArray[(packetNdx*4 + fragNdx) * numOutputs + outputNdx];
+					Fragment& fragment = fragmentBuffer[fragCount++];
+
+					if (fragmentBatch)
+					{
+						const int batchNdx = packetNdx*4 + fragNdx;
+
+						fragment.value = tcu::Vec4(fragmentBatch->getOutput((int)outputNdx, 0)[batchNdx],
+												   fragmentBatch->getOutput((int)outputNdx, 1)[batchNdx],
+												   fragmentBatch->getOutput((int)outputNdx, 2)[batchNdx],
+												   fragmentBatch->getOutput((int)outputNdx, 3)[batchNdx]);
+					}
+					else
+						fragment.value = fragmentOutputArray[(packetNdx*4 + fragNdx) * numOutputs + outputNdx];
 				}
 			}
 
@@ -1093,6 +1499,101 @@ void writeFragmentPackets (const RenderState&					state,
 			fragProcessor.render(renderTarget.colorBuffers[outputNdx], renderTarget.depthBuffer, renderTarget.stencilBuffer, &fragmentBuffer[0], fragCount, facetype, fragOpsState);
 		}
 	}
+
+	return numFragments;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Interpolate float varyings into structure-of-arrays batch
+ *
+ * Uses the same operations in the same order as readVarying() so that
+ * shaders see identical values in both shading interfaces.
+ *//*--------------------------------------------------------------------*/
+void interpolateFragmentBatchVaryings (const FragmentPacket* packets, int numPackets, const FragmentShadingContext& context, int numVaryings, int stride, float* dst)
+{
+	for (int varyingNdx = 0; varyingNdx < numVaryings; ++varyingNdx)
+	{
+		const tcu::Vec4	v0	= context.varyings[0][varyingNdx].get<float>();
+		const tcu::Vec4	v1	= (context.varyings[1]) ? (context.varyings[1][varyingNdx].get<float>()) : (tcu::Vec4(0.0f));
+		const tcu::Vec4	v2	= (context.varyings[2]) ? (context.varyings[2][varyingNdx].get<float>()) : (tcu::Vec4(0.0f));
+
+		for (int compNdx = 0; compNdx < 4; ++compNdx)
+		{
+			float* const comp = dst + (varyingNdx*4 + compNdx)*stride;
+
+			if (context.varyings[1] == DE_NULL)
+			{
+				for (int batchNdx = 0; batchNdx < numPackets*4; ++batchNdx)
+					comp[batchNdx] = v0[compNdx];
+			}
+			else if (context.varyings[2] == DE_NULL)
+			{
+				for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+				for (int fragNdx = 0; fragNdx < 4; ++fragNdx)
+					comp[packetNdx*4 + fragNdx] = packets[packetNdx].barycentric[0][fragNdx] * v0[compNdx]
+												+ packets[packetNdx].barycentric[1][fragNdx] * v1[compNdx];
+			}
+			else
+			{
+				for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+				for (int fragNdx = 0; fragNdx < 4; ++fragNdx)
+					comp[packetNdx*4 + fragNdx] = packets[packetNdx].barycentric[0][fragNdx] * v0[compNdx]
+												+ packets[packetNdx].barycentric[1][fragNdx] * v1[compNdx]
+												+ packets[packetNdx].barycentric[2][fragNdx] * v2[compNdx];
+			}
+		}
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Shade rasterized fragment packets and write them to render target
+ *
+ * Time since startTime is accounted to rasterization. Returns the time
+ * when writes were finished.
+ *//*--------------------------------------------------------------------*/
+deUint64 shadeAndWriteFragmentPackets (const RenderState&				state,
+									   const RenderTarget&				renderTarget,
+									   const Program&					program,
+									   int								numRasterizedPackets,
+									   rr::FaceType						facetype,
+									   const FragmentShadingContext&	shadingContext,
+									   RasterizationInternalBuffers&	buffers,
+									   deUint64							startTime)
+{
+	const int			numSamples		= renderTarget.colorBuffers[0].getNumSamples();
+	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
+	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
+	const int			batchStride		= (int)buffers.fragmentPackets.size()*4;
+	const FragmentBatch	batch			(numRasterizedPackets*4, batchStride,
+										 (buffers.batchVaryings.empty())	? (DE_NULL) : (&buffers.batchVaryings[0]),
+										 (buffers.batchOutputs.empty())		? (DE_NULL) : (&buffers.batchOutputs[0]));
+	deUint64			time			= addStageProfile(buffers.stages[PROFILESTAGE_RASTERIZATION], startTime, 0);
+
+	// Shade
+
+	if (buffers.useFragmentBatches)
+	{
+		if (!buffers.batchVaryings.empty())
+			interpolateFragmentBatchVaryings(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext, (int)program.fragmentShader->getInputs().size(), batchStride, &buffers.batchVaryings[0]);
+
+		program.fragmentShader->shadeFragmentBatch(&buffers.fragmentPackets[0], numRasterizedPackets, batch, shadingContext);
+	}
+	else
+		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
+
+	// Depth clamp
+	if (buffers.fragmentDepthBuffer && state.fragOps.depthClampEnabled)
+		for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
+			buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx], depthClampMin, depthClampMax);
+
+	time = addStageProfile(buffers.stages[PROFILESTAGE_FRAGMENT_SHADING], time, (deUint64)numRasterizedPackets*4);
+
+	// Handle fragment shader outputs
+	{
+		const int numFragments = writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, facetype, buffers.shaderOutputs, (buffers.useFragmentBatches) ? (&batch) : (DE_NULL), buffers.fragmentDepthBuffer, buffers.shadedFragments);
+
+		return addStageProfile(buffers.stages[PROFILESTAGE_FRAGMENT_OPS], time, (deUint64)numFragments);
+	}
 }
 
 void rasterizePrimitive (const RenderState&					state,
@@ -1100,12 +1601,12 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Triangle&				triangle,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					rasterArea,
 						 RasterizationInternalBuffers&		buffers)
 {
+	deUint64			time			= getProfileTime();
 	const int			numSamples		= renderTarget.colorBuffers[0].getNumSamples();
-	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
-	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer		(renderTargetRect, rasterArea, numSamples, state.rasterization);
 	float				depthOffset		= 0.0f;
 
 	rasterizer.init(triangle.v0->position, triangle.v1->position, triangle.v2->position);
@@ -1114,7 +1615,10 @@ void rasterizePrimitive (const RenderState&					state,
 	const FaceType visibleFace = rasterizer.getVisibleFace();
 	if ((state.cullMode == CULLMODE_FRONT	&& visibleFace == FACETYPE_FRONT) ||
 		(state.cullMode == CULLMODE_BACK	&& visibleFace == FACETYPE_BACK))
+	{
+		addStageProfile(buffers.stages[PROFILESTAGE_RASTERIZATION], time, 1);
 		return;
+	}
 
 	// Shading context
 	FragmentShadingContext shadingContext(triangle.v0->outputs, triangle.v1->outputs, triangle.v2->outputs, &buffers.shaderOutputs[0], buffers.fragmentDepthBuffer, triangle.v2->primitiveID, (int)program.fragmentShader->getOutputs().size(), numSamples);
@@ -1148,19 +1652,12 @@ void rasterizePrimitive (const RenderState&					state,
 			for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
 				buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx] + depthOffset, 0.0f, 1.0f);
 
-		// Shade
+		// Shade and handle fragment shader outputs
 
-		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
-
-		// Depth clamp
-		if (buffers.fragmentDepthBuffer && state.fragOps.depthClampEnabled)
-			for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
-				buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx], depthClampMin, depthClampMax);
-
-		// Handle fragment shader outputs
-
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, visibleFace, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+		time = shadeAndWriteFragmentPackets(state, renderTarget, program, numRasterizedPackets, visibleFace, shadingContext, buffers, time);
 	}
+
+	addStageProfile(buffers.stages[PROFILESTAGE_RASTERIZATION], time, 1);
 }
 
 void rasterizePrimitive (const RenderState&					state,
@@ -1168,15 +1665,15 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Line&					line,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					rasterArea,
 						 RasterizationInternalBuffers&		buffers)
 {
+	deUint64					time				= getProfileTime();
 	const int					numSamples			= renderTarget.colorBuffers[0].getNumSamples();
-	const float					depthClampMin		= de::min(state.viewport.zn, state.viewport.zf);
-	const float					depthClampMax		= de::max(state.viewport.zn, state.viewport.zf);
 	const bool					msaa				= numSamples > 1;
 	FragmentShadingContext		shadingContext		(line.v0->outputs, line.v1->outputs, DE_NULL, &buffers.shaderOutputs[0], buffers.fragmentDepthBuffer, line.v1->primitiveID, (int)program.fragmentShader->getOutputs().size(), numSamples);
-	SingleSampleLineRasterizer	aliasedRasterizer	(renderTargetRect);
-	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect);
+	SingleSampleLineRasterizer	aliasedRasterizer	(rasterArea); // \note Aliased line fragments don't depend on the viewport, only visible area matters
+	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect, rasterArea);
 
 	// Initialize rasterization.
 	if (msaa)
@@ -1201,19 +1698,12 @@ void rasterizePrimitive (const RenderState&					state,
 		if (!numRasterizedPackets)
 			break; // Rasterization finished.
 
-		// Shade
+		// Shade and handle fragment shader outputs
 
-		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
-
-		// Depth clamp
-		if (buffers.fragmentDepthBuffer && state.fragOps.depthClampEnabled)
-			for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
-				buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx], depthClampMin, depthClampMax);
-
-		// Handle fragment shader outputs
-
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+		time = shadeAndWriteFragmentPackets(state, renderTarget, program, numRasterizedPackets, rr::FACETYPE_FRONT, shadingContext, buffers, time);
 	}
+
+	addStageProfile(buffers.stages[PROFILESTAGE_RASTERIZATION], time, 1);
 }
 
 void rasterizePrimitive (const RenderState&					state,
@@ -1221,13 +1711,13 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Point&					point,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					rasterArea,
 						 RasterizationInternalBuffers&		buffers)
 {
+	deUint64			time			= getProfileTime();
 	const int			numSamples		= renderTarget.colorBuffers[0].getNumSamples();
-	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
-	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer1		(renderTargetRect, numSamples, state.rasterization);
-	TriangleRasterizer	rasterizer2		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer1		(renderTargetRect, rasterArea, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer2		(renderTargetRect, rasterArea, numSamples, state.rasterization);
 
 	// draw point as two triangles
 	const float offset				= point.v0->pointSize / 2.0f;
@@ -1266,18 +1756,238 @@ void rasterizePrimitive (const RenderState&					state,
 		if (!numRasterizedPackets)
 			break; // Rasterization finished.
 
-		// Shade
+		// Shade and handle fragment shader outputs
 
-		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
+		time = shadeAndWriteFragmentPackets(state, renderTarget, program, numRasterizedPackets, rr::FACETYPE_FRONT, shadingContext, buffers, time);
+	}
 
-		// Depth clamp
-		if (buffers.fragmentDepthBuffer && state.fragOps.depthClampEnabled)
-			for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
-				buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx], depthClampMin, depthClampMax);
+	addStageProfile(buffers.stages[PROFILESTAGE_RASTERIZATION], time, 1);
+}
 
-		// Handle fragment shader outputs
+bool usesFragmentBatches (const FragmentShader& shader)
+{
+	if (!shader.supportsFragmentBatches())
+		return false;
+
+	// Batches only have float storage
+	for (size_t inputNdx = 0; inputNdx < shader.getInputs().size(); ++inputNdx)
+		if (shader.getInputs()[inputNdx].type != GENERICVECTYPE_FLOAT)
+			return false;
 
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+	for (size_t outputNdx = 0; outputNdx < shader.getOutputs().size(); ++outputNdx)
+		if (shader.getOutputs()[outputNdx].type != GENERICVECTYPE_FLOAT)
+			return false;
+
+	return true;
+}
+
+void allocateRasterizationBuffers (RasterizationInternalBuffers& buffers, const RenderTarget& renderTarget, const Program& program, size_t maxFragmentPackets)
+{
+	const int	numSamples			= renderTarget.colorBuffers[0].getNumSamples();
+	const int	numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
+
+	buffers.fragmentPackets.resize(maxFragmentPackets);
+	buffers.shaderOutputs.resize(maxFragmentPackets*4*numFragmentOutputs);
+	buffers.shadedFragments.resize(maxFragmentPackets*4);
+	buffers.fragmentDepthBuffer = DE_NULL;
+	buffers.useFragmentBatches	= usesFragmentBatches(*program.fragmentShader);
+
+	if (buffers.useFragmentBatches)
+	{
+		buffers.batchVaryings.resize(maxFragmentPackets*4*4*program.fragmentShader->getInputs().size());
+		buffers.batchOutputs.resize(maxFragmentPackets*4*4*numFragmentOutputs);
+	}
+
+	// calculate depth only if we have a depth buffer
+	if (!isEmpty(renderTarget.depthBuffer))
+	{
+		buffers.depthValues.resize(maxFragmentPackets*4*numSamples);
+		buffers.fragmentDepthBuffer = &buffers.depthValues[0];
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Window-space bounding box of a primitive
+ *
+ * Returns a conservative bounding box (minX, minY, maxX, maxY) with a margin
+ * that covers all fragments the primitive may generate.
+ *//*--------------------------------------------------------------------*/
+tcu::Vec4 getPrimitiveBoundingBox (const RenderState& state, const pa::Triangle& triangle)
+{
+	DE_UNREF(state);
+
+	const tcu::Vec4&	p0		= triangle.v0->position;
+	const tcu::Vec4&	p1		= triangle.v1->position;
+	const tcu::Vec4&	p2		= triangle.v2->position;
+	const float			margin	= 1.0f;
+
+	return tcu::Vec4(de::min(de::min(p0.x(), p1.x()), p2.x()) - margin,
+					 de::min(de::min(p0.y(), p1.y()), p2.y()) - margin,
+					 de::max(de::max(p0.x(), p1.x()), p2.x()) + margin,
+					 de::max(de::max(p0.y(), p1.y()), p2.y()) + margin);
+}
+
+tcu::Vec4 getPrimitiveBoundingBox (const RenderState& state, const pa::Line& line)
+{
+	const tcu::Vec4&	p0		= line.v0->position;
+	const tcu::Vec4&	p1		= line.v1->position;
+	const float			margin	= deFloatCeil(state.line.lineWidth) + 2.0f; // wide aliased lines are shifted and replicated in minor direction
+
+	return tcu::Vec4(de::min(p0.x(), p1.x()) - margin,
+					 de::min(p0.y(), p1.y()) - margin,
+					 de::max(p0.x(), p1.x()) + margin,
+					 de::max(p0.y(), p1.y()) + margin);
+}
+
+tcu::Vec4 getPrimitiveBoundingBox (const RenderState& state, const pa::Point& point)
+{
+	DE_UNREF(state);
+
+	const tcu::Vec4&	p		= point.v0->position;
+	const float			margin	= point.v0->pointSize / 2.0f + 1.0f;
+
+	return tcu::Vec4(p.x() - margin, p.y() - margin, p.x() + margin, p.y() + margin);
+}
+
+//! Convert window coordinate to tile index, clamped to [0, numTiles-1]. Non-finite values map to the full range.
+int getTileIndex (float windowCoord, int rectOrigin, int numTiles, bool isMax)
+{
+	const float tileCoord = (windowCoord - (float)rectOrigin) / (float)RASTERIZATION_TILE_SIZE;
+
+	if (!(tileCoord >= 0.0f))
+		return (isMax && !(tileCoord < 0.0f)) ? (numTiles-1) : (0);	// negative or NaN
+	else if (!(tileCoord < (float)numTiles))
+		return numTiles-1;
+	else
+		return (int)tileCoord;
+}
+
+template <typename ContainerType>
+class TileRasterizationJob : public de::ThreadPool::Job
+{
+public:
+	TileRasterizationJob (const RenderState&									state,
+						  const RenderTarget&									renderTarget,
+						  const Program&										program,
+						  const ContainerType&									list,
+						  const tcu::IVec4&										renderTargetRect,
+						  DrawBuffers&											buffers)
+		: m_state				(state)
+		, m_renderTarget		(renderTarget)
+		, m_program				(program)
+		, m_list				(list)
+		, m_renderTargetRect	(renderTargetRect)
+		, m_tileRects			(buffers.activeTileRects)
+		, m_activeTiles			(buffers.activeTiles)
+		, m_tilePrimitives		(buffers.tilePrimitives)
+		, m_workerBuffers		(buffers.workerRasterization)
+	{
+	}
+
+	void execute (int jobNdx, int workerNdx)
+	{
+		const std::vector<int>&	primitives	= m_tilePrimitives[m_activeTiles[jobNdx]];
+
+		for (size_t ndx = 0; ndx < primitives.size(); ++ndx)
+			rasterizePrimitive(m_state, m_renderTarget, m_program, m_list[primitives[ndx]], m_renderTargetRect, m_tileRects[jobNdx], m_workerBuffers[workerNdx]);
+	}
+
+private:
+	const RenderState&							m_state;
+	const RenderTarget&							m_renderTarget;
+	const Program&								m_program;
+	const ContainerType&						m_list;
+	const tcu::IVec4							m_renderTargetRect;
+	const std::vector<tcu::IVec4>&				m_tileRects;
+	const std::vector<int>&						m_activeTiles;
+	const std::vector<std::vector<int> >&		m_tilePrimitives;
+	std::vector<RasterizationInternalBuffers>&	m_workerBuffers;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * Rasterizes primitives by binning them into screen-space tiles and
+ * processing the tiles in parallel. Each tile processes its primitives in
+ * list order, which preserves API order for every pixel.
+ *//*--------------------------------------------------------------------*/
+template <typename ContainerType>
+void rasterizeTiled (const RenderState&			state,
+					 const RenderTarget&		renderTarget,
+					 const Program&				program,
+					 const ContainerType&		list,
+					 const tcu::IVec4&			renderTargetRect,
+					 size_t						maxFragmentPackets,
+					 de::ThreadPool&			threadPool,
+					 DrawBuffers&				buffers,
+					 RenderStatistics&			statistics)
+{
+	const deUint64						startTime		= getProfileTime();
+	const int							numTilesX		= (renderTargetRect.z() + RASTERIZATION_TILE_SIZE - 1) / RASTERIZATION_TILE_SIZE;
+	const int							numTilesY		= (renderTargetRect.w() + RASTERIZATION_TILE_SIZE - 1) / RASTERIZATION_TILE_SIZE;
+	std::vector<std::vector<int> >&		binnedPrimitives= buffers.tilePrimitives;
+	std::vector<int>&					activeTiles		= buffers.activeTiles;
+	std::vector<tcu::IVec4>&			tileRects		= buffers.activeTileRects;
+
+	// Bins keep their capacity over draws
+	if ((int)binnedPrimitives.size() < numTilesX*numTilesY)
+		binnedPrimitives.resize(numTilesX*numTilesY);
+
+	for (int tileNdx = 0; tileNdx < numTilesX*numTilesY; ++tileNdx)
+		binnedPrimitives[tileNdx].clear();
+
+	activeTiles.clear();
+	tileRects.clear();
+
+	// Bin primitives
+	for (int primitiveNdx = 0; primitiveNdx < (int)list.size(); ++primitiveNdx)
+	{
+		const tcu::Vec4	bbox	= getPrimitiveBoundingBox(state, list[primitiveNdx]);
+		const int		tileX0	= getTileIndex(bbox.x(), renderTargetRect.x(), numTilesX, false);
+		const int		tileY0	= getTileIndex(bbox.y(), renderTargetRect.y(), numTilesY, false);
+		const int		tileX1	= getTileIndex(bbox.z(), renderTargetRect.x(), numTilesX, true);
+		const int		tileY1	= getTileIndex(bbox.w(), renderTargetRect.y(), numTilesY, true);
+
+		for (int tileY = tileY0; tileY <= tileY1; ++tileY)
+		for (int tileX = tileX0; tileX <= tileX1; ++tileX)
+			binnedPrimitives[tileY*numTilesX + tileX].push_back(primitiveNdx);
+	}
+
+	// Collect non-empty tiles
+	for (int tileY = 0; tileY < numTilesY; ++tileY)
+	for (int tileX = 0; tileX < numTilesX; ++tileX)
+	{
+		const int tileNdx = tileY*numTilesX + tileX;
+
+		if (binnedPrimitives[tileNdx].empty())
+			continue;
+
+		{
+			const int x0 = renderTargetRect.x() + tileX*RASTERIZATION_TILE_SIZE;
+			const int y0 = renderTargetRect.y() + tileY*RASTERIZATION_TILE_SIZE;
+			const int x1 = de::min(x0 + (int)RASTERIZATION_TILE_SIZE, renderTargetRect.x() + renderTargetRect.z());
+			const int y1 = de::min(y0 + (int)RASTERIZATION_TILE_SIZE, renderTargetRect.y() + renderTargetRect.w());
+
+			tileRects.push_back(tcu::IVec4(x0, y0, x1 - x0, y1 - y0));
+			activeTiles.push_back(tileNdx);
+		}
+	}
+
+	// Rasterize tiles
+	{
+		std::vector<RasterizationInternalBuffers>&	workerBuffers	= buffers.workerRasterization;
+		TileRasterizationJob<ContainerType>			job				(state, renderTarget, program, list, renderTargetRect, buffers);
+
+		workerBuffers.resize(threadPool.getNumThreads());
+
+		for (size_t workerNdx = 0; workerNdx < workerBuffers.size(); ++workerNdx)
+			allocateRasterizationBuffers(workerBuffers[workerNdx], renderTarget, program, maxFragmentPackets);
+
+		// Binning
+		addStageProfile(statistics.stages[PROFILESTAGE_RASTERIZATION], startTime, 0);
+
+		threadPool.run(job, (int)tileRects.size());
+
+		for (size_t workerNdx = 0; workerNdx < workerBuffers.size(); ++workerNdx)
+			mergeStageProfiles(statistics.stages, workerBuffers[workerNdx].stages);
 	}
 }
 
@@ -1285,50 +1995,46 @@ template <typename ContainerType>
 void rasterize (const RenderState&					state,
 				const RenderTarget&					renderTarget,
 				const Program&						program,
-				const ContainerType&				list)
+				const ContainerType&				list,
+				const DrawContext&					drawContext)
 {
-	const int						numSamples			= renderTarget.colorBuffers[0].getNumSamples();
-	const int						numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
-	const size_t					maxFragmentPackets	= 128;
+	de::ThreadPool* const			threadPool			= drawContext.threadPool;
+	const size_t					maxFragmentPackets	= (size_t)drawContext.fragmentPacketBatchSize;
 
 	const tcu::IVec4				viewportRect		= tcu::IVec4(state.viewport.rect.left, state.viewport.rect.bottom, state.viewport.rect.width, state.viewport.rect.height);
 	const tcu::IVec4				bufferRect			= getBufferSize(renderTarget.colorBuffers[0]);
 	const tcu::IVec4				renderTargetRect	= rectIntersection(viewportRect, bufferRect);
 
-	// shared buffers for all primitives
-	std::vector<FragmentPacket>		fragmentPackets		(maxFragmentPackets);
-	std::vector<GenericVec4>		shaderOutputs		(maxFragmentPackets*4*numFragmentOutputs);
-	std::vector<Fragment>			shadedFragments		(maxFragmentPackets*4);
-	std::vector<float>				depthValues			(0);
-	float*							depthBufferPointer	= DE_NULL;
-
-	RasterizationInternalBuffers	buffers;
-
-	// calculate depth only if we have a depth buffer
-	if (!isEmpty(renderTarget.depthBuffer))
+	// parallel rasterization is only worthwhile if the primitives can span multiple tiles
+	if (threadPool && program.fragmentShader->isThreadSafe() && !list.empty() &&
+		renderTargetRect.z() > 0 && renderTargetRect.w() > 0 &&
+		(renderTargetRect.z() > RASTERIZATION_TILE_SIZE || renderTargetRect.w() > RASTERIZATION_TILE_SIZE))
 	{
-		depthValues.resize(maxFragmentPackets*4*numSamples);
-		depthBufferPointer = &depthValues[0];
+		rasterizeTiled(state, renderTarget, program, list, renderTargetRect, maxFragmentPackets, *threadPool, drawContext.buffers, drawContext.statistics);
+		return;
 	}
 
-	// set buffers
-	buffers.fragmentPackets.swap(fragmentPackets);
-	buffers.shaderOutputs.swap(shaderOutputs);
-	buffers.shadedFragments.swap(shadedFragments);
-	buffers.fragmentDepthBuffer = depthBufferPointer;
+	// shared buffers for all primitives
+	RasterizationInternalBuffers&	buffers				= drawContext.buffers.rasterization;
+
+	allocateRasterizationBuffers(buffers, renderTarget, program, maxFragmentPackets);
 
 	// rasterize
 	for (typename ContainerType::const_iterator it = list.begin(); it != list.end(); ++it)
-		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, buffers);
+		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, renderTargetRect, buffers);
+
+	mergeStageProfiles(drawContext.statistics.stages, buffers.stages);
 }
 
 /*--------------------------------------------------------------------*//*!
  * Draws transformed triangles, lines or points to render target
  *//*--------------------------------------------------------------------*/
 template <typename ContainerType>
-void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, VertexPacketAllocator& vpalloc)
+void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
-	const bool clipZ = !state.fragOps.depthClampEnabled;
+	const bool		clipZ			= !state.fragOps.depthClampEnabled;
+	const deUint64	numPrimitives	= (deUint64)primList.size();
+	const deUint64	startTime		= getProfileTime();
 
 	// Transform feedback
 
@@ -1336,14 +2042,15 @@ void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTa
 	flatshadeVertices(program, primList);
 
 	// Clipping
-	// \todo [jarkko] is creating & swapping std::vectors really a good solution?
-	clipPrimitives(primList, program, clipZ, vpalloc);
+	clipPrimitives(primList, program, clipZ, vpalloc, drawContext);
 
 	// Transform vertices to window coords
 	transformClipCoordsToWindowCoords(state, primList);
 
+	addStageProfile(drawContext.statistics.stages[PROFILESTAGE_CLIPPING], startTime, numPrimitives);
+
 	// Rasterize and paint
-	rasterize(state, renderTarget, program, primList);
+	rasterize(state, renderTarget, program, primList, drawContext);
 }
 
 void copyVertexPacketPointers(const VertexPacket** dst, const pa::Point& in)
@@ -1383,29 +2090,38 @@ void copyVertexPacketPointers(const VertexPacket** dst, const pa::TriangleAdjace
 }
 
 template <PrimitiveType DrawPrimitiveType> // \note DrawPrimitiveType  can only be Points, line_strip, or triangle_strip
-void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, VertexPacketAllocator& vpalloc)
+void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	// Run primitive assembly for generated stream
 
+	typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType		BaseType;
+
+	const deUint64															startTime					= getProfileTime();
 	const size_t															assemblerPrimitiveCount		= PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::getPrimitiveCount(numVertices);
-	std::vector<typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType>	inputPrimitives				(assemblerPrimitiveCount);
+	std::vector<BaseType>&													inputPrimitives				= getPrimitiveBuffers<BaseType>(drawContext.buffers).base;
+
+	inputPrimitives.resize(assemblerPrimitiveCount);
 
 	PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::exec(inputPrimitives.begin(), vertices, numVertices, state.provokingVertexConvention); // \note input Primitives are baseType_t => only basic primitives (non adjacency) will compile
 
 	// Make shared vertices distinct
 
-	makeSharedVerticesDistinct(inputPrimitives, vpalloc);
+	makeSharedVerticesDistinct(inputPrimitives, vpalloc, drawContext.buffers.distinctVertices);
+
+	addStageProfile(drawContext.statistics.stages[PROFILESTAGE_PRIMITIVE_ASSEMBLY], startTime, (deUint64)assemblerPrimitiveCount);
 
 	// Draw assembled primitives
 
-	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, vpalloc);
+	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, drawContext, vpalloc);
 }
 
 template <PrimitiveType DrawPrimitiveType>
 void drawWithGeometryShader(const RenderState& state, const RenderTarget& renderTarget, const Program& program, std::vector<typename PrimitiveTypeTraits<DrawPrimitiveType>::Type>& input, DrawContext& drawContext)
 {
-	// Vertices outputted by geometry shader may have different number of output variables than the original, create new memory allocator
-	VertexPacketAllocator vpalloc(program.geometryShader->getOutputs().size());
+	// Vertices outputted by geometry shader may have different number of output variables than the original, use separate memory allocator
+	VertexPacketAllocator& vpalloc = drawContext.buffers.geometryAllocator;
+
+	vpalloc.reset(program.geometryShader->getOutputs().size());
 
 	// Run geometry shader for all primitives
 	GeometryEmitter					emitter			(vpalloc, program.geometryShader->getNumVerticesOut());
@@ -1426,6 +2142,8 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 	{
 		// Shading invocation
 
+		const deUint64 shadingStartTime = getProfileTime();
+
 		program.geometryShader->shadePrimitives(emitter, verticesIn, &primitives[0], (int)primitives.size(), invocationNdx);
 
 		// Find primitives in the emitted vertices
@@ -1433,6 +2151,8 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 		std::vector<VertexPacket*> emitted;
 		emitter.moveEmittedTo(emitted);
 
+		addStageProfile(drawContext.statistics.stages[PROFILESTAGE_PRIMITIVE_ASSEMBLY], shadingStartTime, 0);
+
 		for (size_t primitiveBegin = 0; primitiveBegin < emitted.size();)
 		{
 			size_t primitiveEnd;
@@ -1453,9 +2173,9 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 
 			switch (program.geometryShader->getOutputType())
 			{
-				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
@@ -1473,8 +2193,14 @@ template <PrimitiveType DrawPrimitiveType>
 void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, int numVertices, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	// Assemble primitives (deconstruct stips & loops)
+	typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::Type			Type;
+	typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType		BaseType;
+
+	const deUint64															startTime					= getProfileTime();
 	const size_t															assemblerPrimitiveCount		= PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::getPrimitiveCount(numVertices);
-	std::vector<typename PrimitiveTypeTraits<DrawPrimitiveType>::Type>		inputPrimitives				(assemblerPrimitiveCount);
+	std::vector<Type>&														inputPrimitives				= getPrimitiveBuffers<Type>(drawContext.buffers).assembled;
+
+	inputPrimitives.resize(assemblerPrimitiveCount);
 
 	PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::exec(inputPrimitives.begin(), vertices, (size_t)numVertices, state.provokingVertexConvention);
 
@@ -1485,24 +2211,28 @@ void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarge
 	// Geometry shader
 	if (program.geometryShader)
 	{
+		addStageProfile(drawContext.statistics.stages[PROFILESTAGE_PRIMITIVE_ASSEMBLY], startTime, (deUint64)assemblerPrimitiveCount);
+
 		// If there is an active geometry shader, it will convert any primitive type to basic types
 		drawWithGeometryShader<DrawPrimitiveType>(state, renderTarget, program, inputPrimitives, drawContext);
 	}
 	else
 	{
-		std::vector<typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType> basePrimitives;
+		std::vector<BaseType>& basePrimitives = getPrimitiveBuffers<BaseType>(drawContext.buffers).base;
 
 		// convert types from X_adjacency to X
 		convertPrimitiveToBaseType(basePrimitives, inputPrimitives);
 
 		// Make shared vertices distinct. Needed for that the translation to screen space happens only once per vertex, and for flatshading
-		makeSharedVerticesDistinct(basePrimitives, vpalloc);
+		makeSharedVerticesDistinct(basePrimitives, vpalloc, drawContext.buffers.distinctVertices);
 
 		// A primitive ID will be generated even if no geometry shader is active
 		generatePrimitiveIDs(basePrimitives, drawContext);
 
+		addStageProfile(drawContext.statistics.stages[PROFILESTAGE_PRIMITIVE_ASSEMBLY], startTime, (deUint64)assemblerPrimitiveCount);
+
 		// Draw as a basic type
-		drawBasicPrimitives(state, renderTarget, program, basePrimitives, vpalloc);
+		drawBasicPrimitives(state, renderTarget, program, basePrimitives, drawContext, vpalloc);
 	}
 }
 
@@ -1641,8 +2371,59 @@ bool isValidCommand (const DrawCommand& command, int numInstances)
 	return true;
 }
 
+class VertexShadingJob : public de::ThreadPool::Job
+{
+public:
+	VertexShadingJob (const VertexShader& shader, const VertexAttrib* inputs, VertexPacket* const* packets, int numPackets)
+		: m_shader		(shader)
+		, m_inputs		(inputs)
+		, m_packets		(packets)
+		, m_numPackets	(numPackets)
+	{
+	}
+
+	void execute (int chunkNdx, int workerNdx)
+	{
+		const int first	= chunkNdx * VERTEX_SHADING_CHUNK_SIZE;
+		const int count	= de::min((int)VERTEX_SHADING_CHUNK_SIZE, m_numPackets - first);
+
+		DE_UNREF(workerNdx);
+
+		m_shader.shadeVertices(m_inputs, m_packets + first, count);
+	}
+
+private:
+	const VertexShader&			m_shader;
+	const VertexAttrib* const	m_inputs;
+	VertexPacket* const* const	m_packets;
+	const int					m_numPackets;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * Runs vertex shader for all packets. If a thread pool is given and the
+ * shader is thread-safe, the packet array is split into fixed-size chunks
+ * that are shaded in parallel. Each packet is written only by the chunk it
+ * belongs to, so the output is the same as with serial shading.
+ *//*--------------------------------------------------------------------*/
+void shadeVertices (const VertexShader& shader, const VertexAttrib* inputs, VertexPacket* const* packets, int numPackets, de::ThreadPool* threadPool)
+{
+	if (threadPool && numPackets > VERTEX_SHADING_CHUNK_SIZE && shader.isThreadSafe())
+	{
+		VertexShadingJob job (shader, inputs, packets, numPackets);
+		threadPool->run(job, (numPackets + VERTEX_SHADING_CHUNK_SIZE - 1) / VERTEX_SHADING_CHUNK_SIZE);
+	}
+	else
+		shader.shadeVertices(inputs, packets, numPackets);
+}
+
 } // anonymous
 
+//! Buffers reused over draw calls of a Renderer
+struct DrawArena
+{
+	DrawBuffers buffers;
+};
+
 DrawIndices::DrawIndices (const deUint32* ptr, int baseVertex_)
 	: indices	(ptr)
 	, indexType	(INDEXTYPE_UINT32)
@@ -1715,20 +2496,99 @@ bool PrimitiveList::isRestartIndex (size_t elementNdx, deUint32 restartIndex) co
 		return elementNdx == (size_t)restartIndex;
 }
 
+static de::Mutex										s_rendererThreadPoolLock;
+static std::map<int, de::SharedPtr<de::ThreadPool> >	s_rendererThreadPools;	//!< Pools by number of workers, kept for process lifetime
+
+//! Get process-wide pool shared by all renderers with the same number of threads
+static de::SharedPtr<de::ThreadPool> getRendererThreadPool (int numThreads)
+{
+	const int numWorkers = (numThreads == 0) ? ((int)deGetNumAvailableLogicalCores()) : (numThreads);
+
+	DE_ASSERT(numThreads >= 0);
+
+	if (numWorkers <= 1)
+		return de::SharedPtr<de::ThreadPool>();
+
+	{
+		const de::ScopedLock			lock	(s_rendererThreadPoolLock);
+		de::SharedPtr<de::ThreadPool>&	pool	= s_rendererThreadPools[numWorkers];
+
+		if (!pool)
+			pool = de::SharedPtr<de::ThreadPool>(new de::ThreadPool(numWorkers));
+
+		return pool;
+	}
+}
+
+const char* getProfileStageName (ProfileStage stage)
+{
+	static const char* const s_names[] =
+	{
+		"VertexFetch",
+		"VertexShading",
+		"PrimitiveAssembly",
+		"Clipping",
+		"Rasterization",
+		"FragmentShading",
+		"FragmentOps",
+	};
+
+	return de::getSizedArrayElement<PROFILESTAGE_LAST>(s_names, stage);
+}
+
+RenderStatistics::RenderStatistics (void)
+	: numDrawCalls					(0)
+	, numShadedVertices				(0)
+	, numVertexCacheLookups			(0)
+	, numVertexCacheHits			(0)
+	, numTrivialAcceptedTriangles	(0)
+	, numTrivialRejectedTriangles	(0)
+	, numGuardBandTriangles			(0)
+	, numClippedTriangles			(0)
+{
+}
+
 Renderer::Renderer (void)
+	: m_threadPool				(getRendererThreadPool(tcu::getRefRenderNumThreads()))
+	, m_arena					(new DrawArena())
+	, m_fragmentPacketBatchSize	(DEFAULT_FRAGMENT_PACKET_BATCH_SIZE)
+{
+}
+
+Renderer::Renderer (int numThreads)
+	: m_threadPool				(getRendererThreadPool(numThreads))
+	, m_arena					(new DrawArena())
+	, m_fragmentPacketBatchSize	(DEFAULT_FRAGMENT_PACKET_BATCH_SIZE)
 {
 }
 
 Renderer::~Renderer (void)
 {
+	delete m_arena;
+}
+
+int Renderer::getNumThreads (void) const
+{
+	return (m_threadPool) ? (m_threadPool->getNumThreads()) : (1);
 }
 
-void Renderer::draw (const DrawCommand& command) const
+void Renderer::setFragmentPacketBatchSize (int numPackets)
+{
+	DE_ASSERT(numPackets > 0);
+	m_fragmentPacketBatchSize = numPackets;
+}
+
+void Renderer::resetStatistics (void)
+{
+	m_statistics = RenderStatistics();
+}
+
+void Renderer::draw (const DrawCommand& command)
 {
 	drawInstanced(command, 1);
 }
 
-void Renderer::drawInstanced (const DrawCommand& command, int numInstances) const
+void Renderer::drawInstanced (const DrawCommand& command, int numInstances)
 {
 	// Do not run bad commands
 	{
@@ -1748,10 +2608,28 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 
 	// Prepare transformation
 
-	const size_t				numVaryings = command.program.vertexShader->getOutputs().size();
-	VertexPacketAllocator		vpalloc(numVaryings);
-	std::vector<VertexPacket*>	vertexPackets = vpalloc.allocArray(command.primitives.getNumElements());
-	DrawContext					drawContext;
+	DrawBuffers&				buffers			= m_arena->buffers;
+	const size_t				numElements		= command.primitives.getNumElements();
+	const size_t				numVaryings		= command.program.vertexShader->getOutputs().size();
+	const bool					isIndexed		= command.primitives.getIndexType() != INDEXTYPE_LAST;
+	VertexPacketAllocator&		vpalloc			= buffers.vertexAllocator;
+	std::vector<VertexPacket*>&	vertexPackets	= buffers.vertexPackets;
+	std::vector<VertexPacket*>&	vertexRefs		= buffers.vertexRefs;
+	VertexCache* const			vertexCache		= (isIndexed) ? (&buffers.vertexCache) : (DE_NULL);
+	DrawContext					drawContext		(command.state, m_threadPool.get(), m_fragmentPacketBatchSize, buffers, m_statistics);
+
+	m_statistics.numDrawCalls += 1;
+
+	// Packets of the previous draw are no longer referenced
+	vpalloc.reset(numVaryings);
+	vertexPackets.resize(numElements);
+	vpalloc.allocArray(numElements, &vertexPackets[0]);
+
+	if (isIndexed)
+	{
+		vertexRefs.resize(numElements);
+		vertexCache->reset(numElements);
+	}
 
 	for (int instanceID = 0; instanceID < numInstances; ++instanceID)
 	{
@@ -1760,50 +2638,82 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 
 		for (size_t elementNdx = 0; elementNdx < command.primitives.getNumElements(); ++elementNdx)
 		{
-			int numVertexPackets = 0;
+			const deUint64	fetchStartTime		= getProfileTime();
+			int				numVertexPackets	= 0;	// number of elements in the run
+			int				numShadedPackets	= 0;	// number of distinct vertices in the run
+
+			if (vertexCache)
+				vertexCache->clear();
 
 			// collect primitive vertices until restart
 
 			while (elementNdx < command.primitives.getNumElements() &&
 					!(command.state.restart.enabled && command.primitives.isRestartIndex(elementNdx, command.state.restart.restartIndex)))
 			{
-				// input
-				vertexPackets[numVertexPackets]->instanceNdx	= instanceID;
-				vertexPackets[numVertexPackets]->vertexNdx		= (int)command.primitives.getIndex(elementNdx);
+				const int	vertexNdx	= (int)command.primitives.getIndex(elementNdx);
+				const int	cachedSlot	= (vertexCache) ? (vertexCache->lookupOrInsert((size_t)vertexNdx, numShadedPackets)) : ((int)VertexCache::NOT_FOUND);
+
+				if (cachedSlot == VertexCache::NOT_FOUND)
+				{
+					// input
+					vertexPackets[numShadedPackets]->instanceNdx	= instanceID;
+					vertexPackets[numShadedPackets]->vertexNdx		= vertexNdx;
+
+					// output
+					vertexPackets[numShadedPackets]->pointSize		= command.state.point.pointSize;	// default value from the current state
+					vertexPackets[numShadedPackets]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
+
+					if (isIndexed)
+						vertexRefs[numVertexPackets] = vertexPackets[numShadedPackets];
 
-				// output
-				vertexPackets[numVertexPackets]->pointSize		= command.state.point.pointSize;	// default value from the current state
-				vertexPackets[numVertexPackets]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
+					++numShadedPackets;
+				}
+				else
+					vertexRefs[numVertexPackets] = vertexPackets[cachedSlot];
 
 				++numVertexPackets;
 				++elementNdx;
 			}
 
+			addStageProfile(m_statistics.stages[PROFILESTAGE_VERTEX_FETCH], fetchStartTime, (deUint64)numVertexPackets);
+
 			// Duplicated restart shade
 			if (numVertexPackets == 0)
 				continue;
 
-			// \todo Vertex cache?
+			if (isIndexed)
+			{
+				m_statistics.numVertexCacheLookups	+= (deUint64)numVertexPackets;
+				m_statistics.numVertexCacheHits		+= (deUint64)(numVertexPackets - numShadedPackets);
+			}
 
 			// Transform vertices
+			{
+				const deUint64 shadingProfileTime = getProfileTime();
 
-			command.program.vertexShader->shadeVertices(command.vertexAttribs, &vertexPackets[0], numVertexPackets);
+				shadeVertices(*command.program.vertexShader, command.vertexAttribs, &vertexPackets[0], numShadedPackets, m_threadPool.get());
+
+				addStageProfile(m_statistics.stages[PROFILESTAGE_VERTEX_SHADING], shadingProfileTime, (deUint64)numShadedPackets);
+
+				m_statistics.numShadedVertices += (deUint64)numShadedPackets;
+			}
 
 			// Draw primitives
+			VertexPacket* const* const primitiveVertices = (isIndexed) ? (&vertexRefs[0]) : (&vertexPackets[0]);
 
 			switch (command.primitives.getPrimitiveType())
 			{
-				case PRIMITIVETYPE_TRIANGLES:				{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_STRIP:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>			(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_FAN:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_FAN>				(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINES:					{ drawAsPrimitives<PRIMITIVETYPE_LINES>						(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_STRIP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP>				(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_LOOP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_LOOP>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_POINTS:					{ drawAsPrimitives<PRIMITIVETYPE_POINTS>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINES_ADJACENCY:			{ drawAsPrimitives<PRIMITIVETYPE_LINES_ADJACENCY>			(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_STRIP_ADJACENCY:	{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP_ADJACENCY>		(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLES_ADJACENCY:		{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES_ADJACENCY>		(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY:{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY>	(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLES:				{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES>					(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_STRIP:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>			(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_FAN:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_FAN>				(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_LINES:					{ drawAsPrimitives<PRIMITIVETYPE_LINES>						(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_STRIP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP>				(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_LOOP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_LOOP>					(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_POINTS:					{ drawAsPrimitives<PRIMITIVETYPE_POINTS>					(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_LINES_ADJACENCY:			{ drawAsPrimitives<PRIMITIVETYPE_LINES_ADJACENCY>			(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_STRIP_ADJACENCY:	{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP_ADJACENCY>		(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLES_ADJACENCY:		{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES_ADJACENCY>		(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY:{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY>	(command.state, command.renderTarget, command.program, primitiveVertices, numVertexPackets, drawContext, vpalloc);	break; }
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
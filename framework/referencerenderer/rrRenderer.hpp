@@ -29,10 +29,18 @@
 #include "rrPrimitiveTypes.hpp"
 #include "rrMultisamplePixelBufferAccess.hpp"
 #include "tcuTexture.hpp"
+#include "deSharedPtr.hpp"
+
+namespace de
+{
+class ThreadPool;
+}
 
 namespace rr
 {
 
+struct DrawArena;
+
 class RenderTarget
 {
 public:
@@ -127,14 +135,116 @@ public:
 	const PrimitiveList&		primitives;
 } DE_WARN_UNUSED_TYPE;
 
+//! Renderer pipeline stages measured when RR_ENABLE_PROFILING is set
+enum ProfileStage
+{
+	PROFILESTAGE_VERTEX_FETCH = 0,		//!< Index fetch, vertex cache lookup and vertex packet setup. Items are vertex references.
+	PROFILESTAGE_VERTEX_SHADING,		//!< Vertex shader invocations. Items are shaded vertices.
+	PROFILESTAGE_PRIMITIVE_ASSEMBLY,	//!< Primitive assembly and geometry shading. Items are assembled primitives.
+	PROFILESTAGE_CLIPPING,				//!< Flatshading, clipping and viewport transform. Items are input primitives.
+	PROFILESTAGE_RASTERIZATION,			//!< Binning, primitive setup and rasterization. Items are rasterized primitives.
+	PROFILESTAGE_FRAGMENT_SHADING,		//!< Varying interpolation and fragment shader invocations. Items are shaded fragments.
+	PROFILESTAGE_FRAGMENT_OPS,			//!< Per-fragment operations and render target writes. Items are fragments with live samples.
+
+	PROFILESTAGE_LAST
+};
+
+const char*	getProfileStageName	(ProfileStage stage);
+
+struct StageProfile
+{
+	deUint64	timeNs;		//!< Time spent in stage
+	deUint64	numItems;	//!< Number of items processed by stage
+
+	StageProfile (void) : timeNs(0), numItems(0) {}
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Renderer statistics
+ *
+ * Counters accumulated over all draw calls since the Renderer was created
+ * or the statistics were last reset.
+ *
+ * Stage profiles are only updated if RR_ENABLE_PROFILING is set. Stages
+ * executed in parallel report time summed over all threads.
+ *//*--------------------------------------------------------------------*/
+struct RenderStatistics
+{
+	deUint64		numDrawCalls;					//!< Number of non-empty draw calls
+	deUint64		numShadedVertices;				//!< Number of vertices processed by vertex shader, including all instances
+	deUint64		numVertexCacheLookups;			//!< Number of index references in indexed draws
+	deUint64		numVertexCacheHits;				//!< Number of index references that reused an already shaded vertex
+	deUint64		numTrivialAcceptedTriangles;	//!< Number of triangles entirely inside the clip volume
+	deUint64		numTrivialRejectedTriangles;	//!< Number of triangles entirely outside some clip plane
+	deUint64		numGuardBandTriangles;			//!< Number of triangles crossing only side planes that were accepted within guard band
+	deUint64		numClippedTriangles;			//!< Number of triangles clipped to the clip volume planes
+	StageProfile	stages[PROFILESTAGE_LAST];		//!< Per-stage profile, indexed with ProfileStage
+
+	RenderStatistics (void);
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Reference renderer
+ *
+ * If the renderer is created with more than one thread, primitives are
+ * binned into screen-space tiles after clipping and the tiles are
+ * rasterized, shaded and written in parallel. Primitives are processed in
+ * API order within each tile, so the result is identical to the serial
+ * path. Shaders are called concurrently from multiple threads: shading
+ * must not modify shader members or other shared state, and textures
+ * sampled by shaders must not be modified during the draw. Shaders that
+ * can't guarantee this return false from FragmentShader::isThreadSafe(),
+ * and their primitives are then rasterized on the calling thread.
+ *
+ * Default-constructed renderers use the thread count set with
+ * tcu::setRefRenderNumThreads() (--deqp-refrender-threads). Thread count 0
+ * selects the number of available logical cores. Renderers with the same thread count share one
+ * process-wide worker pool, so creating renderers is cheap.
+ *
+ * Vertex shading of large batches is also split across the threads,
+ * unless VertexShader::isThreadSafe() returns false. Vertices are shaded
+ * into fixed slots, so primitive assembly sees the same data in the same
+ * order as with a single thread.
+ *
+ * Fragments are shaded in batches of at most getFragmentPacketBatchSize()
+ * fragment packets. Larger batches amortize per-call overhead in shaders,
+ * smaller batches use less memory per rasterization thread.
+ *
+ * Vertex packets, primitive lists and rasterization buffers are owned by
+ * the renderer and reused by subsequent draw calls, so a renderer must not
+ * be used for multiple draws concurrently.
+ *//*--------------------------------------------------------------------*/
 class Renderer
 {
 public:
-					Renderer		(void);
-					~Renderer		(void);
+	enum
+	{
+		DEFAULT_FRAGMENT_PACKET_BATCH_SIZE	= 128
+	};
+
+								Renderer					(void);
+	explicit					Renderer					(int numThreads);
+								~Renderer					(void);
+
+	void						draw						(const DrawCommand& command);
+	void						drawInstanced				(const DrawCommand& command, int numInstances);
+
+	int							getNumThreads				(void) const;
+
+	void						setFragmentPacketBatchSize	(int numPackets);
+	int							getFragmentPacketBatchSize	(void) const { return m_fragmentPacketBatchSize;	}
+
+	const RenderStatistics&		getStatistics				(void) const { return m_statistics;				}
+	void						resetStatistics				(void);
+
+private:
+								Renderer					(const Renderer&);	// not allowed!
+	Renderer&					operator=					(const Renderer&);	// not allowed!
 
-	void			draw			(const DrawCommand& command) const;
-	void			drawInstanced	(const DrawCommand& command, int numInstances) const;
+	de::SharedPtr<de::ThreadPool>	m_threadPool;				//!< Shared tile workers, null for serial rendering
+	DrawArena*						m_arena;					//!< Buffers reused by draw calls
+	int								m_fragmentPacketBatchSize;	//!< Maximum number of fragment packets shaded at once
+	RenderStatistics				m_statistics;				//!< Updated by draw calls
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
@@ -95,6 +95,10 @@ struct FragmentOutputInfo
  *
  * Vertex shaders execute shading for set of vertex packets. See VertexPacket
  * documentation for more details on shading API.
+ *
+ * Multithreaded renderers call shadeVertices() concurrently for disjoint
+ * packet ranges. Shaders that modify shared state while shading must
+ * return false from isThreadSafe() to be shaded on a single thread.
  *//*--------------------------------------------------------------------*/
 class VertexShader
 {
@@ -103,6 +107,8 @@ public:
 
 	virtual void							shadeVertices		(const VertexAttrib* inputs, VertexPacket* const* packets, const int numPackets) const = 0;
 
+	virtual bool							isThreadSafe		(void) const { return true; }
+
 	const std::vector<VertexInputInfo>&		getInputs() const	{ return m_inputs; }
 	const std::vector<VertexOutputInfo>&	getOutputs() const	{ return m_outputs; }
 
@@ -118,6 +124,16 @@ protected:
  *
  * Fragment shader executes shading for list of fragment packets. See
  * FragmentPacket documentation for more details on shading API.
+ *
+ * Shaders with only float inputs and outputs may additionally implement
+ * shadeFragmentBatch() and return true from supportsFragmentBatches().
+ * The renderer then interpolates varyings into a structure-of-arrays
+ * FragmentBatch and reads outputs from it, instead of calling
+ * shadeFragments(). Both must produce identical results.
+ *
+ * Multithreaded renderers shade fragments of different screen tiles
+ * concurrently. Shaders that modify shared state while shading must
+ * return false from isThreadSafe() to be shaded on a single thread.
  *//*--------------------------------------------------------------------*/
 class FragmentShader
 {
@@ -129,6 +145,11 @@ public:
 
 	virtual void							shadeFragments		(FragmentPacket* packets, const int numPackets, const FragmentShadingContext& context) const = 0; // \note numPackets must be greater than zero.
 
+	virtual bool							supportsFragmentBatches	(void) const { return false; }
+	virtual void							shadeFragmentBatch	(const FragmentPacket* packets, const int numPackets, const FragmentBatch& batch, const FragmentShadingContext& context) const { DE_UNREF(packets); DE_UNREF(numPackets); DE_UNREF(batch); DE_UNREF(context); DE_ASSERT(false); }
+
+	virtual bool							isThreadSafe		(void) const { return true; }
+
 protected:
 											~FragmentShader() {}; // \note Renderer will not delete any objects passed in.
 
@@ -47,6 +47,34 @@ struct FragmentShadingContext
 	float*						fragmentDepths;		//!< Fragment packet depths. Pointer will be NULL if there is no depth buffer. Each sample has per-sample depth values
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Structure-of-arrays fragment batch
+ *
+ * Used by FragmentShader::shadeFragmentBatch(). A batch contains 4
+ * fragments per fragment packet, fragment index being packetNdx*4 + fragNdx.
+ * Each varying and output is stored as four separate component arrays of
+ * numFragments floats. Varyings are interpolated by the renderer before
+ * shading using the same arithmetic as readVarying().
+ *//*--------------------------------------------------------------------*/
+struct FragmentBatch
+{
+								FragmentBatch	(int numFragments_, int stride_, const float* varyings_, float* outputs_)
+									: numFragments	(numFragments_)
+									, stride		(stride_)
+									, varyings		(varyings_)
+									, outputs		(outputs_)
+								{
+								}
+
+	const float*				getVarying		(int varyingNdx, int component) const	{ return varyings + (varyingNdx*4 + component)*stride;	}
+	float*						getOutput		(int outputNdx, int component) const	{ return outputs + (outputNdx*4 + component)*stride;	}
+
+	const int					numFragments;	//!< Number of fragments in batch
+	const int					stride;			//!< Distance between consecutive component arrays
+	const float* const			varyings;		//!< Interpolated varyings
+	float* const				outputs;		//!< Fragment outputs
+};
+
 // Write output
 
 template <typename T>
@@ -34,57 +34,100 @@ VertexPacket::~VertexPacket (void)
 {
 }
 
+static size_t getVertexPacketSize (size_t numberOfVertexOutputs)
+{
+	const size_t extraVaryings = (numberOfVertexOutputs == 0) ? (0) : (numberOfVertexOutputs-1);
+
+	return sizeof(VertexPacket) + extraVaryings * sizeof(GenericVec4);
+}
+
 VertexPacketAllocator::VertexPacketAllocator (const size_t numberOfVertexOutputs)
-	: m_numberOfVertexOutputs(numberOfVertexOutputs)
+	: m_numberOfVertexOutputs	(numberOfVertexOutputs)
+	, m_packetSize				(getVertexPacketSize(numberOfVertexOutputs))
+	, m_blockNdx				(0)
+	, m_blockOffset				(0)
 {
 }
 
 VertexPacketAllocator::~VertexPacketAllocator (void)
 {
-	for (size_t i = 0; i < m_allocations.size(); ++i)
-		delete [] m_allocations[i];
-	m_allocations.clear();
+	for (size_t i = 0; i < m_blocks.size(); ++i)
+		delete [] m_blocks[i].ptr;
+	m_blocks.clear();
 }
 
-std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
+deInt8* VertexPacketAllocator::allocMemory (size_t size)
 {
-	if (!count)
-		return std::vector<VertexPacket*>();
-
-	const size_t extraVaryings	= (m_numberOfVertexOutputs == 0) ? (0) : (m_numberOfVertexOutputs-1);
-	const size_t packetSize		= sizeof(VertexPacket) + extraVaryings * sizeof(GenericVec4);
-
-	std::vector<VertexPacket*>	retVal;
-	deInt8*						ptr = new deInt8[packetSize * count]; // throws bad_alloc => ok
-
-	// *.push_back might throw bad_alloc
-	try
+	// skip blocks that can't hold the allocation
+	while (m_blockNdx < m_blocks.size() && m_blocks[m_blockNdx].size - m_blockOffset < size)
 	{
-		// run ctors
-		for (size_t i = 0; i < count; ++i)
-			retVal.push_back(new (ptr + i*packetSize) VertexPacket()); // throws bad_alloc
+		++m_blockNdx;
+		m_blockOffset = 0;
+	}
 
-		m_allocations.push_back(ptr); // throws bad_alloc
+	if (m_blockNdx == m_blocks.size())
+	{
+		Block block;
+
+		block.size	= de::max(size, (size_t)MIN_BLOCK_SIZE);
+		block.ptr	= new deInt8[block.size]; // throws bad_alloc => ok
+
+		// *.push_back might throw bad_alloc
+		try
+		{
+			m_blocks.push_back(block);
+		}
+		catch (std::bad_alloc& )
+		{
+			delete [] block.ptr;
+			throw;
+		}
+
+		m_blockOffset = 0;
 	}
-	catch (std::bad_alloc& )
+
 	{
-		delete [] ptr;
-		throw;
+		deInt8* const ptr = m_blocks[m_blockNdx].ptr + m_blockOffset;
+		m_blockOffset += size;
+		return ptr;
 	}
+}
 
-	return retVal;
+void VertexPacketAllocator::allocArray (size_t count, VertexPacket** packets)
+{
+	if (!count)
+		return;
+
+	deInt8* const ptr = allocMemory(m_packetSize * count);
+
+	// run ctors
+	for (size_t i = 0; i < count; ++i)
+		packets[i] = new (ptr + i*m_packetSize) VertexPacket();
 }
 
-VertexPacket* VertexPacketAllocator::alloc (void)
+std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
 {
-	const size_t poolSize = 8;
+	std::vector<VertexPacket*> retVal(count); // throws bad_alloc => ok
+
+	if (count)
+		allocArray(count, &retVal[0]);
 
-	if (m_singleAllocPool.empty())
-		m_singleAllocPool = allocArray(poolSize);
+	return retVal;
+}
 
-	VertexPacket* packet = *--m_singleAllocPool.end();
-	m_singleAllocPool.pop_back();
+VertexPacket* VertexPacketAllocator::alloc (void)
+{
+	VertexPacket* packet;
+	allocArray(1, &packet);
 	return packet;
 }
 
+void VertexPacketAllocator::reset (size_t numberOfVertexOutputs)
+{
+	m_numberOfVertexOutputs	= numberOfVertexOutputs;
+	m_packetSize			= getVertexPacketSize(numberOfVertexOutputs);
+	m_blockNdx				= 0;
+	m_blockOffset			= 0;
+}
+
 } // rr
@@ -85,6 +85,12 @@ private:
  *
  * Vertex packet must have enough space allocated for its outputs.
  *
+ * Packets are sub-allocated from large memory blocks. reset() makes all
+ * blocks available for reuse without releasing them, so that an allocator
+ * kept alive over several draws stops allocating memory once the largest
+ * draw has been seen. Packets allocated before reset() must not be
+ * accessed after it.
+ *
  * All memory allocated for vertex packets is released when VertexPacketAllocator
  * is destroyed. Allocated vertex packets should not be accessed after
  * allocator is destroyed.
@@ -97,8 +103,11 @@ public:
 								VertexPacketAllocator	(const size_t numberOfVertexOutputs);
 								~VertexPacketAllocator	(void);
 
-	std::vector<VertexPacket*>	allocArray				(size_t count); // throws bad_alloc
-	VertexPacket*				alloc					(void);			// throws bad_alloc
+	std::vector<VertexPacket*>	allocArray				(size_t count);							// throws bad_alloc
+	void						allocArray				(size_t count, VertexPacket** packets);	// throws bad_alloc
+	VertexPacket*				alloc					(void);									// throws bad_alloc
+
+	void						reset					(size_t numberOfVertexOutputs);
 
 	inline size_t				getNumVertexOutputs		(void) const	{ return m_numberOfVertexOutputs; }
 
@@ -106,9 +115,24 @@ private:
 								VertexPacketAllocator	(const VertexPacketAllocator&); // disabled, non-copyable
 	VertexPacketAllocator&		operator=				(const VertexPacketAllocator&); // disabled, non-copyable
 
-	const size_t				m_numberOfVertexOutputs;
-	std::vector<deInt8*>		m_allocations;
-	std::vector<VertexPacket*>	m_singleAllocPool;
+	enum
+	{
+		MIN_BLOCK_SIZE = 64*1024	//!< Minimum size of a memory block in bytes
+	};
+
+	struct Block
+	{
+		deInt8*					ptr;
+		size_t					size;
+	};
+
+	deInt8*						allocMemory				(size_t size); // throws bad_alloc
+
+	size_t						m_numberOfVertexOutputs;
+	size_t						m_packetSize;
+	std::vector<Block>			m_blocks;
+	size_t						m_blockNdx;				//!< Block currently allocated from
+	size_t						m_blockOffset;			//!< First free byte in current block
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
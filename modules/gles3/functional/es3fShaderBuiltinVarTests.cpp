@@ -931,7 +931,7 @@ public:
 
 void VertexIDCase::renderReference (const tcu::PixelBufferAccess& dst, const int numVertices, const deUint16* const indices, const tcu::Vec4* const positions, const tcu::Vec4* const colors)
 {
-	const rr::Renderer				referenceRenderer;
+	rr::Renderer					referenceRenderer;
 	const rr::RenderState			referenceState		((rr::ViewportState)(rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(dst)));
 	const rr::RenderTarget			referenceTarget		(rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(dst));
 	const VertexIDReferenceShader	referenceShader;
@@ -454,7 +454,7 @@ void TextureCubeFilteringCase::init (void)
 			tcu::Vec4				cBias		= fmtInfo.valueMin;
 			tcu::Vec4				cScale		= fmtInfo.valueMax-fmtInfo.valueMin;
 
-			// Fill first with gradient texture.
+			// Fill first with gradient texture. Smaller levels are box filtered from it.
 			static const tcu::Vec4 gradients[tcu::CUBEFACE_LAST][2] =
 			{
 				{ tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f), tcu::Vec4(1.0f, 1.0f, 1.0f, 0.0f) }, // negative x
@@ -466,11 +466,11 @@ void TextureCubeFilteringCase::init (void)
 			};
 			for (int face = 0; face < tcu::CUBEFACE_LAST; face++)
 			{
-				for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
-				{
-					m_textures[0]->getRefTexture().allocLevel((tcu::CubeFace)face, levelNdx);
-					tcu::fillWithComponentGradients(m_textures[0]->getRefTexture().getLevelFace(levelNdx, (tcu::CubeFace)face), gradients[face][0]*cScale + cBias, gradients[face][1]*cScale + cBias);
-				}
+				m_textures[0]->getRefTexture().allocLevel((tcu::CubeFace)face, 0);
+				tcu::fillWithComponentGradients(m_textures[0]->getRefTexture().getLevelFace(0, (tcu::CubeFace)face), gradients[face][0]*cScale + cBias, gradients[face][1]*cScale + cBias);
+
+				for (int levelNdx = 1; levelNdx < numLevels; levelNdx++)
+					m_textures[0]->getRefTexture().allocLevelLazy((tcu::CubeFace)face, levelNdx);
 			}
 
 			// Fill second with grid texture.
@@ -1007,14 +1007,16 @@ void Texture3DFilteringCase::init (void)
 		m_gradientTex	= new glu::Texture3D(m_context.getRenderContext(), m_internalFormat, m_width, m_height, m_depth);
 		m_gridTex		= new glu::Texture3D(m_context.getRenderContext(), m_internalFormat, m_width, m_height, m_depth);
 
-		// Fill first gradient texture.
-		for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+		// Fill first gradient texture. Smaller levels are box filtered from it.
 		{
 			tcu::Vec4 gMin = tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f)*cScale + cBias;
 			tcu::Vec4 gMax = tcu::Vec4(1.0f, 1.0f, 1.0f, 0.0f)*cScale + cBias;
 
-			m_gradientTex->getRefTexture().allocLevel(levelNdx);
-			tcu::fillWithComponentGradients(m_gradientTex->getRefTexture().getLevel(levelNdx), gMin, gMax);
+			m_gradientTex->getRefTexture().allocLevel(0);
+			tcu::fillWithComponentGradients(m_gradientTex->getRefTexture().getLevel(0), gMin, gMax);
+
+			for (int levelNdx = 1; levelNdx < numLevels; levelNdx++)
+				m_gradientTex->getRefTexture().allocLevelLazy(levelNdx);
 		}
 
 		// Fill second with grid texture.
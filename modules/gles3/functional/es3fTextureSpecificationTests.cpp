@@ -3367,1176 +3367,1171 @@ public:
 	const deUint32 m_internalFormat;
 };
 
-TextureSpecificationTests::TextureSpecificationTests (Context& context)
-	: TestCaseGroup(context, "specification", "Texture Specification Tests")
+static const struct
+{
+	const char*	name;
+	deUint32	format;
+	deUint32	dataType;
+} unsizedFormats[] =
+{
+	{ "alpha_unsigned_byte",			GL_ALPHA,			GL_UNSIGNED_BYTE },
+	{ "luminance_unsigned_byte",		GL_LUMINANCE,		GL_UNSIGNED_BYTE },
+	{ "luminance_alpha_unsigned_byte",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE },
+	{ "rgb_unsigned_short_5_6_5",		GL_RGB,				GL_UNSIGNED_SHORT_5_6_5 },
+	{ "rgb_unsigned_byte",				GL_RGB,				GL_UNSIGNED_BYTE },
+	{ "rgba_unsigned_short_4_4_4_4",	GL_RGBA,			GL_UNSIGNED_SHORT_4_4_4_4 },
+	{ "rgba_unsigned_short_5_5_5_1",	GL_RGBA,			GL_UNSIGNED_SHORT_5_5_5_1 },
+	{ "rgba_unsigned_byte",				GL_RGBA,			GL_UNSIGNED_BYTE }
+};
+
+static const struct
+{
+	const char*	name;
+	deUint32	internalFormat;
+} colorFormats[] =
+{
+	{ "rgba32f",			GL_RGBA32F,			},
+	{ "rgba32i",			GL_RGBA32I,			},
+	{ "rgba32ui",			GL_RGBA32UI,		},
+	{ "rgba16f",			GL_RGBA16F,			},
+	{ "rgba16i",			GL_RGBA16I,			},
+	{ "rgba16ui",			GL_RGBA16UI,		},
+	{ "rgba8",				GL_RGBA8,			},
+	{ "rgba8i",				GL_RGBA8I,			},
+	{ "rgba8ui",			GL_RGBA8UI,			},
+	{ "srgb8_alpha8",		GL_SRGB8_ALPHA8,	},
+	{ "rgb10_a2",			GL_RGB10_A2,		},
+	{ "rgb10_a2ui",			GL_RGB10_A2UI,		},
+	{ "rgba4",				GL_RGBA4,			},
+	{ "rgb5_a1",			GL_RGB5_A1,			},
+	{ "rgba8_snorm",		GL_RGBA8_SNORM,		},
+	{ "rgb8",				GL_RGB8,			},
+	{ "rgb565",				GL_RGB565,			},
+	{ "r11f_g11f_b10f",		GL_R11F_G11F_B10F,	},
+	{ "rgb32f",				GL_RGB32F,			},
+	{ "rgb32i",				GL_RGB32I,			},
+	{ "rgb32ui",			GL_RGB32UI,			},
+	{ "rgb16f",				GL_RGB16F,			},
+	{ "rgb16i",				GL_RGB16I,			},
+	{ "rgb16ui",			GL_RGB16UI,			},
+	{ "rgb8_snorm",			GL_RGB8_SNORM,		},
+	{ "rgb8i",				GL_RGB8I,			},
+	{ "rgb8ui",				GL_RGB8UI,			},
+	{ "srgb8",				GL_SRGB8,			},
+	{ "rgb9_e5",			GL_RGB9_E5,			},
+	{ "rg32f",				GL_RG32F,			},
+	{ "rg32i",				GL_RG32I,			},
+	{ "rg32ui",				GL_RG32UI,			},
+	{ "rg16f",				GL_RG16F,			},
+	{ "rg16i",				GL_RG16I,			},
+	{ "rg16ui",				GL_RG16UI,			},
+	{ "rg8",				GL_RG8,				},
+	{ "rg8i",				GL_RG8I,			},
+	{ "rg8ui",				GL_RG8UI,			},
+	{ "rg8_snorm",			GL_RG8_SNORM,		},
+	{ "r32f",				GL_R32F,			},
+	{ "r32i",				GL_R32I,			},
+	{ "r32ui",				GL_R32UI,			},
+	{ "r16f",				GL_R16F,			},
+	{ "r16i",				GL_R16I,			},
+	{ "r16ui",				GL_R16UI,			},
+	{ "r8",					GL_R8,				},
+	{ "r8i",				GL_R8I,				},
+	{ "r8ui",				GL_R8UI,			},
+	{ "r8_snorm",			GL_R8_SNORM,		}
+};
+
+static const struct
+{
+	const char*	name;
+	deUint32	internalFormat;
+} depthStencilFormats[] =
+{
+	// Depth and stencil formats
+	{ "depth_component32f",	GL_DEPTH_COMPONENT32F	},
+	{ "depth_component24",	GL_DEPTH_COMPONENT24	},
+	{ "depth_component16",	GL_DEPTH_COMPONENT16	},
+	{ "depth32f_stencil8",	GL_DEPTH32F_STENCIL8	},
+	{ "depth24_stencil8",	GL_DEPTH24_STENCIL8		}
+};
+
+// Basic TexImage2D usage.
+static void createBasicTexImage2DTests (Context& context, tcu::TestCaseGroup* basicTexImageGroup)
 {
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
+	{
+		const char*	fmtName		= colorFormats[formatNdx].name;
+		deUint32	format		= colorFormats[formatNdx].internalFormat;
+		const int	tex2DWidth	= 64;
+		const int	tex2DHeight	= 128;
+		const int	texCubeSize	= 64;
+
+		basicTexImageGroup->addChild(new BasicTexImage2DCase	(context,	(string(fmtName) + "_2d").c_str(),		"",	format, tex2DWidth, tex2DHeight));
+		basicTexImageGroup->addChild(new BasicTexImageCubeCase	(context,	(string(fmtName) + "_cube").c_str(),	"",	format, texCubeSize));
+	}
 }
 
-TextureSpecificationTests::~TextureSpecificationTests (void)
+// Randomized TexImage2D order.
+static void createRandomTexImage2DTests (Context& context, tcu::TestCaseGroup* randomTexImageGroup)
 {
+	de::Random rnd(9);
+
+	// 2D cases.
+	for (int ndx = 0; ndx < 10; ndx++)
+	{
+		int		formatNdx	= rnd.getInt(0, DE_LENGTH_OF_ARRAY(colorFormats)-1);
+		int		width		= 1 << rnd.getInt(2, 8);
+		int		height		= 1 << rnd.getInt(2, 8);
+
+		randomTexImageGroup->addChild(new RandomOrderTexImage2DCase(context, (string("2d_") + de::toString(ndx)).c_str(), "", colorFormats[formatNdx].internalFormat, width, height));
+	}
+
+	// Cubemap cases.
+	for (int ndx = 0; ndx < 10; ndx++)
+	{
+		int		formatNdx	= rnd.getInt(0, DE_LENGTH_OF_ARRAY(colorFormats)-1);
+		int		size		= 1 << rnd.getInt(2, 8);
+
+		randomTexImageGroup->addChild(new RandomOrderTexImageCubeCase(context, (string("cube_") + de::toString(ndx)).c_str(), "", colorFormats[formatNdx].internalFormat, size));
+	}
 }
 
-void TextureSpecificationTests::init (void)
+// TexImage2D unpack alignment.
+static void createTexImage2DAlignTests (Context& context, tcu::TestCaseGroup* alignGroup)
 {
-	struct
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_r8_4_8",			"",	GL_R8,			 4,  8, 4, 8));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_r8_63_1",			"",	GL_R8,			63, 30, 1, 1));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_r8_63_2",			"",	GL_R8,			63, 30, 1, 2));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_r8_63_4",			"",	GL_R8,			63, 30, 1, 4));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_r8_63_8",			"",	GL_R8,			63, 30, 1, 8));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba4_51_1",		"",	GL_RGBA4,		51, 30, 1, 1));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba4_51_2",		"",	GL_RGBA4,		51, 30, 1, 2));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba4_51_4",		"",	GL_RGBA4,		51, 30, 1, 4));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba4_51_8",		"",	GL_RGBA4,		51, 30, 1, 8));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgb8_39_1",			"",	GL_RGB8,		39, 43, 1, 1));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgb8_39_2",			"",	GL_RGB8,		39, 43, 1, 2));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgb8_39_4",			"",	GL_RGB8,		39, 43, 1, 4));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgb8_39_8",			"",	GL_RGB8,		39, 43, 1, 8));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba8_47_1",		"",	GL_RGBA8,		47, 27, 1, 1));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba8_47_2",		"",	GL_RGBA8,		47, 27, 1, 2));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba8_47_4",		"",	GL_RGBA8,		47, 27, 1, 4));
+	alignGroup->addChild(new TexImage2DAlignCase	(context, "2d_rgba8_47_8",		"",	GL_RGBA8,		47, 27, 1, 8));
+
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_r8_4_8",			"",	GL_R8,			 4, 3, 8));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_r8_63_1",			"",	GL_R8,			63, 1, 1));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_r8_63_2",			"",	GL_R8,			63, 1, 2));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_r8_63_4",			"",	GL_R8,			63, 1, 4));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_r8_63_8",			"",	GL_R8,			63, 1, 8));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba4_51_1",		"",	GL_RGBA4,		51, 1, 1));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba4_51_2",		"",	GL_RGBA4,		51, 1, 2));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba4_51_4",		"",	GL_RGBA4,		51, 1, 4));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba4_51_8",		"",	GL_RGBA4,		51, 1, 8));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgb8_39_1",		"",	GL_RGB8,		39, 1, 1));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgb8_39_2",		"",	GL_RGB8,		39, 1, 2));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgb8_39_4",		"",	GL_RGB8,		39, 1, 4));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgb8_39_8",		"",	GL_RGB8,		39, 1, 8));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba8_47_1",		"",	GL_RGBA8,		47, 1, 1));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba8_47_2",		"",	GL_RGBA8,		47, 1, 2));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba8_47_4",		"",	GL_RGBA8,		47, 1, 4));
+	alignGroup->addChild(new TexImageCubeAlignCase	(context, "cube_rgba8_47_8",		"",	GL_RGBA8,		47, 1, 8));
+}
+
+// glTexImage2D() unpack parameter cases.
+static void createTexImage2DUnpackParamsTests (Context& context, tcu::TestCaseGroup* paramGroup)
+{
+	static const struct
 	{
 		const char*	name;
 		deUint32	format;
-		deUint32	dataType;
-	} unsizedFormats[] =
-	{
-		{ "alpha_unsigned_byte",			GL_ALPHA,			GL_UNSIGNED_BYTE },
-		{ "luminance_unsigned_byte",		GL_LUMINANCE,		GL_UNSIGNED_BYTE },
-		{ "luminance_alpha_unsigned_byte",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE },
-		{ "rgb_unsigned_short_5_6_5",		GL_RGB,				GL_UNSIGNED_SHORT_5_6_5 },
-		{ "rgb_unsigned_byte",				GL_RGB,				GL_UNSIGNED_BYTE },
-		{ "rgba_unsigned_short_4_4_4_4",	GL_RGBA,			GL_UNSIGNED_SHORT_4_4_4_4 },
-		{ "rgba_unsigned_short_5_5_5_1",	GL_RGBA,			GL_UNSIGNED_SHORT_5_5_5_1 },
-		{ "rgba_unsigned_byte",				GL_RGBA,			GL_UNSIGNED_BYTE }
+		int			width;
+		int			height;
+		int			rowLength;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+	} cases[] =
+	{
+		{ "rgb8_alignment",		GL_RGB8,	31,	30,	0,	0,	0,	2 },
+		{ "rgb8_row_length",	GL_RGB8,	31,	30,	50,	0,	0,	4 },
+		{ "rgb8_skip_rows",		GL_RGB8,	31,	30,	0,	3,	0,	4 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	31,	30,	36,	0,	5,	4 },
+		{ "r8_complex1",		GL_R8,		31, 30, 64, 1,	3,	1 },
+		{ "r8_complex2",		GL_R8,		31, 30, 64, 1,	3,	2 },
+		{ "r8_complex3",		GL_R8,		31, 30, 64, 1,	3,	4 },
+		{ "r8_complex4",		GL_R8,		31, 30, 64, 1,	3,	8 },
+		{ "rgba8_complex1",		GL_RGBA8,	56,	61,	69,	0,	0,	8 },
+		{ "rgba8_complex2",		GL_RGBA8,	56,	61,	69,	0,	7,	8 },
+		{ "rgba8_complex3",		GL_RGBA8,	56,	61,	69,	3,	0,	8 },
+		{ "rgba8_complex4",		GL_RGBA8,	56,	61,	69,	3,	7,	8 },
+		{ "rgba32f_complex",	GL_RGBA32F,	19,	10,	27,	1,	7,	8 }
 	};
 
-	struct
-	{
-		const char*	name;
-		deUint32	internalFormat;
-	} colorFormats[] =
-	{
-		{ "rgba32f",			GL_RGBA32F,			},
-		{ "rgba32i",			GL_RGBA32I,			},
-		{ "rgba32ui",			GL_RGBA32UI,		},
-		{ "rgba16f",			GL_RGBA16F,			},
-		{ "rgba16i",			GL_RGBA16I,			},
-		{ "rgba16ui",			GL_RGBA16UI,		},
-		{ "rgba8",				GL_RGBA8,			},
-		{ "rgba8i",				GL_RGBA8I,			},
-		{ "rgba8ui",			GL_RGBA8UI,			},
-		{ "srgb8_alpha8",		GL_SRGB8_ALPHA8,	},
-		{ "rgb10_a2",			GL_RGB10_A2,		},
-		{ "rgb10_a2ui",			GL_RGB10_A2UI,		},
-		{ "rgba4",				GL_RGBA4,			},
-		{ "rgb5_a1",			GL_RGB5_A1,			},
-		{ "rgba8_snorm",		GL_RGBA8_SNORM,		},
-		{ "rgb8",				GL_RGB8,			},
-		{ "rgb565",				GL_RGB565,			},
-		{ "r11f_g11f_b10f",		GL_R11F_G11F_B10F,	},
-		{ "rgb32f",				GL_RGB32F,			},
-		{ "rgb32i",				GL_RGB32I,			},
-		{ "rgb32ui",			GL_RGB32UI,			},
-		{ "rgb16f",				GL_RGB16F,			},
-		{ "rgb16i",				GL_RGB16I,			},
-		{ "rgb16ui",			GL_RGB16UI,			},
-		{ "rgb8_snorm",			GL_RGB8_SNORM,		},
-		{ "rgb8i",				GL_RGB8I,			},
-		{ "rgb8ui",				GL_RGB8UI,			},
-		{ "srgb8",				GL_SRGB8,			},
-		{ "rgb9_e5",			GL_RGB9_E5,			},
-		{ "rg32f",				GL_RG32F,			},
-		{ "rg32i",				GL_RG32I,			},
-		{ "rg32ui",				GL_RG32UI,			},
-		{ "rg16f",				GL_RG16F,			},
-		{ "rg16i",				GL_RG16I,			},
-		{ "rg16ui",				GL_RG16UI,			},
-		{ "rg8",				GL_RG8,				},
-		{ "rg8i",				GL_RG8I,			},
-		{ "rg8ui",				GL_RG8UI,			},
-		{ "rg8_snorm",			GL_RG8_SNORM,		},
-		{ "r32f",				GL_R32F,			},
-		{ "r32i",				GL_R32I,			},
-		{ "r32ui",				GL_R32UI,			},
-		{ "r16f",				GL_R16F,			},
-		{ "r16i",				GL_R16I,			},
-		{ "r16ui",				GL_R16UI,			},
-		{ "r8",					GL_R8,				},
-		{ "r8i",				GL_R8I,				},
-		{ "r8ui",				GL_R8UI,			},
-		{ "r8_snorm",			GL_R8_SNORM,		}
-	};
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
+		paramGroup->addChild(new TexImage2DParamsCase(context, cases[ndx].name, "",
+													  cases[ndx].format,
+													  cases[ndx].width,
+													  cases[ndx].height,
+													  cases[ndx].rowLength,
+													  cases[ndx].skipRows,
+													  cases[ndx].skipPixels,
+													  cases[ndx].alignment));
+}
 
+// glTexImage2D() pbo cases.
+static void createTexImage2DPboTests (Context& context, tcu::TestCaseGroup* pboGroup)
+{
+	// Parameter cases
 	static const struct
 	{
 		const char*	name;
-		deUint32	internalFormat;
-	} depthStencilFormats[] =
-	{
-		// Depth and stencil formats
-		{ "depth_component32f",	GL_DEPTH_COMPONENT32F	},
-		{ "depth_component24",	GL_DEPTH_COMPONENT24	},
-		{ "depth_component16",	GL_DEPTH_COMPONENT16	},
-		{ "depth32f_stencil8",	GL_DEPTH32F_STENCIL8	},
-		{ "depth24_stencil8",	GL_DEPTH24_STENCIL8		}
+		deUint32	format;
+		int			width;
+		int			height;
+		int			rowLength;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+		int			offset;
+	} parameterCases[] =
+	{
+		{ "rgb8_offset",		GL_RGB8,	31,	30,	0,	0,	0,	4,	67 },
+		{ "rgb8_alignment",		GL_RGB8,	31,	30,	0,	0,	0,	2,	0 },
+		{ "rgb8_row_length",	GL_RGB8,	31,	30,	50,	0,	0,	4,	0 },
+		{ "rgb8_skip_rows",		GL_RGB8,	31,	30,	0,	3,	0,	4,	0 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	31,	30,	36,	0,	5,	4,	0 }
 	};
 
-	// Basic TexImage2D usage.
-	{
-		tcu::TestCaseGroup* basicTexImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_teximage2d", "Basic glTexImage2D() usage");
-		addChild(basicTexImageGroup);
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName		= colorFormats[formatNdx].name;
-			deUint32	format		= colorFormats[formatNdx].internalFormat;
-			const int	tex2DWidth	= 64;
-			const int	tex2DHeight	= 128;
-			const int	texCubeSize	= 64;
-
-			basicTexImageGroup->addChild(new BasicTexImage2DCase	(m_context,	(string(fmtName) + "_2d").c_str(),		"",	format, tex2DWidth, tex2DHeight));
-			basicTexImageGroup->addChild(new BasicTexImageCubeCase	(m_context,	(string(fmtName) + "_cube").c_str(),	"",	format, texCubeSize));
-		}
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
+	{
+		const string	fmtName		= colorFormats[formatNdx].name;
+		const deUint32	format		= colorFormats[formatNdx].internalFormat;
+		const int		tex2DWidth	= 65;
+		const int		tex2DHeight	= 37;
+		const int		texCubeSize	= 64;
+
+		pboGroup->addChild(new TexImage2DBufferCase		(context,	(fmtName + "_2d").c_str(),		"", format, tex2DWidth, tex2DHeight, 0, 0, 0, 4, 0));
+		pboGroup->addChild(new TexImageCubeBufferCase	(context,	(fmtName + "_cube").c_str(),	"", format, texCubeSize, 0, 0, 0, 4, 0));
+	}
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(parameterCases); ndx++)
+	{
+		pboGroup->addChild(new TexImage2DBufferCase(context, (string(parameterCases[ndx].name) + "_2d").c_str(), "",
+													parameterCases[ndx].format,
+													parameterCases[ndx].width,
+													parameterCases[ndx].height,
+													parameterCases[ndx].rowLength,
+													parameterCases[ndx].skipRows,
+													parameterCases[ndx].skipPixels,
+													parameterCases[ndx].alignment,
+													parameterCases[ndx].offset));
+		pboGroup->addChild(new TexImageCubeBufferCase(context, (string(parameterCases[ndx].name) + "_cube").c_str(), "",
+													parameterCases[ndx].format,
+													parameterCases[ndx].width,
+													parameterCases[ndx].rowLength,
+													parameterCases[ndx].skipRows,
+													parameterCases[ndx].skipPixels,
+													parameterCases[ndx].alignment,
+													parameterCases[ndx].offset));
 	}
+}
 
-	// Randomized TexImage2D order.
+// glTexImage2D() depth cases.
+static void createTexImage2DDepthTests (Context& context, tcu::TestCaseGroup* shadow2dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
 	{
-		tcu::TestCaseGroup* randomTexImageGroup = new tcu::TestCaseGroup(m_testCtx, "random_teximage2d", "Randomized glTexImage2D() usage");
-		addChild(randomTexImageGroup);
-
-		de::Random rnd(9);
+		const int tex2DWidth	= 64;
+		const int tex2DHeight	= 128;
 
-		// 2D cases.
-		for (int ndx = 0; ndx < 10; ndx++)
-		{
-			int		formatNdx	= rnd.getInt(0, DE_LENGTH_OF_ARRAY(colorFormats)-1);
-			int		width		= 1 << rnd.getInt(2, 8);
-			int		height		= 1 << rnd.getInt(2, 8);
-
-			randomTexImageGroup->addChild(new RandomOrderTexImage2DCase(m_context, (string("2d_") + de::toString(ndx)).c_str(), "", colorFormats[formatNdx].internalFormat, width, height));
-		}
+		shadow2dGroup->addChild(new TexImage2DDepthCase(context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
+	}
+}
 
-		// Cubemap cases.
-		for (int ndx = 0; ndx < 10; ndx++)
-		{
-			int		formatNdx	= rnd.getInt(0, DE_LENGTH_OF_ARRAY(colorFormats)-1);
-			int		size		= 1 << rnd.getInt(2, 8);
+// glTexImage2D() depth cases with pbo.
+static void createTexImage2DDepthPboTests (Context& context, tcu::TestCaseGroup* shadow2dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
+	{
+		const int tex2DWidth	= 64;
+		const int tex2DHeight	= 128;
 
-			randomTexImageGroup->addChild(new RandomOrderTexImageCubeCase(m_context, (string("cube_") + de::toString(ndx)).c_str(), "", colorFormats[formatNdx].internalFormat, size));
-		}
+		shadow2dGroup->addChild(new TexImage2DDepthBufferCase(context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
 	}
+}
 
-	// TexImage2D unpack alignment.
-	{
-		tcu::TestCaseGroup* alignGroup = new tcu::TestCaseGroup(m_testCtx, "teximage2d_align", "glTexImage2D() unpack alignment tests");
-		addChild(alignGroup);
-
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_r8_4_8",			"",	GL_R8,			 4,  8, 4, 8));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_r8_63_1",			"",	GL_R8,			63, 30, 1, 1));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_r8_63_2",			"",	GL_R8,			63, 30, 1, 2));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_r8_63_4",			"",	GL_R8,			63, 30, 1, 4));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_r8_63_8",			"",	GL_R8,			63, 30, 1, 8));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba4_51_1",		"",	GL_RGBA4,		51, 30, 1, 1));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba4_51_2",		"",	GL_RGBA4,		51, 30, 1, 2));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba4_51_4",		"",	GL_RGBA4,		51, 30, 1, 4));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba4_51_8",		"",	GL_RGBA4,		51, 30, 1, 8));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgb8_39_1",			"",	GL_RGB8,		39, 43, 1, 1));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgb8_39_2",			"",	GL_RGB8,		39, 43, 1, 2));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgb8_39_4",			"",	GL_RGB8,		39, 43, 1, 4));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgb8_39_8",			"",	GL_RGB8,		39, 43, 1, 8));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba8_47_1",		"",	GL_RGBA8,		47, 27, 1, 1));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba8_47_2",		"",	GL_RGBA8,		47, 27, 1, 2));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba8_47_4",		"",	GL_RGBA8,		47, 27, 1, 4));
-		alignGroup->addChild(new TexImage2DAlignCase	(m_context, "2d_rgba8_47_8",		"",	GL_RGBA8,		47, 27, 1, 8));
-
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_r8_4_8",			"",	GL_R8,			 4, 3, 8));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_r8_63_1",			"",	GL_R8,			63, 1, 1));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_r8_63_2",			"",	GL_R8,			63, 1, 2));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_r8_63_4",			"",	GL_R8,			63, 1, 4));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_r8_63_8",			"",	GL_R8,			63, 1, 8));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba4_51_1",		"",	GL_RGBA4,		51, 1, 1));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba4_51_2",		"",	GL_RGBA4,		51, 1, 2));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba4_51_4",		"",	GL_RGBA4,		51, 1, 4));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba4_51_8",		"",	GL_RGBA4,		51, 1, 8));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgb8_39_1",		"",	GL_RGB8,		39, 1, 1));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgb8_39_2",		"",	GL_RGB8,		39, 1, 2));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgb8_39_4",		"",	GL_RGB8,		39, 1, 4));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgb8_39_8",		"",	GL_RGB8,		39, 1, 8));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba8_47_1",		"",	GL_RGBA8,		47, 1, 1));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba8_47_2",		"",	GL_RGBA8,		47, 1, 2));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba8_47_4",		"",	GL_RGBA8,		47, 1, 4));
-		alignGroup->addChild(new TexImageCubeAlignCase	(m_context, "cube_rgba8_47_8",		"",	GL_RGBA8,		47, 1, 8));
-	}
-
-	// glTexImage2D() unpack parameter cases.
-	{
-		tcu::TestCaseGroup* paramGroup = new tcu::TestCaseGroup(m_testCtx, "teximage2d_unpack_params", "glTexImage2D() pixel transfer mode cases");
-		addChild(paramGroup);
-
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			rowLength;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-		} cases[] =
-		{
-			{ "rgb8_alignment",		GL_RGB8,	31,	30,	0,	0,	0,	2 },
-			{ "rgb8_row_length",	GL_RGB8,	31,	30,	50,	0,	0,	4 },
-			{ "rgb8_skip_rows",		GL_RGB8,	31,	30,	0,	3,	0,	4 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	31,	30,	36,	0,	5,	4 },
-			{ "r8_complex1",		GL_R8,		31, 30, 64, 1,	3,	1 },
-			{ "r8_complex2",		GL_R8,		31, 30, 64, 1,	3,	2 },
-			{ "r8_complex3",		GL_R8,		31, 30, 64, 1,	3,	4 },
-			{ "r8_complex4",		GL_R8,		31, 30, 64, 1,	3,	8 },
-			{ "rgba8_complex1",		GL_RGBA8,	56,	61,	69,	0,	0,	8 },
-			{ "rgba8_complex2",		GL_RGBA8,	56,	61,	69,	0,	7,	8 },
-			{ "rgba8_complex3",		GL_RGBA8,	56,	61,	69,	3,	0,	8 },
-			{ "rgba8_complex4",		GL_RGBA8,	56,	61,	69,	3,	7,	8 },
-			{ "rgba32f_complex",	GL_RGBA32F,	19,	10,	27,	1,	7,	8 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
-			paramGroup->addChild(new TexImage2DParamsCase(m_context, cases[ndx].name, "",
-														  cases[ndx].format,
-														  cases[ndx].width,
-														  cases[ndx].height,
-														  cases[ndx].rowLength,
-														  cases[ndx].skipRows,
-														  cases[ndx].skipPixels,
-														  cases[ndx].alignment));
-	}
-
-	// glTexImage2D() pbo cases.
-	{
-		tcu::TestCaseGroup* pboGroup = new tcu::TestCaseGroup(m_testCtx, "teximage2d_pbo", "glTexImage2D() from PBO");
-		addChild(pboGroup);
-
-		// Parameter cases
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			rowLength;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-			int			offset;
-		} parameterCases[] =
-		{
-			{ "rgb8_offset",		GL_RGB8,	31,	30,	0,	0,	0,	4,	67 },
-			{ "rgb8_alignment",		GL_RGB8,	31,	30,	0,	0,	0,	2,	0 },
-			{ "rgb8_row_length",	GL_RGB8,	31,	30,	50,	0,	0,	4,	0 },
-			{ "rgb8_skip_rows",		GL_RGB8,	31,	30,	0,	3,	0,	4,	0 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	31,	30,	36,	0,	5,	4,	0 }
-		};
-
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const string	fmtName		= colorFormats[formatNdx].name;
-			const deUint32	format		= colorFormats[formatNdx].internalFormat;
-			const int		tex2DWidth	= 65;
-			const int		tex2DHeight	= 37;
-			const int		texCubeSize	= 64;
-
-			pboGroup->addChild(new TexImage2DBufferCase		(m_context,	(fmtName + "_2d").c_str(),		"", format, tex2DWidth, tex2DHeight, 0, 0, 0, 4, 0));
-			pboGroup->addChild(new TexImageCubeBufferCase	(m_context,	(fmtName + "_cube").c_str(),	"", format, texCubeSize, 0, 0, 0, 4, 0));
-		}
+// Basic TexSubImage2D usage.
+static void createBasicTexSubImage2DTests (Context& context, tcu::TestCaseGroup* basicTexSubImageGroup)
+{
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
+	{
+		const char*	fmtName		= colorFormats[formatNdx].name;
+		deUint32	format		= colorFormats[formatNdx].internalFormat;
+		const int	tex2DWidth	= 64;
+		const int	tex2DHeight	= 128;
+		const int	texCubeSize	= 64;
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(parameterCases); ndx++)
-		{
-			pboGroup->addChild(new TexImage2DBufferCase(m_context, (string(parameterCases[ndx].name) + "_2d").c_str(), "",
-														parameterCases[ndx].format,
-														parameterCases[ndx].width,
-														parameterCases[ndx].height,
-														parameterCases[ndx].rowLength,
-														parameterCases[ndx].skipRows,
-														parameterCases[ndx].skipPixels,
-														parameterCases[ndx].alignment,
-														parameterCases[ndx].offset));
-			pboGroup->addChild(new TexImageCubeBufferCase(m_context, (string(parameterCases[ndx].name) + "_cube").c_str(), "",
-														parameterCases[ndx].format,
-														parameterCases[ndx].width,
-														parameterCases[ndx].rowLength,
-														parameterCases[ndx].skipRows,
-														parameterCases[ndx].skipPixels,
-														parameterCases[ndx].alignment,
-														parameterCases[ndx].offset));
-		}
+		basicTexSubImageGroup->addChild(new BasicTexSubImage2DCase		(context,	(string(fmtName) + "_2d").c_str(),		"",	format, tex2DWidth, tex2DHeight));
+		basicTexSubImageGroup->addChild(new BasicTexSubImageCubeCase	(context,	(string(fmtName) + "_cube").c_str(),	"",	format, texCubeSize));
 	}
+}
 
-	// glTexImage2D() depth cases.
+// TexSubImage2D to empty texture.
+static void createTexSubImage2DEmptyTexTests (Context& context, tcu::TestCaseGroup* texSubImageEmptyTexGroup)
+{
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(unsizedFormats); formatNdx++)
 	{
-		tcu::TestCaseGroup* shadow2dGroup = new tcu::TestCaseGroup(m_testCtx, "teximage2d_depth", "glTexImage2D() with depth or depth/stencil format");
-		addChild(shadow2dGroup);
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int tex2DWidth	= 64;
-			const int tex2DHeight	= 128;
+		const char*	fmtName		= unsizedFormats[formatNdx].name;
+		deUint32	format		= unsizedFormats[formatNdx].format;
+		deUint32	dataType	= unsizedFormats[formatNdx].dataType;
+		const int	tex2DWidth	= 64;
+		const int	tex2DHeight	= 32;
+		const int	texCubeSize	= 32;
 
-			shadow2dGroup->addChild(new TexImage2DDepthCase(m_context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
-		}
+		texSubImageEmptyTexGroup->addChild(new TexSubImage2DEmptyTexCase	(context,	(string(fmtName) + "_2d").c_str(),		"",	format, dataType, tex2DWidth, tex2DHeight));
+		texSubImageEmptyTexGroup->addChild(new TexSubImageCubeEmptyTexCase	(context,	(string(fmtName) + "_cube").c_str(),	"",	format, dataType, texCubeSize));
 	}
+}
 
-	// glTexImage2D() depth cases with pbo.
-	{
-		tcu::TestCaseGroup* shadow2dGroup = new tcu::TestCaseGroup(m_testCtx, "teximage2d_depth_pbo", "glTexImage2D() with depth or depth/stencil format with pbo");
-		addChild(shadow2dGroup);
+// TexSubImage2D alignment cases.
+static void createTexSubImage2DAlignTests (Context& context, tcu::TestCaseGroup* alignGroup)
+{
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_1_1",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 1));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_1_2",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 2));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_1_4",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 4));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_1_8",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 8));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_63_1",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 1));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_63_2",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 2));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_63_4",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 4));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_r8_63_8",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 8));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba4_51_1",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 1));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba4_51_2",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 2));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba4_51_4",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 4));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba4_51_8",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 8));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgb8_39_1",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 1));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgb8_39_2",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 2));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgb8_39_4",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 4));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgb8_39_8",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 8));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba8_47_1",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 1));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba8_47_2",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 2));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba8_47_4",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 4));
+	alignGroup->addChild(new TexSubImage2DAlignCase		(context, "2d_rgba8_47_8",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 8));
+
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_1_1",			"",	GL_R8,			64, 13, 17,  1,  6, 1));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_1_2",			"",	GL_R8,			64, 13, 17,  1,  6, 2));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_1_4",			"",	GL_R8,			64, 13, 17,  1,  6, 4));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_1_8",			"",	GL_R8,			64, 13, 17,  1,  6, 8));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_63_1",			"",	GL_R8,			64,  1,  9, 63, 30, 1));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_63_2",			"",	GL_R8,			64,  1,  9, 63, 30, 2));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_63_4",			"",	GL_R8,			64,  1,  9, 63, 30, 4));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_r8_63_8",			"",	GL_R8,			64,  1,  9, 63, 30, 8));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba4_51_1",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 1));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba4_51_2",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 2));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba4_51_4",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 4));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba4_51_8",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 8));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgb8_39_1",		"",	GL_RGB8,		64, 11,  8, 39, 43, 1));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgb8_39_2",		"",	GL_RGB8,		64, 11,  8, 39, 43, 2));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgb8_39_4",		"",	GL_RGB8,		64, 11,  8, 39, 43, 4));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgb8_39_8",		"",	GL_RGB8,		64, 11,  8, 39, 43, 8));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba8_47_1",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 1));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba8_47_2",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 2));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba8_47_4",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 4));
+	alignGroup->addChild(new TexSubImageCubeAlignCase	(context, "cube_rgba8_47_8",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 8));
+}
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int tex2DWidth	= 64;
-			const int tex2DHeight	= 128;
+// glTexSubImage2D() pixel transfer mode cases.
+static void createTexSubImage2DUnpackParamsTests (Context& context, tcu::TestCaseGroup* paramGroup)
+{
+	static const struct
+	{
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			subX;
+		int			subY;
+		int			subW;
+		int			subH;
+		int			rowLength;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+	} cases[] =
+	{
+		{ "rgb8_alignment",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	2 },
+		{ "rgb8_row_length",	GL_RGB8,	54,	60,	11,	7,	31,	30,	50,	0,	0,	4 },
+		{ "rgb8_skip_rows",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	3,	0,	4 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	54,	60,	11,	7,	31,	30,	36,	0,	5,	4 },
+		{ "r8_complex1",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	1 },
+		{ "r8_complex2",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	2 },
+		{ "r8_complex3",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	4 },
+		{ "r8_complex4",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	8 },
+		{ "rgba8_complex1",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	0,	0,	8 },
+		{ "rgba8_complex2",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	0,	7,	8 },
+		{ "rgba8_complex3",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	3,	0,	8 },
+		{ "rgba8_complex4",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	3,	7,	8 },
+		{ "rgba32f_complex",	GL_RGBA32F,	92,	84,	13,	19,	56,	61,	69,	3,	7,	8 }
+	};
 
-			shadow2dGroup->addChild(new TexImage2DDepthBufferCase(m_context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
-		}
-	}
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
+		paramGroup->addChild(new TexSubImage2DParamsCase(context, cases[ndx].name, "",
+														 cases[ndx].format,
+														 cases[ndx].width,
+														 cases[ndx].height,
+														 cases[ndx].subX,
+														 cases[ndx].subY,
+														 cases[ndx].subW,
+														 cases[ndx].subH,
+														 cases[ndx].rowLength,
+														 cases[ndx].skipRows,
+														 cases[ndx].skipPixels,
+														 cases[ndx].alignment));
+}
 
-	// Basic TexSubImage2D usage.
+// glTexSubImage2D() PBO cases.
+static void createTexSubImage2DPboTests (Context& context, tcu::TestCaseGroup* pboGroup)
+{
+	static const struct
 	{
-		tcu::TestCaseGroup* basicTexSubImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_texsubimage2d", "Basic glTexSubImage2D() usage");
-		addChild(basicTexSubImageGroup);
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName		= colorFormats[formatNdx].name;
-			deUint32	format		= colorFormats[formatNdx].internalFormat;
-			const int	tex2DWidth	= 64;
-			const int	tex2DHeight	= 128;
-			const int	texCubeSize	= 64;
-
-			basicTexSubImageGroup->addChild(new BasicTexSubImage2DCase		(m_context,	(string(fmtName) + "_2d").c_str(),		"",	format, tex2DWidth, tex2DHeight));
-			basicTexSubImageGroup->addChild(new BasicTexSubImageCubeCase	(m_context,	(string(fmtName) + "_cube").c_str(),	"",	format, texCubeSize));
-		}
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			subX;
+		int			subY;
+		int			subW;
+		int			subH;
+		int			rowLength;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+		int			offset;
+	} paramCases[] =
+	{
+		{ "rgb8_offset",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	4,	67 },
+		{ "rgb8_alignment",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	2,	0 },
+		{ "rgb8_row_length",	GL_RGB8,	54,	60,	11,	7,	31,	30,	50,	0,	0,	4,	0 },
+		{ "rgb8_skip_rows",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	3,	0,	4,	0 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	54,	60,	11,	7,	31,	30,	36,	0,	5,	4,	0 }
+	};
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(colorFormats); ndx++)
+	{
+		pboGroup->addChild(new TexSubImage2DBufferCase(context, (std::string(colorFormats[ndx].name) + "_2d").c_str(), "",
+													   colorFormats[ndx].internalFormat,
+													   54,	// Width
+													   60,	// Height
+													   11,	// Sub X
+													   7,	// Sub Y
+													   31,	// Sub W
+													   30,	// Sub H
+													   0,	// Row len
+													   0,	// Skip rows
+													   0,	// Skip pixels
+													   4,	// Alignment
+													   0	/* offset */));
+		pboGroup->addChild(new TexSubImageCubeBufferCase(context, (std::string(colorFormats[ndx].name) + "_cube").c_str(), "",
+													   colorFormats[ndx].internalFormat,
+													   64,	// Size
+													   11,	// Sub X
+													   7,	// Sub Y
+													   31,	// Sub W
+													   30,	// Sub H
+													   0,	// Row len
+													   0,	// Skip rows
+													   0,	// Skip pixels
+													   4,	// Alignment
+													   0	/* offset */));
+	}
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(paramCases); ndx++)
+	{
+		pboGroup->addChild(new TexSubImage2DBufferCase(context, (std::string(paramCases[ndx].name) + "_2d").c_str(), "",
+													   paramCases[ndx].format,
+													   paramCases[ndx].width,
+													   paramCases[ndx].height,
+													   paramCases[ndx].subX,
+													   paramCases[ndx].subY,
+													   paramCases[ndx].subW,
+													   paramCases[ndx].subH,
+													   paramCases[ndx].rowLength,
+													   paramCases[ndx].skipRows,
+													   paramCases[ndx].skipPixels,
+													   paramCases[ndx].alignment,
+													   paramCases[ndx].offset));
+		pboGroup->addChild(new TexSubImageCubeBufferCase(context, (std::string(paramCases[ndx].name) + "_cube").c_str(), "",
+													   paramCases[ndx].format,
+													   paramCases[ndx].width,
+													   paramCases[ndx].subX,
+													   paramCases[ndx].subY,
+													   paramCases[ndx].subW,
+													   paramCases[ndx].subH,
+													   paramCases[ndx].rowLength,
+													   paramCases[ndx].skipRows,
+													   paramCases[ndx].skipPixels,
+													   paramCases[ndx].alignment,
+													   paramCases[ndx].offset));
 	}
+}
 
-	// TexSubImage2D to empty texture.
+// glTexSubImage2D() depth cases.
+static void createTexSubImage2DDepthTests (Context& context, tcu::TestCaseGroup* shadow2dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
 	{
-		tcu::TestCaseGroup* texSubImageEmptyTexGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage2d_empty_tex", "glTexSubImage2D() to texture that has storage but no data");
-		addChild(texSubImageEmptyTexGroup);
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(unsizedFormats); formatNdx++)
-		{
-			const char*	fmtName		= unsizedFormats[formatNdx].name;
-			deUint32	format		= unsizedFormats[formatNdx].format;
-			deUint32	dataType	= unsizedFormats[formatNdx].dataType;
-			const int	tex2DWidth	= 64;
-			const int	tex2DHeight	= 32;
-			const int	texCubeSize	= 32;
-
-			texSubImageEmptyTexGroup->addChild(new TexSubImage2DEmptyTexCase	(m_context,	(string(fmtName) + "_2d").c_str(),		"",	format, dataType, tex2DWidth, tex2DHeight));
-			texSubImageEmptyTexGroup->addChild(new TexSubImageCubeEmptyTexCase	(m_context,	(string(fmtName) + "_cube").c_str(),	"",	format, dataType, texCubeSize));
-		}
+		const int	tex2DWidth	= 64;
+		const int	tex2DHeight	= 32;
+
+		shadow2dGroup->addChild(new TexSubImage2DDepthCase(context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
 	}
+}
 
-	// TexSubImage2D alignment cases.
-	{
-		tcu::TestCaseGroup* alignGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage2d_align", "glTexSubImage2D() unpack alignment tests");
-		addChild(alignGroup);
-
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_1_1",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 1));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_1_2",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 2));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_1_4",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 4));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_1_8",			"",	GL_R8,			64, 64, 13, 17,  1,  6, 8));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_63_1",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 1));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_63_2",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 2));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_63_4",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 4));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_r8_63_8",			"",	GL_R8,			64, 64,  1,  9, 63, 30, 8));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba4_51_1",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 1));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba4_51_2",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 2));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba4_51_4",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 4));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba4_51_8",		"",	GL_RGBA4,		64, 64,  7, 29, 51, 30, 8));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgb8_39_1",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 1));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgb8_39_2",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 2));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgb8_39_4",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 4));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgb8_39_8",			"",	GL_RGB8,		64, 64, 11,  8, 39, 43, 8));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba8_47_1",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 1));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba8_47_2",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 2));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba8_47_4",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 4));
-		alignGroup->addChild(new TexSubImage2DAlignCase		(m_context, "2d_rgba8_47_8",		"",	GL_RGBA8,		64, 64, 10,  1, 47, 27, 8));
-
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_1_1",			"",	GL_R8,			64, 13, 17,  1,  6, 1));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_1_2",			"",	GL_R8,			64, 13, 17,  1,  6, 2));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_1_4",			"",	GL_R8,			64, 13, 17,  1,  6, 4));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_1_8",			"",	GL_R8,			64, 13, 17,  1,  6, 8));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_63_1",			"",	GL_R8,			64,  1,  9, 63, 30, 1));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_63_2",			"",	GL_R8,			64,  1,  9, 63, 30, 2));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_63_4",			"",	GL_R8,			64,  1,  9, 63, 30, 4));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_r8_63_8",			"",	GL_R8,			64,  1,  9, 63, 30, 8));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba4_51_1",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 1));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba4_51_2",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 2));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba4_51_4",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 4));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba4_51_8",		"",	GL_RGBA4,		64,  7, 29, 51, 30, 8));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgb8_39_1",		"",	GL_RGB8,		64, 11,  8, 39, 43, 1));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgb8_39_2",		"",	GL_RGB8,		64, 11,  8, 39, 43, 2));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgb8_39_4",		"",	GL_RGB8,		64, 11,  8, 39, 43, 4));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgb8_39_8",		"",	GL_RGB8,		64, 11,  8, 39, 43, 8));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba8_47_1",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 1));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba8_47_2",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 2));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba8_47_4",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 4));
-		alignGroup->addChild(new TexSubImageCubeAlignCase	(m_context, "cube_rgba8_47_8",		"",	GL_RGBA8,		64, 10,  1, 47, 27, 8));
-	}
-
-	// glTexSubImage2D() pixel transfer mode cases.
-	{
-		tcu::TestCaseGroup* paramGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage2d_unpack_params", "glTexSubImage2D() pixel transfer mode cases");
-		addChild(paramGroup);
-
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			subX;
-			int			subY;
-			int			subW;
-			int			subH;
-			int			rowLength;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-		} cases[] =
-		{
-			{ "rgb8_alignment",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	2 },
-			{ "rgb8_row_length",	GL_RGB8,	54,	60,	11,	7,	31,	30,	50,	0,	0,	4 },
-			{ "rgb8_skip_rows",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	3,	0,	4 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	54,	60,	11,	7,	31,	30,	36,	0,	5,	4 },
-			{ "r8_complex1",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	1 },
-			{ "r8_complex2",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	2 },
-			{ "r8_complex3",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	4 },
-			{ "r8_complex4",		GL_R8,		54,	60,	11,	7,	31, 30, 64, 1,	3,	8 },
-			{ "rgba8_complex1",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	0,	0,	8 },
-			{ "rgba8_complex2",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	0,	7,	8 },
-			{ "rgba8_complex3",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	3,	0,	8 },
-			{ "rgba8_complex4",		GL_RGBA8,	92,	84,	13,	19,	56,	61,	69,	3,	7,	8 },
-			{ "rgba32f_complex",	GL_RGBA32F,	92,	84,	13,	19,	56,	61,	69,	3,	7,	8 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
-			paramGroup->addChild(new TexSubImage2DParamsCase(m_context, cases[ndx].name, "",
-															 cases[ndx].format,
-															 cases[ndx].width,
-															 cases[ndx].height,
-															 cases[ndx].subX,
-															 cases[ndx].subY,
-															 cases[ndx].subW,
-															 cases[ndx].subH,
-															 cases[ndx].rowLength,
-															 cases[ndx].skipRows,
-															 cases[ndx].skipPixels,
-															 cases[ndx].alignment));
-	}
-
-	// glTexSubImage2D() PBO cases.
-	{
-		tcu::TestCaseGroup* pboGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage2d_pbo", "glTexSubImage2D() pixel buffer object tests");
-		addChild(pboGroup);
-
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			subX;
-			int			subY;
-			int			subW;
-			int			subH;
-			int			rowLength;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-			int			offset;
-		} paramCases[] =
-		{
-			{ "rgb8_offset",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	4,	67 },
-			{ "rgb8_alignment",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	0,	0,	2,	0 },
-			{ "rgb8_row_length",	GL_RGB8,	54,	60,	11,	7,	31,	30,	50,	0,	0,	4,	0 },
-			{ "rgb8_skip_rows",		GL_RGB8,	54,	60,	11,	7,	31,	30,	0,	3,	0,	4,	0 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	54,	60,	11,	7,	31,	30,	36,	0,	5,	4,	0 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(colorFormats); ndx++)
-		{
-			pboGroup->addChild(new TexSubImage2DBufferCase(m_context, (std::string(colorFormats[ndx].name) + "_2d").c_str(), "",
-														   colorFormats[ndx].internalFormat,
-														   54,	// Width
-														   60,	// Height
-														   11,	// Sub X
-														   7,	// Sub Y
-														   31,	// Sub W
-														   30,	// Sub H
-														   0,	// Row len
-														   0,	// Skip rows
-														   0,	// Skip pixels
-														   4,	// Alignment
-														   0	/* offset */));
-			pboGroup->addChild(new TexSubImageCubeBufferCase(m_context, (std::string(colorFormats[ndx].name) + "_cube").c_str(), "",
-														   colorFormats[ndx].internalFormat,
-														   64,	// Size
-														   11,	// Sub X
-														   7,	// Sub Y
-														   31,	// Sub W
-														   30,	// Sub H
-														   0,	// Row len
-														   0,	// Skip rows
-														   0,	// Skip pixels
-														   4,	// Alignment
-														   0	/* offset */));
-		}
+// Basic glCopyTexImage2D() cases
+static void createBasicCopyTexImage2DTests (Context& context, tcu::TestCaseGroup* copyTexImageGroup)
+{
+	copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(context, "2d_alpha",				"",	GL_ALPHA,			128, 64));
+	copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(context, "2d_luminance",			"",	GL_LUMINANCE,		128, 64));
+	copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(context, "2d_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	128, 64));
+	copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(context, "2d_rgb",				"",	GL_RGB,				128, 64));
+	copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(context, "2d_rgba",				"",	GL_RGBA,			128, 64));
+
+	copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(context, "cube_alpha",			"",	GL_ALPHA,			64));
+	copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(context, "cube_luminance",		"",	GL_LUMINANCE,		64));
+	copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(context, "cube_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	64));
+	copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(context, "cube_rgb",				"",	GL_RGB,				64));
+	copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(context, "cube_rgba",			"",	GL_RGBA,			64));
+}
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(paramCases); ndx++)
-		{
-			pboGroup->addChild(new TexSubImage2DBufferCase(m_context, (std::string(paramCases[ndx].name) + "_2d").c_str(), "",
-														   paramCases[ndx].format,
-														   paramCases[ndx].width,
-														   paramCases[ndx].height,
-														   paramCases[ndx].subX,
-														   paramCases[ndx].subY,
-														   paramCases[ndx].subW,
-														   paramCases[ndx].subH,
-														   paramCases[ndx].rowLength,
-														   paramCases[ndx].skipRows,
-														   paramCases[ndx].skipPixels,
-														   paramCases[ndx].alignment,
-														   paramCases[ndx].offset));
-			pboGroup->addChild(new TexSubImageCubeBufferCase(m_context, (std::string(paramCases[ndx].name) + "_cube").c_str(), "",
-														   paramCases[ndx].format,
-														   paramCases[ndx].width,
-														   paramCases[ndx].subX,
-														   paramCases[ndx].subY,
-														   paramCases[ndx].subW,
-														   paramCases[ndx].subH,
-														   paramCases[ndx].rowLength,
-														   paramCases[ndx].skipRows,
-														   paramCases[ndx].skipPixels,
-														   paramCases[ndx].alignment,
-														   paramCases[ndx].offset));
-		}
-	}
+// Basic glCopyTexSubImage2D() cases
+static void createBasicCopyTexSubImage2DTests (Context& context, tcu::TestCaseGroup* copyTexSubImageGroup)
+{
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(context, "2d_alpha",				"",	GL_ALPHA,			GL_UNSIGNED_BYTE, 128, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(context, "2d_luminance",			"",	GL_LUMINANCE,		GL_UNSIGNED_BYTE, 128, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(context, "2d_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE, 128, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(context, "2d_rgb",				"",	GL_RGB,				GL_UNSIGNED_BYTE, 128, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(context, "2d_rgba",				"",	GL_RGBA,			GL_UNSIGNED_BYTE, 128, 64));
+
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(context, "cube_alpha",			"",	GL_ALPHA,			GL_UNSIGNED_BYTE, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(context, "cube_luminance",		"",	GL_LUMINANCE,		GL_UNSIGNED_BYTE, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(context, "cube_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(context, "cube_rgb",				"",	GL_RGB,				GL_UNSIGNED_BYTE, 64));
+	copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(context, "cube_rgba",			"",	GL_RGBA,			GL_UNSIGNED_BYTE, 64));
+}
 
-	// glTexSubImage2D() depth cases.
+// Basic TexImage3D usage.
+static void createBasicTexImage3DTests (Context& context, tcu::TestCaseGroup* basicTexImageGroup)
+{
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
 	{
-		tcu::TestCaseGroup* shadow2dGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage2d_depth", "glTexSubImage2D() with depth or depth/stencil format");
-		addChild(shadow2dGroup);
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int	tex2DWidth	= 64;
-			const int	tex2DHeight	= 32;
+		const char*	fmtName				= colorFormats[formatNdx].name;
+		deUint32	format				= colorFormats[formatNdx].internalFormat;
+		const int	tex2DArrayWidth		= 57;
+		const int	tex2DArrayHeight	= 44;
+		const int	tex2DArrayLevels	= 5;
+		const int	tex3DWidth			= 63;
+		const int	tex3DHeight			= 29;
+		const int	tex3DDepth			= 11;
 
-			shadow2dGroup->addChild(new TexSubImage2DDepthCase(m_context, depthStencilFormats[ndx].name, "", depthStencilFormats[ndx].internalFormat, tex2DWidth, tex2DHeight));
-		}
+		basicTexImageGroup->addChild(new BasicTexImage2DArrayCase	(context,	(string(fmtName) + "_2d_array").c_str(),	"",	format, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLevels));
+		basicTexImageGroup->addChild(new BasicTexImage3DCase		(context,	(string(fmtName) + "_3d").c_str(),			"",	format, tex3DWidth, tex3DHeight, tex3DDepth));
 	}
+}
 
-	// Basic glCopyTexImage2D() cases
+// glTexImage3D() unpack params cases.
+static void createTexImage3DUnpackParamsTests (Context& context, tcu::TestCaseGroup* paramGroup)
+{
+	static const struct
 	{
-		tcu::TestCaseGroup* copyTexImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_copyteximage2d", "Basic glCopyTexImage2D() usage");
-		addChild(copyTexImageGroup);
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			depth;
+		int			imageHeight;
+		int			rowLength;
+		int			skipImages;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+	} cases[] =
+	{
+		{ "rgb8_image_height",	GL_RGB8,	23,	19,	8,	26,	0,	0,	0,	0,	4 },
+		{ "rgb8_row_length",	GL_RGB8,	23,	19,	8,	0,	27,	0,	0,	0,	4 },
+		{ "rgb8_skip_images",	GL_RGB8,	23,	19,	8,	0,	0,	3,	0,	0,	4 },
+		{ "rgb8_skip_rows",		GL_RGB8,	23,	19,	8,	22,	0,	0,	3,	0,	4 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	23,	19,	8,	0,	25,	0,	0,	2,	4 },
+		{ "r8_complex1",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	1 },
+		{ "r8_complex2",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	2 },
+		{ "r8_complex3",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	4 },
+		{ "r8_complex4",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	8 },
+		{ "rgba8_complex1",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	0,	0,	8 },
+		{ "rgba8_complex2",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	2,	0,	8 },
+		{ "rgba8_complex3",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	0,	3,	8 },
+		{ "rgba8_complex4",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	2,	3,	8 },
+		{ "rgba32f_complex",	GL_RGBA32F,	11,	20,	8,	25,	14,	0,	2,	3,	8 }
+	};
 
-		copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(m_context, "2d_alpha",				"",	GL_ALPHA,			128, 64));
-		copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(m_context, "2d_luminance",			"",	GL_LUMINANCE,		128, 64));
-		copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(m_context, "2d_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	128, 64));
-		copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(m_context, "2d_rgb",				"",	GL_RGB,				128, 64));
-		copyTexImageGroup->addChild(new BasicCopyTexImage2DCase		(m_context, "2d_rgba",				"",	GL_RGBA,			128, 64));
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
+		paramGroup->addChild(new TexImage3DParamsCase(context, cases[ndx].name, "",
+													  cases[ndx].format,
+													  cases[ndx].width,
+													  cases[ndx].height,
+													  cases[ndx].depth,
+													  cases[ndx].imageHeight,
+													  cases[ndx].rowLength,
+													  cases[ndx].skipImages,
+													  cases[ndx].skipRows,
+													  cases[ndx].skipPixels,
+													  cases[ndx].alignment));
+}
 
-		copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(m_context, "cube_alpha",			"",	GL_ALPHA,			64));
-		copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(m_context, "cube_luminance",		"",	GL_LUMINANCE,		64));
-		copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(m_context, "cube_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	64));
-		copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(m_context, "cube_rgb",				"",	GL_RGB,				64));
-		copyTexImageGroup->addChild(new BasicCopyTexImageCubeCase	(m_context, "cube_rgba",			"",	GL_RGBA,			64));
+// glTexImage3D() pbo cases.
+static void createTexImage3DPboTests (Context& context, tcu::TestCaseGroup* pboGroup)
+{
+	// Parameter cases
+	static const struct
+	{
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			depth;
+		int			imageHeight;
+		int			rowLength;
+		int			skipImages;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+		int			offset;
+	} parameterCases[] =
+	{
+		{ "rgb8_offset",		GL_RGB8,	23,	19,	8,	0,	0,	0,	0,	0,	1,	67 },
+		{ "rgb8_alignment",		GL_RGB8,	23,	19,	8,	0,	0,	0,	0,	0,	2,	0 },
+		{ "rgb8_image_height",	GL_RGB8,	23,	19,	8,	26,	0,	0,	0,	0,	4,	0 },
+		{ "rgb8_row_length",	GL_RGB8,	23,	19,	8,	0,	27,	0,	0,	0,	4,	0 },
+		{ "rgb8_skip_images",	GL_RGB8,	23,	19,	8,	0,	0,	3,	0,	0,	4,	0 },
+		{ "rgb8_skip_rows",		GL_RGB8,	23,	19,	8,	22,	0,	0,	3,	0,	4,	0 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	23,	19,	8,	0,	25,	0,	0,	2,	4,	0 }
+	};
+
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
+	{
+		const string	fmtName		= colorFormats[formatNdx].name;
+		const deUint32	format		= colorFormats[formatNdx].internalFormat;
+		const int		tex3DWidth	= 11;
+		const int		tex3DHeight	= 20;
+		const int		tex3DDepth	= 8;
+
+		pboGroup->addChild(new TexImage2DArrayBufferCase	(context, (fmtName + "_2d_array").c_str(),	"", format, tex3DWidth, tex3DHeight, tex3DDepth, 0, 0, 0, 0, 0, 4, 0));
+		pboGroup->addChild(new TexImage3DBufferCase			(context, (fmtName + "_3d").c_str(),			"", format, tex3DWidth, tex3DHeight, tex3DDepth, 0, 0, 0, 0, 0, 4, 0));
+	}
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(parameterCases); ndx++)
+	{
+		pboGroup->addChild(new TexImage2DArrayBufferCase(context, (string(parameterCases[ndx].name) + "_2d_array").c_str(), "",
+													parameterCases[ndx].format,
+													parameterCases[ndx].width,
+													parameterCases[ndx].depth,
+													parameterCases[ndx].height,
+													parameterCases[ndx].imageHeight,
+													parameterCases[ndx].rowLength,
+													parameterCases[ndx].skipImages,
+													parameterCases[ndx].skipRows,
+													parameterCases[ndx].skipPixels,
+													parameterCases[ndx].alignment,
+													parameterCases[ndx].offset));
+		pboGroup->addChild(new TexImage3DBufferCase(context, (string(parameterCases[ndx].name) + "_3d").c_str(), "",
+													parameterCases[ndx].format,
+													parameterCases[ndx].width,
+													parameterCases[ndx].depth,
+													parameterCases[ndx].height,
+													parameterCases[ndx].imageHeight,
+													parameterCases[ndx].rowLength,
+													parameterCases[ndx].skipImages,
+													parameterCases[ndx].skipRows,
+													parameterCases[ndx].skipPixels,
+													parameterCases[ndx].alignment,
+													parameterCases[ndx].offset));
 	}
+}
 
-	// Basic glCopyTexSubImage2D() cases
+// glTexImage3D() depth cases.
+static void createTexImage3DDepthTests (Context& context, tcu::TestCaseGroup* shadow3dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
 	{
-		tcu::TestCaseGroup* copyTexSubImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_copytexsubimage2d", "Basic glCopyTexSubImage2D() usage");
-		addChild(copyTexSubImageGroup);
-
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(m_context, "2d_alpha",				"",	GL_ALPHA,			GL_UNSIGNED_BYTE, 128, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(m_context, "2d_luminance",			"",	GL_LUMINANCE,		GL_UNSIGNED_BYTE, 128, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(m_context, "2d_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE, 128, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(m_context, "2d_rgb",				"",	GL_RGB,				GL_UNSIGNED_BYTE, 128, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImage2DCase	(m_context, "2d_rgba",				"",	GL_RGBA,			GL_UNSIGNED_BYTE, 128, 64));
+		const int	tex3DWidth	= 32;
+		const int	tex3DHeight	= 64;
+		const int	tex3DDepth	= 8;
 
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(m_context, "cube_alpha",			"",	GL_ALPHA,			GL_UNSIGNED_BYTE, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(m_context, "cube_luminance",		"",	GL_LUMINANCE,		GL_UNSIGNED_BYTE, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(m_context, "cube_luminance_alpha",	"",	GL_LUMINANCE_ALPHA,	GL_UNSIGNED_BYTE, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(m_context, "cube_rgb",				"",	GL_RGB,				GL_UNSIGNED_BYTE, 64));
-		copyTexSubImageGroup->addChild(new BasicCopyTexSubImageCubeCase	(m_context, "cube_rgba",			"",	GL_RGBA,			GL_UNSIGNED_BYTE, 64));
+		shadow3dGroup->addChild(new TexImage2DArrayDepthCase(context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex3DWidth, tex3DHeight, tex3DDepth));
 	}
+}
 
-	// Basic TexImage3D usage.
+// glTexImage3D() depth cases with pbo.
+static void createTexImage3DDepthPboTests (Context& context, tcu::TestCaseGroup* shadow3dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
 	{
-		tcu::TestCaseGroup* basicTexImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_teximage3d", "Basic glTexImage3D() usage");
-		addChild(basicTexImageGroup);
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName				= colorFormats[formatNdx].name;
-			deUint32	format				= colorFormats[formatNdx].internalFormat;
-			const int	tex2DArrayWidth		= 57;
-			const int	tex2DArrayHeight	= 44;
-			const int	tex2DArrayLevels	= 5;
-			const int	tex3DWidth			= 63;
-			const int	tex3DHeight			= 29;
-			const int	tex3DDepth			= 11;
-
-			basicTexImageGroup->addChild(new BasicTexImage2DArrayCase	(m_context,	(string(fmtName) + "_2d_array").c_str(),	"",	format, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLevels));
-			basicTexImageGroup->addChild(new BasicTexImage3DCase		(m_context,	(string(fmtName) + "_3d").c_str(),			"",	format, tex3DWidth, tex3DHeight, tex3DDepth));
-		}
+		const int	tex3DWidth	= 32;
+		const int	tex3DHeight	= 64;
+		const int	tex3DDepth	= 8;
+
+		shadow3dGroup->addChild(new TexImage2DArrayDepthBufferCase(context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex3DWidth, tex3DHeight, tex3DDepth));
 	}
+}
 
-	// glTexImage3D() unpack params cases.
+// Basic TexSubImage3D usage.
+static void createBasicTexSubImage3DTests (Context& context, tcu::TestCaseGroup* basicTexSubImageGroup)
+{
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
 	{
-		tcu::TestCaseGroup* paramGroup = new tcu::TestCaseGroup(m_testCtx, "teximage3d_unpack_params", "glTexImage3D() unpack parameters");
-		addChild(paramGroup);
+		const char*	fmtName		= colorFormats[formatNdx].name;
+		deUint32	format		= colorFormats[formatNdx].internalFormat;
+		const int	tex3DWidth	= 32;
+		const int	tex3DHeight	= 64;
+		const int	tex3DDepth	= 8;
 
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			depth;
-			int			imageHeight;
-			int			rowLength;
-			int			skipImages;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-		} cases[] =
-		{
-			{ "rgb8_image_height",	GL_RGB8,	23,	19,	8,	26,	0,	0,	0,	0,	4 },
-			{ "rgb8_row_length",	GL_RGB8,	23,	19,	8,	0,	27,	0,	0,	0,	4 },
-			{ "rgb8_skip_images",	GL_RGB8,	23,	19,	8,	0,	0,	3,	0,	0,	4 },
-			{ "rgb8_skip_rows",		GL_RGB8,	23,	19,	8,	22,	0,	0,	3,	0,	4 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	23,	19,	8,	0,	25,	0,	0,	2,	4 },
-			{ "r8_complex1",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	1 },
-			{ "r8_complex2",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	2 },
-			{ "r8_complex3",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	4 },
-			{ "r8_complex4",		GL_R8,		13, 17, 11,	23,	15,	2,	3,	1,	8 },
-			{ "rgba8_complex1",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	0,	0,	8 },
-			{ "rgba8_complex2",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	2,	0,	8 },
-			{ "rgba8_complex3",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	0,	3,	8 },
-			{ "rgba8_complex4",		GL_RGBA8,	11,	20,	8,	25,	14,	0,	2,	3,	8 },
-			{ "rgba32f_complex",	GL_RGBA32F,	11,	20,	8,	25,	14,	0,	2,	3,	8 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
-			paramGroup->addChild(new TexImage3DParamsCase(m_context, cases[ndx].name, "",
-														  cases[ndx].format,
-														  cases[ndx].width,
-														  cases[ndx].height,
-														  cases[ndx].depth,
-														  cases[ndx].imageHeight,
-														  cases[ndx].rowLength,
-														  cases[ndx].skipImages,
-														  cases[ndx].skipRows,
-														  cases[ndx].skipPixels,
-														  cases[ndx].alignment));
-	}
-
-	// glTexImage3D() pbo cases.
-	{
-		tcu::TestCaseGroup* pboGroup = new tcu::TestCaseGroup(m_testCtx, "teximage3d_pbo", "glTexImage3D() from PBO");
-		addChild(pboGroup);
-
-		// Parameter cases
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			depth;
-			int			imageHeight;
-			int			rowLength;
-			int			skipImages;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-			int			offset;
-		} parameterCases[] =
-		{
-			{ "rgb8_offset",		GL_RGB8,	23,	19,	8,	0,	0,	0,	0,	0,	1,	67 },
-			{ "rgb8_alignment",		GL_RGB8,	23,	19,	8,	0,	0,	0,	0,	0,	2,	0 },
-			{ "rgb8_image_height",	GL_RGB8,	23,	19,	8,	26,	0,	0,	0,	0,	4,	0 },
-			{ "rgb8_row_length",	GL_RGB8,	23,	19,	8,	0,	27,	0,	0,	0,	4,	0 },
-			{ "rgb8_skip_images",	GL_RGB8,	23,	19,	8,	0,	0,	3,	0,	0,	4,	0 },
-			{ "rgb8_skip_rows",		GL_RGB8,	23,	19,	8,	22,	0,	0,	3,	0,	4,	0 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	23,	19,	8,	0,	25,	0,	0,	2,	4,	0 }
-		};
-
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const string	fmtName		= colorFormats[formatNdx].name;
-			const deUint32	format		= colorFormats[formatNdx].internalFormat;
-			const int		tex3DWidth	= 11;
-			const int		tex3DHeight	= 20;
-			const int		tex3DDepth	= 8;
-
-			pboGroup->addChild(new TexImage2DArrayBufferCase	(m_context, (fmtName + "_2d_array").c_str(),	"", format, tex3DWidth, tex3DHeight, tex3DDepth, 0, 0, 0, 0, 0, 4, 0));
-			pboGroup->addChild(new TexImage3DBufferCase			(m_context, (fmtName + "_3d").c_str(),			"", format, tex3DWidth, tex3DHeight, tex3DDepth, 0, 0, 0, 0, 0, 4, 0));
-		}
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(parameterCases); ndx++)
-		{
-			pboGroup->addChild(new TexImage2DArrayBufferCase(m_context, (string(parameterCases[ndx].name) + "_2d_array").c_str(), "",
-														parameterCases[ndx].format,
-														parameterCases[ndx].width,
-														parameterCases[ndx].depth,
-														parameterCases[ndx].height,
-														parameterCases[ndx].imageHeight,
-														parameterCases[ndx].rowLength,
-														parameterCases[ndx].skipImages,
-														parameterCases[ndx].skipRows,
-														parameterCases[ndx].skipPixels,
-														parameterCases[ndx].alignment,
-														parameterCases[ndx].offset));
-			pboGroup->addChild(new TexImage3DBufferCase(m_context, (string(parameterCases[ndx].name) + "_3d").c_str(), "",
-														parameterCases[ndx].format,
-														parameterCases[ndx].width,
-														parameterCases[ndx].depth,
-														parameterCases[ndx].height,
-														parameterCases[ndx].imageHeight,
-														parameterCases[ndx].rowLength,
-														parameterCases[ndx].skipImages,
-														parameterCases[ndx].skipRows,
-														parameterCases[ndx].skipPixels,
-														parameterCases[ndx].alignment,
-														parameterCases[ndx].offset));
-		}
+		basicTexSubImageGroup->addChild(new BasicTexSubImage3DCase(context, (string(fmtName) + "_3d").c_str(), "", format, tex3DWidth, tex3DHeight, tex3DDepth));
 	}
+}
 
-	// glTexImage3D() depth cases.
+// glTexSubImage3D() unpack params cases.
+static void createTexSubImage3DUnpackParamsTests (Context& context, tcu::TestCaseGroup* paramGroup)
+{
+	static const struct
 	{
-		tcu::TestCaseGroup* shadow3dGroup = new tcu::TestCaseGroup(m_testCtx, "teximage3d_depth", "glTexImage3D() with depth or depth/stencil format");
-		addChild(shadow3dGroup);
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			depth;
+		int			subX;
+		int			subY;
+		int			subZ;
+		int			subW;
+		int			subH;
+		int			subD;
+		int			imageHeight;
+		int			rowLength;
+		int			skipImages;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+	} cases[] =
+	{
+		{ "rgb8_image_height",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	26,	0,	0,	0,	0,	4 },
+		{ "rgb8_row_length",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	27,	0,	0,	0,	4 },
+		{ "rgb8_skip_images",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	3,	0,	0,	4 },
+		{ "rgb8_skip_rows",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	22,	0,	0,	3,	0,	4 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	25,	0,	0,	2,	4 },
+		{ "r8_complex1",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	1 },
+		{ "r8_complex2",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	2 },
+		{ "r8_complex3",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	4 },
+		{ "r8_complex4",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	8 },
+		{ "rgba8_complex1",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	0,	0,	8 },
+		{ "rgba8_complex2",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	0,	8 },
+		{ "rgba8_complex3",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	0,	3,	8 },
+		{ "rgba8_complex4",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	3,	8 },
+		{ "rgba32f_complex",	GL_RGBA32F,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	3,	8 }
+	};
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int	tex3DWidth	= 32;
-			const int	tex3DHeight	= 64;
-			const int	tex3DDepth	= 8;
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
+		paramGroup->addChild(new TexSubImage3DParamsCase(context, cases[ndx].name, "",
+														 cases[ndx].format,
+														 cases[ndx].width,
+														 cases[ndx].height,
+														 cases[ndx].depth,
+														 cases[ndx].subX,
+														 cases[ndx].subY,
+														 cases[ndx].subZ,
+														 cases[ndx].subW,
+														 cases[ndx].subH,
+														 cases[ndx].subD,
+														 cases[ndx].imageHeight,
+														 cases[ndx].rowLength,
+														 cases[ndx].skipImages,
+														 cases[ndx].skipRows,
+														 cases[ndx].skipPixels,
+														 cases[ndx].alignment));
+}
 
-			shadow3dGroup->addChild(new TexImage2DArrayDepthCase(m_context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex3DWidth, tex3DHeight, tex3DDepth));
-		}
+// glTexSubImage3D() PBO cases.
+static void createTexSubImage3DPboTests (Context& context, tcu::TestCaseGroup* pboGroup)
+{
+	static const struct
+	{
+		const char*	name;
+		deUint32	format;
+		int			width;
+		int			height;
+		int			depth;
+		int			subX;
+		int			subY;
+		int			subZ;
+		int			subW;
+		int			subH;
+		int			subD;
+		int			imageHeight;
+		int			rowLength;
+		int			skipImages;
+		int			skipRows;
+		int			skipPixels;
+		int			alignment;
+		int			offset;
+	} paramCases[] =
+	{
+		{ "rgb8_offset",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	0,	0,	0,	4,	67 },
+		{ "rgb8_image_height",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	26,	0,	0,	0,	0,	4,	0 },
+		{ "rgb8_row_length",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	27,	0,	0,	0,	4,	0 },
+		{ "rgb8_skip_images",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	3,	0,	0,	4,	0 },
+		{ "rgb8_skip_rows",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	22,	0,	0,	3,	0,	4,	0 },
+		{ "rgb8_skip_pixels",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	25,	0,	0,	2,	4,	0 }
+	};
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(colorFormats); ndx++)
+	{
+		pboGroup->addChild(new TexSubImage2DArrayBufferCase(context, (std::string(colorFormats[ndx].name) + "_2d_array").c_str(), "",
+													   colorFormats[ndx].internalFormat,
+													   26,	// Width
+													   25,	// Height
+													   10,	// Depth
+													   1,	// Sub X
+													   2,	// Sub Y
+													   0,	// Sub Z
+													   23,	// Sub W
+													   19,	// Sub H
+													   8,	// Sub D
+													   0,	// Image height
+													   0,	// Row length
+													   0,	// Skip images
+													   0,	// Skip rows
+													   0,	// Skip pixels
+													   4,	// Alignment
+													   0	/* offset */));
+		pboGroup->addChild(new TexSubImage3DBufferCase(context, (std::string(colorFormats[ndx].name) + "_3d").c_str(), "",
+													   colorFormats[ndx].internalFormat,
+													   26,	// Width
+													   25,	// Height
+													   10,	// Depth
+													   1,	// Sub X
+													   2,	// Sub Y
+													   0,	// Sub Z
+													   23,	// Sub W
+													   19,	// Sub H
+													   8,	// Sub D
+													   0,	// Image height
+													   0,	// Row length
+													   0,	// Skip images
+													   0,	// Skip rows
+													   0,	// Skip pixels
+													   4,	// Alignment
+													   0	/* offset */));
+	}
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(paramCases); ndx++)
+	{
+		pboGroup->addChild(new TexSubImage2DArrayBufferCase(context, (std::string(paramCases[ndx].name) + "_2d_array").c_str(), "",
+													   paramCases[ndx].format,
+													   paramCases[ndx].width,
+													   paramCases[ndx].height,
+													   paramCases[ndx].depth,
+													   paramCases[ndx].subX,
+													   paramCases[ndx].subY,
+													   paramCases[ndx].subZ,
+													   paramCases[ndx].subW,
+													   paramCases[ndx].subH,
+													   paramCases[ndx].subD,
+													   paramCases[ndx].imageHeight,
+													   paramCases[ndx].rowLength,
+													   paramCases[ndx].skipImages,
+													   paramCases[ndx].skipRows,
+													   paramCases[ndx].skipPixels,
+													   paramCases[ndx].alignment,
+													   paramCases[ndx].offset));
+		pboGroup->addChild(new TexSubImage3DBufferCase(context, (std::string(paramCases[ndx].name) + "_3d").c_str(), "",
+													   paramCases[ndx].format,
+													   paramCases[ndx].width,
+													   paramCases[ndx].height,
+													   paramCases[ndx].depth,
+													   paramCases[ndx].subX,
+													   paramCases[ndx].subY,
+													   paramCases[ndx].subZ,
+													   paramCases[ndx].subW,
+													   paramCases[ndx].subH,
+													   paramCases[ndx].subD,
+													   paramCases[ndx].imageHeight,
+													   paramCases[ndx].rowLength,
+													   paramCases[ndx].skipImages,
+													   paramCases[ndx].skipRows,
+													   paramCases[ndx].skipPixels,
+													   paramCases[ndx].alignment,
+													   paramCases[ndx].offset));
 	}
+}
 
-	// glTexImage3D() depth cases with pbo.
+// glTexSubImage3D() depth cases.
+static void createTexSubImage3DDepthTests (Context& context, tcu::TestCaseGroup* shadow3dGroup)
+{
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
 	{
-		tcu::TestCaseGroup* shadow3dGroup = new tcu::TestCaseGroup(m_testCtx, "teximage3d_depth_pbo", "glTexImage3D() with depth or depth/stencil format with pbo");
-		addChild(shadow3dGroup);
+		const int	tex2DArrayWidth		= 57;
+		const int	tex2DArrayHeight	= 44;
+		const int	tex2DArrayLevels	= 5;
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int	tex3DWidth	= 32;
-			const int	tex3DHeight	= 64;
-			const int	tex3DDepth	= 8;
+		shadow3dGroup->addChild(new TexSubImage2DArrayDepthCase(context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLevels));
+	}
+}
 
-			shadow3dGroup->addChild(new TexImage2DArrayDepthBufferCase(m_context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex3DWidth, tex3DHeight, tex3DDepth));
-		}
+// glTexStorage2D() cases.
+static void createTexStorage2DTests (Context& context, tcu::TestCaseGroup* texStorageGroup)
+{
+	// All formats.
+	tcu::TestCaseGroup* formatGroup = new tcu::TestCaseGroup(context.getTestContext(), "format", "glTexStorage2D() with all formats");
+	texStorageGroup->addChild(formatGroup);
+
+	// Color formats.
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
+	{
+		const char*	fmtName			= colorFormats[formatNdx].name;
+		deUint32	internalFormat	= colorFormats[formatNdx].internalFormat;
+		const int	tex2DWidth		= 117;
+		const int	tex2DHeight		= 97;
+		int			tex2DLevels		= maxLevelCount(tex2DWidth, tex2DHeight);
+		const int	cubeSize		= 57;
+		int			cubeLevels		= maxLevelCount(cubeSize, cubeSize);
+
+		formatGroup->addChild(new BasicTexStorage2DCase		(context, (string(fmtName) + "_2d").c_str(),		"", internalFormat, tex2DWidth, tex2DHeight, tex2DLevels));
+		formatGroup->addChild(new BasicTexStorageCubeCase	(context, (string(fmtName) + "_cube").c_str(),	"", internalFormat, cubeSize, cubeLevels));
 	}
 
-	// Basic TexSubImage3D usage.
+	// Depth / stencil formats.
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(depthStencilFormats); formatNdx++)
 	{
-		tcu::TestCaseGroup* basicTexSubImageGroup = new tcu::TestCaseGroup(m_testCtx, "basic_texsubimage3d", "Basic glTexSubImage3D() usage");
-		addChild(basicTexSubImageGroup);
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName		= colorFormats[formatNdx].name;
-			deUint32	format		= colorFormats[formatNdx].internalFormat;
-			const int	tex3DWidth	= 32;
-			const int	tex3DHeight	= 64;
-			const int	tex3DDepth	= 8;
+		const char*	fmtName			= depthStencilFormats[formatNdx].name;
+		deUint32	internalFormat	= depthStencilFormats[formatNdx].internalFormat;
+		const int	tex2DWidth		= 117;
+		const int	tex2DHeight		= 97;
+		int			tex2DLevels		= maxLevelCount(tex2DWidth, tex2DHeight);
+		const int	cubeSize		= 57;
+		int			cubeLevels		= maxLevelCount(cubeSize, cubeSize);
 
-			basicTexSubImageGroup->addChild(new BasicTexSubImage3DCase(m_context, (string(fmtName) + "_3d").c_str(), "", format, tex3DWidth, tex3DHeight, tex3DDepth));
-		}
+		formatGroup->addChild(new BasicTexStorage2DCase		(context, (string(fmtName) + "_2d").c_str(),		"", internalFormat, tex2DWidth, tex2DHeight, tex2DLevels));
+		formatGroup->addChild(new BasicTexStorageCubeCase	(context, (string(fmtName) + "_cube").c_str(),	"", internalFormat, cubeSize, cubeLevels));
 	}
 
-	// glTexSubImage3D() unpack params cases.
+	// Sizes.
+	static const struct
 	{
-		tcu::TestCaseGroup* paramGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage3d_unpack_params", "glTexSubImage3D() unpack parameters");
-		addChild(paramGroup);
+		int				width;
+		int				height;
+		int				levels;
+	} tex2DSizes[] =
+	{
+		//	W	H	L
+		{	1,	1,	1 },
+		{	2,	2,	2 },
+		{	64,	32,	7 },
+		{	32,	64,	4 },
+		{	57,	63,	1 },
+		{	57,	63,	2 },
+		{	57,	63,	6 }
+	};
+	static const struct
+	{
+		int		size;
+		int		levels;
+	} cubeSizes[] =
+	{
+		//	S	L
+		{	1,	1 },
+		{	2,	2 },
+		{	57,	1 },
+		{	57,	2 },
+		{	57,	6 },
+		{	64,	4 },
+		{	64,	7 },
+	};
 
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			depth;
-			int			subX;
-			int			subY;
-			int			subZ;
-			int			subW;
-			int			subH;
-			int			subD;
-			int			imageHeight;
-			int			rowLength;
-			int			skipImages;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-		} cases[] =
-		{
-			{ "rgb8_image_height",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	26,	0,	0,	0,	0,	4 },
-			{ "rgb8_row_length",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	27,	0,	0,	0,	4 },
-			{ "rgb8_skip_images",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	3,	0,	0,	4 },
-			{ "rgb8_skip_rows",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	22,	0,	0,	3,	0,	4 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	25,	0,	0,	2,	4 },
-			{ "r8_complex1",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	1 },
-			{ "r8_complex2",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	2 },
-			{ "r8_complex3",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	4 },
-			{ "r8_complex4",		GL_R8,		15,	20,	11,	1,	1,	0,	13, 17, 11,	23,	15,	2,	3,	1,	8 },
-			{ "rgba8_complex1",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	0,	0,	8 },
-			{ "rgba8_complex2",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	0,	8 },
-			{ "rgba8_complex3",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	0,	3,	8 },
-			{ "rgba8_complex4",		GL_RGBA8,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	3,	8 },
-			{ "rgba32f_complex",	GL_RGBA32F,	15,	25,	10,	0,	5,	1,	11,	20,	8,	25,	14,	0,	2,	3,	8 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cases); ndx++)
-			paramGroup->addChild(new TexSubImage3DParamsCase(m_context, cases[ndx].name, "",
-															 cases[ndx].format,
-															 cases[ndx].width,
-															 cases[ndx].height,
-															 cases[ndx].depth,
-															 cases[ndx].subX,
-															 cases[ndx].subY,
-															 cases[ndx].subZ,
-															 cases[ndx].subW,
-															 cases[ndx].subH,
-															 cases[ndx].subD,
-															 cases[ndx].imageHeight,
-															 cases[ndx].rowLength,
-															 cases[ndx].skipImages,
-															 cases[ndx].skipRows,
-															 cases[ndx].skipPixels,
-															 cases[ndx].alignment));
-	}
-
-	// glTexSubImage3D() PBO cases.
-	{
-		tcu::TestCaseGroup* pboGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage3d_pbo", "glTexSubImage3D() pixel buffer object tests");
-		addChild(pboGroup);
-
-		static const struct
-		{
-			const char*	name;
-			deUint32	format;
-			int			width;
-			int			height;
-			int			depth;
-			int			subX;
-			int			subY;
-			int			subZ;
-			int			subW;
-			int			subH;
-			int			subD;
-			int			imageHeight;
-			int			rowLength;
-			int			skipImages;
-			int			skipRows;
-			int			skipPixels;
-			int			alignment;
-			int			offset;
-		} paramCases[] =
-		{
-			{ "rgb8_offset",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	0,	0,	0,	4,	67 },
-			{ "rgb8_image_height",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	26,	0,	0,	0,	0,	4,	0 },
-			{ "rgb8_row_length",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	27,	0,	0,	0,	4,	0 },
-			{ "rgb8_skip_images",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	0,	3,	0,	0,	4,	0 },
-			{ "rgb8_skip_rows",		GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	22,	0,	0,	3,	0,	4,	0 },
-			{ "rgb8_skip_pixels",	GL_RGB8,	26, 25, 10,	1,	2,	1,	23,	19,	8,	0,	25,	0,	0,	2,	4,	0 }
-		};
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(colorFormats); ndx++)
-		{
-			pboGroup->addChild(new TexSubImage2DArrayBufferCase(m_context, (std::string(colorFormats[ndx].name) + "_2d_array").c_str(), "",
-														   colorFormats[ndx].internalFormat,
-														   26,	// Width
-														   25,	// Height
-														   10,	// Depth
-														   1,	// Sub X
-														   2,	// Sub Y
-														   0,	// Sub Z
-														   23,	// Sub W
-														   19,	// Sub H
-														   8,	// Sub D
-														   0,	// Image height
-														   0,	// Row length
-														   0,	// Skip images
-														   0,	// Skip rows
-														   0,	// Skip pixels
-														   4,	// Alignment
-														   0	/* offset */));
-			pboGroup->addChild(new TexSubImage3DBufferCase(m_context, (std::string(colorFormats[ndx].name) + "_3d").c_str(), "",
-														   colorFormats[ndx].internalFormat,
-														   26,	// Width
-														   25,	// Height
-														   10,	// Depth
-														   1,	// Sub X
-														   2,	// Sub Y
-														   0,	// Sub Z
-														   23,	// Sub W
-														   19,	// Sub H
-														   8,	// Sub D
-														   0,	// Image height
-														   0,	// Row length
-														   0,	// Skip images
-														   0,	// Skip rows
-														   0,	// Skip pixels
-														   4,	// Alignment
-														   0	/* offset */));
-		}
+	tcu::TestCaseGroup* sizeGroup = new tcu::TestCaseGroup(context.getTestContext(), "size", "glTexStorage2D() with various sizes");
+	texStorageGroup->addChild(sizeGroup);
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(paramCases); ndx++)
-		{
-			pboGroup->addChild(new TexSubImage2DArrayBufferCase(m_context, (std::string(paramCases[ndx].name) + "_2d_array").c_str(), "",
-														   paramCases[ndx].format,
-														   paramCases[ndx].width,
-														   paramCases[ndx].height,
-														   paramCases[ndx].depth,
-														   paramCases[ndx].subX,
-														   paramCases[ndx].subY,
-														   paramCases[ndx].subZ,
-														   paramCases[ndx].subW,
-														   paramCases[ndx].subH,
-														   paramCases[ndx].subD,
-														   paramCases[ndx].imageHeight,
-														   paramCases[ndx].rowLength,
-														   paramCases[ndx].skipImages,
-														   paramCases[ndx].skipRows,
-														   paramCases[ndx].skipPixels,
-														   paramCases[ndx].alignment,
-														   paramCases[ndx].offset));
-			pboGroup->addChild(new TexSubImage3DBufferCase(m_context, (std::string(paramCases[ndx].name) + "_3d").c_str(), "",
-														   paramCases[ndx].format,
-														   paramCases[ndx].width,
-														   paramCases[ndx].height,
-														   paramCases[ndx].depth,
-														   paramCases[ndx].subX,
-														   paramCases[ndx].subY,
-														   paramCases[ndx].subZ,
-														   paramCases[ndx].subW,
-														   paramCases[ndx].subH,
-														   paramCases[ndx].subD,
-														   paramCases[ndx].imageHeight,
-														   paramCases[ndx].rowLength,
-														   paramCases[ndx].skipImages,
-														   paramCases[ndx].skipRows,
-														   paramCases[ndx].skipPixels,
-														   paramCases[ndx].alignment,
-														   paramCases[ndx].offset));
-		}
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex2DSizes); ndx++)
+	{
+		const deUint32		format		= GL_RGBA8;
+		int					width		= tex2DSizes[ndx].width;
+		int					height		= tex2DSizes[ndx].height;
+		int					levels		= tex2DSizes[ndx].levels;
+		string				name		= string("2d_") + de::toString(width) + "x" + de::toString(height) + "_" + de::toString(levels) + "_levels";
+
+		sizeGroup->addChild(new BasicTexStorage2DCase(context, name.c_str(), "", format, width, height, levels));
 	}
 
-	// glTexSubImage3D() depth cases.
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cubeSizes); ndx++)
 	{
-		tcu::TestCaseGroup* shadow3dGroup = new tcu::TestCaseGroup(m_testCtx, "texsubimage3d_depth", "glTexSubImage3D() with depth or depth/stencil format");
-		addChild(shadow3dGroup);
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(depthStencilFormats); ndx++)
-		{
-			const int	tex2DArrayWidth		= 57;
-			const int	tex2DArrayHeight	= 44;
-			const int	tex2DArrayLevels	= 5;
+		const deUint32		format		= GL_RGBA8;
+		int					size		= cubeSizes[ndx].size;
+		int					levels		= cubeSizes[ndx].levels;
+		string				name		= string("cube_") + de::toString(size) + "x" + de::toString(size) + "_" + de::toString(levels) + "_levels";
 
-			shadow3dGroup->addChild(new TexSubImage2DArrayDepthCase(m_context, (std::string(depthStencilFormats[ndx].name) + "_2d_array").c_str(), "", depthStencilFormats[ndx].internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLevels));
-		}
+		sizeGroup->addChild(new BasicTexStorageCubeCase(context, name.c_str(), "", format, size, levels));
 	}
+}
+
+// glTexStorage3D() cases.
+static void createTexStorage3DTests (Context& context, tcu::TestCaseGroup* texStorageGroup)
+{
+	// All formats.
+	tcu::TestCaseGroup* formatGroup = new tcu::TestCaseGroup(context.getTestContext(), "format", "glTexStorage3D() with all formats");
+	texStorageGroup->addChild(formatGroup);
 
-	// glTexStorage2D() cases.
+	// Color formats.
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
 	{
-		tcu::TestCaseGroup* texStorageGroup = new tcu::TestCaseGroup(m_testCtx, "texstorage2d", "Basic glTexStorage2D() usage");
-		addChild(texStorageGroup);
+		const char*	fmtName				= colorFormats[formatNdx].name;
+		deUint32	internalFormat		= colorFormats[formatNdx].internalFormat;
+		const int	tex2DArrayWidth		= 57;
+		const int	tex2DArrayHeight	= 13;
+		const int	tex2DArrayLayers	= 7;
+		int			tex2DArrayLevels	= maxLevelCount(tex2DArrayWidth, tex2DArrayHeight);
+		const int	tex3DWidth			= 59;
+		const int	tex3DHeight			= 37;
+		const int	tex3DDepth			= 11;
+		int			tex3DLevels			= maxLevelCount(tex3DWidth, tex3DHeight, tex3DDepth);
 
-		// All formats.
-		tcu::TestCaseGroup* formatGroup = new tcu::TestCaseGroup(m_testCtx, "format", "glTexStorage2D() with all formats");
-		texStorageGroup->addChild(formatGroup);
+		formatGroup->addChild(new BasicTexStorage2DArrayCase	(context, (string(fmtName) + "_2d_array").c_str(),	"", internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLayers, tex2DArrayLevels));
+		formatGroup->addChild(new BasicTexStorage3DCase			(context, (string(fmtName) + "_3d").c_str(),			"", internalFormat, tex3DWidth, tex3DHeight, tex3DDepth, tex3DLevels));
+	}
 
-		// Color formats.
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName			= colorFormats[formatNdx].name;
-			deUint32	internalFormat	= colorFormats[formatNdx].internalFormat;
-			const int	tex2DWidth		= 117;
-			const int	tex2DHeight		= 97;
-			int			tex2DLevels		= maxLevelCount(tex2DWidth, tex2DHeight);
-			const int	cubeSize		= 57;
-			int			cubeLevels		= maxLevelCount(cubeSize, cubeSize);
-
-			formatGroup->addChild(new BasicTexStorage2DCase		(m_context, (string(fmtName) + "_2d").c_str(),		"", internalFormat, tex2DWidth, tex2DHeight, tex2DLevels));
-			formatGroup->addChild(new BasicTexStorageCubeCase	(m_context, (string(fmtName) + "_cube").c_str(),	"", internalFormat, cubeSize, cubeLevels));
-		}
+	// Depth/stencil formats (only 2D texture array is supported).
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(depthStencilFormats); formatNdx++)
+	{
+		const char*	fmtName				= depthStencilFormats[formatNdx].name;
+		deUint32	internalFormat		= depthStencilFormats[formatNdx].internalFormat;
+		const int	tex2DArrayWidth		= 57;
+		const int	tex2DArrayHeight	= 13;
+		const int	tex2DArrayLayers	= 7;
+		int			tex2DArrayLevels	= maxLevelCount(tex2DArrayWidth, tex2DArrayHeight);
 
-		// Depth / stencil formats.
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(depthStencilFormats); formatNdx++)
-		{
-			const char*	fmtName			= depthStencilFormats[formatNdx].name;
-			deUint32	internalFormat	= depthStencilFormats[formatNdx].internalFormat;
-			const int	tex2DWidth		= 117;
-			const int	tex2DHeight		= 97;
-			int			tex2DLevels		= maxLevelCount(tex2DWidth, tex2DHeight);
-			const int	cubeSize		= 57;
-			int			cubeLevels		= maxLevelCount(cubeSize, cubeSize);
-
-			formatGroup->addChild(new BasicTexStorage2DCase		(m_context, (string(fmtName) + "_2d").c_str(),		"", internalFormat, tex2DWidth, tex2DHeight, tex2DLevels));
-			formatGroup->addChild(new BasicTexStorageCubeCase	(m_context, (string(fmtName) + "_cube").c_str(),	"", internalFormat, cubeSize, cubeLevels));
-		}
+		formatGroup->addChild(new BasicTexStorage2DArrayCase	(context, (string(fmtName) + "_2d_array").c_str(),	"", internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLayers, tex2DArrayLevels));
+	}
 
-		// Sizes.
-		static const struct
-		{
-			int				width;
-			int				height;
-			int				levels;
-		} tex2DSizes[] =
-		{
-			//	W	H	L
-			{	1,	1,	1 },
-			{	2,	2,	2 },
-			{	64,	32,	7 },
-			{	32,	64,	4 },
-			{	57,	63,	1 },
-			{	57,	63,	2 },
-			{	57,	63,	6 }
-		};
-		static const struct
-		{
-			int		size;
-			int		levels;
-		} cubeSizes[] =
-		{
-			//	S	L
-			{	1,	1 },
-			{	2,	2 },
-			{	57,	1 },
-			{	57,	2 },
-			{	57,	6 },
-			{	64,	4 },
-			{	64,	7 },
-		};
-
-		tcu::TestCaseGroup* sizeGroup = new tcu::TestCaseGroup(m_testCtx, "size", "glTexStorage2D() with various sizes");
-		texStorageGroup->addChild(sizeGroup);
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex2DSizes); ndx++)
-		{
-			const deUint32		format		= GL_RGBA8;
-			int					width		= tex2DSizes[ndx].width;
-			int					height		= tex2DSizes[ndx].height;
-			int					levels		= tex2DSizes[ndx].levels;
-			string				name		= string("2d_") + de::toString(width) + "x" + de::toString(height) + "_" + de::toString(levels) + "_levels";
+	// Sizes.
+	static const struct
+	{
+		int				width;
+		int				height;
+		int				layers;
+		int				levels;
+	} tex2DArraySizes[] =
+	{
+		//	W	H	La	Le
+		{	1,	1,	1,	1 },
+		{	2,	2,	2,	2 },
+		{	64,	32,	3,	7 },
+		{	32,	64,	3,	4 },
+		{	57,	63,	5,	1 },
+		{	57,	63,	5,	2 },
+		{	57,	63,	5,	6 }
+	};
+	static const struct
+	{
+		int				width;
+		int				height;
+		int				depth;
+		int				levels;
+	} tex3DSizes[] =
+	{
+		//	W	H	D	L
+		{	1,	1,	1,	1 },
+		{	2,	2,	2,	2 },
+		{	64,	32,	16,	7 },
+		{	32,	64,	16,	4 },
+		{	32,	16,	64,	4 },
+		{	57,	63,	11,	1 },
+		{	57,	63,	11,	2 },
+		{	57,	63,	11,	6 }
+	};
 
-			sizeGroup->addChild(new BasicTexStorage2DCase(m_context, name.c_str(), "", format, width, height, levels));
-		}
+	tcu::TestCaseGroup* sizeGroup = new tcu::TestCaseGroup(context.getTestContext(), "size", "glTexStorage2D() with various sizes");
+	texStorageGroup->addChild(sizeGroup);
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(cubeSizes); ndx++)
-		{
-			const deUint32		format		= GL_RGBA8;
-			int					size		= cubeSizes[ndx].size;
-			int					levels		= cubeSizes[ndx].levels;
-			string				name		= string("cube_") + de::toString(size) + "x" + de::toString(size) + "_" + de::toString(levels) + "_levels";
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex2DArraySizes); ndx++)
+	{
+		const deUint32		format		= GL_RGBA8;
+		int					width		= tex2DArraySizes[ndx].width;
+		int					height		= tex2DArraySizes[ndx].height;
+		int					layers		= tex2DArraySizes[ndx].layers;
+		int					levels		= tex2DArraySizes[ndx].levels;
+		string				name		= string("2d_array_") + de::toString(width) + "x" + de::toString(height) + "x" + de::toString(layers) + "_" + de::toString(levels) + "_levels";
 
-			sizeGroup->addChild(new BasicTexStorageCubeCase(m_context, name.c_str(), "", format, size, levels));
-		}
+		sizeGroup->addChild(new BasicTexStorage2DArrayCase(context, name.c_str(), "", format, width, height, layers, levels));
 	}
 
-	// glTexStorage3D() cases.
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex3DSizes); ndx++)
 	{
-		tcu::TestCaseGroup* texStorageGroup = new tcu::TestCaseGroup(m_testCtx, "texstorage3d", "Basic glTexStorage3D() usage");
-		addChild(texStorageGroup);
+		const deUint32		format		= GL_RGBA8;
+		int					width		= tex3DSizes[ndx].width;
+		int					height		= tex3DSizes[ndx].height;
+		int					depth		= tex3DSizes[ndx].depth;
+		int					levels		= tex3DSizes[ndx].levels;
+		string				name		= string("3d_") + de::toString(width) + "x" + de::toString(height) + "x" + de::toString(depth) + "_" + de::toString(levels) + "_levels";
 
-		// All formats.
-		tcu::TestCaseGroup* formatGroup = new tcu::TestCaseGroup(m_testCtx, "format", "glTexStorage3D() with all formats");
-		texStorageGroup->addChild(formatGroup);
+		sizeGroup->addChild(new BasicTexStorage3DCase(context, name.c_str(), "", format, width, height, depth, levels));
+	}
+}
 
-		// Color formats.
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(colorFormats); formatNdx++)
-		{
-			const char*	fmtName				= colorFormats[formatNdx].name;
-			deUint32	internalFormat		= colorFormats[formatNdx].internalFormat;
-			const int	tex2DArrayWidth		= 57;
-			const int	tex2DArrayHeight	= 13;
-			const int	tex2DArrayLayers	= 7;
-			int			tex2DArrayLevels	= maxLevelCount(tex2DArrayWidth, tex2DArrayHeight);
-			const int	tex3DWidth			= 59;
-			const int	tex3DHeight			= 37;
-			const int	tex3DDepth			= 11;
-			int			tex3DLevels			= maxLevelCount(tex3DWidth, tex3DHeight, tex3DDepth);
-
-			formatGroup->addChild(new BasicTexStorage2DArrayCase	(m_context, (string(fmtName) + "_2d_array").c_str(),	"", internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLayers, tex2DArrayLevels));
-			formatGroup->addChild(new BasicTexStorage3DCase			(m_context, (string(fmtName) + "_3d").c_str(),			"", internalFormat, tex3DWidth, tex3DHeight, tex3DDepth, tex3DLevels));
-		}
+typedef void (*CreateTestsFunc) (Context& context, tcu::TestCaseGroup* group);
 
-		// Depth/stencil formats (only 2D texture array is supported).
-		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(depthStencilFormats); formatNdx++)
-		{
-			const char*	fmtName				= depthStencilFormats[formatNdx].name;
-			deUint32	internalFormat		= depthStencilFormats[formatNdx].internalFormat;
-			const int	tex2DArrayWidth		= 57;
-			const int	tex2DArrayHeight	= 13;
-			const int	tex2DArrayLayers	= 7;
-			int			tex2DArrayLevels	= maxLevelCount(tex2DArrayWidth, tex2DArrayHeight);
-
-			formatGroup->addChild(new BasicTexStorage2DArrayCase	(m_context, (string(fmtName) + "_2d_array").c_str(),	"", internalFormat, tex2DArrayWidth, tex2DArrayHeight, tex2DArrayLayers, tex2DArrayLevels));
-		}
+//! Functor for creating group children with tcu::createLazyTestCaseGroup()
+class CreateTests
+{
+public:
+					CreateTests		(Context& context, CreateTestsFunc createTests) : m_context(context), m_createTests(createTests) {}
+	void			operator()		(tcu::TestCaseGroup* group) const { m_createTests(m_context, group); }
 
-		// Sizes.
-		static const struct
-		{
-			int				width;
-			int				height;
-			int				layers;
-			int				levels;
-		} tex2DArraySizes[] =
-		{
-			//	W	H	La	Le
-			{	1,	1,	1,	1 },
-			{	2,	2,	2,	2 },
-			{	64,	32,	3,	7 },
-			{	32,	64,	3,	4 },
-			{	57,	63,	5,	1 },
-			{	57,	63,	5,	2 },
-			{	57,	63,	5,	6 }
-		};
-		static const struct
-		{
-			int				width;
-			int				height;
-			int				depth;
-			int				levels;
-		} tex3DSizes[] =
-		{
-			//	W	H	D	L
-			{	1,	1,	1,	1 },
-			{	2,	2,	2,	2 },
-			{	64,	32,	16,	7 },
-			{	32,	64,	16,	4 },
-			{	32,	16,	64,	4 },
-			{	57,	63,	11,	1 },
-			{	57,	63,	11,	2 },
-			{	57,	63,	11,	6 }
-		};
-
-		tcu::TestCaseGroup* sizeGroup = new tcu::TestCaseGroup(m_testCtx, "size", "glTexStorage2D() with various sizes");
-		texStorageGroup->addChild(sizeGroup);
-
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex2DArraySizes); ndx++)
-		{
-			const deUint32		format		= GL_RGBA8;
-			int					width		= tex2DArraySizes[ndx].width;
-			int					height		= tex2DArraySizes[ndx].height;
-			int					layers		= tex2DArraySizes[ndx].layers;
-			int					levels		= tex2DArraySizes[ndx].levels;
-			string				name		= string("2d_array_") + de::toString(width) + "x" + de::toString(height) + "x" + de::toString(layers) + "_" + de::toString(levels) + "_levels";
-
-			sizeGroup->addChild(new BasicTexStorage2DArrayCase(m_context, name.c_str(), "", format, width, height, layers, levels));
-		}
+private:
+	Context&		m_context;
+	CreateTestsFunc	m_createTests;
+};
 
-		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(tex3DSizes); ndx++)
-		{
-			const deUint32		format		= GL_RGBA8;
-			int					width		= tex3DSizes[ndx].width;
-			int					height		= tex3DSizes[ndx].height;
-			int					depth		= tex3DSizes[ndx].depth;
-			int					levels		= tex3DSizes[ndx].levels;
-			string				name		= string("3d_") + de::toString(width) + "x" + de::toString(height) + "x" + de::toString(depth) + "_" + de::toString(levels) + "_levels";
-
-			sizeGroup->addChild(new BasicTexStorage3DCase(m_context, name.c_str(), "", format, width, height, depth, levels));
-		}
-	}
+TextureSpecificationTests::TextureSpecificationTests (Context& context)
+	: TestCaseGroup(context, "specification", "Texture Specification Tests")
+{
+}
+
+TextureSpecificationTests::~TextureSpecificationTests (void)
+{
+}
+
+void TextureSpecificationTests::init (void)
+{
+	// Sub-hierarchies are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_teximage2d", "Basic glTexImage2D() usage", CreateTests(m_context, createBasicTexImage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "random_teximage2d", "Randomized glTexImage2D() usage", CreateTests(m_context, createRandomTexImage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage2d_align", "glTexImage2D() unpack alignment tests", CreateTests(m_context, createTexImage2DAlignTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage2d_unpack_params", "glTexImage2D() pixel transfer mode cases", CreateTests(m_context, createTexImage2DUnpackParamsTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage2d_pbo", "glTexImage2D() from PBO", CreateTests(m_context, createTexImage2DPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage2d_depth", "glTexImage2D() with depth or depth/stencil format", CreateTests(m_context, createTexImage2DDepthTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage2d_depth_pbo", "glTexImage2D() with depth or depth/stencil format with pbo", CreateTests(m_context, createTexImage2DDepthPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_texsubimage2d", "Basic glTexSubImage2D() usage", CreateTests(m_context, createBasicTexSubImage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage2d_empty_tex", "glTexSubImage2D() to texture that has storage but no data", CreateTests(m_context, createTexSubImage2DEmptyTexTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage2d_align", "glTexSubImage2D() unpack alignment tests", CreateTests(m_context, createTexSubImage2DAlignTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage2d_unpack_params", "glTexSubImage2D() pixel transfer mode cases", CreateTests(m_context, createTexSubImage2DUnpackParamsTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage2d_pbo", "glTexSubImage2D() pixel buffer object tests", CreateTests(m_context, createTexSubImage2DPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage2d_depth", "glTexSubImage2D() with depth or depth/stencil format", CreateTests(m_context, createTexSubImage2DDepthTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_copyteximage2d", "Basic glCopyTexImage2D() usage", CreateTests(m_context, createBasicCopyTexImage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_copytexsubimage2d", "Basic glCopyTexSubImage2D() usage", CreateTests(m_context, createBasicCopyTexSubImage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_teximage3d", "Basic glTexImage3D() usage", CreateTests(m_context, createBasicTexImage3DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage3d_unpack_params", "glTexImage3D() unpack parameters", CreateTests(m_context, createTexImage3DUnpackParamsTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage3d_pbo", "glTexImage3D() from PBO", CreateTests(m_context, createTexImage3DPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage3d_depth", "glTexImage3D() with depth or depth/stencil format", CreateTests(m_context, createTexImage3DDepthTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "teximage3d_depth_pbo", "glTexImage3D() with depth or depth/stencil format with pbo", CreateTests(m_context, createTexImage3DDepthPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "basic_texsubimage3d", "Basic glTexSubImage3D() usage", CreateTests(m_context, createBasicTexSubImage3DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage3d_unpack_params", "glTexSubImage3D() unpack parameters", CreateTests(m_context, createTexSubImage3DUnpackParamsTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage3d_pbo", "glTexSubImage3D() pixel buffer object tests", CreateTests(m_context, createTexSubImage3DPboTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texsubimage3d_depth", "glTexSubImage3D() with depth or depth/stencil format", CreateTests(m_context, createTexSubImage3DDepthTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texstorage2d", "Basic glTexStorage2D() usage", CreateTests(m_context, createTexStorage2DTests)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "texstorage3d", "Basic glTexStorage3D() usage", CreateTests(m_context, createTexStorage3DTests)));
 }
 
 } // Functional
@@ -792,7 +792,7 @@ void renderRefQuad (const BlendState&				preCommonBlendState,
 					const vector<DrawBufferInfo>&	drawBuffers,
 					vector<TextureLevel>&			refRenderbuffers)
 {
-	const rr::Renderer			renderer;
+	rr::Renderer				renderer;
 	const rr::PrimitiveList		primitives		(rr::PRIMITIVETYPE_TRIANGLES, 6, 0);
 	const rr::VertexAttrib		vertexAttribs[] =
 	{
@@ -4580,113 +4580,109 @@ static void generateUniformCaseRandomCases (Context& context, tcu::TestCaseGroup
 		generateUniformRandomCase(context, targetGroup, numBasicCases + ndx, true);
 }
 
-class UniformInterfaceTestGroup : public TestCaseGroup
+typedef void (*CreateTestsFunc) (Context& context, tcu::TestCaseGroup* group);
+
+//! Functor for creating group children with tcu::createLazyTestCaseGroup()
+class CreateTests
 {
 public:
-			UniformInterfaceTestGroup	(Context& context);
-	void	init						(void);
+					CreateTests		(Context& context, CreateTestsFunc createTests) : m_context(context), m_createTests(createTests) {}
+	void			operator()		(tcu::TestCaseGroup* group) const { m_createTests(m_context, group); }
+
+private:
+	Context&		m_context;
+	CreateTestsFunc	m_createTests;
 };
 
-UniformInterfaceTestGroup::UniformInterfaceTestGroup (Context& context)
-	: TestCaseGroup(context, "uniform", "Uniform interace")
+static ResourceDefinition::Node::SharedPtr createComputeShader (void)
 {
+	const ResourceDefinition::Node::SharedPtr program (new ResourceDefinition::Program());
+	return ResourceDefinition::Node::SharedPtr(new ResourceDefinition::Shader(program, glu::SHADERTYPE_COMPUTE, glu::GLSL_VERSION_310_ES));
 }
 
-void UniformInterfaceTestGroup::init (void)
+static void createUniformResourceListCases (Context& context, tcu::TestCaseGroup* group)
 {
-	const ResourceDefinition::Node::SharedPtr	program			(new ResourceDefinition::Program());
-	const ResourceDefinition::Node::SharedPtr	computeShader	(new ResourceDefinition::Shader(program, glu::SHADERTYPE_COMPUTE, glu::GLSL_VERSION_310_ES));
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformResourceListBlockContents);
+}
 
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformResourceListBlockContents);
-	}
+static void createUniformArraySizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformBlockArraySizeContents);
+}
 
-	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Query array size");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockArraySizeContents);
-	}
+static void createUniformArrayStrideCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformBlockArrayStrideContents);
+}
 
-	// .array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_stride", "Query array stride");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockArrayStrideContents);
-	}
+static void createUniformAtomicCounterBufferIndexCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED, generateUniformBlockAtomicCounterBufferIndexContents);
+}
 
-	// .atomic_counter_buffer_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "atomic_counter_buffer_index", "Query atomic counter buffer index");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED, generateUniformBlockAtomicCounterBufferIndexContents);
-	}
+static void createUniformLocationCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED | BLOCKFLAG_UNNAMED, generateUniformBlockLocationContents);
+}
 
-	// .block_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "block_index", "Query block index");
-		addChild(blockGroup);
-		generateUniformBlockBlockIndexContents(m_context, blockGroup);
-	}
+static void createUniformMatrixRowMajorCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformMatrixCaseBlocks(context, createComputeShader(), group, generateUniformMatrixOrderCaseBlockContentCases);
+}
 
-	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Query location");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED | BLOCKFLAG_UNNAMED, generateUniformBlockLocationContents);
-	}
+static void createUniformMatrixStrideCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformMatrixCaseBlocks(context, createComputeShader(), group, generateUniformMatrixStrideCaseBlockContentCases);
+}
 
-	// .matrix_row_major
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "matrix_row_major", "Query matrix row_major");
-		addChild(blockGroup);
-		generateUniformMatrixCaseBlocks(m_context, computeShader, blockGroup, generateUniformMatrixOrderCaseBlockContentCases);
-	}
+static void createUniformNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformBlockNameLengthContents);
+}
 
-	// .matrix_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "matrix_stride", "Query matrix stride");
-		addChild(blockGroup);
-		generateUniformMatrixCaseBlocks(m_context, computeShader, blockGroup, generateUniformMatrixStrideCaseBlockContentCases);
-	}
+static void createUniformOffsetCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformBlockOffsetContents);
+}
 
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Query name length");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockNameLengthContents);
-	}
+static void createUniformReferencedByShaderCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateReferencedByShaderCaseBlocks(context, group, generateUniformReferencedByShaderSingleBlockContentCases);
+}
 
-	// .offset
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "offset", "Query offset");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockOffsetContents);
-	}
+static void createUniformTypeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateUniformCaseBlocks(context, createComputeShader(), group, BLOCKFLAG_ALL, generateUniformBlockTypeContents);
+}
 
-	// .referenced_by_shader
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by_shader", "Query referenced by shader");
-		addChild(blockGroup);
-		generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateUniformReferencedByShaderSingleBlockContentCases);
-	}
+class UniformInterfaceTestGroup : public TestCaseGroup
+{
+public:
+			UniformInterfaceTestGroup	(Context& context);
+	void	init						(void);
+};
 
-	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Query type");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockTypeContents);
-	}
+UniformInterfaceTestGroup::UniformInterfaceTestGroup (Context& context)
+	: TestCaseGroup(context, "uniform", "Uniform interace")
+{
+}
 
-	// .random
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "random", "Random");
-		addChild(blockGroup);
-		generateUniformCaseRandomCases(m_context, blockGroup);
-	}
+void UniformInterfaceTestGroup::init (void)
+{
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createUniformResourceListCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_size", "Query array size", CreateTests(m_context, createUniformArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_stride", "Query array stride", CreateTests(m_context, createUniformArrayStrideCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "atomic_counter_buffer_index", "Query atomic counter buffer index", CreateTests(m_context, createUniformAtomicCounterBufferIndexCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "block_index", "Query block index", CreateTests(m_context, generateUniformBlockBlockIndexContents)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "location", "Query location", CreateTests(m_context, createUniformLocationCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "matrix_row_major", "Query matrix row_major", CreateTests(m_context, createUniformMatrixRowMajorCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "matrix_stride", "Query matrix stride", CreateTests(m_context, createUniformMatrixStrideCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Query name length", CreateTests(m_context, createUniformNameLengthCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "offset", "Query offset", CreateTests(m_context, createUniformOffsetCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "referenced_by_shader", "Query referenced by shader", CreateTests(m_context, createUniformReferencedByShaderCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "type", "Query type", CreateTests(m_context, createUniformTypeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "random", "Random", CreateTests(m_context, generateUniformCaseRandomCases)));
 }
 
 static void generateBufferBackedInterfaceResourceListCase (Context& context, const ResourceDefinition::Node::SharedPtr& targetResource, tcu::TestCaseGroup* const targetGroup, ProgramInterface interface, const char* blockName)
@@ -4838,6 +4834,42 @@ static void generateBufferBackedInterfaceResourceBufferDataSizeCases (Context& c
 	targetGroup->addChild(new InterfaceBlockDataSizeTestCase(context, "block_array",	"Block array",		storage,	InterfaceBlockDataSizeTestCase::CASE_BLOCK_ARRAY));
 }
 
+template <glu::Storage Storage>
+static void createBufferBackedResourceListCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferBackedInterfaceResourceBasicBlockTypes(context, group, Storage, generateBufferBackedInterfaceResourceListCase);
+}
+
+template <glu::Storage Storage>
+static void createBufferBackedActiveVariablesCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferBackedInterfaceResourceActiveVariablesCase(context, group, Storage);
+}
+
+template <glu::Storage Storage>
+static void createBufferBackedBufferBindingCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferBackedInterfaceResourceBufferBindingCases(context, group, Storage);
+}
+
+template <glu::Storage Storage>
+static void createBufferBackedBufferDataSizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferBackedInterfaceResourceBufferDataSizeCases(context, group, Storage);
+}
+
+template <glu::Storage Storage>
+static void createBufferBackedNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferBackedInterfaceResourceBasicBlockTypes(context, group, Storage, generateBufferBackedInterfaceNameLengthCase);
+}
+
+template <glu::Storage Storage>
+static void createBufferBackedReferencedByCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateReferencedByShaderCaseBlocks(context, group, generateBufferBlockReferencedByShaderSingleBlockContentCases<Storage>);
+}
+
 class BufferBackedBlockInterfaceTestGroup : public TestCaseGroup
 {
 public:
@@ -4845,6 +4877,9 @@ public:
 	void				init								(void);
 
 private:
+	template <glu::Storage Storage>
+	void				addBlockGroups						(void);
+
 	static const char*	getGroupName						(glu::Storage storage);
 	static const char*	getGroupDescription					(glu::Storage storage);
 
@@ -4858,55 +4893,26 @@ BufferBackedBlockInterfaceTestGroup::BufferBackedBlockInterfaceTestGroup(Context
 	DE_ASSERT(storage == glu::STORAGE_BUFFER || storage == glu::STORAGE_UNIFORM);
 }
 
-void BufferBackedBlockInterfaceTestGroup::init (void)
+template <glu::Storage Storage>
+void BufferBackedBlockInterfaceTestGroup::addBlockGroups (void)
 {
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBasicBlockTypes(m_context, blockGroup, m_storage, generateBufferBackedInterfaceResourceListCase);
-	}
-
-	// .active_variables
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "active_variables", "Active variables");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceActiveVariablesCase(m_context, blockGroup, m_storage);
-	}
-
-	// .buffer_binding
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "buffer_binding", "Buffer binding");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBufferBindingCases(m_context, blockGroup, m_storage);
-	}
-
-	// .buffer_data_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "buffer_data_size", "Buffer data size");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBufferDataSizeCases(m_context, blockGroup, m_storage);
-	}
-
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBasicBlockTypes(m_context, blockGroup, m_storage, generateBufferBackedInterfaceNameLengthCase);
-	}
-
-	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Referenced by shader");
-		addChild(blockGroup);
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createBufferBackedResourceListCases<Storage>)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "active_variables", "Active variables", CreateTests(m_context, createBufferBackedActiveVariablesCases<Storage>)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "buffer_binding", "Buffer binding", CreateTests(m_context, createBufferBackedBufferBindingCases<Storage>)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "buffer_data_size", "Buffer data size", CreateTests(m_context, createBufferBackedBufferDataSizeCases<Storage>)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Name length", CreateTests(m_context, createBufferBackedNameLengthCases<Storage>)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "referenced_by", "Referenced by shader", CreateTests(m_context, createBufferBackedReferencedByCases<Storage>)));
+}
 
-		if (m_storage == glu::STORAGE_UNIFORM)
-			generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_UNIFORM>);
-		else if (m_storage == glu::STORAGE_BUFFER)
-			generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_BUFFER>);
-		else
-			DE_ASSERT(false);
-	}
+void BufferBackedBlockInterfaceTestGroup::init (void)
+{
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	if (m_storage == glu::STORAGE_UNIFORM)
+		addBlockGroups<glu::STORAGE_UNIFORM>();
+	else if (m_storage == glu::STORAGE_BUFFER)
+		addBlockGroups<glu::STORAGE_BUFFER>();
+	else
+		DE_ASSERT(false);
 }
 
 const char* BufferBackedBlockInterfaceTestGroup::getGroupName (glu::Storage storage)
@@ -5969,6 +5975,41 @@ static void generateProgramOutputTypeBlockContents (Context& context, const Reso
 		DE_ASSERT(false);
 }
 
+static void createProgramInputResourceListCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, true, true, generateProgramInputResourceListBlockContents);
+}
+
+static void createProgramInputArraySizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
+}
+
+static void createProgramInputLocationCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, true, generateProgramInputLocationBlockContents);
+}
+
+static void createProgramInputNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
+}
+
+static void createProgramInputReferencedByCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputReferencedByCases(context, group, glu::STORAGE_IN);
+}
+
+static void createProgramInputTypeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, true, generateProgramInputTypeBlockContents);
+}
+
+static void createProgramInputIsPerPatchCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_IS_PER_PATCH>);
+}
+
 class ProgramInputTestGroup : public TestCaseGroup
 {
 public:
@@ -5983,54 +6024,49 @@ ProgramInputTestGroup::ProgramInputTestGroup (Context& context)
 
 void ProgramInputTestGroup::init (void)
 {
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, true, generateProgramInputResourceListBlockContents);
-	}
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createProgramInputResourceListCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_size", "Array size", CreateTests(m_context, createProgramInputArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "location", "Location", CreateTests(m_context, createProgramInputLocationCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Name length", CreateTests(m_context, createProgramInputNameLengthCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "referenced_by", "Reference by shader", CreateTests(m_context, createProgramInputReferencedByCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "type", "Type", CreateTests(m_context, createProgramInputTypeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "is_per_patch", "Is per patch", CreateTests(m_context, createProgramInputIsPerPatchCases)));
+}
 
-	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Array size");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
+static void createProgramOutputResourceListCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, true, false, generateProgramOutputResourceListBlockContents);
+}
 
-	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Location");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputLocationBlockContents);
-	}
+static void createProgramOutputArraySizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
+}
 
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
+static void createProgramOutputLocationCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, false, generateProgramOutputLocationBlockContents);
+}
 
-	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Reference by shader");
-		addChild(blockGroup);
-		generateProgramInputOutputReferencedByCases(m_context, blockGroup, glu::STORAGE_IN);
-	}
+static void createProgramOutputNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
+}
 
-	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Type");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputTypeBlockContents);
-	}
+static void createProgramOutputReferencedByCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputReferencedByCases(context, group, glu::STORAGE_OUT);
+}
 
-	// .is_per_patch
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "is_per_patch", "Is per patch");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_IS_PER_PATCH>);
-	}
+static void createProgramOutputTypeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, false, generateProgramOutputTypeBlockContents);
+}
+
+static void createProgramOutputIsPerPatchCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateProgramInputOutputShaderCaseBlocks(context, group, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_IS_PER_PATCH>);
 }
 
 class ProgramOutputTestGroup : public TestCaseGroup
@@ -6047,54 +6083,14 @@ ProgramOutputTestGroup::ProgramOutputTestGroup (Context& context)
 
 void ProgramOutputTestGroup::init (void)
 {
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, false, generateProgramOutputResourceListBlockContents);
-	}
-
-	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Array size");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
-
-	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Location");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputLocationBlockContents);
-	}
-
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
-
-	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Reference by shader");
-		addChild(blockGroup);
-		generateProgramInputOutputReferencedByCases(m_context, blockGroup, glu::STORAGE_OUT);
-	}
-
-	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Type");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputTypeBlockContents);
-	}
-
-	// .is_per_patch
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "is_per_patch", "Is per patch");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_IS_PER_PATCH>);
-	}
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createProgramOutputResourceListCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_size", "Array size", CreateTests(m_context, createProgramOutputArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "location", "Location", CreateTests(m_context, createProgramOutputLocationCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Name length", CreateTests(m_context, createProgramOutputNameLengthCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "referenced_by", "Reference by shader", CreateTests(m_context, createProgramOutputReferencedByCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "type", "Type", CreateTests(m_context, createProgramOutputTypeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "is_per_patch", "Is per patch", CreateTests(m_context, createProgramOutputIsPerPatchCases)));
 }
 
 static void generateTransformFeedbackShaderCaseBlocks (Context& context, tcu::TestCaseGroup* targetGroup, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*, bool))
@@ -6345,6 +6341,26 @@ static void generateTransformFeedbackVariableTypeBlockContents (Context& context
 	}
 }
 
+static void createTransformFeedbackResourceListCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateTransformFeedbackShaderCaseBlocks(context, group, generateTransformFeedbackResourceListBlockContents);
+}
+
+static void createTransformFeedbackArraySizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateTransformFeedbackShaderCaseBlocks(context, group, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
+}
+
+static void createTransformFeedbackNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateTransformFeedbackShaderCaseBlocks(context, group, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
+}
+
+static void createTransformFeedbackTypeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateTransformFeedbackShaderCaseBlocks(context, group, generateTransformFeedbackVariableTypeBlockContents);
+}
+
 class TransformFeedbackVaryingTestGroup : public TestCaseGroup
 {
 public:
@@ -6359,33 +6375,11 @@ TransformFeedbackVaryingTestGroup::TransformFeedbackVaryingTestGroup (Context& c
 
 void TransformFeedbackVaryingTestGroup::init (void)
 {
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackResourceListBlockContents);
-	}
-
-	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_size", "Array size");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
-
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "name_length", "Name length");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
-
-	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "type", "Type");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableTypeBlockContents);
-	}
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createTransformFeedbackResourceListCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_size", "Array size", CreateTests(m_context, createTransformFeedbackArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Name length", CreateTests(m_context, createTransformFeedbackNameLengthCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "type", "Type", CreateTests(m_context, createTransformFeedbackTypeCases)));
 }
 
 static void generateBufferVariableBufferCaseBlocks (Context& context, tcu::TestCaseGroup* targetGroup, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*))
@@ -6885,110 +6879,84 @@ static void generateBufferVariableRandomCases (Context& context, tcu::TestCaseGr
 		generateBufferVariableRandomCase(context, targetGroup, numBasicCases + ndx, true);
 }
 
-class BufferVariableTestGroup : public TestCaseGroup
+static void createBufferVariableResourceListCases (Context& context, tcu::TestCaseGroup* group)
 {
-public:
-			BufferVariableTestGroup	(Context& context);
-	void	init								(void);
-};
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableResourceListBlockContentsProxy);
+}
 
-BufferVariableTestGroup::BufferVariableTestGroup (Context& context)
-	: TestCaseGroup(context, "buffer_variable", "Buffer variable")
+static void createBufferVariableArraySizeCases (Context& context, tcu::TestCaseGroup* group)
 {
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
 }
 
-void BufferVariableTestGroup::init (void)
+static void createBufferVariableArrayStrideCases (Context& context, tcu::TestCaseGroup* group)
 {
-	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableResourceListBlockContentsProxy);
-	}
-
-	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_size", "Array size");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
-
-	// .array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_stride", "Array stride");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_STRIDE>);
-	}
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_STRIDE>);
+}
 
-	// .block_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "block_index", "Block index");
-		addChild(blockGroup);
-		generateBufferVariableBlockIndexCases(m_context, blockGroup);
-	}
+static void createBufferVariableIsRowMajorCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableMatrixCaseBlocks(context, group, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_ROW_MAJOR>);
+}
 
-	// .is_row_major
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "is_row_major", "Is row major");
-		addChild(blockGroup);
-		generateBufferVariableMatrixCaseBlocks(m_context, blockGroup, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_ROW_MAJOR>);
-	}
+static void createBufferVariableMatrixStrideCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableMatrixCaseBlocks(context, group, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_STRIDE>);
+}
 
-	// .matrix_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "matrix_stride", "Matrix stride");
-		addChild(blockGroup);
-		generateBufferVariableMatrixCaseBlocks(m_context, blockGroup, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_STRIDE>);
-	}
+static void createBufferVariableNameLengthCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableNameLengthCases);
+}
 
-	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "name_length", "Name length");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableNameLengthCases);
-	}
+static void createBufferVariableOffsetCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableOffsetCases);
+}
 
-	// .offset
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "offset", "Offset");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableOffsetCases);
-	}
+static void createBufferVariableReferencedByCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateReferencedByShaderCaseBlocks(context, group, generateBufferVariableReferencedByBlockContents);
+}
 
-	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "referenced_by", "Referenced by");
-		addChild(blockGroup);
-		generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferVariableReferencedByBlockContents);
-	}
+static void createBufferVariableTopLevelArraySizeCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_SIZE>);
+}
 
-	// .top_level_array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "top_level_array_size", "Top-level array size");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_SIZE>);
-	}
+static void createBufferVariableTopLevelArrayStrideCases (Context& context, tcu::TestCaseGroup* group)
+{
+	generateBufferVariableBufferCaseBlocks(context, group, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_STRIDE>);
+}
 
-	// .top_level_array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "top_level_array_stride", "Top-level array stride");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_STRIDE>);
-	}
+class BufferVariableTestGroup : public TestCaseGroup
+{
+public:
+			BufferVariableTestGroup	(Context& context);
+	void	init								(void);
+};
 
-	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "type", "Type");
-		addChild(blockGroup);
-		generateBufferVariableTypeBlock(m_context, blockGroup);
-	}
+BufferVariableTestGroup::BufferVariableTestGroup (Context& context)
+	: TestCaseGroup(context, "buffer_variable", "Buffer variable")
+{
+}
 
-	// .random
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "random", "Random");
-		addChild(blockGroup);
-		generateBufferVariableRandomCases(m_context, blockGroup);
-	}
+void BufferVariableTestGroup::init (void)
+{
+	// Blocks are created only when entered, so filtered runs don't construct all cases.
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "resource_list", "Resource list", CreateTests(m_context, createBufferVariableResourceListCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_size", "Array size", CreateTests(m_context, createBufferVariableArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "array_stride", "Array stride", CreateTests(m_context, createBufferVariableArrayStrideCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "block_index", "Block index", CreateTests(m_context, generateBufferVariableBlockIndexCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "is_row_major", "Is row major", CreateTests(m_context, createBufferVariableIsRowMajorCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "matrix_stride", "Matrix stride", CreateTests(m_context, createBufferVariableMatrixStrideCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "name_length", "Name length", CreateTests(m_context, createBufferVariableNameLengthCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "offset", "Offset", CreateTests(m_context, createBufferVariableOffsetCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "referenced_by", "Referenced by", CreateTests(m_context, createBufferVariableReferencedByCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "top_level_array_size", "Top-level array size", CreateTests(m_context, createBufferVariableTopLevelArraySizeCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "top_level_array_stride", "Top-level array stride", CreateTests(m_context, createBufferVariableTopLevelArrayStrideCases)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "type", "Type", CreateTests(m_context, generateBufferVariableTypeBlock)));
+	addChild(tcu::createLazyTestCaseGroup(m_testCtx, "random", "Random", CreateTests(m_context, generateBufferVariableRandomCases)));
 }
 
 } // anonymous
@@ -30,6 +30,7 @@
 #include "deFloat16.h"
 #include "deUniquePtr.hpp"
 #include "deArrayUtil.hpp"
+#include "deMemory.h"
 
 #include "tcuTestLog.hpp"
 #include "tcuPixelFormat.hpp"
@@ -1141,6 +1142,8 @@ public:
 
 	void										shadeVertices				(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const;
 	void										shadeFragments				(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const;
+	bool										supportsFragmentBatches		(void) const { return true; }
+	void										shadeFragmentBatch			(const rr::FragmentPacket* packets, const int numPackets, const rr::FragmentBatch& batch, const rr::FragmentShadingContext& context) const;
 
 private:
 	static std::string							genVertexSource				(const glu::RenderContext& ctx, const std::vector<AttributeArray*>& arrays);
@@ -1271,6 +1274,19 @@ void DrawTestShaderProgram::shadeFragments (rr::FragmentPacket* packets, const i
 	}
 }
 
+void DrawTestShaderProgram::shadeFragmentBatch (const rr::FragmentPacket* packets, const int numPackets, const rr::FragmentBatch& batch, const rr::FragmentShadingContext& context) const
+{
+	const int varyingLocColor = 0;
+
+	DE_UNREF(packets);
+	DE_UNREF(numPackets);
+	DE_UNREF(context);
+
+	// Color is passed through as-is, copy whole component arrays
+	for (int compNdx = 0; compNdx < 4; ++compNdx)
+		deMemcpy(batch.getOutput(0, compNdx), batch.getVarying(varyingLocColor, compNdx), batch.numFragments * sizeof(float));
+}
+
 std::string DrawTestShaderProgram::genVertexSource (const glu::RenderContext& ctx, const std::vector<AttributeArray*>& arrays)
 {
 	std::map<std::string, std::string>	params;
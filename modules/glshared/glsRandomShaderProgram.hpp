@@ -46,6 +46,7 @@ public:
 private:
 	virtual void						shadeVertices				(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const;
 	virtual void						shadeFragments				(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const;
+	virtual bool						isThreadSafe				(void) const { return false; } // Shading uses m_execCtx
 
 	void								refreshUniforms				(void) const;
 
@@ -25,6 +25,7 @@
 #include "glsShaderLibraryCase.hpp"
 #include "gluShaderUtil.hpp"
 #include "tcuResource.hpp"
+#include "deUniquePtr.hpp"
 #include "glwEnums.hpp"
 
 #include "deInt32.h"
@@ -92,6 +93,7 @@ public:
 							~ShaderParser			(void);
 
 	vector<tcu::TestNode*>	parse					(const char* input);
+	vector<tcu::TestNode*>	parse					(const char* input, int inputSize);
 
 private:
 	enum Token
@@ -1363,8 +1365,17 @@ void ShaderParser::parseImport (vector<tcu::TestNode*>& shaderNodeList)
 
 vector<tcu::TestNode*> ShaderParser::parse (const char* input)
 {
-	// Initialize parser.
-	m_input			= input;
+	return parse(input, (int)strlen(input));
+}
+
+vector<tcu::TestNode*> ShaderParser::parse (const char* input, int inputSize)
+{
+	// Initialize parser. Tokenizer relies on the NUL terminator of m_input.
+	if (inputSize > 0)
+		m_input.assign(input, (size_t)inputSize);
+	else
+		m_input.clear();
+
 	m_curPtr		= m_input.c_str();
 	m_curToken		= TOKEN_INVALID;
 	m_curTokenStr	= "";
@@ -1418,29 +1429,15 @@ ShaderLibrary::~ShaderLibrary (void)
 
 vector<tcu::TestNode*> ShaderLibrary::loadShaderFile (const char* fileName)
 {
-	tcu::Resource*		resource		= m_testCtx.getArchive().getResource(fileName);
-	std::string			fileDirectory	= getFileDirectory(fileName);
-	std::vector<char>	buf;
+	const de::UniquePtr<tcu::Resource>	resource		(m_testCtx.getArchive().getResource(fileName));
+	const std::string					fileDirectory	= getFileDirectory(fileName);
+	std::vector<deUint8>				storage;
+	const deUint8* const				data			= tcu::getResourceData(*resource, storage);
 
 /*	printf("  loading '%s'\n", fileName);*/
 
-	try
-	{
-		int size = resource->getSize();
-		buf.resize(size + 1);
-		resource->read((deUint8*)&buf[0], size);
-		buf[size] = '\0';
-	}
-	catch (const std::exception&)
-	{
-		delete resource;
-		throw;
-	}
-
-	delete resource;
-
 	sl::ShaderParser parser(m_testCtx, m_renderCtx, m_contextInfo, fileDirectory.c_str());
-	vector<tcu::TestNode*> nodes = parser.parse(&buf[0]);
+	vector<tcu::TestNode*> nodes = parser.parse((const char*)data, resource->getSize());
 
 	return nodes;
 }
@@ -667,7 +667,7 @@ void renderReference (RenderBits					renderBits,
 	const TextureFragmentShader		textureFragmentShader	(texture.getRefTexture());
 	const rr::FragmentShader* const	fragmentShader			= (renderBits & RENDERBITS_AS_FRAGMENT_TEXTURE ? static_cast<const rr::FragmentShader*>(&textureFragmentShader) : &coordFragmmentShader);
 
-	const rr::Renderer				renderer;
+	rr::Renderer					renderer;
 	const rr::RenderState			renderState(rr::ViewportState(rr::WindowRectangle(0, 0, target.getWidth(), target.getHeight())));
 	const rr::RenderTarget			renderTarget(rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(target));
 
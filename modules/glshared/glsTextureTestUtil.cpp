@@ -378,52 +378,52 @@ static float computeProjectedTriLod (LodMode mode, const tcu::Vec3& u, const tcu
 	return computeLodFromDerivates(mode, dudx, dvdx, dwdx, dudy, dvdy, dwdy);
 }
 
-static inline tcu::Vec4 execSample (const tcu::Texture1DView& src, const ReferenceParams& params, float s, float lod)
+static inline tcu::Vec4 execSample (const tcu::Texture1DView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, lod);
+		return src.sample(sampler, s, lod);
 }
 
-static inline tcu::Vec4 execSample (const tcu::Texture2DView& src, const ReferenceParams& params, float s, float t, float lod)
+static inline tcu::Vec4 execSample (const tcu::Texture2DView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float t, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, t, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, t, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, t, lod);
+		return src.sample(sampler, s, t, lod);
 }
 
-static inline tcu::Vec4 execSample (const tcu::TextureCubeView& src, const ReferenceParams& params, float s, float t, float r, float lod)
+static inline tcu::Vec4 execSample (const tcu::TextureCubeView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float t, float r, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, t, r, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, t, r, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, t, r, lod);
+		return src.sample(sampler, s, t, r, lod);
 }
 
-static inline tcu::Vec4 execSample (const tcu::Texture2DArrayView& src, const ReferenceParams& params, float s, float t, float r, float lod)
+static inline tcu::Vec4 execSample (const tcu::Texture2DArrayView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float t, float r, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, t, r, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, t, r, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, t, r, lod);
+		return src.sample(sampler, s, t, r, lod);
 }
 
-static inline tcu::Vec4 execSample (const tcu::TextureCubeArrayView& src, const ReferenceParams& params, float s, float t, float r, float q, float lod)
+static inline tcu::Vec4 execSample (const tcu::TextureCubeArrayView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float t, float r, float q, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, t, r, q, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, t, r, q, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, t, r, q, lod);
+		return src.sample(sampler, s, t, r, q, lod);
 }
 
-static inline tcu::Vec4 execSample (const tcu::Texture1DArrayView& src, const ReferenceParams& params, float s, float t, float lod)
+static inline tcu::Vec4 execSample (const tcu::Texture1DArrayView& src, const tcu::CompiledSampler& sampler, const ReferenceParams& params, float s, float t, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
-		return tcu::Vec4(src.sampleCompare(params.sampler, params.ref, s, t, lod), 0.0, 0.0, 1.0f);
+		return tcu::Vec4(src.sampleCompare(sampler, params.ref, s, t, lod), 0.0, 0.0, 1.0f);
 	else
-		return src.sample(params.sampler, s, t, lod);
+		return src.sample(sampler, s, t, lod);
 }
 
 static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Texture1DView& rawSrc, const tcu::Vec4& sq, const ReferenceParams& params)
@@ -431,6 +431,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture1DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 
@@ -456,7 +457,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	s		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
 			float	lod		= triLod[triNdx];
 
-			dst.setPixel(execSample(src, params, s, lod) * params.colorScale + params.colorBias, x, y);
+			dst.setPixel(execSample(src, sampler, params, s, lod) * params.colorScale + params.colorBias, x, y);
 		}
 	}
 }
@@ -466,6 +467,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture2DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 
@@ -493,7 +495,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
 			float	lod		= triLod[triNdx];
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
+			dst.setPixel(execSample(src, sampler, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
 		}
 	}
 }
@@ -503,6 +505,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture1DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 	float										dstW				= (float)dst.getWidth();
@@ -533,7 +536,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 			float	lod		= computeProjectedTriLod(params.lodMode, triU[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
 							+ lodBias;
 
-			dst.setPixel(execSample(src, params, s, lod) * params.colorScale + params.colorBias, px, py);
+			dst.setPixel(execSample(src, sampler, params, s, lod) * params.colorScale + params.colorBias, px, py);
 		}
 	}
 }
@@ -543,6 +546,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture2DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 	float										dstW				= (float)dst.getWidth();
@@ -577,7 +581,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 			float	lod		= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
 							+ lodBias;
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, px, py);
+			dst.setPixel(execSample(src, sampler, params, s, t, lod) * params.colorScale + params.colorBias, px, py);
 		}
 	}
 }
@@ -649,6 +653,7 @@ static void sampleTextureCube (const SurfaceAccess& dst, const tcu::TextureCubeV
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::TextureCubeView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevelFace(0, tcu::CUBEFACE_NEGATIVE_X).getFormat());
 
 	const tcu::IVec2							dstSize				= tcu::IVec2(dst.getWidth(), dst.getHeight());
 	const float									dstW				= float(dstSize.x());
@@ -688,7 +693,7 @@ static void sampleTextureCube (const SurfaceAccess& dst, const tcu::TextureCubeV
 
 			const float		lod			= de::clamp(computeCubeLodFromDerivates(params.lodMode, coord, coordDx, coordDy, srcSize) + lodBias, params.minLod, params.maxLod);
 
-			dst.setPixel(execSample(src, params, coord.x(), coord.y(), coord.z(), lod) * params.colorScale + params.colorBias, px, py);
+			dst.setPixel(execSample(src, sampler, params, coord.x(), coord.y(), coord.z(), lod) * params.colorScale + params.colorBias, px, py);
 		}
 	}
 }
@@ -708,6 +713,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture2DArrayView				src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 
@@ -737,7 +743,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	r		= triangleInterpolate(triR[triNdx].x(), triR[triNdx].y(), triR[triNdx].z(), triX, triY);
 			float	lod		= triLod[triNdx];
 
-			dst.setPixel(execSample(src, params, s, t, r, lod) * params.colorScale + params.colorBias, x, y);
+			dst.setPixel(execSample(src, sampler, params, s, t, r, lod) * params.colorScale + params.colorBias, x, y);
 		}
 	}
 }
@@ -757,6 +763,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture1DArrayView				src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 
@@ -784,7 +791,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
 			float	lod		= triLod[triNdx];
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
+			dst.setPixel(execSample(src, sampler, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
 		}
 	}
 }
@@ -803,6 +810,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture3DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 
@@ -832,7 +840,7 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	r		= triangleInterpolate(triR[triNdx].x(), triR[triNdx].y(), triR[triNdx].z(), triX, triY);
 			float	lod		= triLod[triNdx];
 
-			dst.setPixel(src.sample(params.sampler, s, t, r, lod) * params.colorScale + params.colorBias, x, y);
+			dst.setPixel(src.sample(sampler, s, t, r, lod) * params.colorScale + params.colorBias, x, y);
 		}
 	}
 }
@@ -842,6 +850,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture3DView					src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	float										lodBias				= (params.flags & ReferenceParams::USE_BIAS) ? params.bias : 0.0f;
 	float										dstW				= (float)dst.getWidth();
@@ -880,7 +889,7 @@ static void sampleTextureProjected (const SurfaceAccess& dst, const tcu::Texture
 			float	lod		= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triP[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
 							+ lodBias;
 
-			dst.setPixel(src.sample(params.sampler, s, t, r, lod) * params.colorScale + params.colorBias, px, py);
+			dst.setPixel(src.sample(sampler, s, t, r, lod) * params.colorScale + params.colorBias, px, py);
 		}
 	}
 }
@@ -903,6 +912,7 @@ static void sampleTextureCubeArray (const SurfaceAccess& dst, const tcu::Texture
 	// Separate combined DS formats
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::TextureCubeArrayView				src					= getEffectiveTextureView(rawSrc, srcLevelStorage, params.sampler);
+	const tcu::CompiledSampler					sampler				(params.sampler, src.getLevel(0).getFormat());
 
 	const float									dstW				= (float)dst.getWidth();
 	const float									dstH				= (float)dst.getHeight();
@@ -944,7 +954,7 @@ static void sampleTextureCubeArray (const SurfaceAccess& dst, const tcu::Texture
 
 			const float		lod		= de::clamp(computeCubeLodFromDerivates(params.lodMode, coord, coordDx, coordDy, src.getSize()) + lodBias, params.minLod, params.maxLod);
 
-			dst.setPixel(execSample(src, params, coord.x(), coord.y(), coord.z(), coordQ, lod) * params.colorScale + params.colorBias, px, py);
+			dst.setPixel(execSample(src, sampler, params, coord.x(), coord.y(), coord.z(), coordQ, lod) * params.colorScale + params.colorBias, px, py);
 		}
 	}
 }
@@ -1692,6 +1702,173 @@ void computeQuadTexCoordCubeArray (std::vector<float>& dst, tcu::CubeFace face,
 
 // Texture result verification
 
+namespace
+{
+
+enum
+{
+	LOOKUP_VERIFY_BATCH_ROWS	= 64	//!< Lookups are verified in batches of rows, watchdog is touched between batches.
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Lookups gathered for batch verification
+ *
+ * Lookups are stored separately for each triangle a pixel may belong to.
+ * A pixel close to the edge between triangles is valid if its lookup on
+ * either triangle is valid.
+ *//*--------------------------------------------------------------------*/
+class LookupBatchStorage
+{
+public:
+	LookupBatchStorage (int width, int height, int numTriangles = 1)
+		: m_results		(tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),			width, height, numTriangles)
+		, m_coords		(tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),			width, height, numTriangles)
+		, m_lodBounds	(tcu::TextureFormat(tcu::TextureFormat::RG,		tcu::TextureFormat::FLOAT),			width, height, numTriangles)
+		, m_verifyMask	(tcu::TextureFormat(tcu::TextureFormat::R,		tcu::TextureFormat::UNORM_INT8),	width, height, numTriangles)
+	{
+		tcu::clear(m_verifyMask.getAccess(), tcu::Vec4(0.0f));
+	}
+
+	int getNumTriangles (void) const
+	{
+		return m_verifyMask.getDepth();
+	}
+
+	void addLookup (int triNdx, int x, int y, const tcu::Vec4& coord, const tcu::Vec2& lodBounds, const tcu::Vec4& result)
+	{
+		m_results.getAccess().setPixel(result, x, y, triNdx);
+		m_coords.getAccess().setPixel(coord, x, y, triNdx);
+		m_lodBounds.getAccess().setPixel(lodBounds.toWidth<4>(), x, y, triNdx);
+		m_verifyMask.getAccess().setPixel(tcu::Vec4(1.0f), x, y, triNdx);
+	}
+
+	bool hasLookup (int triNdx, int x, int y) const
+	{
+		return m_verifyMask.getAccess().getPixel(x, y, triNdx).x() != 0.0f;
+	}
+
+	void removeLookup (int triNdx, int x, int y)
+	{
+		m_verifyMask.getAccess().setPixel(tcu::Vec4(0.0f), x, y, triNdx);
+	}
+
+	tcu::LookupBatch getBatch (int triNdx, int y, int height) const
+	{
+		const int width = m_verifyMask.getWidth();
+
+		return tcu::LookupBatch(tcu::getSubregion(m_results.getAccess(),		0, y, triNdx, width, height, 1),
+								tcu::getSubregion(m_coords.getAccess(),			0, y, triNdx, width, height, 1),
+								tcu::getSubregion(m_lodBounds.getAccess(),		0, y, triNdx, width, height, 1),
+								tcu::getSubregion(m_verifyMask.getAccess(),		0, y, triNdx, width, height, 1));
+	}
+
+private:
+	tcu::TextureLevel	m_results;
+	tcu::TextureLevel	m_coords;
+	tcu::TextureLevel	m_lodBounds;
+	tcu::TextureLevel	m_verifyMask;
+};
+
+template<typename TextureViewType>
+class LookupBatchVerifier
+{
+public:
+	LookupBatchVerifier (const TextureViewType& src, const tcu::Sampler& sampler, const tcu::LookupPrecision& prec)
+		: m_src		(src)
+		, m_sampler	(sampler)
+		, m_prec	(prec)
+	{
+	}
+
+	int verify (const tcu::LookupBatch& batch, const tcu::PixelBufferAccess& errorMask) const
+	{
+		return tcu::verifyLookupBatch(m_src, m_sampler, m_prec, batch, errorMask).numFailed;
+	}
+
+private:
+	const TextureViewType&			m_src;
+	const tcu::Sampler&				m_sampler;
+	const tcu::LookupPrecision&		m_prec;
+};
+
+class CubeArrayLookupBatchVerifier
+{
+public:
+	CubeArrayLookupBatchVerifier (const tcu::TextureCubeArrayView& src, const tcu::Sampler& sampler, const tcu::LookupPrecision& prec, const tcu::IVec4& coordBits)
+		: m_src			(src)
+		, m_sampler		(sampler)
+		, m_prec		(prec)
+		, m_coordBits	(coordBits)
+	{
+	}
+
+	int verify (const tcu::LookupBatch& batch, const tcu::PixelBufferAccess& errorMask) const
+	{
+		return tcu::verifyLookupBatch(m_src, m_sampler, m_prec, m_coordBits, batch, errorMask).numFailed;
+	}
+
+private:
+	const tcu::TextureCubeArrayView&	m_src;
+	const tcu::Sampler&					m_sampler;
+	const tcu::LookupPrecision&			m_prec;
+	const tcu::IVec4					m_coordBits;
+};
+
+template<typename Verifier>
+int verifyTriangleLookups (const Verifier& verifier, const LookupBatchStorage& lookups, int triNdx, const tcu::PixelBufferAccess& errorMask, qpWatchDog* watchDog)
+{
+	const int	width		= errorMask.getWidth();
+	const int	height		= errorMask.getHeight();
+	int			numFailed	= 0;
+
+	for (int y = 0; y < height; y += LOOKUP_VERIFY_BATCH_ROWS)
+	{
+		const int numRows = de::min((int)LOOKUP_VERIFY_BATCH_ROWS, height - y);
+
+		// Ugly hack, validation can take way too long at the moment.
+		if (watchDog)
+			qpWatchDog_touch(watchDog);
+
+		numFailed += verifier.verify(lookups.getBatch(triNdx, y, numRows), tcu::getSubregion(errorMask, 0, y, width, numRows));
+	}
+
+	return numFailed;
+}
+
+//! Verifies gathered lookups, marks invalid pixels red in errorMask and returns number of invalid pixels.
+template<typename Verifier>
+int verifyLookups (const Verifier& verifier, LookupBatchStorage& lookups, const tcu::PixelBufferAccess& errorMask, qpWatchDog* watchDog)
+{
+	int numFailed = verifyTriangleLookups(verifier, lookups, 0, errorMask, watchDog);
+
+	if (lookups.getNumTriangles() > 1)
+	{
+		const tcu::Vec4 red = tcu::RGBA::red.toVec();
+
+		// Pixels that failed on first triangle are re-verified on second one, others are already done.
+		for (int py = 0; py < errorMask.getHeight(); py++)
+		for (int px = 0; px < errorMask.getWidth(); px++)
+		{
+			if (!lookups.hasLookup(0, px, py) || !lookups.hasLookup(1, px, py))
+				continue;
+
+			if (tcu::boolAll(tcu::equal(errorMask.getPixel(px, py), red)))
+			{
+				errorMask.setPixel(tcu::RGBA::green.toVec(), px, py);
+				numFailed -= 1;
+			}
+			else
+				lookups.removeLookup(1, px, py);
+		}
+
+		numFailed += verifyTriangleLookups(verifier, lookups, 1, errorMask, watchDog);
+	}
+
+	return numFailed;
+}
+
+} // anonymous
+
 //! Verifies texture lookup results and returns number of failed pixels.
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
@@ -1722,7 +1899,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight());
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1782,18 +1959,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
+				lookups.addLookup(0, px, py, tcu::Vec4(coord, 0.0f, 0.0f, 0.0f), clampedLod, resPix);
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::Texture1DView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
@@ -1827,7 +1999,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight());
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1892,18 +2064,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
+				lookups.addLookup(0, px, py, coord.toWidth<4>(), clampedLod, resPix);
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::Texture2DView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2014,7 +2181,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight(), 2);
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2054,8 +2221,6 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				const bool		tri0	= (wx-posEps)/dstW + (wy-posEps)/dstH <= 1.0f;
 				const bool		tri1	= (wx+posEps)/dstW + (wy+posEps)/dstH >= 1.0f;
 
-				bool			isOk	= false;
-
 				DE_ASSERT(tri0 || tri1);
 
 				// Pixel can belong to either of the triangles if it lies close enough to the edge.
@@ -2103,23 +2268,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
 
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
+					lookups.addLookup(triNdx, px, py, coord.toWidth<4>(), clampedLod, resPix);
 				}
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::TextureCubeView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2194,7 +2349,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight(), 2);
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2228,8 +2383,6 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				const bool		tri0	= (wx-posEps)/dstW + (wy-posEps)/dstH <= 1.0f;
 				const bool		tri1	= (wx+posEps)/dstW + (wy+posEps)/dstH >= 1.0f;
 
-				bool			isOk	= false;
-
 				DE_ASSERT(tri0 || tri1);
 
 				// Pixel can belong to either of the triangles if it lies close enough to the edge.
@@ -2274,23 +2427,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
 
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
+					lookups.addLookup(triNdx, px, py, coord.toWidth<4>(), clampedLod, resPix);
 				}
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::Texture3DView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2361,7 +2504,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight());
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2422,18 +2565,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
+				lookups.addLookup(0, px, py, coord.toWidth<4>(), clampedLod, resPix);
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::Texture1DArrayView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 //! Verifies texture lookup results and returns number of failed pixels.
@@ -2470,7 +2608,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight());
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2536,18 +2674,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
+				lookups.addLookup(0, px, py, coord.toWidth<4>(), clampedLod, resPix);
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(LookupBatchVerifier<tcu::Texture2DArrayView>(src, sampleParams.sampler, lookupPrec), lookups, errorMask, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2661,7 +2794,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 	const float									posEps				= 1.0f / float((1<<4) + 1); // ES3 requires at least 4 subpixel bits.
 
-	int											numFailed			= 0;
+	LookupBatchStorage							lookups				(result.getWidth(), result.getHeight(), 2);
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2701,8 +2834,6 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				const bool		tri0	= nx + ny - posEps <= 1.0f;
 				const bool		tri1	= nx + ny + posEps >= 1.0f;
 
-				bool			isOk	= false;
-
 				DE_ASSERT(tri0 || tri1);
 
 				// Pixel can belong to either of the triangles if it lies close enough to the edge.
@@ -2751,23 +2882,13 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
 
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coordBits, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
+					lookups.addLookup(triNdx, px, py, coord, clampedLod, resPix);
 				}
 			}
 		}
 	}
 
-	return numFailed;
+	return verifyLookups(CubeArrayLookupBatchVerifier(src, sampleParams.sampler, lookupPrec, coordBits), lookups, errorMask, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
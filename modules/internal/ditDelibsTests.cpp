@@ -59,6 +59,7 @@
 #include "deStringUtil.hpp"
 #include "deSpinBarrier.hpp"
 #include "deSTLUtil.hpp"
+#include "deThreadPool.hpp"
 
 namespace dit
 {
@@ -184,6 +185,7 @@ public:
 		addChild(new SelfCheckCase(m_testCtx, "string_util",				"de::StringUtil_selfTest()",			de::StringUtil_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "spin_barrier",				"de::SpinBarrier_selfTest()",			de::SpinBarrier_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "stl_util",					"de::STLUtil_selfTest()",				de::STLUtil_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "thread_pool",				"de::ThreadPool_selfTest()",			de::ThreadPool_selfTest));
 	}
 };
 
@@ -28,12 +28,41 @@
 #include "tcuCommandLine.hpp"
 
 #include "rrRenderer.hpp"
+#include "rrRasterizer.hpp"
+#include "rrFragmentOperations.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuImageCompare.hpp"
+#include "tcuImageCompareThreads.hpp"
+#include "tcuFuzzyImageCompare.hpp"
+#include "tcuBilinearImageCompare.hpp"
+#include "tcuRGBA.hpp"
+#include "tcuTexLookupVerifier.hpp"
+#include "tcuFormatUtil.hpp"
+#include "tcuCompressedTexture.hpp"
+#include "tcuDecompressedTextureCache.hpp"
+#include "tcuTestHierarchyCache.hpp"
+#include "tcuResource.hpp"
+#include "tcuImageIO.hpp"
+#include "tcuTestPackage.hpp"
+#include "tcuTestHierarchyIterator.hpp"
 
 #include "deRandom.hpp"
+#include "deUniquePtr.hpp"
 #include "deArrayUtil.hpp"
+#include "deThreadPool.hpp"
+#include "deStringUtil.hpp"
+#include "deString.h"
+#include "deInt32.h"
+#include "deMemory.h"
+#include "deClock.h"
+#include "deFile.h"
+#include "deThread.h"
+#include "deAtomic.h"
+
+#include <algorithm>
+#include <fstream>
 
 namespace dit
 {
@@ -47,7 +76,7 @@ using tcu::TestLog;
 
 struct MatchCase
 {
-	enum Expected { NO_MATCH, MATCH_GROUP, MATCH_CASE, EXPECTED_LAST };
+	enum Expected { NO_MATCH, MATCH_GROUP, MATCH_CASE, MATCH_GROUP_AND_CASE, EXPECTED_LAST };
 
 	const char*	path;
 	Expected	expected;
@@ -59,7 +88,8 @@ const char* getMatchCaseExpectedDesc (MatchCase::Expected expected)
 	{
 		"no match",
 		"group to match",
-		"case to match"
+		"case to match",
+		"group and case to match"
 	};
 	return de::getSizedArrayElement<MatchCase::EXPECTED_LAST>(descs, expected);
 }
@@ -67,11 +97,12 @@ const char* getMatchCaseExpectedDesc (MatchCase::Expected expected)
 class CaseListParserCase : public tcu::TestCase
 {
 public:
-	CaseListParserCase (tcu::TestContext& testCtx, const char* name, const char* caseList, const MatchCase* subCases, int numSubCases)
+	CaseListParserCase (tcu::TestContext& testCtx, const char* name, const char* caseList, const MatchCase* subCases, int numSubCases, const char* option = "--deqp-caselist")
 		: tcu::TestCase	(testCtx, name, "")
 		, m_caseList	(caseList)
 		, m_subCases	(subCases)
 		, m_numSubCases	(numSubCases)
+		, m_option		(option)
 	{
 	}
 
@@ -87,7 +118,7 @@ public:
 			const char* argv[] =
 			{
 				"deqp",
-				"--deqp-caselist",
+				m_option,
 				m_caseList
 			};
 
@@ -108,8 +139,8 @@ public:
 			matchGroup	= cmdLine.checkTestGroupName(curCase.path);
 			matchCase	= cmdLine.checkTestCaseName(curCase.path);
 
-			if ((matchGroup	== (curCase.expected == MatchCase::MATCH_GROUP)) &&
-				(matchCase	== (curCase.expected == MatchCase::MATCH_CASE)))
+			if ((matchGroup	== (curCase.expected == MatchCase::MATCH_GROUP || curCase.expected == MatchCase::MATCH_GROUP_AND_CASE)) &&
+				(matchCase	== (curCase.expected == MatchCase::MATCH_CASE || curCase.expected == MatchCase::MATCH_GROUP_AND_CASE)))
 			{
 				log << TestLog::Message << "   pass" << TestLog::EndMessage;
 				numPass += 1;
@@ -128,6 +159,7 @@ private:
 	const char* const			m_caseList;
 	const MatchCase* const		m_subCases;
 	const int					m_numSubCases;
+	const char* const			m_option;
 };
 
 class NegativeCaseListCase : public tcu::TestCase
@@ -538,6 +570,83 @@ public:
 	}
 };
 
+class CasePatternTests : public tcu::TestCaseGroup
+{
+public:
+	CasePatternTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "pattern", "Test case pattern (--deqp-case) tests")
+	{
+	}
+
+	void init (void)
+	{
+		{
+			static const char* const	pattern		= "a.b.c";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.b",			MatchCase::MATCH_GROUP	},
+				{ "a.b.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.b.d",			MatchCase::NO_MATCH		},
+				{ "a.b.c.d",		MatchCase::NO_MATCH		},
+				{ "b",				MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "exact", pattern, subCases, DE_LENGTH_OF_ARRAY(subCases), "--deqp-case"));
+		}
+		{
+			static const char* const	pattern		= "a.b.*";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.b",			MatchCase::MATCH_GROUP	},
+				{ "a.b.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.b.c.d",		MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.c",			MatchCase::NO_MATCH		},
+				{ "x",				MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "trailing_wildcard", pattern, subCases, DE_LENGTH_OF_ARRAY(subCases), "--deqp-case"));
+		}
+		{
+			static const char* const	pattern		= "a.*.c";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.x",			MatchCase::MATCH_GROUP	},
+				{ "a.x.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.x.y.c",		MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.cc.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.x.cd",			MatchCase::MATCH_GROUP	},
+				{ "b.x",			MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "middle_wildcard", pattern, subCases, DE_LENGTH_OF_ARRAY(subCases), "--deqp-case"));
+		}
+		{
+			static const char* const	pattern		= "*.b*c";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.bc",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.bxc",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "x.y.bcbc",		MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.b",			MatchCase::MATCH_GROUP	},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "multiple_wildcards", pattern, subCases, DE_LENGTH_OF_ARRAY(subCases), "--deqp-case"));
+		}
+		{
+			static const char* const	pattern		= "a.b,c.*";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.b",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "c",				MatchCase::MATCH_GROUP	},
+				{ "c.d",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "d",				MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "multiple_patterns", pattern, subCases, DE_LENGTH_OF_ARRAY(subCases), "--deqp-case"));
+		}
+	}
+};
+
 class CaseListParserTests : public tcu::TestCaseGroup
 {
 public:
@@ -550,6 +659,7 @@ public:
 	{
 		addChild(new TrieParserTests(m_testCtx));
 		addChild(new ListParserTests(m_testCtx));
+		addChild(new CasePatternTests(m_testCtx));
 	}
 };
 
@@ -761,7 +871,7 @@ protected:
 			rr::ViewportState						viewport		(colorAccess);
 			rr::RenderState							state			(viewport);
 			const rr::DrawCommand					drawCmd			(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, 3, 0));
-			const rr::Renderer						renderer;
+			rr::Renderer							renderer;
 
 			viewport.zn	= zn;
 			viewport.zf	= zf;
@@ -862,6 +972,3339 @@ protected:
 	vector<SubCase>::const_iterator	m_caseIter;
 };
 
+class ParallelRasterizationTest : public tcu::TestCase
+{
+public:
+	ParallelRasterizationTest (tcu::TestContext& testCtx, const char* name, const char* description, rr::PrimitiveType primitiveType, int numSamples)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_primitiveType	(primitiveType)
+		, m_numSamples		(numSamples)
+		, m_iterNdx			(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_iterNdx = 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All iterations passed");
+	}
+
+	IterateResult iterate (void)
+	{
+		static const rr::WindowRectangle viewports[] =
+		{
+			rr::WindowRectangle(0,		0,		300,	200),
+			rr::WindowRectangle(13,		7,		250,	170),
+			rr::WindowRectangle(-40,	-30,	380,	270),
+			rr::WindowRectangle(5,		3,		60,		40),
+		};
+
+		const tcu::ScopedLogSection section(m_testCtx.getLog(), "Iteration" + de::toString(m_iterNdx), "Iteration " + de::toString(m_iterNdx));
+
+		runIteration(viewports[m_iterNdx], deStringHash(getName()) ^ deInt32Hash(m_iterNdx));
+
+		return (++m_iterNdx < DE_LENGTH_OF_ARRAY(viewports)) ? CONTINUE : STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH			= 300,
+		HEIGHT			= 200,
+		NUM_VERTICES	= 384,	//!< Large enough for vertex shading to be split into several chunks
+		NUM_THREADS		= 4
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(3, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[2].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::VertexPacket& packet = *packets[packetNdx];
+
+				packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+				packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+				packet.pointSize	= rr::readVertexAttribFloat(inputs[2], packet.instanceNdx, packet.vertexNdx).x();
+			}
+		}
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (void)
+			: rr::FragmentShader(1, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				tcu::Vec4 dFdx[4];
+
+				// Derivatives depend on quad alignment, which must match in serial and parallel rasterization
+				rr::dFdxVarying(dFdx, packets[packetNdx], context, 0);
+
+				for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				{
+					const tcu::Vec4 color = rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx) + 4.0f*dFdx[fragNdx];
+					rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, color);
+				}
+			}
+		}
+	};
+
+	void render (const tcu::PixelBufferAccess& color, const tcu::PixelBufferAccess& depthStencil, const rr::WindowRectangle& viewport, const std::vector<tcu::Vec4>& positions, const std::vector<tcu::Vec4>& colors, const std::vector<float>& pointSizes, int numThreads) const
+	{
+		const VtxShader							vtxShader;
+		const FragShader						fragShader;
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color);
+		const rr::MultisamplePixelBufferAccess	dsAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depthStencil);
+		const rr::RenderTarget					renderTarget	(colorAccess, dsAccess, dsAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &colors[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 1, 0, 0, &pointSizes[0]),
+		};
+		rr::RenderState							state			((rr::ViewportState(viewport)));
+		rr::Renderer							renderer		(numThreads);
+
+		state.line.lineWidth									= 3.0f;
+		state.fragOps.depthTestEnabled							= true;
+		state.fragOps.depthFunc									= rr::TESTFUNC_LEQUAL;
+		state.fragOps.stencilTestEnabled						= true;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].func		= rr::TESTFUNC_ALWAYS;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].dpPass	= rr::STENCILOP_INCR;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].dpFail	= rr::STENCILOP_INVERT;
+		state.fragOps.stencilStates[rr::FACETYPE_FRONT]			= state.fragOps.stencilStates[rr::FACETYPE_BACK];
+		state.fragOps.blendMode									= rr::BLENDMODE_STANDARD;
+		state.fragOps.blendRGBState.srcFunc						= rr::BLENDFUNC_SRC_ALPHA;
+		state.fragOps.blendRGBState.dstFunc						= rr::BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+		state.fragOps.blendAState.srcFunc						= rr::BLENDFUNC_ONE;
+		state.fragOps.blendAState.dstFunc						= rr::BLENDFUNC_ONE;
+
+		TCU_CHECK(renderer.getNumThreads() == numThreads);
+
+		tcu::clear			(color, tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		tcu::clearDepth		(depthStencil, 1.0f);
+		tcu::clearStencil	(depthStencil, 0);
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(m_primitiveType, (int)positions.size(), 0)));
+
+		TCU_CHECK(renderer.getStatistics().numDrawCalls == 1);
+		TCU_CHECK(renderer.getStatistics().numShadedVertices == (deUint64)positions.size());
+
+		m_testCtx.getLog() << TestLog::Message
+						   << numThreads << " thread(s): shaded " << renderer.getStatistics().numShadedVertices << " vertices"
+						   << TestLog::EndMessage;
+	}
+
+	void runIteration (const rr::WindowRectangle& viewport, deUint32 seed)
+	{
+		const int					numVertices			= NUM_VERTICES;
+		const tcu::TextureFormat	colorFormat			(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		const tcu::TextureFormat	dsFormat			(tcu::TextureFormat::DS, tcu::TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV);
+		tcu::TextureLevel			serialColor			(colorFormat,	m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			serialDepthStencil	(dsFormat,		m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			parallelColor		(colorFormat,	m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			parallelDepthStencil(dsFormat,		m_numSamples, WIDTH, HEIGHT);
+		std::vector<tcu::Vec4>		positions			(numVertices);
+		std::vector<tcu::Vec4>		colors				(numVertices);
+		std::vector<float>			pointSizes			(numVertices);
+		de::Random					rnd					(seed);
+
+		m_testCtx.getLog() << TestLog::Message
+						   << "Viewport (x, y, w, h) = " << tcu::IVec4(viewport.left, viewport.bottom, viewport.width, viewport.height) << "\n"
+						   << "Rendering " << numVertices << " vertices with 1 and " << (int)NUM_THREADS << " threads"
+						   << TestLog::EndMessage;
+
+		for (int vtxNdx = 0; vtxNdx < numVertices; vtxNdx++)
+		{
+			const float w = rnd.getFloat(0.5f, 2.0f);
+
+			positions[vtxNdx]	= tcu::Vec4(rnd.getFloat(-1.3f, 1.3f)*w, rnd.getFloat(-1.3f, 1.3f)*w, rnd.getFloat(-1.1f, 1.1f)*w, w);
+			colors[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+			pointSizes[vtxNdx]	= rnd.getFloat(1.0f, 24.0f);
+		}
+
+		render(serialColor.getAccess(), serialDepthStencil.getAccess(), viewport, positions, colors, pointSizes, 1);
+		render(parallelColor.getAccess(), parallelDepthStencil.getAccess(), viewport, positions, colors, pointSizes, NUM_THREADS);
+
+		{
+			const tcu::ConstPixelBufferAccess	serialColorAccess		= serialColor.getAccess();
+			const tcu::ConstPixelBufferAccess	parallelColorAccess		= parallelColor.getAccess();
+			const tcu::ConstPixelBufferAccess	serialDSAccess			= serialDepthStencil.getAccess();
+			const tcu::ConstPixelBufferAccess	parallelDSAccess		= parallelDepthStencil.getAccess();
+			int									numFailedSamples		= 0;
+
+			for (int y = 0; y < HEIGHT; y++)
+			for (int x = 0; x < WIDTH; x++)
+			for (int sampleNdx = 0; sampleNdx < m_numSamples; sampleNdx++)
+			{
+				const bool colorOk		= tcu::boolAll(tcu::equal(serialColorAccess.getPixel(sampleNdx, x, y), parallelColorAccess.getPixel(sampleNdx, x, y)));
+				const bool depthOk		= serialDSAccess.getPixDepth(sampleNdx, x, y) == parallelDSAccess.getPixDepth(sampleNdx, x, y);
+				const bool stencilOk	= serialDSAccess.getPixStencil(sampleNdx, x, y) == parallelDSAccess.getPixStencil(sampleNdx, x, y);
+
+				if (!colorOk || !depthOk || !stencilOk)
+				{
+					const int maxMsgs = 10;
+
+					if (numFailedSamples < maxMsgs)
+						m_testCtx.getLog() << TestLog::Message
+										   << "FAIL: " << tcu::IVec3(x, y, sampleNdx) << " differs: "
+										   << "color " << serialColorAccess.getPixel(sampleNdx, x, y) << " vs " << parallelColorAccess.getPixel(sampleNdx, x, y)
+										   << ", depth " << serialDSAccess.getPixDepth(sampleNdx, x, y) << " vs " << parallelDSAccess.getPixDepth(sampleNdx, x, y)
+										   << ", stencil " << serialDSAccess.getPixStencil(sampleNdx, x, y) << " vs " << parallelDSAccess.getPixStencil(sampleNdx, x, y)
+										   << TestLog::EndMessage;
+
+					numFailedSamples += 1;
+				}
+			}
+
+			if (numFailedSamples != 0)
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: " << numFailedSamples << " samples differ between serial and parallel rasterization" << TestLog::EndMessage;
+
+				if (m_testCtx.getTestResult() == QP_TEST_RESULT_PASS)
+					m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Parallel rasterization result differs from serial");
+			}
+			else
+				m_testCtx.getLog() << TestLog::Message << "Serial and parallel results are identical" << TestLog::EndMessage;
+		}
+	}
+
+	const rr::PrimitiveType		m_primitiveType;
+	const int					m_numSamples;
+	int							m_iterNdx;
+};
+
+//! Detects concurrent calls to shaders that are not thread-safe
+class ShadingCallTracker
+{
+public:
+	ShadingCallTracker (void)
+		: m_numActiveCalls	(0)
+		, m_numCalls		(0)
+		, m_hadConcurrent	(false)
+	{
+	}
+
+	void enter (void)
+	{
+		if (deAtomicIncrement32(&m_numActiveCalls) > 1)
+			m_hadConcurrent = true;
+
+		m_numCalls += 1;
+
+		// Give other threads a chance to enter while this call is active
+		deYield();
+	}
+
+	void leave (void)
+	{
+		deAtomicDecrement32(&m_numActiveCalls);
+	}
+
+	int		getNumCalls			(void) const { return m_numCalls;		}
+	bool	hadConcurrentCalls	(void) const { return m_hadConcurrent;	}
+
+private:
+	volatile deInt32	m_numActiveCalls;
+	int					m_numCalls;			//!< Only accurate if there were no concurrent calls
+	volatile bool		m_hadConcurrent;
+};
+
+class ShaderThreadSafetyTest : public tcu::TestCase
+{
+public:
+	ShaderThreadSafetyTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int					numVertices		= NUM_TRIANGLES*3;
+		tcu::TextureLevel			color			(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT), 1, SIZE, SIZE);
+		tcu::TextureLevel			depthStencil	(tcu::TextureFormat(tcu::TextureFormat::DS, tcu::TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV), 1, SIZE, SIZE);
+		std::vector<tcu::Vec4>		positions		(numVertices);
+		de::Random					rnd				(deStringHash(getName()));
+		VtxShader					vtxShader;
+		FragShader					fragShader;
+		const rr::Program			program			(&vtxShader, &fragShader);
+		rr::Renderer				renderer		(NUM_THREADS);
+
+		for (int triNdx = 0; triNdx < NUM_TRIANGLES; triNdx++)
+		{
+			const tcu::Vec2 center (rnd.getFloat(-1.0f, 1.0f), rnd.getFloat(-1.0f, 1.0f));
+
+			for (int vtxNdx = 0; vtxNdx < 3; vtxNdx++)
+				positions[triNdx*3 + vtxNdx] = tcu::Vec4(center.x() + rnd.getFloat(-0.2f, 0.2f), center.y() + rnd.getFloat(-0.2f, 0.2f), 0.0f, 1.0f);
+		}
+
+		{
+			const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color.getAccess());
+			const rr::MultisamplePixelBufferAccess	dsAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depthStencil.getAccess());
+			const rr::RenderTarget					renderTarget	(colorAccess, dsAccess, dsAccess);
+			const rr::VertexAttrib					vertexAttrib	(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]);
+			const rr::RenderState					state			((rr::ViewportState(colorAccess)));
+
+			tcu::clear(color.getAccess(), tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+			renderer.draw(rr::DrawCommand(state, renderTarget, program, 1, &vertexAttrib, rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, numVertices, 0)));
+		}
+
+		m_testCtx.getLog() << TestLog::Message
+						   << "Rendered " << (int)NUM_TRIANGLES << " triangles with " << renderer.getNumThreads() << " threads\n"
+						   << "Vertex shader calls: " << vtxShader.tracker.getNumCalls() << "\n"
+						   << "Fragment shader calls: " << fragShader.tracker.getNumCalls()
+						   << TestLog::EndMessage;
+
+		if (vtxShader.tracker.hadConcurrentCalls())
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Vertex shader that is not thread-safe was called concurrently");
+		else if (fragShader.tracker.hadConcurrentCalls())
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Fragment shader that is not thread-safe was called concurrently");
+		else if (renderer.getStatistics().numShadedVertices != (deUint64)numVertices)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Unexpected number of shaded vertices");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		SIZE			= 128,	//!< Spans several rasterization tiles
+		NUM_TRIANGLES	= 1024,	//!< Large enough for vertex shading to be split into several chunks
+		NUM_THREADS		= 4
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(1, 0)
+		{
+			m_inputs[0].type = rr::GENERICVECTYPE_FLOAT;
+		}
+
+		bool isThreadSafe (void) const
+		{
+			return false;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			tracker.enter();
+
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+				packets[packetNdx]->position = rr::readVertexAttribFloat(inputs[0], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+
+			tracker.leave();
+		}
+
+		mutable ShadingCallTracker tracker;
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (void)
+			: rr::FragmentShader(0, 1)
+		{
+			m_outputs[0].type = rr::GENERICVECTYPE_FLOAT;
+		}
+
+		bool isThreadSafe (void) const
+		{
+			return false;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			DE_UNREF(packets);
+
+			tracker.enter();
+
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, tcu::Vec4(1.0f, 0.5f, 0.25f, 1.0f));
+
+			tracker.leave();
+		}
+
+		mutable ShadingCallTracker tracker;
+	};
+};
+
+class VertexCacheTest : public tcu::TestCase
+{
+public:
+	VertexCacheTest (tcu::TestContext& testCtx, const char* name, const char* description, rr::PrimitiveType primitiveType, rr::IndexType indexType, bool primitiveRestart)
+		: tcu::TestCase			(testCtx, name, description)
+		, m_primitiveType		(primitiveType)
+		, m_indexType			(indexType)
+		, m_primitiveRestart	(primitiveRestart)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			GRID_SIZE		= 8,
+			BASE_VERTEX		= 5,
+			NUM_INSTANCES	= 2,
+			SIZE			= 64
+		};
+
+		const deUint32				restartIndex		= (m_indexType == rr::INDEXTYPE_UINT8) ? 0xFFu : (m_indexType == rr::INDEXTYPE_UINT16) ? 0xFFFFu : 0xFFFFFFFFu;
+		const tcu::TextureFormat	format				(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		tcu::TextureLevel			indexedResult		(format, 1, SIZE, SIZE);
+		tcu::TextureLevel			expandedResult		(format, 1, SIZE, SIZE);
+		std::vector<tcu::Vec4>		vertices			(BASE_VERTEX);	// leading vertices are skipped with base vertex
+		std::vector<deUint32>		indices;
+		std::vector<tcu::Vec4>		expandedVertices;
+		int							numDistinctVertices	= 0;
+
+		// Grid vertices
+		for (int y = 0; y <= GRID_SIZE; y++)
+		for (int x = 0; x <= GRID_SIZE; x++)
+			vertices.push_back(tcu::Vec4(2.0f * (float)x / GRID_SIZE - 1.0f, 2.0f * (float)y / GRID_SIZE - 1.0f, 0.0f, 1.0f));
+
+		// Indices, either as a triangle list or as strips separated with restart index
+		for (int y = 0; y < GRID_SIZE; y++)
+		{
+			for (int x = 0; x < GRID_SIZE; x++)
+			{
+				const deUint32 i00 = (deUint32)(y*(GRID_SIZE+1) + x);
+				const deUint32 i10 = i00 + 1;
+				const deUint32 i01 = i00 + GRID_SIZE + 1;
+				const deUint32 i11 = i01 + 1;
+
+				if (m_primitiveType == rr::PRIMITIVETYPE_TRIANGLES)
+				{
+					indices.push_back(i00); indices.push_back(i10); indices.push_back(i01);
+					indices.push_back(i01); indices.push_back(i10); indices.push_back(i11);
+				}
+				else
+				{
+					if (x == 0)
+					{
+						indices.push_back(i00);
+						indices.push_back(i01);
+					}
+					indices.push_back(i10);
+					indices.push_back(i11);
+				}
+			}
+
+			if (m_primitiveType == rr::PRIMITIVETYPE_TRIANGLE_STRIP && m_primitiveRestart && y+1 < GRID_SIZE)
+				indices.push_back(restartIndex);
+		}
+
+		// Each restart run is cached separately
+		{
+			std::vector<bool> seen (vertices.size(), false);
+
+			for (size_t ndx = 0; ndx < indices.size(); ndx++)
+			{
+				if (m_primitiveRestart && indices[ndx] == restartIndex)
+				{
+					std::fill(seen.begin(), seen.end(), false);
+					continue;
+				}
+
+				if (!seen[indices[ndx] + BASE_VERTEX])
+					numDistinctVertices += 1;
+				seen[indices[ndx] + BASE_VERTEX] = true;
+			}
+		}
+
+		// Expanded, non-indexed equivalent. Restart is replaced by separate draws of strip runs.
+		for (size_t ndx = 0; ndx < indices.size(); ndx++)
+			expandedVertices.push_back((m_primitiveRestart && indices[ndx] == restartIndex) ? tcu::Vec4(0.0f) : vertices[indices[ndx] + BASE_VERTEX]);
+
+		{
+			const VtxShader							vtxShader;
+			const FragShader						fragShader;
+			const rr::Program						program			(&vtxShader, &fragShader);
+			rr::RenderState							state			((rr::ViewportState(rr::WindowRectangle(0, 0, SIZE, SIZE))));
+			rr::Renderer							renderer		(1);
+			std::vector<deUint8>					indexData		(indices.size() * 4);
+
+			state.restart.enabled		= m_primitiveRestart;
+			state.restart.restartIndex	= restartIndex;
+
+			for (size_t ndx = 0; ndx < indices.size(); ndx++)
+			{
+				switch (m_indexType)
+				{
+					case rr::INDEXTYPE_UINT8:	indexData[ndx] = (deUint8)indices[ndx];										break;
+					case rr::INDEXTYPE_UINT16:	((deUint16*)&indexData[0])[ndx] = (deUint16)indices[ndx];					break;
+					case rr::INDEXTYPE_UINT32:	((deUint32*)&indexData[0])[ndx] = indices[ndx];								break;
+					default:
+						DE_ASSERT(false);
+				}
+			}
+
+			// Indexed draw
+			{
+				const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(indexedResult.getAccess());
+				const rr::RenderTarget					renderTarget	(colorAccess);
+				const rr::VertexAttrib					vertexAttribs[]	=
+				{
+					rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &vertices[0]),
+					rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &vertices[0]),
+					rr::VertexAttrib(tcu::Vec4(1.0f)),
+				};
+
+				tcu::clear(indexedResult.getAccess(), tcu::Vec4(0.0f));
+				renderer.drawInstanced(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs,
+													   rr::PrimitiveList(m_primitiveType, (int)indices.size(), rr::DrawIndices(&indexData[0], m_indexType, BASE_VERTEX))),
+									   NUM_INSTANCES);
+			}
+
+			m_testCtx.getLog() << TestLog::Message
+							   << "Indexed draw of " << indices.size() << " indices, " << (int)NUM_INSTANCES << " instances: shaded "
+							   << renderer.getStatistics().numShadedVertices << " vertices, "
+							   << renderer.getStatistics().numVertexCacheHits << " / " << renderer.getStatistics().numVertexCacheLookups << " vertex cache hits"
+							   << TestLog::EndMessage;
+
+			if (renderer.getStatistics().numShadedVertices != (deUint64)(numDistinctVertices * NUM_INSTANCES))
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: Expected " << numDistinctVertices * NUM_INSTANCES << " shaded vertices" << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Unexpected number of shaded vertices");
+				return STOP;
+			}
+
+			// Expanded draws
+			{
+				const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(expandedResult.getAccess());
+				const rr::RenderTarget					renderTarget	(colorAccess);
+				const rr::VertexAttrib					vertexAttribs[]	=
+				{
+					rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &expandedVertices[0]),
+					rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &expandedVertices[0]),
+					rr::VertexAttrib(tcu::Vec4(1.0f)),
+				};
+				rr::RenderState							expandedState	= state;
+				size_t									runStart		= 0;
+
+				expandedState.restart.enabled = false;
+				tcu::clear(expandedResult.getAccess(), tcu::Vec4(0.0f));
+
+				for (size_t ndx = 0; ndx <= indices.size(); ndx++)
+				{
+					if (ndx == indices.size() || (m_primitiveRestart && indices[ndx] == restartIndex))
+					{
+						if (ndx > runStart)
+							renderer.drawInstanced(rr::DrawCommand(expandedState, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs,
+																   rr::PrimitiveList(m_primitiveType, (int)(ndx - runStart), (int)runStart)),
+												   NUM_INSTANCES);
+						runStart = ndx + 1;
+					}
+				}
+			}
+		}
+
+		if (tcu::floatThresholdCompare(m_testCtx.getLog(), "Result", "Indexed vs. expanded", expandedResult.getAccess(), indexedResult.getAccess(), tcu::Vec4(0.0f), tcu::COMPARE_LOG_ON_ERROR))
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Indexed draw result differs from non-indexed draw");
+
+		return STOP;
+	}
+
+private:
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(3, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[2].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::VertexPacket&	packet	= *packets[packetNdx];
+				const tcu::Vec4		pos		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+
+				packet.position		= pos;
+				packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx) * 0.5f + 0.5f + tcu::Vec4((float)packet.instanceNdx);
+			}
+		}
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (void)
+			: rr::FragmentShader(1, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+		}
+	};
+
+	const rr::PrimitiveType		m_primitiveType;
+	const rr::IndexType			m_indexType;
+	const bool					m_primitiveRestart;
+};
+
+struct RasterizedPacket
+{
+	rr::FragmentPacket	packet;
+	std::vector<float>	depth;
+
+	bool operator< (const RasterizedPacket& other) const
+	{
+		return packet.position.y() != other.packet.position.y() ? packet.position.y() < other.packet.position.y()
+																 : packet.position.x() < other.packet.position.x();
+	}
+};
+
+static void rasterizeAllPackets (rr::TriangleRasterizer& rasterizer, int numSamples, std::vector<RasterizedPacket>& dst)
+{
+	enum { MAX_PACKETS = 16 };
+
+	rr::FragmentPacket	packets	[MAX_PACKETS];
+	std::vector<float>	depth	(MAX_PACKETS*4*numSamples);
+
+	for (;;)
+	{
+		int numPackets = 0;
+
+		rasterizer.rasterize(packets, &depth[0], MAX_PACKETS, numPackets);
+
+		if (numPackets == 0)
+			break;
+
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		{
+			RasterizedPacket p;
+			p.packet = packets[packetNdx];
+			p.depth.assign(depth.begin() + packetNdx*4*numSamples, depth.begin() + (packetNdx+1)*4*numSamples);
+			dst.push_back(p);
+		}
+	}
+}
+
+class TriangleRasterizerEquivalenceTest : public tcu::TestCase
+{
+public:
+	TriangleRasterizerEquivalenceTest (tcu::TestContext& testCtx, const char* name, const char* description, int numSamples, rr::EdgeEvaluation edgeEvaluation, rr::TriangleTraversal traversal)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_numSamples		(numSamples)
+		, m_edgeEvaluation	(edgeEvaluation)
+		, m_traversal		(traversal)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			NUM_TRIANGLES		= 500,
+			VIEWPORT_WIDTH		= 67,
+			VIEWPORT_HEIGHT		= 53
+		};
+
+		const tcu::IVec4	viewport		(3, 5, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+		de::Random			rnd				(deInt32Hash(m_numSamples) ^ 0x1b3c9a2);
+		int					numPackets		= 0;
+
+		m_testCtx.getLog() << tcu::TestLog::Message << "Comparing against scalar edge evaluation and scanline traversal" << tcu::TestLog::EndMessage;
+
+		for (int triNdx = 0; triNdx < NUM_TRIANGLES; triNdx++)
+		{
+			rr::RasterizationState	state;
+			tcu::Vec4				v[3];
+
+			state.winding			= rnd.getBool() ? rr::WINDING_CCW : rr::WINDING_CW;
+			state.horizontalFill	= rnd.getBool() ? rr::FILL_LEFT : rr::FILL_RIGHT;
+			state.verticalFill		= rnd.getBool() ? rr::FILL_TOP : rr::FILL_BOTTOM;
+
+			for (int vtxNdx = 0; vtxNdx < 3; vtxNdx++)
+			{
+				// Snap some vertices to pixel and sample grid to hit edge cases in fill rules
+				const float	x		= rnd.getFloat(-10.0f, VIEWPORT_WIDTH + 20.0f);
+				const float	y		= rnd.getFloat(-10.0f, VIEWPORT_HEIGHT + 20.0f);
+				const bool	snap	= rnd.getInt(0, 3) == 0;
+
+				v[vtxNdx] = tcu::Vec4(snap ? deFloatFloor(x*8.0f) / 8.0f : x,
+									  snap ? deFloatFloor(y*8.0f) / 8.0f : y,
+									  rnd.getFloat(),
+									  rnd.getFloat(0.1f, 2.0f));
+			}
+
+			// Rasterize with every other triangle limited to a random sub-area
+			{
+				const int			areaX		= (triNdx % 2) ? rnd.getInt(0, VIEWPORT_WIDTH-1) : 0;
+				const int			areaY		= (triNdx % 2) ? rnd.getInt(0, VIEWPORT_HEIGHT-1) : 0;
+				const tcu::IVec4	area		(viewport.x() + areaX, viewport.y() + areaY, rnd.getInt(1, VIEWPORT_WIDTH-areaX), rnd.getInt(1, VIEWPORT_HEIGHT-areaY));
+				const tcu::IVec4	rasterArea	= (triNdx % 2) ? area : viewport;
+
+				rr::RasterizationState	referenceState	= state;
+				rr::RasterizationState	testState		= state;
+
+				referenceState.edgeEvaluation	= rr::EDGEEVALUATION_SCALAR;
+				referenceState.traversal		= rr::TRIANGLETRAVERSAL_SCANLINE;
+				testState.edgeEvaluation		= m_edgeEvaluation;
+				testState.traversal				= m_traversal;
+
+				rr::TriangleRasterizer			referenceRasterizer	(viewport, rasterArea, m_numSamples, referenceState);
+				rr::TriangleRasterizer			testRasterizer		(viewport, rasterArea, m_numSamples, testState);
+				std::vector<RasterizedPacket>	referencePackets;
+				std::vector<RasterizedPacket>	testPackets;
+
+				referenceRasterizer.init(v[0], v[1], v[2]);
+				testRasterizer.init(v[0], v[1], v[2]);
+
+				TCU_CHECK(referenceRasterizer.getVisibleFace() == testRasterizer.getVisibleFace());
+
+				rasterizeAllPackets(referenceRasterizer, m_numSamples, referencePackets);
+				rasterizeAllPackets(testRasterizer, m_numSamples, testPackets);
+
+				// Packet order depends on traversal
+				std::sort(referencePackets.begin(), referencePackets.end());
+				std::sort(testPackets.begin(), testPackets.end());
+
+				if (referencePackets.size() != testPackets.size())
+				{
+					m_testCtx.getLog() << tcu::TestLog::Message << "Triangle " << triNdx << ": got " << testPackets.size() << " packets, expected " << referencePackets.size() << tcu::TestLog::EndMessage;
+					m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Packet count differs");
+					return STOP;
+				}
+
+				for (size_t packetNdx = 0; packetNdx < referencePackets.size(); packetNdx++)
+				{
+					const rr::FragmentPacket& a = referencePackets[packetNdx].packet;
+					const rr::FragmentPacket& b = testPackets[packetNdx].packet;
+
+					if (a.position != b.position || a.coverage != b.coverage ||
+						deMemCmp(a.barycentric, b.barycentric, sizeof(a.barycentric)) != 0)
+					{
+						m_testCtx.getLog() << tcu::TestLog::Message << "Packet mismatch in triangle " << triNdx << " at " << a.position
+										   << ": coverage " << tcu::toHex(a.coverage) << " vs " << tcu::toHex(b.coverage)
+										   << tcu::TestLog::EndMessage;
+						m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Fragment packets differ");
+						return STOP;
+					}
+
+					if (deMemCmp(&referencePackets[packetNdx].depth[0], &testPackets[packetNdx].depth[0], 4*m_numSamples*sizeof(float)) != 0)
+					{
+						m_testCtx.getLog() << tcu::TestLog::Message << "Depth values differ in triangle " << triNdx << " at " << a.position << tcu::TestLog::EndMessage;
+						m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Depth values differ");
+						return STOP;
+					}
+				}
+
+				numPackets += (int)referencePackets.size();
+			}
+		}
+
+		m_testCtx.getLog() << tcu::TestLog::Message << "Compared " << numPackets << " fragment packets from " << (int)NUM_TRIANGLES << " triangles" << tcu::TestLog::EndMessage;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+
+private:
+	const int						m_numSamples;
+	const rr::EdgeEvaluation		m_edgeEvaluation;
+	const rr::TriangleTraversal		m_traversal;
+};
+
+class FragmentProcessorFastPathTest : public tcu::TestCase
+{
+public:
+	FragmentProcessorFastPathTest (tcu::TestContext& testCtx, const char* name, const char* description, int numSamples, bool depthTest, tcu::TextureFormat::ChannelOrder depthOrder, bool alphaBlend)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_numSamples		(numSamples)
+		, m_depthTest		(depthTest)
+		, m_depthOrder		(depthOrder)
+		, m_alphaBlend		(alphaBlend)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			WIDTH			= 61,
+			HEIGHT			= 47,
+			NUM_ITERATIONS	= 20
+		};
+
+		const tcu::TextureFormat	colorFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::TextureFormat	depthFormat		(m_depthOrder, tcu::TextureFormat::UNSIGNED_INT_24_8);
+		tcu::TextureLevel			refColor		(colorFormat, m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			testColor		(colorFormat, m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			refDepth		(depthFormat, m_numSamples, WIDTH, HEIGHT);
+		tcu::TextureLevel			testDepth		(depthFormat, m_numSamples, WIDTH, HEIGHT);
+		const int					colorSize		= colorFormat.getPixelSize()*m_numSamples*WIDTH*HEIGHT;
+		const int					depthSize		= depthFormat.getPixelSize()*m_numSamples*WIDTH*HEIGHT;
+		de::Random					rnd				(deInt32Hash(m_numSamples) ^ (m_depthTest ? 0x71e2 : 0) ^ (m_alphaBlend ? 0x5b3a0 : 0) ^ (int)m_depthOrder);
+		rr::FragmentProcessor		refProcessor;
+		rr::FragmentProcessor		testProcessor;
+		std::vector<tcu::IVec2>		pixels;
+		std::vector<float>			sampleDepths	(WIDTH*HEIGHT*m_numSamples);
+		std::vector<rr::Fragment>	fragments;
+		deUint64					refTime			= 0;
+		deUint64					testTime		= 0;
+
+		refProcessor.setFastPathsEnabled(false);
+
+		// Random initial contents
+		for (int ndx = 0; ndx < colorSize; ndx++)
+			((deUint8*)refColor.getAccess().getDataPtr())[ndx] = (deUint8)rnd.getUint32();
+		for (int ndx = 0; ndx < depthSize; ndx++)
+			((deUint8*)refDepth.getAccess().getDataPtr())[ndx] = (deUint8)rnd.getUint32();
+
+		deMemcpy(testColor.getAccess().getDataPtr(), refColor.getAccess().getDataPtr(), colorSize);
+		deMemcpy(testDepth.getAccess().getDataPtr(), refDepth.getAccess().getDataPtr(), depthSize);
+
+		for (int y = 0; y < HEIGHT; y++)
+		for (int x = 0; x < WIDTH; x++)
+			pixels.push_back(tcu::IVec2(x, y));
+
+		for (int iterNdx = 0; iterNdx < NUM_ITERATIONS; iterNdx++)
+		{
+			rr::FragmentOperationState	state;
+			const int					numFragments	= rnd.getInt(1, WIDTH*HEIGHT);
+
+			state.depthTestEnabled		= m_depthTest;
+			state.depthFunc				= rr::TESTFUNC_LESS;
+			state.depthMask				= rnd.getInt(0, 3) != 0;
+			state.blendMode				= m_alphaBlend ? rr::BLENDMODE_STANDARD : rr::BLENDMODE_NONE;
+			state.blendRGBState.equation	= rr::BLENDEQUATION_ADD;
+			state.blendRGBState.srcFunc		= rr::BLENDFUNC_SRC_ALPHA;
+			state.blendRGBState.dstFunc		= rr::BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+			state.blendAState				= state.blendRGBState;
+			state.scissorTestEnabled	= (iterNdx % 2) == 1;
+			state.scissorRectangle		= rr::WindowRectangle(rnd.getInt(0, WIDTH/2), rnd.getInt(0, HEIGHT/2), rnd.getInt(1, WIDTH/2), rnd.getInt(1, HEIGHT/2));
+
+			// Fragments must not share pixels
+			rnd.shuffle(pixels.begin(), pixels.end());
+			fragments.resize(numFragments);
+
+			for (int fragNdx = 0; fragNdx < numFragments; fragNdx++)
+			{
+				const tcu::Vec4	value		(rnd.getFloat(-0.2f, 1.2f), rnd.getFloat(-0.2f, 1.2f), rnd.getFloat(-0.2f, 1.2f), rnd.getFloat(-0.2f, 1.2f));
+				const deUint32	coverage	= (rnd.getUint32() & ((1u << m_numSamples) - 1u)) | (1u << rnd.getInt(0, m_numSamples-1));
+				float* const	depths		= &sampleDepths[fragNdx*m_numSamples];
+
+				for (int sampleNdx = 0; sampleNdx < m_numSamples; sampleNdx++)
+					depths[sampleNdx] = rnd.getFloat(-0.1f, 1.1f);
+
+				fragments[fragNdx] = rr::Fragment(pixels[fragNdx], rr::GenericVec4(value), coverage, depths);
+			}
+
+			{
+				const deUint64 startTime = deGetMicroseconds();
+				refProcessor.render(rr::MultisamplePixelBufferAccess::fromMultisampleAccess(refColor.getAccess()),
+									rr::MultisamplePixelBufferAccess::fromMultisampleAccess(refDepth.getAccess()),
+									rr::MultisamplePixelBufferAccess(),
+									&fragments[0], numFragments, rr::FACETYPE_FRONT, state);
+				refTime += deGetMicroseconds() - startTime;
+			}
+
+			{
+				const deUint64 startTime = deGetMicroseconds();
+				testProcessor.render(rr::MultisamplePixelBufferAccess::fromMultisampleAccess(testColor.getAccess()),
+									 rr::MultisamplePixelBufferAccess::fromMultisampleAccess(testDepth.getAccess()),
+									 rr::MultisamplePixelBufferAccess(),
+									 &fragments[0], numFragments, rr::FACETYPE_FRONT, state);
+				testTime += deGetMicroseconds() - startTime;
+			}
+
+			if (deMemCmp(refColor.getAccess().getDataPtr(), testColor.getAccess().getDataPtr(), colorSize) != 0)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Color buffer differs after iteration " << iterNdx << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Color buffers differ");
+				return STOP;
+			}
+
+			if (deMemCmp(refDepth.getAccess().getDataPtr(), testDepth.getAccess().getDataPtr(), depthSize) != 0)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Depth buffer differs after iteration " << iterNdx << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Depth buffers differ");
+				return STOP;
+			}
+		}
+
+		m_testCtx.getLog() << TestLog::Message << "Generic pipeline: " << refTime << " us, fast path: " << testTime << " us" << TestLog::EndMessage;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+
+private:
+	const int								m_numSamples;
+	const bool								m_depthTest;
+	const tcu::TextureFormat::ChannelOrder	m_depthOrder;
+	const bool								m_alphaBlend;
+};
+
+class FragmentBatchShadingTest : public tcu::TestCase
+{
+public:
+	FragmentBatchShadingTest (tcu::TestContext& testCtx, const char* name, const char* description, rr::PrimitiveType primitiveType)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_primitiveType	(primitiveType)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::TextureFormat	colorFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		const tcu::TextureFormat	depthFormat		(tcu::TextureFormat::D, tcu::TextureFormat::UNSIGNED_INT_24_8);
+		tcu::TextureLevel			refColor		(colorFormat, 1, WIDTH, HEIGHT);
+		tcu::TextureLevel			refDepth		(depthFormat, 1, WIDTH, HEIGHT);
+		tcu::TextureLevel			testColor		(colorFormat, 1, WIDTH, HEIGHT);
+		tcu::TextureLevel			testDepth		(depthFormat, 1, WIDTH, HEIGHT);
+		std::vector<tcu::Vec4>		positions		(NUM_VERTICES);
+		std::vector<tcu::Vec4>		values0			(NUM_VERTICES);
+		std::vector<tcu::Vec4>		values1			(NUM_VERTICES);
+		de::Random					rnd				(deStringHash(getName()));
+		const struct
+		{
+			int		batchSize;
+			int		numThreads;
+		} configs[] =
+		{
+			{ 1,		1 },
+			{ 7,		1 },
+			{ 128,		1 },
+			{ 2048,		1 },
+			{ 7,		4 },
+		};
+
+		for (int vtxNdx = 0; vtxNdx < NUM_VERTICES; vtxNdx++)
+		{
+			positions[vtxNdx]	= tcu::Vec4(rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.0f, 1.0f), 1.0f);
+			values0[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+			values1[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+		}
+
+		render(refColor.getAccess(), refDepth.getAccess(), positions, values0, values1, false, rr::Renderer::DEFAULT_FRAGMENT_PACKET_BATCH_SIZE, 1);
+
+		for (int configNdx = 0; configNdx < DE_LENGTH_OF_ARRAY(configs); configNdx++)
+		{
+			const int colorSize = colorFormat.getPixelSize()*WIDTH*HEIGHT;
+			const int depthSize = depthFormat.getPixelSize()*WIDTH*HEIGHT;
+
+			m_testCtx.getLog() << TestLog::Message << "Batch shading with " << configs[configNdx].batchSize << " packets per batch, " << configs[configNdx].numThreads << " thread(s)" << TestLog::EndMessage;
+
+			render(testColor.getAccess(), testDepth.getAccess(), positions, values0, values1, true, configs[configNdx].batchSize, configs[configNdx].numThreads);
+
+			if (deMemCmp(refColor.getAccess().getDataPtr(), testColor.getAccess().getDataPtr(), colorSize) != 0 ||
+				deMemCmp(refDepth.getAccess().getDataPtr(), testDepth.getAccess().getDataPtr(), depthSize) != 0)
+			{
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Batch shading result differs from per-packet shading");
+				return STOP;
+			}
+		}
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH			= 150,
+		HEIGHT			= 110,
+		NUM_VERTICES	= 96
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(3, 2)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[2].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::VertexPacket& packet = *packets[packetNdx];
+
+				packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+				packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+				packet.outputs[1]	= rr::readVertexAttribFloat(inputs[2], packet.instanceNdx, packet.vertexNdx);
+				packet.pointSize	= 5.0f;
+			}
+		}
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (bool useBatches)
+			: rr::FragmentShader	(2, 1)
+			, m_useBatches			(useBatches)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+			{
+				const tcu::Vec4 v0 = rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx);
+				const tcu::Vec4 v1 = rr::readVarying<float>(packets[packetNdx], context, 1, fragNdx);
+
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, v0*v1.w() + v1*0.25f);
+			}
+		}
+
+		bool supportsFragmentBatches (void) const
+		{
+			return m_useBatches;
+		}
+
+		void shadeFragmentBatch (const rr::FragmentPacket* packets, const int numPackets, const rr::FragmentBatch& batch, const rr::FragmentShadingContext& context) const
+		{
+			const float* const v1w = batch.getVarying(1, 3);
+
+			DE_UNREF(packets);
+			DE_UNREF(context);
+			TCU_CHECK(batch.numFragments == numPackets*rr::NUM_FRAGMENTS_PER_PACKET);
+
+			for (int compNdx = 0; compNdx < 4; compNdx++)
+			{
+				const float* const	v0	= batch.getVarying(0, compNdx);
+				const float* const	v1	= batch.getVarying(1, compNdx);
+				float* const		out	= batch.getOutput(0, compNdx);
+
+				for (int fragNdx = 0; fragNdx < batch.numFragments; fragNdx++)
+					out[fragNdx] = v0[fragNdx]*v1w[fragNdx] + v1[fragNdx]*0.25f;
+			}
+		}
+
+	private:
+		const bool m_useBatches;
+	};
+
+	void render (const tcu::PixelBufferAccess& color, const tcu::PixelBufferAccess& depth, const std::vector<tcu::Vec4>& positions, const std::vector<tcu::Vec4>& values0, const std::vector<tcu::Vec4>& values1, bool useBatches, int batchSize, int numThreads) const
+	{
+		const VtxShader							vtxShader;
+		const FragShader						fragShader		(useBatches);
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color);
+		const rr::MultisamplePixelBufferAccess	depthAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depth);
+		const rr::RenderTarget					renderTarget	(colorAccess, depthAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &values0[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &values1[0]),
+		};
+		rr::RenderState							state			((rr::ViewportState(rr::WindowRectangle(0, 0, WIDTH, HEIGHT))));
+		rr::Renderer							renderer		(numThreads);
+
+		state.line.lineWidth			= 3.0f;
+		state.fragOps.depthTestEnabled	= true;
+		state.fragOps.depthFunc			= rr::TESTFUNC_LESS;
+
+		renderer.setFragmentPacketBatchSize(batchSize);
+		TCU_CHECK(renderer.getFragmentPacketBatchSize() == batchSize);
+
+		tcu::clear		(color, tcu::Vec4(0.0f));
+		tcu::clearDepth	(depth, 1.0f);
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(m_primitiveType, (int)positions.size(), 0)));
+	}
+
+	const rr::PrimitiveType		m_primitiveType;
+};
+
+class DrawBufferReuseTest : public tcu::TestCase
+{
+public:
+	DrawBufferReuseTest (tcu::TestContext& testCtx, const char* name, const char* description, int numThreads)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_numThreads		(numThreads)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		// Draws of varying size, type and varying count, so that buffers are both grown and reused
+		static const struct
+		{
+			rr::PrimitiveType	primitiveType;
+			int					numVertices;
+			int					numVaryings;
+		} draws[] =
+		{
+			{ rr::PRIMITIVETYPE_TRIANGLES,		300,	2	},
+			{ rr::PRIMITIVETYPE_TRIANGLES,		6,		1	},
+			{ rr::PRIMITIVETYPE_TRIANGLE_STRIP,	120,	2	},
+			{ rr::PRIMITIVETYPE_LINES,			200,	1	},
+			{ rr::PRIMITIVETYPE_POINTS,			50,		2	},
+			{ rr::PRIMITIVETYPE_TRIANGLE_FAN,	600,	1	},
+			{ rr::PRIMITIVETYPE_TRIANGLES,		3,		2	},
+			{ rr::PRIMITIVETYPE_LINE_LOOP,		40,		2	},
+		};
+
+		const tcu::TextureFormat	colorFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		const tcu::TextureFormat	depthFormat		(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT);
+		tcu::TextureLevel			refColor		(colorFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			refDepth		(depthFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			testColor		(colorFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			testDepth		(depthFormat, WIDTH, HEIGHT);
+		std::vector<tcu::Vec4>		positions		(MAX_VERTICES);
+		std::vector<tcu::Vec4>		values			(MAX_VERTICES);
+		de::Random					rnd				(deStringHash(getName()));
+		rr::Renderer				reusedRenderer	(m_numThreads);
+
+		for (int vtxNdx = 0; vtxNdx < MAX_VERTICES; vtxNdx++)
+		{
+			const float w = rnd.getFloat(0.5f, 2.0f);
+
+			// Some vertices are outside the clip volume to exercise clipping
+			positions[vtxNdx]	= tcu::Vec4(rnd.getFloat(-1.3f, 1.3f)*w, rnd.getFloat(-1.3f, 1.3f)*w, rnd.getFloat(-1.2f, 1.2f)*w, w);
+			values[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+		}
+
+		tcu::clear		(refColor.getAccess(), tcu::Vec4(0.0f));
+		tcu::clearDepth	(refDepth.getAccess(), 1.0f);
+		tcu::clear		(testColor.getAccess(), tcu::Vec4(0.0f));
+		tcu::clearDepth	(testDepth.getAccess(), 1.0f);
+
+		for (int drawNdx = 0; drawNdx < DE_LENGTH_OF_ARRAY(draws); drawNdx++)
+		{
+			const int			firstVertex		= rnd.getInt(0, MAX_VERTICES - draws[drawNdx].numVertices);
+			rr::Renderer		freshRenderer	(m_numThreads);
+
+			render(freshRenderer, refColor.getAccess(), refDepth.getAccess(), positions, values, draws[drawNdx].primitiveType, firstVertex, draws[drawNdx].numVertices, draws[drawNdx].numVaryings);
+			render(reusedRenderer, testColor.getAccess(), testDepth.getAccess(), positions, values, draws[drawNdx].primitiveType, firstVertex, draws[drawNdx].numVertices, draws[drawNdx].numVaryings);
+		}
+
+		m_testCtx.getLog() << TestLog::Message << "Rendered " << DE_LENGTH_OF_ARRAY(draws) << " draws with " << m_numThreads << " thread(s)" << TestLog::EndMessage;
+
+		if (deMemCmp(refColor.getAccess().getDataPtr(), testColor.getAccess().getDataPtr(), colorFormat.getPixelSize()*WIDTH*HEIGHT) == 0 &&
+			deMemCmp(refDepth.getAccess().getDataPtr(), testDepth.getAccess().getDataPtr(), depthFormat.getPixelSize()*WIDTH*HEIGHT) == 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Result of reused renderer differs from fresh renderers");
+
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH			= 200,
+		HEIGHT			= 150,
+		MAX_VERTICES	= 1024
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (int numVaryings)
+			: rr::VertexShader(2, numVaryings)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+
+			for (int outputNdx = 0; outputNdx < numVaryings; outputNdx++)
+				m_outputs[outputNdx].type = rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::VertexPacket&	packet	= *packets[packetNdx];
+				const tcu::Vec4		value	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+
+				packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+				packet.pointSize	= 1.0f + 12.0f*value.x();
+
+				for (int outputNdx = 0; outputNdx < (int)m_outputs.size(); outputNdx++)
+					packet.outputs[outputNdx] = value.swizzle((outputNdx+0)%4, (outputNdx+1)%4, (outputNdx+2)%4, (outputNdx+3)%4);
+			}
+		}
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (int numVaryings)
+			: rr::FragmentShader(numVaryings, 1)
+		{
+			for (int inputNdx = 0; inputNdx < numVaryings; inputNdx++)
+				m_inputs[inputNdx].type = rr::GENERICVECTYPE_FLOAT;
+
+			m_outputs[0].type = rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+			{
+				tcu::Vec4 color (0.0f);
+
+				for (int inputNdx = 0; inputNdx < (int)m_inputs.size(); inputNdx++)
+					color += rr::readVarying<float>(packets[packetNdx], context, inputNdx, fragNdx);
+
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, color);
+			}
+		}
+	};
+
+	static void render (rr::Renderer& renderer, const tcu::PixelBufferAccess& color, const tcu::PixelBufferAccess& depth, const std::vector<tcu::Vec4>& positions, const std::vector<tcu::Vec4>& values, rr::PrimitiveType primitiveType, int firstVertex, int numVertices, int numVaryings)
+	{
+		const VtxShader							vtxShader		(numVaryings);
+		const FragShader						fragShader		(numVaryings);
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(color);
+		const rr::MultisamplePixelBufferAccess	depthAccess		= rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(depth);
+		const rr::RenderTarget					renderTarget	(colorAccess, depthAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &values[0]),
+		};
+		rr::RenderState							state			((rr::ViewportState(rr::WindowRectangle(0, 0, WIDTH, HEIGHT))));
+
+		state.line.lineWidth			= 2.0f;
+		state.fragOps.depthTestEnabled	= true;
+		state.fragOps.depthFunc			= rr::TESTFUNC_LEQUAL;
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(primitiveType, numVertices, firstVertex)));
+	}
+
+	const int					m_numThreads;
+};
+
+class GuardBandClippingTest : public tcu::TestCase
+{
+public:
+	GuardBandClippingTest (tcu::TestContext& testCtx, const char* name, const char* description, bool depthClamp)
+		: tcu::TestCase		(testCtx, name, description)
+		, m_depthClamp		(depthClamp)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::TextureFormat	colorFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		const tcu::TextureFormat	stencilFormat	(tcu::TextureFormat::S, tcu::TextureFormat::UNSIGNED_INT8);
+		tcu::TextureLevel			fullColor		(colorFormat,	WIDTH, HEIGHT);
+		tcu::TextureLevel			fullStencil		(stencilFormat,	WIDTH, HEIGHT);
+		tcu::TextureLevel			guardColor		(colorFormat,	WIDTH, HEIGHT);
+		tcu::TextureLevel			guardStencil	(stencilFormat,	WIDTH, HEIGHT);
+		std::vector<tcu::Vec4>		positions		(NUM_VERTICES);
+		std::vector<tcu::Vec4>		colors			(NUM_VERTICES);
+		de::Random					rnd				(deStringHash(getName()));
+		rr::RenderStatistics		fullStats;
+		rr::RenderStatistics		guardStats;
+		int							numCoverageDiffs= 0;
+		int							numErrors		= 0;
+
+		// Mostly large triangles crossing side planes, some crossing near and far planes or w = 0
+		for (int vtxNdx = 0; vtxNdx < NUM_VERTICES; vtxNdx++)
+		{
+			const float w = (rnd.getInt(0, 15) == 0) ? rnd.getFloat(-0.5f, 0.5f) : rnd.getFloat(0.5f, 2.0f);
+
+			positions[vtxNdx]	= tcu::Vec4(rnd.getFloat(-3.0f, 3.0f)*w, rnd.getFloat(-3.0f, 3.0f)*w, rnd.getFloat(-1.2f, 1.2f)*w, w);
+			colors[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f);
+		}
+
+		fullStats	= render(fullColor.getAccess(), fullStencil.getAccess(), positions, colors, rr::CLIPMODE_FULL);
+		guardStats	= render(guardColor.getAccess(), guardStencil.getAccess(), positions, colors, rr::CLIPMODE_GUARD_BAND);
+
+		m_testCtx.getLog() << TestLog::Message
+						   << "Full clipping: " << fullStats.numTrivialAcceptedTriangles << " accepted, " << fullStats.numTrivialRejectedTriangles << " rejected, "
+						   << fullStats.numClippedTriangles << " clipped\n"
+						   << "Guard band clipping: " << guardStats.numTrivialAcceptedTriangles << " accepted, " << guardStats.numTrivialRejectedTriangles << " rejected, "
+						   << guardStats.numGuardBandTriangles << " within guard band, " << guardStats.numClippedTriangles << " clipped"
+						   << TestLog::EndMessage;
+
+		if (fullStats.numGuardBandTriangles != 0 || guardStats.numGuardBandTriangles == 0 ||
+			fullStats.numClippedTriangles != guardStats.numGuardBandTriangles + guardStats.numClippedTriangles ||
+			fullStats.numTrivialAcceptedTriangles != guardStats.numTrivialAcceptedTriangles ||
+			fullStats.numTrivialRejectedTriangles != guardStats.numTrivialRejectedTriangles ||
+			fullStats.numTrivialAcceptedTriangles + fullStats.numTrivialRejectedTriangles + fullStats.numClippedTriangles != (deUint64)NUM_VERTICES/3)
+		{
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Unexpected clipping statistics");
+			return STOP;
+		}
+
+		// Clipped vertices are rounded differently from guard band edges, so coverage may differ
+		// by one triangle along clipped edges. Elsewhere colors may only differ by interpolation error.
+		for (int y = 0; y < HEIGHT; y++)
+		for (int x = 0; x < WIDTH; x++)
+		{
+			const int	fullCount	= fullStencil.getAccess().getPixStencil(x, y);
+			const int	guardCount	= guardStencil.getAccess().getPixStencil(x, y);
+
+			if (fullCount != guardCount)
+			{
+				numCoverageDiffs += 1;
+
+				if (de::abs(fullCount - guardCount) > 1)
+					numErrors += 1;
+			}
+			else if (tcu::boolAny(tcu::greaterThan(tcu::abs(fullColor.getAccess().getPixel(x, y) - guardColor.getAccess().getPixel(x, y)), tcu::Vec4(0.01f))))
+				numErrors += 1;
+		}
+
+		m_testCtx.getLog() << TestLog::Message << "Coverage differs along clipped edges in " << numCoverageDiffs << " pixels" << TestLog::EndMessage;
+
+		if (numErrors != 0 || numCoverageDiffs > MAX_COVERAGE_DIFFS)
+		{
+			m_testCtx.getLog() << TestLog::Message << "FAIL: Found " << numErrors << " invalid pixels" << TestLog::EndMessage;
+			m_testCtx.getLog() << TestLog::ImageSet("Result", "Full vs. guard band clipping")
+							   << TestLog::Image("Full", "Full clipping", fullColor.getAccess())
+							   << TestLog::Image("GuardBand", "Guard band clipping", guardColor.getAccess())
+							   << TestLog::EndImageSet;
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Image comparison failed");
+		}
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH				= 160,
+		HEIGHT				= 120,
+		NUM_VERTICES		= 3*64,
+		MAX_COVERAGE_DIFFS	= WIDTH*HEIGHT/100
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(2, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::VertexPacket& packet = *packets[packetNdx];
+
+				packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+				packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+			}
+		}
+	};
+
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (void)
+			: rr::FragmentShader(1, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+		}
+	};
+
+	rr::RenderStatistics render (const tcu::PixelBufferAccess& color, const tcu::PixelBufferAccess& stencil, const std::vector<tcu::Vec4>& positions, const std::vector<tcu::Vec4>& colors, rr::ClipMode clipMode) const
+	{
+		const VtxShader							vtxShader;
+		const FragShader						fragShader;
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(color);
+		const rr::MultisamplePixelBufferAccess	stencilAccess	= rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(stencil);
+		const rr::RenderTarget					renderTarget	(colorAccess, rr::MultisamplePixelBufferAccess(), stencilAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &colors[0]),
+		};
+		rr::RenderState							state			((rr::ViewportState(rr::WindowRectangle(0, 0, WIDTH, HEIGHT))));
+		rr::Renderer							renderer		(1);
+
+		state.clipMode											= clipMode;
+		state.fragOps.depthClampEnabled							= m_depthClamp;
+		state.fragOps.stencilTestEnabled						= true;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].func		= rr::TESTFUNC_ALWAYS;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].dpPass	= rr::STENCILOP_INCR;
+		state.fragOps.stencilStates[rr::FACETYPE_FRONT]			= state.fragOps.stencilStates[rr::FACETYPE_BACK];
+
+		tcu::clear			(color, tcu::Vec4(0.0f));
+		tcu::clearStencil	(stencil, 0);
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, (int)positions.size(), 0)));
+
+		return renderer.getStatistics();
+	}
+
+	const bool					m_depthClamp;
+};
+
+static void fillRandomBytes (const tcu::PixelBufferAccess& access, de::Random& rnd)
+{
+	const int dataSize = access.getFormat().getPixelSize()*access.getWidth()*access.getHeight()*access.getDepth();
+
+	for (int ndx = 0; ndx < dataSize; ndx++)
+		((deUint8*)access.getDataPtr())[ndx] = (deUint8)rnd.getUint32();
+}
+
+class PixelRowAccessTest : public tcu::TestCase
+{
+public:
+	PixelRowAccessTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::TextureFormat formats[] =
+		{
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::BGRA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::LA,		tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::A,		tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::SNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RG,		tcu::TextureFormat::SNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_INT24),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_SHORT_565),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_SHORT_555),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_SHORT_4444),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_SHORT_5551),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_INT_101010),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT_1010102_REV),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNSIGNED_INT_1010102_REV),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNSIGNED_INT_11F_11F_10F_REV),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNSIGNED_INT_999_E5_REV),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::SIGNED_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RG,		tcu::TextureFormat::SIGNED_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::SIGNED_INT32),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNSIGNED_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNSIGNED_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::R,		tcu::TextureFormat::UNSIGNED_INT24),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNSIGNED_INT32),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::HALF_FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::L,		tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::S,		tcu::TextureFormat::UNSIGNED_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNSIGNED_INT_24_8),
+			tcu::TextureFormat(tcu::TextureFormat::DS,		tcu::TextureFormat::UNSIGNED_INT_24_8),
+			tcu::TextureFormat(tcu::TextureFormat::DS,		tcu::TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV),
+		};
+
+		de::Random	rnd			(0x7a3c1);
+		bool		allOk		= true;
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		{
+			const tcu::TextureFormat&	format	= formats[formatNdx];
+			const bool					ok		= checkFormat(format, rnd);
+
+			m_testCtx.getLog() << TestLog::Message << format << ": " << (ok ? "OK" : "FAIL") << TestLog::EndMessage;
+			allOk = allOk && ok;
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Row access differs from per-pixel access");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH	= 37,
+		HEIGHT	= 5,
+		DEPTH	= 2
+	};
+
+	template <typename T>
+	static bool compareRead (const tcu::ConstPixelBufferAccess& access, int x, int y, int z, int numPixels)
+	{
+		std::vector<tcu::Vector<T, 4> >	rowPixels	(numPixels);
+		std::vector<tcu::Vector<T, 4> >	pixels		(numPixels);
+
+		access.getPixelRowT<T>(x, y, z, numPixels, &rowPixels[0]);
+
+		for (int ndx = 0; ndx < numPixels; ndx++)
+			pixels[ndx] = access.getPixelT<T>(x+ndx, y, z);
+
+		// \note Compare bit patterns so that NaNs decoded from random data compare equal.
+		return deMemCmp(&rowPixels[0], &pixels[0], numPixels*sizeof(tcu::Vector<T, 4>)) == 0;
+	}
+
+	template <typename T>
+	static bool compareWrite (const tcu::PixelBufferAccess& rowAccess, const tcu::PixelBufferAccess& pixelAccess, const std::vector<tcu::Vector<T, 4> >& values, int x, int y, int z)
+	{
+		const int dataSize = rowAccess.getFormat().getPixelSize()*rowAccess.getWidth()*rowAccess.getHeight()*rowAccess.getDepth();
+
+		rowAccess.setPixelRow(&values[0], x, y, z, (int)values.size());
+
+		for (int ndx = 0; ndx < (int)values.size(); ndx++)
+			pixelAccess.setPixel(values[ndx], x+ndx, y, z);
+
+		return deMemCmp(rowAccess.getDataPtr(), pixelAccess.getDataPtr(), dataSize) == 0;
+	}
+
+	static bool checkFormat (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		// \note Per-pixel accessors don't support integer access to packed floating-point formats.
+		const bool				intOk		= format.type != tcu::TextureFormat::UNSIGNED_INT_11F_11F_10F_REV &&
+											  format.type != tcu::TextureFormat::UNSIGNED_INT_999_E5_REV;
+		tcu::TextureLevel		rowLevel	(format, WIDTH, HEIGHT, DEPTH);
+		tcu::TextureLevel		pixelLevel	(format, WIDTH, HEIGHT, DEPTH);
+		bool					ok			= true;
+
+		fillRandomBytes(rowLevel.getAccess(), rnd);
+		tcu::copy(pixelLevel.getAccess(), rowLevel.getAccess());
+
+		for (int iterNdx = 0; iterNdx < 32 && ok; iterNdx++)
+		{
+			const int	x			= rnd.getInt(0, WIDTH-1);
+			const int	y			= rnd.getInt(0, HEIGHT-1);
+			const int	z			= rnd.getInt(0, DEPTH-1);
+			const int	numPixels	= rnd.getInt(1, WIDTH-x);
+
+			// Floating-point access
+			{
+				std::vector<tcu::Vec4> values(numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+					values[ndx] = tcu::Vec4(rnd.getFloat(-1.5f, 300.0f), rnd.getFloat(-1.5f, 1.5f), rnd.getFloat(-0.5f, 1.5f), rnd.getFloat(-0.5f, 300.0f));
+
+				ok = ok && compareRead<float>(rowLevel.getAccess(), x, y, z, numPixels);
+				ok = ok && compareWrite(rowLevel.getAccess(), pixelLevel.getAccess(), values, x, y, z);
+			}
+
+			// Integer access
+			if (intOk)
+			{
+				std::vector<tcu::IVec4> values(numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+					values[ndx] = tcu::IVec4(rnd.getInt(-300, 70000), rnd.getInt(-2, 300), rnd.getInt(0, 1024), rnd.getInt(-1, 255));
+
+				ok = ok && compareRead<deInt32>(rowLevel.getAccess(), x, y, z, numPixels);
+				ok = ok && compareRead<deUint32>(rowLevel.getAccess(), x, y, z, numPixels);
+				ok = ok && compareWrite(rowLevel.getAccess(), pixelLevel.getAccess(), values, x, y, z);
+			}
+		}
+
+		return ok;
+	}
+};
+
+class CompiledSamplerTest : public tcu::TestCase
+{
+public:
+	CompiledSamplerTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::TextureFormat formats[] =
+		{
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_SHORT_565),
+			tcu::TextureFormat(tcu::TextureFormat::RG,		tcu::TextureFormat::SNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::HALF_FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::SIGNED_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNSIGNED_INT32),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNSIGNED_INT_24_8),
+		};
+
+		de::Random	rnd			(0x3c5e1);
+		bool		allOk		= true;
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		{
+			const tcu::TextureFormat&	format	= formats[formatNdx];
+			const bool					ok		= checkFormat(format, rnd);
+
+			m_testCtx.getLog() << TestLog::Message << format << ": " << (ok ? "OK" : "FAIL") << TestLog::EndMessage;
+			allOk = allOk && ok;
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Compiled sampler result differs from sampler result");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		SIZE			= 7,
+		NUM_LAYERS		= 3,
+		NUM_SAMPLERS	= 16,
+		NUM_LOOKUPS		= 24
+	};
+
+	static tcu::Sampler::WrapMode randomWrapMode (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		const tcu::Sampler::WrapMode mode = (tcu::Sampler::WrapMode)rnd.getInt(0, tcu::Sampler::WRAPMODE_LAST-1);
+
+		// \note Border color lookups are not supported for combined depth-stencil types.
+		if (mode == tcu::Sampler::CLAMP_TO_BORDER && tcu::isCombinedDepthStencilType(format.type))
+			return tcu::Sampler::CLAMP_TO_EDGE;
+		else
+			return mode;
+	}
+
+	static tcu::Sampler randomSampler (const tcu::TextureFormat& format, bool allowCompare, de::Random& rnd)
+	{
+		const bool				isDepth		= format.order == tcu::TextureFormat::D || format.order == tcu::TextureFormat::DS;
+		const bool				isInteger	= tcu::getTextureChannelClass(format.type) == tcu::TEXTURECHANNELCLASS_SIGNED_INTEGER ||
+											  tcu::getTextureChannelClass(format.type) == tcu::TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
+		// \note Integer textures are only filtered with nearest filtering.
+		const tcu::Sampler::FilterMode	minFilter	= isInteger ? (rnd.getBool() ? tcu::Sampler::NEAREST : tcu::Sampler::NEAREST_MIPMAP_NEAREST)
+															: (tcu::Sampler::FilterMode)rnd.getInt(0, tcu::Sampler::FILTERMODE_LAST-1);
+		const tcu::Sampler::FilterMode	magFilter	= isInteger ? tcu::Sampler::NEAREST
+															: (tcu::Sampler::FilterMode)rnd.getInt(tcu::Sampler::NEAREST, tcu::Sampler::LINEAR);
+		const tcu::Sampler::CompareMode	compare		= (allowCompare && isDepth && rnd.getBool()) ? (tcu::Sampler::CompareMode)rnd.getInt(1, tcu::Sampler::COMPAREMODE_LAST-1)
+																									: tcu::Sampler::COMPAREMODE_NONE;
+
+		return tcu::Sampler(randomWrapMode(format, rnd),
+							randomWrapMode(format, rnd),
+							randomWrapMode(format, rnd),
+							minFilter,
+							magFilter,
+							rnd.getBool() ? 0.0f : rnd.getFloat(-0.5f, 0.5f),
+							true,
+							compare,
+							0,
+							tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()),
+							rnd.getBool());
+	}
+
+	static bool isSameResult (float a, float b)
+	{
+		// \note Results must be bit-exact, except that NaN sign and payload depend on operand order chosen by the compiler.
+		return deMemCmp(&a, &b, sizeof(float)) == 0 || (tcu::Float32(a).isNaN() && tcu::Float32(b).isNaN());
+	}
+
+	static bool isSameResult (const tcu::Vec4& a, const tcu::Vec4& b)
+	{
+		for (int ndx = 0; ndx < 4; ndx++)
+		{
+			if (!isSameResult(a[ndx], b[ndx]))
+				return false;
+		}
+
+		return true;
+	}
+
+	static float getCoord (de::Random& rnd)
+	{
+		return rnd.getFloat(-1.5f, 2.5f);
+	}
+
+	static bool check2D (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		tcu::Texture2D	texture	(format, SIZE, SIZE);
+		bool			ok		= true;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+			fillRandomBytes(texture.getLevel(levelNdx), rnd);
+		}
+
+		for (int samplerNdx = 0; samplerNdx < NUM_SAMPLERS && ok; samplerNdx++)
+		{
+			const tcu::Sampler			sampler		= randomSampler(format, true, rnd);
+			const tcu::CompiledSampler	compiled	(sampler, format);
+			const tcu::Texture2DView	view		= texture;
+
+			for (int lookupNdx = 0; lookupNdx < NUM_LOOKUPS && ok; lookupNdx++)
+			{
+				const float			s		= getCoord(rnd);
+				const float			t		= getCoord(rnd);
+				const float			lod		= rnd.getFloat(-1.0f, 4.0f);
+				const float			ref		= rnd.getFloat();
+				const tcu::IVec2	offset	(rnd.getInt(-2, 2), rnd.getInt(-2, 2));
+
+				if (sampler.compare == tcu::Sampler::COMPAREMODE_NONE)
+				{
+					ok = ok && isSameResult(view.sample(sampler, s, t, lod), view.sample(compiled, s, t, lod));
+					ok = ok && isSameResult(view.sampleOffset(sampler, s, t, lod, offset), view.sampleOffset(compiled, s, t, lod, offset));
+				}
+				else
+				{
+					ok = ok && isSameResult(view.sampleCompare(sampler, ref, s, t, lod), view.sampleCompare(compiled, ref, s, t, lod));
+					ok = ok && isSameResult(view.sampleCompareOffset(sampler, ref, s, t, lod, offset), view.sampleCompareOffset(compiled, ref, s, t, lod, offset));
+				}
+			}
+		}
+
+		return ok;
+	}
+
+	static bool check2DArray (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		tcu::Texture2DArray	texture	(format, SIZE, SIZE, NUM_LAYERS);
+		bool				ok		= true;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+			fillRandomBytes(texture.getLevel(levelNdx), rnd);
+		}
+
+		for (int samplerNdx = 0; samplerNdx < NUM_SAMPLERS && ok; samplerNdx++)
+		{
+			const tcu::Sampler				sampler		= randomSampler(format, true, rnd);
+			const tcu::CompiledSampler		compiled	(sampler, format);
+			const tcu::Texture2DArrayView	view		= texture;
+
+			for (int lookupNdx = 0; lookupNdx < NUM_LOOKUPS && ok; lookupNdx++)
+			{
+				const float		s	= getCoord(rnd);
+				const float		t	= getCoord(rnd);
+				const float		r	= rnd.getFloat(-0.5f, (float)NUM_LAYERS + 0.5f);
+				const float		lod	= rnd.getFloat(-1.0f, 4.0f);
+				const float		ref	= rnd.getFloat();
+
+				if (sampler.compare == tcu::Sampler::COMPAREMODE_NONE)
+					ok = ok && isSameResult(view.sample(sampler, s, t, r, lod), view.sample(compiled, s, t, r, lod));
+				else
+					ok = ok && isSameResult(view.sampleCompare(sampler, ref, s, t, r, lod), view.sampleCompare(compiled, ref, s, t, r, lod));
+			}
+		}
+
+		return ok;
+	}
+
+	static bool check3D (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		tcu::Texture3D	texture	(format, SIZE, SIZE, SIZE);
+		bool			ok		= true;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+			fillRandomBytes(texture.getLevel(levelNdx), rnd);
+		}
+
+		for (int samplerNdx = 0; samplerNdx < NUM_SAMPLERS && ok; samplerNdx++)
+		{
+			const tcu::Sampler			sampler		= randomSampler(format, false, rnd);
+			const tcu::CompiledSampler	compiled	(sampler, format);
+			const tcu::Texture3DView	view		= texture;
+
+			for (int lookupNdx = 0; lookupNdx < NUM_LOOKUPS && ok; lookupNdx++)
+			{
+				const float	s	= getCoord(rnd);
+				const float	t	= getCoord(rnd);
+				const float	r	= getCoord(rnd);
+				const float	lod	= rnd.getFloat(-1.0f, 4.0f);
+
+				ok = ok && isSameResult(view.sample(sampler, s, t, r, lod), view.sample(compiled, s, t, r, lod));
+			}
+		}
+
+		return ok;
+	}
+
+	static bool checkCube (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		tcu::TextureCube	texture	(format, SIZE);
+		bool				ok		= true;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			for (int face = 0; face < tcu::CUBEFACE_LAST; face++)
+			{
+				texture.allocLevel((tcu::CubeFace)face, levelNdx);
+				fillRandomBytes(texture.getLevelFace(levelNdx, (tcu::CubeFace)face), rnd);
+			}
+		}
+
+		for (int samplerNdx = 0; samplerNdx < NUM_SAMPLERS && ok; samplerNdx++)
+		{
+			const tcu::Sampler			sampler		= randomSampler(format, true, rnd);
+			const tcu::CompiledSampler	compiled	(sampler, format);
+			const tcu::TextureCubeView	view		= texture;
+
+			for (int lookupNdx = 0; lookupNdx < NUM_LOOKUPS && ok; lookupNdx++)
+			{
+				const float	s	= rnd.getFloat(-1.0f, 1.0f);
+				const float	t	= rnd.getFloat(-1.0f, 1.0f);
+				const float	r	= rnd.getBool() ? 1.0f : -1.0f;
+				const float	lod	= rnd.getFloat(-1.0f, 4.0f);
+				const float	ref	= rnd.getFloat();
+
+				if (sampler.compare == tcu::Sampler::COMPAREMODE_NONE)
+					ok = ok && isSameResult(view.sample(sampler, s, t, r, lod), view.sample(compiled, s, t, r, lod));
+				else
+					ok = ok && isSameResult(view.sampleCompare(sampler, ref, s, t, r, lod), view.sampleCompare(compiled, ref, s, t, r, lod));
+			}
+		}
+
+		return ok;
+	}
+
+	static bool checkCubeArray (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		tcu::TextureCubeArray	texture	(format, SIZE, NUM_LAYERS*6);
+		bool					ok		= true;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+			fillRandomBytes(texture.getLevel(levelNdx), rnd);
+		}
+
+		for (int samplerNdx = 0; samplerNdx < NUM_SAMPLERS && ok; samplerNdx++)
+		{
+			const tcu::Sampler					sampler			= randomSampler(format, true, rnd);
+			const tcu::CompiledSampler			compiled		(sampler, format);
+			const tcu::TextureCubeArrayView		view			= texture;
+			tcu::Sampler						faceSampler		= sampler;
+
+			// \note Offset lookups sample within the selected face.
+			faceSampler.seamlessCubeMap = false;
+
+			const tcu::CompiledSampler			faceCompiled	(faceSampler, format);
+
+			for (int lookupNdx = 0; lookupNdx < NUM_LOOKUPS && ok; lookupNdx++)
+			{
+				const float	s	= rnd.getFloat(-1.0f, 1.0f);
+				const float	t	= rnd.getBool() ? 1.0f : -1.0f;
+				const float	r	= rnd.getFloat(-1.0f, 1.0f);
+				const float	q	= rnd.getFloat(-0.5f, (float)NUM_LAYERS + 0.5f);
+				const float	lod	= rnd.getFloat(-1.0f, 4.0f);
+				const float	ref	= rnd.getFloat();
+
+				if (sampler.compare == tcu::Sampler::COMPAREMODE_NONE)
+					ok = ok && isSameResult(view.sample(sampler, s, t, r, q, lod), view.sample(compiled, s, t, r, q, lod));
+				else
+				{
+					const tcu::IVec2				offset		(rnd.getInt(-8, 7), rnd.getInt(-8, 7));
+					const tcu::CubeFaceFloatCoords	coords		= tcu::getCubeFaceCoords(tcu::Vec3(s, t, r));
+					const int						layer		= de::clamp(deFloorFloatToInt32(q + 0.5f), 0, NUM_LAYERS-1);
+					const int						faceDepth	= layer*6 + tcu::getCubeArrayFaceIndex(coords.face);
+					const float						offsetRef	= tcu::sampleLevelArray2DCompare(view.getLevels(), view.getNumLevels(), faceSampler, ref, coords.s, coords.t, lod, tcu::IVec3(offset.x(), offset.y(), faceDepth));
+
+					ok = ok && isSameResult(view.sampleCompare(sampler, ref, s, t, r, q, lod), view.sampleCompare(compiled, ref, s, t, r, q, lod));
+					ok = ok && isSameResult(offsetRef, view.sampleCompareOffset(faceCompiled, ref, s, t, r, q, lod, offset));
+				}
+			}
+		}
+
+		return ok;
+	}
+
+	static bool checkFormat (const tcu::TextureFormat& format, de::Random& rnd)
+	{
+		return check2D(format, rnd)			&&
+			   check2DArray(format, rnd)	&&
+			   check3D(format, rnd)			&&
+			   checkCube(format, rnd)		&&
+			   checkCubeArray(format, rnd);
+	}
+};
+
+class ImageCompareThreadsTest : public tcu::TestCase
+{
+public:
+	ImageCompareThreadsTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::TextureFormat	rgba8Format		(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::TextureFormat	floatFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		tcu::TextureLevel			reference8		(rgba8Format, WIDTH, HEIGHT);
+		tcu::TextureLevel			result8			(rgba8Format, WIDTH, HEIGHT);
+		tcu::TextureLevel			referenceFloat	(floatFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			resultFloat		(floatFormat, WIDTH, HEIGHT);
+		de::Random					rnd				(0x51f2a);
+		const int					prevNumThreads	= tcu::getImageCompareNumThreads();
+		Results						singleThreaded;
+		Results						multiThreaded;
+		bool						allOk			= true;
+
+		fillImages(reference8, result8, referenceFloat, resultFloat, rnd);
+
+		try
+		{
+			tcu::setImageCompareNumThreads(1);
+			compareImages(reference8, result8, referenceFloat, resultFloat, singleThreaded);
+
+			tcu::setImageCompareNumThreads(NUM_THREADS);
+			compareImages(reference8, result8, referenceFloat, resultFloat, multiThreaded);
+		}
+		catch (...)
+		{
+			tcu::setImageCompareNumThreads(prevNumThreads);
+			throw;
+		}
+
+		tcu::setImageCompareNumThreads(prevNumThreads);
+
+		for (int ndx = 0; ndx < NUM_COMPARES; ndx++)
+		{
+			const bool expected = getExpectedResult(reference8, result8, referenceFloat, resultFloat, ndx);
+
+			if (singleThreaded.isOk[ndx] != expected || multiThreaded.isOk[ndx] != expected)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Comparison " << ndx << ": expected " << (expected ? "pass" : "fail")
+													   << ", got " << (singleThreaded.isOk[ndx] ? "pass" : "fail") << " with 1 thread and "
+													   << (multiThreaded.isOk[ndx] ? "pass" : "fail") << " with " << NUM_THREADS << " threads" << TestLog::EndMessage;
+				allOk = false;
+			}
+		}
+
+		for (int ndx = 0; ndx < NUM_FUZZY_PARAMS; ndx++)
+		{
+			if (tcu::Float32(singleThreaded.fuzzyDiff[ndx]).bits() != tcu::Float32(multiThreaded.fuzzyDiff[ndx]).bits() ||
+				!isSameData(singleThreaded.fuzzyMask[ndx], multiThreaded.fuzzyMask[ndx]))
+			{
+				m_testCtx.getLog() << TestLog::Message << "Fuzzy comparison " << ndx << " differs: " << singleThreaded.fuzzyDiff[ndx] << " with 1 thread, "
+													   << multiThreaded.fuzzyDiff[ndx] << " with " << NUM_THREADS << " threads" << TestLog::EndMessage;
+				allOk = false;
+			}
+		}
+
+		if (singleThreaded.bilinearOk != multiThreaded.bilinearOk || !isSameData(singleThreaded.bilinearMask, multiThreaded.bilinearMask))
+		{
+			m_testCtx.getLog() << TestLog::Message << "Bilinear comparison differs" << TestLog::EndMessage;
+			allOk = false;
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Comparison results depend on number of threads");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH				= 512,
+		HEIGHT				= 256,
+		NUM_THREADS			= 4,
+		NUM_COMPARES		= 5,
+		NUM_FUZZY_PARAMS	= 2
+	};
+
+	struct Results
+	{
+		bool				isOk[NUM_COMPARES];
+		float				fuzzyDiff[NUM_FUZZY_PARAMS];
+		tcu::TextureLevel	fuzzyMask[NUM_FUZZY_PARAMS];
+		bool				bilinearOk;
+		tcu::TextureLevel	bilinearMask;
+	};
+
+	static void fillImages (const tcu::PixelBufferAccess& reference8, const tcu::PixelBufferAccess& result8, const tcu::PixelBufferAccess& referenceFloat, const tcu::PixelBufferAccess& resultFloat, de::Random& rnd)
+	{
+		for (int y = 0; y < HEIGHT; y++)
+		for (int x = 0; x < WIDTH; x++)
+		{
+			const tcu::IVec4	gradient	((x + y) & 0xff, (x*2) & 0xff, (y*3) & 0xff, 0xff);
+			const tcu::IVec4	noise		(rnd.getInt(-2, 2), rnd.getInt(-2, 2), rnd.getInt(-2, 2), 0);
+			const tcu::Vec4		value		(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f);
+
+			reference8.setPixel(gradient, x, y);
+			result8.setPixel(tcu::clamp(gradient + noise, tcu::IVec4(0), tcu::IVec4(0xff)), x, y);
+
+			referenceFloat.setPixel(value, x, y);
+			resultFloat.setPixel(value + tcu::Vec4(rnd.getFloat(-0.01f, 0.01f), rnd.getFloat(-0.01f, 0.01f), 0.0f, 0.0f), x, y);
+		}
+
+		// Outlier in the last row band
+		result8.setPixel(tcu::IVec4(0xff, 0, 0xff, 0xff), WIDTH-3, HEIGHT-2);
+
+		// NaN in the middle of the image; maximum difference is reset by the following pixels
+		{
+			tcu::Vec4 value = resultFloat.getPixel(WIDTH/2, HEIGHT/2);
+
+			value.x() = tcu::Float32::nan().asFloat();
+			resultFloat.setPixel(value, WIDTH/2, HEIGHT/2);
+		}
+	}
+
+	void compareImages (const tcu::ConstPixelBufferAccess& reference8, const tcu::ConstPixelBufferAccess& result8, const tcu::ConstPixelBufferAccess& referenceFloat, const tcu::ConstPixelBufferAccess& resultFloat, Results& results)
+	{
+		TestLog& log = m_testCtx.getLog();
+
+		results.isOk[0] = tcu::intThresholdCompare(log, "IntThreshold", "", reference8, result8, tcu::UVec4(2), tcu::COMPARE_LOG_ON_ERROR);
+		results.isOk[1] = tcu::intThresholdCompare(log, "IntThreshold", "", reference8, result8, tcu::UVec4(0xff), tcu::COMPARE_LOG_ON_ERROR);
+		results.isOk[2] = tcu::floatThresholdCompare(log, "FloatThreshold", "", referenceFloat, resultFloat, tcu::Vec4(0.01f), tcu::COMPARE_LOG_ON_ERROR);
+		results.isOk[3] = tcu::floatThresholdCompare(log, "FloatThreshold", "", referenceFloat, resultFloat, tcu::Vec4(0.005f), tcu::COMPARE_LOG_ON_ERROR);
+		results.isOk[4] = tcu::floatThresholdCompare(log, "FloatThreshold", "", tcu::Vec4(0.5f), resultFloat, tcu::Vec4(0.52f), tcu::COMPARE_LOG_ON_ERROR);
+
+		for (int ndx = 0; ndx < NUM_FUZZY_PARAMS; ndx++)
+		{
+			tcu::FuzzyCompareParams params;
+
+			if (ndx == 1)
+				params.maxSampleSkip = 0;
+
+			results.fuzzyMask[ndx].setStorage(tcu::TextureFormat(tcu::TextureFormat::RGB, tcu::TextureFormat::UNORM_INT8), WIDTH, HEIGHT);
+			results.fuzzyDiff[ndx] = tcu::fuzzyCompare(params, reference8, result8, results.fuzzyMask[ndx]);
+		}
+
+		results.bilinearMask.setStorage(tcu::TextureFormat(tcu::TextureFormat::RGB, tcu::TextureFormat::UNORM_INT8), WIDTH, HEIGHT);
+		results.bilinearOk = tcu::bilinearCompare(reference8, result8, results.bilinearMask, tcu::RGBA(2, 2, 2, 2));
+	}
+
+	// Serial evaluation of the comparison metrics
+	static bool getExpectedResult (const tcu::ConstPixelBufferAccess& reference8, const tcu::ConstPixelBufferAccess& result8, const tcu::ConstPixelBufferAccess& referenceFloat, const tcu::ConstPixelBufferAccess& resultFloat, int compareNdx)
+	{
+		if (compareNdx < 2)
+		{
+			const tcu::UVec4	threshold	= (compareNdx == 0) ? tcu::UVec4(2) : tcu::UVec4(0xff);
+			tcu::UVec4			maxDiff		(0);
+
+			for (int y = 0; y < HEIGHT; y++)
+			for (int x = 0; x < WIDTH; x++)
+				maxDiff = tcu::max(maxDiff, tcu::abs(reference8.getPixelInt(x, y) - result8.getPixelInt(x, y)).cast<deUint32>());
+
+			return tcu::boolAll(tcu::lessThanEqual(maxDiff, threshold));
+		}
+		else
+		{
+			const tcu::Vec4		threshold	= (compareNdx == 2) ? tcu::Vec4(0.01f) : (compareNdx == 3) ? tcu::Vec4(0.005f) : tcu::Vec4(0.52f);
+			tcu::Vec4			maxDiff		(0.0f);
+
+			for (int y = 0; y < HEIGHT; y++)
+			for (int x = 0; x < WIDTH; x++)
+			{
+				const tcu::Vec4 reference = (compareNdx == 4) ? tcu::Vec4(0.5f) : referenceFloat.getPixel(x, y);
+				maxDiff = tcu::max(maxDiff, tcu::abs(reference - resultFloat.getPixel(x, y)));
+			}
+
+			return tcu::boolAll(tcu::lessThanEqual(maxDiff, threshold));
+		}
+	}
+
+	static bool isSameData (const tcu::TextureLevel& a, const tcu::TextureLevel& b)
+	{
+		return deMemCmp(a.getAccess().getDataPtr(), b.getAccess().getDataPtr(), a.getFormat().getPixelSize()*a.getWidth()*a.getHeight()) == 0;
+	}
+};
+
+class TexLookupBatchTest : public tcu::TestCase
+{
+public:
+	TexLookupBatchTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		TestLog&					log				= m_testCtx.getLog();
+		const tcu::TextureFormat	texFormat		(tcu::TextureFormat::sRGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::TextureFormat	floatFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		const tcu::TextureFormat	maskFormat		(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::Sampler			sampler			(tcu::Sampler::REPEAT_GL, tcu::Sampler::MIRRORED_REPEAT_GL, tcu::Sampler::CLAMP_TO_EDGE,
+													 tcu::Sampler::LINEAR_MIPMAP_LINEAR, tcu::Sampler::LINEAR);
+		tcu::Texture2D				texture			(texFormat, TEXTURE_SIZE, TEXTURE_SIZE);
+		tcu::TextureLevel			results			(floatFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			coords			(floatFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			lodBounds		(floatFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			verifyMask		(maskFormat, WIDTH, HEIGHT);
+		tcu::TextureLevel			expectedMask	(maskFormat, WIDTH, HEIGHT);
+		de::Random					rnd				(0x7b1d4);
+		tcu::LookupPrecision		prec;
+		int							expectedChecked	= 0;
+		int							expectedFailed	= 0;
+		bool						allOk			= true;
+
+		prec.coordBits		= tcu::IVec3(20, 20, 0);
+		prec.uvwBits		= tcu::IVec3(7, 7, 0);
+		prec.colorThreshold	= tcu::Vec4(2.0f / 255.0f);
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+			tcu::fillWithComponentGradients(texture.getLevel(levelNdx), tcu::Vec4(0.0f), tcu::Vec4(1.0f, 0.5f, 0.25f, 1.0f));
+		}
+
+		tcu::clear(expectedMask.getAccess(), tcu::RGBA::green.toVec());
+
+		// Mix of exact lookups and random colors; serial per-pixel verification gives the expected result.
+		for (int y = 0; y < HEIGHT; y++)
+		for (int x = 0; x < WIDTH; x++)
+		{
+			const tcu::Vec2		coord		(rnd.getFloat(-1.0f, 2.0f), rnd.getFloat(-1.0f, 2.0f));
+			const float			lod			= rnd.getFloat(-1.0f, (float)texture.getNumLevels());
+			const tcu::Vec2		lodRange	(lod - 0.1f, lod + 0.1f);
+			const tcu::Vec4		result		= rnd.getInt(0, 3) == 0 ? tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f)
+																	: texture.sample(sampler, coord.x(), coord.y(), lod);
+			const bool			verify		= rnd.getInt(0, 3) != 0;
+
+			results.getAccess().setPixel(result, x, y);
+			coords.getAccess().setPixel(coord.toWidth<4>(), x, y);
+			lodBounds.getAccess().setPixel(lodRange.toWidth<4>(), x, y);
+			verifyMask.getAccess().setPixel(tcu::Vec4(verify ? 1.0f : 0.0f), x, y);
+
+			if (verify)
+			{
+				expectedChecked += 1;
+
+				if (!tcu::isLookupResultValid(texture, sampler, prec, coord, lodRange, result))
+				{
+					expectedMask.getAccess().setPixel(tcu::RGBA::red.toVec(), x, y);
+					expectedFailed += 1;
+				}
+			}
+		}
+
+		log << TestLog::Message << "Expecting " << expectedFailed << " of " << expectedChecked << " lookups to fail" << TestLog::EndMessage;
+
+		{
+			const tcu::LookupBatch	batch			(results, coords, lodBounds, verifyMask);
+			const int				prevNumThreads	= tcu::getImageCompareNumThreads();
+
+			try
+			{
+				for (int numThreads = 1; numThreads <= NUM_THREADS; numThreads += NUM_THREADS-1)
+				{
+					tcu::TextureLevel			errorMask	(maskFormat, WIDTH, HEIGHT);
+					tcu::TextureLevel			earlyMask	(maskFormat, WIDTH, HEIGHT);
+					tcu::LookupBatchResult		result;
+					tcu::LookupBatchResult		earlyResult;
+
+					tcu::setImageCompareNumThreads(numThreads);
+
+					tcu::clear(errorMask.getAccess(), tcu::RGBA::green.toVec());
+					result = tcu::verifyLookupBatch(texture, sampler, prec, batch, errorMask);
+
+					if (result.numChecked != expectedChecked || result.numFailed != expectedFailed || !isSameData(errorMask, expectedMask))
+					{
+						log << TestLog::Message << "Batch verification with " << numThreads << " threads: got " << result.numFailed
+												<< " of " << result.numChecked << " lookups failing" << TestLog::EndMessage;
+						allOk = false;
+					}
+
+					tcu::clear(earlyMask.getAccess(), tcu::RGBA::green.toVec());
+					earlyResult = tcu::verifyLookupBatch(texture, sampler, prec, batch, earlyMask, MAX_FAILURES);
+
+					if ((earlyResult.numFailed >= MAX_FAILURES) != (expectedFailed >= MAX_FAILURES) || !isSubsetOf(earlyMask, expectedMask))
+					{
+						log << TestLog::Message << "Early-out batch verification with " << numThreads << " threads: got " << earlyResult.numFailed
+												<< " of " << earlyResult.numChecked << " lookups failing" << TestLog::EndMessage;
+						allOk = false;
+					}
+				}
+			}
+			catch (...)
+			{
+				tcu::setImageCompareNumThreads(prevNumThreads);
+				throw;
+			}
+
+			tcu::setImageCompareNumThreads(prevNumThreads);
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Batch verification result differs from per-pixel verification");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		TEXTURE_SIZE	= 16,
+		WIDTH			= 80,
+		HEIGHT			= 56,
+		NUM_THREADS		= 4,
+		MAX_FAILURES	= 8
+	};
+
+	static bool isSameData (const tcu::TextureLevel& a, const tcu::TextureLevel& b)
+	{
+		return deMemCmp(a.getAccess().getDataPtr(), b.getAccess().getDataPtr(), a.getFormat().getPixelSize()*a.getWidth()*a.getHeight()) == 0;
+	}
+
+	//! Check that every pixel marked red in a is also red in b.
+	static bool isSubsetOf (const tcu::TextureLevel& a, const tcu::TextureLevel& b)
+	{
+		for (int y = 0; y < a.getHeight(); y++)
+		for (int x = 0; x < a.getWidth(); x++)
+		{
+			if (a.getAccess().getPixel(x, y).x() != 0.0f && b.getAccess().getPixel(x, y).x() == 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+};
+
+class TexDecompressionThreadsTest : public tcu::TestCase
+{
+public:
+	TexDecompressionThreadsTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const struct
+		{
+			const char*								name;
+			tcu::CompressedTexFormat				format;
+			tcu::TexDecompressionParams::AstcMode	astcMode;
+		} formats[] =
+		{
+			{ "ETC2 RGB8",			tcu::COMPRESSEDTEXFORMAT_ETC2_RGB8,					tcu::TexDecompressionParams::ASTCMODE_LAST	},
+			{ "ETC2 EAC RGBA8",		tcu::COMPRESSEDTEXFORMAT_ETC2_EAC_RGBA8,			tcu::TexDecompressionParams::ASTCMODE_LAST	},
+			{ "EAC signed RG11",	tcu::COMPRESSEDTEXFORMAT_EAC_SIGNED_RG11,			tcu::TexDecompressionParams::ASTCMODE_LAST	},
+			{ "ASTC 4x4",			tcu::COMPRESSEDTEXFORMAT_ASTC_4x4_RGBA,				tcu::TexDecompressionParams::ASTCMODE_LDR	},
+			{ "ASTC 6x5 sRGB",		tcu::COMPRESSEDTEXFORMAT_ASTC_6x5_SRGB8_ALPHA8,		tcu::TexDecompressionParams::ASTCMODE_LDR	},
+			{ "ASTC 12x10",			tcu::COMPRESSEDTEXFORMAT_ASTC_12x10_RGBA,			tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		};
+
+		const int	prevNumThreads	= tcu::getImageCompareNumThreads();
+		de::Random	rnd				(0x7d3a1);
+		bool		allOk			= true;
+
+		try
+		{
+			for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+			{
+				const tcu::CompressedTexFormat		format		= formats[formatNdx].format;
+				const tcu::TexDecompressionParams	params		(formats[formatNdx].astcMode);
+				tcu::CompressedTexture				texture		(format, WIDTH, HEIGHT);
+				tcu::TextureLevel					reference	(tcu::getUncompressedFormat(format), WIDTH, HEIGHT);
+				tcu::TextureLevel					singleThreaded;
+				tcu::TextureLevel					multiThreaded;
+
+				for (int byteNdx = 0; byteNdx < texture.getDataSize(); byteNdx++)
+					((deUint8*)texture.getData())[byteNdx] = rnd.getUint8();
+
+				tcu::setImageCompareNumThreads(1);
+				decompressBlocks(texture, reference, params);
+				decompressPadded(texture, singleThreaded, params);
+
+				tcu::setImageCompareNumThreads(NUM_THREADS);
+				decompressPadded(texture, multiThreaded, params);
+
+				if (!isSameData(getPaddedRegion(singleThreaded), reference) || !isSameData(getPaddedRegion(multiThreaded), reference))
+				{
+					m_testCtx.getLog() << TestLog::Message << formats[formatNdx].name << ": decompression result differs from per-block decompression" << TestLog::EndMessage;
+					allOk = false;
+				}
+			}
+		}
+		catch (...)
+		{
+			tcu::setImageCompareNumThreads(prevNumThreads);
+			throw;
+		}
+
+		tcu::setImageCompareNumThreads(prevNumThreads);
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Decompression results differ");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		WIDTH		= 517,
+		HEIGHT		= 263,
+		PADDING		= 3,
+		NUM_THREADS	= 4
+	};
+
+	//! Decompress each block separately into a scratch buffer
+	static void decompressBlocks (const tcu::CompressedTexture& texture, tcu::TextureLevel& dst, const tcu::TexDecompressionParams& params)
+	{
+		const tcu::CompressedTexFormat	format			= texture.getFormat();
+		const tcu::IVec3				blockSize		= tcu::getBlockPixelSize(format);
+		const int						numBlocksX		= (WIDTH + blockSize.x() - 1) / blockSize.x();
+		const int						numBlocksY		= (HEIGHT + blockSize.y() - 1) / blockSize.y();
+		tcu::TextureLevel				block			(dst.getFormat(), blockSize.x(), blockSize.y());
+
+		for (int blockY = 0; blockY < numBlocksY; blockY++)
+		for (int blockX = 0; blockX < numBlocksX; blockX++)
+		{
+			const int	x		= blockX*blockSize.x();
+			const int	y		= blockY*blockSize.y();
+			const int	width	= de::min(blockSize.x(), WIDTH - x);
+			const int	height	= de::min(blockSize.y(), HEIGHT - y);
+
+			tcu::decompress(block.getAccess(), format, (const deUint8*)texture.getData() + (blockY*numBlocksX + blockX)*tcu::getBlockSize(format), params);
+			tcu::copy(tcu::getSubregion(dst.getAccess(), x, y, width, height), tcu::getSubregion(block.getAccess(), 0, 0, width, height));
+		}
+	}
+
+	//! Decompress into the middle of a larger image with a row pitch wider than the texture, bypassing the decompressed texture cache
+	static void decompressPadded (const tcu::CompressedTexture& texture, tcu::TextureLevel& dst, const tcu::TexDecompressionParams& params)
+	{
+		dst.setStorage(tcu::getUncompressedFormat(texture.getFormat()), WIDTH + 2*PADDING, HEIGHT + 2*PADDING);
+		tcu::decompress(getPaddedRegion(dst), texture.getFormat(), (const deUint8*)texture.getData(), params);
+	}
+
+	static tcu::PixelBufferAccess getPaddedRegion (tcu::TextureLevel& level)
+	{
+		return tcu::getSubregion(level.getAccess(), PADDING, PADDING, WIDTH, HEIGHT);
+	}
+
+	static bool isSameData (const tcu::ConstPixelBufferAccess& a, const tcu::TextureLevel& b)
+	{
+		const int rowSize = a.getFormat().getPixelSize()*a.getWidth();
+
+		for (int y = 0; y < a.getHeight(); y++)
+		{
+			if (deMemCmp(a.getPixelPtr(0, y), b.getAccess().getPixelPtr(0, y), rowSize) != 0)
+				return false;
+		}
+
+		return true;
+	}
+};
+
+class DecompressedTextureCacheTest : public tcu::TestCase
+{
+public:
+	DecompressedTextureCacheTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase(testCtx, name, description)
+		, m_allOk		(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const size_t	prevCacheSize	= tcu::getDecompressedTextureCacheSize();
+		de::Random		rnd				(0x3c1d5);
+
+		m_allOk = true;
+
+		try
+		{
+			runChecks(rnd);
+		}
+		catch (...)
+		{
+			tcu::setDecompressedTextureCacheSize(prevCacheSize);
+			throw;
+		}
+
+		tcu::setDecompressedTextureCacheSize(prevCacheSize);
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected cache behavior");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		SIZE			= 64,
+		ENTRY_SIZE		= SIZE*SIZE*3 + (SIZE/4)*(SIZE/4)*8	//!< Decoded ETC2 RGB8 texels and compressed data
+	};
+
+	void runChecks (de::Random& rnd)
+	{
+		const tcu::TexDecompressionParams	ldrParams	(tcu::TexDecompressionParams::ASTCMODE_LDR);
+		tcu::CompressedTexture				textures[3];
+
+		for (int texNdx = 0; texNdx < DE_LENGTH_OF_ARRAY(textures); texNdx++)
+		{
+			textures[texNdx].setStorage(tcu::COMPRESSEDTEXFORMAT_ETC2_RGB8, SIZE, SIZE);
+
+			for (int byteNdx = 0; byteNdx < textures[texNdx].getDataSize(); byteNdx++)
+				((deUint8*)textures[texNdx].getData())[byteNdx] = rnd.getUint8();
+		}
+
+		// Drop existing entries, room for two textures
+		tcu::setDecompressedTextureCacheSize(0);
+		tcu::setDecompressedTextureCacheSize(3*ENTRY_SIZE - 1);
+
+		{
+			const tcu::DecompressedTextureCacheStats	initial		= tcu::getDecompressedTextureCacheStats();
+			const tcu::DecompressedTexture				first		= tcu::getDecompressedTexture(textures[0]);
+			const tcu::DecompressedTexture				second		= tcu::getDecompressedTexture(textures[0], ldrParams);
+
+			expect(getDelta(initial).numMisses == 1 && getDelta(initial).numHits == 1, "Second lookup of the same texture is a hit");
+			expect(first.getAccess().getDataPtr() == second.getAccess().getDataPtr(), "Hits share decoded texels");
+			expect(isDecodedCorrectly(textures[0], first), "Cached texels match decompression result");
+
+			tcu::getDecompressedTexture(textures[1]);
+			tcu::getDecompressedTexture(textures[0]);
+			tcu::getDecompressedTexture(textures[2]);
+
+			expect(getDelta(initial).numEvictions == 1 && tcu::getDecompressedTextureCacheStats().numEntries == 2, "Third texture evicts one entry");
+			expect(isDecodedCorrectly(textures[0], first), "Borrowed texels stay valid");
+
+			tcu::getDecompressedTexture(textures[0]);
+			expect(getDelta(initial).numHits == 3, "Most recently used texture is kept");
+
+			tcu::getDecompressedTexture(textures[1]);
+			expect(getDelta(initial).numMisses == 4, "Least recently used texture is evicted");
+		}
+
+		// Changed contents
+		{
+			const tcu::DecompressedTextureCacheStats initial = tcu::getDecompressedTextureCacheStats();
+
+			((deUint8*)textures[1].getData())[0] ^= 0xff;
+
+			expect(isDecodedCorrectly(textures[1], tcu::getDecompressedTexture(textures[1])) && getDelta(initial).numMisses == 1, "Changed compressed data is a miss");
+		}
+
+		// Textures larger than the budget are not cached
+		{
+			tcu::setDecompressedTextureCacheSize(ENTRY_SIZE - 1);
+
+			{
+				const tcu::DecompressedTextureCacheStats	initial		= tcu::getDecompressedTextureCacheStats();
+				const tcu::DecompressedTexture				decoded		= tcu::getDecompressedTexture(textures[2]);
+
+				expect(initial.numEntries == 0 && tcu::getDecompressedTextureCacheStats().numEntries == 0, "Shrinking budget evicts entries");
+				expect(isDecodedCorrectly(textures[2], decoded) && getDelta(initial).numMisses == 1, "Texture larger than budget is decompressed");
+			}
+		}
+	}
+
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	static tcu::DecompressedTextureCacheStats getDelta (const tcu::DecompressedTextureCacheStats& initial)
+	{
+		tcu::DecompressedTextureCacheStats delta = tcu::getDecompressedTextureCacheStats();
+
+		delta.numHits		-= initial.numHits;
+		delta.numMisses		-= initial.numMisses;
+		delta.numEvictions	-= initial.numEvictions;
+
+		return delta;
+	}
+
+	static bool isDecodedCorrectly (const tcu::CompressedTexture& texture, const tcu::DecompressedTexture& decoded)
+	{
+		tcu::TextureLevel reference (tcu::getUncompressedFormat(texture.getFormat()), texture.getWidth(), texture.getHeight());
+
+		tcu::decompress(reference.getAccess(), texture.getFormat(), (const deUint8*)texture.getData());
+
+		return deMemCmp(reference.getAccess().getDataPtr(), decoded.getAccess().getDataPtr(), reference.getFormat().getPixelSize()*texture.getWidth()*texture.getHeight()) == 0;
+	}
+
+	bool m_allOk;
+};
+
+class TextureLevelPyramidTest : public tcu::TestCase
+{
+public:
+	TextureLevelPyramidTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase	(testCtx, name, description)
+		, m_allOk		(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		m_allOk = true;
+
+		checkCopyOnWrite();
+		checkExposedLevelCopy();
+		checkCubeCopyOnWrite();
+		checkLazyLevels(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8));
+		checkLazyLevels(tcu::TextureFormat(tcu::TextureFormat::sRGBA, tcu::TextureFormat::UNORM_INT8));
+		checkLazyLevels(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT));
+		checkLazyArrayAndCube();
+		checkConcurrentLazyLevels();
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected texture level contents");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		SIZE	= 16
+	};
+
+	void checkCopyOnWrite (void)
+	{
+		tcu::Texture2D texture (tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), SIZE, SIZE);
+
+		texture.allocLevel(0);
+		tcu::fillWithComponentGradients(texture.getLevel(0), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+		{
+			// Level 0 of texture has been accessed for writing, but level 0 of base has not.
+			const tcu::Texture2D		base		(texture);
+			const tcu::Vec4				original	= base.getLevel(0).getPixel(0, 0);
+			tcu::Texture2D				copy		(base);
+			const tcu::Texture2D&		constCopy	= copy;
+			const tcu::Texture2DView	view		= copy;
+
+			expect(constCopy.getLevel(0).getDataPtr() == base.getLevel(0).getDataPtr(), "Copy shares level data");
+
+			copy.getLevel(0).setPixel(tcu::Vec4(1.0f, 0.0f, 1.0f, 0.0f), 0, 0);
+
+			expect(constCopy.getLevel(0).getDataPtr() != base.getLevel(0).getDataPtr(), "Write access unshares level data");
+			expect(base.getLevel(0).getPixel(0, 0) == original, "Original is not modified");
+			expect(view.getLevel(0).getPixel(0, 0) == tcu::Vec4(1.0f, 0.0f, 1.0f, 0.0f), "View sees unshared level");
+		}
+
+		{
+			tcu::Texture2D copy (tcu::TextureFormat(tcu::TextureFormat::R, tcu::TextureFormat::FLOAT), 1, 1);
+
+			copy = texture;
+			texture.getLevel(0).setPixel(tcu::Vec4(1.0f), 1, 0);
+
+			expect(copy.getLevel(0).getPixel(1, 0) != tcu::Vec4(1.0f), "Assigned copy is not modified");
+		}
+	}
+
+	void checkExposedLevelCopy (void)
+	{
+		tcu::Texture2D texture (tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), SIZE, SIZE);
+
+		texture.allocLevel(0);
+
+		{
+			const tcu::PixelBufferAccess	access		= texture.getLevel(0);
+
+			tcu::clear(access, tcu::Vec4(0.0f));
+
+			{
+				const tcu::Texture2D	copy		(texture);
+				tcu::Texture2D			assigned	(texture.getFormat(), 1, 1);
+
+				assigned = texture;
+				tcu::clear(access, tcu::Vec4(1.0f));
+
+				expect(copy.getLevel(0).getPixel(SIZE-1, SIZE-1) == tcu::Vec4(0.0f), "Copy does not see writes through earlier access");
+				expect(assigned.getLevel(0).getPixel(SIZE-1, SIZE-1) == tcu::Vec4(0.0f), "Assigned copy does not see writes through earlier access");
+				expect(texture.getLevel(0).getPixel(SIZE-1, SIZE-1) == tcu::Vec4(1.0f), "Original sees writes through earlier access");
+			}
+		}
+
+		texture.finishLevelWrites();
+
+		{
+			const tcu::Texture2D	copy		(texture);
+			const tcu::Texture2D&	original	= texture;
+
+			expect(copy.getLevel(0).getDataPtr() == original.getLevel(0).getDataPtr(), "Copy shares level data after finishLevelWrites()");
+
+			tcu::clear(texture.getLevel(0), tcu::Vec4(0.0f));
+
+			expect(copy.getLevel(0).getPixel(SIZE-1, SIZE-1) == tcu::Vec4(1.0f), "Copy does not see writes through later access");
+		}
+	}
+
+	void checkCubeCopyOnWrite (void)
+	{
+		const tcu::TextureFormat	format	(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		tcu::TextureCube			cube	(format, SIZE);
+
+		cube.allocLevel(tcu::CUBEFACE_POSITIVE_Y, 0);
+		tcu::clear(cube.getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y), tcu::Vec4(0.0f));
+
+		{
+			tcu::TextureCube				copy		(cube);
+			const tcu::TextureCubeView		view		= copy.getView();
+
+			expect(copy.isLevelEmpty(tcu::CUBEFACE_NEGATIVE_X, 0) && !copy.isLevelEmpty(tcu::CUBEFACE_POSITIVE_Y, 0), "Cube copy has the same levels");
+
+			tcu::clear(copy.getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y), tcu::Vec4(1.0f));
+
+			expect(static_cast<const tcu::TextureCube&>(cube).getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y).getPixel(0, 0) == tcu::Vec4(0.0f), "Original cube is not modified");
+			expect(view.getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y).getPixel(0, 0) == tcu::Vec4(1.0f), "Cube view sees unshared level");
+		}
+	}
+
+	void checkLazyLevels (const tcu::TextureFormat& format)
+	{
+		tcu::Texture2D	texture		(format, SIZE, SIZE/2);
+		tcu::Texture2D	reference	(format, SIZE, SIZE/2);
+
+		texture.allocLevel(0);
+		tcu::fillWithComponentGradients(texture.getLevel(0), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+		for (int levelNdx = 1; levelNdx < texture.getNumLevels(); levelNdx++)
+			texture.allocLevelLazy(levelNdx);
+
+		computeBoxFilteredLevels(reference, texture.getLevel(0));
+
+		{
+			const tcu::Texture2D copy (texture);
+
+			expect(!copy.isLevelEmpty(2) && copy.isLevelLazy(2), "Lazy level is not generated before access");
+			expect(isLevelEqual(copy.getLevel(2), reference.getLevel(2)), "Lazy level is box filtered from the previous level");
+			expect(!copy.isLevelLazy(1) && copy.isLevelLazy(3), "Only the accessed level and its parents are generated");
+			expect(texture.isLevelLazy(1), "Generating a copy's levels does not affect the original");
+		}
+
+		{
+			const tcu::Texture2DView view = texture;
+
+			for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+				expect(isLevelEqual(view.getLevel(levelNdx), reference.getLevel(levelNdx)), "View generates all lazy levels");
+		}
+	}
+
+	void checkLazyArrayAndCube (void)
+	{
+		const tcu::TextureFormat	format	(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+		tcu::Texture2DArray			array	(format, SIZE, SIZE, 3);
+		tcu::TextureCube			cube	(format, SIZE);
+
+		array.allocLevel(0);
+		array.allocLevelLazy(1);
+		tcu::fillWithComponentGradients(array.getLevel(0), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+		expect(array.getLevel(1).getDepth() == 3 && isLevelEqual(tcu::getSubregion(array.getLevel(1), 0, 0, 2, SIZE/2, SIZE/2, 1), getBoxFiltered2D(tcu::getSubregion(array.getLevel(0), 0, 0, 2, SIZE, SIZE, 1)).getAccess()), "Array layers are filtered separately");
+
+		cube.allocLevel(tcu::CUBEFACE_POSITIVE_Y, 0);
+		cube.allocLevelLazy(tcu::CUBEFACE_POSITIVE_Y, 1);
+		tcu::fillWithComponentGradients(cube.getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+		{
+			const tcu::TextureCube copy (cube);
+
+			expect(cube.isLevelEmpty(tcu::CUBEFACE_NEGATIVE_X, 1) && copy.isLevelLazy(tcu::CUBEFACE_POSITIVE_Y, 1), "Cube copy keeps lazy levels");
+			expect(isLevelEqual(copy.getView().getLevelFace(1, tcu::CUBEFACE_POSITIVE_Y), getBoxFiltered2D(cube.getLevelFace(0, tcu::CUBEFACE_POSITIVE_Y)).getAccess()), "Cube face level is generated");
+		}
+	}
+
+	class LazyLevelReadJob : public de::ThreadPool::Job
+	{
+	public:
+		LazyLevelReadJob (const tcu::Texture2D& texture, const tcu::Texture2D& reference, std::vector<deUint8>& isOk)
+			: m_texture		(texture)
+			, m_reference	(reference)
+			, m_isOk		(isOk)
+		{
+		}
+
+		void execute (int itemNdx, int workerNdx)
+		{
+			// Read levels in different orders so that generation of parent levels overlaps
+			const int numLevels	= m_texture.getNumLevels();
+			const int levelNdx	= (itemNdx % 2 == 0) ? numLevels-1 - (itemNdx/2) % numLevels : (itemNdx/2) % numLevels;
+
+			DE_UNREF(workerNdx);
+
+			m_isOk[itemNdx] = isLevelEqual(m_texture.getLevel(levelNdx), m_reference.getLevel(levelNdx)) ? 1 : 0;
+		}
+
+	private:
+		const tcu::Texture2D&	m_texture;
+		const tcu::Texture2D&	m_reference;
+		std::vector<deUint8>&	m_isOk;
+	};
+
+	void checkConcurrentLazyLevels (void)
+	{
+		const tcu::TextureFormat	format		(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const int					numThreads	= 4;
+		const int					numRounds	= 16;
+		de::ThreadPool				threadPool	(numThreads);
+
+		for (int roundNdx = 0; roundNdx < numRounds; roundNdx++)
+		{
+			tcu::Texture2D			texture		(format, 16*SIZE, 16*SIZE);
+			tcu::Texture2D			reference	(format, 16*SIZE, 16*SIZE);
+			std::vector<deUint8>	isOk		(numThreads*texture.getNumLevels(), 0);
+
+			texture.allocLevel(0);
+			tcu::fillWithComponentGradients(texture.getLevel(0), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+			for (int levelNdx = 1; levelNdx < texture.getNumLevels(); levelNdx++)
+				texture.allocLevelLazy(levelNdx);
+
+			computeBoxFilteredLevels(reference, texture.getLevel(0));
+
+			{
+				LazyLevelReadJob job (texture, reference, isOk);
+				threadPool.run(job, (int)isOk.size());
+			}
+
+			expect(std::find(isOk.begin(), isOk.end(), 0) == isOk.end(), "Lazy levels read from multiple threads are generated once");
+		}
+	}
+
+	static tcu::TextureLevel getBoxFiltered2D (const tcu::ConstPixelBufferAccess& src)
+	{
+		const bool			isSRGB	= tcu::isSRGB(src.getFormat());
+		tcu::TextureLevel	dst		(src.getFormat(), de::max(src.getWidth()/2, 1), de::max(src.getHeight()/2, 1));
+
+		for (int y = 0; y < dst.getHeight(); y++)
+		for (int x = 0; x < dst.getWidth(); x++)
+		{
+			tcu::Vec4 sum (0.0f);
+
+			for (int dy = 0; dy < 2; dy++)
+			for (int dx = 0; dx < 2; dx++)
+			{
+				const tcu::Vec4 texel = src.getPixel(de::min(2*x + dx, src.getWidth()-1), de::min(2*y + dy, src.getHeight()-1));
+				sum += isSRGB ? tcu::sRGBToLinear(texel) : texel;
+			}
+
+			dst.getAccess().setPixel(isSRGB ? tcu::linearToSRGB(sum / 4.0f) : sum / 4.0f, x, y);
+		}
+
+		return dst;
+	}
+
+	static void computeBoxFilteredLevels (tcu::Texture2D& dst, const tcu::ConstPixelBufferAccess& base)
+	{
+		dst.allocLevel(0);
+		tcu::copy(dst.getLevel(0), base);
+
+		for (int levelNdx = 1; levelNdx < dst.getNumLevels(); levelNdx++)
+		{
+			dst.allocLevel(levelNdx);
+			tcu::copy(dst.getLevel(levelNdx), getBoxFiltered2D(dst.getLevel(levelNdx-1)).getAccess());
+		}
+	}
+
+	static bool isLevelEqual (const tcu::ConstPixelBufferAccess& a, const tcu::ConstPixelBufferAccess& b)
+	{
+		if (a.getSize() != b.getSize())
+			return false;
+
+		for (int y = 0; y < a.getHeight(); y++)
+		for (int x = 0; x < a.getWidth(); x++)
+		{
+			if (a.getPixel(x, y) != b.getPixel(x, y))
+				return false;
+		}
+
+		return true;
+	}
+
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	bool m_allOk;
+};
+
+class TestHierarchyCacheTest : public tcu::TestCase
+{
+public:
+	TestHierarchyCacheTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase	(testCtx, name, description)
+		, m_allOk		(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::CachedTestPackage	package		= createPackage();
+		vector<deUint8>					data;
+
+		m_allOk = true;
+
+		tcu::serializeTestHierarchyCache(package, data);
+
+		{
+			tcu::CachedTestPackage	result;
+			const bool				isRead	= tcu::deserializeTestHierarchyCache(&data[0], data.size(), result);
+
+			expect(isRead && isEqual(package, result), "Serialized package is read back");
+		}
+
+		{
+			vector<deUint8>			stale	= data;
+			tcu::CachedTestPackage	result;
+
+			stale[12] ^= 0xff; // Release id
+
+			expect(!tcu::deserializeTestHierarchyCache(&stale[0], stale.size(), result), "Cache from different release is stale");
+		}
+
+		expect(isMalformed(vector<deUint8>(data.begin(), data.end()-1)), "Truncated cache is malformed");
+
+		{
+			tcu::CachedTestPackage	invalid	= package;
+			vector<deUint8>			invalidData;
+
+			invalid.nodes[0].numChildren += 2;
+			tcu::serializeTestHierarchyCache(invalid, invalidData);
+
+			expect(isMalformed(invalidData), "Cache with invalid child count is malformed");
+		}
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected cache behavior");
+		return STOP;
+	}
+
+private:
+	static tcu::CachedTestPackage createPackage (void)
+	{
+		tcu::CachedTestPackage package;
+
+		package.name		= "dEQP-TEST";
+		package.description	= "Test package";
+
+		package.nodes.push_back(tcu::CachedTestNode(tcu::NODETYPE_GROUP,			"group",	"Group"));
+		package.nodes.push_back(tcu::CachedTestNode(tcu::NODETYPE_SELF_VALIDATE,	"case",		"Case"));
+		package.nodes.push_back(tcu::CachedTestNode(tcu::NODETYPE_GROUP,			"subgroup",	""));
+		package.nodes.push_back(tcu::CachedTestNode(tcu::NODETYPE_PERFORMANCE,		"perf",		"Performance case"));
+		package.nodes.push_back(tcu::CachedTestNode(tcu::NODETYPE_ACCURACY,			"accuracy",	""));
+
+		package.nodes[0].numChildren = 2;
+		package.nodes[2].numChildren = 1;
+
+		return package;
+	}
+
+	static bool isEqual (const tcu::CachedTestPackage& a, const tcu::CachedTestPackage& b)
+	{
+		if (a.name != b.name || a.description != b.description || a.nodes.size() != b.nodes.size())
+			return false;
+
+		for (size_t nodeNdx = 0; nodeNdx < a.nodes.size(); nodeNdx++)
+		{
+			const tcu::CachedTestNode& nodeA = a.nodes[nodeNdx];
+			const tcu::CachedTestNode& nodeB = b.nodes[nodeNdx];
+
+			if (nodeA.nodeType != nodeB.nodeType || nodeA.name != nodeB.name || nodeA.description != nodeB.description || nodeA.numChildren != nodeB.numChildren)
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool isMalformed (const vector<deUint8>& data)
+	{
+		tcu::CachedTestPackage result;
+
+		try
+		{
+			tcu::deserializeTestHierarchyCache(&data[0], data.size(), result);
+			return false;
+		}
+		catch (const tcu::Exception&)
+		{
+			return true;
+		}
+	}
+
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	bool m_allOk;
+};
+
+class ResourcePackTest : public tcu::TestCase
+{
+public:
+	ResourcePackTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase	(testCtx, name, description)
+		, m_allOk		(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		m_allOk = true;
+
+		checkMemoryResource();
+
+		{
+			const char* const		names[]		= { "a.txt", "dir/b.bin", "empty" };
+			const string			contents[]	= { "Hello", string("\x00\x01\x02\xff", 4), "" };
+			const vector<deUint8>	pack		= createPack(names, contents, DE_LENGTH_OF_ARRAY(names));
+
+			writeFile(s_packFileName, pack);
+
+			try
+			{
+				const tcu::PackedArchive archive (s_packFileName);
+
+				for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(names); ndx++)
+				{
+					const de::UniquePtr<tcu::Resource>	resource	(archive.getResource(names[ndx]));
+					vector<deUint8>						storage;
+					const deUint8* const				data		= tcu::getResourceData(*resource, storage);
+
+					expect(resource->getData() != DE_NULL || contents[ndx].empty(), "Packed resource is resident in memory");
+					expect(storage.empty(), "Packed resource data is not copied");
+					expect(resource->getSize() == (int)contents[ndx].size() && deMemCmp(data, contents[ndx].c_str(), contents[ndx].size()) == 0, "Packed resource contents are read back");
+				}
+
+				expect(isNotFound(archive, "missing"), "Missing resource is not found");
+				expect(isNotFound(archive, "a.tx"), "Resource name prefix is not found");
+			}
+			catch (const tcu::ResourceError& e)
+			{
+				m_testCtx.getLog() << TestLog::Message << e.what() << TestLog::EndMessage;
+				expect(false, "Valid pack is opened");
+			}
+
+			{
+				vector<deUint8> badMagic = pack;
+				badMagic[0] ^= 0xff;
+				expect(isMalformed(badMagic), "Pack with invalid magic is malformed");
+			}
+
+			{
+				vector<deUint8> badVersion = pack;
+				badVersion[8] += 1;
+				expect(isMalformed(badVersion), "Pack with unsupported version is malformed");
+			}
+
+			expect(isMalformed(vector<deUint8>(pack.begin(), pack.begin() + 20)), "Pack with truncated index is malformed");
+			expect(isMalformed(vector<deUint8>(pack.begin(), pack.end() - 1)), "Pack with truncated data is malformed");
+
+			{
+				vector<deUint8> badCount = pack;
+				badCount[15] = 0x80;
+				expect(isMalformed(badCount), "Pack with invalid entry count is malformed");
+			}
+
+			deDeleteFile(s_packFileName);
+		}
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected resource behavior");
+		return STOP;
+	}
+
+private:
+	static const char* const s_packFileName;
+
+	void checkMemoryResource (void)
+	{
+		const deUint8			data[]		= { 1, 2, 3, 4, 5, 6 };
+		tcu::MemoryResource		resource	("memory", data, DE_LENGTH_OF_ARRAY(data));
+		deUint8					buf[4];
+
+		expect(resource.getData() == &data[0] && resource.getSize() == DE_LENGTH_OF_ARRAY(data), "Memory resource exposes its data");
+
+		resource.read(buf, 4);
+		expect(resource.getPosition() == 4 && buf[0] == 1 && buf[3] == 4, "Memory resource is read from the beginning");
+
+		resource.setPosition(100);
+		expect(resource.getPosition() == DE_LENGTH_OF_ARRAY(data), "Memory resource position is clamped to size");
+
+		resource.setPosition(4);
+
+		try
+		{
+			resource.read(buf, 4);
+			expect(false, "Reading past the end of memory resource fails");
+		}
+		catch (const tcu::Exception&)
+		{
+		}
+	}
+
+	static void appendUint32 (vector<deUint8>& dst, deUint32 value)
+	{
+		for (int byteNdx = 0; byteNdx < 4; byteNdx++)
+			dst.push_back((deUint8)(value >> (8*byteNdx)));
+	}
+
+	// Same layout as written by scripts/build_resource_pack.py, without data alignment.
+	static vector<deUint8> createPack (const char* const* names, const string* contents, int numEntries)
+	{
+		const char		magic[]		= { 'd', 'E', 'Q', 'P', 'p', 'a', 'c', 'k' };
+		vector<deUint8>	pack		(magic, magic + DE_LENGTH_OF_ARRAY(magic));
+		size_t			dataOffset	= pack.size() + 8;
+
+		for (int ndx = 0; ndx < numEntries; ndx++)
+			dataOffset += 12 + strlen(names[ndx]);
+
+		appendUint32(pack, 1u);
+		appendUint32(pack, (deUint32)numEntries);
+
+		for (int ndx = 0; ndx < numEntries; ndx++)
+		{
+			appendUint32(pack, (deUint32)strlen(names[ndx]));
+			pack.insert(pack.end(), names[ndx], names[ndx] + strlen(names[ndx]));
+			appendUint32(pack, (deUint32)dataOffset);
+			appendUint32(pack, (deUint32)contents[ndx].size());
+
+			dataOffset += contents[ndx].size();
+		}
+
+		for (int ndx = 0; ndx < numEntries; ndx++)
+			pack.insert(pack.end(), contents[ndx].begin(), contents[ndx].end());
+
+		return pack;
+	}
+
+	static void writeFile (const char* fileName, const vector<deUint8>& data)
+	{
+		std::ofstream file (fileName, std::ios_base::binary);
+
+		file.write((const char*)&data[0], (std::streamsize)data.size());
+		TCU_CHECK(file.good());
+	}
+
+	static bool isMalformed (const vector<deUint8>& data)
+	{
+		writeFile(s_packFileName, data);
+
+		try
+		{
+			const tcu::PackedArchive archive (s_packFileName);
+			return false;
+		}
+		catch (const tcu::ResourceError&)
+		{
+			return true;
+		}
+	}
+
+	static bool isNotFound (const tcu::Archive& archive, const char* name)
+	{
+		try
+		{
+			delete archive.getResource(name);
+			return false;
+		}
+		catch (const tcu::ResourceError&)
+		{
+			return true;
+		}
+	}
+
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	bool m_allOk;
+};
+
+const char* const ResourcePackTest::s_packFileName = "resource_pack_test.pack";
+
+class ResourcePackDataTest : public tcu::TestCase
+{
+public:
+	ResourcePackDataTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase	(testCtx, name, description)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		// Built from data/internal/data with scripts/build_resource_pack.py, see modules/internal/CMakeLists.txt.
+		const char* const	packFileName	= "internal/data.pack";
+		const char* const	imageNames[]	=
+		{
+			"imageio/rgb24_256x256.png",
+			"imageio/rgb24_209x181.png",
+			"imageio/rgba32_256x256.png",
+			"imageio/rgba32_207x219.png",
+		};
+		bool				allOk			= true;
+
+		if (!deFileExists(packFileName))
+			throw tcu::NotSupportedError(string("Resource pack '") + packFileName + "' not found");
+
+		const tcu::PackedArchive pack (packFileName);
+
+		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(imageNames); ndx++)
+		{
+			const string						dirName			= string("internal/data/") + imageNames[ndx];
+			const de::UniquePtr<tcu::Resource>	packResource	(pack.getResource(imageNames[ndx]));
+			const de::UniquePtr<tcu::Resource>	dirResource		(m_testCtx.getArchive().getResource(dirName.c_str()));
+			vector<deUint8>						dirStorage;
+			const deUint8* const				dirData			= tcu::getResourceData(*dirResource, dirStorage);
+			tcu::TextureLevel					packImage;
+			tcu::TextureLevel					dirImage;
+
+			m_testCtx.getLog() << TestLog::Message << "Comparing packed '" << imageNames[ndx] << "' with '" << dirName << "'" << TestLog::EndMessage;
+
+			if (!packResource->getData() || packResource->getSize() != dirResource->getSize() ||
+				deMemCmp(packResource->getData(), dirData, (size_t)dirResource->getSize()) != 0)
+			{
+				m_testCtx.getLog() << TestLog::Message << "ERROR: packed resource contents differ" << TestLog::EndMessage;
+				allOk = false;
+				continue;
+			}
+
+			tcu::ImageIO::loadPNG(packImage, packResource->getData(), packResource->getSize());
+			tcu::ImageIO::loadPNG(dirImage, m_testCtx.getArchive(), dirName.c_str());
+
+			if (packImage.getFormat() != dirImage.getFormat() ||
+				packImage.getWidth() != dirImage.getWidth() ||
+				packImage.getHeight() != dirImage.getHeight() ||
+				deMemCmp(packImage.getAccess().getDataPtr(), dirImage.getAccess().getDataPtr(), (size_t)(dirImage.getAccess().getSlicePitch())) != 0)
+			{
+				m_testCtx.getLog() << TestLog::Message << "ERROR: images decoded from pack and directory differ" << TestLog::EndMessage;
+				allOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Packed resources differ");
+		return STOP;
+	}
+};
+
+class LazyTestCaseGroupTest : public tcu::TestCase
+{
+public:
+	LazyTestCaseGroupTest (tcu::TestContext& testCtx, const char* name, const char* description)
+		: tcu::TestCase	(testCtx, name, description)
+		, m_allOk		(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		m_allOk = true;
+
+		checkInitDeinit();
+		checkFilteredIteration();
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected lazy group behavior");
+		return STOP;
+	}
+
+private:
+	class CountingCase : public tcu::TestCase
+	{
+	public:
+		CountingCase (tcu::TestContext& testCtx, const char* name)
+			: tcu::TestCase(testCtx, name, "")
+		{
+			s_numLiveCases += 1;
+		}
+
+		~CountingCase (void)
+		{
+			s_numLiveCases -= 1;
+		}
+
+		IterateResult iterate (void)
+		{
+			DE_ASSERT(false);
+			return STOP;
+		}
+	};
+
+	struct CreateCountingCases
+	{
+		CreateCountingCases (int numCases_, int* numCalls_)
+			: numCases	(numCases_)
+			, numCalls	(numCalls_)
+		{
+		}
+
+		void operator() (tcu::TestCaseGroup* group) const
+		{
+			*numCalls += 1;
+
+			for (int caseNdx = 0; caseNdx < numCases; caseNdx++)
+				group->addChild(new CountingCase(group->getTestContext(), ("case" + de::toString(caseNdx)).c_str()));
+		}
+
+		int		numCases;
+		int*	numCalls;
+	};
+
+	class LazyPackage : public tcu::TestPackage
+	{
+	public:
+		LazyPackage (tcu::TestContext& testCtx, int* numCallsA, int* numCallsB)
+			: tcu::TestPackage	(testCtx, "pkg", "")
+			, m_numCallsA		(numCallsA)
+			, m_numCallsB		(numCallsB)
+		{
+		}
+
+		void init (void)
+		{
+			addChild(tcu::createLazyTestCaseGroup(m_testCtx, "a", "", CreateCountingCases(2, m_numCallsA)));
+			addChild(tcu::createLazyTestCaseGroup(m_testCtx, "b", "", CreateCountingCases(2, m_numCallsB)));
+		}
+
+		tcu::TestCaseExecutor* createExecutor (void) const
+		{
+			return DE_NULL;
+		}
+
+	private:
+		int* const	m_numCallsA;
+		int* const	m_numCallsB;
+	};
+
+	// DefaultHierarchyInflater would also switch the current archive of the running package.
+	class SimpleInflater : public tcu::TestHierarchyInflater
+	{
+	public:
+		void enterTestPackage	(tcu::TestPackage* testPackage, vector<tcu::TestNode*>& children)		{ testPackage->init(); testPackage->getChildren(children);	}
+		void leaveTestPackage	(tcu::TestPackage* testPackage)											{ testPackage->deinit();									}
+		void enterGroupNode		(tcu::TestCaseGroup* testGroup, vector<tcu::TestNode*>& children)		{ testGroup->init(); testGroup->getChildren(children);		}
+		void leaveGroupNode		(tcu::TestCaseGroup* testGroup)											{ testGroup->deinit();										}
+	};
+
+	void checkInitDeinit (void)
+	{
+		int numCalls = 0;
+
+		{
+			const de::UniquePtr<tcu::TestNode>	group		(tcu::createLazyTestCaseGroup(m_testCtx, "group", "", CreateCountingCases(3, &numCalls)));
+			vector<tcu::TestNode*>				children;
+
+			group->getChildren(children);
+			expect(numCalls == 0 && s_numLiveCases == 0 && children.empty(), "Children are not created before init()");
+
+			group->init();
+			group->getChildren(children);
+			expect(numCalls == 1 && s_numLiveCases == 3 && children.size() == 3, "Children are created in init()");
+
+			group->deinit();
+			group->getChildren(children);
+			expect(s_numLiveCases == 0 && children.empty(), "Children are destroyed in deinit()");
+
+			group->init();
+			group->getChildren(children);
+			expect(numCalls == 2 && s_numLiveCases == 3 && children.size() == 3, "Children are re-created in init()");
+		}
+
+		expect(s_numLiveCases == 0, "Children are destroyed with group");
+	}
+
+	void checkFilteredIteration (void)
+	{
+		int							numCallsA		= 0;
+		int							numCallsB		= 0;
+		const tcu::CommandLine		cmdLine			("deqp --deqp-case=pkg.b.*");
+		vector<tcu::TestNode*>		packages;
+		vector<string>				casePaths;
+
+		packages.push_back(new LazyPackage(m_testCtx, &numCallsA, &numCallsB));
+
+		{
+			tcu::TestPackageRoot		root		(m_testCtx, packages);
+			SimpleInflater				inflater;
+			tcu::TestHierarchyIterator	iter		(root, inflater, cmdLine);
+
+			for (; iter.getState() != tcu::TestHierarchyIterator::STATE_FINISHED; iter.next())
+			{
+				if (iter.getState() == tcu::TestHierarchyIterator::STATE_ENTER_NODE && tcu::isTestNodeTypeExecutable(iter.getNode()->getNodeType()))
+				{
+					expect(s_numLiveCases == 2, "Only cases of the entered lazy group exist");
+					casePaths.push_back(iter.getNodePath());
+				}
+			}
+		}
+
+		expect(numCallsA == 0, "Filtered-out lazy group is not inflated");
+		expect(numCallsB == 1, "Selected lazy group is inflated once");
+		expect(casePaths.size() == 2 && casePaths[0] == "pkg.b.case0" && casePaths[1] == "pkg.b.case1", "Selected cases are iterated");
+		expect(s_numLiveCases == 0, "Children are destroyed after iteration");
+	}
+
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	static int	s_numLiveCases;
+
+	bool		m_allOk;
+};
+
+int LazyTestCaseGroupTest::s_numLiveCases = 0;
+
 class CommonFrameworkTests : public tcu::TestCaseGroup
 {
 public:
@@ -876,6 +4319,17 @@ public:
 								   tcu::FloatFormat_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "either","tcu::Either_selfTest()",
 								   tcu::Either_selfTest));
+		addChild(new PixelRowAccessTest(m_testCtx, "pixel_row_access", "Compare row and per-pixel pixel buffer access"));
+		addChild(new CompiledSamplerTest(m_testCtx, "compiled_sampler", "Compare compiled sampler and sampler texture lookups"));
+		addChild(new ImageCompareThreadsTest(m_testCtx, "image_compare_threads", "Compare single- and multi-threaded image comparison results"));
+		addChild(new TexLookupBatchTest(m_testCtx, "tex_lookup_batch", "Compare batch and per-pixel texture lookup verification"));
+		addChild(new TexDecompressionThreadsTest(m_testCtx, "tex_decompression_threads", "Compare multi-threaded and per-block compressed texture decompression"));
+		addChild(new DecompressedTextureCacheTest(m_testCtx, "decompressed_texture_cache", "Decompressed texture cache hits, misses and eviction"));
+		addChild(new TextureLevelPyramidTest(m_testCtx, "texture_level_pyramid", "Copy-on-write and lazily generated texture levels"));
+		addChild(new TestHierarchyCacheTest(m_testCtx, "test_hierarchy_cache", "Test hierarchy cache serialization"));
+		addChild(new ResourcePackTest(m_testCtx, "resource_pack", "Memory resources and packed archive index"));
+		addChild(new ResourcePackDataTest(m_testCtx, "resource_pack_data", "Compare packed test data with data directory"));
+		addChild(new LazyTestCaseGroupTest(m_testCtx, "lazy_test_case_group", "Lazy test case group inflation"));
 	}
 };
 
@@ -890,6 +4344,45 @@ public:
 	void init (void)
 	{
 		addChild(new ConstantInterpolationTest(m_testCtx));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_triangles",			"Compare tile-parallel and serial rasterization of triangles",			rr::PRIMITIVETYPE_TRIANGLES,	1));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_triangles_4_samples",	"Compare tile-parallel and serial rasterization of triangles, 4 samples",	rr::PRIMITIVETYPE_TRIANGLES,	4));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_lines",				"Compare tile-parallel and serial rasterization of wide lines",			rr::PRIMITIVETYPE_LINES,		1));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_lines_4_samples",		"Compare tile-parallel and serial rasterization of wide lines, 4 samples",	rr::PRIMITIVETYPE_LINES,		4));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_points",				"Compare tile-parallel and serial rasterization of points",				rr::PRIMITIVETYPE_POINTS,		1));
+		addChild(new ParallelRasterizationTest(m_testCtx, "parallel_points_4_samples",	"Compare tile-parallel and serial rasterization of points, 4 samples",		rr::PRIMITIVETYPE_POINTS,		4));
+		addChild(new ShaderThreadSafetyTest(m_testCtx, "shader_thread_safety",	"Shaders that are not thread-safe are not called concurrently"));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangles_uint8",			"Vertex cache with 8-bit indices",						rr::PRIMITIVETYPE_TRIANGLES,		rr::INDEXTYPE_UINT8,	false));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangles_uint16",			"Vertex cache with 16-bit indices",						rr::PRIMITIVETYPE_TRIANGLES,		rr::INDEXTYPE_UINT16,	false));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangles_uint32",			"Vertex cache with 32-bit indices",						rr::PRIMITIVETYPE_TRIANGLES,		rr::INDEXTYPE_UINT32,	false));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangle_strip_restart_uint8",	"Vertex cache with primitive restart, 8-bit indices",	rr::PRIMITIVETYPE_TRIANGLE_STRIP,	rr::INDEXTYPE_UINT8,	true));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangle_strip_restart_uint16",	"Vertex cache with primitive restart, 16-bit indices",	rr::PRIMITIVETYPE_TRIANGLE_STRIP,	rr::INDEXTYPE_UINT16,	true));
+		addChild(new VertexCacheTest(m_testCtx, "vertex_cache_triangle_strip_restart_uint32",	"Vertex cache with primitive restart, 32-bit indices",	rr::PRIMITIVETYPE_TRIANGLE_STRIP,	rr::INDEXTYPE_UINT32,	true));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "edge_evaluation_1_sample",	"Compare SIMD and scalar edge evaluation, 1 sample",	1,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_SCANLINE));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "edge_evaluation_2_samples",	"Compare SIMD and scalar edge evaluation, 2 samples",	2,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_SCANLINE));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "edge_evaluation_4_samples",	"Compare SIMD and scalar edge evaluation, 4 samples",	4,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_SCANLINE));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "edge_evaluation_8_samples",	"Compare SIMD and scalar edge evaluation, 8 samples",	8,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_SCANLINE));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "edge_evaluation_16_samples",	"Compare SIMD and scalar edge evaluation, 16 samples",	16,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_SCANLINE));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_1_sample",	"Compare hierarchical and scanline traversal, 1 sample",	1,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_scalar_1_sample",	"Compare hierarchical and scanline traversal with scalar edge evaluation, 1 sample",	1,	rr::EDGEEVALUATION_SCALAR,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_2_samples",	"Compare hierarchical and scanline traversal, 2 samples",	2,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_4_samples",	"Compare hierarchical and scanline traversal, 4 samples",	4,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_scalar_4_samples",	"Compare hierarchical and scanline traversal with scalar edge evaluation, 4 samples",	4,	rr::EDGEEVALUATION_SCALAR,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_8_samples",	"Compare hierarchical and scanline traversal, 8 samples",	8,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new TriangleRasterizerEquivalenceTest(m_testCtx, "hierarchical_traversal_16_samples",	"Compare hierarchical and scanline traversal, 16 samples",	16,	rr::EDGEEVALUATION_SIMD,	rr::TRIANGLETRAVERSAL_HIERARCHICAL));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_no_depth",						"Compare fast and generic fragment operations, no depth test",					1,	false,	tcu::TextureFormat::D,	false));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_depth_less",						"Compare fast and generic fragment operations, depth LESS",						1,	true,	tcu::TextureFormat::D,	false));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_depth_less_d24s8",				"Compare fast and generic fragment operations, depth LESS on D24S8",			1,	true,	tcu::TextureFormat::DS,	false));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_depth_less_4_samples",			"Compare fast and generic fragment operations, depth LESS, 4 samples",			4,	true,	tcu::TextureFormat::DS,	false));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_alpha_blend",					"Compare fast and generic fragment operations, alpha blend",					1,	false,	tcu::TextureFormat::D,	true));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_alpha_blend_4_samples",			"Compare fast and generic fragment operations, alpha blend, 4 samples",			4,	false,	tcu::TextureFormat::D,	true));
+		addChild(new FragmentProcessorFastPathTest(m_testCtx, "fragment_ops_depth_less_alpha_blend",		"Compare fast and generic fragment operations, depth LESS and alpha blend",		1,	true,	tcu::TextureFormat::D,	true));
+		addChild(new FragmentBatchShadingTest(m_testCtx, "fragment_batch_triangles",	"Compare structure-of-arrays and per-packet fragment shading of triangles",	rr::PRIMITIVETYPE_TRIANGLES));
+		addChild(new FragmentBatchShadingTest(m_testCtx, "fragment_batch_lines",		"Compare structure-of-arrays and per-packet fragment shading of lines",		rr::PRIMITIVETYPE_LINES));
+		addChild(new FragmentBatchShadingTest(m_testCtx, "fragment_batch_points",		"Compare structure-of-arrays and per-packet fragment shading of points",		rr::PRIMITIVETYPE_POINTS));
+		addChild(new DrawBufferReuseTest(m_testCtx, "reuse_draw_buffers",			"Compare draws with a reused renderer and fresh renderers",				1));
+		addChild(new DrawBufferReuseTest(m_testCtx, "reuse_draw_buffers_parallel",	"Compare draws with a reused renderer and fresh renderers, 4 threads",	4));
+		addChild(new GuardBandClippingTest(m_testCtx, "guard_band_clipping",				"Compare guard band and full triangle clipping",					false));
+		addChild(new GuardBandClippingTest(m_testCtx, "guard_band_clipping_depth_clamp",	"Compare guard band and full triangle clipping with depth clamp",	true));
 	}
 };
 
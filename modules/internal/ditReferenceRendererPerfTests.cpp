@@ -0,0 +1,369 @@
+/*-------------------------------------------------------------------------
+ * drawElements Internal Test Module
+ * ---------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Reference renderer performance benchmarks.
+ *//*--------------------------------------------------------------------*/
+
+#include "ditReferenceRendererPerfTests.hpp"
+#include "tcuTestLog.hpp"
+#include "tcuTexture.hpp"
+#include "tcuTextureUtil.hpp"
+#include "rrRenderer.hpp"
+#include "deStringUtil.hpp"
+#include "deClock.h"
+
+#include <algorithm>
+
+namespace dit
+{
+
+namespace
+{
+
+using tcu::TestLog;
+
+enum Scene
+{
+	SCENE_FULLSCREEN_QUAD = 0,	//!< Two triangles covering the viewport
+	SCENE_SMALL_TRIANGLES,		//!< Grid of 4x4 pixel quads covering the viewport
+	SCENE_WIDE_LINES,			//!< Horizontal 4 pixel wide lines on every other 4 pixel row
+	SCENE_POINT_SPRITES,		//!< Grid of 8x8 pixel points covering the viewport
+
+	SCENE_LAST
+};
+
+class VtxShader : public rr::VertexShader
+{
+public:
+	VtxShader (void)
+		: rr::VertexShader(2, 1)
+	{
+		m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+		m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+	}
+
+	void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		{
+			rr::VertexPacket& packet = *packets[packetNdx];
+
+			packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+			packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+		}
+	}
+};
+
+class FragShader : public rr::FragmentShader
+{
+public:
+	FragShader (void)
+		: rr::FragmentShader(1, 1)
+	{
+		m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+	}
+
+	void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+			rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+	}
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Render a fixed scene repeatedly and report throughput
+ *
+ * Each iteration renders one frame with a single draw call and logs it as
+ * one sample. Pixel rate is computed from the nominal number of covered
+ * pixels in the scene, independent of the number of samples per pixel.
+ *//*--------------------------------------------------------------------*/
+class RenderThroughputCase : public tcu::TestCase
+{
+public:
+							RenderThroughputCase	(tcu::TestContext& testCtx, const char* name, const char* description, Scene scene, int numSamples, int numThreads);
+							~RenderThroughputCase	(void);
+
+	void					init					(void);
+	void					deinit					(void);
+	IterateResult			iterate					(void);
+
+private:
+	enum
+	{
+		WIDTH				= 256,
+		HEIGHT				= 256,
+		NUM_MEASUREMENTS	= 10
+	};
+
+							RenderThroughputCase	(const RenderThroughputCase&);	// not allowed!
+	RenderThroughputCase&	operator=				(const RenderThroughputCase&);	// not allowed!
+
+	void					generateScene			(void);
+	void					render					(void);
+	void					logResults				(void);
+
+	const Scene				m_scene;
+	const int				m_numSamples;
+	const int				m_numThreads;
+
+	rr::Renderer*			m_renderer;
+	tcu::TextureLevel		m_colorBuffer;
+	std::vector<tcu::Vec4>	m_positions;
+	std::vector<tcu::Vec4>	m_colors;
+	rr::PrimitiveType		m_primitiveType;
+	int						m_numPrimitives;
+	int						m_numPixels;		//!< Pixels covered by one frame
+	std::vector<deUint64>	m_frameTimes;		//!< Frame times in microseconds
+};
+
+RenderThroughputCase::RenderThroughputCase (tcu::TestContext& testCtx, const char* name, const char* description, Scene scene, int numSamples, int numThreads)
+	: tcu::TestCase		(testCtx, tcu::NODETYPE_PERFORMANCE, name, description)
+	, m_scene			(scene)
+	, m_numSamples		(numSamples)
+	, m_numThreads		(numThreads)
+	, m_renderer		(DE_NULL)
+	, m_primitiveType	(rr::PRIMITIVETYPE_LAST)
+	, m_numPrimitives	(0)
+	, m_numPixels		(0)
+{
+}
+
+RenderThroughputCase::~RenderThroughputCase (void)
+{
+	RenderThroughputCase::deinit();
+}
+
+void RenderThroughputCase::init (void)
+{
+	m_renderer = new rr::Renderer(m_numThreads);
+	m_colorBuffer.setStorage(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), m_numSamples, WIDTH, HEIGHT);
+	m_frameTimes.clear();
+
+	generateScene();
+
+	// Warm up buffers reused by draw calls
+	render();
+	m_renderer->resetStatistics();
+}
+
+void RenderThroughputCase::deinit (void)
+{
+	delete m_renderer;
+	m_renderer = DE_NULL;
+
+	m_colorBuffer = tcu::TextureLevel();
+	m_positions.clear();
+	m_colors.clear();
+}
+
+//! Convert window coordinates to clip coordinates with w = 1
+static tcu::Vec4 windowToClip (float x, float y, float width, float height)
+{
+	return tcu::Vec4(2.0f*x/width - 1.0f, 2.0f*y/height - 1.0f, 0.0f, 1.0f);
+}
+
+void RenderThroughputCase::generateScene (void)
+{
+	const float w = (float)WIDTH;
+	const float h = (float)HEIGHT;
+
+	m_positions.clear();
+	m_colors.clear();
+
+	switch (m_scene)
+	{
+		case SCENE_FULLSCREEN_QUAD:
+		case SCENE_SMALL_TRIANGLES:
+		{
+			const int cellSize = (m_scene == SCENE_FULLSCREEN_QUAD) ? (de::max((int)WIDTH, (int)HEIGHT)) : (4);
+
+			for (int y = 0; y < HEIGHT; y += cellSize)
+			for (int x = 0; x < WIDTH; x += cellSize)
+			{
+				const tcu::Vec4 v00 = windowToClip((float)x,				(float)y,				w, h);
+				const tcu::Vec4 v10 = windowToClip((float)(x + cellSize),	(float)y,				w, h);
+				const tcu::Vec4 v01 = windowToClip((float)x,				(float)(y + cellSize),	w, h);
+				const tcu::Vec4 v11 = windowToClip((float)(x + cellSize),	(float)(y + cellSize),	w, h);
+
+				m_positions.push_back(v00);
+				m_positions.push_back(v10);
+				m_positions.push_back(v01);
+				m_positions.push_back(v01);
+				m_positions.push_back(v10);
+				m_positions.push_back(v11);
+			}
+
+			m_primitiveType	= rr::PRIMITIVETYPE_TRIANGLES;
+			m_numPrimitives	= (int)m_positions.size() / 3;
+			m_numPixels		= WIDTH*HEIGHT;
+			break;
+		}
+
+		case SCENE_WIDE_LINES:
+		{
+			for (int y = 0; y < HEIGHT; y += 8)
+			{
+				m_positions.push_back(windowToClip(0.0f,	(float)y + 2.0f, w, h));
+				m_positions.push_back(windowToClip(w,		(float)y + 2.0f, w, h));
+			}
+
+			m_primitiveType	= rr::PRIMITIVETYPE_LINES;
+			m_numPrimitives	= (int)m_positions.size() / 2;
+			m_numPixels		= m_numPrimitives*WIDTH*4;
+			break;
+		}
+
+		case SCENE_POINT_SPRITES:
+		{
+			for (int y = 0; y < HEIGHT; y += 8)
+			for (int x = 0; x < WIDTH; x += 8)
+				m_positions.push_back(windowToClip((float)x + 4.0f, (float)y + 4.0f, w, h));
+
+			m_primitiveType	= rr::PRIMITIVETYPE_POINTS;
+			m_numPrimitives	= (int)m_positions.size();
+			m_numPixels		= m_numPrimitives*8*8;
+			break;
+		}
+
+		default:
+			DE_ASSERT(false);
+	}
+
+	for (size_t vtxNdx = 0; vtxNdx < m_positions.size(); ++vtxNdx)
+		m_colors.push_back(tcu::Vec4((float)(vtxNdx % 3) * 0.5f, (float)(vtxNdx % 5) * 0.25f, (float)(vtxNdx % 7) / 6.0f, 1.0f));
+}
+
+void RenderThroughputCase::render (void)
+{
+	const VtxShader							vtxShader;
+	const FragShader						fragShader;
+	const rr::Program						program			(&vtxShader, &fragShader);
+	const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(m_colorBuffer.getAccess());
+	const rr::RenderTarget					renderTarget	(colorAccess);
+	const rr::VertexAttrib					vertexAttribs[]	=
+	{
+		rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &m_positions[0]),
+		rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &m_colors[0]),
+	};
+	rr::RenderState							state			((rr::ViewportState(colorAccess)));
+
+	state.line.lineWidth	= 4.0f;
+	state.point.pointSize	= 8.0f;
+
+	m_renderer->draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(m_primitiveType, (int)m_positions.size(), 0)));
+}
+
+void RenderThroughputCase::logResults (void)
+{
+	TestLog&					log			= m_testCtx.getLog();
+	const rr::RenderStatistics&	stats		= m_renderer->getStatistics();
+	std::vector<deUint64>		sortedTimes	= m_frameTimes;
+
+	log << TestLog::SampleList("Frames", "Frame render times")
+		<< TestLog::SampleInfo
+		<< TestLog::ValueInfo("FrameTime",		"Frame render time",			"us",		QP_SAMPLE_VALUE_TAG_RESPONSE)
+		<< TestLog::ValueInfo("PixelRate",		"Covered pixels per second",	"Mpix/s",	QP_SAMPLE_VALUE_TAG_RESPONSE)
+		<< TestLog::ValueInfo("PrimitiveRate",	"Primitives per second",		"Mprim/s",	QP_SAMPLE_VALUE_TAG_RESPONSE)
+		<< TestLog::EndSampleInfo;
+
+	for (size_t sampleNdx = 0; sampleNdx < m_frameTimes.size(); ++sampleNdx)
+	{
+		const double timeUs = (double)de::max<deUint64>(m_frameTimes[sampleNdx], 1);
+
+		log << TestLog::Sample << (deInt64)m_frameTimes[sampleNdx] << (double)m_numPixels / timeUs << (double)m_numPrimitives / timeUs << TestLog::EndSample;
+	}
+
+	log << TestLog::EndSampleList;
+
+#if RR_ENABLE_PROFILING
+	{
+		tcu::MessageBuilder msg (&log);
+
+		msg << "Renderer stage profile over " << m_frameTimes.size() << " frames:\n";
+
+		for (int stageNdx = 0; stageNdx < rr::PROFILESTAGE_LAST; ++stageNdx)
+			msg << "  " << rr::getProfileStageName((rr::ProfileStage)stageNdx) << ": "
+				<< stats.stages[stageNdx].timeNs / 1000 << " us, "
+				<< stats.stages[stageNdx].numItems << " items\n";
+
+		msg << TestLog::EndMessage;
+	}
+#else
+	DE_UNREF(stats);
+#endif
+
+	// Report median pixel rate
+	{
+		std::sort(sortedTimes.begin(), sortedTimes.end());
+
+		const double	medianTimeUs	= (double)de::max<deUint64>(sortedTimes[sortedTimes.size()/2], 1);
+		const double	pixelRate		= (double)m_numPixels / medianTimeUs;
+		const double	primitiveRate	= (double)m_numPrimitives / medianTimeUs;
+
+		log << TestLog::Message << "Median frame time " << medianTimeUs << " us, " << pixelRate << " Mpix/s, " << primitiveRate << " Mprim/s" << TestLog::EndMessage;
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, de::floatToString((float)pixelRate, 2).c_str());
+	}
+}
+
+RenderThroughputCase::IterateResult RenderThroughputCase::iterate (void)
+{
+	const deUint64 startTime = deGetMicroseconds();
+
+	render();
+
+	m_frameTimes.push_back(deGetMicroseconds() - startTime);
+
+	if ((int)m_frameTimes.size() < NUM_MEASUREMENTS)
+		return CONTINUE;
+
+	logResults();
+	return STOP;
+}
+
+} // anonymous
+
+ReferenceRendererPerfTests::ReferenceRendererPerfTests (tcu::TestContext& testCtx)
+	: tcu::TestCaseGroup(testCtx, "reference_renderer", "Reference renderer throughput")
+{
+}
+
+ReferenceRendererPerfTests::~ReferenceRendererPerfTests (void)
+{
+}
+
+void ReferenceRendererPerfTests::init (void)
+{
+	addChild(new RenderThroughputCase(m_testCtx, "fullscreen_quad",				"Fullscreen quad",								SCENE_FULLSCREEN_QUAD,	1,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "fullscreen_quad_msaa4",		"Fullscreen quad with 4 samples",				SCENE_FULLSCREEN_QUAD,	4,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "fullscreen_quad_msaa16",		"Fullscreen quad with 16 samples",				SCENE_FULLSCREEN_QUAD,	16,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "fullscreen_quad_4_threads",	"Fullscreen quad with 4 render threads",		SCENE_FULLSCREEN_QUAD,	1,	4));
+	addChild(new RenderThroughputCase(m_testCtx, "small_triangles",				"Many small triangles",							SCENE_SMALL_TRIANGLES,	1,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "small_triangles_msaa4",		"Many small triangles with 4 samples",			SCENE_SMALL_TRIANGLES,	4,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "small_triangles_4_threads",	"Many small triangles with 4 render threads",	SCENE_SMALL_TRIANGLES,	1,	4));
+	addChild(new RenderThroughputCase(m_testCtx, "wide_lines",					"Wide lines",									SCENE_WIDE_LINES,		1,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "wide_lines_msaa4",			"Wide lines with 4 samples",					SCENE_WIDE_LINES,		4,	1));
+	addChild(new RenderThroughputCase(m_testCtx, "point_sprites",				"Point sprites",								SCENE_POINT_SPRITES,	1,	1));
+}
+
+} // dit
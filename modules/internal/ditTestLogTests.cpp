@@ -23,8 +23,18 @@
 
 #include "ditTestLogTests.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuSurface.hpp"
+#include "deStringUtil.hpp"
+#include "deFile.h"
+#include "deMemory.h"
+#include "qpTestLog.h"
+#include "xeTestLogParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "xeTestLogWriter.hpp"
 
 #include <limits>
+#include <fstream>
+#include <sstream>
 
 namespace dit
 {
@@ -69,6 +79,674 @@ public:
 	}
 };
 
+//! Test log written to a temporary file, read back by the cases below.
+class TempFileLog
+{
+public:
+	TempFileLog (const char* fileName, int numEncoderThreads, deUint32 flags = 0)
+		: m_fileName	(fileName)
+		, m_log			(qpTestLog_createFileLog(fileName, flags))
+	{
+		qpImageEncoderConfig config;
+
+		if (!m_log)
+			throw tcu::ResourceError(std::string("Failed to create ") + fileName);
+
+		qpImageEncoderConfig_init(&config);
+		config.numThreads = numEncoderThreads;
+
+		qpTestLog_setImageEncoderConfig(m_log, &config);
+	}
+
+	~TempFileLog (void)
+	{
+		if (m_log)
+			qpTestLog_destroy(m_log);
+
+		deDeleteFile(m_fileName.c_str());
+	}
+
+	qpTestLog* get (void) { return m_log; }
+
+	//! Return current file contents.
+	std::string read (void) const
+	{
+		std::ostringstream	contents;
+		std::ifstream		file		(m_fileName.c_str(), std::ios_base::binary);
+
+		contents << file.rdbuf();
+
+		return contents.str();
+	}
+
+	//! Destroy log and return file contents.
+	std::string finish (void)
+	{
+		qpTestLog_destroy(m_log);
+		m_log = DE_NULL;
+
+		return read();
+	}
+
+private:
+						TempFileLog	(const TempFileLog&);
+	TempFileLog&		operator=	(const TempFileLog&);
+
+	const std::string	m_fileName;
+	qpTestLog*			m_log;
+};
+
+static void writeTestImage (qpTestLog* log, const std::string& name, int width, int height, int seed)
+{
+	tcu::Surface surface (width, height);
+
+	for (int y = 0; y < height; y++)
+	for (int x = 0; x < width; x++)
+		surface.setPixel(x, y, tcu::RGBA((x * 4) & 0xff, (y * 4) & 0xff, (seed * 32) & 0xff, 0xff));
+
+	qpTestLog_writeImage(log, name.c_str(), "Test image", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888,
+						 width, height, (int)surface.getAccess().getRowPitch(), surface.getAccess().getDataPtr());
+}
+
+static std::vector<std::string> getImageNames (const std::string& logData)
+{
+	const std::string			prefix	= "<Image Name=\"";
+	std::vector<std::string>	names;
+
+	for (size_t pos = logData.find(prefix); pos != std::string::npos; pos = logData.find(prefix, pos))
+	{
+		const size_t end = logData.find('"', pos + prefix.size());
+
+		names.push_back(logData.substr(pos + prefix.size(), end - (pos + prefix.size())));
+		pos = end;
+	}
+
+	return names;
+}
+
+//! Get attribute of first <Image> element with given name, or empty string.
+static std::string getImageAttribute (const std::string& logData, const std::string& imageName, const std::string& attribName)
+{
+	const size_t	start		= logData.find("<Image Name=\"" + imageName + "\"");
+	const size_t	end			= logData.find('>', start);
+	const size_t	attribPos	= logData.find(" " + attribName + "=\"", start);
+
+	if (start == std::string::npos || attribPos == std::string::npos || attribPos > end)
+		return "";
+
+	{
+		const size_t valueStart = attribPos + attribName.size() + 3;
+		return logData.substr(valueStart, logData.find('"', valueStart) - valueStart);
+	}
+}
+
+//! Log with repeated images: Repeat is identical to First and RepeatOther to Other.
+static std::string writeDedupTestLog (const char* fileName, deUint32 flags)
+{
+	TempFileLog log (fileName, 2, flags);
+
+	qpTestLog_startCase(log.get(), "dit.first", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+	writeTestImage(log.get(), "First", 32, 32, 1);
+	qpTestLog_endCase(log.get(), QP_TEST_RESULT_PASS, "Pass");
+
+	qpTestLog_startCase(log.get(), "dit.second", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+	writeTestImage(log.get(), "Repeat", 32, 32, 1);
+	writeTestImage(log.get(), "Other", 32, 32, 2);
+	writeTestImage(log.get(), "RepeatOther", 32, 32, 2);
+	qpTestLog_endCase(log.get(), QP_TEST_RESULT_PASS, "Pass");
+
+	return log.finish();
+}
+
+class ImageSetCase : public tcu::TestCase
+{
+public:
+	ImageSetCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "image_set", "Image set written with background image encoding")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int					numImages	= 8;
+		TempFileLog					log			("dit-testlog-image-set.qpa", 4);
+		std::vector<std::string>	names;
+		bool						isOk		= true;
+
+		qpTestLog_startCase(log.get(), "dit.image_set", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		qpTestLog_startImageSet(log.get(), "TestImages", "Test Image Set");
+
+		for (int imageNdx = 0; imageNdx < numImages; imageNdx++)
+			writeTestImage(log.get(), "Image" + de::toString(imageNdx), 64 + imageNdx, 64, imageNdx);
+
+		qpTestLog_endImageSet(log.get());
+		qpTestLog_endCase(log.get(), QP_TEST_RESULT_PASS, "Pass");
+
+		{
+			const std::string	logData		= log.finish();
+			const size_t		setStart	= logData.find("<ImageSet");
+			const size_t		setEnd		= logData.find("</ImageSet>");
+
+			names = getImageNames(logData);
+
+			if (setStart == std::string::npos || setEnd == std::string::npos ||
+				logData.find("<Image Name=") < setStart || logData.rfind("<Image Name=") > setEnd)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Images are not inside the image set" << TestLog::EndMessage;
+				isOk = false;
+			}
+		}
+
+		if ((int)names.size() != numImages)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Expected " << numImages << " images, got " << names.size() << TestLog::EndMessage;
+			isOk = false;
+		}
+
+		for (int imageNdx = 0; imageNdx < de::min(numImages, (int)names.size()); imageNdx++)
+		{
+			if (names[imageNdx] != "Image" + de::toString(imageNdx))
+			{
+				m_testCtx.getLog() << TestLog::Message << "Expected Image" << imageNdx << " at position " << imageNdx << ", got " << names[imageNdx] << TestLog::EndMessage;
+				isOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Unexpected images in log");
+		return STOP;
+	}
+};
+
+class TerminateWithPendingImagesCase : public tcu::TestCase
+{
+public:
+	TerminateWithPendingImagesCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "terminate_with_pending_images", "Terminate case while images are being encoded")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		TempFileLog	log		("dit-testlog-terminate.qpa", 2);
+		bool		isOk	= true;
+
+		qpTestLog_startCase(log.get(), "dit.terminated", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		qpTestLog_startImageSet(log.get(), "TestImages", "Test Image Set");
+
+		for (int imageNdx = 0; imageNdx < 8; imageNdx++)
+			writeTestImage(log.get(), "Terminated" + de::toString(imageNdx), 512, 512, imageNdx);
+
+		qpTestLog_terminateCase(log.get(), QP_TEST_RESULT_CRASH);
+
+		{
+			const std::string				logData	= log.finish();
+			const std::vector<std::string>	names	= getImageNames(logData);
+
+			if (logData.find("#terminateTestCaseResult Crash") == std::string::npos)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Case was not terminated" << TestLog::EndMessage;
+				isOk = false;
+			}
+
+			if (!names.empty())
+			{
+				m_testCtx.getLog() << TestLog::Message << "Expected pending images to be dropped, got " << names.size() << " images" << TestLog::EndMessage;
+				isOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Unexpected log contents");
+		return STOP;
+	}
+};
+
+class ImageDedupWriteCase : public tcu::TestCase
+{
+public:
+	ImageDedupWriteCase (tcu::TestContext& testCtx)
+		: TestCase	(testCtx, "image_dedup_write", "Repeated images are written as references")
+		, m_allOk	(true)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		m_allOk = true;
+
+		{
+			const std::string logData = writeDedupTestLog("dit-testlog-dedup-write.qpa", QP_TEST_LOG_DEDUPLICATE_IMAGES);
+
+			expect(logData.find("Version=\"0.3.4\"") != std::string::npos, "Deduplicating log uses version 0.3.4");
+			expect(!getImageAttribute(logData, "First", "Hash").empty(), "First image is written with hash");
+			expect(getImageAttribute(logData, "Repeat", "Ref") == getImageAttribute(logData, "First", "Hash"), "Repeated image in later case references first image");
+			expect(getImageAttribute(logData, "Repeat", "CompressionMode").empty(), "Reference has no image data");
+			expect(!getImageAttribute(logData, "Other", "Hash").empty() && getImageAttribute(logData, "Other", "Hash") != getImageAttribute(logData, "First", "Hash"), "Different image is written with its own hash");
+			expect(getImageAttribute(logData, "RepeatOther", "Ref") == getImageAttribute(logData, "Other", "Hash"), "Repeated image in same case references earlier image");
+		}
+
+		{
+			const std::string logData = writeDedupTestLog("dit-testlog-dedup-write.qpa", 0);
+
+			expect(logData.find("Version=\"0.3.3\"") != std::string::npos, "Log without deduplication uses version 0.3.3");
+			expect(logData.find("Hash=") == std::string::npos && logData.find("Ref=") == std::string::npos, "Log without deduplication has no hashes or references");
+		}
+
+		m_testCtx.setTestResult(m_allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								m_allOk ? "Pass"				: "Unexpected log contents");
+		return STOP;
+	}
+
+private:
+	void expect (bool condition, const char* description)
+	{
+		if (!condition)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Check failed: " << description << TestLog::EndMessage;
+			m_allOk = false;
+		}
+	}
+
+	bool m_allOk;
+};
+
+//! Cases with texts of growing size, later ones larger than BufferedOutputCase buffer.
+static void writeBufferTestCases (qpTestLog* log)
+{
+	for (int caseNdx = 0; caseNdx < 16; caseNdx++)
+	{
+		const std::string	casePath	= "dit.buffered.case" + de::toString(caseNdx);
+		std::string			text;
+
+		for (int lineNdx = 0; lineNdx < 10 + caseNdx*4; lineNdx++)
+			text += "Line " + de::toString(lineNdx) + " of " + casePath + " <&> padding padding padding padding padding\n";
+
+		qpTestLog_startCase(log, casePath.c_str(), QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		qpTestLog_writeText(log, "Text", "Test text", QP_KEY_TAG_NONE, text.c_str());
+		qpTestLog_endCase(log, QP_TEST_RESULT_PASS, "Pass");
+	}
+}
+
+class BufferedOutputCase : public tcu::TestCase
+{
+public:
+	BufferedOutputCase (tcu::TestContext& testCtx, const char* name, const char* description, qpTestLogFlushPolicy flushPolicy)
+		: TestCase			(testCtx, name, description)
+		, m_flushPolicy		(flushPolicy)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const char* const	fileName		= "dit-testlog-buffered.qpa";
+		std::string			refFlushed;
+		std::string			refFinal;
+		std::string			flushed;
+		std::string			final;
+		bool				isOk			= true;
+
+		{
+			TempFileLog log (fileName, 0);
+
+			writeBufferTestCases(log.get());
+			qpTestLog_flush(log.get());
+
+			refFlushed	= log.read();
+			refFinal	= log.finish();
+		}
+
+		{
+			TempFileLog				log		(fileName, 0);
+			qpTestLogBufferConfig	config;
+
+			qpTestLogBufferConfig_init(&config);
+			config.bufferSize		= BUFFER_SIZE;
+			config.flushPolicy		= m_flushPolicy;
+			config.flushNumCases	= 3;
+			config.flushIntervalMs	= 1;
+
+			if (!qpTestLog_setBufferConfig(log.get(), &config))
+				throw tcu::ResourceError("Failed to set test log buffer configuration");
+
+			writeBufferTestCases(log.get());
+			qpTestLog_flush(log.get());
+
+			flushed	= log.read();
+			final	= log.finish();
+		}
+
+		m_testCtx.getLog() << TestLog::Message << "Wrote " << refFinal.size() << " bytes through " << (int)BUFFER_SIZE << " byte buffer" << TestLog::EndMessage;
+
+		if (flushed != refFlushed)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Log after qpTestLog_flush() differs from unbuffered log: got " << flushed.size() << " bytes, expected " << refFlushed.size() << TestLog::EndMessage;
+			isOk = false;
+		}
+
+		if (final != refFinal)
+		{
+			m_testCtx.getLog() << TestLog::Message << "Log after qpTestLog_destroy() differs from unbuffered log: got " << final.size() << " bytes, expected " << refFinal.size() << TestLog::EndMessage;
+			isOk = false;
+		}
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Incomplete log");
+		return STOP;
+	}
+
+private:
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
+
+	const qpTestLogFlushPolicy	m_flushPolicy;
+};
+
+//! Collects raw test case results in log order.
+class TestCaseResultCollector : public xe::TestLogHandler
+{
+public:
+	void setSessionInfo (const xe::SessionInfo&)
+	{
+	}
+
+	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
+	}
+
+	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
+	{
+	}
+
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
+	{
+		m_results.push_back(caseData);
+	}
+
+	const std::vector<xe::TestCaseResultPtr>& getResults (void) const { return m_results; }
+
+private:
+	std::vector<xe::TestCaseResultPtr> m_results;
+};
+
+static const xe::ri::Image* findImage (const xe::ri::List& items, const std::string& name)
+{
+	for (int itemNdx = 0; itemNdx < items.getNumItems(); itemNdx++)
+	{
+		const xe::ri::Item& item = items.getItem(itemNdx);
+
+		if (item.getType() == xe::ri::TYPE_IMAGE && static_cast<const xe::ri::Image&>(item).name == name)
+			return static_cast<const xe::ri::Image*>(&item);
+	}
+
+	return DE_NULL;
+}
+
+class ImageDedupParseCase : public tcu::TestCase
+{
+public:
+	ImageDedupParseCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "image_dedup_parse", "Image references are resolved by result parser")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const std::string		logData		= writeDedupTestLog("dit-testlog-dedup-parse.qpa", QP_TEST_LOG_DEDUPLICATE_IMAGES);
+		TestCaseResultCollector	collector;
+		xe::TestLogParser		logParser	(&collector);
+		xe::TestResultParser	resultParser;
+		xe::TestCaseResult		results[2];
+		bool					isOk		= true;
+
+		logParser.parse((const deUint8*)logData.c_str(), (int)logData.size());
+
+		if (collector.getResults().size() != DE_LENGTH_OF_ARRAY(results))
+			throw tcu::TestError("Expected 2 test case results");
+
+		// \note Same parser must be used for all results, in log order.
+		for (int resultNdx = 0; resultNdx < DE_LENGTH_OF_ARRAY(results); resultNdx++)
+			xe::parseTestCaseResultFromData(&resultParser, &results[resultNdx], *collector.getResults()[resultNdx]);
+
+		{
+			const xe::ri::Image* const	first		= findImage(results[0].resultItems, "First");
+			const xe::ri::Image* const	repeat		= findImage(results[1].resultItems, "Repeat");
+			const xe::ri::Image* const	other		= findImage(results[1].resultItems, "Other");
+			const xe::ri::Image* const	repeatOther	= findImage(results[1].resultItems, "RepeatOther");
+
+			if (!first || !repeat || !other || !repeatOther)
+				throw tcu::TestError("Image missing from parsed results");
+
+			if (first->data.empty() || repeat->data != first->data || repeat->width != first->width || repeat->height != first->height ||
+				repeat->format != first->format || repeat->compression != first->compression)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Reference to image of earlier case was not resolved to original image" << TestLog::EndMessage;
+				isOk = false;
+			}
+
+			if (other->data.empty() || repeatOther->data != other->data)
+			{
+				m_testCtx.getLog() << TestLog::Message << "Reference to image of same case was not resolved to original image" << TestLog::EndMessage;
+				isOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Image references resolved incorrectly");
+		return STOP;
+	}
+};
+
+//! Log with all element types, followed by a case that is either terminated or left open when log is destroyed.
+static std::string writeRoundTripTestLog (const char* fileName, deUint32 flags, bool terminateLastCase)
+{
+	TempFileLog		log			(fileName, 0, flags);
+	qpEglConfigInfo	eglConfig;
+	const deUint8	pixels[]	= { 0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90, 0xa0, 0xb0 };
+
+	deMemset(&eglConfig, 0, sizeof(eglConfig));
+	eglConfig.redSize			= 8;
+	eglConfig.colorBufferType	= "EGL_RGB_BUFFER";
+	eglConfig.configCaveat		= "EGL_NONE";
+	eglConfig.conformant		= "EGL_OPENGL_ES2_BIT";
+	eglConfig.renderableType	= "EGL_OPENGL_ES2_BIT";
+	eglConfig.surfaceTypes		= "EGL_WINDOW_BIT";
+	eglConfig.transparentType	= "EGL_NONE";
+
+	qpTestLog_startCase(log.get(), "dit.complete", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+	qpTestLog_writeText(log.get(), "Text", "Escaped <\"description\">", QP_KEY_TAG_NONE, "Line <1> & 'two'\n\x01\x1f control");
+	qpTestLog_writeInteger(log.get(), "Integer", "Integer value", "ms", QP_KEY_TAG_TIME, -123);
+	qpTestLog_writeFloat(log.get(), "Float", "Float value", "", QP_KEY_TAG_QUALITY, 0.5f);
+	qpTestLog_startSection(log.get(), "Section", "Section");
+	qpTestLog_startImageSet(log.get(), "Images", "Image set");
+	writeTestImage(log.get(), "Png", 17, 13, 1);
+	qpTestLog_writeImage(log.get(), "Raw", "Uncompressed image", QP_IMAGE_COMPRESSION_MODE_NONE, QP_IMAGE_FORMAT_RGB888, 2, 2, 6, pixels);
+	qpTestLog_endImageSet(log.get());
+	qpTestLog_startShaderProgram(log.get(), DE_TRUE, "Link <info>");
+	qpTestLog_writeShader(log.get(), QP_SHADER_TYPE_VERTEX, "void main (void)\n{\n\tgl_Position = vec4(0.0);\n}\n", DE_TRUE, "");
+	qpTestLog_endShaderProgram(log.get());
+	qpTestLog_endSection(log.get());
+	qpTestLog_startSampleList(log.get(), "Samples", "Sample list");
+	qpTestLog_startSampleInfo(log.get());
+	qpTestLog_writeValueInfo(log.get(), "Time", "Render time", "us", QP_SAMPLE_VALUE_TAG_RESPONSE);
+	qpTestLog_endSampleInfo(log.get());
+	qpTestLog_startSample(log.get());
+	qpTestLog_writeValueInteger(log.get(), 42);
+	qpTestLog_endSample(log.get());
+	qpTestLog_endSampleList(log.get());
+	qpTestLog_startEglConfigSet(log.get(), "Configs", "EGL configs");
+	qpTestLog_writeEglConfig(log.get(), &eglConfig);
+	qpTestLog_endEglConfigSet(log.get());
+	qpTestLog_endCase(log.get(), QP_TEST_RESULT_PASS, "Pass");
+
+	qpTestLog_startCase(log.get(), "dit.last", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+	qpTestLog_writeText(log.get(), "Text", "Text", QP_KEY_TAG_NONE, "Last case");
+
+	if (terminateLastCase)
+		qpTestLog_terminateCase(log.get(), QP_TEST_RESULT_CRASH);
+
+	return log.finish();
+}
+
+//! Parse log fed in chunks of given size, followed by end of string like executor does.
+static std::vector<xe::TestCaseResultPtr> parseTestLog (const std::string& logData, size_t chunkSize)
+{
+	TestCaseResultCollector	collector;
+	xe::TestLogParser		parser		(&collector);
+	const deUint8			eos			= 0;
+
+	for (size_t pos = 0; pos < logData.size(); pos += chunkSize)
+		parser.parse((const deUint8*)logData.c_str() + pos, (int)de::min(chunkSize, logData.size() - pos));
+
+	parser.parse(&eos, 1);
+
+	return collector.getResults();
+}
+
+//! Parse case data fed in chunks of given size and write result items as XML for comparison.
+static std::string getParsedResultXml (const xe::TestCaseResultData& data, size_t chunkSize)
+{
+	xe::TestResultParser	parser;
+	xe::TestCaseResult		result;
+	std::ostringstream		str;
+	const size_t			dataSize	= (size_t)data.getDataSize();
+
+	// Status of terminated cases comes from container, as in parseTestCaseResultFromData().
+	result.statusCode		= data.getStatusCode();
+	result.statusDetails	= data.getStatusDetails();
+
+	parser.init(&result, data.getDataFormat());
+
+	for (size_t pos = 0; pos < dataSize; pos += chunkSize)
+	{
+		if (parser.parse(data.getData() + pos, (int)de::min(chunkSize, dataSize - pos)) == xe::TestResultParser::PARSERESULT_ERROR)
+			throw tcu::TestError(std::string("Failed to parse result of ") + data.getTestCasePath() + ": " + result.statusDetails);
+	}
+
+	xe::writeTestResult(result, str);
+
+	return str.str();
+}
+
+class BinaryLogRoundTripCase : public tcu::TestCase
+{
+public:
+	BinaryLogRoundTripCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "binary_log_round_trip", "Binary log is parsed to same results as text log")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		bool isOk = true;
+
+		isOk = checkRoundTrip(true,		xe::TESTSTATUSCODE_CRASH)		&& isOk;
+		isOk = checkRoundTrip(false,	xe::TESTSTATUSCODE_TERMINATED)	&& isOk;
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Binary log results differ");
+		return STOP;
+	}
+
+private:
+	bool checkRoundTrip (bool terminateLastCase, xe::TestStatusCode lastStatusCode)
+	{
+		const std::string							textLog			= writeRoundTripTestLog("dit-testlog-round-trip.qpa", 0, terminateLastCase);
+		const std::string							binaryLog		= writeRoundTripTestLog("dit-testlog-round-trip.qpb", QP_TEST_LOG_BINARY_FORMAT, terminateLastCase);
+		const std::vector<xe::TestCaseResultPtr>	refResults		= parseTestLog(textLog, textLog.size());
+		const size_t								chunkSizes[]	= { 1, 2, 3, 5, 7, 16, 61, 256, 1000, 4096 };
+		std::vector<std::string>					refResultXml;
+		bool										isOk			= true;
+
+		if (refResults.size() != 2 ||
+			refResults[0]->getStatusCode() != xe::TESTSTATUSCODE_LAST ||
+			refResults[1]->getStatusCode() != lastStatusCode)
+			throw tcu::TestError("Unexpected results from text log");
+
+		for (size_t resultNdx = 0; resultNdx < refResults.size(); resultNdx++)
+			refResultXml.push_back(getParsedResultXml(*refResults[resultNdx], (size_t)refResults[resultNdx]->getDataSize()));
+
+		m_testCtx.getLog() << TestLog::Message << "Last case " << (terminateLastCase ? "terminated" : "left open") << ": text log is " << textLog.size() << " bytes, binary log " << binaryLog.size() << " bytes" << TestLog::EndMessage;
+
+		for (int chunkNdx = 0; chunkNdx < DE_LENGTH_OF_ARRAY(chunkSizes); chunkNdx++)
+		{
+			const std::vector<xe::TestCaseResultPtr>	results		= parseTestLog(binaryLog, chunkSizes[chunkNdx]);
+			std::ostringstream							desc;
+
+			desc << "Chunk size " << chunkSizes[chunkNdx];
+			isOk = checkResults(desc.str(), results, refResults, refResultXml, chunkSizes[chunkNdx]) && isOk;
+		}
+
+		// Batch results of binary log are written as binary log.
+		// \note Terminate record only carries status code, so details of case left open are not preserved.
+		if (terminateLastCase)
+		{
+			xe::BatchResult										batchResult;
+			std::ostringstream									str;
+			const std::vector<xe::TestCaseResultPtr>			results		= parseTestLog(binaryLog, binaryLog.size());
+
+			for (size_t resultNdx = 0; resultNdx < results.size(); resultNdx++)
+			{
+				const xe::TestCaseResultData&	src		= *results[resultNdx];
+				const xe::TestCaseResultPtr		dst		= batchResult.createTestCaseResult(src.getTestCasePath());
+
+				dst->setTestResult(src.getStatusCode(), src.getStatusDetails());
+				dst->setDataFormat(src.getDataFormat());
+				dst->setDataSize(src.getDataSize());
+				deMemcpy(dst->getData(), src.getData(), (size_t)src.getDataSize());
+			}
+
+			xe::writeTestLog(batchResult, str);
+
+			if (!xe::matchesBinaryTestLogMagic((const deUint8*)str.str().c_str(), (int)str.str().size()))
+			{
+				m_testCtx.getLog() << TestLog::Message << "Batch result of binary log was not written as binary log" << TestLog::EndMessage;
+				isOk = false;
+			}
+			else
+				isOk = checkResults("Rewritten binary log", parseTestLog(str.str(), str.str().size()), refResults, refResultXml, 4096) && isOk;
+		}
+
+		return isOk;
+	}
+
+	bool checkResults (const std::string&							desc,
+					   const std::vector<xe::TestCaseResultPtr>&	results,
+					   const std::vector<xe::TestCaseResultPtr>&	refResults,
+					   const std::vector<std::string>&				refResultXml,
+					   size_t										chunkSize)
+	{
+		bool isOk = true;
+
+		if (results.size() != refResults.size())
+		{
+			m_testCtx.getLog() << TestLog::Message << desc << ": expected " << refResults.size() << " results, got " << results.size() << TestLog::EndMessage;
+			return false;
+		}
+
+		for (size_t resultNdx = 0; resultNdx < results.size(); resultNdx++)
+		{
+			const xe::TestCaseResultData&	result	= *results[resultNdx];
+			const xe::TestCaseResultData&	ref		= *refResults[resultNdx];
+
+			if (std::string(result.getTestCasePath()) != ref.getTestCasePath() ||
+				result.getStatusCode() != ref.getStatusCode() ||
+				std::string(result.getStatusDetails()) != ref.getStatusDetails() ||
+				result.getDataFormat() != xe::TESTCASEDATAFORMAT_BINARY ||
+				getParsedResultXml(result, chunkSize) != refResultXml[resultNdx])
+			{
+				m_testCtx.getLog() << TestLog::Message << desc << ": result of " << ref.getTestCasePath() << " differs from text log" << TestLog::EndMessage;
+				isOk = false;
+			}
+		}
+
+		return isOk;
+	}
+};
+
 TestLogTests::TestLogTests (tcu::TestContext& testCtx)
 	: TestCaseGroup(testCtx, "testlog", "Test Log Tests")
 {
@@ -81,6 +759,15 @@ TestLogTests::~TestLogTests (void)
 void TestLogTests::init (void)
 {
 	addChild(new BasicSampleListCase(m_testCtx));
+	addChild(new ImageSetCase(m_testCtx));
+	addChild(new TerminateWithPendingImagesCase(m_testCtx));
+	addChild(new ImageDedupWriteCase(m_testCtx));
+	addChild(new ImageDedupParseCase(m_testCtx));
+	addChild(new BufferedOutputCase(m_testCtx, "buffered_output_flush_case",		"Buffered output flushed after each case",		QP_TEST_LOG_FLUSH_POLICY_CASE));
+	addChild(new BufferedOutputCase(m_testCtx, "buffered_output_flush_num_cases",	"Buffered output flushed after every 3 cases",	QP_TEST_LOG_FLUSH_POLICY_NUM_CASES));
+	addChild(new BufferedOutputCase(m_testCtx, "buffered_output_flush_time",		"Buffered output flushed every millisecond",	QP_TEST_LOG_FLUSH_POLICY_TIME));
+	addChild(new BufferedOutputCase(m_testCtx, "buffered_output_flush_crash",		"Buffered output flushed only when required",	QP_TEST_LOG_FLUSH_POLICY_CRASH));
+	addChild(new BinaryLogRoundTripCase(m_testCtx));
 }
 
 } // dit
@@ -27,7 +27,9 @@
 #include "ditFrameworkTests.hpp"
 #include "ditImageIOTests.hpp"
 #include "ditImageCompareTests.hpp"
+#include "ditReferenceRendererPerfTests.hpp"
 #include "ditTestLogTests.hpp"
+#include "ditTexDecompressionPerfTests.hpp"
 #include "ditSeedBuilderTests.hpp"
 
 namespace dit
@@ -50,6 +52,21 @@ public:
 	}
 };
 
+class PerformanceTests : public tcu::TestCaseGroup
+{
+public:
+	PerformanceTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "performance", "Framework performance benchmarks")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new ReferenceRendererPerfTests(m_testCtx));
+		addChild(new TexDecompressionPerfTests(m_testCtx));
+	}
+};
+
 class TestCaseExecutor : public tcu::TestCaseExecutor
 {
 public:
@@ -88,10 +105,11 @@ TestPackage::~TestPackage (void)
 
 void TestPackage::init (void)
 {
-	addChild(new BuildInfoTests	(m_testCtx));
-	addChild(new DelibsTests	(m_testCtx));
-	addChild(new FrameworkTests	(m_testCtx));
-	addChild(new DeqpTests		(m_testCtx));
+	addChild(new BuildInfoTests		(m_testCtx));
+	addChild(new DelibsTests		(m_testCtx));
+	addChild(new FrameworkTests		(m_testCtx));
+	addChild(new DeqpTests			(m_testCtx));
+	addChild(new PerformanceTests	(m_testCtx));
 }
 
 tcu::TestCaseExecutor* TestPackage::createExecutor (void) const
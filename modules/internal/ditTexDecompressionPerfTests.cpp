@@ -0,0 +1,356 @@
+/*-------------------------------------------------------------------------
+ * drawElements Internal Test Module
+ * ---------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compressed texture decompression benchmarks.
+ *//*--------------------------------------------------------------------*/
+
+#include "ditTexDecompressionPerfTests.hpp"
+#include "tcuTestLog.hpp"
+#include "tcuCompressedTexture.hpp"
+#include "tcuTexture.hpp"
+#include "tcuImageCompareThreads.hpp"
+#include "deRandom.hpp"
+#include "deStringUtil.hpp"
+#include "deString.h"
+#include "deMemory.h"
+#include "deClock.h"
+
+#include <algorithm>
+
+namespace dit
+{
+
+namespace
+{
+
+using tcu::TestLog;
+
+//! Get big-endian 64-bit ETC block
+static deUint64 getETCBlock (const deUint8* src)
+{
+	deUint64 block = 0;
+
+	for (int i = 0; i < 8; i++)
+		block = (block << 8) | (deUint64)src[i];
+
+	return block;
+}
+
+static void setETCBlock (deUint8* dst, deUint64 block)
+{
+	for (int i = 0; i < 8; i++)
+		dst[i] = (deUint8)(block >> (8*(7-i)));
+}
+
+//! Switch ETC1 differential mode blocks with out-of-range base colors to individual mode
+static void makeValidETC1Block (deUint8* block)
+{
+	const deUint64 src = getETCBlock(block);
+
+	if ((src >> 33) & 1)
+	{
+		for (int channelNdx = 0; channelNdx < 3; channelNdx++)
+		{
+			const int base	= (int)((src >> (59 - 8*channelNdx)) & 0x1f);
+			const int delta	= (int)((src >> (56 - 8*channelNdx)) & 0x7);
+			const int sum	= base + ((delta & 0x4) ? (delta - 8) : delta);
+
+			if (!de::inBounds(sum, 0, 32))
+			{
+				setETCBlock(block, src & ~(1ull << 33));
+				break;
+			}
+		}
+	}
+}
+
+//! Check if ASTC block decodes to the error color or has undefined results
+static bool isASTCErrorBlock (tcu::CompressedTexFormat format, const deUint8* block, const tcu::TexDecompressionParams& params)
+{
+	const tcu::IVec3		blockSize	= tcu::getBlockPixelSize(format);
+	tcu::TextureLevel		decoded		(tcu::getUncompressedFormat(format), blockSize.x(), blockSize.y());
+	const tcu::Vec4			errorColor	(1.0f, 0.0f, 1.0f, 1.0f);
+
+	try
+	{
+		tcu::decompress(decoded.getAccess(), format, block, params);
+	}
+	catch (const tcu::InternalError&)
+	{
+		return true;
+	}
+
+	for (int y = 0; y < blockSize.y(); y++)
+	for (int x = 0; x < blockSize.x(); x++)
+	{
+		if (decoded.getAccess().getPixel(x, y) != errorColor)
+			return false;
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Decompress a texture repeatedly and report block throughput
+ *
+ * Texture data is random. ETC1 blocks are adjusted to be valid. ASTC
+ * blocks are picked from a pool of random blocks that do not decode to
+ * the error color so that the measurement covers the full decoding path.
+ * Decompression uses numThreads image comparison threads, 0 meaning all
+ * cores.
+ *//*--------------------------------------------------------------------*/
+class DecompressionThroughputCase : public tcu::TestCase
+{
+public:
+									DecompressionThroughputCase		(tcu::TestContext& testCtx, const char* name, const char* description, tcu::CompressedTexFormat format, tcu::TexDecompressionParams::AstcMode astcMode, int numThreads);
+									~DecompressionThroughputCase	(void);
+
+	void							init							(void);
+	void							deinit							(void);
+	IterateResult					iterate							(void);
+
+private:
+	enum
+	{
+		WIDTH				= 512,
+		HEIGHT				= 512,
+		NUM_MEASUREMENTS	= 10,
+		NUM_ASTC_BLOCKS		= 1024	//!< Size of valid ASTC block pool
+	};
+
+									DecompressionThroughputCase		(const DecompressionThroughputCase&);	// not allowed!
+	DecompressionThroughputCase&	operator=						(const DecompressionThroughputCase&);	// not allowed!
+
+	void							generateData					(void);
+	void							decompress						(void);
+	void							logResults						(void);
+
+	const tcu::CompressedTexFormat		m_format;
+	const tcu::TexDecompressionParams	m_params;
+	const int							m_numThreads;
+
+	int									m_prevNumThreads;
+	tcu::CompressedTexture				m_texture;
+	tcu::TextureLevel					m_result;
+	int									m_numBlocks;
+	std::vector<deUint64>				m_times;		//!< Decompression times in microseconds
+};
+
+DecompressionThroughputCase::DecompressionThroughputCase (tcu::TestContext& testCtx, const char* name, const char* description, tcu::CompressedTexFormat format, tcu::TexDecompressionParams::AstcMode astcMode, int numThreads)
+	: tcu::TestCase		(testCtx, tcu::NODETYPE_PERFORMANCE, name, description)
+	, m_format			(format)
+	, m_params			(astcMode)
+	, m_numThreads		(numThreads)
+	, m_prevNumThreads	(-1)
+	, m_numBlocks		(0)
+{
+}
+
+DecompressionThroughputCase::~DecompressionThroughputCase (void)
+{
+	DecompressionThroughputCase::deinit();
+}
+
+void DecompressionThroughputCase::init (void)
+{
+	const tcu::IVec3 blockSize = tcu::getBlockPixelSize(m_format);
+
+	m_texture.setStorage(m_format, WIDTH, HEIGHT);
+	m_result.setStorage(tcu::getUncompressedFormat(m_format), WIDTH, HEIGHT);
+	m_numBlocks = ((WIDTH + blockSize.x() - 1) / blockSize.x()) * ((HEIGHT + blockSize.y() - 1) / blockSize.y());
+	m_times.clear();
+
+	generateData();
+
+	m_prevNumThreads = tcu::getImageCompareNumThreads();
+	tcu::setImageCompareNumThreads(m_numThreads);
+
+	// Warm up thread pool
+	decompress();
+}
+
+void DecompressionThroughputCase::deinit (void)
+{
+	if (m_prevNumThreads >= 0)
+	{
+		tcu::setImageCompareNumThreads(m_prevNumThreads);
+		m_prevNumThreads = -1;
+	}
+
+	m_texture	= tcu::CompressedTexture();
+	m_result	= tcu::TextureLevel();
+}
+
+void DecompressionThroughputCase::generateData (void)
+{
+	const int		blockSize	= tcu::getBlockSize(m_format);
+	deUint8* const	data		= (deUint8*)m_texture.getData();
+	de::Random		rnd			(deStringHash(getName()));
+
+	DE_ASSERT(m_texture.getDataSize() == m_numBlocks*blockSize);
+
+	if (tcu::isAstcFormat(m_format))
+	{
+		std::vector<deUint8> blockPool (NUM_ASTC_BLOCKS*blockSize);
+
+		for (int poolNdx = 0; poolNdx < NUM_ASTC_BLOCKS; poolNdx++)
+		{
+			deUint8* const block = &blockPool[poolNdx*blockSize];
+
+			do
+			{
+				for (int byteNdx = 0; byteNdx < blockSize; byteNdx++)
+					block[byteNdx] = rnd.getUint8();
+			} while (isASTCErrorBlock(m_format, block, m_params));
+		}
+
+		for (int blockNdx = 0; blockNdx < m_numBlocks; blockNdx++)
+			deMemcpy(data + blockNdx*blockSize, &blockPool[rnd.getInt(0, NUM_ASTC_BLOCKS-1)*blockSize], blockSize);
+	}
+	else
+	{
+		for (int blockNdx = 0; blockNdx < m_numBlocks; blockNdx++)
+		{
+			deUint8* const block = data + blockNdx*blockSize;
+
+			for (int byteNdx = 0; byteNdx < blockSize; byteNdx++)
+				block[byteNdx] = rnd.getUint8();
+
+			if (m_format == tcu::COMPRESSEDTEXFORMAT_ETC1_RGB8)
+				makeValidETC1Block(block);
+		}
+	}
+}
+
+//! Decompress bypassing the decompressed texture cache
+void DecompressionThroughputCase::decompress (void)
+{
+	tcu::decompress(m_result.getAccess(), m_format, (const deUint8*)m_texture.getData(), m_params);
+}
+
+void DecompressionThroughputCase::logResults (void)
+{
+	TestLog&				log			= m_testCtx.getLog();
+	const tcu::IVec3		blockSize	= tcu::getBlockPixelSize(m_format);
+	std::vector<deUint64>	sortedTimes	= m_times;
+
+	log << TestLog::SampleList("Decompressions", "Texture decompression times")
+		<< TestLog::SampleInfo
+		<< TestLog::ValueInfo("DecompressionTime",	"Texture decompression time",	"us",			QP_SAMPLE_VALUE_TAG_RESPONSE)
+		<< TestLog::ValueInfo("BlockRate",			"Blocks per second",			"Mblocks/s",	QP_SAMPLE_VALUE_TAG_RESPONSE)
+		<< TestLog::EndSampleInfo;
+
+	for (size_t sampleNdx = 0; sampleNdx < m_times.size(); ++sampleNdx)
+	{
+		const double timeUs = (double)de::max<deUint64>(m_times[sampleNdx], 1);
+
+		log << TestLog::Sample << (deInt64)m_times[sampleNdx] << (double)m_numBlocks / timeUs << TestLog::EndSample;
+	}
+
+	log << TestLog::EndSampleList;
+
+	// Report median block rate
+	{
+		std::sort(sortedTimes.begin(), sortedTimes.end());
+
+		const double	medianTimeUs	= (double)de::max<deUint64>(sortedTimes[sortedTimes.size()/2], 1);
+		const double	blockRate		= (double)m_numBlocks / medianTimeUs;
+
+		log << TestLog::Message << m_numBlocks << " blocks of " << blockSize.x() << "x" << blockSize.y() << " texels" << TestLog::EndMessage;
+		log << TestLog::Message << "Median decompression time " << medianTimeUs << " us, " << blockRate << " Mblocks/s" << TestLog::EndMessage;
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, de::floatToString((float)blockRate, 2).c_str());
+	}
+}
+
+DecompressionThroughputCase::IterateResult DecompressionThroughputCase::iterate (void)
+{
+	const deUint64 startTime = deGetMicroseconds();
+
+	decompress();
+
+	m_times.push_back(deGetMicroseconds() - startTime);
+
+	if ((int)m_times.size() < NUM_MEASUREMENTS)
+		return CONTINUE;
+
+	logResults();
+	return STOP;
+}
+
+} // anonymous
+
+TexDecompressionPerfTests::TexDecompressionPerfTests (tcu::TestContext& testCtx)
+	: tcu::TestCaseGroup(testCtx, "texture_decompression", "Compressed texture decompression throughput")
+{
+}
+
+TexDecompressionPerfTests::~TexDecompressionPerfTests (void)
+{
+}
+
+void TexDecompressionPerfTests::init (void)
+{
+	static const struct
+	{
+		const char*								name;
+		tcu::CompressedTexFormat				format;
+		tcu::TexDecompressionParams::AstcMode	astcMode;
+	} formats[] =
+	{
+		{ "etc1_rgb8",					tcu::COMPRESSEDTEXFORMAT_ETC1_RGB8,							tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "etc2_rgb8",					tcu::COMPRESSEDTEXFORMAT_ETC2_RGB8,							tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "etc2_rgb8_punchthrough",		tcu::COMPRESSEDTEXFORMAT_ETC2_RGB8_PUNCHTHROUGH_ALPHA1,		tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "etc2_eac_rgba8",				tcu::COMPRESSEDTEXFORMAT_ETC2_EAC_RGBA8,					tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "eac_r11",					tcu::COMPRESSEDTEXFORMAT_EAC_R11,							tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "eac_signed_rg11",			tcu::COMPRESSEDTEXFORMAT_EAC_SIGNED_RG11,					tcu::TexDecompressionParams::ASTCMODE_LAST	},
+		{ "astc_4x4_ldr",				tcu::COMPRESSEDTEXFORMAT_ASTC_4x4_RGBA,						tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_4x4_hdr",				tcu::COMPRESSEDTEXFORMAT_ASTC_4x4_RGBA,						tcu::TexDecompressionParams::ASTCMODE_HDR	},
+		{ "astc_4x4_srgb",				tcu::COMPRESSEDTEXFORMAT_ASTC_4x4_SRGB8_ALPHA8,				tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_6x6_ldr",				tcu::COMPRESSEDTEXFORMAT_ASTC_6x6_RGBA,						tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_8x8_ldr",				tcu::COMPRESSEDTEXFORMAT_ASTC_8x8_RGBA,						tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_8x8_srgb",				tcu::COMPRESSEDTEXFORMAT_ASTC_8x8_SRGB8_ALPHA8,				tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_10x5_ldr",				tcu::COMPRESSEDTEXFORMAT_ASTC_10x5_RGBA,					tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_12x12_ldr",				tcu::COMPRESSEDTEXFORMAT_ASTC_12x12_RGBA,					tcu::TexDecompressionParams::ASTCMODE_LDR	},
+		{ "astc_12x12_hdr",				tcu::COMPRESSEDTEXFORMAT_ASTC_12x12_RGBA,					tcu::TexDecompressionParams::ASTCMODE_HDR	},
+	};
+
+	static const struct
+	{
+		const char*		name;
+		const char*		description;
+		int				numThreads;
+	} threadConfigs[] =
+	{
+		{ "single_thread",	"Decompression on the calling thread",		1	},
+		{ "all_cores",		"Decompression on all logical cores",		0	},
+	};
+
+	for (int configNdx = 0; configNdx < DE_LENGTH_OF_ARRAY(threadConfigs); configNdx++)
+	{
+		tcu::TestCaseGroup* const group = new tcu::TestCaseGroup(m_testCtx, threadConfigs[configNdx].name, threadConfigs[configNdx].description);
+		addChild(group);
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+			group->addChild(new DecompressionThroughputCase(m_testCtx, formats[formatNdx].name, "", formats[formatNdx].format, formats[formatNdx].astcMode, threadConfigs[configNdx].numThreads));
+	}
+}
+
+} // dit
@@ -0,0 +1,88 @@
+# -*- coding: utf-8 -*-
+
+#-------------------------------------------------------------------------
+# drawElements Quality Program utilities
+# --------------------------------------
+#
+# Copyright 2015 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+#-------------------------------------------------------------------------
+
+# Packs a test data directory into a single file loadable with
+# tcu::PackedArchive (--deqp-resource-pack). Resource names are paths
+# relative to the data directory, so packing the source data/ directory
+# gives the names used by test modules, e.g. "gles2/shaders/swizzles.test".
+
+import os
+import sys
+import struct
+import argparse
+
+PACK_MAGIC		= b"dEQPpack"
+PACK_VERSION	= 1
+DATA_ALIGNMENT	= 16
+
+def getResourceFiles (dataDir):
+	files = []
+	for root, dirs, fileNames in os.walk(dataDir):
+		dirs.sort()
+		for fileName in sorted(fileNames):
+			path = os.path.join(root, fileName)
+			name = os.path.relpath(path, dataDir).replace(os.sep, '/')
+			files.append((name, path))
+	return files
+
+def align (offset, alignment):
+	return (offset + alignment - 1) // alignment * alignment
+
+def buildPack (dataDir, dstPath):
+	files		= getResourceFiles(dataDir)
+	names		= [name.encode('utf-8') for name, path in files]
+	sizes		= [os.path.getsize(path) for name, path in files]
+	indexSize	= len(PACK_MAGIC) + 8 + sum(12 + len(name) for name in names)
+	offsets		= []
+	offset		= indexSize
+
+	for size in sizes:
+		offset = align(offset, DATA_ALIGNMENT)
+		offsets.append(offset)
+		offset += size
+
+	if offset > 0x7fffffff:
+		raise Exception("Pack file would be too large (%d bytes)" % offset)
+
+	with open(dstPath, 'wb') as dst:
+		dst.write(PACK_MAGIC)
+		dst.write(struct.pack('<II', PACK_VERSION, len(files)))
+
+		for name, offset, size in zip(names, offsets, sizes):
+			dst.write(struct.pack('<I', len(name)))
+			dst.write(name)
+			dst.write(struct.pack('<II', offset, size))
+
+		for (name, path), offset in zip(files, offsets):
+			dst.write(b'\0' * (offset - dst.tell()))
+			with open(path, 'rb') as src:
+				dst.write(src.read())
+
+	print("Packed %d resources into %s" % (len(files), dstPath))
+
+if __name__ == "__main__":
+	parser = argparse.ArgumentParser(description="Build resource pack from test data directory")
+	parser.add_argument("dataDir", help="Test data directory, e.g. data")
+	parser.add_argument("dstPath", help="Output pack file")
+	args = parser.parse_args()
+
+	buildPack(args.dataDir, args.dstPath)